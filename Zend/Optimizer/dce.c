@@ -127,6 +127,11 @@ static inline bool may_have_side_effects(
 		case ZEND_ARRAY_KEY_EXISTS:
 			/* No side effects */
 			return 0;
+		case ZEND_DECLARE_LAMBDA_FUNCTION:
+			/* Creating a closure runs no user code; binding $this and
+			 * copying use()d values only add references that the closure
+			 * itself releases again, so a dead closure is a pure allocation. */
+			return 0;
 		case ZEND_ADD_ARRAY_ELEMENT:
 			/* TODO: We can't free two vars. Keep instruction alive. <?php [0, "$a" => "$b"]; */
 			if ((opline->op1_type & (IS_VAR|IS_TMP_VAR)) && (opline->op2_type & (IS_VAR|IS_TMP_VAR))) {
@@ -1020,7 +1020,6 @@ static bool zend_dfa_try_to_replace_result(zend_op_array *op_array, zend_ssa *ss
 		if (use >= 0
 		 && zend_ssa_next_use(ssa->ops, result_var, use) < 0
 		 && op_array->opcodes[use].opcode != ZEND_FREE
-		 && op_array->opcodes[use].opcode != ZEND_SEND_VAL
 		 && op_array->opcodes[use].opcode != ZEND_SEND_VAL_EX
 		 && op_array->opcodes[use].opcode != ZEND_VERIFY_RETURN_TYPE
 		 && op_array->opcodes[use].opcode != ZEND_YIELD) {
@@ -1053,6 +1052,12 @@ static bool zend_dfa_try_to_replace_result(zend_op_array *op_array, zend_ssa *ss
 
 					op_array->opcodes[use].op1_type = IS_CV;
 					op_array->opcodes[use].op1.var = cv;
+					if (op_array->opcodes[use].opcode == ZEND_SEND_VAL) {
+						/* SEND_VAL has no CV variant. SEND_VAR passes the same
+						 * by-value argument directly from the CV, so the
+						 * defining op doesn't need to produce a TMP copy. */
+						op_array->opcodes[use].opcode = ZEND_SEND_VAR;
+					}
 				} else if (ssa->ops[use].op2_use == result_var) {
 					ssa->ops[use].op2_use = cv_var;
 					ssa->ops[use].op2_use_chain = ssa->vars[cv_var].use_chain;
@@ -1077,6 +1082,240 @@ static bool zend_dfa_try_to_replace_result(zend_op_array *op_array, zend_ssa *ss
 	return 0;
 }
 
+/* Checks whether block "n" belongs to the natural loop headed by "header"
+ * (walking the chain of enclosing loop headers) */
+static bool zend_dfa_block_in_loop(const zend_cfg *cfg, int header, int n)
+{
+	while (n >= 0) {
+		if (n == header) {
+			return 1;
+		}
+		n = cfg->blocks[n].loop_header;
+	}
+	return 0;
+}
+
+/* Checks whether the SSA variable is defined outside of the given loop
+ * (unused operands and function arguments are trivially invariant) */
+static bool zend_dfa_var_is_loop_invariant(const zend_ssa *ssa, int var, int header)
+{
+	int def_block;
+
+	if (var < 0) {
+		return 1;
+	}
+	if (ssa->vars[var].definition >= 0) {
+		def_block = ssa->cfg.map[ssa->vars[var].definition];
+	} else if (ssa->vars[var].definition_phi) {
+		def_block = ssa->vars[var].definition_phi->block;
+	} else {
+		return 1;
+	}
+	return !zend_dfa_block_in_loop(&ssa->cfg, header, def_block);
+}
+
+/* Checks whether the instruction is free of side effects, cannot throw or
+ * emit diagnostics for the inferred operand types, and produces a simple
+ * scalar temporary, so executing it once in the loop pre-header (even when
+ * the loop body would not have run) is unobservable */
+static bool zend_dfa_op_is_hoistable(const zend_op_array *op_array, const zend_ssa *ssa, const zend_op *opline, const zend_ssa_op *ssa_op)
+{
+	uint32_t t1, t2;
+
+	if (ssa_op->result_def < 0
+	 || ssa_op->op1_def >= 0
+	 || ssa_op->op2_def >= 0
+	 || ssa_op->result_use >= 0
+	 || opline->result_type != IS_TMP_VAR) {
+		return 0;
+	}
+
+	t1 = OP1_INFO() & (MAY_BE_ANY|MAY_BE_UNDEF|MAY_BE_REF);
+	switch (opline->opcode) {
+		case ZEND_ADD:
+		case ZEND_SUB:
+		case ZEND_MUL:
+			t2 = OP2_INFO() & (MAY_BE_ANY|MAY_BE_UNDEF|MAY_BE_REF);
+			return t1 && t2
+				&& !(t1 & ~(MAY_BE_LONG|MAY_BE_DOUBLE))
+				&& !(t2 & ~(MAY_BE_LONG|MAY_BE_DOUBLE));
+		case ZEND_BW_OR:
+		case ZEND_BW_AND:
+		case ZEND_BW_XOR:
+			t2 = OP2_INFO() & (MAY_BE_ANY|MAY_BE_UNDEF|MAY_BE_REF);
+			return t1 == MAY_BE_LONG && t2 == MAY_BE_LONG;
+		case ZEND_COUNT:
+			return t1 == MAY_BE_ARRAY;
+		case ZEND_STRLEN:
+			return t1 == MAY_BE_STRING;
+		case ZEND_TYPE_CHECK:
+			return t1 && !(t1 & (MAY_BE_UNDEF|MAY_BE_REF));
+		default:
+			return 0;
+	}
+}
+
+/* Checks whether no other SSA variable is mapped onto the same CV/TMP slot.
+ * The compiler reuses temporaries with disjoint live ranges, and hoisting
+ * extends the live range of the result, so the slot must be exclusive. */
+static bool zend_dfa_result_slot_is_exclusive(const zend_ssa *ssa, int result_var)
+{
+	int var = ssa->vars[result_var].var;
+	int j;
+
+	for (j = 0; j < ssa->vars_count; j++) {
+		if (j != result_var && ssa->vars[j].var == var) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Redirects the link pointing to use site "old_op" in the use chain of the
+ * given SSA variable to "new_op" */
+static void zend_dfa_relink_use(zend_ssa *ssa, int var, int old_op, int new_op)
+{
+	int use;
+
+	if (ssa->vars[var].use_chain == old_op) {
+		ssa->vars[var].use_chain = new_op;
+		return;
+	}
+	use = ssa->vars[var].use_chain;
+	while (use >= 0) {
+		zend_ssa_op *ssa_op = ssa->ops + use;
+		int *chain;
+
+		if (ssa_op->op1_use == var) {
+			chain = &ssa_op->op1_use_chain;
+		} else if (ssa_op->op2_use == var) {
+			chain = &ssa_op->op2_use_chain;
+		} else {
+			chain = &ssa_op->res_use_chain;
+		}
+		if (*chain == old_op) {
+			*chain = new_op;
+			return;
+		}
+		use = *chain;
+	}
+	ZEND_UNREACHABLE();
+}
+
+/* Moves loop-invariant computations into existing NOP slots of the loop
+ * pre-header. Only slots freed by SCCP/DCE are reused, so no instructions
+ * are shifted and all jump targets and SSA positions stay valid; the
+ * permutation is limited to the moved instruction itself. */
+static bool zend_dfa_hoist_loop_invariants(zend_op_array *op_array, zend_ssa *ssa)
+{
+	zend_basic_block *blocks = ssa->cfg.blocks;
+	bool changed = 0;
+	int n;
+
+	if (ssa->cfg.flags & ZEND_FUNC_IRREDUCIBLE) {
+		return 0;
+	}
+
+	for (n = 0; n < ssa->cfg.blocks_count; n++) {
+		zend_basic_block *b = blocks + n;
+		zend_basic_block *pre;
+		int header, preheader;
+		uint32_t i;
+		int j;
+
+		if (!(b->flags & ZEND_BB_REACHABLE) || b->len == 0) {
+			continue;
+		}
+		header = (b->flags & ZEND_BB_LOOP_HEADER) ? n : b->loop_header;
+		if (header < 0) {
+			continue;
+		}
+
+		/* The pre-header is the only predecessor of the loop header that is
+		 * not a back edge; it must branch to the header unconditionally,
+		 * otherwise the hoisted code could run without entering the loop */
+		preheader = -1;
+		for (j = 0; j < blocks[header].predecessors_count; j++) {
+			int p = ssa->cfg.predecessors[blocks[header].predecessor_offset + j];
+
+			if (zend_dfa_block_in_loop(&ssa->cfg, header, p)) {
+				continue;
+			}
+			if (preheader >= 0 && preheader != p) {
+				preheader = -1;
+				break;
+			}
+			preheader = p;
+		}
+		if (preheader < 0
+		 || blocks[preheader].successors_count != 1
+		 || !(blocks[preheader].flags & ZEND_BB_REACHABLE)
+		 || blocks[preheader].len == 0) {
+			continue;
+		}
+		pre = blocks + preheader;
+
+		for (i = b->start; i < b->start + b->len; i++) {
+			zend_op *opline = op_array->opcodes + i;
+			zend_ssa_op *ssa_op = ssa->ops + i;
+			int slot;
+			uint32_t k;
+
+			if (opline->opcode == ZEND_NOP
+			 || !zend_dfa_op_is_hoistable(op_array, ssa, opline, ssa_op)
+			 || !zend_dfa_var_is_loop_invariant(ssa, ssa_op->op1_use, header)
+			 || !zend_dfa_var_is_loop_invariant(ssa, ssa_op->op2_use, header)
+			 || !zend_dfa_result_slot_is_exclusive(ssa, ssa_op->result_def)) {
+				continue;
+			}
+
+			/* Reuse the last NOP slot of the pre-header */
+			slot = -1;
+			for (k = pre->start + pre->len; k-- > pre->start;) {
+				if (op_array->opcodes[k].opcode == ZEND_NOP) {
+					slot = k;
+					break;
+				}
+			}
+			if (slot < 0) {
+				break;
+			}
+
+			/* Operands defined in the pre-header itself must dominate the slot */
+			if ((ssa_op->op1_use >= 0
+			  && ssa->vars[ssa_op->op1_use].definition >= slot
+			  && ssa->cfg.map[ssa->vars[ssa_op->op1_use].definition] == preheader)
+			 || (ssa_op->op2_use >= 0
+			  && ssa->vars[ssa_op->op2_use].definition >= slot
+			  && ssa->cfg.map[ssa->vars[ssa_op->op2_use].definition] == preheader)) {
+				continue;
+			}
+
+// i: #v.T = OP ..., ... [loop invariant] => hoisted to pre-header NOP slot
+
+			if (ssa_op->op1_use >= 0) {
+				zend_dfa_relink_use(ssa, ssa_op->op1_use, i, slot);
+			}
+			if (ssa_op->op2_use >= 0 && ssa_op->op2_use != ssa_op->op1_use) {
+				zend_dfa_relink_use(ssa, ssa_op->op2_use, i, slot);
+			}
+			ssa->vars[ssa_op->result_def].definition = slot;
+
+			op_array->opcodes[slot] = *opline;
+			MAKE_NOP(opline);
+			ssa->ops[slot] = *ssa_op;
+			ssa->cfg.map[slot] = preheader;
+			ssa_op->op1_use = ssa_op->op2_use = ssa_op->result_use = -1;
+			ssa_op->op1_def = ssa_op->op2_def = ssa_op->result_def = -1;
+			ssa_op->op1_use_chain = ssa_op->op2_use_chain = ssa_op->res_use_chain = -1;
+
+			changed = 1;
+		}
+	}
+
+	return changed;
+}
+
 void zend_dfa_optimize_op_array(zend_op_array *op_array, zend_optimizer_ctx *ctx, zend_ssa *ssa, zend_call_info **call_map)
 {
 	if (ctx->debug_level & ZEND_DUMP_BEFORE_DFA_PASS) {
@@ -1135,6 +1374,18 @@ void zend_dfa_optimize_op_array(zend_op_array *op_array, zend_optimizer_ctx *ctx
 #endif
 		}
 
+		if (ZEND_OPTIMIZER_PASS_2 & ctx->optimization_level) {
+			if (zend_dfa_hoist_loop_invariants(op_array, ssa)) {
+				remove_nops = 1;
+			}
+			if (ctx->debug_level & ZEND_DUMP_AFTER_PASS_2) {
+				zend_dump_op_array(op_array, ZEND_DUMP_SSA, "after licm pass", ssa);
+			}
+#if ZEND_DEBUG_DFA
+			ssa_verify_integrity(op_array, ssa, "after licm");
+#endif
+		}
+
 		for (v = op_array->last_var; v < ssa->vars_count; v++) {
 
 			op_1 = ssa->vars[v].definition;
@@ -156,6 +156,11 @@ static bool is_allocation_def(zend_op_array *op_array, zend_ssa *ssa, int def, i
 		switch (opline->opcode) {
 			case ZEND_INIT_ARRAY:
 				return 1;
+			case ZEND_DECLARE_LAMBDA_FUNCTION:
+				/* Closures have no user-visible destructor; freeing one only
+				 * releases the bound $this and use()d values, like freeing an
+				 * array releases its elements. */
+				return 1;
 			case ZEND_NEW: {
 			    /* objects with destructors should escape */
 				zend_class_entry *ce = zend_optimizer_get_class_entry_from_op1(
@@ -229,6 +234,7 @@ static bool is_local_def(zend_op_array *op_array, zend_ssa *ssa, int def, int va
 			case ZEND_ADD_ARRAY_ELEMENT:
 			case ZEND_QM_ASSIGN:
 			case ZEND_ASSIGN:
+			case ZEND_DECLARE_LAMBDA_FUNCTION:
 				return 1;
 			case ZEND_NEW: {
 				/* objects with destructors should escape */
@@ -307,6 +313,25 @@ static bool is_escape_use(zend_op_array *op_array, zend_ssa *ssa, int use, int v
 			case ZEND_POST_INC_OBJ:
 			case ZEND_POST_DEC_OBJ:
 				break;
+			case ZEND_FREE:
+			case ZEND_TYPE_CHECK:
+			case ZEND_BOOL:
+			case ZEND_BOOL_NOT:
+			case ZEND_JMPZ:
+			case ZEND_JMPNZ:
+			case ZEND_JMPZ_EX:
+			case ZEND_JMPNZ_EX:
+			case ZEND_INSTANCEOF:
+				/* only inspects or destroys the value; the pointer is not
+				 * stored anywhere (tracked allocations have default handlers,
+				 * so none of these can run user code either) */
+				break;
+			case ZEND_COUNT:
+				if (OP1_INFO() & MAY_BE_OBJECT) {
+					/* may invoke Countable::count() and leak $this */
+					return 1;
+				}
+				break;
 			case ZEND_INIT_ARRAY:
 			case ZEND_ADD_ARRAY_ELEMENT:
 				if (opline->extended_value & ZEND_ARRAY_ELEMENT_REF) {
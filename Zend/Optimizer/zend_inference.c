@@ -5024,6 +5024,7 @@ ZEND_API bool zend_may_throw_ex(const zend_op *opline, const zend_ssa_op *ssa_op
 		case ZEND_CASE_STRICT:
 		case ZEND_JMP_NULL:
 		case ZEND_JMP_FRAMELESS:
+		case ZEND_DECLARE_LAMBDA_FUNCTION:
 			return 0;
 		case ZEND_SEND_VAR:
 		case ZEND_SEND_VAL:
@@ -26,7 +26,7 @@
 #include "zend_compile.h"
 
 #define ZEND_OPTIMIZER_PASS_1		(1<<0)   /* Simple local optimizations   */
-#define ZEND_OPTIMIZER_PASS_2		(1<<1)   /*                              */
+#define ZEND_OPTIMIZER_PASS_2		(1<<1)   /* Loop invariant code motion   */
 #define ZEND_OPTIMIZER_PASS_3		(1<<2)   /* Jump optimization            */
 #define ZEND_OPTIMIZER_PASS_4		(1<<3)   /* INIT_FCALL_BY_NAME -> DO_FCALL */
 #define ZEND_OPTIMIZER_PASS_5		(1<<4)   /* CFG based optimization       */
@@ -320,6 +320,20 @@ fi
 AC_MSG_CHECKING(whether to enable zend max execution timers)
 AC_MSG_RESULT($ZEND_MAX_EXECUTION_TIMERS)
 
+AC_ARG_ENABLE([zend-xxh64-hash],
+  [AS_HELP_STRING([--enable-zend-xxh64-hash],
+    [whether to hash string keys longer than 16 bytes with XXH64 (changes hash values; clear the opcache file cache after toggling)])],
+  [ZEND_XXH64_HASH=$enableval],
+  [ZEND_XXH64_HASH=no])
+
+if test "$ZEND_XXH64_HASH" = "yes"; then
+  AC_DEFINE(ZEND_HASH_XXH64_LONG_KEYS, 1, [Use XXH64 for string keys longer than 16 bytes])
+  CFLAGS="$CFLAGS -DZEND_HASH_XXH64_LONG_KEYS"
+fi
+
+AC_MSG_CHECKING(whether to enable XXH64 hashing of long string keys)
+AC_MSG_RESULT($ZEND_XXH64_HASH)
+
 ])
 
 AC_ARG_ENABLE([gcc-global-regs],
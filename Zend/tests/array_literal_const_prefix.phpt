@@ -0,0 +1,138 @@
+--TEST--
+Array literals with a constant prefix and dynamic tail keep their semantics
+--FILE--
+<?php
+$x = 10;
+
+/* packed constant prefix */
+$a = [1, 2, 3, 4, $x];
+var_dump($a);
+
+/* string-keyed prefix */
+$b = ['a' => 1, 'b' => 2, 'c' => 3, 'd' => 4, 'e' => $x];
+var_dump($b);
+
+/* mixed keys: explicit integer keys matching the next free index */
+$c = [0 => 'p', 'k' => 'q', 1 => 'r', 2 => 's', $x];
+var_dump($c);
+
+/* bool/null/float keys are normalized like in a fully constant literal */
+$d = [false => 'f', true => 't', null => 'n', 2.0 => 'd', $x];
+var_dump($d);
+
+/* non-sequential integer keys must be preserved */
+$e = [5 => 1, 6 => 2, 7 => 3, 8 => 4, $x];
+var_dump($e);
+
+/* duplicate string keys: last one wins */
+$f = ['k' => 1, 'k' => 2, 'a' => 3, 'b' => 4, $x];
+var_dump($f);
+
+/* by-ref element in the tail */
+$g = [1, 2, 3, 4, &$x];
+$x = 20;
+var_dump($g);
+
+/* dynamic element in the middle limits the prefix */
+$h = [1, 2, 3, 4, $x, 5, 6];
+var_dump($h);
+?>
+--EXPECT--
+array(5) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+  [3]=>
+  int(4)
+  [4]=>
+  int(10)
+}
+array(5) {
+  ["a"]=>
+  int(1)
+  ["b"]=>
+  int(2)
+  ["c"]=>
+  int(3)
+  ["d"]=>
+  int(4)
+  ["e"]=>
+  int(10)
+}
+array(5) {
+  [0]=>
+  string(1) "p"
+  ["k"]=>
+  string(1) "q"
+  [1]=>
+  string(1) "r"
+  [2]=>
+  string(1) "s"
+  [3]=>
+  int(10)
+}
+array(5) {
+  [0]=>
+  string(1) "f"
+  [1]=>
+  string(1) "t"
+  [""]=>
+  string(1) "n"
+  [2]=>
+  string(1) "d"
+  [3]=>
+  int(10)
+}
+array(5) {
+  [5]=>
+  int(1)
+  [6]=>
+  int(2)
+  [7]=>
+  int(3)
+  [8]=>
+  int(4)
+  [9]=>
+  int(10)
+}
+array(4) {
+  ["k"]=>
+  int(2)
+  ["a"]=>
+  int(3)
+  ["b"]=>
+  int(4)
+  [0]=>
+  int(10)
+}
+array(5) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+  [3]=>
+  int(4)
+  [4]=>
+  int(20)
+}
+array(7) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+  [3]=>
+  int(4)
+  [4]=>
+  int(10)
+  [5]=>
+  int(5)
+  [6]=>
+  int(6)
+}
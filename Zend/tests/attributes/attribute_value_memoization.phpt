@@ -0,0 +1,65 @@
+--TEST--
+Repeated attribute argument evaluation returns isolated, stable values
+--FILE--
+<?php
+
+const LIMIT = 10;
+
+enum Mode {
+    case Fast;
+}
+
+#[Attribute]
+class Config
+{
+    public function __construct(
+        public array $options,
+        public int $limit,
+        public Mode $mode,
+    ) {}
+}
+
+#[Config(['a' => [1, 2], 'b' => PHP_EOL], LIMIT * 2, Mode::Fast)]
+class Service {}
+
+$attr = (new ReflectionClass(Service::class))->getAttributes()[0];
+
+$first = $attr->newInstance();
+$second = $attr->newInstance();
+
+/* mutating one instance's array must not leak into later evaluations */
+$first->options['a'][] = 3;
+$third = $attr->newInstance();
+
+var_dump($first->options['a']);
+var_dump($second->options['a']);
+var_dump($third->options['a']);
+var_dump($second->limit);
+var_dump($second->mode === $third->mode);
+var_dump($attr->getArguments()[1]);
+
+?>
+--EXPECT--
+array(3) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+}
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+}
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+}
+int(20)
+bool(true)
+int(20)
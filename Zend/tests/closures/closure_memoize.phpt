@@ -0,0 +1,58 @@
+--TEST--
+Closure::memoize() caches results per scalar argument list
+--FILE--
+<?php
+
+$calls = 0;
+$add = function (int $a, int $b) use (&$calls): int {
+    $calls++;
+    return $a + $b;
+};
+
+$memo = $add->memoize();
+var_dump($memo instanceof Closure);
+
+var_dump($memo(1, 2));
+var_dump($memo(1, 2));
+var_dump($memo(2, 1));
+var_dump($calls);
+
+/* distinct scalar types must not collide */
+$id = (function ($v) use (&$calls) {
+    $calls++;
+    return $v;
+})->memoize();
+
+var_dump($id("1"));
+var_dump($id(1));
+var_dump($id(true));
+var_dump($calls);
+
+/* non-scalar arguments bypass the cache */
+$count = 0;
+$sum = (function (array $a) use (&$count): int {
+    $count++;
+    return array_sum($a);
+})->memoize();
+
+var_dump($sum([1, 2, 3]));
+var_dump($sum([1, 2, 3]));
+var_dump($count);
+
+/* memoizing an already memoized closure returns it unchanged */
+var_dump($memo->memoize() === $memo);
+
+?>
+--EXPECT--
+bool(true)
+int(3)
+int(3)
+int(3)
+int(2)
+string(1) "1"
+int(1)
+bool(true)
+int(5)
+int(6)
+int(2)
+bool(true)
@@ -0,0 +1,30 @@
+--TEST--
+clearstatcache() invalidates the negative autoload cache
+--FILE--
+<?php
+
+$file = __DIR__ . '/failed_autoload_clearstatcache.inc';
+@unlink($file);
+
+spl_autoload_register(function ($name) use ($file) {
+    if (is_file($file)) {
+        require $file;
+    }
+});
+
+var_dump(class_exists('NegCacheGenerated'));
+file_put_contents($file, '<?php class NegCacheGenerated {}');
+/* the failed probe is still cached */
+var_dump(class_exists('NegCacheGenerated'));
+clearstatcache();
+var_dump(class_exists('NegCacheGenerated'));
+
+?>
+--CLEAN--
+<?php
+@unlink(__DIR__ . '/failed_autoload_clearstatcache.inc');
+?>
+--EXPECT--
+bool(false)
+bool(false)
+bool(true)
@@ -0,0 +1,45 @@
+--TEST--
+instanceof against every level of a deep class hierarchy
+--FILE--
+<?php
+
+class L0 {}
+class L1 extends L0 {}
+class L2 extends L1 {}
+class L3 extends L2 {}
+class L4 extends L3 {}
+class L5 extends L4 {}
+class L6 extends L5 {}
+class L7 extends L6 {}
+class L8 extends L7 {}
+
+class Other extends L3 {}
+
+$o = new L8;
+for ($i = 0; $i <= 8; $i++) {
+    var_dump($o instanceof ('L' . $i));
+}
+var_dump($o instanceof Other);
+var_dump(new L3 instanceof L8);
+var_dump(is_subclass_of($o, 'L0'));
+var_dump(is_subclass_of($o, 'L8'));
+var_dump(is_subclass_of(new Other, 'L2'));
+var_dump(new stdClass instanceof L0);
+
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(false)
+bool(false)
+bool(true)
+bool(false)
+bool(true)
+bool(false)
@@ -261,6 +261,14 @@ ZEND_INI_BEGIN()
 #endif
 	STD_ZEND_INI_BOOLEAN("zend.exception_ignore_args",	"0",	ZEND_INI_ALL,		OnUpdateBool, exception_ignore_args, zend_executor_globals, executor_globals)
 	STD_ZEND_INI_ENTRY("zend.exception_string_param_max_len",	"15",	ZEND_INI_ALL,	OnSetExceptionStringParamMaxLen,	exception_string_param_max_len,		zend_executor_globals,	executor_globals)
+	STD_ZEND_INI_ENTRY("zend.exception_trace_limit",	"0",	ZEND_INI_ALL,		OnUpdateLong, exception_trace_limit, zend_executor_globals, executor_globals)
+	/* Check max_execution_time by polling a monotonic deadline at VM interrupt
+	 * points instead of arming an interval timer; avoids SIGPROF delivery. */
+	STD_ZEND_INI_BOOLEAN("zend.timeout_polling",	"0",	ZEND_INI_SYSTEM,	OnUpdateBool, timeout_polling, zend_executor_globals, executor_globals)
+	/* Sampling profiler: CPU milliseconds between samples (0 disables) and the
+	 * file per-request sample counts are appended to. */
+	STD_ZEND_INI_ENTRY("zend.vm_sampler_interval",	"0",	ZEND_INI_SYSTEM,	OnUpdateLong, vm_sampler_interval, zend_executor_globals, executor_globals)
+	STD_ZEND_INI_ENTRY("zend.vm_sampler_output",	NULL,	ZEND_INI_SYSTEM,	OnUpdateString, vm_sampler_output, zend_executor_globals, executor_globals)
 	STD_ZEND_INI_ENTRY("fiber.stack_size",		NULL,			ZEND_INI_ALL,		OnUpdateFiberStackSize,		fiber_stack_size,	zend_executor_globals, 		executor_globals)
 #ifdef ZEND_CHECK_STACK_LIMIT
 	/* The maximum allowed call stack size. 0: auto detect, -1: no limit. For fibers, this is fiber.stack_size. */
@@ -792,6 +800,7 @@ static void executor_globals_ctor(zend_executor_globals *executor_globals) /* {{
 	ZVAL_UNDEF(&executor_globals->user_error_handler);
 	ZVAL_UNDEF(&executor_globals->user_exception_handler);
 	executor_globals->in_autoload = NULL;
+	executor_globals->attribute_value_cache = NULL;
 	executor_globals->current_execute_data = NULL;
 	executor_globals->current_module = NULL;
 	executor_globals->exit_status = 0;
@@ -1557,7 +1566,20 @@ static ZEND_COLD void zend_error_va_list(
 		int orig_type, zend_string *error_filename, uint32_t error_lineno,
 		const char *format, va_list args)
 {
-	zend_string *message = zend_vstrpprintf(0, format, args);
+	zend_string *message;
+
+	/* SCCP only counts the warnings it captures, so don't format messages
+	 * nobody will ever read.  This is the sole early-out: everything else,
+	 * including diagnostics suppressed by error_reporting or @, still
+	 * materializes the message because error_get_last(), error observers
+	 * and record_errors consume it regardless of delivery. */
+	if (EG(capture_warnings_during_sccp)) {
+		ZEND_ASSERT(!((orig_type & E_ALL) & E_FATAL_ERRORS) && "Fatal error during SCCP");
+		EG(capture_warnings_during_sccp)++;
+		return;
+	}
+
+	message = zend_vstrpprintf(0, format, args);
 	zend_error_zstr_at(orig_type, error_filename, error_lineno, message);
 	zend_string_release(message);
 }
@@ -204,6 +204,8 @@ struct _zend_class_entry {
 
 	uint32_t num_interfaces;
 	uint32_t num_traits;
+	/* Number of entries in ancestors, i.e. the inheritance depth of the class */
+	uint32_t num_ancestors;
 
 	/* class_entry or string(s) depending on ZEND_ACC_LINKED */
 	union {
@@ -211,6 +213,10 @@ struct _zend_class_entry {
 		zend_class_name *interface_names;
 	};
 
+	/* All parent classes, root first, recorded at link time; NULL until the
+	 * parent is resolved. Lets instanceof index the chain instead of walking it. */
+	zend_class_entry **ancestors;
+
 	zend_class_name *trait_names;
 	zend_trait_alias **trait_aliases;
 	zend_trait_precedence **trait_precedences;
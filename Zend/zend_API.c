@@ -1603,6 +1603,10 @@ ZEND_API zend_result zend_update_class_constants(zend_class_entry *class_type) /
 	if (ce_flags & (ZEND_ACC_HAS_AST_PROPERTIES|ZEND_ACC_HAS_AST_STATICS)) {
 		zend_property_info *prop_info;
 
+		if (UNEXPECTED(class_type->properties_info_table == NULL && class_type->default_properties_count != 0)) {
+			zend_build_properties_info_table(class_type);
+		}
+
 		/* Use the default properties table to also update initializers of private properties
 		 * that have been shadowed in a child class. */
 		for (uint32_t i = 0; i < class_type->default_properties_count; i++) {
@@ -2329,19 +2333,21 @@ ZEND_API zend_result zend_startup_module_ex(zend_module_entry *module) /* {{{ */
 		while (dep->name) {
 			if (dep->type == MODULE_DEP_REQUIRED) {
 				zend_module_entry *req_mod;
+				ALLOCA_FLAG(use_heap)
 
 				name_len = strlen(dep->name);
-				lcname = zend_string_alloc(name_len, 0);
+				ZSTR_ALLOCA_ALLOC(lcname, name_len, use_heap);
 				zend_str_tolower_copy(ZSTR_VAL(lcname), dep->name, name_len);
 
-				if ((req_mod = zend_hash_find_ptr(&module_registry, lcname)) == NULL || !req_mod->module_started) {
-					zend_string_efree(lcname);
+				req_mod = zend_hash_find_ptr(&module_registry, lcname);
+				ZSTR_ALLOCA_FREE(lcname, use_heap);
+
+				if (req_mod == NULL || !req_mod->module_started) {
 					/* TODO: Check version relationship */
 					zend_error(E_CORE_WARNING, "Cannot load module \"%s\" because required module \"%s\" is not loaded", module->name, dep->name);
 					module->module_started = 0;
 					return FAILURE;
 				}
-				zend_string_efree(lcname);
 			}
 			++dep;
 		}
@@ -2531,17 +2537,21 @@ ZEND_API zend_module_entry* zend_register_module_ex(zend_module_entry *module, i
 
 		while (dep->name) {
 			if (dep->type == MODULE_DEP_CONFLICTS) {
+				bool conflicts;
+				ALLOCA_FLAG(use_heap)
+
 				name_len = strlen(dep->name);
-				lcname = zend_string_alloc(name_len, 0);
+				ZSTR_ALLOCA_ALLOC(lcname, name_len, use_heap);
 				zend_str_tolower_copy(ZSTR_VAL(lcname), dep->name, name_len);
 
-				if (zend_hash_exists(&module_registry, lcname) || zend_get_extension(dep->name)) {
-					zend_string_efree(lcname);
+				conflicts = zend_hash_exists(&module_registry, lcname) || zend_get_extension(dep->name);
+				ZSTR_ALLOCA_FREE(lcname, use_heap);
+
+				if (conflicts) {
 					/* TODO: Check version relationship */
 					zend_error(E_CORE_WARNING, "Cannot load module \"%s\" because conflicting module \"%s\" is already loaded", module->name, dep->name);
 					return NULL;
 				}
-				zend_string_efree(lcname);
 			}
 			++dep;
 		}
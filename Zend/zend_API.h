@@ -887,6 +887,9 @@ ZEND_API zend_result zend_delete_global_variable(zend_string *name);
 ZEND_API zend_array *zend_rebuild_symbol_table(void);
 ZEND_API void zend_attach_symbol_table(zend_execute_data *execute_data);
 ZEND_API void zend_detach_symbol_table(zend_execute_data *execute_data);
+/* Returns the live slot of a variable in the calling user frame, or NULL if
+ * it is not defined. Does not materialize the frame's symbol table. */
+ZEND_API zval *zend_get_local_var(zend_string *name);
 ZEND_API zend_result zend_set_local_var(zend_string *name, zval *value, bool force);
 ZEND_API zend_result zend_set_local_var_str(const char *name, size_t len, zval *value, bool force);
 
@@ -58,6 +58,11 @@
 #include "zend_multiply.h"
 #include "zend_bitset.h"
 #include "zend_mmap.h"
+#ifdef HAVE_DTRACE
+/* zend_dtrace.h depends on compiler types this file does not pull in;
+ * include the generated probe macros directly */
+# include <zend_dtrace_gen.h>
+#endif
 #include <signal.h>
 
 #ifdef HAVE_UNISTD_H
@@ -202,6 +207,12 @@ typedef struct  _zend_mm_huge_list zend_mm_huge_list;
 
 static bool zend_mm_use_huge_pages = false;
 
+/* Number of unused chunks kept mapped across requests (ZEND_MM_CHUNK_RETENTION
+ * environment variable). Retained chunks are advised MADV_FREE where available,
+ * so the kernel only takes their pages back under memory pressure instead of
+ * the next request re-faulting a freshly munmap'ed range. */
+static zend_long zend_mm_chunk_retention = 0;
+
 /*
  * Memory is retrieved from OS by chunks of fixed size 2MB.
  * Inside chunk it's managed by pages of fixed size 4096B.
@@ -779,7 +790,15 @@ static void *zend_mm_chunk_alloc(zend_mm_heap *heap, size_t size, size_t alignme
 		return ptr;
 	}
 #endif
-	return zend_mm_chunk_alloc_int(size, alignment);
+	{
+		void *ptr = zend_mm_chunk_alloc_int(size, alignment);
+#ifdef HAVE_DTRACE
+		if (ptr && DTRACE_MM_CHUNK_ALLOC_ENABLED()) {
+			DTRACE_MM_CHUNK_ALLOC(ptr, size);
+		}
+#endif
+		return ptr;
+	}
 }
 
 static void zend_mm_chunk_free(zend_mm_heap *heap, void *addr, size_t size)
@@ -789,6 +808,11 @@ static void zend_mm_chunk_free(zend_mm_heap *heap, void *addr, size_t size)
 		heap->storage->handlers.chunk_free(heap->storage, addr, size);
 		return;
 	}
+#endif
+#ifdef HAVE_DTRACE
+	if (DTRACE_MM_CHUNK_FREE_ENABLED()) {
+		DTRACE_MM_CHUNK_FREE(addr, size);
+	}
 #endif
 	zend_mm_munmap(addr, size);
 }
@@ -1126,6 +1150,7 @@ static zend_always_inline void zend_mm_delete_chunk(zend_mm_heap *heap, zend_mm_
 	chunk->prev->next = chunk->next;
 	heap->chunks_count--;
 	if (heap->chunks_count + heap->cached_chunks_count < heap->avg_chunks_count + 0.1
+	 || heap->cached_chunks_count < zend_mm_chunk_retention
 	 || (heap->chunks_count == heap->last_chunks_delete_boundary
 	  && heap->last_chunks_delete_count >= 4)) {
 		/* delay deletion */
@@ -1265,6 +1290,12 @@ static zend_never_inline void *zend_mm_alloc_small_slow(zend_mm_heap *heap, uint
 		return NULL;
 	}
 
+#ifdef HAVE_DTRACE
+	if (DTRACE_MM_BIN_GROW_ENABLED()) {
+		DTRACE_MM_BIN_GROW(bin_num, bin_data_size[bin_num]);
+	}
+#endif
+
 	chunk = (zend_mm_chunk*)ZEND_MM_ALIGNED_BASE(bin, ZEND_MM_CHUNK_SIZE);
 	page_num = ZEND_MM_ALIGNED_OFFSET(bin, ZEND_MM_CHUNK_SIZE) / ZEND_MM_PAGE_SIZE;
 	chunk->map[page_num] = ZEND_MM_SRUN(bin_num);
@@ -1881,6 +1912,11 @@ static void *zend_mm_alloc_huge(zend_mm_heap *heap, size_t size ZEND_FILE_LINE_D
 	} while (0);
 #elif ZEND_MM_LIMIT
 	heap->real_size += new_size;
+#endif
+#ifdef HAVE_DTRACE
+	if (DTRACE_MM_HUGE_ALLOC_ENABLED()) {
+		DTRACE_MM_HUGE_ALLOC(ptr, new_size);
+	}
 #endif
 	return ptr;
 }
@@ -1891,6 +1927,11 @@ static void zend_mm_free_huge(zend_mm_heap *heap, void *ptr ZEND_FILE_LINE_DC ZE
 
 	ZEND_MM_CHECK(ZEND_MM_ALIGNED_OFFSET(ptr, ZEND_MM_CHUNK_SIZE) == 0, "zend_mm_heap corrupted");
 	size = zend_mm_del_huge_block(heap, ptr ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+#ifdef HAVE_DTRACE
+	if (DTRACE_MM_HUGE_FREE_ENABLED()) {
+		DTRACE_MM_HUGE_FREE(ptr, size);
+	}
+#endif
 	zend_mm_chunk_free(heap, ptr, size);
 #if ZEND_MM_STAT || ZEND_MM_LIMIT
 	heap->real_size -= size;
@@ -2068,6 +2109,93 @@ ZEND_API size_t zend_mm_gc(zend_mm_heap *heap)
 	return collected * ZEND_MM_PAGE_SIZE;
 }
 
+/* Heap introspection: per-bin live element counts, per-chunk page usage and
+ * huge allocation totals, printed to stderr.  Triggered at shutdown by the
+ * ZEND_MM_PRINT_STATS environment variable; also callable from a debugger
+ * on a live process. */
+ZEND_API void zend_mm_print_stats(zend_mm_heap *heap)
+{
+	zend_mm_free_slot *p;
+	zend_mm_chunk *chunk;
+	zend_mm_huge_list *list;
+	zend_mm_page_info info;
+	uint32_t i, page_num;
+	size_t free_slots[ZEND_MM_BINS];
+	size_t total_slots[ZEND_MM_BINS];
+	size_t live, live_small_bytes = 0;
+	size_t large_blocks = 0, large_pages = 0;
+	size_t huge_blocks = 0, huge_bytes = 0;
+
+#if ZEND_MM_CUSTOM
+	if (heap->use_custom_heap) {
+		return;
+	}
+#endif
+
+	memset(free_slots, 0, sizeof(free_slots));
+	memset(total_slots, 0, sizeof(total_slots));
+
+	for (i = 0; i < ZEND_MM_BINS; i++) {
+		p = heap->free_slot[i];
+		while (p != NULL) {
+			free_slots[i]++;
+			p = p->next_free_slot;
+		}
+	}
+
+	fprintf(stderr, "zend_mm heap statistics\n");
+#if ZEND_MM_STAT
+	fprintf(stderr, "  used: %zu bytes, peak: %zu bytes, real: %zu bytes\n",
+		heap->size, heap->peak, heap->real_size);
+#endif
+
+	chunk = heap->main_chunk;
+	do {
+		page_num = ZEND_MM_FIRST_PAGE;
+		while (page_num < ZEND_MM_PAGES) {
+			if (!zend_mm_bitset_is_set(chunk->free_map, page_num)) {
+				page_num++;
+				continue;
+			}
+			info = chunk->map[page_num];
+			if (info & ZEND_MM_IS_SRUN) {
+				int bin_num = ZEND_MM_SRUN_BIN_NUM(info);
+
+				total_slots[bin_num] += bin_elements[bin_num];
+				page_num += bin_pages[bin_num];
+			} else /* if (info & ZEND_MM_IS_LRUN) */ {
+				large_blocks++;
+				large_pages += ZEND_MM_LRUN_PAGES(info);
+				page_num += ZEND_MM_LRUN_PAGES(info);
+			}
+		}
+		fprintf(stderr, "  chunk %u: %u/%u pages used\n",
+			chunk->num, (uint32_t)(ZEND_MM_PAGES - chunk->free_pages), (uint32_t)ZEND_MM_PAGES);
+		chunk = chunk->next;
+	} while (chunk != heap->main_chunk);
+
+	for (i = 0; i < ZEND_MM_BINS; i++) {
+		if (!total_slots[i]) {
+			continue;
+		}
+		/* slots on the free list still occupy their pages */
+		live = total_slots[i] - MIN(free_slots[i], total_slots[i]);
+		live_small_bytes += live * bin_data_size[i];
+		fprintf(stderr, "  bin %5u bytes: %8zu live / %8zu slots (%zu bytes live)\n",
+			bin_data_size[i], live, total_slots[i], live * bin_data_size[i]);
+	}
+
+	list = heap->huge_list;
+	while (list != NULL) {
+		huge_blocks++;
+		huge_bytes += list->size;
+		list = list->next;
+	}
+
+	fprintf(stderr, "  small: %zu bytes live, large: %zu blocks (%zu pages), huge: %zu blocks (%zu bytes)\n",
+		live_small_bytes, large_blocks, large_pages, huge_blocks, huge_bytes);
+}
+
 #if ZEND_DEBUG
 /******************/
 /* Leak detection */
@@ -2301,6 +2429,13 @@ void zend_mm_shutdown(zend_mm_heap *heap, bool full, bool silent)
 	}
 #endif
 
+	if (!silent) {
+		char *tmp = getenv("ZEND_MM_PRINT_STATS");
+		if (tmp && ZEND_ATOL(tmp)) {
+			zend_mm_print_stats(heap);
+		}
+	}
+
 	/* free huge blocks */
 	list = heap->huge_list;
 	heap->huge_list = NULL;
@@ -2334,6 +2469,7 @@ void zend_mm_shutdown(zend_mm_heap *heap, bool full, bool silent)
 		/* free some cached chunks to keep average count */
 		heap->avg_chunks_count = (heap->avg_chunks_count + (double)heap->peak_chunks_count) / 2.0;
 		while ((double)heap->cached_chunks_count + 0.9 > heap->avg_chunks_count &&
+		       heap->cached_chunks_count > zend_mm_chunk_retention &&
 		       heap->cached_chunks) {
 			p = heap->cached_chunks;
 			heap->cached_chunks = p->next;
@@ -2344,6 +2480,15 @@ void zend_mm_shutdown(zend_mm_heap *heap, bool full, bool silent)
 		p = heap->cached_chunks;
 		while (p != NULL) {
 			zend_mm_chunk *q = p->next;
+#if !defined(_WIN32) && defined(MADV_FREE)
+			/* Chunks retained across the request stay mapped so the next
+			 * request does not page-fault on a fresh mapping, but let the
+			 * kernel take their pages back lazily under memory pressure.
+			 * The header memset below re-dirties only the first page. */
+			if (zend_mm_chunk_retention > 0) {
+				(void)madvise(p, ZEND_MM_CHUNK_SIZE, MADV_FREE);
+			}
+#endif
 			memset(p, 0, sizeof(zend_mm_chunk));
 			p->next = q;
 			p = q;
@@ -2905,6 +3050,10 @@ static void alloc_globals_ctor(zend_alloc_globals *alloc_globals)
 	if (tmp && ZEND_ATOL(tmp)) {
 		zend_mm_use_huge_pages = true;
 	}
+	tmp = getenv("ZEND_MM_CHUNK_RETENTION");
+	if (tmp) {
+		zend_mm_chunk_retention = ZEND_ATOL(tmp);
+	}
 	alloc_globals->mm_heap = zend_mm_init();
 }
 
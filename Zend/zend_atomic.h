@@ -142,6 +142,10 @@ static zend_always_inline void zend_atomic_int_store_ex(zend_atomic_int *obj, in
 	(void)InterlockedExchange(&obj->value, desired);
 }
 
+static zend_always_inline void zend_atomic_thread_fence_release(void) {
+	MemoryBarrier();
+}
+
 #elif defined(HAVE_C11_ATOMICS)
 
 #define ZEND_ATOMIC_BOOL_INIT(obj, desired) __c11_atomic_init(&(obj)->value, (desired))
@@ -182,6 +186,10 @@ static zend_always_inline void zend_atomic_int_store_ex(zend_atomic_int *obj, in
 	__c11_atomic_store(&obj->value, desired, __ATOMIC_SEQ_CST);
 }
 
+static zend_always_inline void zend_atomic_thread_fence_release(void) {
+	__c11_atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
 #elif defined(HAVE_GNUC_ATOMICS)
 
 /* bool */
@@ -232,6 +240,10 @@ static zend_always_inline void zend_atomic_int_store_ex(zend_atomic_int *obj, in
 	__atomic_store(&obj->value, &desired, __ATOMIC_SEQ_CST);
 }
 
+static zend_always_inline void zend_atomic_thread_fence_release(void) {
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
 #elif defined(HAVE_SYNC_ATOMICS)
 
 #define ZEND_ATOMIC_BOOL_INIT(obj, desired) ((obj)->value = (desired))
@@ -302,6 +314,10 @@ static zend_always_inline void zend_atomic_int_store_ex(zend_atomic_int *obj, in
 	__sync_synchronize();
 }
 
+static zend_always_inline void zend_atomic_thread_fence_release(void) {
+	__sync_synchronize();
+}
+
 #elif defined(HAVE_NO_ATOMICS)
 
 #warning No atomics support detected. Please open an issue with platform details.
@@ -362,6 +378,9 @@ static zend_always_inline int zend_atomic_int_exchange_ex(zend_atomic_int *obj,
 	return prev;
 }
 
+static zend_always_inline void zend_atomic_thread_fence_release(void) {
+}
+
 #endif
 
 ZEND_API void zend_atomic_bool_init(zend_atomic_bool *obj, bool desired);
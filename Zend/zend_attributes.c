@@ -196,19 +196,64 @@ ZEND_API zend_attribute *zend_get_parameter_attribute_str(HashTable *attributes,
 	return get_attribute_str(attributes, str, len, offset + 1);
 }
 
+typedef struct {
+	zend_class_entry *scope;
+	zval value;
+} zend_attribute_value_cache_entry;
+
+static void attribute_value_cache_entry_free(zval *zv)
+{
+	zend_attribute_value_cache_entry *entry = Z_PTR_P(zv);
+
+	zval_ptr_dtor(&entry->value);
+	efree(entry);
+}
+
 ZEND_API zend_result zend_get_attribute_value(zval *ret, zend_attribute *attr, uint32_t i, zend_class_entry *scope)
 {
+	zend_attribute_value_cache_entry *entry;
+	zend_ulong key;
+
 	if (i >= attr->argc) {
 		return FAILURE;
 	}
 
+	if (Z_TYPE(attr->args[i].value) != IS_CONSTANT_AST) {
+		ZVAL_COPY_OR_DUP(ret, &attr->args[i].value);
+		return SUCCESS;
+	}
+
+	/* The argument slot is stable for the lifetime of the attribute (and
+	 * lives in SHM with opcache), so its address identifies the AST. */
+	key = (zend_ulong)(uintptr_t)&attr->args[i];
+
+	if (EG(attribute_value_cache)
+	 && (entry = zend_hash_index_find_ptr(EG(attribute_value_cache), key)) != NULL
+	 && entry->scope == scope) {
+		ZVAL_COPY(ret, &entry->value);
+		return SUCCESS;
+	}
+
 	ZVAL_COPY_OR_DUP(ret, &attr->args[i].value);
 
-	if (Z_TYPE_P(ret) == IS_CONSTANT_AST) {
-		if (SUCCESS != zval_update_constant_ex(ret, scope)) {
-			zval_ptr_dtor(ret);
-			return FAILURE;
+	if (SUCCESS != zval_update_constant_ex(ret, scope)) {
+		zval_ptr_dtor(ret);
+		return FAILURE;
+	}
+
+	/* Memoize for the rest of the request: constants cannot be redefined and
+	 * class constants are evaluated at most once, so the result is stable.
+	 * Cross-request caching would be unsound, as the same AST may resolve
+	 * against different constant or class definitions in the next request. */
+	if (EG(active)) {
+		if (!EG(attribute_value_cache)) {
+			ALLOC_HASHTABLE(EG(attribute_value_cache));
+			zend_hash_init(EG(attribute_value_cache), 8, NULL, attribute_value_cache_entry_free, 0);
 		}
+		entry = emalloc(sizeof(zend_attribute_value_cache_entry));
+		entry->scope = scope;
+		ZVAL_COPY(&entry->value, ret);
+		zend_hash_index_update_ptr(EG(attribute_value_cache), key, entry);
 	}
 
 	return SUCCESS;
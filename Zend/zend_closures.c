@@ -26,6 +26,7 @@
 #include "zend_objects.h"
 #include "zend_objects_API.h"
 #include "zend_globals.h"
+#include "zend_smart_str.h"
 #include "zend_closures_arginfo.h"
 
 typedef struct _zend_closure {
@@ -40,6 +41,13 @@ typedef struct _zend_closure {
 ZEND_API zend_class_entry *zend_ce_closure;
 static zend_object_handlers closure_handlers;
 
+static ZEND_NAMED_FUNCTION(zend_closure_memoize_handler);
+
+/* The result cache of a memoizing closure lives in the first reserved slot
+ * of its embedded internal function. */
+#define ZEND_CLOSURE_MEMOIZE_CACHE(closure) \
+	(*(HashTable**)&(closure)->func.internal_function.reserved[0])
+
 ZEND_METHOD(Closure, __invoke) /* {{{ */
 {
 	zend_function *func = EX(func);
@@ -412,6 +420,138 @@ ZEND_METHOD(Closure, fromCallable)
 }
 /* }}} */
 
+static ZEND_NAMED_FUNCTION(zend_closure_memoize_handler) /* {{{ */
+{
+	zend_closure *closure = (zend_closure*)ZEND_CLOSURE_OBJECT(EX(func));
+	HashTable *cache = ZEND_CLOSURE_MEMOIZE_CACHE(closure);
+	zval *args = ZEND_CALL_ARG(execute_data, 1);
+	uint32_t i, num_args = ZEND_NUM_ARGS();
+	zend_string *key = NULL;
+	zend_fcall_info fci;
+
+	if (UNEXPECTED(Z_TYPE(closure->this_ptr) != IS_OBJECT
+			|| !instanceof_function(Z_OBJCE(closure->this_ptr), zend_ce_closure))) {
+		zend_throw_error(NULL, "Cannot invoke a memoizing closure after it has been rebound");
+		return;
+	}
+
+	/* Results are cached only for argument lists made up entirely of scalars;
+	 * calls with other argument types fall through to the wrapped closure. */
+	if (!(EX_CALL_INFO() & ZEND_CALL_HAS_EXTRA_NAMED_PARAMS)) {
+		smart_str key_str = {0};
+		bool cacheable = true;
+
+		for (i = 0; i < num_args; i++) {
+			zval *arg = &args[i];
+
+			ZVAL_DEREF(arg);
+			switch (Z_TYPE_P(arg)) {
+				case IS_NULL:
+				case IS_FALSE:
+				case IS_TRUE:
+					smart_str_appendc(&key_str, (char)('0' + Z_TYPE_P(arg)));
+					break;
+				case IS_LONG:
+					smart_str_appendc(&key_str, 'i');
+					smart_str_appendl(&key_str, (const char*)&Z_LVAL_P(arg), sizeof(zend_long));
+					break;
+				case IS_DOUBLE:
+					smart_str_appendc(&key_str, 'd');
+					smart_str_appendl(&key_str, (const char*)&Z_DVAL_P(arg), sizeof(double));
+					break;
+				case IS_STRING:
+					/* The length prefix keeps adjacent strings from colliding. */
+					smart_str_appendc(&key_str, 's');
+					smart_str_appendl(&key_str, (const char*)&Z_STRLEN_P(arg), sizeof(size_t));
+					smart_str_appendl(&key_str, Z_STRVAL_P(arg), Z_STRLEN_P(arg));
+					break;
+				default:
+					cacheable = false;
+					break;
+			}
+			if (!cacheable) {
+				break;
+			}
+		}
+
+		if (cacheable) {
+			key = smart_str_extract(&key_str);
+		} else {
+			smart_str_free(&key_str);
+		}
+	}
+
+	if (key && cache) {
+		zval *cached = zend_hash_find(cache, key);
+
+		if (cached) {
+			zend_string_release_ex(key, 0);
+			RETURN_COPY(cached);
+		}
+	}
+
+	memset(&fci, 0, sizeof(zend_fcall_info));
+	fci.size = sizeof(zend_fcall_info);
+	ZVAL_COPY_VALUE(&fci.function_name, &closure->this_ptr);
+	fci.retval = return_value;
+	fci.param_count = num_args;
+	fci.params = args;
+	fci.named_params = (EX_CALL_INFO() & ZEND_CALL_HAS_EXTRA_NAMED_PARAMS) ?
+		EX(extra_named_params) : NULL;
+
+	if (zend_call_function(&fci, NULL) == FAILURE
+	 || UNEXPECTED(EG(exception))
+	 || Z_TYPE_P(return_value) == IS_UNDEF) {
+		if (key) {
+			zend_string_release_ex(key, 0);
+		}
+		return;
+	}
+
+	if (key) {
+		if (!cache) {
+			ALLOC_HASHTABLE(cache);
+			zend_hash_init(cache, 8, NULL, ZVAL_PTR_DTOR, 0);
+			ZEND_CLOSURE_MEMOIZE_CACHE(closure) = cache;
+		}
+		Z_TRY_ADDREF_P(return_value);
+		zend_hash_update(cache, key, return_value);
+		zend_string_release_ex(key, 0);
+	}
+}
+/* }}} */
+
+/* {{{ Returns a closure that caches this closure's results per request, keyed by its scalar arguments */
+ZEND_METHOD(Closure, memoize)
+{
+	zend_closure *closure;
+	zend_internal_function memoize;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	closure = (zend_closure *)Z_OBJ_P(ZEND_THIS);
+
+	if (closure->func.type == ZEND_INTERNAL_FUNCTION
+	 && closure->orig_internal_handler == zend_closure_memoize_handler) {
+		/* Already memoizing; wrapping it again would only add call overhead. */
+		RETURN_COPY(ZEND_THIS);
+	}
+
+	memset(&memoize, 0, sizeof(zend_internal_function));
+	memoize.type = ZEND_INTERNAL_FUNCTION;
+	memoize.fn_flags = ZEND_ACC_PUBLIC;
+	memoize.handler = zend_closure_memoize_handler;
+	memoize.function_name = closure->func.common.function_name;
+	memoize.scope = zend_ce_closure;
+	memoize.doc_comment = NULL;
+
+	/* The wrapped closure travels as the bound object, so the standard
+	 * get_gc/free_obj handling of this_ptr keeps it alive. */
+	zend_create_closure(return_value, (zend_function *)&memoize,
+		zend_ce_closure, zend_ce_closure, ZEND_THIS);
+}
+/* }}} */
+
 static ZEND_COLD zend_function *zend_closure_get_constructor(zend_object *object) /* {{{ */
 {
 	zend_throw_error(NULL, "Instantiation of class Closure is not allowed");
@@ -502,6 +642,30 @@ ZEND_API zval* zend_get_closure_this_ptr(zval *obj) /* {{{ */
 }
 /* }}} */
 
+ZEND_API zend_function *zend_get_closure_callable(zend_object *obj, void **object_or_called_scope, uint32_t *call_info) /* {{{ */
+{
+	zend_closure *closure = (zend_closure *)obj;
+	uint32_t info;
+
+	ZEND_ASSERT(obj->ce == zend_ce_closure);
+
+	/* Delay closure destruction until its invocation */
+	GC_ADDREF(obj);
+	ZEND_ASSERT(ZEND_ACC_FAKE_CLOSURE == ZEND_CALL_FAKE_CLOSURE);
+	info = ZEND_CALL_NESTED_FUNCTION | ZEND_CALL_DYNAMIC | ZEND_CALL_CLOSURE |
+		(closure->func.common.fn_flags & ZEND_ACC_FAKE_CLOSURE);
+	if (Z_TYPE(closure->this_ptr) != IS_UNDEF) {
+		info |= ZEND_CALL_HAS_THIS;
+		*object_or_called_scope = Z_OBJ(closure->this_ptr);
+	} else {
+		*object_or_called_scope = closure->called_scope;
+	}
+	*call_info = info;
+
+	return &closure->func;
+}
+/* }}} */
+
 static zend_function *zend_closure_get_method(zend_object **object, zend_string *method, const zval *key) /* {{{ */
 {
 	if (zend_string_equals_literal_ci(method, ZEND_INVOKE_FUNC_NAME)) {
@@ -526,6 +690,11 @@ static void zend_closure_free_storage(zend_object *object) /* {{{ */
 		}
 		destroy_op_array(&closure->func.op_array);
 	} else if (closure->func.type == ZEND_INTERNAL_FUNCTION) {
+		if (closure->orig_internal_handler == zend_closure_memoize_handler
+		 && ZEND_CLOSURE_MEMOIZE_CACHE(closure)) {
+			zend_hash_destroy(ZEND_CLOSURE_MEMOIZE_CACHE(closure));
+			FREE_HASHTABLE(ZEND_CLOSURE_MEMOIZE_CACHE(closure));
+		}
 		zend_string_release(closure->func.common.function_name);
 	}
 
@@ -686,6 +855,10 @@ static HashTable *zend_closure_get_gc(zend_object *obj, zval **table, int *n) /*
 
 	*table = Z_TYPE(closure->this_ptr) != IS_NULL ? &closure->this_ptr : NULL;
 	*n = Z_TYPE(closure->this_ptr) != IS_NULL ? 1 : 0;
+	if (closure->func.type == ZEND_INTERNAL_FUNCTION
+			&& closure->orig_internal_handler == zend_closure_memoize_handler) {
+		return ZEND_CLOSURE_MEMOIZE_CACHE(closure);
+	}
 	/* Fake closures don't own the static variables they reference. */
 	return (closure->func.type == ZEND_USER_FUNCTION
 			&& !(closure->func.op_array.fn_flags & ZEND_ACC_FAKE_CLOSURE)) ?
@@ -810,6 +983,10 @@ static void zend_create_closure_ex(zval *res, zend_function *func, zend_class_en
 			closure->orig_internal_handler = closure->func.internal_function.handler;
 		}
 		closure->func.internal_function.handler = zend_closure_internal_handler;
+		if (UNEXPECTED(closure->orig_internal_handler == zend_closure_memoize_handler)) {
+			/* Rebound/cloned memoizing closures must not share the source's cache. */
+			ZEND_CLOSURE_MEMOIZE_CACHE(closure) = NULL;
+		}
 		zend_string_addref(closure->func.op_array.function_name);
 		if (!func->common.scope) {
 			/* if it's a free function, we won't set scope & this since they're meaningless */
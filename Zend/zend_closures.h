@@ -40,6 +40,7 @@ ZEND_API void zend_create_fake_closure(zval *res, zend_function *op_array, zend_
 ZEND_API zend_function *zend_get_closure_invoke_method(zend_object *obj);
 ZEND_API const zend_function *zend_get_closure_method_def(zend_object *obj);
 ZEND_API zval* zend_get_closure_this_ptr(zval *obj);
+ZEND_API zend_function *zend_get_closure_callable(zend_object *obj, void **object_or_called_scope, uint32_t *call_info);
 
 END_EXTERN_C()
 
@@ -445,6 +445,7 @@ void init_compiler(void) /* {{{ */
 	CG(delayed_autoloads) = NULL;
 	CG(unlinked_uses) = NULL;
 	CG(current_linking_class) = NULL;
+	CG(ast_arena_cache) = NULL;
 }
 /* }}} */
 
@@ -472,6 +473,10 @@ void shutdown_compiler(void) /* {{{ */
 		FREE_HASHTABLE(CG(unlinked_uses));
 		CG(unlinked_uses) = NULL;
 	}
+	if (CG(ast_arena_cache)) {
+		zend_arena_destroy(CG(ast_arena_cache));
+		CG(ast_arena_cache) = NULL;
+	}
 	CG(current_linking_class) = NULL;
 }
 /* }}} */
@@ -2041,6 +2046,8 @@ ZEND_API void zend_initialize_class_data(zend_class_entry *ce, bool nullify_hand
 		ce->parent_name = NULL;
 		ce->num_interfaces = 0;
 		ce->interfaces = NULL;
+		ce->num_ancestors = 0;
+		ce->ancestors = NULL;
 		ce->num_traits = 0;
 		ce->trait_names = NULL;
 		ce->trait_aliases = NULL;
@@ -8433,7 +8440,6 @@ static void zend_compile_class_decl(znode *result, zend_ast *ast, bool toplevel)
 				}
 			} else if (EXPECTED(zend_hash_add_ptr(CG(class_table), lcname, ce) != NULL)) {
 				zend_string_release(lcname);
-				zend_build_properties_info_table(ce);
 				zend_inheritance_check_override(ce);
 				ce->ce_flags |= ZEND_ACC_LINKED;
 				zend_observer_class_linked_notify(ce, lcname);
@@ -8443,8 +8449,8 @@ static void zend_compile_class_decl(znode *result, zend_ast *ast, bool toplevel)
 			}
 		} else if (!extends_ast) {
 link_unbound:
-			/* Link unbound simple class */
-			zend_build_properties_info_table(ce);
+			/* Link unbound simple class. The properties info table is built
+			 * lazily on first use. */
 			zend_inheritance_check_override(ce);
 			ce->ce_flags |= ZEND_ACC_LINKED;
 		}
@@ -9955,12 +9961,147 @@ static void zend_compile_shell_exec(znode *result, zend_ast *ast) /* {{{ */
 }
 /* }}} */
 
+/* Determine how many leading elements of a (not fully constant) array literal
+ * are compile-time constants that can be pre-built into a single constant
+ * array and merged into the result by one ZEND_ADD_ARRAY_UNPACK, leaving
+ * per-element opcodes only for the dynamic tail. Because the merge renumbers
+ * integer keys, elements with integer-ish keys only qualify while their key
+ * matches the next free index of the prefix built so far. On success the
+ * prefix array is returned in *prefix and its length as return value;
+ * prefixes too short to be worthwhile report a length of 0. */
+static uint32_t zend_try_ct_eval_array_prefix(zend_ast_list *list, zval *prefix) /* {{{ */
+{
+	uint32_t i, prefix_len;
+	zend_long next_index = 0;
+
+	for (i = 0; i < list->children; ++i) {
+		zend_ast *elem_ast = list->child[i];
+		zend_ast *key_ast;
+
+		if (elem_ast == NULL
+		 || elem_ast->kind == ZEND_AST_UNPACK
+		 || elem_ast->attr /* by_ref */
+		 || elem_ast->child[0]->kind != ZEND_AST_ZVAL) {
+			break;
+		}
+
+		key_ast = elem_ast->child[1];
+		if (key_ast) {
+			zval *key;
+			bool is_int_key = false;
+			zend_long index = 0;
+
+			if (key_ast->kind != ZEND_AST_ZVAL) {
+				break;
+			}
+			key = zend_ast_get_zval(key_ast);
+			switch (Z_TYPE_P(key)) {
+				case IS_LONG:
+					is_int_key = true;
+					index = Z_LVAL_P(key);
+					break;
+				case IS_STRING: {
+					zend_ulong hval;
+					if (ZEND_HANDLE_NUMERIC(Z_STR_P(key), hval)) {
+						is_int_key = true;
+						index = (zend_long) hval;
+					}
+					break;
+				}
+				case IS_DOUBLE: {
+					zend_long lval = zend_dval_to_lval(Z_DVAL_P(key));
+					/* Incompatible float keys error at run-time */
+					if (!zend_is_long_compatible(Z_DVAL_P(key), lval)) {
+						goto scan_done;
+					}
+					is_int_key = true;
+					index = lval;
+					break;
+				}
+				case IS_FALSE:
+					is_int_key = true;
+					index = 0;
+					break;
+				case IS_TRUE:
+					is_int_key = true;
+					index = 1;
+					break;
+				case IS_NULL:
+					/* becomes the "" string key */
+					break;
+				default:
+					goto scan_done;
+			}
+			if (is_int_key) {
+				if (index != next_index) {
+					goto scan_done;
+				}
+				next_index++;
+			}
+		} else {
+			next_index++;
+		}
+	}
+
+scan_done:
+	/* A short prefix is not worth the extra constant; a full-length one
+	 * cannot occur here, as zend_try_ct_eval_array() would have handled
+	 * the literal already. */
+	if (i < 4 || i >= list->children) {
+		return 0;
+	}
+	prefix_len = i;
+
+	array_init_size(prefix, prefix_len);
+	for (i = 0; i < prefix_len; ++i) {
+		zend_ast *elem_ast = list->child[i];
+		zend_ast *key_ast = elem_ast->child[1];
+		zval *value = zend_ast_get_zval(elem_ast->child[0]);
+
+		Z_TRY_ADDREF_P(value);
+
+		if (key_ast) {
+			zval *key = zend_ast_get_zval(key_ast);
+			switch (Z_TYPE_P(key)) {
+				case IS_LONG:
+					zend_hash_index_update(Z_ARRVAL_P(prefix), Z_LVAL_P(key), value);
+					break;
+				case IS_STRING:
+					zend_symtable_update(Z_ARRVAL_P(prefix), Z_STR_P(key), value);
+					break;
+				case IS_DOUBLE:
+					zend_hash_index_update(Z_ARRVAL_P(prefix),
+						zend_dval_to_lval(Z_DVAL_P(key)), value);
+					break;
+				case IS_FALSE:
+					zend_hash_index_update(Z_ARRVAL_P(prefix), 0, value);
+					break;
+				case IS_TRUE:
+					zend_hash_index_update(Z_ARRVAL_P(prefix), 1, value);
+					break;
+				case IS_NULL:
+					zend_hash_update(Z_ARRVAL_P(prefix), ZSTR_EMPTY_ALLOC(), value);
+					break;
+				EMPTY_SWITCH_DEFAULT_CASE()
+			}
+		} else if (!zend_hash_next_index_insert(Z_ARRVAL_P(prefix), value)) {
+			zval_ptr_dtor_nogc(value);
+			zval_ptr_dtor(prefix);
+			return 0;
+		}
+	}
+
+	return prefix_len;
+}
+/* }}} */
+
 static void zend_compile_array(znode *result, zend_ast *ast) /* {{{ */
 {
 	zend_ast_list *list = zend_ast_get_list(ast);
 	zend_op *opline;
 	uint32_t i, opnum_init = -1;
 	bool packed = 1;
+	zval prefix;
 
 	if (zend_try_ct_eval_array(&result->u.constant, ast)) {
 		result->op_type = IS_CONST;
@@ -9970,7 +10111,20 @@ static void zend_compile_array(znode *result, zend_ast *ast) /* {{{ */
 	/* Empty arrays are handled at compile-time */
 	ZEND_ASSERT(list->children > 0);
 
-	for (i = 0; i < list->children; ++i) {
+	i = zend_try_ct_eval_array_prefix(list, &prefix);
+	if (i != 0) {
+		znode prefix_node;
+
+		prefix_node.op_type = IS_CONST;
+		ZVAL_COPY_VALUE(&prefix_node.u.constant, &prefix);
+
+		opnum_init = get_next_op_number();
+		zend_emit_op_tmp(result, ZEND_INIT_ARRAY, NULL, NULL);
+		opline = zend_emit_op(NULL, ZEND_ADD_ARRAY_UNPACK, &prefix_node, NULL);
+		SET_NODE(opline->result, result);
+	}
+
+	for (; i < list->children; ++i) {
 		zend_ast *elem_ast = list->child[i];
 		zend_ast *value_ast, *key_ast;
 		bool by_ref;
@@ -9984,7 +10138,7 @@ static void zend_compile_array(znode *result, zend_ast *ast) /* {{{ */
 
 		if (elem_ast->kind == ZEND_AST_UNPACK) {
 			zend_compile_expr(&value_node, value_ast);
-			if (i == 0) {
+			if (opnum_init == (uint32_t)-1) {
 				opnum_init = get_next_op_number();
 				opline = zend_emit_op_tmp(result, ZEND_INIT_ARRAY, NULL, NULL);
 			}
@@ -10009,7 +10163,7 @@ static void zend_compile_array(znode *result, zend_ast *ast) /* {{{ */
 			zend_compile_expr(&value_node, value_ast);
 		}
 
-		if (i == 0) {
+		if (opnum_init == (uint32_t)-1) {
 			opnum_init = get_next_op_number();
 			opline = zend_emit_op_tmp(result, ZEND_INIT_ARRAY, &value_node, key_node_ptr);
 			opline->extended_value = list->children << ZEND_ARRAY_SIZE_SHIFT;
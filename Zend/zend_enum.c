@@ -216,7 +216,6 @@ zend_result zend_enum_build_backed_enum_table(zend_class_entry *ce)
 		}
 
 		zval *c_value = &c->value;
-		zval *case_name = zend_enum_fetch_case_name(Z_OBJ_P(c_value));
 		zval *case_value = zend_enum_fetch_case_value(Z_OBJ_P(c_value));
 
 		if (ce->enum_backing_type != Z_TYPE_P(case_value)) {
@@ -226,31 +225,36 @@ zend_result zend_enum_build_backed_enum_table(zend_class_entry *ce)
 			goto failure;
 		}
 
+		/* All case constants are evaluated at this point, so the table can map
+		 * the backing value straight to the case object; dense int-backed
+		 * enums then resolve through the packed-array fast path of
+		 * zend_hash_index_find(). Internal enums still store the case name
+		 * because their case objects are created lazily per request. */
 		if (ce->enum_backing_type == IS_LONG) {
 			zend_long long_key = Z_LVAL_P(case_value);
-			zval *existing_case_name = zend_hash_index_find(backed_enum_table, long_key);
-			if (existing_case_name) {
+			zval *existing_case = zend_hash_index_find(backed_enum_table, long_key);
+			if (existing_case) {
 				zend_throw_error(NULL, "Duplicate value in enum %s for cases %s and %s",
 					ZSTR_VAL(enum_class_name),
-					Z_STRVAL_P(existing_case_name),
+					Z_STRVAL_P(zend_enum_fetch_case_name(Z_OBJ_P(existing_case))),
 					ZSTR_VAL(name));
 				goto failure;
 			}
-			Z_TRY_ADDREF_P(case_name);
-			zend_hash_index_add_new(backed_enum_table, long_key, case_name);
+			Z_ADDREF_P(c_value);
+			zend_hash_index_add_new(backed_enum_table, long_key, c_value);
 		} else {
 			ZEND_ASSERT(ce->enum_backing_type == IS_STRING);
 			zend_string *string_key = Z_STR_P(case_value);
-			zval *existing_case_name = zend_hash_find(backed_enum_table, string_key);
-			if (existing_case_name != NULL) {
+			zval *existing_case = zend_hash_find(backed_enum_table, string_key);
+			if (existing_case != NULL) {
 				zend_throw_error(NULL, "Duplicate value in enum %s for cases %s and %s",
 					ZSTR_VAL(enum_class_name),
-					Z_STRVAL_P(existing_case_name),
+					Z_STRVAL_P(zend_enum_fetch_case_name(Z_OBJ_P(existing_case))),
 					ZSTR_VAL(name));
 				goto failure;
 			}
-			Z_TRY_ADDREF_P(case_name);
-			zend_hash_add_new(backed_enum_table, string_key, case_name);
+			Z_ADDREF_P(c_value);
+			zend_hash_add_new(backed_enum_table, string_key, c_value);
 		}
 	} ZEND_HASH_FOREACH_END();
 
@@ -324,8 +328,14 @@ not_found:
 		return FAILURE;
 	}
 
-	// TODO: We might want to store pointers to constants in backed_enum_table instead of names,
-	// to make this lookup more efficient.
+	/* User enum tables map straight to the case object */
+	if (EXPECTED(Z_TYPE_P(case_name_zv) == IS_OBJECT)) {
+		*result = Z_OBJ_P(case_name_zv);
+		return SUCCESS;
+	}
+
+	/* Internal enum tables store the case name, as the case objects do not
+	 * exist yet when the table is registered */
 	ZEND_ASSERT(Z_TYPE_P(case_name_zv) == IS_STRING);
 	zend_class_constant *c = zend_hash_find_ptr(CE_CONSTANTS_TABLE(ce), Z_STR_P(case_name_zv));
 	ZEND_ASSERT(c != NULL);
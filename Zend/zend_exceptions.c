@@ -262,10 +262,14 @@ static zend_object *zend_default_exception_new(zend_class_entry *class_type) /*
 	zend_object *object = zend_objects_new(class_type);
 	object_properties_init(object, class_type);
 
-	if (EG(current_execute_data)) {
+	/* A negative trace limit skips backtrace capture altogether: code that
+	 * throws expected failures in bulk can ini_set() it around the hot
+	 * region, leaving getTrace() empty for those objects */
+	if (EG(current_execute_data) && EXPECTED(EG(exception_trace_limit) >= 0)) {
 		zend_fetch_debug_backtrace(&trace,
 			0,
-			EG(exception_ignore_args) ? DEBUG_BACKTRACE_IGNORE_ARGS : 0, 0);
+			EG(exception_ignore_args) ? DEBUG_BACKTRACE_IGNORE_ARGS : 0,
+			EG(exception_trace_limit) > 0 ? (int)EG(exception_trace_limit) : 0);
 	} else {
 		array_init(&trace);
 	}
@@ -3892,13 +3892,25 @@ ZEND_API void ZEND_FASTCALL zend_free_compiled_variables(zend_execute_data *exec
 }
 /* }}} */
 
+/* While a polling timeout is armed (zend.timeout_polling), amortize the
+ * deadline read over ZEND_TIMEOUT_POLL_INTERVAL interrupt checks; the poll
+ * raises vm_interrupt itself, so the existing dispatch below handles it. */
+#define ZEND_VM_TIMEOUT_POLL_CHECK() do { \
+		if (UNEXPECTED(EG(timeout_deadline) != 0) \
+		 && UNEXPECTED(--EG(timeout_poll_countdown) == 0)) { \
+			zend_timeout_poll(); \
+		} \
+	} while (0)
+
 #define ZEND_VM_INTERRUPT_CHECK() do { \
+		ZEND_VM_TIMEOUT_POLL_CHECK(); \
 		if (UNEXPECTED(zend_atomic_bool_load_ex(&EG(vm_interrupt)))) { \
 			ZEND_VM_INTERRUPT(); \
 		} \
 	} while (0)
 
 #define ZEND_VM_LOOP_INTERRUPT_CHECK() do { \
+		ZEND_VM_TIMEOUT_POLL_CHECK(); \
 		if (UNEXPECTED(zend_atomic_bool_load_ex(&EG(vm_interrupt)))) { \
 			ZEND_VM_LOOP_INTERRUPT(); \
 		} \
@@ -4030,6 +4042,8 @@ static zend_always_inline void i_init_func_execute_data(zend_op_array *op_array,
 }
 /* }}} */
 
+ZEND_API void (*zend_init_run_time_cache_hook)(zend_op_array *op_array, void **run_time_cache) = NULL;
+
 static zend_always_inline void init_func_run_time_cache_i(zend_op_array *op_array) /* {{{ */
 {
 	void **run_time_cache;
@@ -4038,6 +4052,9 @@ static zend_always_inline void init_func_run_time_cache_i(zend_op_array *op_arra
 	run_time_cache = zend_arena_alloc(&CG(arena), op_array->cache_size);
 	memset(run_time_cache, 0, op_array->cache_size);
 	ZEND_MAP_PTR_SET(op_array->run_time_cache, run_time_cache);
+	if (UNEXPECTED(zend_init_run_time_cache_hook != NULL)) {
+		zend_init_run_time_cache_hook(op_array, run_time_cache);
+	}
 }
 /* }}} */
 
@@ -4747,7 +4764,12 @@ static zend_never_inline zend_execute_data *zend_init_dynamic_call_object(zend_o
 	zend_object *object;
 	uint32_t call_info;
 
-	if (EXPECTED(function->handlers->get_closure) &&
+	if (EXPECTED(function->ce == zend_ce_closure)) {
+		/* Direct path for plain closures.  Closure is final, so the class
+		 * check fully devirtualizes the get_closure handler dispatch that
+		 * otherwise dominates dynamic-call setup in closure-heavy code. */
+		fbc = zend_get_closure_callable(function, &object_or_called_scope, &call_info);
+	} else if (EXPECTED(function->handlers->get_closure) &&
 	    EXPECTED(function->handlers->get_closure(function, &called_scope, &fbc, &object, 0) == SUCCESS)) {
 
 		object_or_called_scope = called_scope;
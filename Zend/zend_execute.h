@@ -41,6 +41,12 @@ void shutdown_executor(void);
 void shutdown_destructors(void);
 ZEND_API void zend_shutdown_executor_values(bool fast_shutdown);
 
+/* Allocate request-lifetime memory from a per-request bump arena.
+ * The memory cannot be freed individually; it is released as a whole
+ * at executor shutdown. Intended for many short-lived allocations that
+ * would otherwise pay per-chunk free-list maintenance in the Zend MM. */
+ZEND_API void *zend_request_arena_alloc(size_t size);
+
 ZEND_API void zend_init_execute_data(zend_execute_data *execute_data, zend_op_array *op_array, zval *return_value);
 ZEND_API void zend_init_func_execute_data(zend_execute_data *execute_data, zend_op_array *op_array, zval *return_value);
 ZEND_API void zend_init_code_execute_data(zend_execute_data *execute_data, zend_op_array *op_array, zval *return_value);
@@ -50,6 +56,8 @@ ZEND_API void execute_internal(zend_execute_data *execute_data, zval *return_val
 ZEND_API bool zend_is_valid_class_name(zend_string *name);
 ZEND_API zend_class_entry *zend_lookup_class(zend_string *name);
 ZEND_API zend_class_entry *zend_lookup_class_ex(zend_string *name, zend_string *lcname, uint32_t flags);
+ZEND_API void zend_reset_failed_autoload_cache(void);
+ZEND_API void zend_reset_static_state(void);
 ZEND_API zend_class_entry *zend_get_called_scope(zend_execute_data *ex);
 ZEND_API zend_object *zend_get_this_object(zend_execute_data *ex);
 ZEND_API zend_result zend_eval_string(const char *str, zval *retval_ptr, const char *string_name);
@@ -396,6 +404,11 @@ ZEND_API ZEND_COLD void ZEND_FASTCALL zend_cannot_pass_by_reference(uint32_t arg
 ZEND_API void zend_set_timeout(zend_long seconds, bool reset_signals);
 ZEND_API void zend_unset_timeout(void);
 ZEND_API ZEND_NORETURN void ZEND_FASTCALL zend_timeout(void);
+
+/* Interrupt checks between two deadline reads in polling timeout mode */
+#define ZEND_TIMEOUT_POLL_INTERVAL 1024
+
+ZEND_API void ZEND_FASTCALL zend_timeout_poll(void);
 ZEND_API zend_class_entry *zend_fetch_class(zend_string *class_name, uint32_t fetch_type);
 ZEND_API zend_class_entry *zend_fetch_class_with_scope(zend_string *class_name, uint32_t fetch_type, zend_class_entry *scope);
 ZEND_API zend_class_entry *zend_fetch_class_by_name(zend_string *class_name, zend_string *lcname, uint32_t fetch_type);
@@ -404,6 +417,10 @@ ZEND_API zend_function * ZEND_FASTCALL zend_fetch_function(zend_string *name);
 ZEND_API zend_function * ZEND_FASTCALL zend_fetch_function_str(const char *name, size_t len);
 ZEND_API void ZEND_FASTCALL zend_init_func_run_time_cache(zend_op_array *op_array);
 
+/* Invoked right after a fresh run-time cache has been zeroed, so that an
+ * accelerator may pre-populate cache slots (e.g. from shared memory). */
+extern ZEND_API void (*zend_init_run_time_cache_hook)(zend_op_array *op_array, void **run_time_cache);
+
 ZEND_API void zend_fetch_dimension_const(zval *result, zval *container, zval *dim, int type);
 
 ZEND_API zval* zend_get_compiled_variable_value(const zend_execute_data *execute_data_ptr, uint32_t var);
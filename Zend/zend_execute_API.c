@@ -39,6 +39,8 @@
 #include "zend_observer.h"
 #include "zend_call_stack.h"
 #include "zend_frameless_function.h"
+#include "zend_hrtime.h"
+#include "zend_virtual_cwd.h"
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
@@ -61,6 +63,14 @@ ZEND_API const zend_fcall_info_cache empty_fcall_info_cache = {0};
 ZEND_TLS HANDLE tq_timer = NULL;
 #endif
 
+#if defined(HAVE_SETITIMER) && !defined(ZTS) && !defined(ZEND_WIN32)
+/* Engine sampling profiler; the implementation sits next to the timeout
+ * machinery below. */
+# define ZEND_VM_SAMPLER 1
+static void zend_vm_sampler_activate(void);
+static void zend_vm_sampler_deactivate(void);
+#endif
+
 #if 0&&ZEND_DEBUG
 static void (*original_sigsegv_handler)(int);
 static void zend_handle_sigsegv(void) /* {{{ */
@@ -148,6 +158,7 @@ void init_executor(void) /* {{{ */
 	EG(class_table) = CG(class_table);
 
 	EG(in_autoload) = NULL;
+	EG(failed_autoload) = NULL;
 	EG(error_handling) = EH_NORMAL;
 	EG(flags) = EG_FLAGS_INITIAL;
 
@@ -171,6 +182,8 @@ void init_executor(void) /* {{{ */
 	zend_stack_init(&EG(user_exception_handlers), sizeof(zval));
 
 	zend_objects_store_init(&EG(objects_store), 1024);
+	memset(&EG(objects_recycle), 0, sizeof(EG(objects_recycle)));
+	memset(&EG(generator_recycle), 0, sizeof(EG(generator_recycle)));
 
 	EG(full_tables_cleanup) = 0;
 	ZEND_ATOMIC_BOOL_INIT(&EG(vm_interrupt), false);
@@ -200,14 +213,30 @@ void init_executor(void) /* {{{ */
 	EG(filename_override) = NULL;
 	EG(lineno_override) = -1;
 
+	EG(request_arena) = NULL;
+	EG(attribute_value_cache) = NULL;
+
 	zend_max_execution_timer_init();
 	zend_fiber_init();
 	zend_weakrefs_init();
 
+#ifdef ZEND_VM_SAMPLER
+	zend_vm_sampler_activate();
+#endif
+
 	EG(active) = 1;
 }
 /* }}} */
 
+ZEND_API void *zend_request_arena_alloc(size_t size) /* {{{ */
+{
+	if (UNEXPECTED(!EG(request_arena))) {
+		EG(request_arena) = zend_arena_create(64 * 1024);
+	}
+	return zend_arena_alloc(&EG(request_arena), size);
+}
+/* }}} */
+
 static int zval_call_destructor(zval *zv) /* {{{ */
 {
 	if (Z_TYPE_P(zv) == IS_INDIRECT) {
@@ -269,6 +298,17 @@ void shutdown_destructors(void) /* {{{ */
 /* }}} */
 
 /* Free values held by the executor. */
+static zend_always_inline void zend_op_array_drop_static_variables(zend_op_array *op_array)
+{
+	if (ZEND_MAP_PTR(op_array->static_variables_ptr)) {
+		HashTable *ht = ZEND_MAP_PTR_GET(op_array->static_variables_ptr);
+		if (ht) {
+			zend_array_destroy(ht);
+			ZEND_MAP_PTR_SET(op_array->static_variables_ptr, NULL);
+		}
+	}
+}
+
 ZEND_API void zend_shutdown_executor_values(bool fast_shutdown)
 {
 	zend_string *key;
@@ -310,13 +350,7 @@ ZEND_API void zend_shutdown_executor_values(bool fast_shutdown)
 			if (op_array->type == ZEND_INTERNAL_FUNCTION) {
 				break;
 			}
-			if (ZEND_MAP_PTR(op_array->static_variables_ptr)) {
-				HashTable *ht = ZEND_MAP_PTR_GET(op_array->static_variables_ptr);
-				if (ht) {
-					zend_array_destroy(ht);
-					ZEND_MAP_PTR_SET(op_array->static_variables_ptr, NULL);
-				}
-			}
+			zend_op_array_drop_static_variables(op_array);
 		} ZEND_HASH_FOREACH_END();
 		ZEND_HASH_MAP_REVERSE_FOREACH_VAL(EG(class_table), zv) {
 			zend_class_entry *ce = Z_PTR_P(zv);
@@ -362,13 +396,7 @@ ZEND_API void zend_shutdown_executor_values(bool fast_shutdown)
 				zend_op_array *op_array;
 				ZEND_HASH_MAP_FOREACH_PTR(&ce->function_table, op_array) {
 					if (op_array->type == ZEND_USER_FUNCTION) {
-						if (ZEND_MAP_PTR(op_array->static_variables_ptr)) {
-							HashTable *ht = ZEND_MAP_PTR_GET(op_array->static_variables_ptr);
-							if (ht) {
-								zend_array_destroy(ht);
-								ZEND_MAP_PTR_SET(op_array->static_variables_ptr, NULL);
-							}
-						}
+						zend_op_array_drop_static_variables(op_array);
 					}
 				} ZEND_HASH_FOREACH_END();
 			}
@@ -389,6 +417,13 @@ ZEND_API void zend_shutdown_executor_values(bool fast_shutdown)
 		zend_stack_clean(&EG(user_error_handlers), (void (*)(void *))ZVAL_PTR_DTOR, 1);
 		zend_stack_clean(&EG(user_exception_handlers), (void (*)(void *))ZVAL_PTR_DTOR, 1);
 
+		/* Memoized attribute arguments may hold objects (e.g. enum cases). */
+		if (EG(attribute_value_cache)) {
+			zend_hash_destroy(EG(attribute_value_cache));
+			FREE_HASHTABLE(EG(attribute_value_cache));
+			EG(attribute_value_cache) = NULL;
+		}
+
 #if ZEND_DEBUG
 		if (!CG(unclean_shutdown)) {
 			gc_collect_cycles();
@@ -399,6 +434,11 @@ ZEND_API void zend_shutdown_executor_values(bool fast_shutdown)
 	}
 
 	zend_objects_store_free_object_storage(&EG(objects_store), fast_shutdown);
+
+	if (!fast_shutdown) {
+		zend_objects_recycle_flush();
+		zend_generator_frame_recycle_flush();
+	}
 }
 
 void shutdown_executor(void) /* {{{ */
@@ -411,12 +451,21 @@ void shutdown_executor(void) /* {{{ */
 	bool fast_shutdown = is_zend_mm() && !EG(full_tables_cleanup);
 #endif
 
+#ifdef ZEND_VM_SAMPLER
+	zend_vm_sampler_deactivate();
+#endif
+
 	zend_try {
 		zend_stream_shutdown();
 	} zend_end_try();
 
 	zend_shutdown_executor_values(fast_shutdown);
 
+	if (EG(request_arena)) {
+		zend_arena_destroy(EG(request_arena));
+		EG(request_arena) = NULL;
+	}
+
 	zend_weakrefs_shutdown();
 	zend_max_execution_timer_shutdown();
 	zend_fiber_shutdown();
@@ -474,6 +523,10 @@ void shutdown_executor(void) /* {{{ */
 			zend_hash_destroy(EG(in_autoload));
 			FREE_HASHTABLE(EG(in_autoload));
 		}
+		if (EG(failed_autoload)) {
+			zend_hash_destroy(EG(failed_autoload));
+			FREE_HASHTABLE(EG(failed_autoload));
+		}
 
 		if (EG(ht_iterators) != EG(ht_iterators_slots)) {
 			efree(EG(ht_iterators));
@@ -1203,6 +1256,19 @@ ZEND_API zend_class_entry *zend_lookup_class_ex(zend_string *name, zend_string *
 		return NULL;
 	}
 
+	/* Negative cache: the autoloader already came back empty for this name
+	 * during this request (polyfill-style class_exists() probes), so don't
+	 * run it again.  Registering another autoloader or clearing the stat
+	 * cache (the filesystem changed, e.g. a class file was generated)
+	 * clears the cache, and a later manual declaration is found in
+	 * EG(class_table) above. */
+	if (EG(failed_autoload) && zend_hash_exists(EG(failed_autoload), lc_name)) {
+		if (!key) {
+			zend_string_release_ex(lc_name, 0);
+		}
+		return NULL;
+	}
+
 	/* Verify class name before passing it to the autoloader. */
 	if (!key && !ZSTR_HAS_CE_CACHE(name) && !zend_is_valid_class_name(name)) {
 		zend_string_release_ex(lc_name, 0);
@@ -1240,6 +1306,14 @@ ZEND_API zend_class_entry *zend_lookup_class_ex(zend_string *name, zend_string *
 	zend_string_release_ex(autoload_name, 0);
 	zend_hash_del(EG(in_autoload), lc_name);
 
+	if (!ce && !EG(exception)) {
+		if (!EG(failed_autoload)) {
+			ALLOC_HASHTABLE(EG(failed_autoload));
+			zend_hash_init(EG(failed_autoload), 8, NULL, NULL, 0);
+		}
+		zend_hash_add_empty_element(EG(failed_autoload), lc_name);
+	}
+
 	if (!key) {
 		zend_string_release_ex(lc_name, 0);
 	}
@@ -1253,6 +1327,57 @@ ZEND_API zend_class_entry *zend_lookup_class_ex(zend_string *name, zend_string *
 }
 /* }}} */
 
+/* Reset per-request mutable engine state back to its post-declaration
+ * defaults: global variables, function static variables and class static
+ * properties.  Meant for long-running SAPIs (embed) between logical
+ * requests, with no user code on the stack.  Statics of immutable
+ * (preloaded/opcached) functions and classes are dropped here and lazily
+ * re-initialized from their shared defaults on next use, so with the
+ * bootstrap done in a preload script this amounts to a copy-on-write
+ * restore of the post-bootstrap snapshot. */
+ZEND_API void zend_reset_static_state(void) /* {{{ */
+{
+	zval *zv;
+
+	zend_hash_graceful_reverse_destroy(&EG(symbol_table));
+	zend_hash_init(&EG(symbol_table), 64, NULL, ZVAL_PTR_DTOR, 0);
+
+	ZEND_HASH_MAP_REVERSE_FOREACH_VAL(EG(function_table), zv) {
+		zend_op_array *op_array = Z_PTR_P(zv);
+
+		if (op_array->type == ZEND_INTERNAL_FUNCTION) {
+			break;
+		}
+		zend_op_array_drop_static_variables(op_array);
+	} ZEND_HASH_FOREACH_END();
+
+	ZEND_HASH_MAP_REVERSE_FOREACH_VAL(EG(class_table), zv) {
+		zend_class_entry *ce = Z_PTR_P(zv);
+
+		if (ce->default_static_members_count) {
+			zend_cleanup_internal_class_data(ce);
+		}
+		if (ce->ce_flags & ZEND_HAS_STATIC_IN_METHODS) {
+			zend_op_array *op_array;
+
+			ZEND_HASH_MAP_FOREACH_PTR(&ce->function_table, op_array) {
+				if (op_array->type == ZEND_USER_FUNCTION) {
+					zend_op_array_drop_static_variables(op_array);
+				}
+			} ZEND_HASH_FOREACH_END();
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+/* }}} */
+
+ZEND_API void zend_reset_failed_autoload_cache(void) /* {{{ */
+{
+	if (EG(failed_autoload)) {
+		zend_hash_clean(EG(failed_autoload));
+	}
+}
+/* }}} */
+
 ZEND_API zend_class_entry *zend_lookup_class(zend_string *name) /* {{{ */
 {
 	return zend_lookup_class_ex(name, NULL, 0);
@@ -1610,13 +1735,45 @@ void zend_set_timeout(zend_long seconds, bool reset_signals) /* {{{ */
 {
 
 	EG(timeout_seconds) = seconds;
+
+	if (EG(timeout_polling)) {
+		/* The deadline is checked at VM interrupt points; no timer is armed
+		 * and no signal is delivered, so profilers using SIGPROF/SIGALRM are
+		 * not disturbed and the per-request timer syscalls are saved. */
+		EG(timeout_deadline) = seconds
+			? zend_hrtime() + (zend_hrtime_t)seconds * ZEND_NANO_IN_SEC
+			: 0;
+		EG(timeout_poll_countdown) = ZEND_TIMEOUT_POLL_INTERVAL;
+		zend_atomic_bool_store_ex(&EG(timed_out), false);
+		return;
+	}
+
+	EG(timeout_deadline) = 0;
 	zend_set_timeout_ex(seconds, reset_signals);
 	zend_atomic_bool_store_ex(&EG(timed_out), false);
 }
 /* }}} */
 
+/* Slow path of the deadline check in ZEND_VM_INTERRUPT_CHECK(): entered once
+ * every ZEND_TIMEOUT_POLL_INTERVAL checks while a polling timeout is armed. */
+ZEND_API void ZEND_FASTCALL zend_timeout_poll(void) /* {{{ */
+{
+	EG(timeout_poll_countdown) = ZEND_TIMEOUT_POLL_INTERVAL;
+	if (zend_hrtime() >= EG(timeout_deadline)) {
+		EG(timeout_deadline) = 0;
+		zend_atomic_bool_store_ex(&EG(timed_out), true);
+		zend_atomic_bool_store_ex(&EG(vm_interrupt), true);
+	}
+}
+/* }}} */
+
 void zend_unset_timeout(void) /* {{{ */
 {
+	if (EG(timeout_polling)) {
+		EG(timeout_deadline) = 0;
+		zend_atomic_bool_store_ex(&EG(timed_out), false);
+		return;
+	}
 #ifdef ZEND_WIN32
 	if (NULL != tq_timer) {
 		if (!DeleteTimerQueueTimer(NULL, tq_timer, INVALID_HANDLE_VALUE)) {
@@ -1646,6 +1803,148 @@ void zend_unset_timeout(void) /* {{{ */
 }
 /* }}} */
 
+#ifdef ZEND_VM_SAMPLER
+/* Sampling profiler: a cheap virtual interval timer (zend.vm_sampler_interval,
+ * milliseconds of consumed CPU time) raises SIGVTALRM, whose handler only
+ * requests a VM interrupt. The sample itself is taken at the next safe point
+ * through zend_interrupt_function, where the executing file:line is counted
+ * in a per-request table; shutdown_executor() appends the aggregated counts
+ * to zend.vm_sampler_output. Sampling CPU time rather than wall time means
+ * idle workers never fire and the overhead is bounded by the rate alone. */
+
+static void (*vm_sampler_prev_interrupt_function)(zend_execute_data *execute_data);
+static bool vm_sampler_interrupt_installed = false;
+
+static void zend_vm_sampler_handler(int dummy) /* {{{ */
+{
+	if (EG(vm_sampler_active)) {
+		zend_atomic_bool_store_ex(&EG(vm_sampler_pending), true);
+		zend_atomic_bool_store_ex(&EG(vm_interrupt), true);
+	}
+}
+/* }}} */
+
+static void zend_vm_sampler_interrupt(zend_execute_data *execute_data) /* {{{ */
+{
+	if (EG(vm_sampler_active)
+	 && zend_atomic_bool_exchange_ex(&EG(vm_sampler_pending), false)) {
+		zend_execute_data *ex = execute_data;
+
+		/* attribute samples taken in internal functions to their nearest
+		 * user-code caller */
+		while (ex && (!ex->func || !ZEND_USER_CODE(ex->func->type))) {
+			ex = ex->prev_execute_data;
+		}
+		if (ex && ex->func->op_array.filename) {
+			char key[MAXPATHLEN + 32];
+			int len = snprintf(key, sizeof(key), "%s:%u",
+				ZSTR_VAL(ex->func->op_array.filename), (unsigned int)ex->opline->lineno);
+			zval *count = zend_hash_str_find(&EG(vm_sampler_counts), key, len);
+
+			if (count) {
+				Z_LVAL_P(count)++;
+			} else {
+				zval tmp;
+
+				ZVAL_LONG(&tmp, 1);
+				zend_hash_str_add_new(&EG(vm_sampler_counts), key, len, &tmp);
+			}
+		}
+	}
+	if (vm_sampler_prev_interrupt_function) {
+		vm_sampler_prev_interrupt_function(execute_data);
+	}
+}
+/* }}} */
+
+static void zend_vm_sampler_activate(void) /* {{{ */
+{
+	struct itimerval t;
+	zend_long interval = EG(vm_sampler_interval);
+
+	if (interval <= 0 || !EG(vm_sampler_output) || !EG(vm_sampler_output)[0]) {
+		return;
+	}
+
+	if (!vm_sampler_interrupt_installed) {
+		vm_sampler_prev_interrupt_function = zend_interrupt_function;
+		zend_interrupt_function = zend_vm_sampler_interrupt;
+		vm_sampler_interrupt_installed = true;
+	}
+
+	zend_hash_init(&EG(vm_sampler_counts), 64, NULL, NULL, 0);
+	zend_atomic_bool_store_ex(&EG(vm_sampler_pending), false);
+	EG(vm_sampler_active) = true;
+
+#ifdef ZEND_SIGNALS
+	zend_signal(SIGVTALRM, zend_vm_sampler_handler);
+#else
+	{
+		sigset_t sigset;
+# ifdef HAVE_SIGACTION
+		struct sigaction act;
+
+		act.sa_handler = zend_vm_sampler_handler;
+		sigemptyset(&act.sa_mask);
+		act.sa_flags = SA_ONSTACK;
+		sigaction(SIGVTALRM, &act, NULL);
+# else
+		signal(SIGVTALRM, zend_vm_sampler_handler);
+# endif
+		sigemptyset(&sigset);
+		sigaddset(&sigset, SIGVTALRM);
+		sigprocmask(SIG_UNBLOCK, &sigset, NULL);
+	}
+#endif
+
+	t.it_value.tv_sec = t.it_interval.tv_sec = interval / 1000;
+	t.it_value.tv_usec = t.it_interval.tv_usec = (interval % 1000) * 1000;
+	setitimer(ITIMER_VIRTUAL, &t, NULL);
+}
+/* }}} */
+
+/* Appends one "file:line count" row per sampled location. Workers sharing
+ * an output file append whole rows, which O_APPEND keeps intact for writes
+ * of this size; aggregation across workers is a post-processing step. */
+static void zend_vm_sampler_dump(void) /* {{{ */
+{
+	FILE *fp;
+	zend_string *key;
+	zval *zv;
+
+	if (zend_hash_num_elements(&EG(vm_sampler_counts)) == 0) {
+		return;
+	}
+
+	fp = fopen(EG(vm_sampler_output), "ab");
+	if (!fp) {
+		return;
+	}
+	ZEND_HASH_MAP_FOREACH_STR_KEY_VAL(&EG(vm_sampler_counts), key, zv) {
+		fprintf(fp, "%s " ZEND_LONG_FMT "\n", ZSTR_VAL(key), Z_LVAL_P(zv));
+	} ZEND_HASH_FOREACH_END();
+	fclose(fp);
+}
+/* }}} */
+
+static void zend_vm_sampler_deactivate(void) /* {{{ */
+{
+	struct itimerval no_interval;
+
+	if (!EG(vm_sampler_active)) {
+		return;
+	}
+
+	memset(&no_interval, 0, sizeof(no_interval));
+	setitimer(ITIMER_VIRTUAL, &no_interval, NULL);
+	EG(vm_sampler_active) = false;
+
+	zend_vm_sampler_dump();
+	zend_hash_destroy(&EG(vm_sampler_counts));
+}
+/* }}} */
+#endif /* ZEND_VM_SAMPLER */
+
 static ZEND_COLD void report_class_fetch_error(zend_string *class_name, uint32_t fetch_type)
 {
 	if (fetch_type & ZEND_FETCH_CLASS_SILENT) {
@@ -1873,6 +2172,47 @@ ZEND_API void zend_detach_symbol_table(zend_execute_data *execute_data) /* {{{ *
 }
 /* }}} */
 
+ZEND_API zval *zend_get_local_var(zend_string *name) /* {{{ */
+{
+	zend_execute_data *execute_data = EG(current_execute_data);
+
+	while (execute_data && (!execute_data->func || !ZEND_USER_CODE(execute_data->func->common.type))) {
+		execute_data = execute_data->prev_execute_data;
+	}
+
+	if (!execute_data) {
+		return NULL;
+	}
+
+	if (!(EX_CALL_INFO() & ZEND_CALL_HAS_SYMBOL_TABLE)) {
+		/* Look the name up in the CV slots directly instead of
+		 * materializing the whole symbol table for one read. */
+		zend_ulong h = zend_string_hash_val(name);
+		zend_op_array *op_array = &execute_data->func->op_array;
+
+		if (EXPECTED(op_array->last_var)) {
+			zend_string **str = op_array->vars;
+			zend_string **end = str + op_array->last_var;
+
+			do {
+				if (ZSTR_H(*str) == h &&
+				    zend_string_equal_content(*str, name)) {
+					zval *var = EX_VAR_NUM(str - op_array->vars);
+					if (Z_TYPE_P(var) == IS_UNDEF) {
+						return NULL;
+					}
+					return var;
+				}
+				str++;
+			} while (str != end);
+		}
+		return NULL;
+	}
+
+	return zend_hash_find_ind(execute_data->symbol_table, name);
+}
+/* }}} */
+
 ZEND_API zend_result zend_set_local_var(zend_string *name, zval *value, bool force) /* {{{ */
 {
 	zend_execute_data *execute_data = EG(current_execute_data);
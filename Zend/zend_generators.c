@@ -130,6 +130,94 @@ static void zend_generator_cleanup_unfinished_execution(
 }
 /* }}} */
 
+/* Short-lived generators allocate and free a heap frame per instance.  Keep
+ * freed frames on per-op_array free lists (hashed into a small slot table,
+ * like the object recycler), so creating the next generator for the same
+ * function turns into a pointer swap instead of a trip through the
+ * allocator.  Correctness hinges on the recorded block size, not on the
+ * op_array pointer: a slot is only reused when the requested size matches,
+ * so an op_array freed and reallocated at the same address can not hand out
+ * an undersized block. */
+
+static zend_always_inline zend_generator_recycle_slot *zend_generator_recycle_slot_for(const zend_op_array *op_array)
+{
+	return &EG(generator_recycle).slots[(((uintptr_t)op_array) >> 6) & (ZEND_GENERATOR_RECYCLE_NUM_SLOTS - 1)];
+}
+
+static void zend_generator_recycle_slot_flush(zend_generator_recycle_slot *slot)
+{
+	void *frame = slot->head;
+
+	while (frame) {
+		void *next = *(void**)frame;
+
+		efree(frame);
+		frame = next;
+	}
+	slot->head = NULL;
+	slot->count = 0;
+}
+
+ZEND_API zend_execute_data *ZEND_FASTCALL zend_generator_frame_alloc(const zend_op_array *op_array, uint32_t size) /* {{{ */
+{
+	zend_generator_recycle_slot *slot = zend_generator_recycle_slot_for(op_array);
+
+	if (EXPECTED(slot->op_array == op_array)
+	 && EXPECTED(slot->size == size)
+	 && EXPECTED(slot->head != NULL)) {
+		void *frame = slot->head;
+
+		slot->head = *(void**)frame;
+		slot->count--;
+		return (zend_execute_data*)frame;
+	}
+	return (zend_execute_data*)emalloc(size);
+}
+/* }}} */
+
+ZEND_API void ZEND_FASTCALL zend_generator_frame_free(zend_execute_data *execute_data) /* {{{ */
+{
+	const zend_op_array *op_array = &EX(func)->op_array;
+
+	/* Only frames without extra (variadic) arguments have a size derived
+	 * from the op_array alone; free the rest as before. */
+	if (EXPECTED(ZEND_CALL_NUM_ARGS(execute_data) <= op_array->num_args)) {
+		zend_generator_recycle_slot *slot = zend_generator_recycle_slot_for(op_array);
+		uint32_t size = (ZEND_CALL_FRAME_SLOT + op_array->last_var + op_array->T) * sizeof(zval);
+
+		if (slot->op_array != op_array || slot->size != size) {
+			if (slot->head) {
+				zend_generator_recycle_slot_flush(slot);
+			}
+			slot->op_array = op_array;
+			slot->size = size;
+		}
+		if (EXPECTED(slot->count < ZEND_GENERATOR_RECYCLE_MAX_FRAMES)) {
+			*(void**)execute_data = slot->head;
+			slot->head = execute_data;
+			slot->count++;
+			return;
+		}
+	}
+	efree(execute_data);
+}
+/* }}} */
+
+ZEND_API void ZEND_FASTCALL zend_generator_frame_recycle_flush(void) /* {{{ */
+{
+	zend_generator_recycle_slot *slot = EG(generator_recycle).slots;
+	zend_generator_recycle_slot *end = slot + ZEND_GENERATOR_RECYCLE_NUM_SLOTS;
+
+	do {
+		if (slot->head) {
+			zend_generator_recycle_slot_flush(slot);
+		}
+		slot->op_array = NULL;
+		slot++;
+	} while (slot != end);
+}
+/* }}} */
+
 ZEND_API void zend_generator_close(zend_generator *generator, bool finished_execution) /* {{{ */
 {
 	if (EXPECTED(generator->execute_data)) {
@@ -166,7 +254,7 @@ ZEND_API void zend_generator_close(zend_generator *generator, bool finished_exec
 			zend_generator_cleanup_unfinished_execution(generator, execute_data, 0);
 		}
 
-		efree(execute_data);
+		zend_generator_frame_free(execute_data);
 	}
 }
 /* }}} */
@@ -106,6 +106,10 @@ void zend_register_generator_ce(void);
 ZEND_API void zend_generator_close(zend_generator *generator, bool finished_execution);
 ZEND_API void zend_generator_resume(zend_generator *generator);
 
+ZEND_API zend_execute_data *ZEND_FASTCALL zend_generator_frame_alloc(const zend_op_array *op_array, uint32_t size);
+ZEND_API void ZEND_FASTCALL zend_generator_frame_free(zend_execute_data *execute_data);
+ZEND_API void ZEND_FASTCALL zend_generator_frame_recycle_flush(void);
+
 ZEND_API void zend_generator_restore_call_stack(zend_generator *generator);
 ZEND_API zend_execute_data* zend_generator_freeze_call_stack(zend_execute_data *execute_data);
 
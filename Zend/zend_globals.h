@@ -80,6 +80,21 @@ typedef enum {
 	ZEND_MEMOIZE_FETCH,
 } zend_memoize_mode;
 
+/* recycled generator frames; see zend_generator_frame_* in zend_generators.c */
+#define ZEND_GENERATOR_RECYCLE_NUM_SLOTS  16 /* power of two */
+#define ZEND_GENERATOR_RECYCLE_MAX_FRAMES 32 /* per slot */
+
+typedef struct _zend_generator_recycle_slot {
+	const zend_op_array *op_array;
+	void                *head;
+	uint32_t             size;
+	uint32_t             count;
+} zend_generator_recycle_slot;
+
+typedef struct _zend_generator_recycle {
+	zend_generator_recycle_slot slots[ZEND_GENERATOR_RECYCLE_NUM_SLOTS];
+} zend_generator_recycle;
+
 struct _zend_compiler_globals {
 	zend_stack loop_var_stack;
 
@@ -136,6 +151,9 @@ struct _zend_compiler_globals {
 
 	zend_ast *ast;
 	zend_arena *ast_arena;
+	/* emptied AST arena kept for reuse between compilations, so bulk
+	 * compiles (preloading, warm-up) do not recreate it per file */
+	zend_arena *ast_arena_cache;
 
 	zend_stack delayed_oplines_stack;
 	HashTable *memoized_exprs;
@@ -211,6 +229,9 @@ struct _zend_executor_globals {
 	zend_atomic_bool timed_out;
 
 	HashTable *in_autoload;
+	/* lowercased class names the autoloader failed to produce during this
+	 * request; cleared when another autoloader is registered */
+	HashTable *failed_autoload;
 
 	zend_long hard_timeout;
 	void *stack_base;
@@ -239,11 +260,19 @@ struct _zend_executor_globals {
 	/* timeout support */
 	zend_long timeout_seconds;
 
+	/* polling timeout mode (zend.timeout_polling): deadline in zend_hrtime()
+	 * nanoseconds, checked at VM interrupt points; 0 while no timeout armed */
+	bool timeout_polling;
+	uint64_t timeout_deadline;
+	uint32_t timeout_poll_countdown;
+
 	HashTable *ini_directives;
 	HashTable *modified_ini_directives;
 	zend_ini_entry *error_reporting_ini_entry;
 
 	zend_objects_store objects_store;
+	zend_objects_recycle objects_recycle;
+	zend_generator_recycle generator_recycle;
 	zend_object *exception, *prev_exception;
 	const zend_op *opline_before_exception;
 	zend_op exception_op[3];
@@ -272,6 +301,16 @@ struct _zend_executor_globals {
 
 	zend_long exception_string_param_max_len;
 
+	/* maximum number of frames captured in exception traces, 0 for no limit */
+	zend_long exception_trace_limit;
+
+	/* sampling profiler state; see zend_vm_sampler_* in zend_execute_API.c */
+	bool vm_sampler_active;
+	zend_atomic_bool vm_sampler_pending;
+	zend_long vm_sampler_interval;
+	char *vm_sampler_output;
+	HashTable vm_sampler_counts;
+
 	zend_get_gc_buffer get_gc_buffer;
 
 	zend_fiber_context *main_fiber_context;
@@ -293,6 +332,14 @@ struct _zend_executor_globals {
 	zend_string *filename_override;
 	zend_long lineno_override;
 
+	/* Lazily created bump allocator for request-lifetime data, released
+	 * wholesale in shutdown_executor(). See zend_request_arena_alloc(). */
+	zend_arena *request_arena;
+
+	/* Lazily created memoization table for evaluated attribute arguments,
+	 * keyed by the argument slot address. See zend_get_attribute_value(). */
+	HashTable *attribute_value_cache;
+
 #ifdef ZEND_CHECK_STACK_LIMIT
 	zend_call_stack call_stack;
 	zend_long max_allowed_stack_size;
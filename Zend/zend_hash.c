@@ -751,12 +751,18 @@ static zend_always_inline Bucket *zend_hash_find_bucket(const HashTable *ht, con
 	}
 
 	while (1) {
+		idx = Z_NEXT(p->val);
+		if (idx != HT_INVALID_IDX) {
+			/* Overlap the fetch of the next colliding bucket with the key
+			 * comparison below; on large tables every chain hop is otherwise
+			 * a dependent cache miss. */
+			ZEND_PREFETCH(HT_HASH_TO_BUCKET_EX(arData, idx));
+		}
 		if (p->h == ZSTR_H(key) &&
 		    EXPECTED(p->key) &&
 		    zend_string_equal_content(p->key, key)) {
 			return p;
 		}
-		idx = Z_NEXT(p->val);
 		if (idx == HT_INVALID_IDX) {
 			return NULL;
 		}
@@ -779,12 +785,15 @@ static zend_always_inline Bucket *zend_hash_str_find_bucket(const HashTable *ht,
 	while (idx != HT_INVALID_IDX) {
 		ZEND_ASSERT(idx < HT_IDX_TO_HASH(ht->nTableSize));
 		p = HT_HASH_TO_BUCKET_EX(arData, idx);
+		idx = Z_NEXT(p->val);
+		if (idx != HT_INVALID_IDX) {
+			ZEND_PREFETCH(HT_HASH_TO_BUCKET_EX(arData, idx));
+		}
 		if ((p->h == h)
 			 && p->key
 			 && zend_string_equals_cstr(p->key, str, len)) {
 			return p;
 		}
-		idx = Z_NEXT(p->val);
 	}
 	return NULL;
 }
@@ -1437,15 +1437,14 @@ static void do_inherit_class_constant(zend_string *name, zend_class_constant *pa
 }
 /* }}} */
 
-void zend_build_properties_info_table(zend_class_entry *ce)
+ZEND_API void zend_build_properties_info_table(zend_class_entry *ce)
 {
 	zend_property_info **table, *prop;
 	size_t size;
-	if (ce->default_properties_count == 0) {
+	if (ce->default_properties_count == 0 || ce->properties_info_table != NULL) {
 		return;
 	}
 
-	ZEND_ASSERT(ce->properties_info_table == NULL);
 	size = sizeof(zend_property_info *) * ce->default_properties_count;
 	if (ce->type == ZEND_USER_CLASS) {
 		ce->properties_info_table = table = zend_arena_alloc(&CG(arena), size);
@@ -1458,6 +1457,12 @@ void zend_build_properties_info_table(zend_class_entry *ce)
 
 	if (ce->parent && ce->parent->default_properties_count != 0) {
 		zend_property_info **parent_table = ce->parent->properties_info_table;
+
+		/* The parent may have deferred building its own table as well. */
+		if (UNEXPECTED(parent_table == NULL)) {
+			zend_build_properties_info_table(ce->parent);
+			parent_table = ce->parent->properties_info_table;
+		}
 		memcpy(
 			table, parent_table,
 			sizeof(zend_property_info *) * ce->parent->default_properties_count
@@ -1515,6 +1520,16 @@ ZEND_API void zend_do_inheritance_ex(zend_class_entry *ce, zend_class_entry *par
 	ce->default_object_handlers = parent_ce->default_object_handlers;
 	ce->ce_flags |= ZEND_ACC_RESOLVED_PARENT;
 
+	/* Record the full parent chain, root first, so that instanceof checks
+	 * can index it instead of walking the chain. */
+	ZEND_ASSERT(!ce->ancestors);
+	ce->num_ancestors = parent_ce->num_ancestors + 1;
+	ce->ancestors = pemalloc(sizeof(zend_class_entry *) * ce->num_ancestors, ce->type == ZEND_INTERNAL_CLASS);
+	if (parent_ce->num_ancestors) {
+		memcpy(ce->ancestors, parent_ce->ancestors, sizeof(zend_class_entry *) * parent_ce->num_ancestors);
+	}
+	ce->ancestors[parent_ce->num_ancestors] = parent_ce;
+
 	/* Inherit properties */
 	if (parent_ce->default_properties_count) {
 		zval *src, *dst, *end;
@@ -3197,7 +3212,11 @@ ZEND_API zend_class_entry *zend_do_link_class(zend_class_entry *ce, zend_string
 			do_interface_implementation(ce, zend_ce_stringable);
 		}
 
-		zend_build_properties_info_table(ce);
+		/* ce->properties_info_table is built lazily on first use: most
+		 * classes linked at runtime are never instantiated in the same
+		 * request, and the table is only indexed through instances or
+		 * before constant updating. Classes published to the inheritance
+		 * cache materialize it in zend_persist_class_entry_calc(). */
 	} zend_catch {
 		/* Do not leak recorded errors to the next linked class. */
 		if (!orig_record_errors) {
@@ -3421,7 +3440,7 @@ ZEND_API zend_class_entry *zend_try_early_bind(zend_class_entry *ce, zend_class_
 			if (parent_ce && parent_ce->num_interfaces) {
 				zend_do_inherit_interfaces(ce, parent_ce);
 			}
-			zend_build_properties_info_table(ce);
+			/* ce->properties_info_table is built lazily on first use. */
 			if ((ce->ce_flags & (ZEND_ACC_IMPLICIT_ABSTRACT_CLASS|ZEND_ACC_INTERFACE|ZEND_ACC_TRAIT|ZEND_ACC_EXPLICIT_ABSTRACT_CLASS)) == ZEND_ACC_IMPLICIT_ABSTRACT_CLASS) {
 				zend_verify_abstract_class(ce);
 			}
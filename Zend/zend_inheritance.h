@@ -34,7 +34,10 @@ static zend_always_inline void zend_do_inheritance(zend_class_entry *ce, zend_cl
 ZEND_API zend_class_entry *zend_do_link_class(zend_class_entry *ce, zend_string *lc_parent_name, zend_string *key);
 
 void zend_verify_abstract_class(zend_class_entry *ce);
-void zend_build_properties_info_table(zend_class_entry *ce);
+/* Linking defers building this table for userland classes; call sites that
+ * index into ce->properties_info_table without holding an instance must
+ * materialize it first (no-op once built). */
+ZEND_API void zend_build_properties_info_table(zend_class_entry *ce);
 ZEND_API zend_class_entry *zend_try_early_bind(zend_class_entry *ce, zend_class_entry *parent_ce, zend_string *lcname, zval *delayed_early_binding);
 
 void zend_inheritance_check_override(zend_class_entry *ce);
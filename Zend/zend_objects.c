@@ -25,9 +25,16 @@
 #include "zend_interfaces.h"
 #include "zend_exceptions.h"
 #include "zend_weakrefs.h"
+#include "zend_inheritance.h"
 
 static zend_always_inline void _zend_object_std_init(zend_object *object, zend_class_entry *ce)
 {
+	/* Linking may have deferred building the properties info table; property
+	 * access, GC and serialization index into it through instances, so it
+	 * must exist before the first instance does. */
+	if (UNEXPECTED(ce->properties_info_table == NULL && ce->default_properties_count != 0)) {
+		zend_build_properties_info_table(ce);
+	}
 	GC_SET_REFCOUNT(object, 1);
 	GC_TYPE_INFO(object) = GC_OBJECT;
 	object->ce = ce;
@@ -186,8 +193,11 @@ ZEND_API void zend_objects_destroy_object(zend_object *object)
 
 ZEND_API zend_object* ZEND_FASTCALL zend_objects_new(zend_class_entry *ce)
 {
-	zend_object *object = emalloc(sizeof(zend_object) + zend_object_properties_size(ce));
+	zend_object *object = zend_objects_recycle_alloc(ce);
 
+	if (!object) {
+		object = emalloc(sizeof(zend_object) + zend_object_properties_size(ce));
+	}
 	_zend_object_std_init(object, ce);
 	return object;
 }
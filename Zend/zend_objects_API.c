@@ -127,6 +127,99 @@ ZEND_API void ZEND_FASTCALL zend_objects_store_free_object_storage(zend_objects_
 }
 
 
+static zend_always_inline zend_objects_recycle_slot *zend_objects_recycle_slot_for(const zend_class_entry *ce)
+{
+	return &EG(objects_recycle).slots[(((uintptr_t)ce) >> 6) & (ZEND_OBJECTS_RECYCLE_NUM_SLOTS - 1)];
+}
+
+static void zend_objects_recycle_slot_flush(zend_objects_recycle_slot *slot)
+{
+	void *block = slot->head;
+
+	while (block) {
+		void *next = *(void**)block;
+
+		efree(block);
+		block = next;
+	}
+	slot->head = NULL;
+	slot->count = 0;
+}
+
+ZEND_API zend_object* ZEND_FASTCALL zend_objects_recycle_alloc(zend_class_entry *ce)
+{
+	zend_objects_recycle_slot *slot = zend_objects_recycle_slot_for(ce);
+
+	/* Blocks are only ever cached for the class that owns the slot, so a
+	 * match guarantees the block size fits. */
+	if (EXPECTED(slot->ce == ce) && EXPECTED(slot->head != NULL)) {
+		void *block = slot->head;
+
+		slot->head = *(void**)block;
+		slot->count--;
+		return (zend_object*)block;
+	}
+	return NULL;
+}
+
+ZEND_API void ZEND_FASTCALL zend_objects_recycle_prewarm(zend_class_entry *ce, uint32_t count)
+{
+	zend_objects_recycle_slot *slot;
+	size_t block_size;
+
+	/* Only default-layout blocks are recycled; see zend_objects_store_del(). */
+	if (ce->create_object) {
+		return;
+	}
+
+	slot = zend_objects_recycle_slot_for(ce);
+	if (slot->ce != ce) {
+		if (slot->head) {
+			zend_objects_recycle_slot_flush(slot);
+		}
+		slot->ce = ce;
+	}
+
+	block_size = sizeof(zend_object) + zend_object_properties_size(ce);
+	while (slot->count < ZEND_OBJECTS_RECYCLE_MAX_BLOCKS && count > 0) {
+		void *block = emalloc(block_size);
+
+		*(void**)block = slot->head;
+		slot->head = block;
+		slot->count++;
+		count--;
+	}
+}
+
+ZEND_API void ZEND_FASTCALL zend_objects_store_reserve(uint32_t count)
+{
+	zend_objects_store *objects = &EG(objects_store);
+	uint32_t new_size = objects->size;
+
+	if (count <= new_size - objects->top) {
+		return;
+	}
+	do {
+		new_size *= 2;
+	} while (new_size - objects->top < count);
+	objects->object_buckets = (zend_object **) erealloc(objects->object_buckets, new_size * sizeof(zend_object*));
+	objects->size = new_size;
+}
+
+ZEND_API void ZEND_FASTCALL zend_objects_recycle_flush(void)
+{
+	zend_objects_recycle_slot *slot = EG(objects_recycle).slots;
+	zend_objects_recycle_slot *end = slot + ZEND_OBJECTS_RECYCLE_NUM_SLOTS;
+
+	do {
+		if (slot->head) {
+			zend_objects_recycle_slot_flush(slot);
+		}
+		slot->ce = NULL;
+		slot++;
+	} while (slot != end);
+}
+
 /* Store objects API */
 static ZEND_COLD zend_never_inline void ZEND_FASTCALL zend_objects_store_put_cold(zend_object *object)
 {
@@ -201,7 +294,29 @@ ZEND_API void ZEND_FASTCALL zend_objects_store_del(zend_object *object) /* {{{ *
 		}
 		ptr = ((char*)object) - object->handlers->offset;
 		GC_REMOVE_FROM_BUFFER(object);
-		efree(ptr);
+		/* Only blocks allocated by zend_objects_new() have a size that can be
+		 * derived from the class entry alone, so only those are recycled. */
+		if (object->handlers->offset == 0
+		 && !object->ce->create_object
+		 && EXPECTED(!(EG(flags) & (EG_FLAGS_OBJECT_STORE_NO_REUSE|EG_FLAGS_IN_RESOURCE_SHUTDOWN)))) {
+			zend_objects_recycle_slot *slot = zend_objects_recycle_slot_for(object->ce);
+
+			if (slot->ce != object->ce) {
+				if (slot->head) {
+					zend_objects_recycle_slot_flush(slot);
+				}
+				slot->ce = object->ce;
+			}
+			if (EXPECTED(slot->count < ZEND_OBJECTS_RECYCLE_MAX_BLOCKS)) {
+				*(void**)ptr = slot->head;
+				slot->head = ptr;
+				slot->count++;
+			} else {
+				efree(ptr);
+			}
+		} else {
+			efree(ptr);
+		}
 		ZEND_OBJECTS_STORE_ADD_TO_FREE_LIST(handle);
 	}
 }
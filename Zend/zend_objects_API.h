@@ -51,6 +51,24 @@ typedef struct _zend_objects_store {
 	int free_list_head;
 } zend_objects_store;
 
+/* Storage blocks of objects using the default layout (no custom create_object
+ * handler) are recycled through a small direct-mapped cache keyed by class
+ * entry, so that classes instantiated many times per request get their blocks
+ * back with a pointer pop instead of a full allocator round trip.  Freed
+ * blocks are linked through their first word. */
+#define ZEND_OBJECTS_RECYCLE_NUM_SLOTS  32 /* power of two */
+#define ZEND_OBJECTS_RECYCLE_MAX_BLOCKS 64 /* per slot */
+
+typedef struct _zend_objects_recycle_slot {
+	zend_class_entry *ce;
+	void             *head;
+	uint32_t          count;
+} zend_objects_recycle_slot;
+
+typedef struct _zend_objects_recycle {
+	zend_objects_recycle_slot slots[ZEND_OBJECTS_RECYCLE_NUM_SLOTS];
+} zend_objects_recycle;
+
 /* Global store handling functions */
 BEGIN_EXTERN_C()
 ZEND_API void ZEND_FASTCALL zend_objects_store_init(zend_objects_store *objects, uint32_t init_size);
@@ -63,6 +81,16 @@ ZEND_API void ZEND_FASTCALL zend_objects_store_destroy(zend_objects_store *objec
 ZEND_API void ZEND_FASTCALL zend_objects_store_put(zend_object *object);
 ZEND_API void ZEND_FASTCALL zend_objects_store_del(zend_object *object);
 
+/* Returns a recycled storage block for "ce", or NULL when none is cached */
+ZEND_API zend_object* ZEND_FASTCALL zend_objects_recycle_alloc(zend_class_entry *ce);
+ZEND_API void ZEND_FASTCALL zend_objects_recycle_flush(void);
+
+/* Bulk hydration support: before instantiating many objects of one class,
+ * pre-fill its recycle slot so each instance starts with a pointer pop, and
+ * grow the handle table once instead of doubling it mid-burst. */
+ZEND_API void ZEND_FASTCALL zend_objects_recycle_prewarm(zend_class_entry *ce, uint32_t count);
+ZEND_API void ZEND_FASTCALL zend_objects_store_reserve(uint32_t count);
+
 /* Called when the ctor was terminated by an exception */
 static zend_always_inline void zend_object_store_ctor_failed(zend_object *obj)
 {
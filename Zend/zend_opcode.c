@@ -419,6 +419,9 @@ ZEND_API void destroy_zend_class(zval *zv)
 			if (ce->num_interfaces > 0 && (ce->ce_flags & ZEND_ACC_RESOLVED_INTERFACES)) {
 				efree(ce->interfaces);
 			}
+			if (ce->ancestors) {
+				efree(ce->ancestors);
+			}
 			if (ce->backed_enum_table) {
 				zend_hash_release(ce->backed_enum_table);
 			}
@@ -513,6 +516,9 @@ ZEND_API void destroy_zend_class(zval *zv)
 			if (ce->num_interfaces > 0) {
 				free(ce->interfaces);
 			}
+			if (ce->ancestors) {
+				free(ce->ancestors);
+			}
 			if (ce->properties_info_table) {
 				free(ce->properties_info_table);
 			}
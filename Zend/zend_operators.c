@@ -1960,6 +1960,42 @@ ZEND_API zend_result ZEND_FASTCALL shift_right_function(zval *result, zval *op1,
 }
 /* }}} */
 
+/* Grow a string for an in-place append ($str .= ...). Unlike
+ * zend_string_extend(), which requests the exact size, allocations of a page
+ * or more are rounded up to the next power of two. The padding is a pure
+ * function of the length, so consecutive appends that stay within the same
+ * padded size resolve to a same-size erealloc() that the allocator answers
+ * without moving or copying the block. Building a string in a loop thus takes
+ * O(log n) moves instead of one per iteration, like smart_str, without a
+ * capacity field in zend_string. Unrelated reallocs simply drop the padding. */
+static zend_always_inline zend_string *zend_string_extend_for_concat(zend_string *s, size_t len)
+{
+	ZEND_ASSERT(len >= ZSTR_LEN(s));
+	if (!ZSTR_IS_INTERNED(s) && EXPECTED(GC_REFCOUNT(s) == 1)) {
+		size_t size = ZEND_MM_ALIGNED_SIZE(_ZSTR_STRUCT_SIZE(len));
+		zend_string *ret;
+
+		if (size >= 4096 && EXPECTED(size < (SIZE_MAX >> 1))) {
+			/* round up to the next power of two */
+			size--;
+			size |= size >> 1;
+			size |= size >> 2;
+			size |= size >> 4;
+			size |= size >> 8;
+			size |= size >> 16;
+#if SIZEOF_SIZE_T == 8
+			size |= size >> 32;
+#endif
+			size++;
+		}
+		ret = (zend_string *)erealloc(s, size);
+		ZSTR_LEN(ret) = len;
+		zend_string_forget_hash_val(ret);
+		return ret;
+	}
+	return zend_string_extend(s, len, 0);
+}
+
 ZEND_API zend_result ZEND_FASTCALL concat_function(zval *result, zval *op1, zval *op2) /* {{{ */
 {
 	zval *orig_op1 = op1;
@@ -2081,7 +2117,7 @@ has_op2_string:;
 				free_op1_string = false;
 			}
 			/* special case, perform operations on result */
-			result_str = zend_string_extend(op1_string, result_len, 0);
+			result_str = zend_string_extend_for_concat(op1_string, result_len);
 			/* account for the case where result_str == op1_string == op2_string and the realloc is done */
 			if (op1_string == op2_string) {
 				if (free_op2_string) {
@@ -2490,15 +2526,11 @@ ZEND_API bool ZEND_FASTCALL instanceof_function_slow(const zend_class_entry *ins
 		}
 		return 0;
 	} else {
-		while (1) {
-			instance_ce = instance_ce->parent;
-			if (instance_ce == ce) {
-				return 1;
-			}
-			if (instance_ce == NULL) {
-				return 0;
-			}
-		}
+		/* Every linked class records its parent chain root first in
+		 * ce->ancestors, and ce->num_ancestors is its depth, so an ancestry
+		 * test is one bound check and one compare. */
+		return ce->num_ancestors < instance_ce->num_ancestors
+			&& instance_ce->ancestors[ce->num_ancestors] == ce;
 	}
 }
 /* }}} */
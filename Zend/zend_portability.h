@@ -390,6 +390,14 @@ char *alloca();
 # define UNEXPECTED(condition) (condition)
 #endif
 
+/* Hint that "address" is likely to be read soon, without touching it.
+ * May be used on addresses that are not valid to dereference. */
+#if ZEND_GCC_VERSION >= 3001 || __has_builtin(__builtin_prefetch)
+# define ZEND_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+# define ZEND_PREFETCH(address) ((void)0)
+#endif
+
 #ifndef XtOffsetOf
 # define XtOffsetOf(s_type, field) offsetof(s_type, field)
 #endif
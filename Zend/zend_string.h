@@ -426,6 +426,107 @@ static zend_always_inline bool zend_string_starts_with_ci(const zend_string *str
 #define zend_string_starts_with_literal_ci(str, prefix) \
 	zend_string_starts_with_cstr_ci(str, prefix, strlen(prefix))
 
+#if defined(ZEND_HASH_XXH64_LONG_KEYS) && SIZEOF_ZEND_LONG == 8
+/*
+ * XXH64 (Yann Collet's xxHash, 64-bit variant), used by zend_inline_hash_func()
+ * for keys longer than 16 bytes when --enable-zend-xxh64-hash is given.
+ * It consumes the key in 8-byte lanes with multiply/rotate folds, which beats
+ * the byte-oriented DJBX33A below by a wide margin on multi-hundred-byte keys,
+ * while short keys keep DJBX33A and its cheaper setup.  The produced hash
+ * values differ from the default build, so anything that persists them across
+ * builds (notably the opcache file cache) must be cleared when the option is
+ * toggled.  Kept self-contained because Zend cannot depend on the xxhash
+ * sources bundled with ext/hash.
+ */
+
+static zend_always_inline uint64_t zend_hash_xxh64_rotl(uint64_t v, unsigned int n)
+{
+	return (v << n) | (v >> (64 - n));
+}
+
+static zend_always_inline uint64_t zend_hash_xxh64_read64(const char *p)
+{
+	/* Native endianness: hash values only need to be stable within one build. */
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static zend_always_inline uint32_t zend_hash_xxh64_read32(const char *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static zend_always_inline uint64_t zend_hash_xxh64_round(uint64_t acc, uint64_t lane)
+{
+	acc += lane * Z_UL(14029467366897019727); /* prime 2 */
+	return zend_hash_xxh64_rotl(acc, 31) * Z_UL(11400714785074694791); /* prime 1 */
+}
+
+static zend_always_inline uint64_t zend_hash_xxh64(const char *str, size_t len)
+{
+	const uint64_t prime1 = Z_UL(11400714785074694791);
+	const uint64_t prime2 = Z_UL(14029467366897019727);
+	const uint64_t prime3 = Z_UL(1609587929392839161);
+	const uint64_t prime4 = Z_UL(9650029242287828579);
+	const uint64_t prime5 = Z_UL(2870177450012600261);
+	const char *end = str + len;
+	uint64_t hash;
+
+	if (len >= 32) {
+		uint64_t acc1 = prime1 + prime2;
+		uint64_t acc2 = prime2;
+		uint64_t acc3 = 0;
+		uint64_t acc4 = (uint64_t)0 - prime1;
+
+		do {
+			acc1 = zend_hash_xxh64_round(acc1, zend_hash_xxh64_read64(str));
+			acc2 = zend_hash_xxh64_round(acc2, zend_hash_xxh64_read64(str + 8));
+			acc3 = zend_hash_xxh64_round(acc3, zend_hash_xxh64_read64(str + 16));
+			acc4 = zend_hash_xxh64_round(acc4, zend_hash_xxh64_read64(str + 24));
+			str += 32;
+		} while (str <= end - 32);
+
+		hash = zend_hash_xxh64_rotl(acc1, 1)
+			+ zend_hash_xxh64_rotl(acc2, 7)
+			+ zend_hash_xxh64_rotl(acc3, 12)
+			+ zend_hash_xxh64_rotl(acc4, 18);
+		hash = (hash ^ zend_hash_xxh64_round(0, acc1)) * prime1 + prime4;
+		hash = (hash ^ zend_hash_xxh64_round(0, acc2)) * prime1 + prime4;
+		hash = (hash ^ zend_hash_xxh64_round(0, acc3)) * prime1 + prime4;
+		hash = (hash ^ zend_hash_xxh64_round(0, acc4)) * prime1 + prime4;
+	} else {
+		hash = prime5;
+	}
+	hash += (uint64_t)len;
+
+	while (end - str >= 8) {
+		hash ^= zend_hash_xxh64_round(0, zend_hash_xxh64_read64(str));
+		hash = zend_hash_xxh64_rotl(hash, 27) * prime1 + prime4;
+		str += 8;
+	}
+	if (end - str >= 4) {
+		hash ^= (uint64_t)zend_hash_xxh64_read32(str) * prime1;
+		hash = zend_hash_xxh64_rotl(hash, 23) * prime2 + prime3;
+		str += 4;
+	}
+	while (str < end) {
+		hash ^= (uint64_t)(unsigned char)*str * prime5;
+		hash = zend_hash_xxh64_rotl(hash, 11) * prime1;
+		str++;
+	}
+
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+#endif /* ZEND_HASH_XXH64_LONG_KEYS */
+
 /*
  * DJBX33A (Daniel J. Bernstein, Times 33 with Addition)
  *
@@ -463,6 +564,13 @@ static zend_always_inline zend_ulong zend_inline_hash_func(const char *str, size
 {
 	zend_ulong hash = Z_UL(5381);
 
+#if defined(ZEND_HASH_XXH64_LONG_KEYS) && SIZEOF_ZEND_LONG == 8
+	if (len > 16) {
+		/* Hash value can't be zero, so we always set the high bit */
+		return zend_hash_xxh64(str, len) | Z_UL(0x8000000000000000);
+	}
+#endif
+
 #if defined(_WIN32) || defined(__i386__) || defined(__x86_64__) || defined(__aarch64__)
 	/* Version with multiplication works better on modern CPU */
 	for (; len >= 8; len -= 8, str += 8) {
@@ -238,6 +238,13 @@ extern void *MALLOC(size_t);
 #define FREE   free
 #endif
 
+/* The private memory pool is a process-wide bump allocator: with threads it
+ * races on pmem_next, and Bigints carved from it must never reach free()
+ * when the per-thread freelists are torn down. The freelists already
+ * recycle Bigints after the first allocation, so omit the pool and let
+ * every Bigint come from malloc(). */
+#define Omit_Private_Memory 1
+
 #ifndef Omit_Private_Memory
 #ifndef PRIVATE_MEM
 #define PRIVATE_MEM 2304
@@ -354,6 +354,139 @@ static inline zend_ulong realpath_cache_key(const char *path, size_t path_len) /
 /* }}} */
 #endif /* defined(ZEND_WIN32) */
 
+/* Optional pool-shared overlay over the per-process realpath cache.  A SAPI
+ * that forks workers (FPM) can map it before forking, so a path resolved by
+ * one worker is visible to the whole pool.  Entries use a per-slot seqlock:
+ * an even sequence means the slot is stable, writers bump it to odd while
+ * copying and both sides give up on any race, keeping the overlay best
+ * effort and lock free. */
+#if !defined(ZEND_WIN32) && defined(HAVE_MMAP)
+# define REALPATH_CACHE_SHM 1
+#endif
+
+#ifdef REALPATH_CACHE_SHM
+# include <sys/mman.h>
+# ifndef MAP_ANONYMOUS
+#  define MAP_ANONYMOUS MAP_ANON
+# endif
+
+/* longer paths just stay per-process */
+#define REALPATH_CACHE_SHM_MAXPATH 512
+
+typedef struct _realpath_cache_shm_slot {
+	uint32_t seq;
+	uint32_t path_len;
+	uint32_t realpath_len;
+	uint8_t  is_dir;
+	zend_ulong key;
+	time_t expires;
+	char path[REALPATH_CACHE_SHM_MAXPATH];
+	char realpath[REALPATH_CACHE_SHM_MAXPATH];
+} realpath_cache_shm_slot;
+
+typedef struct _realpath_cache_shm {
+	uint32_t num_slots;
+	realpath_cache_shm_slot slots[1];
+} realpath_cache_shm;
+
+static realpath_cache_shm *realpath_shm = NULL;
+
+static bool realpath_cache_shm_find(zend_ulong key, const char *path, size_t path_len, time_t t, char *realpath, size_t *realpath_len, int *is_dir) /* {{{ */
+{
+	realpath_cache_shm_slot *slot = &realpath_shm->slots[key % realpath_shm->num_slots];
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+	size_t len;
+
+	if ((seq & 1)
+	 || slot->key != key
+	 || slot->path_len != path_len
+	 || slot->realpath_len >= REALPATH_CACHE_SHM_MAXPATH
+	 || (CWDG(realpath_cache_ttl) && slot->expires < t)
+	 || memcmp(slot->path, path, path_len) != 0) {
+		return 0;
+	}
+	len = slot->realpath_len;
+	memcpy(realpath, slot->realpath, len + 1);
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq) {
+		/* a writer raced us, the copy cannot be trusted */
+		return 0;
+	}
+	*realpath_len = len;
+	*is_dir = slot->is_dir;
+	return 1;
+}
+/* }}} */
+
+static void realpath_cache_shm_add(zend_ulong key, const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t) /* {{{ */
+{
+	realpath_cache_shm_slot *slot = &realpath_shm->slots[key % realpath_shm->num_slots];
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+	if (path_len >= REALPATH_CACHE_SHM_MAXPATH
+	 || realpath_len >= REALPATH_CACHE_SHM_MAXPATH) {
+		return;
+	}
+	if ((seq & 1)
+	 || !__atomic_compare_exchange_n(&slot->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		/* another worker is writing the slot */
+		return;
+	}
+	slot->key = key;
+	slot->path_len = path_len;
+	slot->realpath_len = realpath_len;
+	slot->is_dir = is_dir > 0;
+	slot->expires = t + CWDG(realpath_cache_ttl);
+	memcpy(slot->path, path, path_len + 1);
+	memcpy(slot->realpath, realpath, realpath_len + 1);
+	__atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+}
+/* }}} */
+
+static void realpath_cache_shm_del(zend_ulong key, const char *path, size_t path_len) /* {{{ */
+{
+	realpath_cache_shm_slot *slot = &realpath_shm->slots[key % realpath_shm->num_slots];
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+	if ((seq & 1)
+	 || slot->key != key
+	 || slot->path_len != path_len
+	 || memcmp(slot->path, path, path_len) != 0) {
+		return;
+	}
+	if (__atomic_compare_exchange_n(&slot->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		slot->key = 0;
+		slot->path_len = 0;
+		__atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+	}
+}
+/* }}} */
+#endif /* REALPATH_CACHE_SHM */
+
+CWD_API int realpath_cache_share(uint32_t num_slots) /* {{{ */
+{
+#ifdef REALPATH_CACHE_SHM
+	realpath_cache_shm *shm;
+	size_t size;
+
+	if (realpath_shm || num_slots == 0) {
+		return -1;
+	}
+	size = sizeof(realpath_cache_shm) + (num_slots - 1) * sizeof(realpath_cache_shm_slot);
+	shm = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+	if (shm == MAP_FAILED) {
+		return -1;
+	}
+	memset(shm, 0, size);
+	shm->num_slots = num_slots;
+	realpath_shm = shm;
+	return 0;
+#else
+	return -1;
+#endif
+}
+/* }}} */
+
 CWD_API void realpath_cache_clean(void) /* {{{ */
 {
 	realpath_cache_clean_helper(sizeof(CWDG(realpath_cache))/sizeof(CWDG(realpath_cache)[0]), CWDG(realpath_cache), &CWDG(realpath_cache_size));
@@ -366,6 +499,12 @@ CWD_API void realpath_cache_del(const char *path, size_t path_len) /* {{{ */
 	zend_ulong n = key % (sizeof(CWDG(realpath_cache)) / sizeof(CWDG(realpath_cache)[0]));
 	realpath_cache_bucket **bucket = &CWDG(realpath_cache)[n];
 
+#ifdef REALPATH_CACHE_SHM
+	if (realpath_shm) {
+		realpath_cache_shm_del(key, path, path_len);
+	}
+#endif
+
 	while (*bucket != NULL) {
 		if (key == (*bucket)->key && path_len == (*bucket)->path_len &&
 					memcmp(path, (*bucket)->path, path_len) == 0) {
@@ -388,7 +527,7 @@ CWD_API void realpath_cache_del(const char *path, size_t path_len) /* {{{ */
 }
 /* }}} */
 
-static inline void realpath_cache_add(const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t) /* {{{ */
+static inline void realpath_cache_add_ex(const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t, bool publish) /* {{{ */
 {
 	zend_long size = sizeof(realpath_cache_bucket) + path_len + 1;
 	int same = 1;
@@ -399,6 +538,14 @@ static inline void realpath_cache_add(const char *path, size_t path_len, const c
 		same = 0;
 	}
 
+#ifdef REALPATH_CACHE_SHM
+	if (publish && realpath_shm) {
+		realpath_cache_shm_add(realpath_cache_key(path, path_len), path, path_len, realpath, realpath_len, is_dir, t);
+	}
+#else
+	(void)publish;
+#endif
+
 	if (CWDG(realpath_cache_size) + size <= CWDG(realpath_cache_size_limit)) {
 		realpath_cache_bucket *bucket = malloc(size);
 		zend_ulong n;
@@ -434,6 +581,12 @@ static inline void realpath_cache_add(const char *path, size_t path_len, const c
 }
 /* }}} */
 
+static inline void realpath_cache_add(const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t) /* {{{ */
+{
+	realpath_cache_add_ex(path, path_len, realpath, realpath_len, is_dir, t, /* publish */ true);
+}
+/* }}} */
+
 static inline realpath_cache_bucket* realpath_cache_find(const char *path, size_t path_len, time_t t) /* {{{ */
 {
 	zend_ulong key = realpath_cache_key(path, path_len);
@@ -459,6 +612,27 @@ static inline realpath_cache_bucket* realpath_cache_find(const char *path, size_
 			bucket = &(*bucket)->next;
 		}
 	}
+
+#ifdef REALPATH_CACHE_SHM
+	/* fall back to the pool-shared overlay and replay the hit locally */
+	if (realpath_shm) {
+		char realpath[REALPATH_CACHE_SHM_MAXPATH];
+		size_t realpath_len;
+		int is_dir;
+
+		if (realpath_cache_shm_find(key, path, path_len, t, realpath, &realpath_len, &is_dir)) {
+			realpath_cache_add_ex(path, path_len, realpath, realpath_len, is_dir, t, /* publish */ false);
+			bucket = &CWDG(realpath_cache)[n];
+			while (*bucket != NULL) {
+				if (key == (*bucket)->key && path_len == (*bucket)->path_len &&
+							memcmp(path, (*bucket)->path, path_len) == 0) {
+					return *bucket;
+				}
+				bucket = &(*bucket)->next;
+			}
+		}
+	}
+#endif
 	return NULL;
 }
 /* }}} */
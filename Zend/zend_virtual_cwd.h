@@ -247,6 +247,9 @@ extern virtual_cwd_globals cwd_globals;
 # define CWDG(v) (cwd_globals.v)
 #endif
 
+/* Map a pool-shared overlay for the realpath cache; must be called before
+ * the SAPI forks its workers.  Returns 0 on success, -1 when unsupported. */
+CWD_API int realpath_cache_share(uint32_t num_slots);
 CWD_API void realpath_cache_clean(void);
 CWD_API void realpath_cache_del(const char *path, size_t path_len);
 CWD_API realpath_cache_bucket* realpath_cache_lookup(const char *path, size_t path_len, time_t t);
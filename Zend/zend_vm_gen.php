@@ -3036,6 +3036,9 @@ function usage() {
          "\n  --with-vm-kind=CALL|SWITCH|GOTO|HYBRID - select threading model (default is HYBRID)".
          "\n  --without-specializer                  - disable executor specialization".
          "\n  --with-lines                           - enable #line directives".
+         "\nIf Zend/zend_vm_order.txt exists, the HYBRID executor emits the listed".
+         "\nhandlers first, in that order (see zend_vm_order.php for producing the".
+         "\nfile from a zend_vm_trace_handlers.h profile).".
          "\n\n");
 }
 
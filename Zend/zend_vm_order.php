@@ -0,0 +1,94 @@
+<?php
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) Zend Technologies Ltd. (http://www.zend.com)           |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+/* Build Zend/zend_vm_order.txt from a handler transition profile.
+ *
+ * Workflow:
+ *   1. Build PHP with VM tracing, e.g. add to the top of zend_execute.c:
+ *        #include "zend_vm_trace_handlers.h"
+ *      (before zend_vm_execute.h is included) and rebuild.
+ *   2. Run a representative workload. Each run merges handler pair
+ *      frequencies into zend_vm_trace.log in the working directory.
+ *   3. php zend_vm_order.php zend_vm_trace.log > Zend/zend_vm_order.txt
+ *   4. php zend_vm_gen.php  (the HYBRID executor emits the listed handlers
+ *      first, in this order, so hot handlers share I-cache lines; handlers
+ *      not listed keep their definition order after them).
+ *
+ * The order chains handlers greedily along their hottest observed
+ * transitions, starting from the hottest handler, so that frequent
+ * dispatch successors tend to be adjacent in the generated executor.
+ */
+
+if ($argc < 2) {
+    fwrite(STDERR, "Usage: php zend_vm_order.php zend_vm_trace.log > zend_vm_order.txt\n");
+    exit(1);
+}
+
+$f = fopen($argv[1], "r");
+if (!is_resource($f)) {
+    fwrite(STDERR, "ERROR: Cannot open '{$argv[1]}'\n");
+    exit(1);
+}
+
+$weight = [];  // handler  => total executions (in + out transitions)
+$edges  = [];  // handler  => [successor => count]
+while (!feof($f)) {
+    $line = trim(fgets($f));
+    if ($line === "") {
+        continue;
+    }
+    $part = preg_split('/\s+/', $line);
+    if (count($part) != 3 || !ctype_digit($part[2])) {
+        continue;
+    }
+    [$from, $to, $count] = $part;
+    $count = (int)$count;
+    $weight[$from] = ($weight[$from] ?? 0) + $count;
+    $weight[$to] = ($weight[$to] ?? 0) + $count;
+    $edges[$from][$to] = ($edges[$from][$to] ?? 0) + $count;
+}
+fclose($f);
+
+arsort($weight);
+foreach ($edges as &$successors) {
+    arsort($successors);
+}
+unset($successors);
+
+$placed = [];
+foreach ($weight as $start => $w) {
+    if (isset($placed[$start])) {
+        continue;
+    }
+    // Follow the hottest not-yet-placed successor as long as one exists.
+    $cur = $start;
+    while ($cur !== null) {
+        $placed[$cur] = true;
+        $next = null;
+        foreach ($edges[$cur] ?? [] as $to => $count) {
+            if (!isset($placed[$to])) {
+                $next = $to;
+                break;
+            }
+        }
+        $cur = $next;
+    }
+}
+
+foreach ($placed as $name => $dummy) {
+    echo $name, "\n";
+}
@@ -0,0 +1,53 @@
+<?php
+
+require_once __DIR__ . '/runner.inc';
+
+const N = 10000;
+
+function jsonDocument(): array {
+    $doc = [];
+    for ($i = 0; $i < 50; $i++) {
+        $doc['item' . $i] = [
+            'id' => $i,
+            'name' => "name \u{00e9}\u{00e8} $i",
+            'price' => $i * 1.5,
+            'active' => (bool) ($i & 1),
+            'tags' => ['a', 'b', 'c'],
+            'nested' => ['x' => ['y' => ['z' => $i]]],
+        ];
+    }
+    return $doc;
+}
+
+runBenchmarkFile([
+    'json.encode' => function () {
+        $doc = jsonDocument();
+        for ($i = 0; $i < N; $i++) {
+            json_encode($doc);
+        }
+    },
+    'json.encode_pretty' => function () {
+        $doc = jsonDocument();
+        for ($i = 0; $i < N; $i++) {
+            json_encode($doc, JSON_PRETTY_PRINT);
+        }
+    },
+    'json.decode_assoc' => function () {
+        $json = json_encode(jsonDocument());
+        for ($i = 0; $i < N; $i++) {
+            json_decode($json, true);
+        }
+    },
+    'json.decode_object' => function () {
+        $json = json_encode(jsonDocument());
+        for ($i = 0; $i < N; $i++) {
+            json_decode($json);
+        }
+    },
+    'json.decode_scalar_heavy' => function () {
+        $json = json_encode(range(0.5, 5000.5));
+        for ($i = 0; $i < 1000; $i++) {
+            json_decode($json, true);
+        }
+    },
+]);
@@ -0,0 +1,54 @@
+<?php
+
+require_once __DIR__ . '/runner.inc';
+
+if (!extension_loaded('mbstring')) {
+    /* Report an empty result set rather than failing the whole suite */
+    fwrite(STDOUT, "{}\n");
+    exit(0);
+}
+
+const N = 10000;
+
+function mbSubject(): string {
+    return str_repeat("R\u{00e9}sum\u{00e9} na\u{00ef}ve \u{65e5}\u{672c}\u{8a9e} text ", 100);
+}
+
+runBenchmarkFile([
+    'mbstring.strlen_utf8' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_strlen($s, 'UTF-8');
+        }
+    },
+    'mbstring.substr_utf8' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_substr($s, 100, 50, 'UTF-8');
+        }
+    },
+    'mbstring.strpos_utf8' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_strpos($s, "\u{65e5}\u{672c}\u{8a9e}", 0, 'UTF-8');
+        }
+    },
+    'mbstring.strtolower_utf8' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_strtolower($s, 'UTF-8');
+        }
+    },
+    'mbstring.convert_encoding' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_convert_encoding($s, 'UTF-16', 'UTF-8');
+        }
+    },
+    'mbstring.check_encoding' => function () {
+        $s = mbSubject();
+        for ($i = 0; $i < N; $i++) {
+            mb_check_encoding($s, 'UTF-8');
+        }
+    },
+]);
@@ -0,0 +1,45 @@
+<?php
+
+require_once __DIR__ . '/runner.inc';
+
+const N = 100000;
+
+runBenchmarkFile([
+    'pcre.match_literal' => function () {
+        $subject = str_repeat('lorem ipsum dolor sit amet ', 10);
+        for ($i = 0; $i < N; $i++) {
+            preg_match('/dolor/', $subject);
+        }
+    },
+    'pcre.match_captures' => function () {
+        $subject = 'user@example.com, other@example.org, third@example.net';
+        for ($i = 0; $i < N; $i++) {
+            preg_match('/([a-z0-9._%+-]+)@([a-z0-9.-]+)\.([a-z]{2,})/i', $subject, $m);
+        }
+    },
+    'pcre.match_all' => function () {
+        $subject = str_repeat('id=123; id=456; id=789; ', 50);
+        for ($i = 0; $i < 10000; $i++) {
+            preg_match_all('/id=(\d+)/', $subject, $m);
+        }
+    },
+    'pcre.replace' => function () {
+        $subject = str_repeat("some  text\twith   mixed\t\twhitespace ", 20);
+        for ($i = 0; $i < 10000; $i++) {
+            preg_replace('/\s+/', ' ', $subject);
+        }
+    },
+    'pcre.split' => function () {
+        $subject = implode(',', range(0, 500));
+        for ($i = 0; $i < 10000; $i++) {
+            preg_split('/,/', $subject);
+        }
+    },
+    'pcre.cache_churn' => function () {
+        /* A distinct pattern per iteration exercises pcre_cache lookups
+         * and compilation, not just match time */
+        for ($i = 0; $i < 10000; $i++) {
+            preg_match('/pattern' . ($i % 256) . '\d+/', 'pattern42x');
+        }
+    },
+]);
@@ -0,0 +1,43 @@
+<?php
+
+require_once __DIR__ . '/runner.inc';
+
+const N = 100000;
+
+class AllocSmall {
+    public $a = 1;
+    public $b = 2;
+    public $c = 3;
+}
+
+runBenchmarkFile([
+    'zend_alloc.small_arrays' => function () {
+        for ($i = 0; $i < N; $i++) {
+            $a = [1, 2, 3, $i];
+        }
+    },
+    'zend_alloc.objects' => function () {
+        for ($i = 0; $i < N; $i++) {
+            $o = new AllocSmall();
+        }
+    },
+    'zend_alloc.strings' => function () {
+        for ($i = 0; $i < N; $i++) {
+            $s = str_repeat('x', 64 + ($i & 63));
+        }
+    },
+    'zend_alloc.large_blocks' => function () {
+        for ($i = 0; $i < 1000; $i++) {
+            $s = str_repeat('x', 1 << 18);
+        }
+    },
+    'zend_alloc.array_grow_shrink' => function () {
+        $a = [];
+        for ($i = 0; $i < N; $i++) {
+            $a[] = $i;
+        }
+        while ($a) {
+            array_pop($a);
+        }
+    },
+]);
@@ -0,0 +1,82 @@
+<?php
+
+require_once __DIR__ . '/runner.inc';
+
+const N = 100000;
+
+runBenchmarkFile([
+    'zend_hash.insert_packed' => function () {
+        $a = [];
+        for ($i = 0; $i < N; $i++) {
+            $a[] = $i;
+        }
+    },
+    'zend_hash.insert_int_keys' => function () {
+        $a = [];
+        for ($i = N; $i > 0; $i--) {
+            $a[$i] = $i;
+        }
+    },
+    'zend_hash.insert_string_keys' => function () {
+        $a = [];
+        for ($i = 0; $i < N; $i++) {
+            $a['key' . $i] = $i;
+        }
+    },
+    'zend_hash.lookup_hit' => function () {
+        static $a = null;
+        if ($a === null) {
+            $a = [];
+            for ($i = 0; $i < N; $i++) {
+                $a['key' . ($i % 1000)] = $i;
+            }
+        }
+        $sum = 0;
+        for ($i = 0; $i < N; $i++) {
+            $sum += $a['key' . ($i % 1000)];
+        }
+    },
+    'zend_hash.lookup_miss' => function () {
+        static $a = null;
+        if ($a === null) {
+            $a = [];
+            for ($i = 0; $i < 1000; $i++) {
+                $a['key' . $i] = $i;
+            }
+        }
+        $hits = 0;
+        for ($i = 0; $i < N; $i++) {
+            $hits += isset($a['nokey' . ($i % 1000)]);
+        }
+    },
+    'zend_hash.foreach_packed' => function () {
+        static $a = null;
+        if ($a === null) {
+            $a = range(0, N - 1);
+        }
+        $sum = 0;
+        foreach ($a as $v) {
+            $sum += $v;
+        }
+    },
+    'zend_hash.foreach_string_keys' => function () {
+        static $a = null;
+        if ($a === null) {
+            $a = [];
+            for ($i = 0; $i < N; $i++) {
+                $a['key' . $i] = $i;
+            }
+        }
+        $sum = 0;
+        foreach ($a as $k => $v) {
+            $sum += $v;
+        }
+    },
+    'zend_hash.unset_rebuild' => function () {
+        $a = range(0, 9999);
+        for ($i = 0; $i < 10000; $i += 2) {
+            unset($a[$i]);
+        }
+        $a[] = 1;
+    },
+]);
@@ -0,0 +1,230 @@
+<?php
+
+require_once __DIR__ . '/shared.php';
+
+/*
+ * Per-subsystem micro benchmark driver.
+ *
+ * Runs every benchmark/micro/*.php file in a fresh, CPU-pinned PHP process,
+ * aggregates the per-repetition wall-clock times into a median with a 95%
+ * confidence interval, and reads/writes a machine-readable baseline format
+ * so builds can be gated on "no regression above N%":
+ *
+ *   php benchmark/microbench.php --store baseline.json
+ *   ... build the new binary ...
+ *   php benchmark/microbench.php --compare baseline.json --threshold 2
+ *
+ * --compare exits non-zero if any benchmark regressed by more than the
+ * threshold with non-overlapping confidence intervals.
+ */
+
+function main(array $argv) {
+    $options = parseOptions($argv);
+
+    $files = glob(__DIR__ . '/micro/*.php');
+    sort($files);
+
+    $results = [];
+    foreach ($files as $file) {
+        $results += runBenchmarkProcess($file, $options);
+    }
+    if (!$results) {
+        fwrite(STDERR, "No benchmarks matched\n");
+        exit(1);
+    }
+
+    $summary = [
+        'meta' => [
+            'date' => date('c'),
+            'php_version' => PHP_VERSION,
+            'commit' => getPhpSrcCommitHash(),
+            'repeat' => $options['repeat'],
+            'cpu' => $options['cpu'],
+        ],
+        'results' => [],
+    ];
+    foreach ($results as $name => $times) {
+        $summary['results'][$name] = computeStats($times);
+    }
+
+    printSummary($summary);
+
+    if ($options['store'] !== null) {
+        file_put_contents($options['store'], json_encode($summary, JSON_PRETTY_PRINT) . "\n");
+        fwrite(STDOUT, "Stored baseline in {$options['store']}\n");
+    }
+    if ($options['compare'] !== null) {
+        exit(compareAgainstBaseline($summary, $options['compare'], $options['threshold']));
+    }
+}
+
+function parseOptions(array $argv): array {
+    $options = [
+        'repeat' => 11,
+        'threshold' => 2.0,
+        'store' => null,
+        'compare' => null,
+        'filter' => '',
+        'cpu' => null,
+    ];
+    for ($i = 1; $i < count($argv); $i++) {
+        switch ($argv[$i]) {
+            case '--repeat':
+                $options['repeat'] = max(3, (int) $argv[++$i]);
+                break;
+            case '--threshold':
+                $options['threshold'] = (float) $argv[++$i];
+                break;
+            case '--store':
+                $options['store'] = $argv[++$i];
+                break;
+            case '--compare':
+                $options['compare'] = $argv[++$i];
+                break;
+            case '--filter':
+                $options['filter'] = $argv[++$i];
+                break;
+            case '--cpu':
+                $options['cpu'] = (int) $argv[++$i];
+                break;
+            default:
+                fwrite(STDERR, "Unknown option: {$argv[$i]}\n");
+                fwrite(STDERR, "Usage: php microbench.php [--repeat N] [--filter SUBSTR] [--cpu N]\n");
+                fwrite(STDERR, "           [--store FILE] [--compare FILE [--threshold PCT]]\n");
+                exit(1);
+        }
+    }
+    if ($options['cpu'] === null) {
+        $options['cpu'] = taskSetAvailable() ? 0 : -1;
+    }
+    return $options;
+}
+
+function taskSetAvailable(): bool {
+    if (PHP_OS_FAMILY !== 'Linux') {
+        return false;
+    }
+    exec('command -v taskset 2>/dev/null', $out, $status);
+    return $status === 0;
+}
+
+function runBenchmarkProcess(string $file, array $options): array {
+    $cmd = [];
+    if ($options['cpu'] >= 0) {
+        /* Pin the child to one core so migrations and per-core frequency
+         * differences do not show up as noise */
+        $cmd = ['taskset', '-c', (string) $options['cpu']];
+    }
+    $cmd = [...$cmd,
+        PHP_BINARY,
+        '-d opcache.enable_cli=1',
+        '-d opcache.jit=disable',
+        $file,
+        (string) $options['repeat'],
+        $options['filter'],
+    ];
+    $process = runCommand($cmd);
+    $results = json_decode($process->stdout, true);
+    if (!is_array($results)) {
+        fwrite(STDERR, "Unexpected output from $file\n");
+        exit(1);
+    }
+    return $results;
+}
+
+function getPhpSrcCommitHash(): string {
+    $result = runCommand(['git', 'log', '--pretty=format:%H', '-n', '1'], dirname(__DIR__));
+    return $result->stdout;
+}
+
+/* Median with a 95% confidence interval computed from the interquartile
+ * range (the standard box plot notch: median +/- 1.57 * IQR / sqrt(n)),
+ * which is robust against the occasional scheduling outlier. */
+function computeStats(array $times): array {
+    sort($times);
+    $n = count($times);
+    $median = quantile($times, 0.5);
+    $iqr = quantile($times, 0.75) - quantile($times, 0.25);
+    $ci = 1.57 * $iqr / sqrt($n);
+    return [
+        'median_ns' => (int) round($median),
+        'ci95_ns' => (int) round($ci),
+        'min_ns' => $times[0],
+        'max_ns' => $times[$n - 1],
+        'repeat' => $n,
+    ];
+}
+
+function quantile(array $sorted, float $q): float {
+    $pos = (count($sorted) - 1) * $q;
+    $base = (int) floor($pos);
+    $rest = $pos - $base;
+    if ($base + 1 < count($sorted)) {
+        return $sorted[$base] + $rest * ($sorted[$base + 1] - $sorted[$base]);
+    }
+    return $sorted[$base];
+}
+
+function printSummary(array $summary) {
+    foreach ($summary['results'] as $name => $stats) {
+        fwrite(STDOUT, sprintf("%-36s %12s \xc2\xb1%s\n",
+            $name, formatNs($stats['median_ns']), formatNs($stats['ci95_ns'])));
+    }
+}
+
+function formatNs(int $ns): string {
+    if ($ns >= 1e9) {
+        return sprintf('%.3fs', $ns / 1e9);
+    } elseif ($ns >= 1e6) {
+        return sprintf('%.2fms', $ns / 1e6);
+    } elseif ($ns >= 1e3) {
+        return sprintf('%.2fus', $ns / 1e3);
+    }
+    return $ns . 'ns';
+}
+
+function compareAgainstBaseline(array $summary, string $baselineFile, float $threshold): int {
+    if (!file_exists($baselineFile)) {
+        fwrite(STDERR, "Baseline file '$baselineFile' not found\n");
+        return 1;
+    }
+    $baseline = json_decode(file_get_contents($baselineFile), true);
+    if (!isset($baseline['results'])) {
+        fwrite(STDERR, "Baseline file '$baselineFile' is not a microbench summary\n");
+        return 1;
+    }
+
+    $regressions = [];
+    fwrite(STDOUT, "\n| Benchmark | Base | Head | Diff |\n|---|---|---|---|\n");
+    foreach ($summary['results'] as $name => $head) {
+        $base = $baseline['results'][$name] ?? null;
+        if ($base === null) {
+            fwrite(STDOUT, "| $name | - | " . formatNs($head['median_ns']) . " | - |\n");
+            continue;
+        }
+        $diff = ($head['median_ns'] - $base['median_ns']) / $base['median_ns'] * 100;
+        /* Only flag a regression when the confidence intervals do not
+         * overlap; a large diff with overlapping intervals is noise */
+        $significant = $head['median_ns'] - $head['ci95_ns']
+            > $base['median_ns'] + $base['ci95_ns'];
+        $flag = '';
+        if ($diff > $threshold && $significant) {
+            $regressions[] = $name;
+            $flag = ' **regression**';
+        }
+        fwrite(STDOUT, sprintf("| %s | %s | %s | %+.2f%%%s |\n",
+            $name, formatNs($base['median_ns']), formatNs($head['median_ns']), $diff, $flag));
+    }
+
+    if ($regressions) {
+        fwrite(STDERR, "\n" . count($regressions) . " benchmark(s) regressed more than $threshold%:\n");
+        foreach ($regressions as $name) {
+            fwrite(STDERR, "  $name\n");
+        }
+        return 1;
+    }
+    fwrite(STDOUT, "\nNo regression above $threshold%\n");
+    return 0;
+}
+
+main($argv);
@@ -47,6 +47,10 @@
 
 #define BC_MUL_MAX_ADD_COUNT (~((BC_UINT_T) 0) / (BC_MUL_UINT_OVERFLOW * BC_MUL_UINT_OVERFLOW))
 
+/* Minimum number of limbs in the smaller operand before the multiplication
+ * is split recursively (Karatsuba). Below this the schoolbook loop wins. */
+#define BC_MUL_KARATSUBA_THRESHOLD 32
+
 
 /* Multiply utility routines */
 
@@ -214,6 +218,156 @@ static void bc_write_bcd_representation(uint32_t value, char *str)
 	memcpy(str, &digits, sizeof(digits));
 }
 
+/*
+ * Limb vector helpers for the multiplication kernels. All arrays are
+ * little-endian limbs in base BC_MUL_UINT_OVERFLOW, normalized (every limb
+ * smaller than the base) unless noted otherwise.
+ */
+
+/* out = x + y; out needs MAX(xlen, ylen) + 1 limbs. Returns the used length. */
+static size_t bc_add_limbs(const BC_UINT_T *x, size_t xlen, const BC_UINT_T *y, size_t ylen, BC_UINT_T *out)
+{
+	const BC_UINT_T *longer = xlen >= ylen ? x : y;
+	size_t short_len = MIN(xlen, ylen);
+	size_t long_len = MAX(xlen, ylen);
+	BC_UINT_T carry = 0;
+	size_t i;
+
+	for (i = 0; i < short_len; i++) {
+		BC_UINT_T sum = x[i] + y[i] + carry;
+		carry = sum >= BC_MUL_UINT_OVERFLOW;
+		out[i] = carry ? sum - BC_MUL_UINT_OVERFLOW : sum;
+	}
+	for (; i < long_len; i++) {
+		BC_UINT_T sum = longer[i] + carry;
+		carry = sum >= BC_MUL_UINT_OVERFLOW;
+		out[i] = carry ? sum - BC_MUL_UINT_OVERFLOW : sum;
+	}
+	out[long_len] = carry;
+	return long_len + (carry != 0);
+}
+
+/* x -= y in place; the caller guarantees x >= y. */
+static void bc_sub_limbs(BC_UINT_T *x, size_t xlen, const BC_UINT_T *y, size_t ylen)
+{
+	BC_UINT_T borrow = 0;
+	size_t i;
+
+	for (i = 0; i < ylen; i++) {
+		BC_UINT_T yv = y[i] + borrow;
+		if (x[i] < yv) {
+			x[i] += BC_MUL_UINT_OVERFLOW - yv;
+			borrow = 1;
+		} else {
+			x[i] -= yv;
+			borrow = 0;
+		}
+	}
+	for (; borrow && i < xlen; i++) {
+		if (x[i] == 0) {
+			x[i] = BC_MUL_UINT_OVERFLOW - 1;
+		} else {
+			x[i]--;
+			borrow = 0;
+		}
+	}
+}
+
+/* x += y in place; any final carry propagates into the upper limbs of x. */
+static void bc_add_into_limbs(BC_UINT_T *x, size_t xlen, const BC_UINT_T *y, size_t ylen)
+{
+	BC_UINT_T carry = 0;
+	size_t i;
+
+	for (i = 0; i < ylen; i++) {
+		BC_UINT_T sum = x[i] + y[i] + carry;
+		carry = sum >= BC_MUL_UINT_OVERFLOW;
+		x[i] = carry ? sum - BC_MUL_UINT_OVERFLOW : sum;
+	}
+	for (; carry && i < xlen; i++) {
+		x[i]++;
+		if (x[i] == BC_MUL_UINT_OVERFLOW) {
+			x[i] = 0;
+		} else {
+			carry = 0;
+		}
+	}
+}
+
+static void bc_mul_limbs_dispatch(const BC_UINT_T *a, size_t alen, const BC_UINT_T *b, size_t blen, BC_UINT_T *prod);
+
+/* Schoolbook product of two limb vectors into prod (alen + blen limbs, zeroed
+ * by the caller). Carries are deferred as long as the accumulator has
+ * headroom, as in the original bc_standard_mul() loop. */
+static void bc_mul_limbs_schoolbook(const BC_UINT_T *a, size_t alen, const BC_UINT_T *b, size_t blen, BC_UINT_T *prod)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < alen; i++) {
+		if (UNEXPECTED(count >= BC_MUL_MAX_ADD_COUNT)) {
+			bc_digits_adjustment(prod, alen + blen);
+			count = 0;
+		}
+		count++;
+		for (size_t j = 0; j < blen; j++) {
+			prod[i + j] += a[i] * b[j];
+		}
+	}
+	bc_digits_adjustment(prod, alen + blen);
+}
+
+/* Karatsuba: a = a1 * B^m + a0, b = b1 * B^m + b0, then
+ * a * b = z2 * B^2m + (z0 + z2 + (a0 + a1)(b0 + b1) - z0 - z2) * B^m + z0
+ * with z0 = a0 * b0 and z2 = a1 * b1, trading one of the four recursive
+ * products for some linear additions. The caller guarantees the operands are
+ * roughly balanced (see bc_mul_limbs_dispatch()). */
+static void bc_mul_limbs_karatsuba(const BC_UINT_T *a, size_t alen, const BC_UINT_T *b, size_t blen, BC_UINT_T *prod)
+{
+	size_t m = MIN(alen, blen) / 2;
+	size_t sa_size = alen - m + 1;
+	size_t sb_size = blen - m + 1;
+	size_t t_size = sa_size + sb_size;
+	size_t i;
+
+	BC_UINT_T *buf = safe_emalloc(sa_size + sb_size + t_size, sizeof(BC_UINT_T), 0);
+	BC_UINT_T *sa = buf;
+	BC_UINT_T *sb = sa + sa_size;
+	BC_UINT_T *t = sb + sb_size;
+
+	/* z0 and z2 go straight into the (zeroed) result buffer: z0 occupies the
+	 * low 2m limbs, z2 the remaining high limbs, with no overlap. */
+	bc_mul_limbs_dispatch(a, m, b, m, prod);
+	bc_mul_limbs_dispatch(a + m, alen - m, b + m, blen - m, prod + 2 * m);
+
+	/* t = (a0 + a1) * (b0 + b1) */
+	size_t sa_len = bc_add_limbs(a, m, a + m, alen - m, sa);
+	size_t sb_len = bc_add_limbs(b, m, b + m, blen - m, sb);
+	for (i = 0; i < sa_len + sb_len; i++) {
+		t[i] = 0;
+	}
+	bc_mul_limbs_dispatch(sa, sa_len, sb, sb_len, t);
+
+	/* t -= z0 + z2; the result (the middle term) is non-negative. */
+	bc_sub_limbs(t, sa_len + sb_len, prod, 2 * m);
+	bc_sub_limbs(t, sa_len + sb_len, prod + 2 * m, alen + blen - 2 * m);
+
+	bc_add_into_limbs(prod + m, alen + blen - m, t, sa_len + sb_len);
+
+	efree(buf);
+}
+
+/* Normalized product of two limb vectors into prod (alen + blen limbs, zeroed
+ * by the caller). Recurses with Karatsuba while both operands are large and
+ * not too lopsided; very unbalanced products gain little from splitting. */
+static void bc_mul_limbs_dispatch(const BC_UINT_T *a, size_t alen, const BC_UINT_T *b, size_t blen, BC_UINT_T *prod)
+{
+	if (MIN(alen, blen) < BC_MUL_KARATSUBA_THRESHOLD || MAX(alen, blen) > 2 * MIN(alen, blen)) {
+		bc_mul_limbs_schoolbook(a, alen, b, blen, prod);
+	} else {
+		bc_mul_limbs_karatsuba(a, alen, b, blen, prod);
+	}
+}
+
 /*
  * Converts the BCD of bc_num by 4 (32 bits) or 8 (64 bits) digits to an array of BC_UINT_Ts.
  * The array is generated starting with the smaller digits.
@@ -231,20 +385,21 @@ static void bc_standard_mul(bc_num n1, size_t n1len, bc_num n2, size_t n2len, bc
 
 	size_t n1_arr_size = (n1len + BC_MUL_UINT_DIGITS - 1) / BC_MUL_UINT_DIGITS;
 	size_t n2_arr_size = (n2len + BC_MUL_UINT_DIGITS - 1) / BC_MUL_UINT_DIGITS;
-	size_t prod_arr_size = n1_arr_size + n2_arr_size - 1;
+	size_t prod_full_size = n1_arr_size + n2_arr_size;
+	size_t prod_arr_size = prod_full_size - 1;
 
 	/*
 	 * let's say that N is the max of n1len and n2len (and a multiple of BC_MUL_UINT_DIGITS for simplicity),
-	 * then this sum is <= N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS - 1
-	 * which is equal to N - 1 if BC_MUL_UINT_DIGITS is 4, and N/2 - 1 if BC_MUL_UINT_DIGITS is 8.
+	 * then this sum is <= N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS + N/BC_MUL_UINT_DIGITS
+	 * which is equal to N if BC_MUL_UINT_DIGITS is 4, and N/2 if BC_MUL_UINT_DIGITS is 8.
 	 */
-	BC_UINT_T *buf = safe_emalloc(n1_arr_size + n2_arr_size + prod_arr_size, sizeof(BC_UINT_T), 0);
+	BC_UINT_T *buf = safe_emalloc(n1_arr_size + n2_arr_size + prod_full_size, sizeof(BC_UINT_T), 0);
 
 	BC_UINT_T *n1_uint = buf;
 	BC_UINT_T *n2_uint = buf + n1_arr_size;
 	BC_UINT_T *prod_uint = n2_uint + n2_arr_size;
 
-	for (i = 0; i < prod_arr_size; i++) {
+	for (i = 0; i < prod_full_size; i++) {
 		prod_uint[i] = 0;
 	}
 
@@ -252,29 +407,16 @@ static void bc_standard_mul(bc_num n1, size_t n1len, bc_num n2, size_t n2len, bc
 	bc_convert_to_uint(n1_uint, n1end, n1len);
 	bc_convert_to_uint(n2_uint, n2end, n2len);
 
-	/* Multiplication and addition */
-	size_t count = 0;
-	for (i = 0; i < n1_arr_size; i++) {
-		/*
-		 * This calculation adds the result multiple times to the array entries.
-		 * When multiplying large numbers of digits, there is a possibility of
-		 * overflow, so digit adjustment is performed beforehand.
-		 */
-		if (UNEXPECTED(count >= BC_MUL_MAX_ADD_COUNT)) {
-			bc_digits_adjustment(prod_uint, prod_arr_size);
-			count = 0;
-		}
-		count++;
-		for (size_t j = 0; j < n2_arr_size; j++) {
-			prod_uint[i + j] += n1_uint[i] * n2_uint[j];
-		}
-	}
+	/* Multiplication; schoolbook or Karatsuba depending on the sizes. */
+	bc_mul_limbs_dispatch(n1_uint, n1_arr_size, n2_uint, n2_arr_size, prod_uint);
 
 	/*
-	 * Move a value exceeding 4/8 digits by carrying to the next digit.
-	 * However, the last digit does nothing.
+	 * The write-back below expects the top of the product in the last of
+	 * prod_arr_size limbs, possibly exceeding 4/8 digits; fold the extra
+	 * normalized limb back in. The top two limbs combined are smaller than
+	 * the base squared, so this cannot overflow.
 	 */
-	bc_digits_adjustment(prod_uint, prod_arr_size);
+	prod_uint[prod_arr_size - 1] += prod_uint[prod_arr_size] * BC_MUL_UINT_OVERFLOW;
 
 	/* Convert to bc_num */
 	*prod = bc_new_num_nonzeroed(prodlen, 0);
@@ -0,0 +1,30 @@
+--TEST--
+bcmul() with operands large enough for the Karatsuba path
+--EXTENSIONS--
+bcmath
+--INI--
+bcmath.scale=0
+--FILE--
+<?php
+/* (10^n - 1)^2 = 10^2n - 2*10^n + 1, i.e. "9...9" squared is "9...980...01" */
+$n = 2000;
+$nines = str_repeat('9', $n);
+$expected = str_repeat('9', $n - 1) . '8' . str_repeat('0', $n - 1) . '1';
+var_dump(bcmul($nines, $nines) === $expected);
+
+$a = substr(str_repeat('1234567890987654321', 200), 0, 3000);
+$b = substr(str_repeat('3141592653589793238462643', 150), 0, 2500);
+$c = substr(str_repeat('2718281828459045235360287', 150), 0, 2400);
+
+// commutativity
+var_dump(bcmul($a, $b) === bcmul($b, $a));
+// distributivity ties the large path to addition, which is computed separately
+var_dump(bcmul($a, bcadd($b, $c)) === bcadd(bcmul($a, $b), bcmul($a, $c)));
+// unbalanced operands stay on the schoolbook path
+var_dump(bcmul($a, '99991') === bcsub(bcmul($a, '100000'), bcmul($a, '9')));
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
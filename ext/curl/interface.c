@@ -2515,6 +2515,27 @@ PHP_FUNCTION(curl_getinfo)
 		if (curl_easy_getinfo(ch->cp, CURLINFO_CAINFO, &s_code) == CURLE_OK) {
 			CAAS("cainfo", s_code);
 		}
+#endif
+		/* Connection cache telemetry: lets callers tell reused connections
+		 * (num_connects == 0, stable conn_id) from fresh ones, and see how
+		 * long a transfer sat waiting for a connection. */
+		if (curl_easy_getinfo(ch->cp, CURLINFO_NUM_CONNECTS, &l_code) == CURLE_OK) {
+			CAAL("num_connects", l_code);
+		}
+#if LIBCURL_VERSION_NUM >= 0x080100 /* Available since 8.1.0 */
+		if (curl_easy_getinfo(ch->cp, CURLINFO_XFER_ID, &co) == CURLE_OK) {
+			CAAL("xfer_id", co);
+		}
+#endif
+#if LIBCURL_VERSION_NUM >= 0x080200 /* Available since 8.2.0 */
+		if (curl_easy_getinfo(ch->cp, CURLINFO_CONN_ID, &co) == CURLE_OK) {
+			CAAL("conn_id", co);
+		}
+#endif
+#if LIBCURL_VERSION_NUM >= 0x080600 /* Available since 8.6.0 */
+		if (curl_easy_getinfo(ch->cp, CURLINFO_QUEUE_TIME_T, &co) == CURLE_OK) {
+			CAAL("queue_time_us", co);
+		}
 #endif
 	} else {
 		switch (option) {
@@ -541,6 +541,12 @@ ttinfo* timelib_fetch_posix_timezone_offset(timelib_tzinfo *tz, timelib_sll ts,
 		if (transition_time) {
 			*transition_time = tz->trans[tz->bit64.timecnt - 1];
 		}
+
+		tz->lookup_cache.start = transition_time ? tz->trans[tz->bit64.timecnt - 1] : INT64_MIN;
+		tz->lookup_cache.end = INT64_MAX;
+		tz->lookup_cache.transition_time = tz->lookup_cache.start;
+		tz->lookup_cache.type = &(tz->type[tz->posix_info->type_index_std_type]);
+
 		return &(tz->type[tz->posix_info->type_index_std_type]);
 	}
 
@@ -559,6 +565,18 @@ ttinfo* timelib_fetch_posix_timezone_offset(timelib_tzinfo *tz, timelib_sll ts,
 			if (transition_time) {
 				*transition_time = transitions.times[i - 1];
 			}
+
+			/* Memoise this window for timelib_fetch_timezone_offset. When the
+			 * zone has real transitions we are only consulted for time stamps
+			 * past the last one, so clamp the window start accordingly. */
+			tz->lookup_cache.start = transitions.times[i - 1];
+			if (transition_time && tz->lookup_cache.start < tz->trans[tz->bit64.timecnt - 1]) {
+				tz->lookup_cache.start = tz->trans[tz->bit64.timecnt - 1];
+			}
+			tz->lookup_cache.end = transitions.times[i];
+			tz->lookup_cache.transition_time = transition_time ? transitions.times[i - 1] : INT64_MIN;
+			tz->lookup_cache.type = &(tz->type[transitions.types[i - 1]]);
+
 			return &(tz->type[transitions.types[i - 1]]);
 		}
 	}
@@ -791,6 +791,13 @@ ttinfo* timelib_fetch_timezone_offset(timelib_tzinfo *tz, timelib_sll ts, timeli
 {
 	uint32_t left, right;
 
+	/* Consecutive lookups tend to fall between the same pair of transitions,
+	 * so replay the last result when 'ts' is still inside its window */
+	if (tz->lookup_cache.type && ts >= tz->lookup_cache.start && ts < tz->lookup_cache.end) {
+		*transition_time = tz->lookup_cache.transition_time;
+		return tz->lookup_cache.type;
+	}
+
 	/* RFC 8536: If there are no transitions, local time for all timestamps is specified
 	 * by the TZ string in the footer if present and nonempty; otherwise, it is specified
 	 * by time type 0.
@@ -813,6 +820,11 @@ ttinfo* timelib_fetch_timezone_offset(timelib_tzinfo *tz, timelib_sll ts, timeli
 	/* RFC 8536: Local time for timestamps before the first transition is specified by
 	 * the first time type (time type 0). */
 	if (ts < tz->trans[0]) {
+		tz->lookup_cache.start = INT64_MIN;
+		tz->lookup_cache.end = tz->trans[0];
+		tz->lookup_cache.transition_time = INT64_MIN;
+		tz->lookup_cache.type = &(tz->type[0]);
+
 		*transition_time = INT64_MIN;
 		return &(tz->type[0]);
 	}
@@ -828,6 +840,11 @@ ttinfo* timelib_fetch_timezone_offset(timelib_tzinfo *tz, timelib_sll ts, timeli
 			return timelib_fetch_posix_timezone_offset(tz, ts, transition_time);
 		}
 
+		tz->lookup_cache.start = tz->trans[tz->bit64.timecnt - 1];
+		tz->lookup_cache.end = INT64_MAX;
+		tz->lookup_cache.transition_time = tz->trans[tz->bit64.timecnt - 1];
+		tz->lookup_cache.type = &(tz->type[tz->trans_idx[tz->bit64.timecnt - 1]]);
+
 		*transition_time = tz->trans[tz->bit64.timecnt - 1];
 		return &(tz->type[tz->trans_idx[tz->bit64.timecnt - 1]]);
 	}
@@ -847,6 +864,11 @@ ttinfo* timelib_fetch_timezone_offset(timelib_tzinfo *tz, timelib_sll ts, timeli
 			left = mid;
 		}
 	}
+	tz->lookup_cache.start = tz->trans[left];
+	tz->lookup_cache.end = tz->trans[right];
+	tz->lookup_cache.transition_time = tz->trans[left];
+	tz->lookup_cache.type = &(tz->type[tz->trans_idx[left]]);
+
 	*transition_time = tz->trans[left];
 	return &(tz->type[tz->trans_idx[left]]);
 }
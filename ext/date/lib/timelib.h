@@ -218,6 +218,15 @@ typedef struct _timelib_tzinfo
 
 	char              *posix_string;
 	timelib_posix_str *posix_info;
+
+	/* Memoised result of the last offset lookup, valid for time stamps in
+	 * [start, end). 'type' is NULL until the first lookup fills it in. */
+	struct {
+		timelib_sll  start;
+		timelib_sll  end;
+		timelib_sll  transition_time;
+		ttinfo      *type;
+	} lookup_cache;
 } timelib_tzinfo;
 
 typedef struct _timelib_rel_time {
@@ -241,6 +241,7 @@ static void date_register_classes(void);
 
 ZEND_DECLARE_MODULE_GLOBALS(date)
 static PHP_GINIT_FUNCTION(date);
+static PHP_GSHUTDOWN_FUNCTION(date);
 
 /* True global */
 timelib_tzdb *php_date_global_timezone_db;
@@ -382,7 +383,7 @@ zend_module_entry date_module_entry = {
 	PHP_DATE_VERSION,                /* extension version */
 	PHP_MODULE_GLOBALS(date),   /* globals descriptor */
 	PHP_GINIT(date),            /* globals ctor */
-	NULL,                       /* globals dtor */
+	PHP_GSHUTDOWN(date),        /* globals dtor */
 	ZEND_MODULE_POST_ZEND_DEACTIVATE_N(date), /* post deactivate */
 	STANDARD_MODULE_PROPERTIES_EX
 };
@@ -395,6 +396,22 @@ static PHP_GINIT_FUNCTION(date)
 	date_globals->default_timezone = NULL;
 	date_globals->timezone = NULL;
 	date_globals->tzcache = NULL;
+	date_globals->tzcache_tzdb = NULL;
+	date_globals->time_recycle_count = 0;
+}
+/* }}} */
+
+/* {{{ PHP_GSHUTDOWN_FUNCTION */
+static PHP_GSHUTDOWN_FUNCTION(date)
+{
+	if (date_globals->tzcache) {
+		zend_hash_destroy(date_globals->tzcache);
+		pefree(date_globals->tzcache, 1);
+		date_globals->tzcache = NULL;
+	}
+	while (date_globals->time_recycle_count > 0) {
+		timelib_time_dtor(date_globals->time_recycle[--date_globals->time_recycle_count]);
+	}
 }
 /* }}} */
 
@@ -413,7 +430,6 @@ PHP_RINIT_FUNCTION(date)
 		efree(DATEG(timezone));
 	}
 	DATEG(timezone) = NULL;
-	DATEG(tzcache) = NULL;
 	DATEG(last_errors) = NULL;
 
 	return SUCCESS;
@@ -434,12 +450,6 @@ PHP_RSHUTDOWN_FUNCTION(date)
 
 ZEND_MODULE_POST_ZEND_DEACTIVATE_D(date)
 {
-	if (DATEG(tzcache)) {
-		zend_hash_destroy(DATEG(tzcache));
-		FREE_HASHTABLE(DATEG(tzcache));
-		DATEG(tzcache) = NULL;
-	}
-
 	if (DATEG(last_errors)) {
 		timelib_error_container_dtor(DATEG(last_errors));
 		DATEG(last_errors) = NULL;
@@ -450,6 +460,34 @@ ZEND_MODULE_POST_ZEND_DEACTIVATE_D(date)
 
 #define DATE_TIMEZONEDB      php_date_global_timezone_db ? php_date_global_timezone_db : timelib_builtin_db()
 
+/* {{{ timelib_time recycling
+ * DateTime-heavy code allocates and frees a timelib_time (or several) per
+ * instantiation. Keep a small per-process stack of zeroed structures so the
+ * common construct/destruct churn bypasses the allocator. A recycled
+ * structure is interchangeable with a fresh timelib_time_ctor() one; the only
+ * heap member a timelib_time owns is tz_abbr, released before pooling. */
+static timelib_time *php_timelib_time_alloc(void)
+{
+	if (DATEG(time_recycle_count) > 0) {
+		return DATEG(time_recycle)[--DATEG(time_recycle_count)];
+	}
+	return timelib_time_ctor();
+}
+
+static void php_timelib_time_release(timelib_time *t)
+{
+	if (DATEG(time_recycle_count) < PHP_DATE_TIME_RECYCLE_SIZE) {
+		if (t->tz_abbr) {
+			timelib_free(t->tz_abbr);
+		}
+		memset(t, 0, sizeof(timelib_time));
+		DATEG(time_recycle)[DATEG(time_recycle_count)++] = t;
+	} else {
+		timelib_time_dtor(t);
+	}
+}
+/* }}} */
+
 /* {{{ PHP_MINIT_FUNCTION */
 PHP_MINIT_FUNCTION(date)
 {
@@ -504,9 +542,17 @@ static timelib_tzinfo *php_date_parse_tzfile(const char *formal_tzname, const ti
 	timelib_tzinfo *tzi;
 	int dummy_error_code;
 
+	/* Parsed timezones are immutable, so the cache persists across requests
+	 * and each zone is parsed at most once per process (per thread with ZTS). */
 	if(!DATEG(tzcache)) {
-		ALLOC_HASHTABLE(DATEG(tzcache));
-		zend_hash_init(DATEG(tzcache), 4, NULL, _php_date_tzinfo_dtor, 0);
+		DATEG(tzcache) = pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(DATEG(tzcache), 4, NULL, _php_date_tzinfo_dtor, 1);
+		DATEG(tzcache_tzdb) = tzdb;
+	} else if (DATEG(tzcache_tzdb) != tzdb) {
+		/* An external timezone database was installed (php_date_set_tzdb)
+		 * after entries were cached; drop the stale ones. */
+		zend_hash_clean(DATEG(tzcache));
+		DATEG(tzcache_tzdb) = tzdb;
 	}
 
 	if ((tzi = zend_hash_str_find_ptr(DATEG(tzcache), formal_tzname, strlen(formal_tzname))) != NULL) {
@@ -876,7 +922,7 @@ PHPAPI zend_string *php_format_date(const char *format, size_t format_len, time_
 	timelib_tzinfo *tzi;
 	zend_string *string;
 
-	t = timelib_time_ctor();
+	t = php_timelib_time_alloc();
 
 	if (localtime) {
 		tzi = get_timezone_info();
@@ -890,7 +936,7 @@ PHPAPI zend_string *php_format_date(const char *format, size_t format_len, time_
 
 	string = date_format(format, format_len, t, localtime);
 
-	timelib_time_dtor(t);
+	php_timelib_time_release(t);
 	return string;
 }
 /* }}} */
@@ -904,7 +950,7 @@ PHPAPI int php_idate(char format, time_t ts, bool localtime)
 	timelib_time_offset *offset = NULL;
 	timelib_sll isoweek, isoyear;
 
-	t = timelib_time_ctor();
+	t = php_timelib_time_alloc();
 
 	if (!localtime) {
 		tzi = get_timezone_info();
@@ -987,7 +1033,7 @@ PHPAPI int php_idate(char format, time_t ts, bool localtime)
 	if (!localtime) {
 		timelib_time_offset_dtor(offset);
 	}
-	timelib_time_dtor(t);
+	php_timelib_time_release(t);
 
 	return retval;
 }
@@ -1061,14 +1107,14 @@ PHPAPI zend_long php_parse_date(const char *string, zend_long *now)
 
 	parsed_time = timelib_strtotime(string, strlen(string), &error, DATE_TIMEZONEDB, php_date_parse_tzfile_wrapper);
 	if (error->error_count) {
-		timelib_time_dtor(parsed_time);
+		php_timelib_time_release(parsed_time);
 		timelib_error_container_dtor(error);
 		return -1;
 	}
 	timelib_error_container_dtor(error);
 	timelib_update_ts(parsed_time, NULL);
 	retval = timelib_date_to_int(parsed_time, &error2);
-	timelib_time_dtor(parsed_time);
+	php_timelib_time_release(parsed_time);
 	if (error2) {
 		return -1;
 	}
@@ -1103,7 +1149,7 @@ PHP_FUNCTION(strtotime)
 		return;
 	}
 
-	now = timelib_time_ctor();
+	now = php_timelib_time_alloc();
 	now->tz_info = tzi;
 	now->zone_type = TIMELIB_ZONETYPE_ID;
 	timelib_unixtime2local(now,
@@ -1114,8 +1160,8 @@ PHP_FUNCTION(strtotime)
 	parse_error = error->error_count;
 	timelib_error_container_dtor(error);
 	if (parse_error) {
-		timelib_time_dtor(now);
-		timelib_time_dtor(t);
+		php_timelib_time_release(now);
+		php_timelib_time_release(t);
 		RETURN_FALSE;
 	}
 
@@ -1123,8 +1169,8 @@ PHP_FUNCTION(strtotime)
 	timelib_update_ts(t, tzi);
 	ts = timelib_date_to_int(t, &epoch_does_not_fit_in_zend_long);
 
-	timelib_time_dtor(now);
-	timelib_time_dtor(t);
+	php_timelib_time_release(now);
+	php_timelib_time_release(t);
 
 	if (epoch_does_not_fit_in_zend_long) {
 		php_error_docref(NULL, E_WARNING, "Epoch doesn't fit in a PHP integer");
@@ -1156,7 +1202,7 @@ PHPAPI void php_mktime(INTERNAL_FUNCTION_PARAMETERS, bool gmt)
 	ZEND_PARSE_PARAMETERS_END();
 
 	/* Initialize structure with current time */
-	now = timelib_time_ctor();
+	now = php_timelib_time_alloc();
 	if (gmt) {
 		timelib_unixtime2gmt(now, (timelib_sll) php_time());
 	} else {
@@ -1207,13 +1253,13 @@ PHPAPI void php_mktime(INTERNAL_FUNCTION_PARAMETERS, bool gmt)
 	ts = timelib_date_to_int(now, &epoch_does_not_fit_in_zend_long);
 
 	if (epoch_does_not_fit_in_zend_long) {
-		timelib_time_dtor(now);
+		php_timelib_time_release(now);
 		php_error_docref(NULL, E_WARNING, "Epoch doesn't fit in a PHP integer");
 		RETURN_FALSE;
 	}
 
 	ts += adjust_seconds;
-	timelib_time_dtor(now);
+	php_timelib_time_release(now);
 
 	RETURN_LONG(ts);
 }
@@ -1279,7 +1325,7 @@ PHPAPI void php_strftime(INTERNAL_FUNCTION_PARAMETERS, bool gmt)
 		timestamp = (zend_long) php_time();
 	}
 
-	ts = timelib_time_ctor();
+	ts = php_timelib_time_alloc();
 	if (gmt) {
 		tzi = NULL;
 		timelib_unixtime2gmt(ts, (timelib_sll) timestamp);
@@ -1339,7 +1385,7 @@ PHPAPI void php_strftime(INTERNAL_FUNCTION_PARAMETERS, bool gmt)
 	}
 #endif
 
-	timelib_time_dtor(ts);
+	php_timelib_time_release(ts);
 	if (!gmt) {
 		timelib_time_offset_dtor(offset);
 	}
@@ -1399,7 +1445,7 @@ PHP_FUNCTION(localtime)
 	if (!tzi) {
 		RETURN_THROWS();
 	}
-	ts = timelib_time_ctor();
+	ts = php_timelib_time_alloc();
 	ts->tz_info = tzi;
 	ts->zone_type = TIMELIB_ZONETYPE_ID;
 	timelib_unixtime2local(ts, (timelib_sll) timestamp);
@@ -1428,7 +1474,7 @@ PHP_FUNCTION(localtime)
 		add_next_index_long(return_value, ts->dst);
 	}
 
-	timelib_time_dtor(ts);
+	php_timelib_time_release(ts);
 }
 /* }}} */
 
@@ -1453,7 +1499,7 @@ PHP_FUNCTION(getdate)
 	if (!tzi) {
 		RETURN_THROWS();
 	}
-	ts = timelib_time_ctor();
+	ts = php_timelib_time_alloc();
 	ts->tz_info = tzi;
 	ts->zone_type = TIMELIB_ZONETYPE_ID;
 	timelib_unixtime2local(ts, (timelib_sll) timestamp);
@@ -1472,7 +1518,7 @@ PHP_FUNCTION(getdate)
 	add_assoc_string(return_value, "month", mon_full_names[ts->m - 1]);
 	add_index_long(return_value, 0, timestamp);
 
-	timelib_time_dtor(ts);
+	php_timelib_time_release(ts);
 }
 /* }}} */
 
@@ -1614,7 +1660,7 @@ static zval *date_period_it_current_data(zend_object_iterator *iter)
 	/* Create new object */
 	php_date_instantiate(get_base_date_class(object->start_ce), &iterator->current);
 	newdateobj = Z_PHPDATE_P(&iterator->current);
-	newdateobj->time = timelib_time_ctor();
+	newdateobj->time = php_timelib_time_alloc();
 	*newdateobj->time = *it_time;
 	if (it_time->tz_abbr) {
 		newdateobj->time->tz_abbr = timelib_strdup(it_time->tz_abbr);
@@ -1676,7 +1722,7 @@ static void date_period_it_rewind(zend_object_iterator *iter)
 
 	iterator->current_index = 0;
 	if (iterator->object->current) {
-		timelib_time_dtor(iterator->object->current);
+		php_timelib_time_release(iterator->object->current);
 	}
 	if (!iterator->object->start) {
 		date_throw_uninitialized_error(date_ce_period);
@@ -1869,7 +1915,7 @@ static zend_object *date_object_clone_date(zend_object *this_ptr) /* {{{ */
 	}
 
 	/* this should probably moved to a new `timelib_time *timelime_time_clone(timelib_time *)` */
-	new_obj->time = timelib_time_ctor();
+	new_obj->time = php_timelib_time_alloc();
 	*new_obj->time = *old_obj->time;
 	if (old_obj->time->tz_abbr) {
 		new_obj->time->tz_abbr = timelib_strdup(old_obj->time->tz_abbr);
@@ -2285,7 +2331,7 @@ static void date_object_free_storage_date(zend_object *object) /* {{{ */
 	php_date_obj *intern = php_date_obj_from_obj(object);
 
 	if (intern->time) {
-		timelib_time_dtor(intern->time);
+		php_timelib_time_release(intern->time);
 	}
 
 	zend_object_std_dtor(&intern->std);
@@ -2318,15 +2364,15 @@ static void date_object_free_storage_period(zend_object *object) /* {{{ */
 	php_period_obj *intern = php_period_obj_from_obj(object);
 
 	if (intern->start) {
-		timelib_time_dtor(intern->start);
+		php_timelib_time_release(intern->start);
 	}
 
 	if (intern->current) {
-		timelib_time_dtor(intern->current);
+		php_timelib_time_release(intern->current);
 	}
 
 	if (intern->end) {
-		timelib_time_dtor(intern->end);
+		php_timelib_time_release(intern->end);
 	}
 
 	timelib_rel_time_dtor(intern->interval);
@@ -2408,19 +2454,24 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 	suseconds_t usec;
 	int options = 0;
 
+	bool is_now = false;
+
 	if (dateobj->time) {
-		timelib_time_dtor(dateobj->time);
+		php_timelib_time_release(dateobj->time);
 	}
 	if (format) {
 		if (time_str_len == 0) {
 			time_str = "";
 		}
 		dateobj->time = timelib_parse_from_format(format, time_str, time_str_len, &err, DATE_TIMEZONEDB, php_date_parse_tzfile_wrapper);
+	} else if (time_str_len == 0
+			|| (time_str_len == sizeof("now") - 1 && memcmp(time_str, "now", sizeof("now") - 1) == 0)) {
+		/* Most common constructor input: parsing "now" yields a time with all
+		 * fields unset, which the fast path below replaces wholesale with the
+		 * current time, so skip the parser altogether. */
+		is_now = true;
+		dateobj->time = NULL;
 	} else {
-		if (time_str_len == 0) {
-			time_str = "now";
-			time_str_len = sizeof("now") - 1;
-		}
 		dateobj->time = timelib_strtotime(time_str, time_str_len, &err, DATE_TIMEZONEDB, php_date_parse_tzfile_wrapper);
 	}
 
@@ -2434,7 +2485,7 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 			err->error_messages[0].position, err->error_messages[0].character ? err->error_messages[0].character : ' ', err->error_messages[0].message);
 	}
 	if (err && err->error_count) {
-		timelib_time_dtor(dateobj->time);
+		php_timelib_time_release(dateobj->time);
 		dateobj->time = 0;
 		return 0;
 	}
@@ -2457,7 +2508,7 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 				break;
 		}
 		type = tzobj->type;
-	} else if (dateobj->time->tz_info) {
+	} else if (dateobj->time && dateobj->time->tz_info) {
 		tzi = dateobj->time->tz_info;
 	} else {
 		tzi = get_timezone_info();
@@ -2466,7 +2517,7 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 		}
 	}
 
-	now = timelib_time_ctor();
+	now = php_timelib_time_alloc();
 	now->zone_type = type;
 	switch (type) {
 		case TIMELIB_ZONETYPE_ID:
@@ -2485,10 +2536,7 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 	timelib_unixtime2local(now, (timelib_sll) sec);
 	php_date_set_time_fraction(now, usec);
 
-	if (!format
-	 && time_str_len == sizeof("now") - 1
-	 && memcmp(time_str, "now", sizeof("now") - 1) == 0) {
-		timelib_time_dtor(dateobj->time);
+	if (is_now) {
 		dateobj->time = now;
 		return 1;
 	}
@@ -2504,14 +2552,14 @@ PHPAPI bool php_date_initialize(php_date_obj *dateobj, const char *time_str, siz
 
 	dateobj->time->have_relative = 0;
 
-	timelib_time_dtor(now);
+	php_timelib_time_release(now);
 
 	return 1;
 } /* }}} */
 
 PHPAPI void php_date_initialize_from_ts_long(php_date_obj *dateobj, zend_long sec, int usec) /* {{{ */
 {
-	dateobj->time = timelib_time_ctor();
+	dateobj->time = php_timelib_time_alloc();
 	dateobj->time->zone_type = TIMELIB_ZONETYPE_OFFSET;
 
 	timelib_unixtime2gmt(dateobj->time, (timelib_sll)sec);
@@ -3190,7 +3238,7 @@ static void php_date_do_return_parsed_time(INTERNAL_FUNCTION_PARAMETERS, timelib
 		}
 		add_assoc_zval(return_value, "relative", &element);
 	}
-	timelib_time_dtor(parsed_time);
+	php_timelib_time_release(parsed_time);
 } /* }}} */
 
 /* {{{ Returns associative array with detailed info about given date */
@@ -3267,7 +3315,7 @@ static bool php_date_modify(zval *object, char *modify, size_t modify_len) /* {{
 			err->error_messages[0].position,
 			err->error_messages[0].character ? err->error_messages[0].character : ' ',
 			err->error_messages[0].message);
-		timelib_time_dtor(tmp_time);
+		php_timelib_time_release(tmp_time);
 		return 0;
 	}
 
@@ -3314,7 +3362,7 @@ static bool php_date_modify(zval *object, char *modify, size_t modify_len) /* {{
 		timelib_set_timezone_from_offset(dateobj->time, 0);
 	}
 
-	timelib_time_dtor(tmp_time);
+	php_timelib_time_release(tmp_time);
 
 	timelib_update_ts(dateobj->time, NULL);
 	timelib_update_from_sse(dateobj->time);
@@ -3412,7 +3460,7 @@ static void php_date_add(zval *object, zval *interval, zval *return_value) /* {{
 	} else {
 		new_time = timelib_add(dateobj->time, intobj->diff);
 	}
-	timelib_time_dtor(dateobj->time);
+	php_timelib_time_release(dateobj->time);
 	dateobj->time = new_time;
 } /* }}} */
 
@@ -3469,7 +3517,7 @@ static void php_date_sub(zval *object, zval *interval, zval *return_value) /* {{
 	} else {
 		new_time = timelib_sub(dateobj->time, intobj->diff);
 	}
-	timelib_time_dtor(dateobj->time);
+	php_timelib_time_release(dateobj->time);
 	dateobj->time = new_time;
 } /* }}} */
 
@@ -4661,7 +4709,7 @@ static void php_date_interval_initialize_from_hash(zval **return_value, php_inte
 		(*intobj)->from_string = true;
 		(*intobj)->date_string = zend_string_copy(Z_STR_P(date_str));
 
-		timelib_time_dtor(time);
+		php_timelib_time_release(time);
 		timelib_error_container_dtor(err);
 
 		return;
@@ -4902,7 +4950,7 @@ PHP_FUNCTION(date_interval_create_from_date_string)
 	date_interval_instantiate_from_time(return_value, time, time_str);
 
 cleanup:
-	timelib_time_dtor(time);
+	php_timelib_time_release(time);
 	timelib_error_container_dtor(err);
 }
 /* }}} */
@@ -4934,7 +4982,7 @@ PHP_METHOD(DateInterval, createFromDateString)
 	date_interval_instantiate_from_time(return_value, time, time_str);
 
 cleanup:
-	timelib_time_dtor(time);
+	php_timelib_time_release(time);
 	timelib_error_container_dtor(err);
 }
 /* }}} */
@@ -5041,10 +5089,10 @@ static bool date_period_initialize(timelib_time **st, timelib_time **et, timelib
 		retval = false;
 		zend_throw_exception_ex(date_ce_date_malformed_period_string_exception, 0, "Unknown or bad format (%s)", format);
 		if (b) {
-			timelib_time_dtor(b);
+			php_timelib_time_release(b);
 		}
 		if (e) {
-			timelib_time_dtor(e);
+			php_timelib_time_release(e);
 		}
 		if (p) {
 			timelib_rel_time_dtor(p);
@@ -5191,7 +5239,7 @@ PHP_METHOD(DatePeriod, __construct)
 
 		/* start date */
 		dateobj = Z_PHPDATE_P(start);
-		clone = timelib_time_ctor();
+		clone = php_timelib_time_alloc();
 		memcpy(clone, dateobj->time, sizeof(timelib_time));
 		if (dateobj->time->tz_abbr) {
 			clone->tz_abbr = timelib_strdup(dateobj->time->tz_abbr);
@@ -5232,7 +5280,7 @@ PHP_METHOD(DatePeriod, getStartDate)
 
 	php_date_instantiate(dpobj->start_ce, return_value);
 	dateobj = Z_PHPDATE_P(return_value);
-	dateobj->time = timelib_time_ctor();
+	dateobj->time = php_timelib_time_alloc();
 	*dateobj->time = *dpobj->start;
 	if (dpobj->start->tz_abbr) {
 		dateobj->time->tz_abbr = timelib_strdup(dpobj->start->tz_abbr);
@@ -5259,7 +5307,7 @@ PHP_METHOD(DatePeriod, getEndDate)
 
 	php_date_instantiate(dpobj->start_ce, return_value);
 	dateobj = Z_PHPDATE_P(return_value);
-	dateobj->time = timelib_time_ctor();
+	dateobj->time = php_timelib_time_alloc();
 	*dateobj->time = *dpobj->end;
 	if (dpobj->end->tz_abbr) {
 			dateobj->time->tz_abbr = timelib_strdup(dpobj->end->tz_abbr);
@@ -5507,7 +5555,7 @@ static void php_do_date_sunrise_sunset(INTERNAL_FUNCTION_PARAMETERS, bool calc_s
 	if (!tzi) {
 		RETURN_THROWS();
 	}
-	t = timelib_time_ctor();
+	t = php_timelib_time_alloc();
 	t->tz_info = tzi;
 	t->zone_type = TIMELIB_ZONETYPE_ID;
 
@@ -5517,7 +5565,7 @@ static void php_do_date_sunrise_sunset(INTERNAL_FUNCTION_PARAMETERS, bool calc_s
 
 	timelib_unixtime2local(t, time);
 	rs = timelib_astro_rise_set_altitude(t, longitude, latitude, altitude, 1, &h_rise, &h_set, &rise, &set, &transit);
-	timelib_time_dtor(t);
+	php_timelib_time_release(t);
 
 	if (rs != 0) {
 		RETURN_FALSE;
@@ -5581,13 +5629,13 @@ PHP_FUNCTION(date_sun_info)
 	if (!tzi) {
 		RETURN_THROWS();
 	}
-	t = timelib_time_ctor();
+	t = php_timelib_time_alloc();
 	t->tz_info = tzi;
 	t->zone_type = TIMELIB_ZONETYPE_ID;
 	timelib_unixtime2local(t, time);
 
 	/* Setup */
-	t2 = timelib_time_ctor();
+	t2 = php_timelib_time_alloc();
 	array_init(return_value);
 
 	/* Get sun up/down and transit */
@@ -5663,8 +5711,8 @@ PHP_FUNCTION(date_sun_info)
 			t2->sse = set;
 			add_assoc_long(return_value, "astronomical_twilight_end", timelib_date_to_int(t2, &dummy));
 	}
-	timelib_time_dtor(t);
-	timelib_time_dtor(t2);
+	php_timelib_time_release(t);
+	php_timelib_time_release(t2);
 }
 /* }}} */
 
@@ -5719,7 +5767,7 @@ static bool php_date_period_initialize_from_hash(php_period_obj *period_obj, Has
 			}
 
 			if (period_obj->start != NULL) {
-				timelib_time_dtor(period_obj->start);
+				php_timelib_time_release(period_obj->start);
 			}
 			period_obj->start = timelib_time_clone(date_obj->time);
 			period_obj->start_ce = Z_OBJCE_P(ht_entry);
@@ -5741,7 +5789,7 @@ static bool php_date_period_initialize_from_hash(php_period_obj *period_obj, Has
 			}
 
 			if (period_obj->end != NULL) {
-				timelib_time_dtor(period_obj->end);
+				php_timelib_time_release(period_obj->end);
 			}
 			period_obj->end = timelib_time_clone(date_obj->time);
 		} else if (Z_TYPE_P(ht_entry) != IS_NULL) {
@@ -5762,7 +5810,7 @@ static bool php_date_period_initialize_from_hash(php_period_obj *period_obj, Has
 			}
 
 			if (period_obj->current != NULL) {
-				timelib_time_dtor(period_obj->current);
+				php_timelib_time_release(period_obj->current);
 			}
 			period_obj->current = timelib_time_clone(date_obj->time);
 		} else if (Z_TYPE_P(ht_entry) != IS_NULL)  {
@@ -120,11 +120,17 @@ static inline php_period_obj *php_period_obj_from_obj(zend_object *obj) {
 
 #define Z_PHPPERIOD_P(zv)  php_period_obj_from_obj(Z_OBJ_P((zv)))
 
+/* Number of timelib_time structures kept for reuse between instantiations */
+#define PHP_DATE_TIME_RECYCLE_SIZE 16
+
 ZEND_BEGIN_MODULE_GLOBALS(date)
 	char                    *default_timezone;
 	char                    *timezone;
 	HashTable               *tzcache;
+	const timelib_tzdb      *tzcache_tzdb;
 	timelib_error_container *last_errors;
+	timelib_time            *time_recycle[PHP_DATE_TIME_RECYCLE_SIZE];
+	int                      time_recycle_count;
 ZEND_END_MODULE_GLOBALS(date)
 
 #define DATEG(v) ZEND_MODULE_GLOBALS_ACCESSOR(date, v)
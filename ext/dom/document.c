@@ -1789,6 +1789,91 @@ PHP_METHOD(DOMDocument, validate)
 /* }}} */
 
 #ifdef LIBXML_SCHEMAS_ENABLED
+
+#ifndef ZTS
+/* Compiling a large schema often costs more than the validation itself.
+ * Schemas loaded from files are therefore cached per process, keyed by the
+ * resolved path and invalidated when the file's mtime or size changes.
+ * libxml2 cannot serialize compiled schemas, so the cache only spans the
+ * lifetime of the worker. ZTS builds skip the cache as it would need
+ * locking around the shared entries. */
+#define DOM_SCHEMA_CACHE_SIZE 4
+
+typedef struct dom_schema_cache_entry {
+	char *path;
+	time_t mtime;
+	off_t size;
+	xmlSchemaPtr schema;
+} dom_schema_cache_entry;
+
+static dom_schema_cache_entry dom_schema_cache[DOM_SCHEMA_CACHE_SIZE];
+static unsigned int dom_schema_cache_next = 0;
+
+static xmlSchemaPtr dom_schema_cache_fetch(const char *path)
+{
+	zend_stat_t st = {0};
+	unsigned int i;
+
+	if (VCWD_STAT(path, &st) != 0) {
+		return NULL;
+	}
+
+	for (i = 0; i < DOM_SCHEMA_CACHE_SIZE; i++) {
+		dom_schema_cache_entry *entry = &dom_schema_cache[i];
+
+		if (entry->path && strcmp(entry->path, path) == 0) {
+			if (entry->mtime == st.st_mtime && entry->size == st.st_size) {
+				return entry->schema;
+			}
+			/* stale; drop so the caller re-parses */
+			xmlSchemaFree(entry->schema);
+			pefree(entry->path, 1);
+			entry->path = NULL;
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
+static bool dom_schema_cache_store(const char *path, xmlSchemaPtr schema)
+{
+	zend_stat_t st = {0};
+	dom_schema_cache_entry *entry;
+
+	if (VCWD_STAT(path, &st) != 0) {
+		return false;
+	}
+
+	entry = &dom_schema_cache[dom_schema_cache_next];
+	dom_schema_cache_next = (dom_schema_cache_next + 1) % DOM_SCHEMA_CACHE_SIZE;
+
+	if (entry->path) {
+		xmlSchemaFree(entry->schema);
+		pefree(entry->path, 1);
+	}
+	entry->path = pestrdup(path, 1);
+	entry->mtime = st.st_mtime;
+	entry->size = st.st_size;
+	entry->schema = schema;
+	return true;
+}
+#endif /* !ZTS */
+
+void dom_schema_cache_clear(void)
+{
+#ifndef ZTS
+	unsigned int i;
+
+	for (i = 0; i < DOM_SCHEMA_CACHE_SIZE; i++) {
+		if (dom_schema_cache[i].path) {
+			xmlSchemaFree(dom_schema_cache[i].schema);
+			pefree(dom_schema_cache[i].path, 1);
+			dom_schema_cache[i].path = NULL;
+		}
+	}
+#endif
+}
+
 static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type) /* {{{ */
 {
 	zval *id;
@@ -1800,9 +1885,10 @@ static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type
 	int valid_opts = 0;
 	zend_long flags = 0;
 	xmlSchemaParserCtxtPtr  parser;
-	xmlSchemaPtr            sptr;
+	xmlSchemaPtr            sptr = NULL;
 	xmlSchemaValidCtxtPtr   vptr;
 	int                     is_valid;
+	bool                    cached = false;
 	char resolved_path[MAXPATHLEN + 1];
 
 	id = ZEND_THIS;
@@ -1832,6 +1918,14 @@ static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type
 			php_error_docref(NULL, E_WARNING, "Invalid Schema file source");
 			RETURN_FALSE;
 		}
+#ifndef ZTS
+		sptr = dom_schema_cache_fetch(valid_file);
+		if (sptr) {
+			cached = true;
+			parser = NULL;
+			break;
+		}
+#endif
 		parser = xmlSchemaNewParserCtxt(valid_file);
 		break;
 	case DOM_LOAD_STRING:
@@ -1843,12 +1937,14 @@ static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type
 		return;
 	}
 
-	xmlSchemaSetParserErrors(parser,
-		(xmlSchemaValidityErrorFunc) php_libxml_error_handler,
-		(xmlSchemaValidityWarningFunc) php_libxml_error_handler,
-		parser);
-	sptr = xmlSchemaParse(parser);
-	xmlSchemaFreeParserCtxt(parser);
+	if (!cached) {
+		xmlSchemaSetParserErrors(parser,
+			(xmlSchemaValidityErrorFunc) php_libxml_error_handler,
+			(xmlSchemaValidityWarningFunc) php_libxml_error_handler,
+			parser);
+		sptr = xmlSchemaParse(parser);
+		xmlSchemaFreeParserCtxt(parser);
+	}
 	PHP_LIBXML_RESTORE_GLOBALS(new_parser_ctxt);
 	if (!sptr) {
 		if (!EG(exception)) {
@@ -1856,12 +1952,20 @@ static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type
 		}
 		RETURN_FALSE;
 	}
+#ifndef ZTS
+	if (!cached && type == DOM_LOAD_FILE
+	 && dom_schema_cache_store(valid_file, sptr)) {
+		cached = true;
+	}
+#endif
 
 	docp = (xmlDocPtr) dom_object_get_node(intern);
 
 	vptr = xmlSchemaNewValidCtxt(sptr);
 	if (!vptr) {
-		xmlSchemaFree(sptr);
+		if (!cached) {
+			xmlSchemaFree(sptr);
+		}
 		zend_throw_error(NULL, "Invalid Schema Validation Context");
 		RETURN_THROWS();
 	}
@@ -1874,7 +1978,9 @@ static void _dom_document_schema_validate(INTERNAL_FUNCTION_PARAMETERS, int type
 	xmlSchemaSetValidOptions(vptr, valid_opts);
 	xmlSchemaSetValidErrors(vptr, php_libxml_error_handler, php_libxml_error_handler, vptr);
 	is_valid = xmlSchemaValidateDoc(vptr, docp);
-	xmlSchemaFree(sptr);
+	if (!cached) {
+		xmlSchemaFree(sptr);
+	}
 	xmlSchemaFreeValidCtxt(vptr);
 	PHP_LIBXML_RESTORE_GLOBALS(validate);
 
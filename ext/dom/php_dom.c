@@ -1248,6 +1248,9 @@ PHP_MINFO_FUNCTION(dom)
 
 PHP_MSHUTDOWN_FUNCTION(dom) /* {{{ */
 {
+#ifdef LIBXML_SCHEMAS_ENABLED
+	dom_schema_cache_clear();
+#endif
 	zend_hash_destroy(&dom_document_prop_handlers);
 	zend_hash_destroy(&dom_abstract_base_document_prop_handlers);
 	zend_hash_destroy(&dom_xml_document_prop_handlers);
@@ -296,4 +296,8 @@ PHP_MINIT_FUNCTION(dom);
 PHP_MSHUTDOWN_FUNCTION(dom);
 PHP_MINFO_FUNCTION(dom);
 
+#ifdef LIBXML_SCHEMAS_ENABLED
+void dom_schema_cache_clear(void);
+#endif
+
 #endif /* PHP_DOM_H */
@@ -0,0 +1,61 @@
+--TEST--
+DomDocument::schemaValidate() - repeated validation and schema file replacement
+--EXTENSIONS--
+dom
+--FILE--
+<?php
+
+$schema_loose = <<<XSD
+<?xml version="1.0" encoding="UTF-8"?>
+<xs:schema xmlns:xs="http://www.w3.org/2001/XMLSchema">
+ <xs:element name="note">
+  <xs:complexType>
+   <xs:sequence>
+    <xs:element name="body" type="xs:string"/>
+   </xs:sequence>
+   <xs:anyAttribute processContents="lax"/>
+  </xs:complexType>
+ </xs:element>
+</xs:schema>
+XSD;
+
+$schema_strict = <<<XSD
+<?xml version="1.0" encoding="UTF-8"?>
+<xs:schema xmlns:xs="http://www.w3.org/2001/XMLSchema">
+ <xs:element name="note">
+  <xs:complexType>
+   <xs:sequence>
+    <xs:element name="body" type="xs:string"/>
+    <xs:element name="subject" type="xs:string"/>
+   </xs:sequence>
+  </xs:complexType>
+ </xs:element>
+</xs:schema>
+XSD;
+
+$file = __DIR__ . '/schemaValidate_cache.xsd';
+file_put_contents($file, $schema_loose);
+
+$doc = new DOMDocument;
+$doc->loadXML('<note><body>hi</body></note>');
+
+/* repeated validations against the same file reuse the compiled schema */
+var_dump($doc->schemaValidate($file));
+var_dump($doc->schemaValidate($file));
+
+/* replacing the schema file must be picked up */
+file_put_contents($file, $schema_strict);
+touch($file, time() + 2);
+var_dump($doc->schemaValidate($file));
+
+?>
+--CLEAN--
+<?php
+unlink(__DIR__ . '/schemaValidate_cache.xsd');
+?>
+--EXPECTF--
+bool(true)
+bool(true)
+
+Warning: DOMDocument::schemaValidate(): Element 'note': Missing child element(s). Expected is ( subject ). in %s on line %d
+bool(false)
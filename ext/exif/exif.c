@@ -93,6 +93,7 @@ ZEND_BEGIN_MODULE_GLOBALS(exif)
 	char * encode_jis;
 	char * decode_jis_be;
 	char * decode_jis_le;
+	zend_long scan_limit;
 	HashTable *tag_table_cache;
 ZEND_END_MODULE_GLOBALS(exif)
 
@@ -142,6 +143,7 @@ PHP_INI_BEGIN()
 	STD_PHP_INI_ENTRY("exif.encode_jis",              "",            PHP_INI_ALL, OnUpdateEncode, encode_jis,        zend_exif_globals, exif_globals)
 	STD_PHP_INI_ENTRY("exif.decode_jis_motorola",     "JIS",         PHP_INI_ALL, OnUpdateDecode, decode_jis_be,     zend_exif_globals, exif_globals)
 	STD_PHP_INI_ENTRY("exif.decode_jis_intel",        "JIS",         PHP_INI_ALL, OnUpdateDecode, decode_jis_le,     zend_exif_globals, exif_globals)
+	STD_PHP_INI_ENTRY("exif.scan_limit",              "0",           PHP_INI_ALL, OnUpdateLong,   scan_limit,        zend_exif_globals, exif_globals)
 PHP_INI_END()
 /* }}} */
 
@@ -157,6 +159,7 @@ static PHP_GINIT_FUNCTION(exif)
 	exif_globals->encode_jis        = NULL;
 	exif_globals->decode_jis_be     = NULL;
 	exif_globals->decode_jis_le     = NULL;
+	exif_globals->scan_limit        = 0;
 	exif_globals->tag_table_cache   = NULL;
 }
 /* }}} */
@@ -3822,6 +3825,13 @@ static bool exif_scan_JPEG_header(image_info_type *ImageInfo)
 
 		fpos = php_stream_tell(ImageInfo->infile);
 
+		/* All metadata of interest lives in the marker prefix, so a scan limit
+		   (exif.scan_limit, bytes, 0 = unlimited) lets intake pipelines stop
+		   walking the marker stream instead of touching the whole file. */
+		if (EXIF_G(scan_limit) > 0 && fpos > (size_t)EXIF_G(scan_limit)) {
+			return (ImageInfo->sections_found&(~FOUND_COMPUTED)) ? true : false;
+		}
+
 		/* safety net in case the above algorithm change dramatically, should not trigger */
 		ZEND_ASSERT(marker != 0xff);
 
@@ -3846,6 +3856,38 @@ static bool exif_scan_JPEG_header(image_info_type *ImageInfo)
 			return false;
 		}
 
+		switch(marker) {
+			case M_SOS:
+			case M_EOI:
+			case M_COM:
+			case M_EXIF:
+			case M_APP12:
+			case M_SOF0:
+			case M_SOF1:
+			case M_SOF2:
+			case M_SOF3:
+			case M_SOF5:
+			case M_SOF6:
+			case M_SOF7:
+			case M_SOF9:
+			case M_SOF10:
+			case M_SOF11:
+			case M_SOF13:
+			case M_SOF14:
+			case M_SOF15:
+				break;
+			default:
+				/* Nothing below looks at the payload: seek past it instead of
+				   buffering (APPn blobs like ICC profiles can be near 64K each). */
+				if (ImageInfo->FileSize < fpos + itemlen
+				 || php_stream_seek(ImageInfo->infile, itemlen-2, SEEK_CUR) != 0) {
+					EXIF_ERRLOG_FILEEOF(ImageInfo)
+					return false;
+				}
+				last_marker = marker;
+				continue;
+		}
+
 		sn = exif_file_sections_add(ImageInfo, marker, itemlen, NULL);
 		Data = ImageInfo->file.list[sn].data;
 
@@ -733,6 +733,79 @@ static void zend_ffi_zval_to_bit_field(void *ptr, zend_ffi_field *field, zval *v
 }
 /* }}} */
 
+/* Bulk conversion of a packed PHP array of scalars into a C array. Filling a
+ * C array element-by-element goes through the dimension handlers and
+ * dominates marshaling cost; here the zvals are read in one flat loop with
+ * direct stores. */
+static zend_never_inline zend_result zend_ffi_zval_to_cdata_array(void *ptr, zend_ffi_type *type, zval *value) /* {{{ */
+{
+	zend_ffi_type *el_type = ZEND_FFI_TYPE(type->array.type);
+	HashTable *ht = Z_ARRVAL_P(value);
+	char *p = (char*)ptr;
+	zval *zv;
+
+	if ((type->attr & (ZEND_FFI_ATTR_INCOMPLETE_ARRAY|ZEND_FFI_ATTR_VLA))
+	 || !HT_IS_PACKED(ht)
+	 || zend_hash_num_elements(ht) > type->array.length) {
+		zend_ffi_assign_incompatible(value, type);
+		return FAILURE;
+	}
+
+	switch (el_type->kind) {
+		case ZEND_FFI_TYPE_FLOAT:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(float*)p = (float)zval_get_double(zv);
+				p += sizeof(float);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_DOUBLE:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(double*)p = zval_get_double(zv);
+				p += sizeof(double);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_UINT8:
+		case ZEND_FFI_TYPE_SINT8:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(uint8_t*)p = (uint8_t)zval_get_long(zv);
+				p += sizeof(uint8_t);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_UINT16:
+		case ZEND_FFI_TYPE_SINT16:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(uint16_t*)p = (uint16_t)zval_get_long(zv);
+				p += sizeof(uint16_t);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_UINT32:
+		case ZEND_FFI_TYPE_SINT32:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(uint32_t*)p = (uint32_t)zval_get_long(zv);
+				p += sizeof(uint32_t);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_UINT64:
+		case ZEND_FFI_TYPE_SINT64:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(uint64_t*)p = (uint64_t)zval_get_long(zv);
+				p += sizeof(uint64_t);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		case ZEND_FFI_TYPE_BOOL:
+			ZEND_HASH_PACKED_FOREACH_VAL(ht, zv) {
+				*(uint8_t*)p = zend_is_true(zv);
+				p += sizeof(uint8_t);
+			} ZEND_HASH_FOREACH_END();
+			break;
+		default:
+			zend_ffi_assign_incompatible(value, type);
+			return FAILURE;
+	}
+	return SUCCESS;
+}
+/* }}} */
+
 static zend_always_inline zend_result zend_ffi_zval_to_cdata(void *ptr, zend_ffi_type *type, zval *value) /* {{{ */
 {
 	zend_long lval;
@@ -857,8 +930,13 @@ again:
 			}
 			zend_ffi_assign_incompatible(value, type);
 			return FAILURE;
-		case ZEND_FFI_TYPE_STRUCT:
 		case ZEND_FFI_TYPE_ARRAY:
+			if (Z_TYPE_P(value) == IS_ARRAY) {
+				return zend_ffi_zval_to_cdata_array(ptr, type, value);
+			}
+			zend_ffi_assign_incompatible(value, type);
+			return FAILURE;
+		case ZEND_FFI_TYPE_STRUCT:
 		default:
 			/* Incompatible types, because otherwise the CData check at the entry point would've succeeded. */
 			zend_ffi_assign_incompatible(value, type);
@@ -0,0 +1,48 @@
+--TEST--
+FFI: bulk assignment of packed PHP arrays to C arrays
+--EXTENSIONS--
+ffi
+--INI--
+ffi.enable=1
+--FILE--
+<?php
+$s = FFI::new("struct { int32_t v[4]; double d[2]; uint8_t b[3]; }");
+$s->v = [1, 2, 3, 4];
+var_dump($s->v[0], $s->v[3]);
+
+// partial assignment leaves the tail untouched
+$s->v = [9];
+var_dump($s->v[0], $s->v[1]);
+
+$s->d = [1.5, "2.5"];
+var_dump($s->d[0], $s->d[1]);
+
+$s->b = [true, false, 2];
+var_dump($s->b[0], $s->b[1], $s->b[2]);
+
+// too many elements
+try {
+    $s->v = [1, 2, 3, 4, 5];
+} catch (FFI\Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+
+// non-packed arrays are rejected
+try {
+    $s->v = ["x" => 1];
+} catch (FFI\Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECTF--
+int(1)
+int(4)
+int(9)
+int(2)
+float(1.5)
+float(2.5)
+int(1)
+int(0)
+int(2)
+Incompatible types when assigning to type '%s'
+Incompatible types when assigning to type '%s'
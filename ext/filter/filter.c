@@ -148,6 +148,7 @@ ZEND_TSRMLS_CACHE_UPDATE();
 	ZVAL_UNDEF(&filter_globals->session_array);
 #endif
 	filter_globals->default_filter = FILTER_DEFAULT;
+	filter_globals->compiled_defs = NULL;
 }
 /* }}} */
 
@@ -192,6 +193,11 @@ PHP_RSHUTDOWN_FUNCTION(filter)
 #if 0
 	VAR_ARRAY_COPY_DTOR(session_array)
 #endif
+	if (IF_G(compiled_defs)) {
+		zend_hash_destroy(IF_G(compiled_defs));
+		FREE_HASHTABLE(IF_G(compiled_defs));
+		IF_G(compiled_defs) = NULL;
+	}
 	return SUCCESS;
 }
 /* }}} */
@@ -456,66 +462,67 @@ PHP_FUNCTION(filter_has_var)
 }
 /* }}} */
 
-static void php_filter_call(
-	zval *filtered, zend_long filter, HashTable *filter_args_ht, zend_long filter_args_long,
-	const int copy, zend_long filter_flags
-) /* {{{ */ {
-	zval *options = NULL;
+/* A single field of a filter definition with the "filter"/"flags"/"options"
+ * members already resolved, so applying it does not need any hash lookups. */
+typedef struct {
+	zend_string *key;     /* field name, borrowed from the definition */
+	zend_long    filter;
+	zend_long    flags;
+	zval        *options; /* borrowed from the definition, may be NULL */
+} php_filter_spec;
+
+typedef struct {
+	uint32_t        num;
+	php_filter_spec specs[1];
+} php_filter_program;
+
+static void php_filter_parse_args(php_filter_spec *spec, HashTable *filter_args_ht) /* {{{ */
+{
 	zval *option;
-	char *charset = NULL;
 
-	if (!filter_args_ht) {
-		if (filter != -1) { /* handler for array apply */
-			/* filter_args is the filter_flags */
-			filter_flags = filter_args_long;
+	if ((option = zend_hash_str_find(filter_args_ht, "filter", sizeof("filter") - 1)) != NULL) {
+		spec->filter = zval_get_long(option);
+	}
 
-			if (!(filter_flags & FILTER_REQUIRE_ARRAY ||  filter_flags & FILTER_FORCE_ARRAY)) {
-				filter_flags |= FILTER_REQUIRE_SCALAR;
+	if ((option = zend_hash_str_find_deref(filter_args_ht, "options", sizeof("options") - 1)) != NULL) {
+		if (spec->filter != FILTER_CALLBACK) {
+			if (Z_TYPE_P(option) == IS_ARRAY) {
+				spec->options = option;
 			}
 		} else {
-			filter = filter_args_long;
-		}
-	} else {
-		if ((option = zend_hash_str_find(filter_args_ht, "filter", sizeof("filter") - 1)) != NULL) {
-			filter = zval_get_long(option);
-		}
-
-		if ((option = zend_hash_str_find_deref(filter_args_ht, "options", sizeof("options") - 1)) != NULL) {
-			if (filter != FILTER_CALLBACK) {
-				if (Z_TYPE_P(option) == IS_ARRAY) {
-					options = option;
-				}
-			} else {
-				options = option;
-				filter_flags = 0;
-			}
+			spec->options = option;
+			spec->flags = 0;
 		}
+	}
 
-		if ((option = zend_hash_str_find(filter_args_ht, "flags", sizeof("flags") - 1)) != NULL) {
-			filter_flags = zval_get_long(option);
+	if ((option = zend_hash_str_find(filter_args_ht, "flags", sizeof("flags") - 1)) != NULL) {
+		spec->flags = zval_get_long(option);
 
-			if (!(filter_flags & FILTER_REQUIRE_ARRAY ||  filter_flags & FILTER_FORCE_ARRAY)) {
-				filter_flags |= FILTER_REQUIRE_SCALAR;
-			}
+		if (!(spec->flags & FILTER_REQUIRE_ARRAY ||  spec->flags & FILTER_FORCE_ARRAY)) {
+			spec->flags |= FILTER_REQUIRE_SCALAR;
 		}
 	}
+}
+/* }}} */
 
+static void php_filter_apply_spec(zval *filtered, const php_filter_spec *spec, const int copy) /* {{{ */
+{
 	if (Z_TYPE_P(filtered) == IS_ARRAY) {
-		if (filter_flags & FILTER_REQUIRE_SCALAR) {
+		if (spec->flags & FILTER_REQUIRE_SCALAR) {
 			zval_ptr_dtor(filtered);
-			if (filter_flags & FILTER_NULL_ON_FAILURE) {
+			if (spec->flags & FILTER_NULL_ON_FAILURE) {
 				ZVAL_NULL(filtered);
 			} else {
 				ZVAL_FALSE(filtered);
 			}
 			return;
 		}
-		php_zval_filter_recursive(filtered, filter, filter_flags, options, charset, copy);
+		php_zval_filter_recursive(filtered, spec->filter, spec->flags, spec->options, NULL, copy);
 		return;
 	}
-	if (filter_flags & FILTER_REQUIRE_ARRAY) {
+	if (spec->flags & FILTER_REQUIRE_ARRAY) {
 		zval_ptr_dtor(filtered);
-		if (filter_flags & FILTER_NULL_ON_FAILURE) {
+		if (spec->flags & FILTER_NULL_ON_FAILURE) {
 			ZVAL_NULL(filtered);
 		} else {
 			ZVAL_FALSE(filtered);
@@ -523,8 +530,8 @@ static void php_filter_call(
 		return;
 	}
 
-	php_zval_filter(filtered, filter, filter_flags, options, charset, copy);
-	if (filter_flags & FILTER_FORCE_ARRAY) {
+	php_zval_filter(filtered, spec->filter, spec->flags, spec->options, NULL, copy);
+	if (spec->flags & FILTER_FORCE_ARRAY) {
 		zval tmp;
 		ZVAL_COPY_VALUE(&tmp, filtered);
 		array_init(filtered);
@@ -533,43 +540,157 @@ static void php_filter_call(
 }
 /* }}} */
 
+static void php_filter_call(
+	zval *filtered, zend_long filter, HashTable *filter_args_ht, zend_long filter_args_long,
+	const int copy, zend_long filter_flags
+) /* {{{ */ {
+	php_filter_spec spec;
+
+	spec.key = NULL;
+	spec.filter = filter;
+	spec.flags = filter_flags;
+	spec.options = NULL;
+
+	if (!filter_args_ht) {
+		if (filter != -1) { /* handler for array apply */
+			/* filter_args is the filter_flags */
+			spec.flags = filter_args_long;
+
+			if (!(spec.flags & FILTER_REQUIRE_ARRAY ||  spec.flags & FILTER_FORCE_ARRAY)) {
+				spec.flags |= FILTER_REQUIRE_SCALAR;
+			}
+		} else {
+			spec.filter = filter_args_long;
+		}
+	} else {
+		php_filter_parse_args(&spec, filter_args_ht);
+	}
+
+	php_filter_apply_spec(filtered, &spec, copy);
+}
+/* }}} */
+
+/* Resolves every field of a definition array once, up front; returns NULL and
+ * throws when the definition contains a non-string or empty key. Programs that
+ * go into the per-request cache live until request end and are never freed
+ * individually, so they come from the request arena instead of the heap. */
+static php_filter_program *php_filter_compile_definition(HashTable *op_ht, bool cached) /* {{{ */
+{
+	php_filter_program *program;
+	php_filter_spec *spec;
+	zend_string *arg_key;
+	zval *arg_elm;
+
+	if (cached) {
+		program = zend_request_arena_alloc(zend_safe_address_guarded(
+			zend_hash_num_elements(op_ht), sizeof(php_filter_spec), sizeof(php_filter_program)));
+	} else {
+		program = safe_emalloc(zend_hash_num_elements(op_ht), sizeof(php_filter_spec), sizeof(php_filter_program));
+	}
+	program->num = 0;
+	spec = program->specs;
+
+	ZEND_HASH_FOREACH_STR_KEY_VAL(op_ht, arg_key, arg_elm) {
+		if (arg_key == NULL) {
+			zend_argument_type_error(2, "must contain only string keys");
+			goto failure;
+		}
+		if (ZSTR_LEN(arg_key) == 0) {
+			zend_argument_value_error(2, "cannot contain empty keys");
+			goto failure;
+		}
+
+		spec->key = arg_key;
+		spec->filter = -1;
+		spec->flags = FILTER_REQUIRE_SCALAR;
+		spec->options = NULL;
+
+		if (Z_TYPE_P(arg_elm) == IS_ARRAY) {
+			php_filter_parse_args(spec, Z_ARRVAL_P(arg_elm));
+		} else {
+			spec->filter = zval_get_long(arg_elm);
+		}
+
+		spec++;
+		program->num++;
+	} ZEND_HASH_FOREACH_END();
+
+	return program;
+
+failure:
+	if (!cached) {
+		efree(program);
+	}
+	return NULL;
+}
+/* }}} */
+
+static php_filter_program *php_filter_get_program(HashTable *op_ht, bool *cached) /* {{{ */
+{
+	php_filter_program *program;
+
+	/* Definitions written as constant array literals are immutable and keep
+	 * their address for the whole request, so the compiled form can be reused
+	 * by every later call with the same definition. */
+	if (!(GC_FLAGS(op_ht) & IS_ARRAY_IMMUTABLE)) {
+		*cached = false;
+		return php_filter_compile_definition(op_ht, false);
+	}
+
+	*cached = true;
+	if (!IF_G(compiled_defs)) {
+		ALLOC_HASHTABLE(IF_G(compiled_defs));
+		/* no destructor: the programs live in the request arena */
+		zend_hash_init(IF_G(compiled_defs), 8, NULL, NULL, 0);
+	} else if ((program = zend_hash_index_find_ptr(IF_G(compiled_defs), (zend_ulong)(uintptr_t)op_ht)) != NULL) {
+		return program;
+	}
+
+	program = php_filter_compile_definition(op_ht, true);
+	if (program) {
+		zend_hash_index_add_new_ptr(IF_G(compiled_defs), (zend_ulong)(uintptr_t)op_ht, program);
+	}
+	return program;
+}
+/* }}} */
+
 static void php_filter_array_handler(zval *input, HashTable *op_ht, zend_long op_long,
 	zval *return_value, bool add_empty
 ) /* {{{ */ {
-	zend_string *arg_key;
-	zval *tmp, *arg_elm;
+	zval *tmp;
 
 	if (!op_ht) {
 		ZVAL_DUP(return_value, input);
 		php_filter_call(return_value, -1, NULL, op_long, 0, FILTER_REQUIRE_ARRAY);
 	} else {
+		bool cached;
+		php_filter_program *program = php_filter_get_program(op_ht, &cached);
+
+		if (!program) {
+			RETURN_THROWS();
+		}
+
 		array_init(return_value);
 
-		ZEND_HASH_FOREACH_STR_KEY_VAL(op_ht, arg_key, arg_elm) {
-			if (arg_key == NULL) {
-				zend_argument_type_error(2, "must contain only string keys");
-				RETURN_THROWS();
-	 		}
-			if (ZSTR_LEN(arg_key) == 0) {
-				zend_argument_value_error(2, "cannot contain empty keys");
-				RETURN_THROWS();
-			}
-			if ((tmp = zend_hash_find(Z_ARRVAL_P(input), arg_key)) == NULL) {
+		for (uint32_t i = 0; i < program->num; i++) {
+			const php_filter_spec *spec = &program->specs[i];
+
+			if ((tmp = zend_hash_find(Z_ARRVAL_P(input), spec->key)) == NULL) {
 				if (add_empty) {
-					add_assoc_null_ex(return_value, ZSTR_VAL(arg_key), ZSTR_LEN(arg_key));
+					add_assoc_null_ex(return_value, ZSTR_VAL(spec->key), ZSTR_LEN(spec->key));
 				}
 			} else {
 				zval nval;
 				ZVAL_DEREF(tmp);
 				ZVAL_DUP(&nval, tmp);
-				php_filter_call(&nval, -1,
-					Z_TYPE_P(arg_elm) == IS_ARRAY ? Z_ARRVAL_P(arg_elm) : NULL,
-					Z_TYPE_P(arg_elm) == IS_ARRAY ? 0 : zval_get_long(arg_elm),
-					0, FILTER_REQUIRE_SCALAR
-				);
-				zend_hash_update(Z_ARRVAL_P(return_value), arg_key, &nval);
+				php_filter_apply_spec(&nval, spec, 0);
+				zend_hash_update(Z_ARRVAL_P(return_value), spec->key, &nval);
 			}
-		} ZEND_HASH_FOREACH_END();
+		}
+
+		if (!cached) {
+			efree(program);
+		}
 	}
 }
 /* }}} */
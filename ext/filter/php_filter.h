@@ -49,6 +49,7 @@ ZEND_BEGIN_MODULE_GLOBALS(filter)
 #endif
 	zend_long default_filter;
 	zend_long default_filter_flags;
+	HashTable *compiled_defs;
 ZEND_END_MODULE_GLOBALS(filter)
 
 #if defined(COMPILE_DL_FILTER) && defined(ZTS)
@@ -0,0 +1,76 @@
+--TEST--
+filter_var_array() with the same constant definition applied repeatedly
+--EXTENSIONS--
+filter
+--FILE--
+<?php
+
+const DEFINITION = [
+    'id'    => FILTER_VALIDATE_INT,
+    'score' => [
+        'filter'  => FILTER_VALIDATE_INT,
+        'options' => ['min_range' => 0, 'max_range' => 100],
+    ],
+    'email' => FILTER_VALIDATE_EMAIL,
+    'tags'  => [
+        'filter' => FILTER_DEFAULT,
+        'flags'  => FILTER_REQUIRE_ARRAY,
+    ],
+    'name'  => [
+        'filter'  => FILTER_CALLBACK,
+        'options' => 'strtoupper',
+    ],
+];
+
+$inputs = [
+    ['id' => '7', 'score' => '55', 'email' => 'a@example.com', 'tags' => ['x'], 'name' => 'ann'],
+    ['id' => 'nope', 'score' => '101', 'email' => 'not-an-email', 'tags' => 'scalar'],
+];
+
+foreach ($inputs as $input) {
+    var_dump(filter_var_array($input, DEFINITION));
+}
+
+/* Mutable definitions are re-read on every call */
+$definition = ['id' => FILTER_VALIDATE_INT];
+var_dump(filter_var_array(['id' => '1'], $definition));
+$definition['id'] = FILTER_VALIDATE_EMAIL;
+var_dump(filter_var_array(['id' => '1'], $definition));
+
+?>
+--EXPECT--
+array(5) {
+  ["id"]=>
+  int(7)
+  ["score"]=>
+  int(55)
+  ["email"]=>
+  string(13) "a@example.com"
+  ["tags"]=>
+  array(1) {
+    [0]=>
+    string(1) "x"
+  }
+  ["name"]=>
+  string(3) "ANN"
+}
+array(5) {
+  ["id"]=>
+  bool(false)
+  ["score"]=>
+  bool(false)
+  ["email"]=>
+  bool(false)
+  ["tags"]=>
+  bool(false)
+  ["name"]=>
+  NULL
+}
+array(1) {
+  ["id"]=>
+  int(1)
+}
+array(1) {
+  ["id"]=>
+  bool(false)
+}
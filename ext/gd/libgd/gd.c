@@ -2517,6 +2517,62 @@ void gdImageCopyResampled (gdImagePtr dst, gdImagePtr src, int dstX, int dstY, i
 		gdImageCopyResized (dst, src, dstX, dstY, srcX, srcY, dstW, dstH, srcW, srcH);
 		return;
 	}
+
+	/* Fast path for exact integer downscales (2x/4x thumbnails etc.): every
+	 * source pixel contributes with weight 1, so whole blocks can be
+	 * accumulated with integer arithmetic on the rows directly instead of
+	 * going through gdImageGetTrueColorPixel() per sample. The division
+	 * sequence mirrors the general code below, so the output is identical. */
+	if (src->trueColor
+	    && dstW > 0 && dstH > 0
+	    && srcW >= dstW && srcH >= dstH
+	    && srcW % dstW == 0 && srcH % dstH == 0
+	    && srcX >= 0 && srcY >= 0
+	    && srcX + srcW <= src->sx && srcY + srcH <= src->sy) {
+		const int fx = srcW / dstW;
+		const int fy = srcH / dstH;
+		const double spixels = (double) fx * (double) fy;
+
+		for (y = 0; y < dstH; y++) {
+			for (x = 0; x < dstW; x++) {
+				int64_t rsum = 0, gsum = 0, bsum = 0, asum = 0, aacc = 0;
+				double red, green, blue, alpha, alpha_sum;
+				int i, j;
+
+				for (j = 0; j < fy; j++) {
+					const int *row = src->tpixels[srcY + y * fy + j] + srcX + x * fx;
+
+					for (i = 0; i < fx; i++) {
+						const int p = row[i];
+						const int w = gdAlphaMax - gdTrueColorGetAlpha (p);
+
+						rsum += gdTrueColorGetRed (p) * w;
+						gsum += gdTrueColorGetGreen (p) * w;
+						bsum += gdTrueColorGetBlue (p) * w;
+						aacc += gdTrueColorGetAlpha (p);
+						asum += w;
+					}
+				}
+				red = (double) rsum / spixels;
+				green = (double) gsum / spixels;
+				blue = (double) bsum / spixels;
+				alpha = (double) aacc / spixels;
+				alpha_sum = (double) asum / spixels;
+				if (asum != 0) {
+					red /= alpha_sum;
+					green /= alpha_sum;
+					blue /= alpha_sum;
+				}
+				red = red >= 255.5 ? 255 : red+0.5;
+				blue = blue >= 255.5 ? 255 : blue+0.5;
+				green = green >= 255.5 ? 255 : green+0.5;
+				alpha = alpha >= gdAlphaMax+0.5 ? gdAlphaMax : alpha+0.5;
+				gdImageSetPixel (dst, dstX + x, dstY + y, gdTrueColorAlpha ((int)red, (int)green, (int)blue, (int)alpha));
+			}
+		}
+		return;
+	}
+
 	for (y = dstY; (y < dstY + dstH); y++) {
 		sy1 = ((double) y - (double) dstY) * (double) srcH / (double) dstH;
 		sy2 = ((double) (y + 1) - (double) dstY) * (double) srcH / (double) dstH;
@@ -41,6 +41,9 @@
 # endif
 #endif
 
+/* Window size used when hashing files straight out of a mapping */
+#define PHP_HASH_FILE_MAP_CHUNK (1024 * 1024)
+
 static HashTable php_hash_hashtable;
 zend_class_entry *php_hashcontext_ce;
 static zend_object_handlers php_hashcontext_handlers;
@@ -355,6 +358,45 @@ PHP_HASH_API int php_hash_unserialize(php_hashcontext_object *hash, zend_long ma
 
 /* Userspace */
 
+/* {{{ php_hash_update_from_stream
+ * Feeds the whole stream into the hash context.  Plain files are mapped and
+ * hashed straight out of the page cache in PHP_HASH_FILE_MAP_CHUNK windows;
+ * anything the mapping doesn't cover (or streams that can't be mapped at all)
+ * goes through the regular read loop. */
+static zend_result php_hash_update_from_stream(const php_hash_ops *ops, void *context, php_stream *stream)
+{
+	char buf[1024];
+	ssize_t n;
+
+	if (php_stream_mmap_possible(stream)) {
+		char *p;
+
+		do {
+			size_t mapped;
+
+			p = php_stream_mmap_range(stream, php_stream_tell(stream), PHP_HASH_FILE_MAP_CHUNK, PHP_STREAM_MAP_MODE_SHARED_READONLY, &mapped);
+			if (p) {
+				if (php_stream_seek(stream, mapped, SEEK_CUR) != 0) {
+					php_stream_mmap_unmap(stream);
+					break;
+				}
+				ops->hash_update(context, (unsigned char *) p, mapped);
+				php_stream_mmap_unmap(stream);
+				if (mapped < PHP_HASH_FILE_MAP_CHUNK) {
+					/* Short mapping: end of file */
+					return SUCCESS;
+				}
+			}
+		} while (p);
+	}
+
+	while ((n = php_stream_read(stream, buf, sizeof(buf))) > 0) {
+		ops->hash_update(context, (unsigned char *) buf, n);
+	}
+	return n < 0 ? FAILURE : SUCCESS;
+}
+/* }}} */
+
 static void php_hash_do_hash(
 	zval *return_value, zend_string *algo, char *data, size_t data_len, bool raw_output, bool isfilename, HashTable *args
 ) /* {{{ */ {
@@ -384,14 +426,10 @@ static void php_hash_do_hash(
 	ops->hash_init(context, args);
 
 	if (isfilename) {
-		char buf[1024];
-		ssize_t n;
+		zend_result status = php_hash_update_from_stream(ops, context, stream);
 
-		while ((n = php_stream_read(stream, buf, sizeof(buf))) > 0) {
-			ops->hash_update(context, (unsigned char *) buf, n);
-		}
 		php_stream_close(stream);
-		if (n < 0) {
+		if (status == FAILURE) {
 			efree(context);
 			RETURN_FALSE;
 		}
@@ -531,15 +569,12 @@ static void php_hash_do_hash_hmac(
 	php_hash_hmac_prep_key(K, ops, context, (unsigned char *) key, key_len);
 
 	if (isfilename) {
-		char buf[1024];
-		ssize_t n;
+		zend_result status;
 		ops->hash_init(context, NULL);
 		ops->hash_update(context, K, ops->block_size);
-		while ((n = php_stream_read(stream, buf, sizeof(buf))) > 0) {
-			ops->hash_update(context, (unsigned char *) buf, n);
-		}
+		status = php_hash_update_from_stream(ops, context, stream);
 		php_stream_close(stream);
-		if (n < 0) {
+		if (status == FAILURE) {
 			efree(context);
 			efree(K);
 			zend_string_release(digest);
@@ -749,8 +784,7 @@ PHP_FUNCTION(hash_update_file)
 	php_stream_context *context = NULL;
 	php_stream *stream;
 	zend_string *filename;
-	char buf[1024];
-	ssize_t n;
+	zend_result status;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "OP|r!", &zhash, php_hashcontext_ce, &filename, &zcontext) == FAILURE) {
 		RETURN_THROWS();
@@ -766,12 +800,10 @@ PHP_FUNCTION(hash_update_file)
 		RETURN_FALSE;
 	}
 
-	while ((n = php_stream_read(stream, buf, sizeof(buf))) > 0) {
-		hash->ops->hash_update(hash->context, (unsigned char *) buf, n);
-	}
+	status = php_hash_update_from_stream(hash->ops, hash->context, stream);
 	php_stream_close(stream);
 
-	RETURN_BOOL(n >= 0);
+	RETURN_BOOL(status == SUCCESS);
 }
 /* }}} */
 
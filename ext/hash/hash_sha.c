@@ -196,6 +196,102 @@ static void SHA256Transform(uint32_t state[8], const unsigned char block[64])
 }
 /* }}} */
 
+#if defined(__x86_64__) && defined(HAVE_FUNC_ATTRIBUTE_TARGET) && defined(HAVE_IMMINTRIN_H)
+# define PHP_HASH_SHA_NI 1
+# include <immintrin.h>
+# include "Zend/zend_cpuinfo.h"
+
+/* {{{ SHA256Transform_shani
+ * SHA256 transformation over whole blocks using the x86 SHA extensions.
+ * The message schedule and round computation run four rounds at a time in
+ * the sha256msg1/sha256msg2/sha256rnds2 instructions; keeping the state in
+ * registers across blocks is what makes the multi-block signature pay off.
+ */
+static void SHA256Transform_shani(uint32_t state[8], const unsigned char *input, size_t blocks)
+	__attribute__((target("sha,sse4.1")));
+
+static void SHA256Transform_shani(uint32_t state[8], const unsigned char *input, size_t blocks)
+{
+	const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	__m128i state0, state1, tmp, msg, msgs[4];
+
+	/* Reorder the state words into the ABEF/CDGH lane layout the
+	 * sha256rnds2 instruction expects. */
+	tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0xB1); /* CDAB */
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[4]), 0x1B); /* EFGH */
+	state0 = _mm_alignr_epi8(tmp, state1, 8);    /* ABEF */
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0); /* CDGH */
+
+	while (blocks--) {
+		const __m128i abef = state0, cdgh = state1;
+		int i;
+
+		/* Rounds 0-15: straight out of the message block */
+		for (i = 0; i < 4; i++) {
+			msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (input + 16 * i)), byteswap);
+			msg = _mm_add_epi32(msgs[i], _mm_loadu_si128((const __m128i *) &SHA256_K[4 * i]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+		}
+
+		/* Rounds 16-63: schedule four new message words per iteration */
+		for (i = 4; i < 16; i++) {
+			tmp = _mm_alignr_epi8(msgs[(i - 1) & 3], msgs[(i - 2) & 3], 4);
+			msg = _mm_sha256msg1_epu32(msgs[(i - 4) & 3], msgs[(i - 3) & 3]);
+			msg = _mm_add_epi32(msg, tmp);
+			msg = _mm_sha256msg2_epu32(msg, msgs[(i - 1) & 3]);
+			msgs[i & 3] = msg;
+			msg = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i *) &SHA256_K[4 * i]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+		}
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+		input += 64;
+	}
+
+	tmp    = _mm_shuffle_epi32(state0, 0x1B);    /* FEBA */
+	state1 = _mm_shuffle_epi32(state1, 0xB1);    /* DCHG */
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0); /* DCBA */
+	state1 = _mm_alignr_epi8(state1, tmp, 8);    /* HGFE */
+	_mm_storeu_si128((__m128i *) &state[0], state0);
+	_mm_storeu_si128((__m128i *) &state[4], state1);
+}
+/* }}} */
+
+static bool SHA256UseSHANI(void)
+{
+	static int enabled = -1;
+
+	if (UNEXPECTED(enabled < 0)) {
+		enabled = zend_cpu_supports(ZEND_CPU_FEATURE_SHA);
+	}
+	return enabled;
+}
+#endif /* PHP_HASH_SHA_NI */
+
+/* {{{ SHA256TransformBlocks
+ * Runs the transform over a run of whole 64-byte blocks, hardware
+ * accelerated where the CPU allows it.
+ */
+static void SHA256TransformBlocks(uint32_t state[8], const unsigned char *input, size_t blocks)
+{
+#ifdef PHP_HASH_SHA_NI
+	if (SHA256UseSHANI()) {
+		SHA256Transform_shani(state, input, blocks);
+		return;
+	}
+#endif
+	while (blocks--) {
+		SHA256Transform(state, input);
+		input += 64;
+	}
+}
+/* }}} */
+
 /* {{{ PHP_SHA224InitArgs
  * SHA224 initialization. Begins an SHA224 operation, writing a new context.
  */
@@ -242,9 +338,8 @@ PHP_HASH_API void PHP_SHA224Update(PHP_SHA224_CTX * context, const unsigned char
 		memcpy((unsigned char*) & context->buffer[index], (unsigned char*) input, partLen);
 		SHA256Transform(context->state, context->buffer);
 
-		for (i = partLen; i + 63 < inputLen; i += 64) {
-			SHA256Transform(context->state, &input[i]);
-		}
+		SHA256TransformBlocks(context->state, &input[partLen], (inputLen - partLen) >> 6);
+		i = partLen + ((inputLen - partLen) & ~(size_t) 0x3F);
 
 		index = 0;
 	} else {
@@ -320,9 +415,8 @@ PHP_HASH_API void PHP_SHA256Update(PHP_SHA256_CTX * context, const unsigned char
 		memcpy((unsigned char*) & context->buffer[index], (unsigned char*) input, partLen);
 		SHA256Transform(context->state, context->buffer);
 
-		for (i = partLen; i + 63 < inputLen; i += 64) {
-			SHA256Transform(context->state, &input[i]);
-		}
+		SHA256TransformBlocks(context->state, &input[partLen], (inputLen - partLen) >> 6);
+		i = partLen + ((inputLen - partLen) & ~(size_t) 0x3F);
 
 		index = 0;
 	} else {
@@ -88,6 +88,7 @@ static char *get_iconv_version(void) {
 
 ZEND_DECLARE_MODULE_GLOBALS(iconv)
 static PHP_GINIT_FUNCTION(iconv);
+static PHP_GSHUTDOWN_FUNCTION(iconv);
 
 /* {{{ iconv_module_entry */
 zend_module_entry iconv_module_entry = {
@@ -102,7 +103,7 @@ zend_module_entry iconv_module_entry = {
 	PHP_ICONV_VERSION,
 	PHP_MODULE_GLOBALS(iconv),
 	PHP_GINIT(iconv),
-	NULL,
+	PHP_GSHUTDOWN(iconv),
 	NULL,
 	STANDARD_MODULE_PROPERTIES_EX
 };
@@ -124,6 +125,27 @@ static PHP_GINIT_FUNCTION(iconv)
 	iconv_globals->input_encoding = NULL;
 	iconv_globals->output_encoding = NULL;
 	iconv_globals->internal_encoding = NULL;
+	memset(iconv_globals->cd_cache, 0, sizeof(iconv_globals->cd_cache));
+	iconv_globals->cd_cache_next = 0;
+}
+/* }}} */
+
+/* {{{ PHP_GSHUTDOWN_FUNCTION */
+static PHP_GSHUTDOWN_FUNCTION(iconv)
+{
+	int i;
+
+	for (i = 0; i < PHP_ICONV_CD_CACHE_SIZE; i++) {
+		php_iconv_cd_cache_entry *entry = &iconv_globals->cd_cache[i];
+
+		if (entry->out_charset) {
+			iconv_close((iconv_t)entry->cd);
+			pefree(entry->out_charset, 1);
+			pefree(entry->in_charset, 1);
+			entry->out_charset = NULL;
+			entry->in_charset = NULL;
+		}
+	}
 }
 /* }}} */
 
@@ -434,6 +456,85 @@ static int _php_check_ignore(const char *charset)
 #endif
 /* }}} */
 
+/* {{{ php_iconv_open_cached() */
+static iconv_t php_iconv_open_cached(const char *out_charset, const char *in_charset)
+{
+	int i;
+
+	for (i = 0; i < PHP_ICONV_CD_CACHE_SIZE; i++) {
+		php_iconv_cd_cache_entry *entry = &ICONVG(cd_cache)[i];
+
+		if (entry->out_charset
+		 && !entry->in_use
+		 && strcmp(entry->out_charset, out_charset) == 0
+		 && strcmp(entry->in_charset, in_charset) == 0) {
+			entry->in_use = 1;
+			return (iconv_t)entry->cd;
+		}
+	}
+	return iconv_open(out_charset, in_charset);
+}
+/* }}} */
+
+/* {{{ php_iconv_close_cached()
+ * Returns a descriptor obtained from php_iconv_open_cached() to the cache,
+ * resetting its conversion state; descriptors that do not fit are closed */
+static void php_iconv_close_cached(iconv_t cd, const char *out_charset, const char *in_charset)
+{
+	unsigned int i, victim;
+
+	/* the caller inspects errno after the conversion; the reset must not
+	 * clobber it */
+	int save_errno = errno;
+
+	for (i = 0; i < PHP_ICONV_CD_CACHE_SIZE; i++) {
+		php_iconv_cd_cache_entry *entry = &ICONVG(cd_cache)[i];
+
+		if (entry->in_use && (iconv_t)entry->cd == cd) {
+			iconv(cd, NULL, NULL, NULL, NULL);
+			entry->in_use = 0;
+			errno = save_errno;
+			return;
+		}
+	}
+
+	if (strlen(out_charset) >= ICONV_CSNMAXLEN || strlen(in_charset) >= ICONV_CSNMAXLEN) {
+		iconv_close(cd);
+		errno = save_errno;
+		return;
+	}
+
+	/* insert the new descriptor, evicting an idle entry round-robin */
+	victim = PHP_ICONV_CD_CACHE_SIZE;
+	for (i = 0; i < PHP_ICONV_CD_CACHE_SIZE; i++) {
+		unsigned int n = (ICONVG(cd_cache_next) + i) % PHP_ICONV_CD_CACHE_SIZE;
+
+		if (!ICONVG(cd_cache)[n].in_use) {
+			victim = n;
+			break;
+		}
+	}
+	if (victim == PHP_ICONV_CD_CACHE_SIZE) {
+		iconv_close(cd);
+		errno = save_errno;
+		return;
+	}
+	ICONVG(cd_cache_next) = (victim + 1) % PHP_ICONV_CD_CACHE_SIZE;
+
+	if (ICONVG(cd_cache)[victim].out_charset) {
+		iconv_close((iconv_t)ICONVG(cd_cache)[victim].cd);
+		pefree(ICONVG(cd_cache)[victim].out_charset, 1);
+		pefree(ICONVG(cd_cache)[victim].in_charset, 1);
+	}
+	iconv(cd, NULL, NULL, NULL, NULL);
+	ICONVG(cd_cache)[victim].out_charset = pestrdup(out_charset, 1);
+	ICONVG(cd_cache)[victim].in_charset = pestrdup(in_charset, 1);
+	ICONVG(cd_cache)[victim].cd = (void *)cd;
+	ICONVG(cd_cache)[victim].in_use = 0;
+	errno = save_errno;
+}
+/* }}} */
+
 /* {{{ php_iconv_string() */
 PHP_ICONV_API php_iconv_err_t php_iconv_string(const char *in_p, size_t in_len, zend_string **out, const char *out_charset, const char *in_charset)
 {
@@ -447,7 +548,7 @@ PHP_ICONV_API php_iconv_err_t php_iconv_string(const char *in_p, size_t in_len,
 
 	*out = NULL;
 
-	cd = iconv_open(out_charset, in_charset);
+	cd = php_iconv_open_cached(out_charset, in_charset);
 
 	if (cd == (iconv_t)(-1)) {
 		if (errno == EINVAL) {
@@ -514,7 +615,7 @@ PHP_ICONV_API php_iconv_err_t php_iconv_string(const char *in_p, size_t in_len,
 		}
 	}
 
-	iconv_close(cd);
+	php_iconv_close_cached(cd, out_charset, in_charset);
 
 	if (result == (size_t)(-1)) {
 		switch (errno) {
@@ -2195,33 +2296,136 @@ PHP_FUNCTION(iconv_mime_decode_headers)
 /* }}} */
 
 /* {{{ Returns str converted to the out_charset character set */
+/* {{{ _php_iconv_hash_recursive()
+ * Converts all string keys and values of the given hash, descending into
+ * nested arrays; elements that cannot be converted are dropped */
+static HashTable *_php_iconv_hash_recursive(HashTable *input, const char *out_charset, const char *in_charset)
+{
+	HashTable *output, *chash;
+	zend_long idx;
+	zend_string *key;
+	zval *entry, entry_tmp;
+	php_iconv_err_t err;
+
+	if (GC_IS_RECURSIVE(input)) {
+		GC_UNPROTECT_RECURSION(input);
+		php_error_docref(NULL, E_WARNING, "Cannot convert recursively referenced values");
+		return NULL;
+	}
+	GC_TRY_PROTECT_RECURSION(input);
+	output = zend_new_array(zend_hash_num_elements(input));
+	ZEND_HASH_FOREACH_KEY_VAL(input, idx, key, entry) {
+		if (key) {
+			zend_string *converted_key;
+
+			err = php_iconv_string(ZSTR_VAL(key), ZSTR_LEN(key), &converted_key, out_charset, in_charset);
+			_php_iconv_show_error(err, out_charset, in_charset);
+			if (err != PHP_ICONV_ERR_SUCCESS || converted_key == NULL) {
+				if (converted_key) {
+					zend_string_efree(converted_key);
+				}
+				continue;
+			}
+			key = converted_key;
+		}
+		ZEND_ASSERT(entry);
+try_again:
+		switch (Z_TYPE_P(entry)) {
+			case IS_STRING: {
+				zend_string *converted;
+
+				err = php_iconv_string(Z_STRVAL_P(entry), Z_STRLEN_P(entry), &converted, out_charset, in_charset);
+				_php_iconv_show_error(err, out_charset, in_charset);
+				if (err != PHP_ICONV_ERR_SUCCESS || converted == NULL) {
+					if (converted) {
+						zend_string_efree(converted);
+					}
+					if (key) {
+						zend_string_release(key);
+					}
+					continue;
+				}
+				ZVAL_STR(&entry_tmp, converted);
+				break;
+			}
+			case IS_NULL:
+			case IS_TRUE:
+			case IS_FALSE:
+			case IS_LONG:
+			case IS_DOUBLE:
+				ZVAL_COPY(&entry_tmp, entry);
+				break;
+			case IS_ARRAY:
+				chash = _php_iconv_hash_recursive(Z_ARRVAL_P(entry), out_charset, in_charset);
+				if (chash) {
+					ZVAL_ARR(&entry_tmp, chash);
+				} else {
+					ZVAL_EMPTY_ARRAY(&entry_tmp);
+				}
+				break;
+			case IS_REFERENCE:
+				entry = Z_REFVAL_P(entry);
+				goto try_again;
+			case IS_OBJECT:
+			default:
+				if (key) {
+					zend_string_release(key);
+				}
+				php_error_docref(NULL, E_WARNING, "Object is not supported");
+				continue;
+		}
+		if (key) {
+			zend_hash_add(output, key, &entry_tmp);
+			zend_string_release(key);
+		} else {
+			zend_hash_index_add(output, idx, &entry_tmp);
+		}
+	} ZEND_HASH_FOREACH_END();
+	GC_TRY_UNPROTECT_RECURSION(input);
+
+	return output;
+}
+/* }}} */
+
 PHP_FUNCTION(iconv)
 {
 	char *in_charset, *out_charset;
 	zend_string *in_buffer;
+	HashTable *in_hash;
 	size_t in_charset_len = 0, out_charset_len = 0;
 	php_iconv_err_t err;
 	zend_string *out_buffer;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ssS",
-		&in_charset, &in_charset_len, &out_charset, &out_charset_len, &in_buffer) == FAILURE) {
-		RETURN_THROWS();
-	}
+	ZEND_PARSE_PARAMETERS_START(3, 3)
+		Z_PARAM_STRING(in_charset, in_charset_len)
+		Z_PARAM_STRING(out_charset, out_charset_len)
+		Z_PARAM_ARRAY_HT_OR_STR(in_hash, in_buffer)
+	ZEND_PARSE_PARAMETERS_END();
 
 	if (in_charset_len >= ICONV_CSNMAXLEN || out_charset_len >= ICONV_CSNMAXLEN) {
 		php_error_docref(NULL, E_WARNING, "Encoding parameter exceeds the maximum allowed length of %d characters", ICONV_CSNMAXLEN);
 		RETURN_FALSE;
 	}
 
-	err = php_iconv_string(ZSTR_VAL(in_buffer), (size_t)ZSTR_LEN(in_buffer), &out_buffer, out_charset, in_charset);
-	_php_iconv_show_error(err, out_charset, in_charset);
-	if (err == PHP_ICONV_ERR_SUCCESS && out_buffer != NULL) {
-		RETVAL_NEW_STR(out_buffer);
+	if (in_buffer) {
+		err = php_iconv_string(ZSTR_VAL(in_buffer), (size_t)ZSTR_LEN(in_buffer), &out_buffer, out_charset, in_charset);
+		_php_iconv_show_error(err, out_charset, in_charset);
+		if (err == PHP_ICONV_ERR_SUCCESS && out_buffer != NULL) {
+			RETVAL_NEW_STR(out_buffer);
+		} else {
+			if (out_buffer != NULL) {
+				zend_string_efree(out_buffer);
+			}
+			RETURN_FALSE;
+		}
 	} else {
-		if (out_buffer != NULL) {
-			zend_string_efree(out_buffer);
+		HashTable *out_hash = _php_iconv_hash_recursive(in_hash, out_charset, in_charset);
+
+		if (out_hash) {
+			RETVAL_ARR(out_hash);
+		} else {
+			RETURN_FALSE;
 		}
-		RETURN_FALSE;
 	}
 }
 /* }}} */
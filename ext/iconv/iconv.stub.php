@@ -45,7 +45,7 @@ function iconv_mime_decode(string $string, int $mode = 0, ?string $encoding = nu
 function iconv_mime_decode_headers(string $headers, int $mode = 0, ?string $encoding = null): array|false {}
 
 /** @refcount 1 */
-function iconv(string $from_encoding, string $to_encoding, string $string): string|false {}
+function iconv(string $from_encoding, string $to_encoding, array|string $string): array|string|false {}
 
 function iconv_set_encoding(string $type, string $encoding): bool {}
 
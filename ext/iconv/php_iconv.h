@@ -41,10 +41,24 @@ PHP_MINIT_FUNCTION(miconv);
 PHP_MSHUTDOWN_FUNCTION(miconv);
 PHP_MINFO_FUNCTION(miconv);
 
+/* Opening a conversion descriptor is much more expensive than converting a
+ * small string, so descriptors used by php_iconv_string() are kept open and
+ * reused for subsequent conversions between the same pair of charsets */
+#define PHP_ICONV_CD_CACHE_SIZE 4
+
+typedef struct _php_iconv_cd_cache_entry {
+	char *out_charset;
+	char *in_charset;
+	void *cd;         /* iconv_t */
+	bool  in_use;
+} php_iconv_cd_cache_entry;
+
 ZEND_BEGIN_MODULE_GLOBALS(iconv)
 	char *input_encoding;
 	char *internal_encoding;
 	char *output_encoding;
+	php_iconv_cd_cache_entry cd_cache[PHP_ICONV_CD_CACHE_SIZE];
+	unsigned int cd_cache_next;
 ZEND_END_MODULE_GLOBALS(iconv)
 
 #define ICONVG(v) ZEND_MODULE_GLOBALS_ACCESSOR(iconv, v)
@@ -0,0 +1,57 @@
+--TEST--
+Test iconv() function : converting arrays of strings
+--EXTENSIONS--
+iconv
+--FILE--
+<?php
+/*
+ * Test iconv() with an array argument: keys and values are converted,
+ * nested arrays are descended into and non-string scalars are kept
+ */
+
+$input = [
+    'caf' . chr(0xE9) => 'r' . chr(0xE9) . 'sum' . chr(0xE9),
+    'plain' => 'ascii only',
+    'nested' => [
+        chr(0xE0) . ' la carte',
+        'count' => 3,
+        'ratio' => 1.5,
+        'flag' => true,
+        'none' => null,
+    ],
+];
+
+var_dump(iconv('ISO-8859-1', 'UTF-8', $input));
+
+/* repeated conversions between the same pair reuse the cached descriptor */
+$out = [];
+for ($i = 0; $i < 10; $i++) {
+    $out[] = iconv('UTF-8', 'ISO-8859-1', "caf\u{e9} $i");
+}
+var_dump(bin2hex(end($out)));
+
+var_dump(iconv('ISO-8859-1', 'UTF-8', []));
+?>
+--EXPECT--
+array(3) {
+  ["café"]=>
+  string(8) "résumé"
+  ["plain"]=>
+  string(10) "ascii only"
+  ["nested"]=>
+  array(5) {
+    [0]=>
+    string(11) "à la carte"
+    ["count"]=>
+    int(3)
+    ["ratio"]=>
+    float(1.5)
+    ["flag"]=>
+    bool(true)
+    ["none"]=>
+    NULL
+  }
+}
+string(12) "636166e92039"
+array(0) {
+}
@@ -33,6 +33,7 @@ static inline NumberFormatter_object *php_intl_number_format_fetch_object(zend_o
 #define Z_INTL_NUMBERFORMATTER_P(zv) php_intl_number_format_fetch_object(Z_OBJ_P(zv))
 
 void formatter_register_class( void );
+void numfmt_cache_entry_dtor( zval *zv );
 extern zend_class_entry *NumberFormatter_ce_ptr;
 
 /* Auxiliary macros */
@@ -23,6 +23,75 @@
 #include "formatter_class.h"
 #include "intl_convert.h"
 
+/* Opening a number formatter makes ICU reload locale resource bundles and
+ * parse the pattern every time, which dominates construction cost for
+ * workloads creating many formatters with identical parameters.  The first
+ * formatter opened for each (style, locale, pattern) is kept pristine in a
+ * process-lifetime cache and further requests get unum_clone()d copies, so
+ * every object still owns a private handle and attribute mutation never
+ * leaks into the cached original. */
+#define NUMFMT_CACHE_MAX_ENTRIES 32
+
+/* {{{ */
+void numfmt_cache_entry_dtor( zval *zv )
+{
+	unum_close( (UNumberFormat *)Z_PTR_P( zv ) );
+}
+/* }}} */
+
+/* {{{ */
+static zend_string *numfmt_cache_key( zend_long style, const char *locale, const UChar *spattern, int32_t spattern_len )
+{
+	size_t       locale_len = strlen( locale );
+	zend_string *key = zend_string_alloc( sizeof(zend_long) + locale_len + 1 + (size_t)spattern_len * sizeof(UChar), 1 );
+	char        *p = ZSTR_VAL( key );
+
+	memcpy( p, &style, sizeof(zend_long) );
+	p += sizeof(zend_long);
+	memcpy( p, locale, locale_len );
+	p[locale_len] = '\0';
+	p += locale_len + 1;
+	if( spattern_len > 0 ) {
+		memcpy( p, spattern, (size_t)spattern_len * sizeof(UChar) );
+	}
+	ZSTR_VAL( key )[ZSTR_LEN( key )] = '\0';
+	return key;
+}
+/* }}} */
+
+/* {{{ */
+static UNumberFormat *numfmt_cache_open( zend_long style, const UChar *spattern, int32_t spattern_len, const char *locale, UErrorCode *status )
+{
+	zend_string   *key = numfmt_cache_key( style, locale, spattern, spattern_len );
+	UNumberFormat *cached = zend_hash_find_ptr( &INTL_G(numfmt_cache), key );
+	UNumberFormat *ufmt;
+
+	if( cached ) {
+		ufmt = unum_clone( cached, status );
+		if( U_SUCCESS( *status ) ) {
+			zend_string_release_ex( key, 1 );
+			return ufmt;
+		}
+		*status = U_ZERO_ERROR;
+	}
+
+	ufmt = unum_open( style, spattern, spattern_len, locale, NULL, status );
+
+	if( ufmt && U_SUCCESS( *status ) &&
+		zend_hash_num_elements( &INTL_G(numfmt_cache) ) < NUMFMT_CACHE_MAX_ENTRIES )
+	{
+		UErrorCode clone_status = U_ZERO_ERROR;
+
+		cached = unum_clone( ufmt, &clone_status );
+		if( cached && U_SUCCESS( clone_status ) ) {
+			zend_hash_add_new_ptr( &INTL_G(numfmt_cache), key, cached );
+		}
+	}
+	zend_string_release_ex( key, 1 );
+	return ufmt;
+}
+/* }}} */
+
 /* {{{ */
 static int numfmt_ctor(INTERNAL_FUNCTION_PARAMETERS, zend_error_handling *error_handling, bool *error_handling_replaced)
 {
@@ -69,8 +138,9 @@ static int numfmt_ctor(INTERNAL_FUNCTION_PARAMETERS, zend_error_handling *error_
 		return FAILURE;
 	}
     
-	/* Create an ICU number formatter. */
-	FORMATTER_OBJECT(nfo) = unum_open(style, spattern, spattern_len, locale, NULL, &INTL_DATA_ERROR_CODE(nfo));
+	/* Create an ICU number formatter, reusing a cached pristine one if
+	 * the same parameters were already seen in this process. */
+	FORMATTER_OBJECT(nfo) = numfmt_cache_open(style, spattern, spattern_len, locale, &INTL_DATA_ERROR_CODE(nfo));
 
 	if(spattern) {
 		efree(spattern);
@@ -103,6 +103,7 @@ PHP_INI_END()
 /* }}} */
 
 static PHP_GINIT_FUNCTION(intl);
+static PHP_GSHUTDOWN_FUNCTION(intl);
 
 /* {{{ intl_module_entry */
 zend_module_entry intl_module_entry = {
@@ -117,7 +118,7 @@ zend_module_entry intl_module_entry = {
 	PHP_INTL_VERSION,
 	PHP_MODULE_GLOBALS(intl),   /* globals descriptor */
 	PHP_GINIT(intl),            /* globals ctor */
-	NULL,                       /* globals dtor */
+	PHP_GSHUTDOWN(intl),        /* globals dtor */
 	NULL,                       /* post deactivate */
 	STANDARD_MODULE_PROPERTIES_EX
 };
@@ -137,6 +138,14 @@ static PHP_GINIT_FUNCTION(intl)
 	ZEND_TSRMLS_CACHE_UPDATE();
 #endif
 	memset( intl_globals, 0, sizeof(zend_intl_globals) );
+	zend_hash_init( &intl_globals->numfmt_cache, 8, NULL, numfmt_cache_entry_dtor, 1 );
+}
+/* }}} */
+
+/* {{{ intl_globals_dtor */
+static PHP_GSHUTDOWN_FUNCTION(intl)
+{
+	zend_hash_destroy( &intl_globals->numfmt_cache );
 }
 /* }}} */
 
@@ -51,6 +51,9 @@ ZEND_BEGIN_MODULE_GLOBALS(intl)
 	intl_error g_error;
 	zend_long error_level;
 	bool use_exceptions;
+	/* process-lifetime cache of pristine UNumberFormat handles, shared with
+	 * new NumberFormatter objects via unum_clone(); see formatter_main.c */
+	HashTable numfmt_cache;
 ZEND_END_MODULE_GLOBALS(intl)
 
 #if defined(ZTS) && defined(COMPILE_DL_INTL)
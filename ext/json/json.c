@@ -21,6 +21,7 @@
 
 #include "php.h"
 #include "php_ini.h"
+#include "php_streams.h"
 #include "ext/standard/info.h"
 #include "ext/standard/html.h"
 #include "zend_smart_str.h"
@@ -218,6 +219,87 @@ PHP_JSON_API bool php_json_validate_ex(const char *str, size_t str_len, zend_lon
 }
 /* }}} */
 
+PHP_JSON_API void php_json_incr_parser_init(php_json_incr_parser *parser) /* {{{ */
+{
+	memset(parser, 0, sizeof(*parser));
+}
+/* }}} */
+
+PHP_JSON_API void php_json_incr_parser_feed(php_json_incr_parser *parser, const char *chunk, size_t len) /* {{{ */
+{
+	size_t i;
+
+	smart_str_appendl(&parser->buf, chunk, len);
+
+	/* Framing only: strings (with escapes) must be skipped so that brackets
+	 * inside them do not count, everything else is left to the real parser
+	 * on finish. */
+	for (i = 0; i < len; i++) {
+		char c = chunk[i];
+
+		if (parser->in_string) {
+			if (parser->escaped) {
+				parser->escaped = false;
+			} else if (c == '\\') {
+				parser->escaped = true;
+			} else if (c == '"') {
+				parser->in_string = false;
+			}
+			continue;
+		}
+
+		switch (c) {
+			case '"':
+				parser->in_string = true;
+				parser->started = true;
+				break;
+			case '{':
+			case '[':
+				parser->depth++;
+				parser->started = true;
+				break;
+			case '}':
+			case ']':
+				if (parser->depth && --parser->depth == 0) {
+					parser->ready = true;
+				}
+				break;
+			case ' ':
+			case '\t':
+			case '\n':
+			case '\r':
+				break;
+			default:
+				parser->started = true;
+				break;
+		}
+	}
+}
+/* }}} */
+
+PHP_JSON_API bool php_json_incr_parser_ready(const php_json_incr_parser *parser) /* {{{ */
+{
+	return parser->ready;
+}
+/* }}} */
+
+PHP_JSON_API zend_result php_json_incr_parser_finish(php_json_incr_parser *parser, zval *return_value, zend_long options, zend_long depth) /* {{{ */
+{
+	if (!parser->buf.s) {
+		JSON_G(error_code) = PHP_JSON_ERROR_SYNTAX;
+		ZVAL_NULL(return_value);
+		return FAILURE;
+	}
+	return php_json_decode_ex(return_value, ZSTR_VAL(parser->buf.s), ZSTR_LEN(parser->buf.s), options, depth);
+}
+/* }}} */
+
+PHP_JSON_API void php_json_incr_parser_destroy(php_json_incr_parser *parser) /* {{{ */
+{
+	smart_str_free(&parser->buf);
+}
+/* }}} */
+
 /* {{{ Returns the JSON representation of a value */
 PHP_FUNCTION(json_encode)
 {
@@ -310,6 +392,161 @@ PHP_FUNCTION(json_decode)
 }
 /* }}} */
 
+/* Read block size for json_decode_lines(). Reading large blocks amortizes
+ * the stream layer cost over many records; newlines inside a block are
+ * found with memchr(), which the libc vectorizes. */
+#define PHP_JSON_LINES_BLOCK_SIZE (64 * 1024)
+
+static zend_result php_json_decode_lines_record(
+		zval *return_value, const char *p, size_t len, zend_long options, zend_long depth,
+		zend_fcall_info *fci, zend_fcall_info_cache *fcc, zend_long *count)
+{
+	zval record;
+
+	/* tolerate CRLF line endings and empty lines */
+	if (len && p[len - 1] == '\r') {
+		len--;
+	}
+	if (!len) {
+		return SUCCESS;
+	}
+
+	if (php_json_decode_ex(&record, p, len, options, depth) == FAILURE
+	 && !(options & PHP_JSON_PARTIAL_OUTPUT_ON_ERROR)) {
+		zval_ptr_dtor(&record);
+		return FAILURE;
+	}
+
+	if (ZEND_FCI_INITIALIZED(*fci)) {
+		zval retval;
+
+		fci->params = &record;
+		fci->param_count = 1;
+		fci->retval = &retval;
+		if (zend_call_function(fci, fcc) == SUCCESS) {
+			zval_ptr_dtor(&retval);
+		}
+		zval_ptr_dtor(&record);
+		if (UNEXPECTED(EG(exception))) {
+			return FAILURE;
+		}
+	} else {
+		add_next_index_zval(return_value, &record);
+	}
+	(*count)++;
+
+	return SUCCESS;
+}
+
+/* {{{ Decodes a stream of newline-delimited JSON records */
+PHP_FUNCTION(json_decode_lines)
+{
+	zval *zstream;
+	php_stream *stream;
+	zend_fcall_info fci = empty_fcall_info;
+	zend_fcall_info_cache fcc = empty_fcall_info_cache;
+	bool assoc = 0;
+	bool assoc_null = 1;
+	zend_long depth = PHP_JSON_PARSER_DEFAULT_DEPTH;
+	zend_long options = 0;
+	zend_long count = 0;
+	smart_str carry = {0};
+	char *block;
+	ssize_t r;
+
+	ZEND_PARSE_PARAMETERS_START(1, 5)
+		Z_PARAM_RESOURCE(zstream)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_FUNC_OR_NULL(fci, fcc)
+		Z_PARAM_BOOL_OR_NULL(assoc, assoc_null)
+		Z_PARAM_LONG(depth)
+		Z_PARAM_LONG(options)
+	ZEND_PARSE_PARAMETERS_END();
+
+	php_stream_from_zval(stream, zstream);
+
+	if (!(options & PHP_JSON_THROW_ON_ERROR)) {
+		JSON_G(error_code) = PHP_JSON_ERROR_NONE;
+	}
+
+	if (depth <= 0) {
+		zend_argument_value_error(4, "must be greater than 0");
+		RETURN_THROWS();
+	}
+
+	if (depth > INT_MAX) {
+		zend_argument_value_error(4, "must be less than %d", INT_MAX);
+		RETURN_THROWS();
+	}
+
+	/* For BC reasons, the bool $assoc overrides the long $options bit for PHP_JSON_OBJECT_AS_ARRAY */
+	if (!assoc_null) {
+		if (assoc) {
+			options |=  PHP_JSON_OBJECT_AS_ARRAY;
+		} else {
+			options &= ~PHP_JSON_OBJECT_AS_ARRAY;
+		}
+	}
+
+	if (!ZEND_FCI_INITIALIZED(fci)) {
+		array_init(return_value);
+	}
+
+	block = emalloc(PHP_JSON_LINES_BLOCK_SIZE);
+	while ((r = php_stream_read(stream, block, PHP_JSON_LINES_BLOCK_SIZE)) > 0) {
+		const char *p = block;
+		const char *end = block + r;
+		const char *nl;
+
+		while (p < end && (nl = memchr(p, '\n', end - p)) != NULL) {
+			const char *line = p;
+			size_t line_len = nl - p;
+
+			if (smart_str_get_len(&carry)) {
+				/* record continued from the previous block */
+				smart_str_appendl(&carry, p, line_len);
+				line = ZSTR_VAL(carry.s);
+				line_len = ZSTR_LEN(carry.s);
+			}
+			if (php_json_decode_lines_record(return_value, line, line_len,
+					options, depth, &fci, &fcc, &count) == FAILURE) {
+				goto failure;
+			}
+			smart_str_free(&carry);
+			p = nl + 1;
+		}
+		if (p < end) {
+			smart_str_appendl(&carry, p, end - p);
+		}
+	}
+
+	/* the last record does not need a trailing newline */
+	if (smart_str_get_len(&carry)
+	 && php_json_decode_lines_record(return_value, ZSTR_VAL(carry.s), ZSTR_LEN(carry.s),
+			options, depth, &fci, &fcc, &count) == FAILURE) {
+		goto failure;
+	}
+
+	smart_str_free(&carry);
+	efree(block);
+	if (ZEND_FCI_INITIALIZED(fci)) {
+		RETURN_LONG(count);
+	}
+	return;
+
+failure:
+	smart_str_free(&carry);
+	efree(block);
+	if (!ZEND_FCI_INITIALIZED(fci)) {
+		zval_ptr_dtor(return_value);
+	}
+	if (EG(exception)) {
+		RETURN_THROWS();
+	}
+	RETURN_NULL();
+}
+/* }}} */
+
 /* {{{ Validates if a string contains a valid json */
 PHP_FUNCTION(json_validate)
 {
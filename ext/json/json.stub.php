@@ -156,6 +156,12 @@ function json_encode(mixed $value, int $flags = 0, int $depth = 512): string|fal
 
 function json_decode(string $json, ?bool $associative = null, int $depth = 512, int $flags = 0): mixed {}
 
+/**
+ * @param resource $stream
+ * @refcount 1
+ */
+function json_decode_lines($stream, ?callable $callback = null, ?bool $associative = null, int $depth = 512, int $flags = 0): array|int|null {}
+
 function json_validate(string $json, int $depth = 512, int $flags = 0): bool {}
 
 function json_last_error(): int {}
@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 0ceb50047401c4b9e878c09cc518eacc274f7fff */
+ * Stub hash: 0c04c22b2599999af01a5fdb208c71ba0ab7eacf */
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_json_encode, 0, 1, MAY_BE_STRING|MAY_BE_FALSE)
 	ZEND_ARG_TYPE_INFO(0, value, IS_MIXED, 0)
@@ -14,6 +14,14 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_json_decode, 0, 1, IS_MIXED, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, flags, IS_LONG, 0, "0")
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_json_decode_lines, 0, 1, MAY_BE_ARRAY|MAY_BE_LONG|MAY_BE_NULL)
+	ZEND_ARG_INFO(0, stream)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, callback, IS_CALLABLE, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, associative, _IS_BOOL, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, depth, IS_LONG, 0, "512")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, flags, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_json_validate, 0, 1, _IS_BOOL, 0)
 	ZEND_ARG_TYPE_INFO(0, json, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, depth, IS_LONG, 0, "512")
@@ -31,6 +39,7 @@ ZEND_END_ARG_INFO()
 
 ZEND_FUNCTION(json_encode);
 ZEND_FUNCTION(json_decode);
+ZEND_FUNCTION(json_decode_lines);
 ZEND_FUNCTION(json_validate);
 ZEND_FUNCTION(json_last_error);
 ZEND_FUNCTION(json_last_error_msg);
@@ -38,6 +47,7 @@ ZEND_FUNCTION(json_last_error_msg);
 static const zend_function_entry ext_functions[] = {
 	ZEND_FE(json_encode, arginfo_json_encode)
 	ZEND_FE(json_decode, arginfo_json_decode)
+	ZEND_FE(json_decode_lines, arginfo_json_decode_lines)
 	ZEND_FE(json_validate, arginfo_json_validate)
 	ZEND_FE(json_last_error, arginfo_json_last_error)
 	ZEND_FE(json_last_error_msg, arginfo_json_last_error_msg)
@@ -28,6 +28,11 @@
 #include "php_json_encoder.h"
 #include <zend_exceptions.h>
 #include "zend_enum.h"
+#include "zend_bitset.h"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
 
 static const char digits[] = "0123456789abcdef";
 
@@ -357,6 +362,39 @@ zend_result php_json_escape_string(
 			0xffffffff, 0x500080c4, 0x10000000, 0x00000000,
 			0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
 
+#ifdef __SSE2__
+		/* Skip over runs of characters that never need escaping 16 bytes at
+		 * a time. The character classes here must match the charmap below:
+		 * control characters and non-ASCII bytes (both "less than 0x20" in a
+		 * signed comparison), plus the bytes that may be escaped depending on
+		 * the options. */
+		while (len >= sizeof(__m128i)) {
+			__m128i operand = _mm_loadu_si128((const __m128i *)(s + pos));
+			__m128i special = _mm_cmplt_epi8(operand, _mm_set1_epi8(0x20));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('"')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('\\')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('/')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('<')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('>')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('&')));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(operand, _mm_set1_epi8('\'')));
+
+			uint32_t mask = _mm_movemask_epi8(special);
+			if (mask) {
+				uint32_t n = zend_ulong_ntz(mask);
+				pos += n;
+				len -= n;
+				break;
+			}
+			pos += sizeof(__m128i);
+			len -= sizeof(__m128i);
+		}
+		if (UNEXPECTED(len == 0)) {
+			smart_str_appendl(buf, s, pos);
+			break;
+		}
+#endif
+
 		us = (unsigned char)s[pos];
 		if (EXPECTED(!ZEND_BIT_TEST(charmap, us))) {
 			pos++;
@@ -111,4 +111,26 @@ static inline zend_result php_json_decode(zval *return_value, const char *str, s
 	return php_json_decode_ex(return_value, str, str_len, assoc ? PHP_JSON_OBJECT_AS_ARRAY : 0, depth);
 }
 
+/* Incremental decoding front-end: JSON text can be fed in arbitrary chunks
+ * (e.g. as it arrives from a stream) without buffering it twice in the
+ * caller. Feeding tracks string/escape state and container nesting only;
+ * the buffered document is parsed once, on finish. For documents with an
+ * array or object root, php_json_incr_parser_ready() reports when the
+ * closing bracket has been seen, so the caller can stop reading; scalar
+ * roots are only validated by finish. */
+typedef struct _php_json_incr_parser {
+	smart_str buf;
+	uint32_t depth;      /* currently open containers */
+	bool in_string;
+	bool escaped;
+	bool started;        /* first significant byte seen */
+	bool ready;          /* a complete array/object root is buffered */
+} php_json_incr_parser;
+
+PHP_JSON_API void php_json_incr_parser_init(php_json_incr_parser *parser);
+PHP_JSON_API void php_json_incr_parser_feed(php_json_incr_parser *parser, const char *chunk, size_t len);
+PHP_JSON_API bool php_json_incr_parser_ready(const php_json_incr_parser *parser);
+PHP_JSON_API zend_result php_json_incr_parser_finish(php_json_incr_parser *parser, zval *return_value, zend_long options, zend_long depth);
+PHP_JSON_API void php_json_incr_parser_destroy(php_json_incr_parser *parser);
+
 #endif  /* PHP_JSON_H */
@@ -0,0 +1,72 @@
+--TEST--
+json_decode_lines() decodes newline-delimited JSON streams
+--FILE--
+<?php
+
+function make_stream(string $data) {
+    $fp = fopen('php://memory', 'r+');
+    fwrite($fp, $data);
+    rewind($fp);
+    return $fp;
+}
+
+/* array mode, CRLF and empty lines tolerated, last line without newline */
+$fp = make_stream("{\"a\":1}\r\n\n[1,2]\n\"x\"");
+var_dump(json_decode_lines($fp, null, true));
+fclose($fp);
+
+/* callback mode returns the number of records */
+$fp = make_stream("1\n2\n3\n");
+$sum = 0;
+var_dump(json_decode_lines($fp, function ($v) use (&$sum) { $sum += $v; }));
+var_dump($sum);
+fclose($fp);
+
+/* a record spanning read-block boundaries is reassembled */
+$big = str_repeat('x', 100000);
+$fp = make_stream("\"$big\"\n42\n");
+$rows = json_decode_lines($fp);
+var_dump(count($rows), strlen($rows[0]), $rows[1]);
+fclose($fp);
+
+/* invalid record aborts with null and sets the error code */
+$fp = make_stream("1\n{bad\n2\n");
+var_dump(json_decode_lines($fp));
+var_dump(json_last_error() === JSON_ERROR_SYNTAX);
+fclose($fp);
+
+/* JSON_THROW_ON_ERROR throws instead */
+$fp = make_stream("{oops\n");
+try {
+    json_decode_lines($fp, null, null, 512, JSON_THROW_ON_ERROR);
+} catch (JsonException $e) {
+    echo get_class($e), ": ", $e->getMessage(), "\n";
+}
+fclose($fp);
+
+?>
+--EXPECT--
+array(3) {
+  [0]=>
+  array(1) {
+    ["a"]=>
+    int(1)
+  }
+  [1]=>
+  array(2) {
+    [0]=>
+    int(1)
+    [1]=>
+    int(2)
+  }
+  [2]=>
+  string(1) "x"
+}
+int(3)
+int(6)
+int(2)
+int(100000)
+int(42)
+NULL
+bool(true)
+JsonException: Syntax error
@@ -1823,7 +1823,13 @@ static size_t mb_get_strlen(zend_string *string, const mbfl_encoding *encoding)
 	unsigned int char_len = encoding->flag & (MBFL_ENCTYPE_SBCS | MBFL_ENCTYPE_WCS2 | MBFL_ENCTYPE_WCS4);
 	if (char_len) {
 		return ZSTR_LEN(string) / char_len;
-	} else if (php_mb_is_no_encoding_utf8(encoding->no_encoding) && ZSTR_IS_VALID_UTF8(string)) {
+	} else if (php_mb_is_no_encoding_utf8(encoding->no_encoding)
+			&& (ZSTR_IS_VALID_UTF8(string) || mb_check_str_encoding(string, &mbfl_encoding_utf8))) {
+		/* For valid UTF-8, two vectorized passes (validation, which also caches
+		 * the IS_STR_VALID_UTF8 flag, then continuation-byte counting) are much
+		 * faster than decoding to wchars; the decoder below is only needed for
+		 * strings with invalid byte sequences, where the error-substitution
+		 * behavior must be preserved */
 		return mb_fast_strlen_utf8((unsigned char*)ZSTR_VAL(string), ZSTR_LEN(string));
 	}
 
@@ -431,6 +431,8 @@ PHP_INI_BEGIN()
 	STD_PHP_INI_ENTRY_EX("mysqli.max_persistent",		"-1",	PHP_INI_SYSTEM,		OnUpdateLong,		max_persistent,		zend_mysqli_globals,		mysqli_globals,	display_link_numbers)
 	STD_PHP_INI_BOOLEAN("mysqli.allow_persistent",		"1",	PHP_INI_SYSTEM,		OnUpdateBool,		allow_persistent,	zend_mysqli_globals,		mysqli_globals)
 	STD_PHP_INI_BOOLEAN("mysqli.rollback_on_cached_plink",	"0",PHP_INI_SYSTEM,		OnUpdateBool,		rollback_on_cached_plink,	zend_mysqli_globals,		mysqli_globals)
+	STD_PHP_INI_ENTRY("mysqli.pconn_fresh_interval",	"0",	PHP_INI_SYSTEM,		OnUpdateLong,		pconn_fresh_interval,	zend_mysqli_globals,	mysqli_globals)
+	STD_PHP_INI_ENTRY("mysqli.pconn_idle_ttl",			"0",	PHP_INI_SYSTEM,		OnUpdateLong,		pconn_idle_ttl,		zend_mysqli_globals,		mysqli_globals)
 	STD_PHP_INI_ENTRY("mysqli.default_host",			NULL,	PHP_INI_ALL,		OnUpdateString,		default_host,		zend_mysqli_globals,		mysqli_globals)
 	STD_PHP_INI_ENTRY("mysqli.default_user",			NULL,	PHP_INI_ALL,		OnUpdateString,		default_user,		zend_mysqli_globals,		mysqli_globals)
 	STD_PHP_INI_ENTRY("mysqli.default_pw",				NULL,	PHP_INI_ALL,		OnUpdateString,		default_pw,			zend_mysqli_globals,		mysqli_globals)
@@ -466,6 +468,8 @@ static PHP_GINIT_FUNCTION(mysqli)
 	mysqli_globals->allow_local_infile = 0;
 	mysqli_globals->local_infile_directory = NULL;
 	mysqli_globals->rollback_on_cached_plink = false;
+	mysqli_globals->pconn_fresh_interval = 0;
+	mysqli_globals->pconn_idle_ttl = 0;
 }
 /* }}} */
 
@@ -263,7 +263,26 @@ void php_mysqli_close(MY_MYSQL * mysql, int close_type, int resource_status)
 					FAIL == mysqlnd_rollback(mysql->mysql, TRANS_COR_NO_OPT, NULL))
 				{
 					mysqli_close(mysql->mysql, close_type);
+#ifndef MYSQLI_NO_CHANGE_USER_ON_PCONNECT
+				/* If a freshness window is configured, pay for the session
+				 * reset round-trip now, at check-in, so that a checkout
+				 * within the window is a plain timestamp comparison with no
+				 * server round-trip. Links that cannot be reset here are
+				 * closed instead of being pooled in a dirty state. */
+				} else if (MyG(pconn_fresh_interval) > 0 &&
+					mysqlnd_get_server_version(mysql->mysql) >= 50703 &&
+					PASS != mysqlnd_reset_connection(mysql->mysql))
+				{
+					mysqli_close(mysql->mysql, close_type);
+#endif
 				} else {
+					if (MyG(pconn_fresh_interval) > 0
+#ifndef MYSQLI_NO_CHANGE_USER_ON_PCONNECT
+						&& mysqlnd_get_server_version(mysql->mysql) >= 50703
+#endif
+					) {
+						mysql->mysql->data->pooled_pristine = TRUE;
+					}
 					zend_ptr_stack_push(&plist->free_links, mysql->mysql);
 					MyG(num_inactive_persistent)++;
 				}
@@ -156,48 +156,81 @@ void mysqli_common_connect(INTERNAL_FUNCTION_PARAMETERS, bool is_real_connect, b
 				if (le->type == php_le_pmysqli()) {
 					plist = (mysqli_plist_entry *) le->ptr;
 
-					do {
-						if (zend_ptr_stack_num_elements(&plist->free_links)) {
-							/* If we have an initialized (but unconnected) mysql resource,
-							 * close it before we reuse an existing persistent resource. */
-							if (mysql->mysql) {
-								mysqli_close(mysql->mysql, MYSQLI_CLOSE_IMPLICIT);
-							}
+					while (zend_ptr_stack_num_elements(&plist->free_links)) {
+						/* If we have an initialized (but unconnected) mysql resource,
+						 * close it before we reuse an existing persistent resource. */
+						if (mysql->mysql) {
+							mysqli_close(mysql->mysql, MYSQLI_CLOSE_IMPLICIT);
+						}
+
+						mysql->mysql = zend_ptr_stack_pop(&plist->free_links);
 
-							mysql->mysql = zend_ptr_stack_pop(&plist->free_links);
+						MyG(num_inactive_persistent)--;
+
+						/* Prune links that sat idle past the configured TTL;
+						 * the server has likely dropped them anyway and
+						 * re-validating them is wasted work. */
+						if (MyG(pconn_idle_ttl) > 0 &&
+							time(NULL) - mysql->mysql->data->pooled_at > MyG(pconn_idle_ttl))
+						{
+							mysqli_close(mysql->mysql, MYSQLI_CLOSE_IMPLICIT);
+							mysql->mysql = NULL;
+							continue;
+						}
 
-							MyG(num_inactive_persistent)--;
-							/* reset variables */
+						/* A link whose session was already reset at check-in
+						 * and that has not been idle past the freshness
+						 * window is handed out without any server
+						 * round-trip: checkout is a timestamp comparison. */
+						if (mysql->mysql->data->pooled_pristine &&
+							time(NULL) - mysql->mysql->data->pooled_at < MyG(pconn_fresh_interval))
+						{
+							mysqlnd_restart_psession(mysql->mysql);
+							MyG(num_active_persistent)++;
+
+							/* clear error */
+							php_mysqli_set_error(mysql_errno(mysql->mysql), (char *) mysql_error(mysql->mysql));
+
+							goto end;
+						}
+						/* reset variables */
 
 #ifndef MYSQLI_NO_CHANGE_USER_ON_PCONNECT
-							if (!mysqli_change_user_silent(mysql->mysql, username, passwd, dbname, passwd_len)) {
+						/* The pooled link was opened with the same credentials
+						 * (they are part of the hash key), so a lightweight
+						 * COM_RESET_CONNECTION is enough to get a pristine
+						 * session; re-authenticating with COM_CHANGE_USER is
+						 * only the fallback for servers without it (pre 5.7.3). */
+						if ((mysqlnd_get_server_version(mysql->mysql) >= 50703 &&
+								PASS == mysqlnd_reset_connection(mysql->mysql)) ||
+							!mysqli_change_user_silent(mysql->mysql, username, passwd, dbname, passwd_len)) {
 #else
-							if (!mysql_ping(mysql->mysql)) {
+						if (!mysql_ping(mysql->mysql)) {
 #endif
-								mysqlnd_restart_psession(mysql->mysql);
-								MyG(num_active_persistent)++;
-
-								/* clear error */
-								php_mysqli_set_error(mysql_errno(mysql->mysql), (char *) mysql_error(mysql->mysql));
-
-								goto end;
-							} else {
-								if (mysql->mysql->data->vio->data->ssl) {
-									/* copy over pre-existing ssl settings so we can reuse them when reconnecting */
-									ssl = true;
-
-									ssl_key = mysql->mysql->data->vio->data->options.ssl_key ? estrdup(mysql->mysql->data->vio->data->options.ssl_key) : NULL;
-									ssl_cert = mysql->mysql->data->vio->data->options.ssl_cert ? estrdup(mysql->mysql->data->vio->data->options.ssl_cert) : NULL;
-									ssl_ca = mysql->mysql->data->vio->data->options.ssl_ca ? estrdup(mysql->mysql->data->vio->data->options.ssl_ca) : NULL;
-									ssl_capath = mysql->mysql->data->vio->data->options.ssl_capath ? estrdup(mysql->mysql->data->vio->data->options.ssl_capath) : NULL;
-									ssl_cipher = mysql->mysql->data->vio->data->options.ssl_cipher ? estrdup(mysql->mysql->data->vio->data->options.ssl_cipher) : NULL;
-								}
-
-								mysqli_close(mysql->mysql, MYSQLI_CLOSE_IMPLICIT);
-								mysql->mysql = NULL;
+							mysqlnd_restart_psession(mysql->mysql);
+							MyG(num_active_persistent)++;
+
+							/* clear error */
+							php_mysqli_set_error(mysql_errno(mysql->mysql), (char *) mysql_error(mysql->mysql));
+
+							goto end;
+						} else {
+							if (mysql->mysql->data->vio->data->ssl) {
+								/* copy over pre-existing ssl settings so we can reuse them when reconnecting */
+								ssl = true;
+
+								ssl_key = mysql->mysql->data->vio->data->options.ssl_key ? estrdup(mysql->mysql->data->vio->data->options.ssl_key) : NULL;
+								ssl_cert = mysql->mysql->data->vio->data->options.ssl_cert ? estrdup(mysql->mysql->data->vio->data->options.ssl_cert) : NULL;
+								ssl_ca = mysql->mysql->data->vio->data->options.ssl_ca ? estrdup(mysql->mysql->data->vio->data->options.ssl_ca) : NULL;
+								ssl_capath = mysql->mysql->data->vio->data->options.ssl_capath ? estrdup(mysql->mysql->data->vio->data->options.ssl_capath) : NULL;
+								ssl_cipher = mysql->mysql->data->vio->data->options.ssl_cipher ? estrdup(mysql->mysql->data->vio->data->options.ssl_cipher) : NULL;
 							}
+
+							mysqli_close(mysql->mysql, MYSQLI_CLOSE_IMPLICIT);
+							mysql->mysql = NULL;
+							break;
 						}
-					} while (0);
+					}
 				}
 			} else {
 				plist = calloc(1, sizeof(mysqli_plist_entry));
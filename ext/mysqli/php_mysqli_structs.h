@@ -253,6 +253,8 @@ ZEND_BEGIN_MODULE_GLOBALS(mysqli)
 	char				*error_msg;
 	zend_long			report_mode;
 	bool 				rollback_on_cached_plink;
+	zend_long			pconn_fresh_interval;
+	zend_long			pconn_idle_ttl;
 ZEND_END_MODULE_GLOBALS(mysqli)
 
 #define MyG(v) ZEND_MODULE_GLOBALS_ACCESSOR(mysqli, v)
@@ -385,6 +385,8 @@ MYSQLND_METHOD(mysqlnd_conn_data, end_psession)(MYSQLND_CONN_DATA * conn)
 	}
 	mysqlnd_set_string(&conn->last_message, NULL, 0);
 	conn->error_info = &conn->error_info_impl;
+	conn->pooled_at = time(NULL);
+	conn->pooled_pristine = FALSE;
 	DBG_VOID_RETURN;
 }
 /* }}} */
@@ -1377,6 +1379,31 @@ MYSQLND_METHOD(mysqlnd_conn_data, change_user)(MYSQLND_CONN_DATA * const conn,
 /* }}} */
 
 
+/* {{{ mysqlnd_conn_data::reset_connection */
+static enum_func_status
+MYSQLND_METHOD(mysqlnd_conn_data, reset_connection)(MYSQLND_CONN_DATA * const conn)
+{
+	enum_func_status ret;
+
+	DBG_ENTER("mysqlnd_conn_data::reset_connection");
+	DBG_INF_FMT("conn=%" PRIu64, conn->thread_id);
+
+	SET_EMPTY_ERROR(conn->error_info);
+	UPSERT_STATUS_SET_AFFECTED_ROWS_TO_ERROR(conn->upsert_status);
+
+	/*
+	  Resets the session state server side without re-authenticating, which
+	  makes it considerably cheaper than COM_CHANGE_USER. Prepared statements
+	  and temporary tables are dropped by the server like after change_user.
+	*/
+	ret = conn->command->reset_connection(conn);
+
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+/* }}} */
+
+
 /* {{{ mysqlnd_conn_data::set_client_option */
 static enum_func_status
 MYSQLND_METHOD(mysqlnd_conn_data, set_client_option)(MYSQLND_CONN_DATA * const conn,
@@ -2012,7 +2039,9 @@ MYSQLND_CLASS_METHODS_START(mysqlnd_conn_data)
 	MYSQLND_METHOD(mysqlnd_conn_data, negotiate_client_api_capabilities),
 	MYSQLND_METHOD(mysqlnd_conn_data, get_client_api_capabilities),
 
-	MYSQLND_METHOD(mysqlnd_conn_data, get_scheme)
+	MYSQLND_METHOD(mysqlnd_conn_data, get_scheme),
+
+	MYSQLND_METHOD(mysqlnd_conn_data, reset_connection)
 MYSQLND_CLASS_METHODS_END;
 
 
@@ -324,6 +324,7 @@ typedef enum_func_status (*func_mysqlnd_execute_com_stmt_send_long_data)(MYSQLND
 typedef enum_func_status (*func_mysqlnd_execute_com_stmt_close)(MYSQLND_CONN_DATA * const conn, const zend_ulong stmt_id);
 typedef enum_func_status (*func_mysqlnd_execute_com_enable_ssl)(MYSQLND_CONN_DATA * const conn, const size_t client_capabilities, const size_t server_capabilities, const unsigned int charset_no);
 typedef enum_func_status (*func_mysqlnd_execute_com_handshake)(MYSQLND_CONN_DATA * const conn, const MYSQLND_CSTRING username, const MYSQLND_CSTRING password, const MYSQLND_CSTRING database, const size_t client_flags);
+typedef enum_func_status (*func_mysqlnd_execute_com_reset_connection)(MYSQLND_CONN_DATA * const conn);
 
 
 MYSQLND_CLASS_METHODS_TYPE(mysqlnd_command)
@@ -347,6 +348,7 @@ MYSQLND_CLASS_METHODS_TYPE(mysqlnd_command)
 	func_mysqlnd_execute_com_stmt_close stmt_close;
 	func_mysqlnd_execute_com_enable_ssl enable_ssl;
 	func_mysqlnd_execute_com_handshake handshake;
+	func_mysqlnd_execute_com_reset_connection reset_connection;
 };
 
 
@@ -514,6 +516,7 @@ typedef size_t				(*func_mysqlnd_conn_data__negotiate_client_api_capabilities)(M
 typedef size_t				(*func_mysqlnd_conn_data__get_client_api_capabilities)(const MYSQLND_CONN_DATA * const conn);
 
 typedef MYSQLND_STRING		(*func_mysqlnd_conn_data__get_scheme)(MYSQLND_CONN_DATA * conn, MYSQLND_CSTRING hostname, MYSQLND_CSTRING *socket_or_pipe, unsigned int port, bool * unix_socket, bool * named_pipe);
+typedef enum_func_status	(*func_mysqlnd_conn_data__reset_connection)(MYSQLND_CONN_DATA * const conn);
 
 
 
@@ -601,6 +604,8 @@ MYSQLND_CLASS_METHODS_TYPE(mysqlnd_conn_data)
 	func_mysqlnd_conn_data__get_client_api_capabilities get_client_api_capabilities;
 
 	func_mysqlnd_conn_data__get_scheme get_scheme;
+
+	func_mysqlnd_conn_data__reset_connection reset_connection;
 };
 
 
@@ -953,6 +958,10 @@ struct st_mysqlnd_connection_data
 
 	/* persistent connection */
 	bool		persistent;
+	/* when the connection was last put back into a pool (end_psession) */
+	time_t		pooled_at;
+	/* session state was already reset when the connection was pooled */
+	bool		pooled_pristine;
 };
 
 
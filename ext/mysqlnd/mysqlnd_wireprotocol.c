@@ -1360,31 +1360,47 @@ php_mysqlnd_read_row_ex(MYSQLND_PFC * pfc,
 		SET_CONNECTION_STATE(connection_state, CONN_QUIT_SENT);
 		set_packet_error(error_info, CR_SERVER_GONE_ERROR, UNKNOWN_SQLSTATE, mysqlnd_server_gone);
 	} else {
-		/* If the packet is split in multiple chunks, allocate a temporary buffer that we can
-		 * reallocate, and only afterwards copy it to the pool when we know the final size. */
-		zend_uchar *buf = NULL;
+		/* If the packet is split in multiple chunks, receive every chunk into its own
+		 * temporary buffer and gather them into the pool chunk once the final size is
+		 * known. Growing a single temporary buffer with erealloc() instead would copy
+		 * all previously received chunks again on every 16MB boundary. */
+		struct {
+			zend_uchar *ptr;
+			size_t size;
+		} *chunks = NULL;
+		unsigned int chunk_count = 0, i;
 		while (header.size >= MYSQLND_MAX_PACKET_SIZE) {
-			buf = erealloc(buf, *data_size + header.size);
-			p = buf + *data_size;
+			chunks = safe_erealloc(chunks, chunk_count + 1, sizeof(*chunks), 0);
+			p = chunks[chunk_count].ptr = emalloc(header.size);
+			chunks[chunk_count].size = header.size;
+			chunk_count++;
 			*data_size += header.size;
 
 			if (UNEXPECTED(PASS != (ret = pfc->data->m.receive(pfc, vio, p, header.size, stats, error_info)))) {
 				DBG_ERR("Empty row packet body");
 				SET_CONNECTION_STATE(connection_state, CONN_QUIT_SENT);
 				set_packet_error(error_info, CR_SERVER_GONE_ERROR, UNKNOWN_SQLSTATE, mysqlnd_server_gone);
-				efree(buf);
-				DBG_RETURN(FAIL);
+				goto free_chunks;
 			}
 			if (FAIL == mysqlnd_read_header(pfc, vio, &header, stats, error_info)) {
-				efree(buf);
+free_chunks:
+				for (i = 0; i < chunk_count; i++) {
+					efree(chunks[i].ptr);
+				}
+				efree(chunks);
 				DBG_RETURN(FAIL);
 			}
 		}
 
 		buffer->ptr = pool->get_chunk(pool, *data_size + header.size + prealloc_more_bytes);
-		if (buf) {
-			memcpy(buffer->ptr, buf, *data_size);
-			efree(buf);
+		if (chunks) {
+			size_t copied = 0;
+			for (i = 0; i < chunk_count; i++) {
+				memcpy((zend_uchar *) buffer->ptr + copied, chunks[i].ptr, chunks[i].size);
+				copied += chunks[i].size;
+				efree(chunks[i].ptr);
+			}
+			efree(chunks);
 		}
 		p = (zend_uchar *) buffer->ptr + *data_size;
 		*data_size += header.size;
@@ -50,6 +50,12 @@
 #include "ext/standard/md5.h"
 #include "ext/hash/php_hash.h"
 
+#ifdef HAVE_DTRACE
+/* opcache may be loaded as a shared object, so it cannot participate in the
+ * core php provider object; plain SDT probes attach the same way. */
+# include <sys/sdt.h>
+#endif
+
 #ifdef HAVE_JIT
 # include "jit/zend_jit.h"
 #endif
@@ -89,6 +95,10 @@ typedef int gid_t;
 #include <sys/stat.h>
 #include <errno.h>
 
+#ifdef HAVE_SYS_INOTIFY_H
+# include <sys/inotify.h>
+#endif
+
 #ifdef __AVX__
 #include <immintrin.h>
 #endif
@@ -124,6 +134,7 @@ static zend_class_entry* (*accelerator_orig_inheritance_cache_get)(zend_class_en
 static zend_class_entry* (*accelerator_orig_inheritance_cache_add)(zend_class_entry *ce, zend_class_entry *proto, zend_class_entry *parent, zend_class_entry **traits_and_interfaces, HashTable *dependencies);
 static zend_result (*accelerator_orig_zend_stream_open_function)(zend_file_handle *handle );
 static zend_string *(*accelerator_orig_zend_resolve_path)(zend_string *filename);
+static zend_class_entry *(*accelerator_orig_zend_autoload)(zend_string *name, zend_string *lc_name);
 static zif_handler orig_chdir = NULL;
 static ZEND_INI_MH((*orig_include_path_on_modify)) = NULL;
 static zend_result (*orig_post_startup_cb)(void);
@@ -416,6 +427,10 @@ static inline void accel_unlock_all(void)
 #define STRTAB_NEXT(s) \
 	((zend_string*)((char*)(s) + STRTAB_STR_SIZE(s)))
 
+/* Shared memory kept untouched by interned string spilling, so that a full
+ * interned strings buffer can never cause an OOM restart by itself. */
+#define STRTAB_OVERFLOW_SHM_RESERVE (1024 * 1024)
+
 static void accel_interned_strings_restore_state(void)
 {
 	zend_string *s, *top;
@@ -455,6 +470,12 @@ static void accel_interned_strings_restore_state(void)
 		} while (s < top);
 	}
 	ZCSG(interned_strings).nNumOfElements = n;
+
+	/* Spilled strings live in the shared pool, which is restored together
+	 * with the string table on restart. */
+	ZCSG(interned_strings_overflow_count) = 0;
+	ZCSG(interned_strings_overflow_mem) = 0;
+	ZCSG(interned_strings_overflow_misses) = 0;
 }
 
 static void accel_interned_strings_save_state(void)
@@ -528,23 +549,53 @@ zend_string* ZEND_FASTCALL accel_new_interned_string(zend_string *str)
 	}
 
 	if (UNEXPECTED((char*)ZCSG(interned_strings).end - (char*)ZCSG(interned_strings).top < STRTAB_STR_SIZE(str))) {
-	    /* no memory, return the same non-interned string */
-		zend_accel_error(ACCEL_LOG_WARNING, "Interned string buffer overflow");
-		return str;
+		/* The dedicated buffer is full. Spill into the main shared memory
+		 * pool when it has room to spare, so the string stays shared across
+		 * all processes instead of being duplicated on every per-process
+		 * heap. Hash slots can reach pool memory because positions are plain
+		 * offsets from the table and every process maps the segments at the
+		 * same addresses. */
+		size_t spill_size = STRTAB_STR_SIZE(str) + ZEND_STRING_TABLE_POS_ALIGNMENT;
+		char *mem = NULL;
+		ptrdiff_t offset = 0;
+
+		if (zend_shared_alloc_get_free_memory() > spill_size + STRTAB_OVERFLOW_SHM_RESERVE) {
+			mem = zend_shared_alloc(spill_size);
+		}
+		if (mem) {
+			/* keep the collision slot preceding the string, as in the buffer */
+			s = (zend_string*)(mem + ZEND_STRING_TABLE_POS_ALIGNMENT);
+			offset = (char*)s - (char*)&ZCSG(interned_strings);
+		}
+		if (!mem
+		 || UNEXPECTED(offset <= 0)
+		 || UNEXPECTED((size_t)offset / ZEND_STRING_TABLE_POS_ALIGNMENT > (size_t)ZEND_STRING_TABLE_POS_MAX)) {
+			/* no memory, return the same non-interned string */
+			zend_accel_error(ACCEL_LOG_WARNING, "Interned string buffer overflow");
+			ZCSG(interned_strings_overflow_misses)++;
+			return str;
+		}
+		ZCSG(interned_strings_overflow_count)++;
+		ZCSG(interned_strings_overflow_mem) += spill_size;
+	} else {
+		/* create new interning string in shared interned strings buffer */
+		s = ZCSG(interned_strings).top;
+		ZCSG(interned_strings).top = (zend_string*)((char*)s + STRTAB_STR_SIZE(str));
 	}
 
-	/* create new interning string in shared interned strings buffer */
 	ZCSG(interned_strings).nNumOfElements++;
-	s = ZCSG(interned_strings).top;
 	hash_slot = STRTAB_HASH_TO_SLOT(&ZCSG(interned_strings), h);
 	STRTAB_COLLISION(s) = *hash_slot;
-	*hash_slot = STRTAB_STR_TO_POS(&ZCSG(interned_strings), s);
 	GC_SET_REFCOUNT(s, 2);
 	GC_TYPE_INFO(s) = GC_STRING | ((IS_STR_INTERNED | IS_STR_PERMANENT) << GC_FLAGS_SHIFT)| (ZSTR_IS_VALID_UTF8(str) ? IS_STR_VALID_UTF8 : 0);
 	ZSTR_H(s) = h;
 	ZSTR_LEN(s) = ZSTR_LEN(str);
 	memcpy(ZSTR_VAL(s), ZSTR_VAL(str), ZSTR_LEN(s) + 1);
-	ZCSG(interned_strings).top = STRTAB_NEXT(s);
+	/* Readers in other processes walk the table without taking the
+	 * allocator lock, so only link the fully initialized string into
+	 * the hash slot, and fence so the payload is visible first. */
+	zend_atomic_thread_fence_release();
+	*hash_slot = STRTAB_STR_TO_POS(&ZCSG(interned_strings), s);
 
 finish:
 	/* Transfer CE_CACHE map ptr slot to new interned string.
@@ -1437,6 +1488,155 @@ zend_result zend_accel_invalidate(zend_string *filename, bool force)
 	return file_found ? SUCCESS : FAILURE;
 }
 
+/* Discard every cached script in place instead of restarting.  Workers then
+ * recompile scripts lazily as they are requested, so a deploy does not
+ * stampede the way a full SHM wipe does, and code currently executing from
+ * the old copies keeps running until the request finishes.  The discarded
+ * copies are accounted as wasted memory and reclaimed by the regular
+ * out-of-memory restart once the cache fills up again. */
+void zend_accel_invalidate_all(void)
+{
+	uint32_t i;
+
+	if (!ZCG(accelerator_enabled)) {
+		return;
+	}
+
+	HANDLE_BLOCK_INTERRUPTIONS();
+	SHM_UNPROTECT();
+	zend_shared_alloc_lock();
+
+	for (i = 0; i < ZCSG(hash).num_entries; i++) {
+		zend_accel_hash_entry *entry = &ZCSG(hash).hash_entries[i];
+
+		if (!entry->indirect) {
+			zend_accel_discard_script((zend_persistent_script *)entry->data);
+		}
+	}
+
+	zend_shared_alloc_unlock();
+	SHM_PROTECT();
+	HANDLE_UNBLOCK_INTERRUPTIONS();
+}
+
+#ifdef HAVE_SYS_INOTIFY_H
+/* inotify-based invalidation (opcache.file_watcher).  Each worker watches the
+ * directories of the scripts it has loaded and drains its event queue once
+ * per request, so with validate_timestamps=0 stale scripts are still
+ * discarded - the request-path cost is a single non-blocking read() of the
+ * inotify descriptor instead of one stat() per cached file.  Events that
+ * can't be attributed to individual scripts (queue overflow, a watched
+ * directory being moved or deleted, as atomic deploys do) fall back to
+ * zend_accel_invalidate_all(). */
+
+#define ACCEL_WATCHER_EVENT_MASK \
+	(IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | \
+	 IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+static void zend_accel_watcher_wd_dtor(zval *zv)
+{
+	zend_string_release_ex((zend_string*)Z_PTR_P(zv), 1);
+}
+
+void zend_accel_watcher_track(zend_string *filename)
+{
+	const char *slash;
+	char dir[MAXPATHLEN];
+	size_t dir_len;
+	zend_string *dir_str;
+	int wd;
+
+	if (ZSTR_VAL(filename)[0] != '/') {
+		/* relative paths and streams (phar://, ...) can't be watched */
+		return;
+	}
+
+	if (ZCG(watcher_fd) < 0) {
+		ZCG(watcher_fd) = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (ZCG(watcher_fd) < 0) {
+			zend_accel_error(ACCEL_LOG_WARNING, "Cannot create inotify instance: %s", strerror(errno));
+			return;
+		}
+		zend_hash_init(&ZCG(watcher_dirs), 64, NULL, NULL, 1);
+		zend_hash_init(&ZCG(watcher_wds), 64, NULL, zend_accel_watcher_wd_dtor, 1);
+	}
+
+	slash = strrchr(ZSTR_VAL(filename), '/');
+	dir_len = (slash == ZSTR_VAL(filename)) ? 1 : (size_t)(slash - ZSTR_VAL(filename));
+	if (dir_len >= MAXPATHLEN
+	 || zend_hash_str_exists(&ZCG(watcher_dirs), ZSTR_VAL(filename), dir_len)) {
+		return;
+	}
+	memcpy(dir, ZSTR_VAL(filename), dir_len);
+	dir[dir_len] = '\0';
+
+	wd = inotify_add_watch(ZCG(watcher_fd), dir, ACCEL_WATCHER_EVENT_MASK);
+	if (wd < 0) {
+		zend_accel_error(ACCEL_LOG_WARNING, "Cannot watch directory %s: %s", dir, strerror(errno));
+		return;
+	}
+
+	dir_str = zend_string_init(dir, dir_len, 1);
+	zend_hash_add_empty_element(&ZCG(watcher_dirs), dir_str);
+	zend_hash_index_update_ptr(&ZCG(watcher_wds), wd, dir_str);
+}
+
+void zend_accel_watcher_poll(void)
+{
+	/* aligned for the struct inotify_event records read() packs into it */
+	zend_ulong buf[4096 / sizeof(zend_ulong)];
+	ssize_t len;
+
+	if (ZCG(watcher_fd) < 0) {
+		return;
+	}
+
+	while ((len = read(ZCG(watcher_fd), buf, sizeof(buf))) > 0) {
+		const char *p = (const char*)buf;
+		const char *end = p + len;
+
+		while (p < end) {
+			const struct inotify_event *event = (const struct inotify_event*)p;
+			zend_string *dir_str;
+			char path[MAXPATHLEN];
+			size_t path_len;
+			zend_string *path_str;
+
+			p += sizeof(*event) + event->len;
+
+			if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
+				/* the affected scripts can't be identified any more */
+				zend_accel_invalidate_all();
+				continue;
+			}
+			dir_str = zend_hash_index_find_ptr(&ZCG(watcher_wds), event->wd);
+			if (!dir_str) {
+				continue;
+			}
+			if (event->mask & IN_IGNORED) {
+				zend_hash_del(&ZCG(watcher_dirs), dir_str);
+				zend_hash_index_del(&ZCG(watcher_wds), event->wd);
+				continue;
+			}
+			if (!event->len) {
+				continue;
+			}
+			path_len = ZSTR_LEN(dir_str) + 1 + strlen(event->name);
+			if (path_len >= MAXPATHLEN) {
+				continue;
+			}
+			memcpy(path, ZSTR_VAL(dir_str), ZSTR_LEN(dir_str));
+			path[ZSTR_LEN(dir_str)] = '/';
+			strcpy(path + ZSTR_LEN(dir_str) + 1, event->name);
+
+			path_str = zend_string_init(path, path_len, 0);
+			zend_accel_invalidate(path_str, true);
+			zend_string_release_ex(path_str, 0);
+		}
+	}
+}
+#endif /* HAVE_SYS_INOTIFY_H */
+
 static zend_string* accel_new_interned_key(zend_string *key)
 {
 	zend_string *new_key;
@@ -1549,6 +1749,59 @@ static zend_persistent_script *cache_script_in_file_cache(zend_persistent_script
 	return store_script_in_file_cache(new_persistent_script);
 }
 
+/* Record the script's unconditionally declared classes in the class index,
+ * so autoloading can find the defining file with a single hash probe.
+ * Expects the shared allocation lock to be held; the script (including the
+ * class table and its keys) must already live in shared memory. */
+static void zend_accel_index_script_classes(zend_persistent_script *persistent_script)
+{
+	zend_string *key;
+	zend_class_entry *ce;
+
+	if (!ZCG(accel_directives).autoload_index) {
+		return;
+	}
+
+	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(&persistent_script->script.class_table, key, ce) {
+		zend_string *lc_name;
+		zend_accel_hash_entry *entry;
+
+		if (!(ce->ce_flags & ZEND_ACC_TOP_LEVEL)) {
+			/* Conditionally declared; executing the file may not define it. */
+			continue;
+		}
+		if (ZSTR_VAL(key)[0] != '\0') {
+			/* Early bound class; the key is the interned lowercased name. */
+			lc_name = key;
+		} else {
+			/* Runtime definition key: "\0" + lowercased name + file/line.
+			 * The embedded name has the same length as ce->name. */
+			zend_string *tmp = zend_string_init(ZSTR_VAL(key) + 1, ZSTR_LEN(ce->name), 0);
+
+			lc_name = accel_new_interned_key(tmp);
+			zend_string_release_ex(tmp, 0);
+			if (!lc_name) {
+				continue;
+			}
+		}
+		entry = zend_accel_hash_find_entry(&ZCSG(class_index), lc_name);
+		if (entry) {
+			zend_persistent_script *old = (zend_persistent_script *)entry->data;
+
+			if (old && zend_string_equals(old->script.filename, persistent_script->script.filename)) {
+				/* The file was recompiled; point at the new copy. */
+				entry->data = persistent_script;
+			} else {
+				/* The same class is defined in several files (or the entry
+				 * was already invalidated); the index cannot decide. */
+				entry->data = NULL;
+			}
+		} else if (!zend_accel_hash_is_full(&ZCSG(class_index))) {
+			zend_accel_hash_update(&ZCSG(class_index), lc_name, 0, persistent_script);
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+
 static zend_persistent_script *cache_script_in_shared_memory(zend_persistent_script *new_persistent_script, zend_string *key, bool *from_shared_memory)
 {
 	zend_accel_hash_entry *bucket;
@@ -1563,6 +1816,35 @@ static zend_persistent_script *cache_script_in_shared_memory(zend_persistent_scr
 	zend_accel_finalize_delayed_early_binding_list(new_persistent_script);
 	CG(compiler_options) = orig_compiler_options;
 
+	/* Check whether another process already stored the script before taking
+	 * the exclusive lock. After a deploy many workers miss the cache for the
+	 * same hot scripts at once; without this check they would all convoy on
+	 * the lock only to find the script stored by the first one. The hash is
+	 * safe for lock-free readers, so the losers of the race drop out here and
+	 * only processes with genuinely new scripts serialize below. */
+	bucket = zend_accel_hash_find_entry(&ZCSG(hash), new_persistent_script->script.filename);
+	if (bucket) {
+		zend_persistent_script *existing_persistent_script = (zend_persistent_script *)bucket->data;
+
+		if (!existing_persistent_script->corrupted) {
+			if (key &&
+			    (!ZCG(accel_directives).validate_timestamps ||
+			     (new_persistent_script->timestamp == existing_persistent_script->timestamp)) &&
+			    !zend_accel_hash_find(&ZCSG(hash), key)) {
+				/* only the alias key still has to be added under the lock */
+				zend_shared_alloc_lock();
+				bucket = zend_accel_hash_find_entry(&ZCSG(hash), new_persistent_script->script.filename);
+				if (bucket && !((zend_persistent_script *)bucket->data)->corrupted) {
+					zend_accel_add_key(key, bucket);
+				}
+				zend_shared_alloc_unlock();
+			}
+			free_persistent_script(new_persistent_script, 1);
+			*from_shared_memory = true;
+			return existing_persistent_script;
+		}
+	}
+
 	/* exclusive lock */
 	zend_shared_alloc_lock();
 
@@ -1647,6 +1929,7 @@ static zend_persistent_script *cache_script_in_shared_memory(zend_persistent_scr
 	bucket = zend_accel_hash_update(&ZCSG(hash), new_persistent_script->script.filename, 0, new_persistent_script);
 	if (bucket) {
 		zend_accel_error(ACCEL_LOG_INFO, "Cached script '%s'", ZSTR_VAL(new_persistent_script->script.filename));
+		zend_accel_index_script_classes(new_persistent_script);
 		if (key &&
 		    /* key may contain non-persistent PHAR aliases (see issues #115 and #149) */
 		    !zend_string_starts_with_literal(key, "phar://") &&
@@ -1722,6 +2005,138 @@ static void replay_warnings(uint32_t num_warnings, zend_error_info **warnings) {
 	}
 }
 
+/* Decides whether a class constant expression is guaranteed to evaluate to
+ * the same value in every request: literals, arrays and operators over them,
+ * persistent (engine/extension) constants, and already-resolved constants of
+ * the same class.  Anything else - user constants, other classes, enum cases,
+ * magic constants, namespace fallbacks - keeps its AST. */
+static bool zend_accel_const_expr_is_stable(zend_ast *ast, const zend_class_entry *ce)
+{
+	if (!ast) {
+		return true;
+	}
+	switch (ast->kind) {
+		case ZEND_AST_ZVAL:
+			return true;
+		case ZEND_AST_CONST: {
+			zend_ast *name_ast = ast->child[0];
+			zend_constant *c;
+
+			if (name_ast->kind != ZEND_AST_ZVAL
+			 || Z_TYPE_P(zend_ast_get_zval(name_ast)) != IS_STRING
+			 /* A namespace fallback could be shadowed by a constant defined
+			  * at run-time in a later request. */
+			 || (name_ast->attr & IS_CONSTANT_UNQUALIFIED_IN_NAMESPACE)) {
+				return false;
+			}
+			c = zend_hash_find_ptr(EG(zend_constants), Z_STR_P(zend_ast_get_zval(name_ast)));
+			return c
+				&& (ZEND_CONSTANT_FLAGS(c) & CONST_PERSISTENT)
+				&& !(ZEND_CONSTANT_FLAGS(c) & CONST_DEPRECATED);
+		}
+		case ZEND_AST_CLASS_CONST: {
+			zend_ast *class_ast = ast->child[0];
+			zend_ast *name_ast = ast->child[1];
+			zend_string *class_name;
+			zend_class_constant *c;
+
+			if (class_ast->kind != ZEND_AST_ZVAL
+			 || Z_TYPE_P(zend_ast_get_zval(class_ast)) != IS_STRING
+			 || name_ast->kind != ZEND_AST_ZVAL
+			 || Z_TYPE_P(zend_ast_get_zval(name_ast)) != IS_STRING) {
+				return false;
+			}
+			class_name = Z_STR_P(zend_ast_get_zval(class_ast));
+			if (!zend_string_equals_literal_ci(class_name, "self")
+			 && !zend_string_equals_ci(class_name, ce->name)) {
+				return false;
+			}
+			c = zend_hash_find_ptr(&ce->constants_table, Z_STR_P(zend_ast_get_zval(name_ast)));
+			return c
+				&& c->ce == ce
+				&& Z_TYPE(c->value) != IS_CONSTANT_AST
+				&& !(ZEND_CLASS_CONST_FLAGS(c) & ZEND_ACC_DEPRECATED);
+		}
+		case ZEND_AST_BINARY_OP:
+		case ZEND_AST_GREATER:
+		case ZEND_AST_GREATER_EQUAL:
+		case ZEND_AST_AND:
+		case ZEND_AST_OR:
+		case ZEND_AST_UNARY_OP:
+		case ZEND_AST_UNARY_PLUS:
+		case ZEND_AST_UNARY_MINUS:
+		case ZEND_AST_CONDITIONAL:
+		case ZEND_AST_COALESCE: {
+			uint32_t i, children = zend_ast_get_num_children(ast);
+
+			for (i = 0; i < children; i++) {
+				if (!zend_accel_const_expr_is_stable(ast->child[i], ce)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case ZEND_AST_ARRAY: {
+			zend_ast_list *list = zend_ast_get_list(ast);
+			uint32_t i;
+
+			for (i = 0; i < list->children; i++) {
+				zend_ast *elem = list->child[i];
+
+				if (!elem
+				 || elem->kind != ZEND_AST_ARRAY_ELEM
+				 || !zend_accel_const_expr_is_stable(elem->child[0], ce)
+				 || !zend_accel_const_expr_is_stable(elem->child[1], ce)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+/* Evaluates class constant ASTs whose value is provably request-independent,
+ * so that they are persisted as plain (for arrays: immutable, shared from
+ * SHM) values instead of being re-evaluated and re-allocated on first access
+ * in every request. */
+static void zend_accel_resolve_ast_constants(zend_persistent_script *persistent_script)
+{
+	zend_class_entry *ce;
+
+	ZEND_HASH_MAP_FOREACH_PTR(&persistent_script->script.class_table, ce) {
+		zend_string *name;
+		zend_class_constant *c;
+		bool unresolved = false;
+
+		if (!(ce->ce_flags & ZEND_ACC_HAS_AST_CONSTANTS)
+		 /* Trait constants are evaluated in the scope of the using class. */
+		 || (ce->ce_flags & (ZEND_ACC_TRAIT|ZEND_ACC_ENUM))) {
+			continue;
+		}
+		ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(&ce->constants_table, name, c) {
+			if (c->ce == ce && Z_TYPE(c->value) == IS_CONSTANT_AST) {
+				if (zend_accel_const_expr_is_stable(Z_ASTVAL(c->value), ce)
+				 && zend_update_class_constant(c, name, c->ce) == SUCCESS) {
+					continue;
+				}
+				if (UNEXPECTED(EG(exception))) {
+					/* The expression will fail again on first runtime access
+					 * and report from there, as it does today. */
+					zend_clear_exception();
+				}
+				unresolved = true;
+			} else if (Z_TYPE(c->value) == IS_CONSTANT_AST) {
+				unresolved = true;
+			}
+		} ZEND_HASH_FOREACH_END();
+		if (!unresolved) {
+			ce->ce_flags &= ~ZEND_ACC_HAS_AST_CONSTANTS;
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+
 static zend_persistent_script *opcache_compile_file(zend_file_handle *file_handle, int type, zend_op_array **op_array_p)
 {
 	zend_persistent_script *new_persistent_script;
@@ -1845,6 +2260,7 @@ static zend_persistent_script *opcache_compile_file(zend_file_handle *file_handl
 	zend_accel_move_user_functions(CG(function_table), CG(function_table)->nNumUsed - orig_functions_count, &new_persistent_script->script);
 	zend_accel_move_user_classes(CG(class_table), CG(class_table)->nNumUsed - orig_class_count, &new_persistent_script->script);
 	zend_accel_build_delayed_early_binding_list(new_persistent_script);
+	zend_accel_resolve_ast_constants(new_persistent_script);
 	new_persistent_script->num_warnings = EG(num_errors);
 	new_persistent_script->warnings = EG(errors);
 	EG(num_errors) = 0;
@@ -2131,6 +2547,9 @@ zend_op_array *persistent_compile_file(zend_file_handle *file_handle, int type)
 
 		/* Cache miss.. */
 		ZCSG(misses)++;
+#ifdef HAVE_DTRACE
+		DTRACE_PROBE1(php, opcache__miss, ZSTR_VAL(file_handle->filename));
+#endif
 
 		/* No memory left. Behave like without the Accelerator */
 		if (ZSMMG(memory_exhausted) || ZCSG(restart_pending)) {
@@ -2177,6 +2596,9 @@ zend_op_array *persistent_compile_file(zend_file_handle *file_handle, int type)
 		HANDLE_UNBLOCK_INTERRUPTIONS();
 	} else {
 
+#ifdef HAVE_DTRACE
+		DTRACE_PROBE1(php, opcache__hit, ZSTR_VAL(file_handle->filename));
+#endif
 #if !ZEND_WIN32
 		ZCSG(hits)++; /* TBFixed: may lose one hit */
 		persistent_script->dynamic_members.hits++; /* see above */
@@ -2226,6 +2648,13 @@ zend_op_array *persistent_compile_file(zend_file_handle *file_handle, int type)
 		zend_accel_set_auto_globals(persistent_script->ping_auto_globals_mask & ~ZCG(auto_globals_mask));
 	}
 
+#ifdef HAVE_SYS_INOTIFY_H
+	if (UNEXPECTED(ZCG(accel_directives).file_watcher)
+	 && persistent_script->script.filename) {
+		zend_accel_watcher_track(persistent_script->script.filename);
+	}
+#endif
+
 	return zend_accel_load_script(persistent_script, from_shared_memory);
 }
 
@@ -2571,6 +3000,66 @@ static zend_string* persistent_zend_resolve_path(zend_string *filename)
 	return accelerator_orig_zend_resolve_path(filename);
 }
 
+/* zend_autoload replacement. Before any userland autoloader runs, probe the
+ * class index; on a hit include the defining file directly, which resolves
+ * the class with one SHM hash probe plus a cached compilation instead of a
+ * userland callback and its path building. Falls through to the original
+ * autoloader (usually SPL's) whenever the index cannot answer. */
+static zend_class_entry *persistent_autoload(zend_string *name, zend_string *lc_name)
+{
+	if (ZCG(accelerator_enabled)) {
+		zend_persistent_script *persistent_script = zend_accel_hash_find(&ZCSG(class_index), lc_name);
+
+		if (persistent_script && !persistent_script->corrupted) {
+			zend_string *filename = persistent_script->script.filename;
+			zval dummy;
+
+			ZVAL_NULL(&dummy);
+			if (zend_hash_add(&EG(included_files), filename, &dummy)) {
+				zend_file_handle file_handle;
+				zend_op_array *op_array;
+
+				zend_stream_init_filename_ex(&file_handle, filename);
+				if (ZCG(accel_directives).validate_timestamps
+				 && php_stream_open_for_zend_ex(&file_handle, STREAM_OPEN_FOR_INCLUDE) == FAILURE) {
+					/* The indexed file disappeared; let the regular
+					 * autoloaders deal with the class. */
+					zend_hash_del(&EG(included_files), filename);
+					zend_destroy_file_handle(&file_handle);
+					goto fallback;
+				}
+				op_array = zend_compile_file(&file_handle, ZEND_REQUIRE);
+				if (op_array) {
+					uint32_t orig_jit_trace_num = EG(jit_trace_num);
+					zval result;
+
+					ZVAL_UNDEF(&result);
+					zend_execute(op_array, &result);
+					EG(jit_trace_num) = orig_jit_trace_num;
+
+					destroy_op_array(op_array);
+					efree_size(op_array, sizeof(zend_op_array));
+					if (!EG(exception)) {
+						zval_ptr_dtor(&result);
+					}
+				}
+				zend_destroy_file_handle(&file_handle);
+				if (EG(exception)) {
+					return NULL;
+				}
+			}
+
+			zend_class_entry *ce = zend_hash_find_ptr(EG(class_table), lc_name);
+			if (ce) {
+				return ce;
+			}
+		}
+	}
+
+fallback:
+	return accelerator_orig_zend_autoload ? accelerator_orig_zend_autoload(name, lc_name) : NULL;
+}
+
 static void zend_reset_cache_vars(void)
 {
 	ZSMMG(memory_exhausted) = false;
@@ -2600,6 +3089,57 @@ static void accel_reset_pcre_cache(void)
 	} ZEND_HASH_FOREACH_END();
 }
 
+/* Batch timestamp refresher (opcache.revalidate_batch). Instead of spreading
+ * one stat() per script over the request paths of all workers, the first
+ * worker that crosses the shared deadline re-stats the whole accelerated
+ * script list in one pass and publishes fresh dynamic_members.revalidate
+ * values into SHM. Until the next deadline every request then validates
+ * scripts with a plain integer comparison in validate_timestamp_and_record(),
+ * which keeps slow (e.g. NFS) stats off the request path of the other
+ * workers. Must be called with SHM unprotected. */
+static void accel_revalidate_batch(void)
+{
+	time_t deadline = ZCG(request_time) + (time_t)ZCG(accel_directives).revalidate_freq;
+	uint32_t i;
+
+	/* Several workers may cross the deadline at once; only the one that
+	 * advances it walks the script list. */
+	zend_shared_alloc_lock();
+	if (ZCSG(next_batch_revalidate) > ZCG(request_time)) {
+		zend_shared_alloc_unlock();
+		return;
+	}
+	ZCSG(next_batch_revalidate) = deadline;
+	zend_shared_alloc_unlock();
+
+	for (i = 0; i < ZCSG(hash).num_entries; i++) {
+		zend_accel_hash_entry *entry = &ZCSG(hash).hash_entries[i];
+		zend_persistent_script *persistent_script;
+		zend_file_handle ps_handle;
+
+		if (entry->indirect) {
+			continue;
+		}
+		persistent_script = (zend_persistent_script *) entry->data;
+		if (persistent_script->corrupted
+		 || persistent_script->timestamp == 0 /* preloaded scripts are never checked */) {
+			continue;
+		}
+
+		zend_stream_init_filename_ex(&ps_handle, persistent_script->script.filename);
+		ps_handle.opened_path = persistent_script->script.filename;
+
+		if (zend_get_file_handle_timestamp(&ps_handle, NULL) == persistent_script->timestamp) {
+			persistent_script->dynamic_members.revalidate = deadline;
+		} else {
+			zend_accel_lock_discard_script(persistent_script);
+		}
+
+		ps_handle.opened_path = NULL;
+		zend_destroy_file_handle(&ps_handle);
+	}
+}
+
 zend_result accel_activate(INIT_FUNC_ARGS)
 {
 	if (!ZCG(enabled) || !accel_startup_ok) {
@@ -2682,6 +3222,9 @@ zend_result accel_activate(INIT_FUNC_ARGS)
 				zend_map_ptr_reset();
 				zend_reset_cache_vars();
 				zend_accel_hash_clean(&ZCSG(hash));
+				if (ZCG(accel_directives).autoload_index) {
+					zend_accel_hash_clean(&ZCSG(class_index));
+				}
 
 				if (ZCG(accel_directives).interned_strings_buffer) {
 					accel_interned_strings_restore_state();
@@ -2710,9 +3253,23 @@ zend_result accel_activate(INIT_FUNC_ARGS)
 
 	ZCG(accelerator_enabled) = ZCSG(accelerator_enabled);
 
+	if (ZCG(accelerator_enabled)
+	 && ZCG(accel_directives).validate_timestamps
+	 && ZCG(accel_directives).revalidate_batch
+	 && ZCG(accel_directives).revalidate_freq
+	 && ZCSG(next_batch_revalidate) <= ZCG(request_time)) {
+		accel_revalidate_batch();
+	}
+
 	SHM_PROTECT();
 	HANDLE_UNBLOCK_INTERRUPTIONS();
 
+#ifdef HAVE_SYS_INOTIFY_H
+	if (ZCG(accelerator_enabled) && ZCG(accel_directives).file_watcher) {
+		zend_accel_watcher_poll();
+	}
+#endif
+
 	if (ZCG(accelerator_enabled) && ZCSG(last_restart_time) != ZCG(last_restart_time)) {
 		/* SHM was reinitialized. */
 		ZCG(last_restart_time) = ZCSG(last_restart_time);
@@ -2720,6 +3277,10 @@ zend_result accel_activate(INIT_FUNC_ARGS)
 		/* Reset in-process realpath cache */
 		realpath_cache_clean();
 
+		/* The constant arrays the index points to were wiped with SHM */
+		zend_hash_clean(&ZCG(const_array_index));
+		zend_hash_clean(&ZCG(const_array_staged));
+
 		accel_reset_pcre_cache();
 		ZCG(pcre_reseted) = false;
 	} else if (!ZCG(accelerator_enabled) && !ZCG(pcre_reseted)) {
@@ -2739,12 +3300,194 @@ zend_result accel_activate(INIT_FUNC_ARGS)
 	return SUCCESS;
 }
 
-#ifdef HAVE_JIT
+/* Run-time cache warm-up snapshots
+ *
+ * The per-request run-time caches of immutable op-arrays start out zeroed, so
+ * every process re-resolves every polymorphic property cache slot on its first
+ * hit after a fork or request start.  For cache slots that only reference data
+ * at fixed addresses in SHM (immutable class entries and their property
+ * offsets), the resolved contents are valid in every process attached to the
+ * cache.  The first request to initialize a cache records the op-array; at
+ * deactivation the FETCH_OBJ_R slots pointing to immutable classes are copied
+ * into a SHM snapshot hung off the op-array's reserved slot, and later cache
+ * initializations replay the snapshot instead of starting cold. */
+
+static int accel_rtc_reserved_id = -1;
+
+typedef struct _accel_rtc_record {
+	struct _accel_rtc_record *next;
+	zend_op_array            *op_array;
+	void                    **cache;
+} accel_rtc_record;
+
+/* One snapshotted cache slot: its byte offset in the run-time cache and the
+ * two words ZEND_FETCH_OBJ_R keeps there (class entry and property offset) */
+typedef struct _accel_rtc_entry {
+	uint32_t slot;
+	void    *ce;
+	void    *prop;
+} accel_rtc_entry;
+
+typedef struct _accel_rtc_snapshot {
+	uint32_t        count;
+	accel_rtc_entry entries[1];
+} accel_rtc_snapshot;
+
+static void accel_warm_run_time_cache(zend_op_array *op_array, void **run_time_cache)
+{
+	accel_rtc_snapshot *snapshot;
+	accel_rtc_record *record;
+
+	if (!ZCG(accelerator_enabled)
+	 || accel_rtc_reserved_id < 0
+	 || !(op_array->fn_flags & ZEND_ACC_IMMUTABLE)
+	 || !zend_accel_in_shm(op_array)) {
+		return;
+	}
+
+	snapshot = (accel_rtc_snapshot*)op_array->reserved[accel_rtc_reserved_id];
+	if (snapshot) {
+		uint32_t i;
+
+		if (UNEXPECTED(!zend_accel_in_shm(snapshot))) {
+			return;
+		}
+		for (i = 0; i < snapshot->count; i++) {
+			void **slot = (void**)((char*)run_time_cache + snapshot->entries[i].slot);
+
+			slot[0] = snapshot->entries[i].ce;
+			slot[1] = snapshot->entries[i].prop;
+		}
+		return;
+	}
+
+	/* No snapshot yet; remember the cache and harvest it at deactivation,
+	 * once this request has resolved its property accesses. */
+	record = emalloc(sizeof(accel_rtc_record));
+	record->op_array = op_array;
+	record->cache = run_time_cache;
+	record->next = (accel_rtc_record*)ZCG(rtc_warm_records);
+	ZCG(rtc_warm_records) = record;
+}
+
+static void accel_rtc_harvest(zend_op_array *op_array, void **run_time_cache)
+{
+	const zend_op *opline = op_array->opcodes;
+	const zend_op *end = opline + op_array->last;
+	accel_rtc_entry *entries;
+	accel_rtc_snapshot *snapshot;
+	uint32_t count = 0;
+	ALLOCA_FLAG(use_heap)
+
+	entries = do_alloca(sizeof(accel_rtc_entry) * op_array->last, use_heap);
+	for (; opline < end; opline++) {
+		if (opline->opcode == ZEND_FETCH_OBJ_R && opline->op2_type == IS_CONST) {
+			uint32_t slot = opline->extended_value & ~ZEND_FETCH_REF;
+			void **p = (void**)((char*)run_time_cache + slot);
+			zend_class_entry *ce = (zend_class_entry*)p[0];
+
+			if (slot + 2 * sizeof(void*) <= op_array->cache_size
+			 && ce
+			 && (ce->ce_flags & ZEND_ACC_IMMUTABLE)
+			 && zend_accel_in_shm(ce)) {
+				entries[count].slot = slot;
+				entries[count].ce = p[0];
+				entries[count].prop = p[1];
+				count++;
+			}
+		}
+	}
+
+	if (count) {
+		SHM_UNPROTECT();
+		zend_shared_alloc_lock();
+		if (!op_array->reserved[accel_rtc_reserved_id]) {
+			snapshot = zend_shared_alloc(sizeof(accel_rtc_snapshot) + (count - 1) * sizeof(accel_rtc_entry));
+			if (snapshot) {
+				snapshot->count = count;
+				memcpy(snapshot->entries, entries, count * sizeof(accel_rtc_entry));
+				op_array->reserved[accel_rtc_reserved_id] = snapshot;
+			}
+		}
+		zend_shared_alloc_unlock();
+		SHM_PROTECT();
+	}
+	free_alloca(entries, use_heap);
+}
+
+static void accel_rtc_harvest_all(void)
+{
+	accel_rtc_record *record = (accel_rtc_record*)ZCG(rtc_warm_records);
+
+	while (record) {
+		accel_rtc_record *next = record->next;
+
+		if (ZCG(accelerator_enabled) && !ZCSG(restart_in_progress)) {
+			accel_rtc_harvest(record->op_array, record->cache);
+		}
+		efree(record);
+		record = next;
+	}
+	ZCG(rtc_warm_records) = NULL;
+}
+
+/* Function-level execution coverage
+ *
+ * When opcache.coverage is enabled, every persisted op-array gets a
+ * zend_ulong execution counter carved out of its script's shared-memory
+ * block (see zend_persist.c), and an fcall observer bumps it on entry.
+ * The counters live in SHM, so they aggregate across every process
+ * attached to the cache, and opcache_get_status() reports them per
+ * function.  With the directive off no observer is registered and the
+ * engine runs unmodified. */
+
+int accel_coverage_reserved = -1;
+
+static void accel_coverage_fcall_begin(zend_execute_data *execute_data)
+{
+	zend_ulong *counter = (zend_ulong*)execute_data->func->op_array.reserved[accel_coverage_reserved];
+
+	/* Unsynchronized increments may drop the odd hit when processes race;
+	 * that is acceptable for coverage and keeps the handler to one add. */
+	(*counter)++;
+}
+
+static zend_observer_fcall_handlers accel_coverage_observer_init(zend_execute_data *execute_data)
+{
+	zend_observer_fcall_handlers handlers = { NULL, NULL };
+	zend_function *func = execute_data->func;
+
+	if (func->type == ZEND_USER_FUNCTION
+	 && func->op_array.reserved[accel_coverage_reserved]) {
+		handlers.begin = accel_coverage_fcall_begin;
+	}
+	return handlers;
+}
+
+void accel_coverage_startup(void)
+{
+	if (ZCG(accel_directives).protect_memory) {
+		/* counter writes would fault in mprotect()ed SHM */
+		zend_accel_error(ACCEL_LOG_WARNING, "opcache.coverage cannot be combined with opcache.protect_memory, coverage disabled");
+		ZCG(accel_directives).coverage = false;
+		return;
+	}
+	accel_coverage_reserved = zend_get_resource_handle(ACCELERATOR_PRODUCT_NAME);
+	if (accel_coverage_reserved < 0) {
+		zend_accel_error(ACCEL_LOG_WARNING, "opcache.coverage disabled, no reserved op_array slot available");
+		ZCG(accel_directives).coverage = false;
+		return;
+	}
+	zend_observer_fcall_register(accel_coverage_observer_init);
+}
+
 void accel_deactivate(void)
 {
+	accel_rtc_harvest_all();
+#ifdef HAVE_JIT
 	zend_jit_deactivate();
-}
 #endif
+}
 
 zend_result accel_post_deactivate(void)
 {
@@ -2753,6 +3496,8 @@ zend_result accel_post_deactivate(void)
 		ZCG(cwd) = NULL;
 	}
 
+	zend_file_cache_deactivate();
+
 	if (!ZCG(enabled) || !accel_startup_ok) {
 		return SUCCESS;
 	}
@@ -2857,6 +3602,9 @@ static zend_result zend_accel_init_shm(void)
 	ZSMMG(app_shared_globals) = accel_shared_globals;
 
 	zend_accel_hash_init(&ZCSG(hash), ZCG(accel_directives).max_accelerated_files);
+	if (ZCG(accel_directives).autoload_index) {
+		zend_accel_hash_init(&ZCSG(class_index), ZCG(accel_directives).max_accelerated_files);
+	}
 
 	if (ZCG(accel_directives).interned_strings_buffer) {
 		uint32_t hash_size;
@@ -2911,6 +3659,7 @@ static zend_result zend_accel_init_shm(void)
 	ZCSG(accelerator_enabled) = true;
 	ZCSG(start_time) = zend_accel_get_time();
 	ZCSG(last_restart_time) = 0;
+	ZCSG(next_batch_revalidate) = 0;
 	ZCSG(restart_in_progress) = false;
 
 	for (i = 0; i < -HT_MIN_MASK; i++) {
@@ -2928,6 +3677,25 @@ static void accel_globals_ctor(zend_accel_globals *accel_globals)
 	ZEND_TSRMLS_CACHE_UPDATE();
 #endif
 	memset(accel_globals, 0, sizeof(zend_accel_globals));
+	zend_hash_init(&accel_globals->const_array_index, 8, NULL, NULL, 1);
+	zend_hash_init(&accel_globals->const_array_staged, 8, NULL, NULL, 1);
+#ifdef HAVE_SYS_INOTIFY_H
+	accel_globals->watcher_fd = -1;
+#endif
+}
+
+static void accel_globals_dtor(zend_accel_globals *accel_globals)
+{
+	zend_hash_destroy(&accel_globals->const_array_index);
+	zend_hash_destroy(&accel_globals->const_array_staged);
+#ifdef HAVE_SYS_INOTIFY_H
+	if (accel_globals->watcher_fd >= 0) {
+		close(accel_globals->watcher_fd);
+		accel_globals->watcher_fd = -1;
+		zend_hash_destroy(&accel_globals->watcher_dirs);
+		zend_hash_destroy(&accel_globals->watcher_wds);
+	}
+#endif
 }
 
 #ifdef HAVE_HUGE_CODE_PAGES
@@ -3104,7 +3872,7 @@ static void accel_move_code_to_huge_pages(void)
 static int accel_startup(zend_extension *extension)
 {
 #ifdef ZTS
-	accel_globals_id = ts_allocate_id(&accel_globals_id, sizeof(zend_accel_globals), (ts_allocate_ctor) accel_globals_ctor, NULL);
+	accel_globals_id = ts_allocate_id(&accel_globals_id, sizeof(zend_accel_globals), (ts_allocate_ctor) accel_globals_ctor, (ts_allocate_dtor) accel_globals_dtor);
 #else
 	accel_globals_ctor(&accel_globals);
 #endif
@@ -3125,6 +3893,12 @@ static int accel_startup(zend_extension *extension)
 		return FAILURE;
 	}
 
+	accel_rtc_reserved_id = zend_get_resource_handle(ACCELERATOR_PRODUCT_NAME);
+
+	if (ZCG(accel_directives).coverage) {
+		accel_coverage_startup();
+	}
+
 #ifdef ZEND_WIN32
 	if (UNEXPECTED(accel_gen_uname_id() == FAILURE)) {
 		zps_startup_failure("Unable to get user name", NULL, accelerator_remove_cb);
@@ -3288,6 +4062,9 @@ file_cache_fallback:
 	accelerator_orig_compile_file = zend_compile_file;
 	zend_compile_file = persistent_compile_file;
 
+	/* Pre-populate fresh run-time caches from SHM warm-up snapshots */
+	zend_init_run_time_cache_hook = accel_warm_run_time_cache;
+
 	/* Override stream opener function (to eliminate open() call caused by
 	 * include/require statements ) */
 	accelerator_orig_zend_stream_open_function = zend_stream_open_function;
@@ -3298,6 +4075,13 @@ file_cache_fallback:
 	accelerator_orig_zend_resolve_path = zend_resolve_path;
 	zend_resolve_path = persistent_zend_resolve_path;
 
+	/* Override the autoloading entry point (to resolve indexed classes with
+	 * one SHM hash probe before userland autoloaders run) */
+	if (!file_cache_only && ZCG(accel_directives).autoload_index) {
+		accelerator_orig_zend_autoload = zend_autoload;
+		zend_autoload = persistent_autoload;
+	}
+
 	/* Override chdir() function */
 	if ((func = zend_hash_str_find_ptr(CG(function_table), "chdir", sizeof("chdir")-1)) != NULL &&
 	    func->type == ZEND_INTERNAL_FUNCTION) {
@@ -3368,6 +4152,8 @@ void accel_shutdown(void)
 	if (!ZCG(enabled) || !accel_startup_ok) {
 #ifdef ZTS
 		ts_free_id(accel_globals_id);
+#else
+		accel_globals_dtor(&accel_globals);
 #endif
 		return;
 	}
@@ -3382,6 +4168,8 @@ void accel_shutdown(void)
 
 #ifdef ZTS
 	ts_free_id(accel_globals_id);
+#else
+	accel_globals_dtor(&accel_globals);
 #endif
 
 	if (!_file_cache_only) {
@@ -3762,6 +4550,11 @@ static bool preload_try_resolve_constants(zend_class_entry *ce)
 			uint32_t i;
 			bool resolved = true;
 
+			/* The properties info table is built lazily after linking. */
+			if (!ce->properties_info_table) {
+				zend_build_properties_info_table(ce);
+			}
+
 			for (i = 0; i < ce->default_properties_count; i++) {
 				val = &ce->default_properties_table[i];
 				if (Z_TYPE_P(val) == IS_CONSTANT_AST) {
@@ -4144,6 +4937,122 @@ static void preload_remove_empty_includes(void)
 	} ZEND_HASH_FOREACH_END();
 }
 
+static void preload_script_dep_add(HashTable *file_indexes, HashTable **dep_sets, uint32_t self, const zend_class_entry *dep)
+{
+	zval *zv;
+
+	if (!dep || dep->type != ZEND_USER_CLASS || !dep->info.user.filename) {
+		return;
+	}
+	zv = zend_hash_find(file_indexes, dep->info.user.filename);
+	if (!zv || (uint32_t)Z_LVAL_P(zv) == self) {
+		return;
+	}
+	if (!dep_sets[self]) {
+		dep_sets[self] = emalloc(sizeof(HashTable));
+		zend_hash_init(dep_sets[self], 8, NULL, NULL, 0);
+	}
+	zend_hash_index_add_empty_element(dep_sets[self], Z_LVAL_P(zv));
+}
+
+/* Record, for every preloaded file, which other preloaded files define the
+ * parents, interfaces and traits of its classes. The lists are stored next
+ * to ZCSG(saved_scripts) (same order, 1-based indexes, 0-terminated) and
+ * published through opcache_get_status(), so a reload driver can map an
+ * on-disk change to the affected compilation units instead of assuming the
+ * whole preload set is stale. Re-linking a subset in place is not possible
+ * (preloaded classes are permanently linked into SHM), so that decision has
+ * to be made before the new master runs the preload script. */
+static uint32_t **preload_collect_script_deps(void)
+{
+	uint32_t num_scripts = zend_hash_num_elements(preload_scripts);
+	HashTable file_indexes;
+	HashTable **dep_sets;
+	uint32_t **lists;
+	zend_string *filename;
+	zval *zv;
+	uint32_t i;
+
+	zend_hash_init(&file_indexes, num_scripts, NULL, NULL, 0);
+	i = 0;
+	ZEND_HASH_MAP_FOREACH_STR_KEY(preload_scripts, filename) {
+		zval tmp;
+		ZVAL_LONG(&tmp, i);
+		zend_hash_add(&file_indexes, filename, &tmp);
+		i++;
+	} ZEND_HASH_FOREACH_END();
+
+	dep_sets = ecalloc(num_scripts, sizeof(HashTable*));
+
+	ZEND_HASH_MAP_FOREACH_VAL(EG(class_table), zv) {
+		zend_class_entry *ce;
+		zval *idx;
+		uint32_t self;
+
+		if (Z_TYPE_P(zv) == IS_ALIAS_PTR) {
+			continue;
+		}
+		ce = Z_CE_P(zv);
+		if (ce->type != ZEND_USER_CLASS || !ce->info.user.filename) {
+			continue;
+		}
+		idx = zend_hash_find(&file_indexes, ce->info.user.filename);
+		if (!idx) {
+			continue;
+		}
+		self = (uint32_t)Z_LVAL_P(idx);
+
+		if (ce->ce_flags & ZEND_ACC_LINKED) {
+			if (ce->parent) {
+				preload_script_dep_add(&file_indexes, dep_sets, self, ce->parent);
+			}
+			for (i = 0; i < ce->num_interfaces; i++) {
+				preload_script_dep_add(&file_indexes, dep_sets, self, ce->interfaces[i]);
+			}
+		} else {
+			if (ce->parent_name) {
+				zend_string *key = zend_string_tolower(ce->parent_name);
+				preload_script_dep_add(&file_indexes, dep_sets, self,
+					zend_hash_find_ptr(EG(class_table), key));
+				zend_string_release(key);
+			}
+			for (i = 0; i < ce->num_interfaces; i++) {
+				preload_script_dep_add(&file_indexes, dep_sets, self,
+					zend_hash_find_ptr(EG(class_table), ce->interface_names[i].lc_name));
+			}
+		}
+		for (i = 0; i < ce->num_traits; i++) {
+			preload_script_dep_add(&file_indexes, dep_sets, self,
+				zend_hash_find_ptr(EG(class_table), ce->trait_names[i].lc_name));
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zend_hash_destroy(&file_indexes);
+
+	lists = NULL;
+	for (i = 0; i < num_scripts; i++) {
+		if (dep_sets[i]) {
+			zend_ulong dep_idx;
+			uint32_t n = 0;
+			uint32_t *list = emalloc((zend_hash_num_elements(dep_sets[i]) + 1) * sizeof(uint32_t));
+
+			ZEND_HASH_FOREACH_NUM_KEY(dep_sets[i], dep_idx) {
+				list[n++] = (uint32_t)dep_idx + 1;
+			} ZEND_HASH_FOREACH_END();
+			list[n] = 0;
+			zend_hash_destroy(dep_sets[i]);
+			efree(dep_sets[i]);
+			if (!lists) {
+				lists = ecalloc(num_scripts, sizeof(uint32_t*));
+			}
+			lists[i] = list;
+		}
+	}
+	efree(dep_sets);
+
+	return lists;
+}
+
 static void preload_register_trait_methods(zend_class_entry *ce) {
 	zend_op_array *op_array;
 	ZEND_HASH_MAP_FOREACH_PTR(&ce->function_table, op_array) {
@@ -4399,6 +5308,7 @@ static zend_result accel_preload(const char *config, bool in_child)
 
 	if (ret == SUCCESS) {
 		zend_persistent_script *script;
+		uint32_t **saved_script_deps;
 		int ping_auto_globals_mask;
 		int i;
 
@@ -4462,6 +5372,10 @@ static zend_result accel_preload(const char *config, bool in_child)
 
 		preload_remove_empty_includes();
 
+		/* Classes are still in EG(class_table) here; collect the file
+		 * dependency graph before they are moved into the preload script. */
+		saved_script_deps = preload_collect_script_deps();
+
 		script = create_persistent_script();
 		script->ping_auto_globals_mask = ping_auto_globals_mask;
 
@@ -4525,6 +5439,27 @@ static zend_result accel_preload(const char *config, bool in_child)
 		} ZEND_HASH_FOREACH_END();
 		ZCSG(saved_scripts)[i] = NULL;
 
+		if (saved_script_deps) {
+			uint32_t num_scripts = zend_hash_num_elements(preload_scripts);
+			uint32_t j;
+
+			ZCSG(saved_script_deps) = zend_shared_alloc(num_scripts * sizeof(uint32_t*));
+			for (j = 0; j < num_scripts; j++) {
+				if (saved_script_deps[j]) {
+					uint32_t len = 0;
+					while (saved_script_deps[j][len]) {
+						len++;
+					}
+					ZCSG(saved_script_deps)[j] = zend_shared_alloc((len + 1) * sizeof(uint32_t));
+					memcpy(ZCSG(saved_script_deps)[j], saved_script_deps[j], (len + 1) * sizeof(uint32_t));
+					efree(saved_script_deps[j]);
+				} else {
+					ZCSG(saved_script_deps)[j] = NULL;
+				}
+			}
+			efree(saved_script_deps);
+		}
+
 		zend_shared_alloc_save_state();
 		accel_interned_strings_save_state();
 
@@ -4812,11 +5747,7 @@ ZEND_EXT_API zend_extension zend_extension_entry = {
 	accel_startup,					   		/* startup */
 	NULL,									/* shutdown */
 	NULL,									/* per-script activation */
-#ifdef HAVE_JIT
 	accel_deactivate,                       /* per-script deactivation */
-#else
-	NULL,									/* per-script deactivation */
-#endif
 	NULL,									/* message handler */
 	NULL,									/* op_array handler */
 	NULL,									/* extended statement handler */
@@ -149,10 +149,15 @@ typedef struct _zend_accel_directives {
 	bool      use_cwd;
 	bool      ignore_dups;
 	bool      validate_timestamps;
+#ifdef HAVE_SYS_INOTIFY_H
+	bool      file_watcher;
+#endif
 	bool      revalidate_path;
 	bool      save_comments;
 	bool      record_warnings;
+	bool      autoload_index;
 	bool      protect_memory;
+	bool      coverage;
 	bool      file_override_enabled;
 	bool      enable_cli;
 	bool      validate_permission;
@@ -160,6 +165,8 @@ typedef struct _zend_accel_directives {
 	bool      validate_root;
 #endif
 	zend_ulong     revalidate_freq;
+	bool      revalidate_batch;
+	bool      graceful_reset;
 	zend_ulong     file_update_protection;
 	char          *error_log;
 #ifdef ZEND_WIN32
@@ -213,11 +220,29 @@ typedef struct _zend_accel_globals {
 	time_t                  request_time;
 	time_t                  last_restart_time; /* used to synchronize SHM and in-process caches */
 	HashTable               xlat_table;
+	/* content hash -> constant array persisted in SHM; identical
+	 * immutable arrays from different scripts share one copy */
+	HashTable               const_array_index;
+	/* arrays persisted for the current script; merged into
+	 * const_array_index only after the whole script is stored, so the
+	 * size calculation and the persist pass see the same index */
+	HashTable               const_array_staged;
 #ifndef ZEND_WIN32
 	zend_ulong              root_hash;
+#endif
+#ifdef HAVE_SYS_INOTIFY_H
+	/* inotify-based invalidation (opcache.file_watcher) */
+	int                     watcher_fd;
+	HashTable               watcher_dirs; /* watched directories */
+	HashTable               watcher_wds;  /* watch descriptor -> directory */
 #endif
 	/* preallocated shared-memory block to save current script */
 	void                   *mem;
+	/* mmaped file cache payloads of the current request (zend_file_cache.c) */
+	void                   *file_cache_mappings;
+	/* immutable op-arrays whose run-time caches are harvested into SHM
+	 * warm-up snapshots at deactivation */
+	void                   *rtc_warm_records;
 	zend_persistent_script *current_persistent_script;
 	/* cache to save hash lookup on the same INCLUDE opcode */
 	const zend_op          *cache_opline;
@@ -250,6 +275,7 @@ typedef struct _zend_accel_shared_globals {
 	zend_ulong   hash_restarts;    /* number of restarts because of hash overflow */
 	zend_ulong   manual_restarts;  /* number of restarts scheduled by opcache_reset() */
 	zend_accel_hash hash;             /* hash table for cached scripts */
+	zend_accel_hash class_index;      /* lowercased class name -> defining cached script */
 
 	size_t map_ptr_last;
 
@@ -257,6 +283,7 @@ typedef struct _zend_accel_shared_globals {
 	time_t          start_time;
 	time_t          last_restart_time;
 	time_t          force_restart_time;
+	time_t          next_batch_revalidate; /* deadline of the batch timestamp refresher */
 	bool       accelerator_enabled;
 	bool       restart_pending;
 	zend_accel_restart_reason restart_reason;
@@ -267,10 +294,16 @@ typedef struct _zend_accel_shared_globals {
 #endif
 	bool       restart_in_progress;
 	bool       jit_counters_stopped;
+	/* number of JIT compilations refused because the code buffer was full,
+	 * reset together with the buffer on restart */
+	zend_ulong jit_buffer_overflows;
 
 	/* Preloading */
 	zend_persistent_script *preload_script;
 	zend_persistent_script **saved_scripts;
+	/* per-saved-script dependency lists: 1-based indexes into saved_scripts,
+	 * 0-terminated; entry is NULL when the script has no dependencies */
+	uint32_t **saved_script_deps;
 
 	/* uninitialized HashTable Support */
 	uint32_t uninitialized_bucket[-HT_MIN_MASK];
@@ -279,6 +312,13 @@ typedef struct _zend_accel_shared_globals {
 	void *jit_traces;
 	const void **jit_exit_groups;
 
+	/* Interned string buffer pressure accounting: strings spilled into the
+	 * shared pool after the dedicated buffer overflowed, and interning
+	 * requests that had to be dropped entirely */
+	zend_ulong   interned_strings_overflow_count;
+	size_t       interned_strings_overflow_mem;
+	zend_ulong   interned_strings_overflow_misses;
+
 	/* Interned Strings Support (must be the last element) */
 	zend_string_table interned_strings;
 } zend_accel_shared_globals;
@@ -308,8 +348,13 @@ extern zend_accel_globals accel_globals;
 
 extern const char *zps_api_failure_reason;
 
+/* reserved op_array slot holding the per-function coverage counter,
+ * or -1 when opcache.coverage is disabled */
+extern int accel_coverage_reserved;
+
 BEGIN_EXTERN_C()
 
+void accel_coverage_startup(void);
 void accel_shutdown(void);
 zend_result  accel_activate(INIT_FUNC_ARGS);
 zend_result accel_post_deactivate(void);
@@ -319,6 +364,11 @@ accel_time_t zend_get_file_handle_timestamp(zend_file_handle *file_handle, size_
 zend_result validate_timestamp_and_record(zend_persistent_script *persistent_script, zend_file_handle *file_handle);
 zend_result validate_timestamp_and_record_ex(zend_persistent_script *persistent_script, zend_file_handle *file_handle);
 zend_result zend_accel_invalidate(zend_string *filename, bool force);
+void zend_accel_invalidate_all(void);
+#ifdef HAVE_SYS_INOTIFY_H
+void zend_accel_watcher_track(zend_string *filename);
+void zend_accel_watcher_poll(void);
+#endif
 zend_result accelerator_shm_read_lock(void);
 void accelerator_shm_read_unlock(void);
 
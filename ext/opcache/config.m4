@@ -105,6 +105,8 @@ if test "$PHP_OPCACHE" != "no"; then
 
   AC_CHECK_FUNCS([mprotect shm_create_largepage])
 
+  AC_CHECK_HEADERS([sys/inotify.h])
+
   AC_CACHE_CHECK([for sysvipc shared memory support], [php_cv_shm_ipc],
     [AC_RUN_IFELSE([AC_LANG_SOURCE([[
 #include <sys/types.h>
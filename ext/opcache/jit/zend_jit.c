@@ -28,6 +28,7 @@
 #include "Zend/zend_closures.h"
 #include "Zend/zend_ini.h"
 #include "Zend/zend_observer.h"
+#include "Zend/zend_multiply.h"
 #include "zend_smart_str.h"
 #include "jit/zend_jit.h"
 
@@ -712,9 +713,11 @@ ZEND_EXT_API void zend_jit_status(zval *ret)
 	if (dasm_buf) {
 		add_assoc_long(&stats, "buffer_size", (char*)dasm_end - (char*)dasm_buf);
 		add_assoc_long(&stats, "buffer_free", (char*)dasm_end - (char*)*dasm_ptr);
+		add_assoc_long(&stats, "buffer_overflows", ZCSG(jit_buffer_overflows));
 	} else {
 		add_assoc_long(&stats, "buffer_size", 0);
 		add_assoc_long(&stats, "buffer_free", 0);
+		add_assoc_long(&stats, "buffer_overflows", 0);
 	}
 	add_assoc_zval(ret, "jit", &stats);
 }
@@ -748,6 +751,24 @@ static zend_string *zend_jit_func_name(const zend_op_array *op_array)
 	}
 }
 
+/* Check whether any corner product of the two operand ranges overflows
+ * zend_long. Mirrors the range propagation for ZEND_MUL in zend_inference.c. */
+static bool zend_mul_range_may_overflow(zend_long op1_min, zend_long op1_max, zend_long op2_min, zend_long op2_max)
+{
+	double dummy;
+	zend_long t, t1_overflow, t2_overflow, t3_overflow, t4_overflow;
+
+	t = 0;
+	ZEND_SIGNED_MULTIPLY_LONG(op1_min, op2_min, t, dummy, t1_overflow);
+	ZEND_SIGNED_MULTIPLY_LONG(op1_min, op2_max, t, dummy, t2_overflow);
+	ZEND_SIGNED_MULTIPLY_LONG(op1_max, op2_min, t, dummy, t3_overflow);
+	ZEND_SIGNED_MULTIPLY_LONG(op1_max, op2_max, t, dummy, t4_overflow);
+	(void) dummy;
+	(void) t;
+
+	return t1_overflow || t2_overflow || t3_overflow || t4_overflow;
+}
+
 static int zend_may_overflow(const zend_op *opline, const zend_ssa_op *ssa_op, const zend_op_array *op_array, zend_ssa *ssa)
 {
 	int res;
@@ -843,10 +864,19 @@ static int zend_may_overflow(const zend_op *opline, const zend_ssa_op *ssa_op, c
 			return 0;
 		case ZEND_MUL:
 			res = ssa_op->result_def;
-			return (res < 0 ||
-				!ssa->var_info[res].has_range ||
-				ssa->var_info[res].range.underflow ||
-				ssa->var_info[res].range.overflow);
+			if (res < 0
+			 || !ssa->var_info[res].has_range
+			 || ssa->var_info[res].range.underflow
+			 || ssa->var_info[res].range.overflow) {
+				if (!OP1_HAS_RANGE() || !OP2_HAS_RANGE()) {
+					return 1;
+				}
+				if (zend_mul_range_may_overflow(OP1_MIN_RANGE(), OP1_MAX_RANGE(),
+						OP2_MIN_RANGE(), OP2_MAX_RANGE())) {
+					return 1;
+				}
+			}
+			return 0;
 		case ZEND_ASSIGN_OP:
 			if (opline->extended_value == ZEND_ADD) {
 				res = ssa_op->op1_def;
@@ -904,10 +934,19 @@ static int zend_may_overflow(const zend_op *opline, const zend_ssa_op *ssa_op, c
 				return 0;
 			} else if (opline->extended_value == ZEND_MUL) {
 				res = ssa_op->op1_def;
-				return (res < 0 ||
-					!ssa->var_info[res].has_range ||
-					ssa->var_info[res].range.underflow ||
-					ssa->var_info[res].range.overflow);
+				if (res < 0
+				 || !ssa->var_info[res].has_range
+				 || ssa->var_info[res].range.underflow
+				 || ssa->var_info[res].range.overflow) {
+					if (!OP1_HAS_RANGE() || !OP2_HAS_RANGE()) {
+						return 1;
+					}
+					if (zend_mul_range_may_overflow(OP1_MIN_RANGE(), OP1_MAX_RANGE(),
+							OP2_MIN_RANGE(), OP2_MAX_RANGE())) {
+						return 1;
+					}
+				}
+				return 0;
 			}
 			ZEND_FALLTHROUGH;
 		default:
@@ -2915,6 +2954,14 @@ void zend_jit_check_funcs(HashTable *function_table, bool is_method) {
 			ZEND_COUNTER_INFO(op_array) = 0;
 			jit_extension = (zend_jit_op_array_extension*)ZEND_FUNC_INFO(op_array);
 			opline->handler = jit_extension->orig_handler;
+			if (JIT_G(debug) & ZEND_JIT_DEBUG_PROF_DUMP) {
+				fprintf(stderr, "PROF %" PRIuPTR "/" ZEND_ULONG_FMT " %s%s%s %s:%d\n",
+					counter, zend_jit_profile_counter,
+					op_array->scope ? ZSTR_VAL(op_array->scope->name) : "",
+					op_array->scope ? "::" : "",
+					op_array->function_name ? ZSTR_VAL(op_array->function_name) : "{main}",
+					ZSTR_VAL(op_array->filename), op_array->line_start);
+			}
 			if (((double)counter / (double)zend_jit_profile_counter) > JIT_G(prof_threshold)) {
 				zend_real_jit_func(op_array, NULL, NULL);
 			}
@@ -74,6 +74,8 @@
 #define ZEND_JIT_DEBUG_TRACE_TSSA      (1<<19)
 #define ZEND_JIT_DEBUG_TRACE_EXIT_INFO (1<<20)
 
+#define ZEND_JIT_DEBUG_PROF_DUMP       (1<<21)
+
 #define ZEND_JIT_DEBUG_IR_SRC            (1<<24)
 #define ZEND_JIT_DEBUG_IR_FINAL          (1<<25)
 #define ZEND_JIT_DEBUG_IR_AFTER_SCCP     (1<<26)
@@ -109,6 +111,7 @@ typedef struct _zend_jit_globals {
 
 	const char *options;
 	zend_long   buffer_size;
+	zend_long   buffer_reset_threshold; /* number of buffer-full compilation failures before a restart is scheduled (0 - disabled) */
 	zend_long   debug;
 	zend_long   bisect_limit;
 	double      prof_threshold;
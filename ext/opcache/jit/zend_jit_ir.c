@@ -2822,6 +2822,12 @@ static void *zend_jit_ir_compile(ir_ctx *ctx, size_t *size, const char *name)
 
 	*dasm_ptr = code_buffer.pos;
 
+	if (!entry && ctx->status == IR_ERROR_CODE_MEM_OVERFLOW) {
+		/* Remember the starvation, so zend_jit_check_buffer_starvation() can
+		 * turn repeated buffer-full failures into a scheduled restart. */
+		ZCSG(jit_buffer_overflows)++;
+	}
+
 #if defined(IR_TARGET_AARCH64)
 	if (ctx->flags2 & IR_HAS_VENEERS) {
 		zend_jit_commit_veneers();
@@ -5549,8 +5555,16 @@ static int zend_jit_long_math_helper(zend_jit_ctx   *jit,
 				if (Z_MODE(res_addr) == IS_REG) {
 					ref = ir_CONST_LONG(0); // dead code
 				}
+			} else if (op2_lval == 1 || op2_lval == -1) {
+				/* the remainder is always zero */
+				ref = ir_CONST_LONG(0);
 			} else if (zend_long_is_power_of_two(op2_lval) && op1_range && op1_range->min >= 0) {
 				ref = ir_AND_L(jit_Z_LVAL(jit, op1_addr), ir_CONST_LONG(op2_lval - 1));
+			} else if (op2_lval < 0 && op2_lval != ZEND_LONG_MIN
+					&& zend_long_is_power_of_two(-op2_lval) && op1_range && op1_range->min >= 0) {
+				/* the result takes the sign of the dividend, so the
+				 * divisor sign is irrelevant */
+				ref = ir_AND_L(jit_Z_LVAL(jit, op1_addr), ir_CONST_LONG(-op2_lval - 1));
 			} else {
 				ref = ir_MOD_L(jit_Z_LVAL(jit, op1_addr), ir_CONST_LONG(op2_lval));
 			}
@@ -14144,6 +14158,30 @@ static int zend_jit_fetch_obj(zend_jit_ctx         *jit,
 	return 1;
 }
 
+/* May the declared property type check be skipped because the inferred (or
+ * trace-guarded) value type already satisfies it? In that case the write is
+ * compiled like a write to an untyped property. */
+static bool zend_jit_prop_type_check_elidable(const zend_class_entry *ce, const zend_property_info *prop_info, uint32_t val_info)
+{
+	uint32_t type_mask;
+
+	if (!ce || !(ce->ce_flags & ZEND_ACC_IMMUTABLE)) {
+		/* prop_info may belong to another instantiation of the class */
+		return 0;
+	}
+	if (prop_info->flags & ZEND_ACC_READONLY) {
+		return 0;
+	}
+	if (ZEND_TYPE_IS_COMPLEX(prop_info->type)) {
+		return 0;
+	}
+	if (val_info & (MAY_BE_REF|MAY_BE_UNDEF)) {
+		return 0;
+	}
+	type_mask = ZEND_TYPE_PURE_MASK(prop_info->type);
+	return ((val_info & MAY_BE_ANY) & ~type_mask) == 0;
+}
+
 static int zend_jit_assign_obj(zend_jit_ctx         *jit,
                                const zend_op        *opline,
                                const zend_op_array  *op_array,
@@ -14360,7 +14398,8 @@ static int zend_jit_assign_obj(zend_jit_ctx         *jit,
 				ir_IF_TRUE(if_def);
 			}
 		}
-		if (ZEND_TYPE_IS_SET(prop_info->type)) {
+		if (ZEND_TYPE_IS_SET(prop_info->type)
+		 && !zend_jit_prop_type_check_elidable(ce, prop_info, val_info)) {
 			ir_ref ref, arg3, arg4;
 
 			// JIT: value = zend_assign_to_typed_prop(prop_info, property_val, value EXECUTE_DATA_CC);
@@ -14408,7 +14447,9 @@ static int zend_jit_assign_obj(zend_jit_ctx         *jit,
 		}
 	}
 
-	if (!prop_info || !ZEND_TYPE_IS_SET(prop_info->type)) {
+	if (!prop_info
+	 || !ZEND_TYPE_IS_SET(prop_info->type)
+	 || zend_jit_prop_type_check_elidable(ce, prop_info, val_info)) {
 		if (Z_MODE(val_addr) != IS_REG
 		 && (res_addr == 0 || Z_MODE(res_addr) != IS_REG)
 		 && opline->result_type == IS_UNUSED) {
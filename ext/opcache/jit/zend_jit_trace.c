@@ -64,6 +64,7 @@ static void zend_jit_trace_startup(bool reattached)
 		ZCSG(jit_traces) = zend_jit_traces;
 		ZCSG(jit_exit_groups) = zend_jit_exit_groups;
 		ZCSG(jit_counters_stopped) = false;
+		ZCSG(jit_buffer_overflows) = 0;
 	} else {
 		zend_jit_traces = ZCSG(jit_traces);
 		if (!zend_jit_traces) {
@@ -7341,6 +7342,22 @@ jit_failure:
 	return handler;
 }
 
+/* Generated code can't be evicted or compacted in place: it is position
+ * dependent and may be executing in other processes.  Instead, when the code
+ * buffer is exhausted but new code still gets hot enough to ask for
+ * compilation, the hot set has shifted since the buffer was filled, and the
+ * best we can do is schedule a restart (like the shared allocator does on
+ * OOM), so the buffer is rebuilt from the current hot paths.  Disabled by
+ * default; enabled through opcache.jit_buffer_reset_threshold. */
+static void zend_jit_check_buffer_starvation(void)
+{
+	if (JIT_G(buffer_reset_threshold)
+	 && ZCSG(jit_buffer_overflows) >= (zend_ulong)JIT_G(buffer_reset_threshold)
+	 && !ZCSG(restart_pending)) {
+		zend_accel_schedule_restart(ACCEL_RESTART_OOM);
+	}
+}
+
 static zend_jit_trace_stop zend_jit_compile_root_trace(zend_jit_trace_rec *trace_buffer, const zend_op *opline, size_t offset)
 {
 	zend_jit_trace_stop ret;
@@ -7490,6 +7507,10 @@ exit:;
 		zend_bailout();
 	}
 
+	if (ret == ZEND_JIT_TRACE_STOP_COMPILER_ERROR) {
+		zend_jit_check_buffer_starvation();
+	}
+
 	if ((JIT_G(debug) & ZEND_JIT_DEBUG_TRACE_EXIT_INFO) != 0
 	 && ret == ZEND_JIT_TRACE_STOP_COMPILED
 	 && t->exit_count > 0) {
@@ -8296,6 +8317,10 @@ exit:;
 		zend_bailout();
 	}
 
+	if (ret == ZEND_JIT_TRACE_STOP_COMPILER_ERROR) {
+		zend_jit_check_buffer_starvation();
+	}
+
 	if ((JIT_G(debug) & ZEND_JIT_DEBUG_TRACE_EXIT_INFO) != 0
 	 && ret == ZEND_JIT_TRACE_STOP_COMPILED
 	 && t->exit_count > 0) {
@@ -8815,6 +8840,7 @@ static void zend_jit_trace_restart(void)
 	ZEND_JIT_EXIT_NUM = 0;
 	ZEND_JIT_EXIT_COUNTERS = 0;
 	ZCSG(jit_counters_stopped) = false;
+	ZCSG(jit_buffer_overflows) = 0;
 
 	zend_jit_trace_init_caches();
 }
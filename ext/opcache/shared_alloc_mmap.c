@@ -267,6 +267,18 @@ static int create_segments(size_t requested_size, zend_shared_segment ***shared_
 	}
 
 success: ZEND_ATTRIBUTE_UNUSED;
+#ifdef MADV_HUGEPAGE
+	/* Ask for transparent huge pages in case the explicit MAP_HUGETLB
+	 * attempts above could not be satisfied (typically because no pages are
+	 * reserved in the kernel pool). Large segments otherwise run on 4K pages
+	 * and take continuous dTLB miss pressure. The call is advice only: it
+	 * fails harmlessly on mappings that are already hugetlb backed, and for
+	 * shared anonymous memory it needs shmem THP enabled (see
+	 * /sys/kernel/mm/transparent_hugepage/shmem_enabled). */
+	if (requested_size >= 2 * 1024 * 1024) {
+		(void)madvise(p, requested_size, MADV_HUGEPAGE);
+	}
+#endif
 	*shared_segments_count = 1;
 	*shared_segments_p = (zend_shared_segment **) calloc(1, sizeof(zend_shared_segment) + sizeof(void *));
 	if (!*shared_segments_p) {
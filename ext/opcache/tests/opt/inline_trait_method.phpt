@@ -0,0 +1,43 @@
+--TEST--
+Constant-returning trait method calls are inlined in using classes
+--INI--
+opcache.enable=1
+opcache.enable_cli=1
+opcache.optimization_level=-1
+--FILE--
+<?php
+trait Defaults {
+    final public function limit() {
+        return 42;
+    }
+    private function label() {
+        return 'default';
+    }
+}
+class Config {
+    use Defaults;
+
+    public function describe() {
+        return $this->label() . ':' . $this->limit();
+    }
+    public static function staticLimit() {
+        return 42;
+    }
+}
+class Renamed {
+    use Defaults {
+        label as private tag;
+    }
+
+    public function describe() {
+        return $this->tag() . ':' . $this->limit();
+    }
+}
+var_dump((new Config)->describe());
+var_dump((new Renamed)->describe());
+var_dump((new Config)->limit());
+?>
+--EXPECT--
+string(10) "default:42"
+string(10) "default:42"
+int(42)
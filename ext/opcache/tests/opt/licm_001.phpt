@@ -0,0 +1,66 @@
+--TEST--
+LICM 001: Loop invariant computations keep their results when hoisted
+--INI--
+opcache.enable=1
+opcache.enable_cli=1
+opcache.optimization_level=-1
+opcache.preload=
+--EXTENSIONS--
+opcache
+--FILE--
+<?php
+function sum_scaled(array $a, int $m, int $n) {
+    $sum = 0;
+    for ($i = 0; $i < count($a); $i++) {
+        $sum += $a[$i] * ($m * $n);
+    }
+    return $sum;
+}
+
+function masked(int $x, int $y, int $n) {
+    $r = [];
+    for ($i = 0; $i < $n; $i++) {
+        $r[] = $i & ($x | $y);
+    }
+    return $r;
+}
+
+function typed($v, int $n) {
+    $c = 0;
+    while ($n-- > 0) {
+        if (is_int($v)) {
+            $c++;
+        }
+    }
+    return $c;
+}
+
+function zero_trip(string $s) {
+    $sum = 0;
+    for ($i = 0; $i < 0; $i++) {
+        $sum += strlen($s);
+    }
+    return $sum;
+}
+
+var_dump(sum_scaled([1, 2, 3], 2, 5));
+var_dump(masked(5, 3, 4));
+var_dump(typed(42, 3));
+var_dump(typed("s", 3));
+var_dump(zero_trip("abc"));
+?>
+--EXPECT--
+int(60)
+array(4) {
+  [0]=>
+  int(0)
+  [1]=>
+  int(1)
+  [2]=>
+  int(2)
+  [3]=>
+  int(3)
+}
+int(3)
+int(0)
+int(0)
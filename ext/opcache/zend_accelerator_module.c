@@ -275,6 +275,9 @@ ZEND_INI_BEGIN()
 	STD_PHP_INI_BOOLEAN("opcache.use_cwd"            , "1", PHP_INI_SYSTEM, OnUpdateBool, accel_directives.use_cwd            , zend_accel_globals, accel_globals)
 	STD_PHP_INI_BOOLEAN("opcache.validate_timestamps", "1", PHP_INI_ALL   , OnUpdateBool, accel_directives.validate_timestamps, zend_accel_globals, accel_globals)
 	STD_PHP_INI_BOOLEAN("opcache.validate_permission", "0", PHP_INI_SYSTEM, OnUpdateBool, accel_directives.validate_permission, zend_accel_globals, accel_globals)
+#ifdef HAVE_SYS_INOTIFY_H
+	STD_PHP_INI_BOOLEAN("opcache.file_watcher"       , "0", PHP_INI_SYSTEM, OnUpdateBool, accel_directives.file_watcher       , zend_accel_globals, accel_globals)
+#endif
 #ifndef ZEND_WIN32
 	STD_PHP_INI_BOOLEAN("opcache.validate_root"      , "0", PHP_INI_SYSTEM, OnUpdateBool, accel_directives.validate_root      , zend_accel_globals, accel_globals)
 #endif
@@ -288,6 +291,8 @@ ZEND_INI_BEGIN()
 	STD_PHP_INI_ENTRY("opcache.max_wasted_percentage" , "5"   , PHP_INI_SYSTEM, OnUpdateMaxWastedPercentage,	 accel_directives.max_wasted_percentage,     zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.force_restart_timeout" , "180" , PHP_INI_SYSTEM, OnUpdateLong,	             accel_directives.force_restart_timeout,     zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.revalidate_freq"       , "2"   , PHP_INI_ALL   , OnUpdateLong,	             accel_directives.revalidate_freq,           zend_accel_globals, accel_globals)
+	STD_PHP_INI_BOOLEAN("opcache.revalidate_batch"    , "0"   , PHP_INI_SYSTEM, OnUpdateBool,	             accel_directives.revalidate_batch,          zend_accel_globals, accel_globals)
+	STD_PHP_INI_BOOLEAN("opcache.graceful_reset"      , "0"   , PHP_INI_SYSTEM, OnUpdateBool,	             accel_directives.graceful_reset,            zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.file_update_protection", "2"   , PHP_INI_ALL   , OnUpdateLong,                accel_directives.file_update_protection,    zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.preferred_memory_model", ""    , PHP_INI_SYSTEM, OnUpdateStringUnempty,       accel_directives.memory_model,              zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.blacklist_filename"    , ""    , PHP_INI_SYSTEM, OnUpdateString,	             accel_directives.user_blacklist_filename,   zend_accel_globals, accel_globals)
@@ -296,6 +301,8 @@ ZEND_INI_BEGIN()
 	STD_PHP_INI_BOOLEAN("opcache.protect_memory"        , "0"  , PHP_INI_SYSTEM, OnUpdateBool,                  accel_directives.protect_memory,            zend_accel_globals, accel_globals)
 	STD_PHP_INI_BOOLEAN("opcache.save_comments"         , "1"  , PHP_INI_SYSTEM, OnUpdateBool,                  accel_directives.save_comments,             zend_accel_globals, accel_globals)
 	STD_PHP_INI_BOOLEAN("opcache.record_warnings"       , "0"  , PHP_INI_SYSTEM, OnUpdateBool,                  accel_directives.record_warnings,           zend_accel_globals, accel_globals)
+	STD_PHP_INI_BOOLEAN("opcache.autoload_index"        , "0"  , PHP_INI_SYSTEM, OnUpdateBool,                  accel_directives.autoload_index,            zend_accel_globals, accel_globals)
+	STD_PHP_INI_BOOLEAN("opcache.coverage"              , "0"  , PHP_INI_SYSTEM, OnUpdateBool,                  accel_directives.coverage,                  zend_accel_globals, accel_globals)
 
 	STD_PHP_INI_ENTRY("opcache.optimization_level"    , DEFAULT_OPTIMIZATION_LEVEL , PHP_INI_SYSTEM, OnUpdateLong, accel_directives.optimization_level,   zend_accel_globals, accel_globals)
 	STD_PHP_INI_ENTRY("opcache.opt_debug_level"       , "0"      , PHP_INI_SYSTEM, OnUpdateLong,             accel_directives.opt_debug_level,            zend_accel_globals, accel_globals)
@@ -329,6 +336,7 @@ ZEND_INI_BEGIN()
 #ifdef HAVE_JIT
 	STD_PHP_INI_ENTRY("opcache.jit"                           , "disable",                    PHP_INI_ALL,    OnUpdateJit,      options,               zend_jit_globals, jit_globals)
 	STD_PHP_INI_ENTRY("opcache.jit_buffer_size"               , ZEND_JIT_DEFAULT_BUFFER_SIZE, PHP_INI_SYSTEM, OnUpdateLong,     buffer_size,           zend_jit_globals, jit_globals)
+	STD_PHP_INI_ENTRY("opcache.jit_buffer_reset_threshold"    , "0",                          PHP_INI_SYSTEM, OnUpdateLong,     buffer_reset_threshold, zend_jit_globals, jit_globals)
 	STD_PHP_INI_ENTRY("opcache.jit_debug"                     , "0",                          PHP_INI_ALL,    OnUpdateJitDebug, debug,                 zend_jit_globals, jit_globals)
 	STD_PHP_INI_ENTRY("opcache.jit_bisect_limit"              , "0",                          PHP_INI_ALL,    OnUpdateLong,     bisect_limit,          zend_jit_globals, jit_globals)
 	STD_PHP_INI_ENTRY("opcache.jit_prof_threshold"            , "0.005",                      PHP_INI_ALL,    OnUpdateReal,     prof_threshold,        zend_jit_globals, jit_globals)
@@ -585,6 +593,43 @@ int start_accel_module(void)
 	return zend_startup_module(&accel_module_entry);
 }
 
+/* opcache.coverage: read the SHM execution counter hung off the op-array */
+static zend_long accel_coverage_read(const zend_op_array *op_array)
+{
+	zend_ulong *counter = (zend_ulong*)op_array->reserved[accel_coverage_reserved];
+
+	return counter ? (zend_long)*counter : 0;
+}
+
+static void accelerator_get_script_coverage(zval *report, zend_persistent_script *script)
+{
+	zval coverage;
+	zend_string *key;
+	zend_op_array *op_array;
+	zend_class_entry *ce;
+
+	array_init(&coverage);
+	add_assoc_long(&coverage, "{main}", accel_coverage_read(&script->script.main_op_array));
+	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(&script->script.function_table, key, op_array) {
+		add_assoc_long_ex(&coverage, ZSTR_VAL(key), ZSTR_LEN(key), accel_coverage_read(op_array));
+	} ZEND_HASH_FOREACH_END();
+	ZEND_HASH_MAP_FOREACH_PTR(&script->script.class_table, ce) {
+		zend_function *func;
+
+		ZEND_HASH_MAP_FOREACH_PTR(&ce->function_table, func) {
+			/* skip inherited methods; they are counted on the declaring class */
+			if (func->type == ZEND_USER_FUNCTION && func->common.scope == ce) {
+				zend_string *name = zend_string_concat3(
+					ZSTR_VAL(ce->name), ZSTR_LEN(ce->name), "::", 2,
+					ZSTR_VAL(func->common.function_name), ZSTR_LEN(func->common.function_name));
+				add_assoc_long_ex(&coverage, ZSTR_VAL(name), ZSTR_LEN(name), accel_coverage_read(&func->op_array));
+				zend_string_release_ex(name, 0);
+			}
+		} ZEND_HASH_FOREACH_END();
+	} ZEND_HASH_FOREACH_END();
+	add_assoc_zval(report, "coverage", &coverage);
+}
+
 /* {{{ Get the scripts which are accelerated by ZendAccelerator */
 static int accelerator_get_scripts(zval *return_value)
 {
@@ -628,6 +673,10 @@ static int accelerator_get_scripts(zval *return_value)
 
 			add_assoc_long(&persistent_script_report, "revalidate", (zend_long)script->dynamic_members.revalidate);
 
+			if (ZCG(accel_directives).coverage && accel_coverage_reserved >= 0) {
+				accelerator_get_script_coverage(&persistent_script_report, script);
+			}
+
 			zend_hash_update(Z_ARRVAL_P(return_value), cache_entry->key, &persistent_script_report);
 		}
 	}
@@ -688,6 +737,9 @@ ZEND_FUNCTION(opcache_get_status)
 		add_assoc_long(&interned_strings_usage, "used_memory", (char*)ZCSG(interned_strings).top - (char*)(accel_shared_globals + 1));
 		add_assoc_long(&interned_strings_usage, "free_memory", (char*)ZCSG(interned_strings).end - (char*)ZCSG(interned_strings).top);
 		add_assoc_long(&interned_strings_usage, "number_of_strings", ZCSG(interned_strings).nNumOfElements);
+		add_assoc_long(&interned_strings_usage, "overflow_strings", ZCSG(interned_strings_overflow_count));
+		add_assoc_long(&interned_strings_usage, "overflow_memory", ZCSG(interned_strings_overflow_mem));
+		add_assoc_long(&interned_strings_usage, "overflow_misses", ZCSG(interned_strings_overflow_misses));
 		add_assoc_zval(return_value, "interned_strings_usage", &interned_strings_usage);
 	}
 
@@ -748,6 +800,28 @@ ZEND_FUNCTION(opcache_get_status)
 				p++;
 			}
 			add_assoc_zval(&statistics, "scripts", &scripts);
+
+			if (ZCSG(saved_script_deps)) {
+				uint32_t i = 0;
+				zval deps;
+
+				/* preloaded file => files defining its parents/interfaces/traits */
+				array_init(&deps);
+				for (p = ZCSG(saved_scripts); *p; p++, i++) {
+					const uint32_t *d = ZCSG(saved_script_deps)[i];
+
+					if (d && *d) {
+						zval list;
+
+						array_init(&list);
+						for (; *d; d++) {
+							add_next_index_str(&list, ZCSG(saved_scripts)[*d - 1]->script.filename);
+						}
+						zend_hash_update(Z_ARRVAL(deps), (*p)->script.filename, &list);
+					}
+				}
+				add_assoc_zval(&statistics, "script_dependencies", &deps);
+			}
 		}
 		add_assoc_zval(return_value, "preload_statistics", &statistics);
 	}
@@ -804,6 +878,10 @@ ZEND_FUNCTION(opcache_get_configuration)
 	add_assoc_double(&directives, "opcache.max_wasted_percentage",  ZCG(accel_directives).max_wasted_percentage);
 	add_assoc_long(&directives, 	 "opcache.force_restart_timeout",  ZCG(accel_directives).force_restart_timeout);
 	add_assoc_long(&directives, 	 "opcache.revalidate_freq",        ZCG(accel_directives).revalidate_freq);
+	add_assoc_bool(&directives, 	 "opcache.revalidate_batch",       ZCG(accel_directives).revalidate_batch);
+#ifdef HAVE_SYS_INOTIFY_H
+	add_assoc_bool(&directives, 	 "opcache.file_watcher",           ZCG(accel_directives).file_watcher);
+#endif
 	add_assoc_string(&directives, "opcache.preferred_memory_model", STRING_NOT_NULL(ZCG(accel_directives).memory_model));
 	add_assoc_string(&directives, "opcache.blacklist_filename",     STRING_NOT_NULL(ZCG(accel_directives).user_blacklist_filename));
 	add_assoc_long(&directives,   "opcache.max_file_size",          ZCG(accel_directives).max_file_size);
@@ -812,6 +890,7 @@ ZEND_FUNCTION(opcache_get_configuration)
 	add_assoc_bool(&directives,   "opcache.protect_memory",         ZCG(accel_directives).protect_memory);
 	add_assoc_bool(&directives,   "opcache.save_comments",          ZCG(accel_directives).save_comments);
 	add_assoc_bool(&directives,   "opcache.record_warnings",        ZCG(accel_directives).record_warnings);
+	add_assoc_bool(&directives,   "opcache.autoload_index",         ZCG(accel_directives).autoload_index);
 	add_assoc_bool(&directives,   "opcache.enable_file_override",   ZCG(accel_directives).file_override_enabled);
 	add_assoc_long(&directives, 	 "opcache.optimization_level",     ZCG(accel_directives).optimization_level);
 
@@ -844,6 +923,7 @@ ZEND_FUNCTION(opcache_get_configuration)
 #ifdef HAVE_JIT
 	add_assoc_string(&directives, "opcache.jit", JIT_G(options));
 	add_assoc_long(&directives,   "opcache.jit_buffer_size", JIT_G(buffer_size));
+	add_assoc_long(&directives,   "opcache.jit_buffer_reset_threshold", JIT_G(buffer_reset_threshold));
 	add_assoc_long(&directives,   "opcache.jit_debug", JIT_G(debug));
 	add_assoc_long(&directives,   "opcache.jit_bisect_limit", JIT_G(bisect_limit));
 	add_assoc_long(&directives,   "opcache.jit_blacklist_root_trace", JIT_G(blacklist_root_trace));
@@ -896,6 +976,13 @@ ZEND_FUNCTION(opcache_reset)
 		RETURN_FALSE;
 	}
 
+	if (ZCG(accel_directives).graceful_reset) {
+		/* discard all scripts in place and let them recompile on demand,
+		 * instead of wiping SHM and stampeding every worker at once */
+		zend_accel_invalidate_all();
+		RETURN_TRUE;
+	}
+
 	/* exclusive lock */
 	zend_shared_alloc_lock();
 	zend_accel_schedule_restart(ACCEL_RESTART_USER);
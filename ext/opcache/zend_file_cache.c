@@ -56,6 +56,11 @@
 # include <sys/file.h>
 #endif
 
+#if defined(HAVE_MMAP) && !defined(ZEND_WIN32)
+# include <sys/mman.h>
+# define ZEND_FILE_CACHE_MMAP 1
+#endif
+
 #if __has_feature(memory_sanitizer)
 # include <sanitizer/msan_interface.h>
 #endif
@@ -199,6 +204,17 @@ typedef struct _zend_file_cache_metainfo {
 	uint32_t     checksum;
 } zend_file_cache_metainfo;
 
+#ifdef ZEND_FILE_CACHE_MMAP
+/* Copy-on-write mapping backing a script loaded with opcache.file_cache_only.
+ * Mappings live until the end of the request (the loaded script may be in use
+ * until then) and are torn down in zend_file_cache_deactivate(). */
+typedef struct _zend_file_cache_mapping {
+	struct _zend_file_cache_mapping *next;
+	void   *addr;
+	size_t  len;
+} zend_file_cache_mapping;
+#endif
+
 static int zend_file_cache_mkdir(char *filename, size_t start)
 {
 	char *s = filename + start;
@@ -463,6 +479,12 @@ static void zend_file_cache_serialize_op_array(zend_op_array            *op_arra
 	ZEND_MAP_PTR_INIT(op_array->static_variables_ptr, NULL);
 	ZEND_MAP_PTR_INIT(op_array->run_time_cache, NULL);
 
+	if (accel_coverage_reserved >= 0) {
+		/* The opcache.coverage counter points into this cache's SHM block;
+		 * a copy loaded from the file cache must not inherit it. */
+		op_array->reserved[accel_coverage_reserved] = NULL;
+	}
+
 	/* Check whether this op_array has already been serialized. */
 	if (IS_SERIALIZED(op_array->opcodes)) {
 		ZEND_ASSERT(op_array->scope && "Only method op_arrays should be shared");
@@ -784,6 +806,19 @@ static void zend_file_cache_serialize_class(zval                     *zv,
 		}
 	}
 
+	if (ce->ancestors) {
+		uint32_t i;
+		zend_class_entry **ancestors;
+
+		SERIALIZE_PTR(ce->ancestors);
+		ancestors = ce->ancestors;
+		UNSERIALIZE_PTR(ancestors);
+
+		for (i = 0; i < ce->num_ancestors; i++) {
+			SERIALIZE_PTR(ancestors[i]);
+		}
+	}
+
 	if (ce->num_traits) {
 		uint32_t i;
 		zend_class_name *trait_names;
@@ -1618,6 +1653,16 @@ static void zend_file_cache_unserialize_class(zval                    *zv,
 		}
 	}
 
+	if (ce->ancestors) {
+		uint32_t i;
+
+		UNSERIALIZE_PTR(ce->ancestors);
+
+		for (i = 0; i < ce->num_ancestors; i++) {
+			UNSERIALIZE_PTR(ce->ancestors[i]);
+		}
+	}
+
 	if (ce->num_traits) {
 		uint32_t i;
 
@@ -1838,22 +1883,50 @@ zend_persistent_script *zend_file_cache_script_load(zend_file_handle *file_handl
 	}
 
 	checkpoint = zend_arena_checkpoint(CG(arena));
+#ifdef ZEND_FILE_CACHE_MMAP
+	mem = NULL;
+	if (file_cache_only) {
+		/* The script is going to stay in process memory anyway, so map the
+		 * payload copy-on-write instead of reading it into the compiler
+		 * arena.  The pointer fixup pass only dirties the pages it touches;
+		 * untouched pages (most of the string region) remain backed by the
+		 * page cache and are shared between workers. */
+		size_t map_len = sizeof(info) + info.mem_size + info.str_size;
+		zend_stat_t st;
+		void *map;
+
+		if (zend_fstat(fd, &st) == 0
+		 && (size_t)st.st_size >= map_len
+		 && (map = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)) != MAP_FAILED) {
+			zend_file_cache_mapping *mapping = emalloc(sizeof(zend_file_cache_mapping));
+
+			mapping->addr = map;
+			mapping->len = map_len;
+			mapping->next = (zend_file_cache_mapping*)ZCG(file_cache_mappings);
+			ZCG(file_cache_mappings) = mapping;
+			mem = (char*)map + sizeof(info);
+		}
+	}
+	if (!mem)
+#endif
+	{
 #if defined(__AVX__) || defined(__SSE2__)
-	/* Align to 64-byte boundary */
-	mem = zend_arena_alloc(&CG(arena), info.mem_size + info.str_size + 64);
-	mem = (void*)(((uintptr_t)mem + 63L) & ~63L);
+		/* Align to 64-byte boundary */
+		mem = zend_arena_alloc(&CG(arena), info.mem_size + info.str_size + 64);
+		mem = (void*)(((uintptr_t)mem + 63L) & ~63L);
 #else
-	mem = zend_arena_alloc(&CG(arena), info.mem_size + info.str_size);
+		mem = zend_arena_alloc(&CG(arena), info.mem_size + info.str_size);
 #endif
 
-	if (read(fd, mem, info.mem_size + info.str_size) != (ssize_t)(info.mem_size + info.str_size)) {
-		zend_accel_error(ACCEL_LOG_WARNING, "opcache cannot read from file '%s' (mem)\n", filename);
-		zend_file_cache_flock(fd, LOCK_UN);
-		close(fd);
-		zend_file_cache_unlink(filename);
-		zend_arena_release(&CG(arena), checkpoint);
-		efree(filename);
-		return NULL;
+		if (read(fd, mem, info.mem_size + info.str_size) != (ssize_t)(info.mem_size + info.str_size)) {
+			zend_accel_error(ACCEL_LOG_WARNING, "opcache cannot read from file '%s' (mem)\n", filename);
+			zend_file_cache_flock(fd, LOCK_UN);
+			close(fd);
+			zend_file_cache_unlink(filename);
+			zend_arena_release(&CG(arena), checkpoint);
+			efree(filename);
+			return NULL;
+		}
 	}
 	if (zend_file_cache_flock(fd, LOCK_UN) != 0) {
 		zend_accel_error(ACCEL_LOG_WARNING, "opcache cannot unlock file '%s'\n", filename);
@@ -1954,6 +2027,22 @@ use_process_mem:
 	return script;
 }
 
+void zend_file_cache_deactivate(void)
+{
+#ifdef ZEND_FILE_CACHE_MMAP
+	zend_file_cache_mapping *mapping = (zend_file_cache_mapping*)ZCG(file_cache_mappings);
+
+	while (mapping) {
+		zend_file_cache_mapping *next = mapping->next;
+
+		munmap(mapping->addr, mapping->len);
+		efree(mapping);
+		mapping = next;
+	}
+	ZCG(file_cache_mappings) = NULL;
+#endif
+}
+
 void zend_file_cache_invalidate(zend_string *full_path)
 {
 	char *filename;
@@ -21,6 +21,7 @@
 
 int zend_file_cache_script_store(zend_persistent_script *script, bool in_shm);
 zend_persistent_script *zend_file_cache_script_load(zend_file_handle *file_handle);
+void zend_file_cache_deactivate(void);
 void zend_file_cache_invalidate(zend_string *full_path);
 
 #endif /* ZEND_FILE_CACHE_H */
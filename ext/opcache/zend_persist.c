@@ -89,6 +89,182 @@ static void zend_persist_op_array(zval *zv);
 static const uint32_t uninitialized_bucket[-HT_MIN_MASK] =
 	{HT_INVALID_IDX, HT_INVALID_IDX};
 
+/* Deduplication of constant arrays across persisted scripts.
+ *
+ * Literal tables, attribute arguments and default values repeat the same
+ * immutable arrays in script after script.  Scripts stored in SHM are only
+ * freed wholesale on a restart, so once such an array has been persisted it
+ * can simply be referenced from later scripts.  ZCG(const_array_index) maps
+ * a content hash to the SHM copy.  Arrays persisted for the current script
+ * are staged in ZCG(const_array_staged) and merged into the index only after
+ * the whole script has been stored: the size pass in zend_persist_calc.c ran
+ * before any of this script's arrays existed in SHM, and extending the index
+ * mid-script would make the two passes disagree about the script size. */
+
+static bool zend_accel_const_array_hash_ex(HashTable *ht, zend_ulong *hash);
+
+static bool zend_accel_const_zval_hash(zval *z, zend_ulong *hash)
+{
+	zend_ulong h = *hash * 33 + Z_TYPE_P(z);
+
+	switch (Z_TYPE_P(z)) {
+		case IS_UNDEF:
+		case IS_NULL:
+		case IS_FALSE:
+		case IS_TRUE:
+			break;
+		case IS_LONG:
+			h = h * 33 + (zend_ulong)Z_LVAL_P(z);
+			break;
+		case IS_DOUBLE: {
+			uint64_t bits;
+			memcpy(&bits, &Z_DVAL_P(z), sizeof(bits));
+			h = h * 33 + (zend_ulong)bits;
+			break;
+		}
+		case IS_STRING:
+			h = h * 33 + zend_string_hash_val(Z_STR_P(z));
+			break;
+		case IS_ARRAY:
+			/* An xlat entry means this nested array was (or is counted
+			 * as) persisted through another reference; the original may
+			 * already be freed, so don't look at its contents */
+			if (zend_shared_alloc_get_xlat_entry(Z_ARRVAL_P(z))
+			 || !zend_accel_const_array_hash_ex(Z_ARRVAL_P(z), &h)) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+	}
+	*hash = h;
+	return true;
+}
+
+static bool zend_accel_const_array_hash_ex(HashTable *ht, zend_ulong *hash)
+{
+	zend_ulong h = *hash * 33 + ht->nNumOfElements * 2 + HT_IS_PACKED(ht);
+	uint32_t idx;
+
+	h = h * 33 + (zend_ulong)ht->nNextFreeElement;
+	if (HT_IS_PACKED(ht)) {
+		for (idx = 0; idx < ht->nNumUsed; idx++) {
+			if (!zend_accel_const_zval_hash(ht->arPacked + idx, &h)) {
+				return false;
+			}
+		}
+	} else {
+		for (idx = 0; idx < ht->nNumUsed; idx++) {
+			Bucket *p = ht->arData + idx;
+
+			if (Z_TYPE(p->val) != IS_UNDEF) {
+				h = h * 33 + (p->key ? zend_string_hash_val(p->key) : p->h);
+			}
+			if (!zend_accel_const_zval_hash(&p->val, &h)) {
+				return false;
+			}
+		}
+	}
+	*hash = h;
+	return true;
+}
+
+bool zend_accel_const_array_hash(HashTable *ht, zend_ulong *hash)
+{
+	if (ZCG(current_persistent_script)->corrupted
+	 || ZCG(accel_directives).file_cache) {
+		/* The file cache serializer cannot represent pointers into
+		 * another script's SHM block */
+		return false;
+	}
+	*hash = 0;
+	return zend_accel_const_array_hash_ex(ht, hash);
+}
+
+static bool zend_accel_const_zval_identical(zval *a, zval *b);
+
+static bool zend_accel_const_array_identical(HashTable *a, HashTable *b)
+{
+	uint32_t idx;
+
+	if (a->nNumOfElements != b->nNumOfElements
+	 || a->nNumUsed != b->nNumUsed
+	 || a->nNextFreeElement != b->nNextFreeElement
+	 || HT_IS_PACKED(a) != HT_IS_PACKED(b)) {
+		return false;
+	}
+	if (HT_IS_PACKED(a)) {
+		for (idx = 0; idx < a->nNumUsed; idx++) {
+			if (!zend_accel_const_zval_identical(a->arPacked + idx, b->arPacked + idx)) {
+				return false;
+			}
+		}
+	} else {
+		for (idx = 0; idx < a->nNumUsed; idx++) {
+			Bucket *p = a->arData + idx;
+			Bucket *q = b->arData + idx;
+
+			if (Z_TYPE(p->val) != IS_UNDEF
+			 && (p->h != q->h
+			  || !p->key != !q->key
+			  || (p->key && !zend_string_equals(p->key, q->key)))) {
+				return false;
+			}
+			if (!zend_accel_const_zval_identical(&p->val, &q->val)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool zend_accel_const_zval_identical(zval *a, zval *b)
+{
+	if (Z_TYPE_P(a) != Z_TYPE_P(b)) {
+		return false;
+	}
+	switch (Z_TYPE_P(a)) {
+		case IS_UNDEF:
+		case IS_NULL:
+		case IS_FALSE:
+		case IS_TRUE:
+			return true;
+		case IS_LONG:
+			return Z_LVAL_P(a) == Z_LVAL_P(b);
+		case IS_DOUBLE:
+			/* bitwise, so 0.0 and -0.0 stay distinct and NaNs compare
+			 * reliably */
+			return memcmp(&Z_DVAL_P(a), &Z_DVAL_P(b), sizeof(double)) == 0;
+		case IS_STRING:
+			return zend_string_equals(Z_STR_P(a), Z_STR_P(b));
+		case IS_ARRAY:
+			return zend_accel_const_array_identical(Z_ARRVAL_P(a), Z_ARRVAL_P(b));
+		default:
+			return false;
+	}
+}
+
+HashTable *zend_accel_const_array_find(HashTable *ht, zend_ulong hash)
+{
+	HashTable *cached = zend_hash_index_find_ptr(&ZCG(const_array_index), hash);
+
+	if (cached && zend_accel_const_array_identical(ht, cached)) {
+		return cached;
+	}
+	return NULL;
+}
+
+static void zend_accel_const_arrays_commit(void)
+{
+	zend_ulong hash;
+	void *ht;
+
+	ZEND_HASH_FOREACH_NUM_KEY_PTR(&ZCG(const_array_staged), hash, ht) {
+		zend_hash_index_add_ptr(&ZCG(const_array_index), hash, ht);
+	} ZEND_HASH_FOREACH_END();
+	zend_hash_clean(&ZCG(const_array_staged));
+}
+
 static void zend_hash_persist(HashTable *ht)
 {
 	uint32_t idx, nIndex;
@@ -218,6 +394,23 @@ static void zend_persist_zval(zval *z)
 				/* pass */
 			} else {
 				HashTable *ht;
+				zend_ulong dedup_hash;
+				bool dedupable = zend_accel_const_array_hash(Z_ARR_P(z), &dedup_hash);
+
+				if (dedupable
+				 && (ht = zend_accel_const_array_find(Z_ARR_P(z), dedup_hash))) {
+					/* An identical array was already persisted by an
+					 * earlier script; SHM scripts are only freed
+					 * wholesale, so the reference stays valid */
+					zend_shared_alloc_register_xlat_entry(Z_ARR_P(z), ht);
+					if (Z_REFCOUNTED_P(z)) {
+						GC_REMOVE_FROM_BUFFER(Z_ARR_P(z));
+						zend_array_destroy(Z_ARR_P(z));
+					}
+					Z_ARR_P(z) = ht;
+					Z_TYPE_FLAGS_P(z) = 0;
+					break;
+				}
 
 				if (!Z_REFCOUNTED_P(z)) {
 					ht = zend_shared_memdup_put(Z_ARR_P(z), sizeof(zend_array));
@@ -247,6 +440,9 @@ static void zend_persist_zval(zval *z)
 				Z_TYPE_FLAGS_P(z) = 0;
 				GC_SET_REFCOUNT(Z_COUNTED_P(z), 2);
 				GC_ADD_FLAGS(Z_COUNTED_P(z), IS_ARRAY_IMMUTABLE);
+				if (dedupable) {
+					zend_hash_index_add_ptr(&ZCG(const_array_staged), dedup_hash, ht);
+				}
 			}
 			break;
 		case IS_CONSTANT_AST:
@@ -368,6 +564,21 @@ static void zend_persist_type(zend_type *type) {
 	} ZEND_TYPE_FOREACH_END();
 }
 
+/* opcache.coverage: carve the per-function execution counter out of the
+ * persist buffer, so it lands in SHM next to the op-array and survives for
+ * the lifetime of the cached script.  Must stay in sync with the matching
+ * size accounting in zend_persist_calc.c. */
+static void zend_persist_coverage_counter(zend_op_array *op_array)
+{
+	if (ZCG(accel_directives).coverage && accel_coverage_reserved >= 0) {
+		zend_ulong *counter = (zend_ulong*)ZCG(mem);
+
+		ZCG(mem) = (void*)((char*)ZCG(mem) + ZEND_ALIGNED_SIZE(sizeof(zend_ulong)));
+		*counter = 0;
+		op_array->reserved[accel_coverage_reserved] = counter;
+	}
+}
+
 static void zend_persist_op_array_ex(zend_op_array *op_array, zend_persistent_script* main_persistent_script)
 {
 	zend_op *persist_ptr;
@@ -474,6 +685,7 @@ static void zend_persist_op_array_ex(zend_op_array *op_array, zend_persistent_sc
 				ZEND_ASSERT(op_array->dynamic_func_defs != NULL);
 			}
 			ZCG(mem) = (void*)((char*)ZCG(mem) + ZEND_ALIGNED_SIZE(zend_extensions_op_array_persist(op_array, ZCG(mem))));
+			zend_persist_coverage_counter(op_array);
 			return;
 		}
 	} else {
@@ -673,6 +885,7 @@ static void zend_persist_op_array_ex(zend_op_array *op_array, zend_persistent_sc
 	}
 
 	ZCG(mem) = (void*)((char*)ZCG(mem) + ZEND_ALIGNED_SIZE(zend_extensions_op_array_persist(op_array, ZCG(mem))));
+	zend_persist_coverage_counter(op_array);
 }
 
 static void zend_persist_op_array(zval *zv)
@@ -1120,6 +1333,20 @@ void zend_update_parent_ce(zend_class_entry *ce)
 			}
 		}
 
+		if (ce->ancestors) {
+			uint32_t i = 0;
+
+			ce->ancestors = zend_shared_memdup_free(ce->ancestors, sizeof(zend_class_entry*) * ce->num_ancestors);
+			for (i = 0; i < ce->num_ancestors; i++) {
+				if (ce->ancestors[i]->type == ZEND_USER_CLASS) {
+					zend_class_entry *tmp = zend_shared_alloc_get_xlat_entry(ce->ancestors[i]);
+					if (tmp != NULL) {
+						ce->ancestors[i] = tmp;
+					}
+				}
+			}
+		}
+
 		if (ce->iterator_funcs_ptr) {
 			memset(ce->iterator_funcs_ptr, 0, sizeof(zend_class_iterator_funcs));
 			if (zend_class_implements_interface(ce, zend_ce_aggregate)) {
@@ -1390,6 +1617,8 @@ zend_persistent_script *zend_accel_script_persist(zend_persistent_script *script
 	}
 #endif
 
+	zend_accel_const_arrays_commit();
+
 	script->corrupted = false;
 	ZCG(current_persistent_script) = NULL;
 
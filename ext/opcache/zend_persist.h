@@ -27,6 +27,9 @@ BEGIN_EXTERN_C()
 uint32_t zend_accel_script_persist_calc(zend_persistent_script *script, int for_shm);
 zend_persistent_script *zend_accel_script_persist(zend_persistent_script *script, int for_shm);
 
+bool zend_accel_const_array_hash(HashTable *ht, zend_ulong *hash);
+HashTable *zend_accel_const_array_find(HashTable *ht, zend_ulong hash);
+
 void zend_persist_class_entry_calc(zend_class_entry *ce);
 zend_class_entry *zend_persist_class_entry(zend_class_entry *ce);
 void zend_update_parent_ce(zend_class_entry *ce);
@@ -27,6 +27,7 @@
 #include "zend_operators.h"
 #include "zend_attributes.h"
 #include "zend_constants.h"
+#include "zend_inheritance.h"
 
 #define ADD_DUP_SIZE(m,s)  ZCG(current_persistent_script)->size += zend_shared_memdup_size((void*)m, s)
 #define ADD_SIZE(m)        ZCG(current_persistent_script)->size += ZEND_ALIGNED_SIZE(m)
@@ -113,6 +114,21 @@ static void zend_persist_zval_calc(zval *z)
 			 && zend_accel_in_shm(Z_ARR_P(z))) {
 				return;
 			}
+			if (!zend_shared_alloc_get_xlat_entry(Z_ARR_P(z))) {
+				zend_ulong dedup_hash;
+
+				if (zend_accel_const_array_hash(Z_ARR_P(z), &dedup_hash)
+				 && zend_accel_const_array_find(Z_ARR_P(z), dedup_hash)) {
+					/* identical array already persisted by an earlier
+					 * script; the persist pass will reference it instead
+					 * of storing a new copy, so count nothing.  Register
+					 * the pointer so further references and enclosing
+					 * arrays see the same decision the persist pass will
+					 * make. */
+					zend_shared_alloc_register_xlat_entry(Z_ARR_P(z), Z_ARR_P(z));
+					return;
+				}
+			}
 			size = zend_shared_memdup_size(Z_ARR_P(z), sizeof(zend_array));
 			if (size) {
 				HashTable *ht = Z_ARRVAL_P(z);
@@ -200,6 +216,15 @@ static void zend_persist_type_calc(zend_type *type)
 	} ZEND_TYPE_FOREACH_END();
 }
 
+/* Size of the opcache.coverage execution counter allocated by
+ * zend_persist_coverage_counter() in zend_persist.c */
+static void zend_persist_coverage_counter_calc(void)
+{
+	if (ZCG(accel_directives).coverage && accel_coverage_reserved >= 0) {
+		ADD_SIZE(ZEND_ALIGNED_SIZE(sizeof(zend_ulong)));
+	}
+}
+
 static void zend_persist_op_array_calc_ex(zend_op_array *op_array)
 {
 	if (op_array->function_name) {
@@ -216,6 +241,7 @@ static void zend_persist_op_array_calc_ex(zend_op_array *op_array)
 		if (zend_shared_alloc_get_xlat_entry(op_array->opcodes)) {
 			/* already stored */
 			ADD_SIZE(ZEND_ALIGNED_SIZE(zend_extensions_op_array_persist_calc(op_array)));
+			zend_persist_coverage_counter_calc();
 			return;
 		}
 	}
@@ -314,6 +340,7 @@ static void zend_persist_op_array_calc_ex(zend_op_array *op_array)
 	}
 
 	ADD_SIZE(ZEND_ALIGNED_SIZE(zend_extensions_op_array_persist_calc(op_array)));
+	zend_persist_coverage_counter_calc();
 }
 
 static void zend_persist_op_array_calc(zval *zv)
@@ -470,6 +497,13 @@ void zend_persist_class_entry_calc(zend_class_entry *ce)
 			}
 		} ZEND_HASH_FOREACH_END();
 
+		/* Linking defers building the properties info table; the class
+		 * becomes immutable once persisted, so materialize it now. */
+		if (!ce->properties_info_table
+		 && ce->default_properties_count
+		 && (ce->ce_flags & (ZEND_ACC_LINKED|ZEND_ACC_NEARLY_LINKED))) {
+			zend_build_properties_info_table(ce);
+		}
 		if (ce->properties_info_table) {
 			ADD_SIZE(sizeof(zend_property_info *) * ce->default_properties_count);
 		}
@@ -478,6 +512,10 @@ void zend_persist_class_entry_calc(zend_class_entry *ce)
 			ADD_SIZE(sizeof(zend_class_entry*) * ce->num_interfaces);
 		}
 
+		if (ce->ancestors) {
+			ADD_SIZE(sizeof(zend_class_entry*) * ce->num_ancestors);
+		}
+
 		if (ce->iterator_funcs_ptr) {
 			ADD_SIZE(sizeof(zend_class_iterator_funcs));
 		}
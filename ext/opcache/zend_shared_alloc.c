@@ -29,6 +29,10 @@
 #include <errno.h>
 #include "ZendAccelerator.h"
 #include "zend_shared_alloc.h"
+#include "zend_system_id.h"
+#ifdef HAVE_DTRACE
+# include <sys/sdt.h>
+#endif
 #ifdef HAVE_UNISTD_H
 # include <unistd.h>
 #endif
@@ -478,6 +482,10 @@ void zend_shared_alloc_lock(void)
 {
 	ZEND_ASSERT(!ZCG(locked));
 
+#ifdef HAVE_DTRACE
+	DTRACE_PROBE(php, opcache__lock__wait__begin);
+#endif
+
 #ifndef ZEND_WIN32
 	struct flock mem_write_lock;
 
@@ -510,6 +518,10 @@ void zend_shared_alloc_lock(void)
 	zend_shared_alloc_lock_win32();
 #endif
 
+#ifdef HAVE_DTRACE
+	DTRACE_PROBE(php, opcache__lock__wait__end);
+#endif
+
 	ZCG(locked) = 1;
 }
 
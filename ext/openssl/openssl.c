@@ -1239,6 +1239,7 @@ static const EVP_CIPHER * php_openssl_get_evp_cipher_from_algo(zend_long algo) {
 PHP_INI_BEGIN()
 	PHP_INI_ENTRY("openssl.cafile", NULL, PHP_INI_PERDIR, NULL)
 	PHP_INI_ENTRY("openssl.capath", NULL, PHP_INI_PERDIR, NULL)
+	STD_PHP_INI_ENTRY("openssl.session_cache_size", "0", PHP_INI_SYSTEM, OnUpdateLong, session_cache_size, zend_openssl_globals, openssl_globals)
 PHP_INI_END()
 /* }}} */
 
@@ -1334,6 +1335,8 @@ PHP_MINIT_FUNCTION(openssl)
 
 	REGISTER_INI_ENTRIES();
 
+	php_openssl_init_session_cache();
+
 	return SUCCESS;
 }
 /* }}} */
@@ -1409,6 +1412,8 @@ PHP_MSHUTDOWN_FUNCTION(openssl)
 	/* reinstate the default tcp handler */
 	php_stream_xport_register("tcp", php_stream_generic_socket_factory);
 
+	php_openssl_shutdown_session_cache();
+
 	UNREGISTER_INI_ENTRIES();
 
 	return SUCCESS;
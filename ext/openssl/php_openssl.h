@@ -79,6 +79,7 @@ struct php_openssl_errors {
 ZEND_BEGIN_MODULE_GLOBALS(openssl)
 	struct php_openssl_errors *errors;
 	struct php_openssl_errors *errors_mark;
+	zend_long session_cache_size;
 ZEND_END_MODULE_GLOBALS(openssl)
 
 #define OPENSSL_G(v) ZEND_MODULE_GLOBALS_ACCESSOR(openssl, v)
@@ -89,6 +90,10 @@ ZEND_TSRMLS_CACHE_EXTERN();
 
 php_stream_transport_factory_func php_openssl_ssl_socket_factory;
 
+/* Shared TLS client session cache (xp_ssl.c); created before workers fork. */
+void php_openssl_init_session_cache(void);
+void php_openssl_shutdown_session_cache(void);
+
 void php_openssl_store_errors(void);
 
 /* openssl file path extra */
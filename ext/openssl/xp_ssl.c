@@ -55,6 +55,17 @@
 #include <arpa/inet.h>
 #endif
 
+#if defined(HAVE_MMAP) && !defined(PHP_WIN32)
+#include <sys/mman.h>
+#include <sched.h>
+#ifndef MAP_ANONYMOUS
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+#define PHP_OPENSSL_SESSION_CACHE 1
+#endif
+
+ZEND_EXTERN_MODULE_GLOBALS(openssl)
+
 /* Flags for determining allowed stream crypto methods */
 #define STREAM_CRYPTO_IS_CLIENT            (1<<0)
 #define STREAM_CRYPTO_METHOD_SSLv2         (1<<1)
@@ -204,10 +215,230 @@ typedef struct _php_openssl_netstream_data_t {
 	php_openssl_alpn_ctx alpn_ctx;
 #endif
 	char *url_name;
+	char *conn_name;	/* full resource name; base of the session cache key */
+	char *session_key;	/* shared TLS session cache key, built before the handshake */
 	unsigned state_set:1;
 	unsigned _spare:31;
 } php_openssl_netstream_data_t;
 
+#ifdef PHP_OPENSSL_SESSION_CACHE
+/* Shared TLS client session cache.
+ *
+ * One anonymous shared mapping, created at MINIT in the parent process so
+ * all forked workers (FPM children) inherit it, holds a direct-mapped table
+ * of serialized SSL_SESSIONs keyed by resource name, SNI name and peer
+ * verification mode. A new entry simply overwrites the slot its key hashes
+ * to; per-slot spinlocks make reads and writes consistent. Repeated
+ * outbound TLS connections to the same endpoint then resume instead of
+ * performing a full handshake, from any worker. */
+
+#define PHP_OPENSSL_SESSION_KEY_MAX	256
+#define PHP_OPENSSL_SESSION_DATA_MAX	4096
+
+typedef struct {
+	uint32_t lock;
+	uint32_t keylen;
+	uint32_t datalen;	/* zero while the slot is empty */
+	char key[PHP_OPENSSL_SESSION_KEY_MAX];
+	unsigned char data[PHP_OPENSSL_SESSION_DATA_MAX];
+} php_openssl_session_slot;
+
+typedef struct {
+	uint32_t nslots;
+	pid_t owner;
+	php_openssl_session_slot slots[1];
+} php_openssl_session_cache_t;
+
+static php_openssl_session_cache_t *php_openssl_session_cache = NULL;
+static size_t php_openssl_session_cache_bytes = 0;
+
+static zend_always_inline void php_openssl_session_slot_lock(volatile uint32_t *lock)
+{
+	while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE)) {
+		sched_yield();
+	}
+}
+
+static zend_always_inline void php_openssl_session_slot_unlock(volatile uint32_t *lock)
+{
+	__atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+static php_openssl_session_slot *php_openssl_session_slot_for(const char *key, size_t keylen)
+{
+	uint32_t h = 2166136261U;
+	size_t i;
+
+	for (i = 0; i < keylen; i++) {
+		h *= 16777619;
+		h ^= (unsigned char)key[i];
+	}
+
+	return &php_openssl_session_cache->slots[h % php_openssl_session_cache->nslots];
+}
+
+static void php_openssl_session_cache_put(const char *key, SSL_SESSION *sess)
+{
+	size_t keylen = strlen(key);
+	unsigned char data[PHP_OPENSSL_SESSION_DATA_MAX], *p = data;
+	php_openssl_session_slot *slot;
+	int datalen;
+
+	datalen = i2d_SSL_SESSION(sess, NULL);
+	if (keylen > PHP_OPENSSL_SESSION_KEY_MAX
+			|| datalen <= 0 || datalen > PHP_OPENSSL_SESSION_DATA_MAX) {
+		return;
+	}
+	i2d_SSL_SESSION(sess, &p);
+
+	slot = php_openssl_session_slot_for(key, keylen);
+	php_openssl_session_slot_lock(&slot->lock);
+	slot->keylen = (uint32_t)keylen;
+	slot->datalen = (uint32_t)datalen;
+	memcpy(slot->key, key, keylen);
+	memcpy(slot->data, data, datalen);
+	php_openssl_session_slot_unlock(&slot->lock);
+}
+
+static SSL_SESSION *php_openssl_session_cache_get(const char *key)
+{
+	size_t keylen = strlen(key);
+	unsigned char data[PHP_OPENSSL_SESSION_DATA_MAX];
+	const unsigned char *p = data;
+	php_openssl_session_slot *slot;
+	uint32_t datalen = 0;
+	SSL_SESSION *sess;
+
+	if (keylen > PHP_OPENSSL_SESSION_KEY_MAX) {
+		return NULL;
+	}
+
+	slot = php_openssl_session_slot_for(key, keylen);
+	php_openssl_session_slot_lock(&slot->lock);
+	if (slot->datalen != 0 && slot->keylen == keylen && memcmp(slot->key, key, keylen) == 0) {
+		datalen = slot->datalen;
+		memcpy(data, slot->data, datalen);
+	}
+	php_openssl_session_slot_unlock(&slot->lock);
+
+	if (datalen == 0) {
+		return NULL;
+	}
+
+	sess = d2i_SSL_SESSION(NULL, &p, datalen);
+	if (sess && SSL_SESSION_get_time(sess) + SSL_SESSION_get_timeout(sess) < time(NULL)) {
+		/* Expired by the server's own lifetime; force a full handshake. */
+		SSL_SESSION_free(sess);
+		return NULL;
+	}
+
+	return sess;
+}
+
+/* SSL_CTX new-session callback; with TLS 1.3 the ticket arrives after the
+ * handshake, so this may fire from a later read as well. */
+static int php_openssl_shared_session_new_cb(SSL *ssl, SSL_SESSION *sess)
+{
+	php_stream *stream = (php_stream*)SSL_get_ex_data(ssl, php_openssl_get_ssl_stream_data_index());
+
+	if (stream) {
+		php_openssl_netstream_data_t *sslsock = (php_openssl_netstream_data_t*)stream->abstract;
+
+		if (sslsock->session_key) {
+			php_openssl_session_cache_put(sslsock->session_key, sess);
+		}
+	}
+
+	return 0;	/* we keep no reference to the session */
+}
+
+/* The key must separate endpoints that would verify the peer differently:
+ * resuming a session cached without peer verification would otherwise skip
+ * certificate checks for a stream that requested them. */
+static void php_openssl_build_session_key(php_stream *stream, php_openssl_netstream_data_t *sslsock)
+{
+	zval *val;
+	const char *sni = sslsock->url_name ? sslsock->url_name : "";
+	char *cafile = NULL;
+	char *capath = NULL;
+	zend_long verify_depth = -1;
+	bool verify_peer = true;
+	bool verify_peer_name = true;
+	bool allow_self_signed = false;
+	char buf[PHP_OPENSSL_SESSION_KEY_MAX];
+	int len;
+
+	GET_VER_OPT_STRING("peer_name", sni);
+	if (GET_VER_OPT("verify_peer")) {
+		verify_peer = zend_is_true(val);
+	}
+	if (GET_VER_OPT("verify_peer_name")) {
+		verify_peer_name = zend_is_true(val);
+	}
+	if (GET_VER_OPT("allow_self_signed")) {
+		allow_self_signed = zend_is_true(val);
+	}
+	GET_VER_OPT_LONG("verify_depth", verify_depth);
+	GET_VER_OPT_STRING("cafile", cafile);
+	GET_VER_OPT_STRING("capath", capath);
+	if (cafile == NULL) {
+		cafile = zend_ini_string("openssl.cafile", sizeof("openssl.cafile")-1, 0);
+	}
+	if (capath == NULL) {
+		capath = zend_ini_string("openssl.capath", sizeof("openssl.capath")-1, 0);
+	}
+
+	/* Every option that changes how the peer is verified takes part in the
+	 * key; when the result does not fit, the stream simply isn't cached. */
+	len = snprintf(buf, sizeof(buf), "%s|%s|%d%d%d|" ZEND_LONG_FMT "|%s|%s",
+			sslsock->conn_name, sni,
+			verify_peer, verify_peer_name, allow_self_signed, verify_depth,
+			cafile ? cafile : "", capath ? capath : "");
+	if (len > 0 && (size_t)len < sizeof(buf)) {
+		sslsock->session_key = pestrndup(buf, len, php_stream_is_persistent(stream));
+	}
+}
+#endif /* PHP_OPENSSL_SESSION_CACHE */
+
+void php_openssl_init_session_cache(void)
+{
+#ifdef PHP_OPENSSL_SESSION_CACHE
+	size_t nslots, bytes;
+
+	if (OPENSSL_G(session_cache_size) <= 0) {
+		return;
+	}
+
+	nslots = (size_t)OPENSSL_G(session_cache_size) / sizeof(php_openssl_session_slot);
+	if (nslots == 0) {
+		nslots = 1;
+	}
+	bytes = sizeof(php_openssl_session_cache_t) + (nslots - 1) * sizeof(php_openssl_session_slot);
+
+	php_openssl_session_cache = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (php_openssl_session_cache == MAP_FAILED) {
+		php_openssl_session_cache = NULL;
+		return;
+	}
+	php_openssl_session_cache_bytes = bytes;
+	php_openssl_session_cache->nslots = (uint32_t)nslots;
+	php_openssl_session_cache->owner = getpid();
+#endif
+}
+
+void php_openssl_shutdown_session_cache(void)
+{
+#ifdef PHP_OPENSSL_SESSION_CACHE
+	if (php_openssl_session_cache) {
+		if (php_openssl_session_cache->owner == getpid()) {
+			munmap(php_openssl_session_cache, php_openssl_session_cache_bytes);
+		}
+		php_openssl_session_cache = NULL;
+	}
+#endif
+}
+
 /* it doesn't matter that we do some hash traversal here, since it is done only
  * in an error condition arising from a network connection problem */
 static int php_openssl_is_http_stream_talking_to_iis(php_stream *stream) /* {{{ */
@@ -1809,6 +2040,13 @@ static zend_result php_openssl_setup_crypto(php_stream *stream,
 		SSL_set_ex_data(sslsock->ssl_handle, php_openssl_get_ssl_stream_data_index(), stream);
 	}
 
+#ifdef PHP_OPENSSL_SESSION_CACHE
+	if (sslsock->is_client && php_openssl_session_cache) {
+		SSL_CTX_set_session_cache_mode(sslsock->ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL);
+		SSL_CTX_sess_set_new_cb(sslsock->ctx, php_openssl_shared_session_new_cb);
+	}
+#endif
+
 	if (!SSL_set_fd(sslsock->ssl_handle, sslsock->s.socket)) {
 		php_openssl_handle_ssl_error(stream, 0, 1);
 	}
@@ -1916,6 +2154,21 @@ static int php_openssl_enable_crypto(php_stream *stream,
 		}
 #endif
 
+#ifdef PHP_OPENSSL_SESSION_CACHE
+		if (sslsock->is_client && php_openssl_session_cache
+				&& sslsock->conn_name && !sslsock->session_key) {
+			php_openssl_build_session_key(stream, sslsock);
+			if (sslsock->session_key) {
+				SSL_SESSION *sess = php_openssl_session_cache_get(sslsock->session_key);
+
+				if (sess) {
+					SSL_set_session(sslsock->ssl_handle, sess);
+					SSL_SESSION_free(sess);
+				}
+			}
+		}
+#endif
+
 		if (!sslsock->state_set) {
 			if (sslsock->is_client) {
 				SSL_set_connect_state(sslsock->ssl_handle);
@@ -2296,6 +2549,14 @@ static int php_openssl_sockop_close(php_stream *stream, int close_handle) /* {{{
 		pefree(sslsock->url_name, php_stream_is_persistent(stream));
 	}
 
+	if (sslsock->conn_name) {
+		pefree(sslsock->conn_name, php_stream_is_persistent(stream));
+	}
+
+	if (sslsock->session_key) {
+		pefree(sslsock->session_key, php_stream_is_persistent(stream));
+	}
+
 	if (sslsock->reneg) {
 		pefree(sslsock->reneg, php_stream_is_persistent(stream));
 	}
@@ -2858,6 +3119,12 @@ php_stream *php_openssl_ssl_socket_factory(const char *proto, size_t protolen,
 
 	sslsock->url_name = php_openssl_get_url_name(resourcename, resourcenamelen, !!persistent_id);
 
+#ifdef PHP_OPENSSL_SESSION_CACHE
+	if (php_openssl_session_cache) {
+		sslsock->conn_name = pestrndup(resourcename, resourcenamelen, !!persistent_id);
+	}
+#endif
+
 	return stream;
 }
 /* }}} */
@@ -1586,6 +1586,62 @@ PHP_FUNCTION(pcntl_setns)
 		RETURN_TRUE;
 	}
 }
+
+/* The returned stream becomes readable when the process exits, so children
+ * can be awaited with stream_select() and reaped with WNOHANG instead of
+ * juggling SIGCHLD or polling pcntl_wait() */
+PHP_FUNCTION(pcntl_pidfd_open)
+{
+	zend_long pid, flags = 0;
+	int fd;
+	php_stream *stream;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_LONG(pid)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(flags)
+	ZEND_PARSE_PARAMETERS_END();
+
+	fd = syscall(SYS_pidfd_open, pid, flags);
+	if (fd == -1) {
+		PCNTL_G(last_error) = errno;
+		switch (errno) {
+			case EINVAL:
+				if (flags != 0) {
+					zend_argument_value_error(2, "is not a valid flags value (" ZEND_LONG_FMT ")", flags);
+					RETURN_THROWS();
+				}
+				ZEND_FALLTHROUGH;
+			case ESRCH:
+				zend_argument_value_error(1, "is not a valid process (" ZEND_LONG_FMT ")", pid);
+				RETURN_THROWS();
+
+			case ENFILE:
+			case EMFILE:
+				php_error_docref(NULL, E_WARNING, "Error %d: File descriptors limit reached", errno);
+				break;
+
+			case ENODEV:
+				php_error_docref(NULL, E_WARNING, "Error %d: Anonymous inode fs unsupported", errno);
+				break;
+
+			case ENOMEM:
+				php_error_docref(NULL, E_WARNING, "Error %d: Insufficient memory for pidfd_open", errno);
+				break;
+
+			default:
+				php_error_docref(NULL, E_WARNING, "Error %d", errno);
+		}
+		RETURN_FALSE;
+	}
+
+	stream = php_stream_fopen_from_fd(fd, "r", NULL);
+	if (stream == NULL) {
+		close(fd);
+		RETURN_FALSE;
+	}
+	php_stream_to_zval(stream, return_value);
+}
 #endif
 
 #ifdef HAVE_SCHED_SETAFFINITY
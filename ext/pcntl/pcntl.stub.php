@@ -1007,6 +1007,11 @@ function pcntl_forkx(int $flags): int{}
 
 #ifdef HAVE_PIDFD_OPEN
 function pcntl_setns(?int $process_id = null, int $nstype = CLONE_NEWNET): bool {}
+
+/**
+ * @return resource|false
+ */
+function pcntl_pidfd_open(int $process_id, int $flags = 0) {}
 #endif
 
 #ifdef HAVE_SCHED_SETAFFINITY
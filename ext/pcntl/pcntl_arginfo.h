@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 775838bf2abbf32933f5cec6e4a85e07e8cea247 */
+ * Stub hash: 14586d88629d9a6bdc10ff71f0f0719a80c67e39 */
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_pcntl_fork, 0, 0, IS_LONG, 0)
 ZEND_END_ARG_INFO()
@@ -137,6 +137,11 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_pcntl_setns, 0, 0, _IS_BOOL, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, process_id, IS_LONG, 1, "null")
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, nstype, IS_LONG, 0, "CLONE_NEWNET")
 ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_pcntl_pidfd_open, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, process_id, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, flags, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
 #endif
 
 #if defined(HAVE_SCHED_SETAFFINITY)
@@ -214,6 +219,7 @@ ZEND_FUNCTION(pcntl_forkx);
 #endif
 #if defined(HAVE_PIDFD_OPEN)
 ZEND_FUNCTION(pcntl_setns);
+ZEND_FUNCTION(pcntl_pidfd_open);
 #endif
 #if defined(HAVE_SCHED_SETAFFINITY)
 ZEND_FUNCTION(pcntl_getcpuaffinity);
@@ -279,6 +285,7 @@ static const zend_function_entry ext_functions[] = {
 #endif
 #if defined(HAVE_PIDFD_OPEN)
 	ZEND_FE(pcntl_setns, arginfo_pcntl_setns)
+	ZEND_FE(pcntl_pidfd_open, arginfo_pcntl_pidfd_open)
 #endif
 #if defined(HAVE_SCHED_SETAFFINITY)
 	ZEND_FE(pcntl_getcpuaffinity, arginfo_pcntl_getcpuaffinity)
@@ -0,0 +1,41 @@
+--TEST--
+pcntl_pidfd_open() allows waiting for child exit with stream_select()
+--EXTENSIONS--
+pcntl
+--SKIPIF--
+<?php
+if (!function_exists('pcntl_pidfd_open')) die('skip pcntl_pidfd_open is not available');
+?>
+--FILE--
+<?php
+
+$pid = pcntl_fork();
+if ($pid === 0) {
+    usleep(50000);
+    exit(7);
+}
+
+$pidfd = pcntl_pidfd_open($pid);
+var_dump(is_resource($pidfd));
+
+$r = [$pidfd];
+$w = $e = null;
+var_dump(stream_select($r, $w, $e, 5));
+
+var_dump(pcntl_waitpid($pid, $status, WNOHANG) === $pid);
+var_dump(pcntl_wexitstatus($status));
+
+fclose($pidfd);
+
+try {
+    pcntl_pidfd_open(-1);
+} catch (ValueError $ex) {
+    echo $ex->getMessage(), "\n";
+}
+?>
+--EXPECT--
+bool(true)
+int(1)
+bool(true)
+int(7)
+pcntl_pidfd_open(): Argument #1 ($process_id) is not a valid process (-1)
@@ -302,6 +302,8 @@ static PHP_GINIT_FUNCTION(pcre) /* {{{ */
 
 	pcre_globals->backtrack_limit = 0;
 	pcre_globals->recursion_limit = 0;
+	pcre_globals->last_pattern    = NULL;
+	pcre_globals->last_pce        = NULL;
 	pcre_globals->error_code      = PHP_PCRE_NO_ERROR;
 	ZVAL_UNDEF(&pcre_globals->unmatched_null_pair);
 	ZVAL_UNDEF(&pcre_globals->unmatched_empty_pair);
@@ -366,6 +368,7 @@ PHP_INI_BEGIN()
 #ifdef HAVE_PCRE_JIT_SUPPORT
 	STD_PHP_INI_BOOLEAN("pcre.jit",           "1",       PHP_INI_ALL, OnUpdateJit,            jit,             zend_pcre_globals, pcre_globals)
 #endif
+	STD_PHP_INI_ENTRY("pcre.preload_patterns", NULL,     PHP_INI_SYSTEM, OnUpdateString,      preload_patterns, zend_pcre_globals, pcre_globals)
 PHP_INI_END()
 
 static char *_pcre2_config_str(uint32_t what)
@@ -423,6 +426,55 @@ static PHP_MINFO_FUNCTION(pcre)
 }
 /* }}} */
 
+/* {{{ php_pcre_preload_patterns
+ * Compile (and JIT) the patterns listed in the pcre.preload_patterns file
+ * into the persistent cache at module startup. Under prefork SAPIs the
+ * workers then inherit the already compiled patterns from the parent, so no
+ * child ever recompiles them and the compiled code stays in shared
+ * copy-on-write pages instead of being duplicated per process. */
+static void php_pcre_preload_patterns(void)
+{
+	FILE *fp;
+	char line[4096];
+
+	if (!PCRE_G(preload_patterns) || !*PCRE_G(preload_patterns)) {
+		return;
+	}
+	/* The CLI cache is per-request and does not exist yet. */
+	if (PCRE_G(per_request_cache)) {
+		return;
+	}
+
+	fp = fopen(PCRE_G(preload_patterns), "r");
+	if (!fp) {
+		php_error_docref(NULL, E_CORE_WARNING,
+			"Cannot open pcre.preload_patterns file \"%s\"", PCRE_G(preload_patterns));
+		return;
+	}
+
+	while (fgets(line, sizeof(line), fp)) {
+		size_t len = strlen(line);
+		zend_string *pattern;
+
+		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+			len--;
+		}
+		/* one delimited pattern per line; '#' and ';' start a comment line */
+		if (len == 0 || line[0] == '#' || line[0] == ';') {
+			continue;
+		}
+
+		pattern = zend_string_init(line, len, 0);
+		/* An invalid pattern already emitted a startup warning; keep going
+		 * so one bad line does not invalidate the rest of the list. */
+		(void) pcre_get_compiled_regex_cache_ex(pattern, false);
+		zend_string_release_ex(pattern, 0);
+	}
+
+	fclose(fp);
+}
+/* }}} */
+
 /* {{{ PHP_MINIT_FUNCTION(pcre) */
 static PHP_MINIT_FUNCTION(pcre)
 {
@@ -442,6 +494,8 @@ static PHP_MINIT_FUNCTION(pcre)
 
 	register_php_pcre_symbols(module_number);
 
+	php_pcre_preload_patterns();
+
 	return SUCCESS;
 }
 /* }}} */
@@ -485,6 +539,10 @@ static PHP_RINIT_FUNCTION(pcre)
 		zend_hash_init(&PCRE_G(pcre_cache), 0, NULL, php_efree_pcre_cache, 0);
 	}
 
+	/* interned pattern strings from the previous request are gone */
+	PCRE_G(last_pattern) = NULL;
+	PCRE_G(last_pce) = NULL;
+
 	return SUCCESS;
 }
 /* }}} */
@@ -612,6 +670,12 @@ PHPAPI pcre_cache_entry* pcre_get_compiled_regex_cache_ex(zend_string *regex, bo
 			ZSTR_VAL(BG(ctype_string)), ZSTR_LEN(BG(ctype_string)),
 			ZSTR_VAL(regex), ZSTR_LEN(regex));
 	} else {
+		/* Literal patterns are interned strings with a stable address, so
+		 * the repeated call with the same pattern that dominates real
+		 * workloads can skip the hash lookup entirely. */
+		if (EXPECTED(regex == PCRE_G(last_pattern))) {
+			return PCRE_G(last_pce);
+		}
 		key = regex;
 	}
 
@@ -621,6 +685,9 @@ PHPAPI pcre_cache_entry* pcre_get_compiled_regex_cache_ex(zend_string *regex, bo
 	if (zv) {
 		if (key != regex) {
 			zend_string_release_ex(key, 0);
+		} else if (ZSTR_IS_INTERNED(regex)) {
+			PCRE_G(last_pattern) = regex;
+			PCRE_G(last_pce) = (pcre_cache_entry*)Z_PTR_P(zv);
 		}
 		return (pcre_cache_entry*)Z_PTR_P(zv);
 	}
@@ -825,6 +892,9 @@ PHPAPI pcre_cache_entry* pcre_get_compiled_regex_cache_ex(zend_string *regex, bo
 	if (zend_hash_num_elements(&PCRE_G(pcre_cache)) == PCRE_CACHE_SIZE) {
 		int num_clean = PCRE_CACHE_SIZE / 8;
 		zend_hash_apply_with_argument(&PCRE_G(pcre_cache), pcre_clean_cache, &num_clean);
+		/* the evicted entries may include the lookaside one */
+		PCRE_G(last_pattern) = NULL;
+		PCRE_G(last_pce) = NULL;
 	}
 
 	/* Store the compiled pattern and extra info in the cache. */
@@ -873,6 +943,9 @@ PHPAPI pcre_cache_entry* pcre_get_compiled_regex_cache_ex(zend_string *regex, bo
 
 	if (key != regex) {
 		zend_string_release_ex(key, 0);
+	} else if (ZSTR_IS_INTERNED(regex)) {
+		PCRE_G(last_pattern) = regex;
+		PCRE_G(last_pce) = ret;
 	}
 
 	return ret;
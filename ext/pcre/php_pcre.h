@@ -75,10 +75,15 @@ ZEND_BEGIN_MODULE_GLOBALS(pcre)
 	HashTable pcre_cache;
 	zend_long backtrack_limit;
 	zend_long recursion_limit;
+	char *preload_patterns;
 #ifdef HAVE_PCRE_JIT_SUPPORT
 	bool jit;
 #endif
 	bool per_request_cache;
+	/* one-entry lookaside over pcre_cache: the last interned pattern looked
+	 * up under the default locale, reset per request and on cache eviction */
+	zend_string *last_pattern;
+	pcre_cache_entry *last_pce;
 	php_pcre_error_code error_code;
 	/* Used for unmatched subpatterns in OFFSET_CAPTURE mode */
 	zval unmatched_null_pair;
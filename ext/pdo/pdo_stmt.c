@@ -1377,9 +1377,27 @@ PHP_METHOD(PDOStatement, fetchAll)
 			while (do_fetch(stmt, &data, how | flags, PDO_FETCH_ORI_NEXT, /* offset */ 0, return_all));
 		} else {
 			array_init(return_value);
-			do {
-				zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &data);
-			} while (do_fetch(stmt, &data, how | flags, PDO_FETCH_ORI_NEXT, /* offset */ 0, NULL));
+			/* Buffered drivers report the result size up front; preallocating
+			 * the packed array avoids repeatedly growing it while hydrating
+			 * large result sets */
+			if (stmt->row_count > 1 && stmt->row_count <= (zend_long)UINT32_MAX) {
+				zend_hash_extend(Z_ARRVAL_P(return_value), (uint32_t)stmt->row_count, 1);
+			}
+			if ((how | flags) == PDO_FETCH_COLUMN) {
+				/* Single-column hydration writes each value straight into the
+				 * result array, skipping the per-row fetch mode dispatch */
+				do {
+					zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &data);
+					if (!do_fetch_common(stmt, PDO_FETCH_ORI_NEXT, /* offset */ 0)) {
+						break;
+					}
+					fetch_value(stmt, &data, stmt->fetch.column, NULL);
+				} while (1);
+			} else {
+				do {
+					zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &data);
+				} while (do_fetch(stmt, &data, how | flags, PDO_FETCH_ORI_NEXT, /* offset */ 0, NULL));
+			}
 		}
 	}
 
@@ -1400,6 +1418,47 @@ PHP_METHOD(PDOStatement, fetchAll)
 }
 /* }}} */
 
+/* {{{ Returns the remaining rows as one packed array per column, keyed by column name. */
+PHP_METHOD(PDOStatement, fetchAllColumnar)
+{
+	zval *cols, val;
+	int i;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_STMT_GET_OBJ;
+	PDO_STMT_CLEAR_ERR();
+
+	array_init_size(return_value, stmt->column_count);
+
+	/* on no results, return an empty array */
+	if (!do_fetch_common(stmt, PDO_FETCH_ORI_NEXT, 0)) {
+		PDO_HANDLE_STMT_ERR();
+		return;
+	}
+
+	cols = safe_emalloc(stmt->column_count, sizeof(zval), 0);
+	for (i = 0; i < stmt->column_count; i++) {
+		array_init(&cols[i]);
+	}
+
+	/* Filling one packed array per column avoids allocating a per-row
+	 * HashTable for every fetched row, which is what dominates fetchAll()
+	 * on wide result sets. */
+	do {
+		for (i = 0; i < stmt->column_count; i++) {
+			fetch_value(stmt, &val, i, NULL);
+			zend_hash_next_index_insert_new(Z_ARRVAL(cols[i]), &val);
+		}
+	} while (do_fetch_common(stmt, PDO_FETCH_ORI_NEXT, 0));
+
+	for (i = 0; i < stmt->column_count; i++) {
+		zend_symtable_update(Z_ARRVAL_P(return_value), stmt->columns[i].name, &cols[i]);
+	}
+	efree(cols);
+}
+/* }}} */
+
 static void register_bound_param(INTERNAL_FUNCTION_PARAMETERS, int is_param) /* {{{ */
 {
 	struct pdo_bound_param_data param;
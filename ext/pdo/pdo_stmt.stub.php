@@ -40,6 +40,8 @@ class PDOStatement implements IteratorAggregate
     /** @tentative-return-type */
     public function fetchAll(int $mode = PDO::FETCH_DEFAULT, mixed ...$args): array {}
 
+    public function fetchAllColumnar(): array {}
+
     /** @tentative-return-type */
     public function fetchColumn(int $column = 0): mixed {}
 
@@ -245,6 +245,18 @@ static void pgsql_handle_closer(pdo_dbh_t *dbh) /* {{{ */
 			pefree(H->lob_streams, dbh->is_persistent);
 			H->lob_streams = NULL;
 		}
+		if (H->prepared_plans) {
+			pdo_pgsql_pinned_plan *plan;
+
+			/* closing the connection deallocates the statements server-side */
+			ZEND_HASH_FOREACH_PTR(H->prepared_plans, plan) {
+				pefree(plan->stmt_name, dbh->is_persistent);
+				pefree(plan, dbh->is_persistent);
+			} ZEND_HASH_FOREACH_END();
+			zend_hash_destroy(H->prepared_plans);
+			pefree(H->prepared_plans, dbh->is_persistent);
+			H->prepared_plans = NULL;
+		}
 		pdo_pgsql_cleanup_notice_callback(H);
 		if (H->server) {
 			PQfinish(H->server);
@@ -317,8 +329,29 @@ static bool pgsql_handle_preparer(pdo_dbh_t *dbh, zend_string *sql, pdo_stmt_t *
 
 	if (!emulate && !execute_only) {
 		/* prepared query: set the query name and defer the
-		   actual prepare until the first execute call */
-		spprintf(&S->stmt_name, 0, "pdo_stmt_%08x", ++H->stmt_counter);
+		   actual prepare until the first execute call.  Identical SQL
+		   reuses the statement already prepared on the server, so
+		   re-preparing a query costs no extra round trip. */
+		pdo_pgsql_pinned_plan *plan;
+
+		if (!H->prepared_plans) {
+			H->prepared_plans = pemalloc(sizeof(HashTable), dbh->is_persistent);
+			zend_hash_init(H->prepared_plans, 8, NULL, NULL, dbh->is_persistent);
+		}
+
+		plan = zend_hash_str_find_ptr(H->prepared_plans, ZSTR_VAL(S->query), ZSTR_LEN(S->query));
+		if (!plan) {
+			char buf[32];
+
+			plan = pecalloc(1, sizeof(pdo_pgsql_pinned_plan), dbh->is_persistent);
+			snprintf(buf, sizeof(buf), "pdo_stmt_%08x", ++H->stmt_counter);
+			plan->stmt_name = pestrdup(buf, dbh->is_persistent);
+			zend_hash_str_add_ptr(H->prepared_plans, ZSTR_VAL(S->query), ZSTR_LEN(S->query), plan);
+		}
+
+		S->pinned_plan = plan;
+		S->stmt_name = estrdup(plan->stmt_name);
+		S->is_prepared = plan->is_prepared;
 	}
 
 	return true;
@@ -545,6 +578,14 @@ static zend_result pdo_pgsql_check_liveness(pdo_dbh_t *dbh)
 	pdo_pgsql_db_handle *H = (pdo_pgsql_db_handle *)dbh->driver_data;
 	if (!PQconsumeInput(H->server) || PQstatus(H->server) == CONNECTION_BAD) {
 		PQreset(H->server);
+		if (H->prepared_plans) {
+			pdo_pgsql_pinned_plan *plan;
+
+			/* the new server session has no prepared statements */
+			ZEND_HASH_FOREACH_PTR(H->prepared_plans, plan) {
+				plan->is_prepared = false;
+			} ZEND_HASH_FOREACH_END();
+		}
 	}
 	return (PQstatus(H->server) == CONNECTION_OK) ? SUCCESS : FAILURE;
 }
@@ -72,7 +72,10 @@ static int pgsql_stmt_dtor(pdo_stmt_t *stmt)
 	}
 
 	if (S->stmt_name) {
-		if (S->is_prepared && server_obj_usable) {
+		/* pinned plans stay prepared on the server so later statements
+		 * with the same SQL can reuse them; they are torn down with the
+		 * connection */
+		if (S->is_prepared && !S->pinned_plan && server_obj_usable) {
 			pdo_pgsql_db_handle *H = S->H;
 			char *q = NULL;
 			PGresult *res;
@@ -132,6 +135,84 @@ static int pgsql_stmt_dtor(pdo_stmt_t *stmt)
 	return 1;
 }
 
+#ifdef LIBPQ_HAS_PIPELINING
+/* Prepare and execute the deferred statement in a single server round trip
+ * using libpq pipeline mode.  Returns true when the statement is prepared and
+ * S->result holds the execution result (which may be an error result, handled
+ * by the caller like any PQexecPrepared() outcome).  Returns false with the
+ * connection back in normal mode when the caller should fall back to the
+ * synchronous path, so that the existing error reporting and the 42P05 retry
+ * still apply. */
+static bool pgsql_stmt_prepare_execute_pipeline(pdo_stmt_t *stmt, pdo_pgsql_stmt *S)
+{
+	pdo_pgsql_db_handle *H = S->H;
+	int nparams = stmt->bound_params ? zend_hash_num_elements(stmt->bound_params) : 0;
+	PGresult *res, *exec_res = NULL;
+	bool prepared = false;
+	bool clean = true;
+
+	if (PQpipelineStatus(H->server) != PQ_PIPELINE_OFF
+	 || !PQenterPipelineMode(H->server)) {
+		return false;
+	}
+
+	/* queue PREPARE and EXECUTE; on a send failure still sync, so that
+	 * whatever was queued gets collected below */
+	if (!PQsendPrepare(H->server, S->stmt_name, ZSTR_VAL(S->query), nparams, S->param_types)
+	 || !PQsendQueryPrepared(H->server, S->stmt_name, nparams,
+			(const char **)S->param_values, S->param_lengths, S->param_formats, 0)) {
+		clean = false;
+	}
+	if (!PQpipelineSync(H->server)) {
+		PQexitPipelineMode(H->server);
+		return false;
+	}
+
+	/* results arrive as: PREPARE, NULL, EXECUTE, NULL, PIPELINE_SYNC;
+	 * commands after a failure report PGRES_PIPELINE_ABORTED */
+	res = PQgetResult(H->server);
+	if (res) {
+		prepared = (PQresultStatus(res) == PGRES_COMMAND_OK);
+		PQclear(res);
+	}
+	if ((res = PQgetResult(H->server))) {
+		PQclear(res);
+		clean = false;
+	}
+
+	exec_res = PQgetResult(H->server);
+	if ((res = PQgetResult(H->server))) {
+		PQclear(res);
+		clean = false;
+	}
+
+	if ((res = PQgetResult(H->server))) {
+		if (PQresultStatus(res) != PGRES_PIPELINE_SYNC) {
+			clean = false;
+		}
+		PQclear(res);
+	} else {
+		clean = false;
+	}
+	PQexitPipelineMode(H->server);
+
+	if (!prepared || !clean || !exec_res
+	 || PQresultStatus(exec_res) == PGRES_PIPELINE_ABORTED) {
+		if (exec_res) {
+			PQclear(exec_res);
+		}
+		return false;
+	}
+
+	S->is_prepared = 1;
+	if (S->pinned_plan) {
+		S->pinned_plan->is_prepared = true;
+	}
+	S->result = exec_res;
+	return true;
+}
+#endif
+
 static int pgsql_stmt_execute(pdo_stmt_t *stmt)
 {
 	pdo_pgsql_stmt *S = (pdo_pgsql_stmt*)stmt->driver_data;
@@ -179,7 +260,18 @@ static int pgsql_stmt_execute(pdo_stmt_t *stmt)
 	} else if (S->stmt_name) {
 		/* using a prepared statement */
 
+		if (!S->is_prepared && S->pinned_plan && S->pinned_plan->is_prepared) {
+			/* an earlier statement with the same SQL already prepared it */
+			S->is_prepared = 1;
+		}
+
 		if (!S->is_prepared) {
+#ifdef LIBPQ_HAS_PIPELINING
+			/* the deferred PREPARE and this EXECUTE fit in one round trip */
+			if (pgsql_stmt_prepare_execute_pipeline(stmt, S)) {
+				goto stmt_executed;
+			}
+#endif
 stmt_retry:
 			/* we deferred the prepare until now, because we didn't
 			 * know anything about the parameter types; now we do */
@@ -192,6 +284,9 @@ stmt_retry:
 				case PGRES_TUPLES_OK:
 					/* it worked */
 					S->is_prepared = 1;
+					if (S->pinned_plan) {
+						S->pinned_plan->is_prepared = true;
+					}
 					PQclear(S->result);
 					break;
 				default: {
@@ -226,6 +321,9 @@ stmt_retry:
 				S->param_lengths,
 				S->param_formats,
 				0);
+#ifdef LIBPQ_HAS_PIPELINING
+stmt_executed:;
+#endif
 	} else if (stmt->supports_placeholders == PDO_PLACEHOLDER_NAMED) {
 		/* execute query with parameters */
 		S->result = PQexecParams(H->server, ZSTR_VAL(S->query),
@@ -32,6 +32,14 @@ typedef struct {
 	char *errmsg;
 } pdo_pgsql_error_info;
 
+/* a server-side prepared statement pinned to the connection, so that
+ * preparing the same SQL again reuses the existing plan instead of
+ * round-tripping another PREPARE */
+typedef struct {
+	char *stmt_name;
+	bool is_prepared;
+} pdo_pgsql_pinned_plan;
+
 /* stuff we use in a pgsql database handle */
 typedef struct {
 	PGconn		*server;
@@ -46,6 +54,8 @@ typedef struct {
 	bool		disable_native_prepares; /* deprecated since 5.6 */
 	bool		disable_prepares;
 	HashTable       *lob_streams;
+	/* query text -> pdo_pgsql_pinned_plan*, kept for the connection lifetime */
+	HashTable       *prepared_plans;
 	zend_fcall_info_cache *notice_callback;
 } pdo_pgsql_db_handle;
 
@@ -59,6 +69,8 @@ typedef struct {
 	pdo_pgsql_column        *cols;
 	char *cursor_name;
 	char *stmt_name;
+	/* shared entry in H->prepared_plans, NULL for unnamed or emulated statements */
+	pdo_pgsql_pinned_plan *pinned_plan;
 	zend_string *query;
 	char **param_values;
 	int *param_lengths;
@@ -0,0 +1,41 @@
+--TEST--
+PDO_sqlite: Testing PDOStatement::fetchAllColumnar()
+--EXTENSIONS--
+pdo_sqlite
+--FILE--
+<?php
+
+$db = new PDO('sqlite::memory:');
+$db->exec('CREATE TABLE test (id INT, name TEXT)');
+$db->exec("INSERT INTO test VALUES (1, 'one'), (2, 'two'), (3, 'three')");
+
+$stmt = $db->query('SELECT id, name FROM test ORDER BY id');
+var_dump($stmt->fetchAllColumnar());
+
+$stmt = $db->query('SELECT id FROM test WHERE id > 100');
+var_dump($stmt->fetchAllColumnar());
+
+?>
+--EXPECT--
+array(2) {
+  ["id"]=>
+  array(3) {
+    [0]=>
+    int(1)
+    [1]=>
+    int(2)
+    [2]=>
+    int(3)
+  }
+  ["name"]=>
+  array(3) {
+    [0]=>
+    string(3) "one"
+    [1]=>
+    string(3) "two"
+    [2]=>
+    string(5) "three"
+  }
+}
+array(0) {
+}
@@ -442,8 +442,19 @@ void phar_entry_remove(phar_entry_data *idata, char **error) /* {{{ */
 	}\
 	return FAILURE;
 
+/* Release the manifest buffer of phar_parse_pharfile(), which is either a
+ * mapping of the manifest range of the stream or a heap copy of it */
+#define MAPPHAR_RELEASE_BUF() \
+	do { \
+		if (manifest_fp) { \
+			php_stream_mmap_unmap(manifest_fp); \
+		} else { \
+			efree(savebuf); \
+		} \
+	} while (0)
+
 #define MAPPHAR_FAIL(msg) \
-	efree(savebuf);\
+	MAPPHAR_RELEASE_BUF();\
 	if (mydata) {\
 		phar_destroy_phar_data(mydata);\
 	}\
@@ -728,6 +739,7 @@ void phar_parse_metadata_lazy(const char *buffer, phar_metadata_tracker *tracker
 static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, char *alias, size_t alias_len, zend_long halt_offset, phar_archive_data** pphar, uint32_t compression, char **error) /* {{{ */
 {
 	char b32[4], *buffer, *endbuffer, *savebuf;
+	php_stream *manifest_fp = NULL; /* non-NULL while the manifest is mmapped */
 	phar_archive_data *mydata = NULL;
 	phar_entry_info entry;
 	uint32_t manifest_len, manifest_count, manifest_flags, manifest_index, tmp_len, sig_flags;
@@ -797,12 +809,32 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 		MAPPHAR_ALLOC_FAIL("manifest cannot be larger than 100 MB in phar \"%s\"")
 	}
 
-	buffer = (char *)emalloc(manifest_len);
-	savebuf = buffer;
-	endbuffer = buffer + manifest_len;
+	/* map the manifest directly instead of copying it to the heap; large
+	 * deploy archives carry multi-megabyte manifests and the parse below
+	 * only reads the buffer sequentially */
+	if (manifest_len >= MANIFEST_FIXED_LEN && php_stream_mmap_possible(fp)) {
+		size_t mapped_len = 0;
 
-	if (manifest_len < MANIFEST_FIXED_LEN || manifest_len != php_stream_read(fp, buffer, manifest_len)) {
-		MAPPHAR_FAIL("internal corruption of phar \"%s\" (truncated manifest header)")
+		buffer = php_stream_mmap_range(fp, halt_offset + 4, manifest_len, PHP_STREAM_MAP_MODE_SHARED_READONLY, &mapped_len);
+		if (buffer && mapped_len == manifest_len) {
+			manifest_fp = fp;
+		} else if (buffer) {
+			php_stream_mmap_unmap(fp);
+			buffer = NULL;
+		}
+	}
+
+	if (manifest_fp) {
+		savebuf = buffer;
+		endbuffer = buffer + manifest_len;
+	} else {
+		buffer = (char *)emalloc(manifest_len);
+		savebuf = buffer;
+		endbuffer = buffer + manifest_len;
+
+		if (manifest_len < MANIFEST_FIXED_LEN || manifest_len != php_stream_read(fp, buffer, manifest_len)) {
+			MAPPHAR_FAIL("internal corruption of phar \"%s\" (truncated manifest header)")
+		}
 	}
 
 	/* extract the number of entries */
@@ -818,7 +850,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 	buffer += 2;
 
 	if ((manifest_ver & PHAR_API_VER_MASK) < PHAR_API_MIN_READ) {
-		efree(savebuf);
+		MAPPHAR_RELEASE_BUF();
 		php_stream_close(fp);
 		if (error) {
 			spprintf(error, 0, "phar \"%s\" is API version %1.u.%1.u.%1.u, and cannot be processed", fname, manifest_ver >> 12, (manifest_ver >> 8) & 0xF, (manifest_ver >> 4) & 0x0F);
@@ -844,7 +876,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 		|| (read_len = php_stream_tell(fp)) < 20
 		|| 8 != php_stream_read(fp, sig_buf, 8)
 		|| memcmp(sig_buf+4, "GBMB", 4)) {
-			efree(savebuf);
+			MAPPHAR_RELEASE_BUF();
 			php_stream_close(fp);
 			if (error) {
 				spprintf(error, 0, "phar \"%s\" has a broken signature", fname);
@@ -865,7 +897,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				/* we store the signature followed by the signature length */
 				if (-1 == php_stream_seek(fp, -12, SEEK_CUR)
 				|| 4 != php_stream_read(fp, sig_buf, 4)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						spprintf(error, 0, "phar \"%s\" openssl signature length could not be read", fname);
@@ -882,7 +914,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				if (-1 == php_stream_seek(fp, whence, SEEK_CUR)
 				|| !(end_of_phar = php_stream_tell(fp))
 				|| signature_len != php_stream_read(fp, sig, signature_len)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					efree(sig);
 					php_stream_close(fp);
 					if (error) {
@@ -892,7 +924,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				}
 
 				if (FAILURE == phar_verify_signature(fp, end_of_phar, sig_flags, sig, signature_len, fname, &signature, &sig_len, error)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					efree(sig);
 					php_stream_close(fp);
 					if (error) {
@@ -912,7 +944,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				read_len = php_stream_tell(fp);
 
 				if (php_stream_read(fp, (char*)digest, sizeof(digest)) != sizeof(digest)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						spprintf(error, 0, "phar \"%s\" has a broken signature", fname);
@@ -921,7 +953,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				}
 
 				if (FAILURE == phar_verify_signature(fp, read_len, PHAR_SIG_SHA512, (char *)digest, 64, fname, &signature, &sig_len, error)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						char *save = *error;
@@ -939,7 +971,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				read_len = php_stream_tell(fp);
 
 				if (php_stream_read(fp, (char*)digest, sizeof(digest)) != sizeof(digest)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						spprintf(error, 0, "phar \"%s\" has a broken signature", fname);
@@ -948,7 +980,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				}
 
 				if (FAILURE == phar_verify_signature(fp, read_len, PHAR_SIG_SHA256, (char *)digest, 32, fname, &signature, &sig_len, error)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						char *save = *error;
@@ -966,7 +998,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				read_len = php_stream_tell(fp);
 
 				if (php_stream_read(fp, (char*)digest, sizeof(digest)) != sizeof(digest)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						spprintf(error, 0, "phar \"%s\" has a broken signature", fname);
@@ -975,7 +1007,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				}
 
 				if (FAILURE == phar_verify_signature(fp, read_len, PHAR_SIG_SHA1, (char *)digest, 20, fname, &signature, &sig_len, error)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						char *save = *error;
@@ -993,7 +1025,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				read_len = php_stream_tell(fp);
 
 				if (php_stream_read(fp, (char*)digest, sizeof(digest)) != sizeof(digest)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						spprintf(error, 0, "phar \"%s\" has a broken signature", fname);
@@ -1002,7 +1034,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				}
 
 				if (FAILURE == phar_verify_signature(fp, read_len, PHAR_SIG_MD5, (char *)digest, 16, fname, &signature, &sig_len, error)) {
-					efree(savebuf);
+					MAPPHAR_RELEASE_BUF();
 					php_stream_close(fp);
 					if (error) {
 						char *save = *error;
@@ -1014,7 +1046,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				break;
 			}
 			default:
-				efree(savebuf);
+				MAPPHAR_RELEASE_BUF();
 				php_stream_close(fp);
 
 				if (error) {
@@ -1023,7 +1055,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				return FAILURE;
 		}
 	} else if (PHAR_G(require_hash)) {
-		efree(savebuf);
+		MAPPHAR_RELEASE_BUF();
 		php_stream_close(fp);
 
 		if (error) {
@@ -1051,8 +1083,6 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 		/* if the alias is stored we enforce it (implicit overrides explicit) */
 		if (alias && alias_len && (alias_len != tmp_len || strncmp(alias, buffer, tmp_len)))
 		{
-			php_stream_close(fp);
-
 			if (signature) {
 				efree(signature);
 			}
@@ -1061,7 +1091,8 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 				spprintf(error, 0, "cannot load phar \"%s\" with implicit alias \"%.*s\" under different alias \"%s\"", fname, tmp_len, buffer, alias);
 			}
 
-			efree(savebuf);
+			MAPPHAR_RELEASE_BUF();
+			php_stream_close(fp);
 			return FAILURE;
 		}
 
@@ -1289,7 +1320,7 @@ static int phar_parse_pharfile(php_stream *fp, char *fname, size_t fname_len, ch
 	}
 	zend_hash_add_ptr(&(PHAR_G(phar_fname_map)), str, mydata);
 	zend_string_release(str);
-	efree(savebuf);
+	MAPPHAR_RELEASE_BUF();
 
 	if (pphar) {
 		*pphar = mydata;
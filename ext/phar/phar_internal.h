@@ -42,6 +42,7 @@
 #include "ext/standard/info.h"
 #include "ext/standard/basic_functions.h"
 #include "ext/standard/file.h"
+#include "ext/standard/php_filestat.h"
 #include "ext/standard/php_string.h"
 #include "ext/standard/url.h"
 #include "ext/standard/crc32.h"
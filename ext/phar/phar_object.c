@@ -4647,16 +4647,7 @@ PHP_METHOD(PharFileInfo, chmod)
 
 	/* hackish cache in php_stat needs to be cleared */
 	/* if this code fails to work, check main/streams/streams.c, _php_stream_stat_path */
-	if (BG(CurrentLStatFile)) {
-		zend_string_release(BG(CurrentLStatFile));
-	}
-
-	if (BG(CurrentStatFile)) {
-		zend_string_release(BG(CurrentStatFile));
-	}
-
-	BG(CurrentLStatFile) = NULL;
-	BG(CurrentStatFile) = NULL;
+	php_clear_stat_cache(false, NULL, 0);
 	phar_flush(entry_obj->entry->phar, 0, 0, 0, &error);
 
 	if (error) {
@@ -1982,23 +1982,25 @@ void phar_add_virtual_dirs(phar_archive_data *phar, char *filename, size_t filen
 {
 	const char *s;
 	zend_string *str;
-	zval *ret;
 
 	while ((s = zend_memrchr(filename, '/', filename_len))) {
 		filename_len = s - filename;
 		if (!filename_len) {
 			break;
 		}
+		/* once a directory is present all of its parents are, too; probe
+		 * before allocating a key, as most parents of later entries are
+		 * already known */
+		if (zend_hash_str_exists(&phar->virtual_dirs, filename, filename_len)) {
+			break;
+		}
 		if (GC_FLAGS(&phar->virtual_dirs) & GC_PERSISTENT) {
 			str = zend_string_init_interned(filename, filename_len, 1);
 		} else {
 			str = zend_string_init(filename, filename_len, 0);
 		}
-		ret = zend_hash_add_empty_element(&phar->virtual_dirs, str);
+		zend_hash_add_empty_element(&phar->virtual_dirs, str);
 		zend_string_release(str);
-		if (ret == NULL) {
-			break;
-		}
 	}
 }
 /* }}} */
@@ -297,6 +297,16 @@ PHP_METHOD(Random_Randomizer, getBytes)
 			zend_string_free(retval);
 			RETURN_THROWS();
 		}
+#ifndef WORDS_BIGENDIAN
+		/* The byte loop below serializes the result in little endian order;
+		 * on matching hosts a whole 64-bit result is stored in one go */
+		if (EXPECTED(result.size == sizeof(result.result))
+		 && (size_t)(length - total_size) >= sizeof(result.result)) {
+			memcpy(ZSTR_VAL(retval) + total_size, &result.result, sizeof(result.result));
+			total_size += sizeof(result.result);
+			continue;
+		}
+#endif
 		for (size_t i = 0; i < result.size; i++) {
 			ZSTR_VAL(retval)[total_size++] = (result.result >> (i * 8)) & 0xff;
 			if (total_size >= length) {
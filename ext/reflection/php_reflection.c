@@ -1250,7 +1250,7 @@ static void reflect_attributes(INTERNAL_FUNCTION_PARAMETERS, HashTable *attribut
 		RETURN_EMPTY_ARRAY();
 	}
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(attributes));
 
 	if (FAILURE == read_attributes(return_value, attributes, scope, offset, target, name, base, filename)) {
 		RETURN_THROWS();
@@ -2175,7 +2175,7 @@ ZEND_METHOD(ReflectionFunctionAbstract, getParameters)
 		RETURN_EMPTY_ARRAY();
 	}
 
-	array_init(return_value);
+	array_init_size(return_value, num_args);
 	for (i = 0; i < num_args; i++) {
 		zval parameter;
 
@@ -4592,7 +4592,7 @@ ZEND_METHOD(ReflectionClass, getMethods)
 
 	GET_REFLECTION_OBJECT_PTR(ce);
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(&ce->function_table));
 	ZEND_HASH_MAP_FOREACH_PTR(&ce->function_table, mptr) {
 		_addmethod(mptr, ce, Z_ARRVAL_P(return_value), filter);
 	} ZEND_HASH_FOREACH_END();
@@ -4770,7 +4770,7 @@ ZEND_METHOD(ReflectionClass, getProperties)
 
 	GET_REFLECTION_OBJECT_PTR(ce);
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(&ce->properties_info));
 	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(&ce->properties_info, key, prop_info) {
 		_addproperty(prop_info, key, ce, Z_ARRVAL_P(return_value), filter);
 	} ZEND_HASH_FOREACH_END();
@@ -4826,7 +4826,7 @@ ZEND_METHOD(ReflectionClass, getConstants)
 
 	GET_REFLECTION_OBJECT_PTR(ce);
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(CE_CONSTANTS_TABLE(ce)));
 	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(CE_CONSTANTS_TABLE(ce), key, constant) {
 		if (UNEXPECTED(Z_TYPE(constant->value) == IS_CONSTANT_AST && zend_update_class_constant(constant, key, constant->ce) != SUCCESS)) {
 			RETURN_THROWS();
@@ -4860,7 +4860,7 @@ ZEND_METHOD(ReflectionClass, getReflectionConstants)
 
 	GET_REFLECTION_OBJECT_PTR(ce);
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(CE_CONSTANTS_TABLE(ce)));
 	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(CE_CONSTANTS_TABLE(ce), name, constant) {
 		if (ZEND_CLASS_CONST_FLAGS(constant) & filter) {
 			zval class_const;
@@ -5194,7 +5194,7 @@ ZEND_METHOD(ReflectionClass, getInterfaces)
 		uint32_t i;
 
 		ZEND_ASSERT(ce->ce_flags & ZEND_ACC_LINKED);
-		array_init(return_value);
+		array_init_size(return_value, ce->num_interfaces);
 		for (i=0; i < ce->num_interfaces; i++) {
 			zval interface;
 			zend_reflection_class_factory(ce->interfaces[i], &interface);
@@ -5224,7 +5224,7 @@ ZEND_METHOD(ReflectionClass, getInterfaceNames)
 	}
 
 	ZEND_ASSERT(ce->ce_flags & ZEND_ACC_LINKED);
-	array_init(return_value);
+	array_init_size(return_value, ce->num_interfaces);
 
 	for (i=0; i < ce->num_interfaces; i++) {
 		add_next_index_str(return_value, zend_string_copy(ce->interfaces[i]->name));
@@ -5248,7 +5248,7 @@ ZEND_METHOD(ReflectionClass, getTraits)
 		RETURN_EMPTY_ARRAY();
 	}
 
-	array_init(return_value);
+	array_init_size(return_value, ce->num_traits);
 
 	for (i=0; i < ce->num_traits; i++) {
 		zval trait;
@@ -5279,7 +5279,7 @@ ZEND_METHOD(ReflectionClass, getTraitNames)
 		RETURN_EMPTY_ARRAY();
 	}
 
-	array_init(return_value);
+	array_init_size(return_value, ce->num_traits);
 
 	for (i=0; i < ce->num_traits; i++) {
 		add_next_index_str(return_value, zend_string_copy(ce->trait_names[i].name));
@@ -6867,7 +6867,7 @@ ZEND_METHOD(ReflectionEnum, getCases)
 
 	GET_REFLECTION_OBJECT_PTR(ce);
 
-	array_init(return_value);
+	array_init_size(return_value, zend_hash_num_elements(CE_CONSTANTS_TABLE(ce)));
 	ZEND_HASH_MAP_FOREACH_STR_KEY_PTR(CE_CONSTANTS_TABLE(ce), name, constant) {
 		if (ZEND_CLASS_CONST_FLAGS(constant) & ZEND_CLASS_CONST_IS_CASE) {
 			zval class_const;
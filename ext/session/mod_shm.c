@@ -0,0 +1,610 @@
+/*
+   +----------------------------------------------------------------------+
+   | Copyright (c) The PHP Group                                          |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | https://www.php.net/license/3_01.txt                                 |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+ */
+
+#include "php.h"
+
+#if defined(HAVE_MMAP) && !defined(PHP_WIN32)
+
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+
+#include "php_session.h"
+#include "mod_shm.h"
+#include "SAPI.h"
+
+#ifndef MAP_ANONYMOUS
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Session store over one anonymous shared mapping created in the parent
+ * process before workers fork (PHP_MINIT runs in the FPM/Apache master).
+ * Everything inside the segment is addressed by byte offsets relative to
+ * its start, never by pointers, so every process can use it regardless of
+ * where the mapping landed.  Offset 0 is the segment header and therefore
+ * doubles as the NULL offset.
+ *
+ * Layout: a header with PS_SHM_BUCKETS spinlocked hash chains, followed by
+ * a heap managed by an address-ordered first-fit free list (one spinlock).
+ * The bucket lock protects its chain, the allocator lock only the free
+ * list; the allocator lock is a leaf and is only ever taken while holding
+ * at most one bucket lock, so the ordering is deadlock free. */
+
+#define PS_SHM_BUCKETS		256		/* power of two */
+#define PS_SHM_MIN_SIZE		(64 * 1024)
+#define PS_SHM_ALIGNMENT	8
+#define PS_SHM_ALIGN(s)		(((s) + PS_SHM_ALIGNMENT - 1) & ~(size_t)(PS_SHM_ALIGNMENT - 1))
+#define PS_SHM_EVICT_ATTEMPTS	8
+
+/* Heap block header; the payload follows it directly. On the free list
+ * "next" links to the next free block, in allocated blocks only "size"
+ * (which includes this header) is meaningful. */
+typedef struct {
+	uint32_t size;
+	uint32_t next;
+} ps_shm_block;
+
+/* One session record: key and data are stored inline behind the struct. */
+typedef struct {
+	uint32_t next;		/* offset of next record in the same bucket */
+	uint32_t hv;		/* hash value of key */
+	uint32_t keylen;
+	uint32_t datalen;	/* amount of valid data */
+	time_t atime;		/* time of last read or write */
+} ps_shm_sd;
+
+typedef struct {
+	uint32_t lock;
+	uint32_t head;		/* offset of first record */
+} ps_shm_bucket;
+
+typedef struct {
+	uint32_t segsize;
+	uint32_t free_head;	/* offset of first free heap block */
+	uint32_t alloc_lock;
+	pid_t owner;
+	ps_shm_bucket buckets[PS_SHM_BUCKETS];
+} ps_shm;
+
+static ps_shm *ps_shm_instance = NULL;
+static size_t ps_shm_instance_size = 0;
+
+#define PS_SHM_DATA ps_shm *data = PS_GET_MOD_DATA()
+
+#define PS_SHM_PTR(data, off) ((void *)((char *)(data) + (off)))
+
+static zend_always_inline bool ps_shm_trylock(volatile uint32_t *lock)
+{
+	return __atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static zend_always_inline void ps_shm_lock(volatile uint32_t *lock)
+{
+	while (!ps_shm_trylock(lock)) {
+		sched_yield();
+	}
+}
+
+static zend_always_inline void ps_shm_unlock(volatile uint32_t *lock)
+{
+	__atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t ps_shm_hash(const zend_string *data)
+{
+	uint32_t h;
+	const char *data_char = ZSTR_VAL(data);
+	const char *e = ZSTR_VAL(data) + ZSTR_LEN(data);
+
+	for (h = 2166136261U; data_char < e; ) {
+		h *= 16777619;
+		h ^= *data_char++;
+	}
+
+	return h;
+}
+
+/* Carve an allocated block for payload_size payload bytes out of the free
+ * list. Returns the payload offset, 0 when no block is large enough. */
+static uint32_t ps_shm_heap_alloc(ps_shm *data, size_t payload_size)
+{
+	size_t need = sizeof(ps_shm_block) + PS_SHM_ALIGN(payload_size);
+	uint32_t *prev, off, ret = 0;
+
+	ps_shm_lock(&data->alloc_lock);
+
+	prev = &data->free_head;
+	for (off = data->free_head; off; ) {
+		ps_shm_block *b = PS_SHM_PTR(data, off);
+
+		if (b->size >= need) {
+			if (b->size - need >= sizeof(ps_shm_block) + PS_SHM_ALIGNMENT) {
+				/* The remainder stays on the free list in place of b. */
+				ps_shm_block *rest = PS_SHM_PTR(data, off + need);
+
+				rest->size = b->size - (uint32_t)need;
+				rest->next = b->next;
+				b->size = (uint32_t)need;
+				*prev = off + (uint32_t)need;
+			} else {
+				*prev = b->next;
+			}
+			ret = off + sizeof(ps_shm_block);
+			break;
+		}
+		prev = &b->next;
+		off = b->next;
+	}
+
+	ps_shm_unlock(&data->alloc_lock);
+
+	return ret;
+}
+
+static void ps_shm_heap_free(ps_shm *data, uint32_t payload_off)
+{
+	uint32_t off = payload_off - sizeof(ps_shm_block);
+	ps_shm_block *b = PS_SHM_PTR(data, off);
+	uint32_t *prev, prev_off = 0, cur;
+
+	ps_shm_lock(&data->alloc_lock);
+
+	/* Keep the free list sorted by address so neighbours can coalesce. */
+	prev = &data->free_head;
+	for (cur = data->free_head; cur && cur < off; ) {
+		ps_shm_block *c = PS_SHM_PTR(data, cur);
+		prev_off = cur;
+		prev = &c->next;
+		cur = c->next;
+	}
+
+	if (cur && off + b->size == cur) {
+		ps_shm_block *n = PS_SHM_PTR(data, cur);
+		b->size += n->size;
+		b->next = n->next;
+	} else {
+		b->next = cur;
+	}
+	*prev = off;
+
+	if (prev_off) {
+		ps_shm_block *p = PS_SHM_PTR(data, prev_off);
+		if (prev_off + p->size == off) {
+			p->size += b->size;
+			p->next = b->next;
+		}
+	}
+
+	ps_shm_unlock(&data->alloc_lock);
+}
+
+/* Usable data capacity of a record, derived from its heap block. */
+static zend_always_inline size_t ps_shm_sd_capacity(ps_shm *data, uint32_t sd_off, const ps_shm_sd *sd)
+{
+	const ps_shm_block *b = PS_SHM_PTR(data, sd_off - sizeof(ps_shm_block));
+
+	return b->size - sizeof(ps_shm_block) - sizeof(ps_shm_sd) - sd->keylen;
+}
+
+/* Chain search; the caller must hold the bucket lock. */
+static uint32_t ps_shm_sd_lookup(ps_shm *data, uint32_t slot, uint32_t hv, const zend_string *key)
+{
+	uint32_t off;
+
+	for (off = data->buckets[slot].head; off; ) {
+		ps_shm_sd *sd = PS_SHM_PTR(data, off);
+
+		if (sd->hv == hv && sd->keylen == ZSTR_LEN(key)
+				&& !memcmp((char *)(sd + 1), ZSTR_VAL(key), sd->keylen)) {
+			return off;
+		}
+		off = sd->next;
+	}
+
+	return 0;
+}
+
+/* Remove a record from its chain; the caller must hold the bucket lock.
+ * Returns false when the record is no longer on the chain. */
+static bool ps_shm_sd_unlink(ps_shm *data, uint32_t slot, uint32_t sd_off)
+{
+	uint32_t *prev = &data->buckets[slot].head;
+	uint32_t off;
+
+	for (off = *prev; off; ) {
+		ps_shm_sd *sd = PS_SHM_PTR(data, off);
+
+		if (off == sd_off) {
+			*prev = sd->next;
+			return true;
+		}
+		prev = &sd->next;
+		off = sd->next;
+	}
+
+	return false;
+}
+
+/* Free the least recently used record to make room, approximating LRU
+ * across all buckets. locked_slot is the bucket the caller already holds;
+ * other buckets are only trylocked so two writers evicting at the same
+ * time cannot deadlock on each other's bucket. */
+static bool ps_shm_evict(ps_shm *data, uint32_t locked_slot)
+{
+	int attempts = PS_SHM_EVICT_ATTEMPTS;
+
+	while (attempts-- > 0) {
+		uint32_t best_slot = 0, best_off = 0, slot, off;
+		time_t best_atime = 0;
+		bool found = false;
+
+		for (slot = 0; slot < PS_SHM_BUCKETS; slot++) {
+			if (slot != locked_slot && !ps_shm_trylock(&data->buckets[slot].lock)) {
+				continue;
+			}
+			for (off = data->buckets[slot].head; off; ) {
+				ps_shm_sd *sd = PS_SHM_PTR(data, off);
+
+				if (!found || sd->atime < best_atime) {
+					found = true;
+					best_slot = slot;
+					best_off = off;
+					best_atime = sd->atime;
+				}
+				off = sd->next;
+			}
+			if (slot != locked_slot) {
+				ps_shm_unlock(&data->buckets[slot].lock);
+			}
+		}
+
+		if (!found) {
+			return false;
+		}
+
+		if (best_slot == locked_slot) {
+			if (ps_shm_sd_unlink(data, best_slot, best_off)) {
+				ps_shm_heap_free(data, best_off);
+				return true;
+			}
+			continue;
+		}
+
+		if (!ps_shm_trylock(&data->buckets[best_slot].lock)) {
+			continue;
+		}
+		/* The candidate may have been removed while the bucket was
+		 * unlocked; unlinking verifies it is still on the chain. */
+		found = ps_shm_sd_unlink(data, best_slot, best_off);
+		ps_shm_unlock(&data->buckets[best_slot].lock);
+		if (found) {
+			ps_shm_heap_free(data, best_off);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool ps_shm_key_exists(ps_shm *data, const zend_string *key)
+{
+	uint32_t hv, slot, off;
+
+	if (!key) {
+		return false;
+	}
+	hv = ps_shm_hash(key);
+	slot = hv & (PS_SHM_BUCKETS - 1);
+
+	ps_shm_lock(&data->buckets[slot].lock);
+	off = ps_shm_sd_lookup(data, slot, hv, key);
+	ps_shm_unlock(&data->buckets[slot].lock);
+
+	return off != 0;
+}
+
+PHP_MINIT_FUNCTION(ps_shm)
+{
+	size_t segsize;
+	ps_shm *data;
+	ps_shm_block *heap;
+	uint32_t heap_off;
+
+	/* The handler stays selectable either way; without a segment, selecting
+	 * it simply fails at open time. */
+	php_session_register_module(&ps_mod_shm);
+
+	if (PS(shm_size) <= 0) {
+		/* Disabled: don't map a segment deployments may never use. */
+		return SUCCESS;
+	}
+	if (PS(shm_size) < PS_SHM_MIN_SIZE) {
+		segsize = PS_SHM_MIN_SIZE;
+	} else if ((zend_ulong) PS(shm_size) > UINT32_MAX - PS_SHM_ALIGNMENT) {
+		/* Offsets are 32 bit wide */
+		segsize = UINT32_MAX - PS_SHM_ALIGNMENT + 1;
+	} else {
+		segsize = PS_SHM_ALIGN((size_t) PS(shm_size));
+	}
+
+	data = mmap(NULL, segsize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (data == MAP_FAILED) {
+		php_error_docref(NULL, E_WARNING,
+				"Cannot create shared memory session segment of %zu bytes", segsize);
+		return SUCCESS;
+	}
+
+	/* The anonymous mapping is zero filled, so all locks start released
+	 * and all chains empty; only the heap needs explicit setup. */
+	heap_off = (uint32_t) PS_SHM_ALIGN(sizeof(ps_shm));
+	heap = PS_SHM_PTR(data, heap_off);
+	heap->size = (uint32_t) segsize - heap_off;
+	heap->next = 0;
+
+	data->segsize = (uint32_t) segsize;
+	data->free_head = heap_off;
+	data->owner = getpid();
+
+	ps_shm_instance = data;
+	ps_shm_instance_size = segsize;
+
+	return SUCCESS;
+}
+
+PHP_MSHUTDOWN_FUNCTION(ps_shm)
+{
+	if (ps_shm_instance) {
+		/* Only the process that created the mapping tears it down;
+		 * workers just exit and drop their reference. */
+		if (ps_shm_instance->owner == getpid()) {
+			munmap(ps_shm_instance, ps_shm_instance_size);
+		}
+		ps_shm_instance = NULL;
+	}
+
+	return SUCCESS;
+}
+
+PS_OPEN_FUNC(shm)
+{
+	if (!ps_shm_instance) {
+		return FAILURE;
+	}
+	PS_SET_MOD_DATA(ps_shm_instance);
+
+	return SUCCESS;
+}
+
+PS_CLOSE_FUNC(shm)
+{
+	PS_SET_MOD_DATA(NULL);
+
+	return SUCCESS;
+}
+
+PS_READ_FUNC(shm)
+{
+	PS_SHM_DATA;
+	uint32_t hv, slot, off;
+	zend_result ret = FAILURE;
+
+	/* If there is an ID and strict mode, verify existence */
+	if (PS(use_strict_mode) && !ps_shm_key_exists(data, key)) {
+		/* key points to PS(id), but cannot change here. */
+		if (key) {
+			efree(PS(id));
+			PS(id) = NULL;
+		}
+		PS(id) = PS(mod)->s_create_sid((void **)&data);
+		if (!PS(id)) {
+			return FAILURE;
+		}
+		if (PS(use_cookies)) {
+			PS(send_cookie) = 1;
+		}
+		php_session_reset_id();
+		PS(session_status) = php_session_active;
+	}
+
+	hv = ps_shm_hash(PS(id));
+	slot = hv & (PS_SHM_BUCKETS - 1);
+
+	ps_shm_lock(&data->buckets[slot].lock);
+
+	off = ps_shm_sd_lookup(data, slot, hv, PS(id));
+	if (off) {
+		ps_shm_sd *sd = PS_SHM_PTR(data, off);
+
+		*val = zend_string_init((char *)(sd + 1) + sd->keylen, sd->datalen, 0);
+		time(&sd->atime);
+		ret = SUCCESS;
+	}
+
+	ps_shm_unlock(&data->buckets[slot].lock);
+
+	return ret;
+}
+
+PS_WRITE_FUNC(shm)
+{
+	PS_SHM_DATA;
+	uint32_t hv = ps_shm_hash(key);
+	uint32_t slot = hv & (PS_SHM_BUCKETS - 1);
+	uint32_t old_off, new_off;
+	ps_shm_sd *sd;
+
+	ps_shm_lock(&data->buckets[slot].lock);
+
+	old_off = ps_shm_sd_lookup(data, slot, hv, key);
+	if (old_off) {
+		sd = PS_SHM_PTR(data, old_off);
+		if (ps_shm_sd_capacity(data, old_off, sd) >= ZSTR_LEN(val)) {
+			sd->datalen = (uint32_t) ZSTR_LEN(val);
+			memcpy((char *)(sd + 1) + sd->keylen, ZSTR_VAL(val), ZSTR_LEN(val));
+			time(&sd->atime);
+			ps_shm_unlock(&data->buckets[slot].lock);
+			return SUCCESS;
+		}
+	}
+
+	new_off = ps_shm_heap_alloc(data, sizeof(ps_shm_sd) + ZSTR_LEN(key) + ZSTR_LEN(val));
+	while (!new_off && ps_shm_evict(data, slot)) {
+		new_off = ps_shm_heap_alloc(data, sizeof(ps_shm_sd) + ZSTR_LEN(key) + ZSTR_LEN(val));
+	}
+	if (!new_off) {
+		ps_shm_unlock(&data->buckets[slot].lock);
+		php_error_docref(NULL, E_WARNING, "Shared memory session segment is full");
+		return FAILURE;
+	}
+
+	sd = PS_SHM_PTR(data, new_off);
+	sd->hv = hv;
+	sd->keylen = (uint32_t) ZSTR_LEN(key);
+	sd->datalen = (uint32_t) ZSTR_LEN(val);
+	memcpy((char *)(sd + 1), ZSTR_VAL(key), ZSTR_LEN(key));
+	memcpy((char *)(sd + 1) + ZSTR_LEN(key), ZSTR_VAL(val), ZSTR_LEN(val));
+	time(&sd->atime);
+
+	if (old_off) {
+		ps_shm_sd_unlink(data, slot, old_off);
+	}
+	sd->next = data->buckets[slot].head;
+	data->buckets[slot].head = new_off;
+
+	ps_shm_unlock(&data->buckets[slot].lock);
+
+	if (old_off) {
+		ps_shm_heap_free(data, old_off);
+	}
+
+	return SUCCESS;
+}
+
+PS_DESTROY_FUNC(shm)
+{
+	PS_SHM_DATA;
+	uint32_t hv = ps_shm_hash(key);
+	uint32_t slot = hv & (PS_SHM_BUCKETS - 1);
+	uint32_t off;
+
+	ps_shm_lock(&data->buckets[slot].lock);
+
+	off = ps_shm_sd_lookup(data, slot, hv, key);
+	if (off) {
+		ps_shm_sd_unlink(data, slot, off);
+	}
+
+	ps_shm_unlock(&data->buckets[slot].lock);
+
+	if (off) {
+		ps_shm_heap_free(data, off);
+	}
+
+	return SUCCESS;
+}
+
+PS_GC_FUNC(shm)
+{
+	PS_SHM_DATA;
+	time_t limit;
+	uint32_t slot;
+
+	*nrdels = 0;
+
+	time(&limit);
+	limit -= maxlifetime;
+
+	for (slot = 0; slot < PS_SHM_BUCKETS; slot++) {
+		uint32_t *prev, off;
+
+		ps_shm_lock(&data->buckets[slot].lock);
+
+		prev = &data->buckets[slot].head;
+		for (off = *prev; off; ) {
+			ps_shm_sd *sd = PS_SHM_PTR(data, off);
+			uint32_t next = sd->next;
+
+			if (sd->atime < limit) {
+				*prev = next;
+				ps_shm_heap_free(data, off);
+				(*nrdels)++;
+			} else {
+				prev = &sd->next;
+			}
+			off = next;
+		}
+
+		ps_shm_unlock(&data->buckets[slot].lock);
+	}
+
+	return *nrdels;
+}
+
+PS_CREATE_SID_FUNC(shm)
+{
+	zend_string *sid;
+	int maxfail = 3;
+	PS_SHM_DATA;
+
+	do {
+		sid = php_session_create_id((void **)&data);
+		/* Check collision */
+		if (sid && ps_shm_key_exists(data, sid)) {
+			zend_string_release_ex(sid, 0);
+			sid = NULL;
+			if (!(maxfail--)) {
+				return NULL;
+			}
+		}
+	} while (!sid);
+
+	return sid;
+}
+
+PS_VALIDATE_SID_FUNC(shm)
+{
+	PS_SHM_DATA;
+
+	return ps_shm_key_exists(data, key) ? SUCCESS : FAILURE;
+}
+
+PS_UPDATE_TIMESTAMP_FUNC(shm)
+{
+	PS_SHM_DATA;
+	uint32_t hv = ps_shm_hash(key);
+	uint32_t slot = hv & (PS_SHM_BUCKETS - 1);
+	uint32_t off;
+
+	ps_shm_lock(&data->buckets[slot].lock);
+
+	off = ps_shm_sd_lookup(data, slot, hv, key);
+	if (off) {
+		ps_shm_sd *sd = PS_SHM_PTR(data, off);
+		time(&sd->atime);
+	}
+
+	ps_shm_unlock(&data->buckets[slot].lock);
+
+	return off ? SUCCESS : FAILURE;
+}
+
+const ps_module ps_mod_shm = {
+	PS_MOD_UPDATE_TIMESTAMP(shm)
+};
+
+#endif
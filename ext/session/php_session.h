@@ -163,6 +163,7 @@ typedef struct _php_ps_globals {
 	zend_long gc_divisor;
 	zend_long gc_maxlifetime;
 	zend_long cache_expire;
+	zend_long shm_size;
 	struct {
 		zval ps_open;
 		zval ps_close;
@@ -55,6 +55,8 @@
 #include "mod_mm.h"
 #endif
 
+#include "mod_shm.h"
+
 PHPAPI ZEND_DECLARE_MODULE_GLOBALS(ps)
 
 static zend_result php_session_rfc1867_callback(unsigned int event, void *event_data, void **extra);
@@ -831,6 +833,7 @@ PHP_INI_BEGIN()
 	PHP_INI_ENTRY("session.sid_length",             "32",        PHP_INI_ALL, OnUpdateSidLength)
 	PHP_INI_ENTRY("session.sid_bits_per_character", "4",         PHP_INI_ALL, OnUpdateSidBits)
 	STD_PHP_INI_BOOLEAN("session.lazy_write",       "1",         PHP_INI_ALL, OnUpdateSessionBool,    lazy_write,         php_ps_globals,    ps_globals)
+	STD_PHP_INI_ENTRY("session.shm_size",           "8388608",   PHP_INI_SYSTEM, OnUpdateLong,       shm_size,           php_ps_globals,    ps_globals)
 
 	/* Upload progress */
 	STD_PHP_INI_BOOLEAN("session.upload_progress.enabled",
@@ -2907,6 +2910,9 @@ static PHP_MINIT_FUNCTION(session) /* {{{ */
 
 #ifdef HAVE_LIBMM
 	PHP_MINIT(ps_mm) (INIT_FUNC_ARGS_PASSTHRU);
+#endif
+#if defined(HAVE_MMAP) && !defined(PHP_WIN32)
+	PHP_MINIT(ps_shm) (INIT_FUNC_ARGS_PASSTHRU);
 #endif
 	php_session_rfc1867_orig_callback = php_rfc1867_callback;
 	php_rfc1867_callback = php_session_rfc1867_callback;
@@ -2934,6 +2940,9 @@ static PHP_MSHUTDOWN_FUNCTION(session) /* {{{ */
 #ifdef HAVE_LIBMM
 	PHP_MSHUTDOWN(ps_mm) (SHUTDOWN_FUNC_ARGS_PASSTHRU);
 #endif
+#if defined(HAVE_MMAP) && !defined(PHP_WIN32)
+	PHP_MSHUTDOWN(ps_shm) (SHUTDOWN_FUNC_ARGS_PASSTHRU);
+#endif
 
 	/* reset rfc1867 callbacks */
 	php_session_rfc1867_orig_callback = NULL;
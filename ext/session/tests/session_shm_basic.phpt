@@ -0,0 +1,52 @@
+--TEST--
+Session shm save handler: write, read back, destroy
+--INI--
+session.save_handler=shm
+session.name=PHPSESSID
+--EXTENSIONS--
+session
+--SKIPIF--
+<?php
+include('skipif.inc');
+if (@session_module_name("shm") === false) {
+    die("skip shm save handler not available");
+}
+?>
+--FILE--
+<?php
+
+ob_start();
+
+var_dump(session_module_name());
+
+var_dump(session_start());
+$_SESSION['foo'] = 'bar';
+$_SESSION['num'] = 42;
+$id = session_id();
+var_dump(session_commit());
+
+session_id($id);
+var_dump(session_start());
+var_dump($_SESSION['foo']);
+var_dump($_SESSION['num']);
+
+var_dump(session_destroy());
+
+session_id($id);
+var_dump(session_start());
+var_dump($_SESSION);
+session_destroy();
+
+ob_end_flush();
+?>
+--EXPECT--
+string(3) "shm"
+bool(true)
+bool(true)
+bool(true)
+string(3) "bar"
+int(42)
+bool(true)
+bool(true)
+array(0) {
+}
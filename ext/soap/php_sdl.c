@@ -27,6 +27,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#ifdef HAVE_MMAP
+# include <sys/mman.h>
+#endif
 
 #ifndef O_BINARY
 # define O_BINARY 0
@@ -1517,6 +1520,17 @@ static HashTable* sdl_deserialize_parameters(encodePtr *encoders, sdlTypePtr *ty
 	return ht;
 }
 
+static void sdl_cache_release(char *buf, size_t size, bool mapped)
+{
+#ifdef HAVE_MMAP
+	if (mapped) {
+		munmap(buf, size);
+		return;
+	}
+#endif
+	efree(buf);
+}
+
 static sdlPtr get_sdl_from_cache(const char *fn, const char *uri, size_t uri_len, time_t t, time_t *cached)
 {
 	sdlPtr sdl;
@@ -1531,26 +1545,38 @@ static sdlPtr get_sdl_from_cache(const char *fn, const char *uri, size_t uri_len
 	int f;
 	struct stat st;
 	char *in, *buf;
+	bool mapped = false;
 
 	f = open(fn, O_RDONLY|O_BINARY);
 	if (f < 0) {
 		return NULL;
 	}
-	if (fstat(f, &st) != 0) {
+	if (fstat(f, &st) != 0 || st.st_size < 6 + (off_t)sizeof(time_t)) {
 		close(f);
 		return NULL;
 	}
-	buf = in = emalloc(st.st_size);
-	if (read(f, in, st.st_size) != st.st_size) {
+#ifdef HAVE_MMAP
+	/* Map the cache file read-only: workers deserializing the same WSDL
+	 * share the page cache instead of each making a private copy */
+	buf = in = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, f, 0);
+	if (buf != MAP_FAILED) {
+		mapped = true;
+		close(f);
+	} else
+#endif
+	{
+		buf = in = emalloc(st.st_size);
+		if (read(f, in, st.st_size) != st.st_size) {
+			close(f);
+			efree(in);
+			return NULL;
+		}
 		close(f);
-		efree(in);
-		return NULL;
 	}
-	close(f);
 
 	if (strncmp(in,"wsdl",4) != 0 || in[4] != WSDL_CACHE_VERSION || in[5] != '\0') {
 		unlink(fn);
-		efree(buf);
+		sdl_cache_release(buf, st.st_size, mapped);
 		return NULL;
 	}
 	in += 6;
@@ -1558,7 +1584,7 @@ static sdlPtr get_sdl_from_cache(const char *fn, const char *uri, size_t uri_len
 	WSDL_CACHE_GET(old_t, time_t, &in);
 	if (old_t < t) {
 		unlink(fn);
-		efree(buf);
+		sdl_cache_release(buf, st.st_size, mapped);
 		return NULL;
 	}
 	*cached = old_t;
@@ -1566,7 +1592,7 @@ static sdlPtr get_sdl_from_cache(const char *fn, const char *uri, size_t uri_len
 	WSDL_CACHE_GET_INT(i, &in);
 	if (i != uri_len || strncmp(in, uri, i) != 0) {
 		unlink(fn);
-		efree(buf);
+		sdl_cache_release(buf, st.st_size, mapped);
 		return NULL;
 	}
 	WSDL_CACHE_SKIP(i, &in);
@@ -1765,7 +1791,7 @@ static sdlPtr get_sdl_from_cache(const char *fn, const char *uri, size_t uri_len
 	efree(bindings);
 	efree(encoders);
 	efree(types);
-	efree(buf);
+	sdl_cache_release(buf, st.st_size, mapped);
 	return sdl;
 }
 
@@ -110,6 +110,10 @@ struct	sockaddr_un {
 ZEND_BEGIN_MODULE_GLOBALS(sockets)
 	int last_error;
 	char *strerror_buf;
+	/* reusable receive buffer for large socket_recvfrom() length requests;
+	 * grown on demand, released in RSHUTDOWN */
+	char *recv_scratch;
+	size_t recv_scratch_size;
 #ifdef PHP_WIN32
 	uint32_t wsa_child_count;
 	HashTable wsa_info;
@@ -403,6 +403,8 @@ static PHP_GINIT_FUNCTION(sockets)
 #endif
 	sockets_globals->last_error = 0;
 	sockets_globals->strerror_buf = NULL;
+	sockets_globals->recv_scratch = NULL;
+	sockets_globals->recv_scratch_size = 0;
 #ifdef PHP_WIN32
 	sockets_globals->wsa_child_count = 0;
 	zend_hash_init(&sockets_globals->wsa_info, 0, NULL, sockets_destroy_wsa_info, 1);
@@ -482,6 +484,11 @@ static PHP_RSHUTDOWN_FUNCTION(sockets)
 		efree(SOCKETS_G(strerror_buf));
 		SOCKETS_G(strerror_buf) = NULL;
 	}
+	if (SOCKETS_G(recv_scratch)) {
+		efree(SOCKETS_G(recv_scratch));
+		SOCKETS_G(recv_scratch) = NULL;
+		SOCKETS_G(recv_scratch_size) = 0;
+	}
 
 	return SUCCESS;
 }
@@ -1365,6 +1372,7 @@ PHP_FUNCTION(socket_recvfrom)
 	zend_long				arg3, arg4;
 	const char			*address;
 	zend_string			*recv_buf;
+	char				*recv_place;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "Ozllz|z", &arg1, socket_ce, &arg2, &arg3, &arg4, &arg5, &arg6) == FAILURE) {
 		RETURN_THROWS();
@@ -1379,7 +1387,22 @@ PHP_FUNCTION(socket_recvfrom)
 		RETURN_FALSE;
 	}
 
-	recv_buf = zend_string_alloc(arg3 + 1, 0);
+	/* A datagram receive typically asks for the maximum packet size but gets
+	 * a much smaller packet, so large requests receive into a reusable
+	 * scratch buffer and the returned string is sized to the actual packet:
+	 * tight receive loops avoid a large allocation per call and the caller
+	 * is not handed oversized strings. */
+	if (arg3 + 1 > 4096) {
+		if (SOCKETS_G(recv_scratch_size) < (size_t) arg3 + 1) {
+			SOCKETS_G(recv_scratch) = erealloc(SOCKETS_G(recv_scratch), arg3 + 1);
+			SOCKETS_G(recv_scratch_size) = arg3 + 1;
+		}
+		recv_buf = NULL;
+		recv_place = SOCKETS_G(recv_scratch);
+	} else {
+		recv_buf = zend_string_alloc(arg3 + 1, 0);
+		recv_place = ZSTR_VAL(recv_buf);
+	}
 
 	switch (php_sock->type) {
 		case AF_UNIX:
@@ -1387,15 +1410,21 @@ PHP_FUNCTION(socket_recvfrom)
 			memset(&s_un, 0, slen);
 			s_un.sun_family = AF_UNIX;
 
-			retval = recvfrom(php_sock->bsd_socket, ZSTR_VAL(recv_buf), arg3, arg4, (struct sockaddr *)&s_un, (socklen_t *)&slen);
+			retval = recvfrom(php_sock->bsd_socket, recv_place, arg3, arg4, (struct sockaddr *)&s_un, (socklen_t *)&slen);
 
 			if (retval < 0) {
 				PHP_SOCKET_ERROR(php_sock, "Unable to recvfrom", errno);
-				zend_string_efree(recv_buf);
+				if (recv_buf) {
+					zend_string_efree(recv_buf);
+				}
 				RETURN_FALSE;
 			}
-			ZSTR_LEN(recv_buf) = retval;
-			ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			if (recv_buf) {
+				ZSTR_LEN(recv_buf) = retval;
+				ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			} else {
+				recv_buf = zend_string_init(recv_place, retval, 0);
+			}
 
 			ZEND_TRY_ASSIGN_REF_NEW_STR(arg2, recv_buf);
 			ZEND_TRY_ASSIGN_REF_STRING(arg5, s_un.sun_path);
@@ -1407,19 +1436,27 @@ PHP_FUNCTION(socket_recvfrom)
 			sin.sin_family = AF_INET;
 
 			if (arg6 == NULL) {
-				zend_string_efree(recv_buf);
+				if (recv_buf) {
+					zend_string_efree(recv_buf);
+				}
 				WRONG_PARAM_COUNT;
 			}
 
-			retval = recvfrom(php_sock->bsd_socket, ZSTR_VAL(recv_buf), arg3, arg4, (struct sockaddr *)&sin, (socklen_t *)&slen);
+			retval = recvfrom(php_sock->bsd_socket, recv_place, arg3, arg4, (struct sockaddr *)&sin, (socklen_t *)&slen);
 
 			if (retval < 0) {
 				PHP_SOCKET_ERROR(php_sock, "Unable to recvfrom", errno);
-				zend_string_efree(recv_buf);
+				if (recv_buf) {
+					zend_string_efree(recv_buf);
+				}
 				RETURN_FALSE;
 			}
-			ZSTR_LEN(recv_buf) = retval;
-			ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			if (recv_buf) {
+				ZSTR_LEN(recv_buf) = retval;
+				ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			} else {
+				recv_buf = zend_string_init(recv_place, retval, 0);
+			}
 
 			address = inet_ntop(AF_INET, &sin.sin_addr, addrbuf, sizeof(addrbuf));
 
@@ -1434,19 +1471,27 @@ PHP_FUNCTION(socket_recvfrom)
 			sin6.sin6_family = AF_INET6;
 
 			if (arg6 == NULL) {
-				zend_string_efree(recv_buf);
+				if (recv_buf) {
+					zend_string_efree(recv_buf);
+				}
 				WRONG_PARAM_COUNT;
 			}
 
-			retval = recvfrom(php_sock->bsd_socket, ZSTR_VAL(recv_buf), arg3, arg4, (struct sockaddr *)&sin6, (socklen_t *)&slen);
+			retval = recvfrom(php_sock->bsd_socket, recv_place, arg3, arg4, (struct sockaddr *)&sin6, (socklen_t *)&slen);
 
 			if (retval < 0) {
 				PHP_SOCKET_ERROR(php_sock, "unable to recvfrom", errno);
-				zend_string_efree(recv_buf);
+				if (recv_buf) {
+					zend_string_efree(recv_buf);
+				}
 				RETURN_FALSE;
 			}
-			ZSTR_LEN(recv_buf) = retval;
-			ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			if (recv_buf) {
+				ZSTR_LEN(recv_buf) = retval;
+				ZSTR_VAL(recv_buf)[ZSTR_LEN(recv_buf)] = '\0';
+			} else {
+				recv_buf = zend_string_init(recv_place, retval, 0);
+			}
 
 			memset(addrbuf, 0, INET6_ADDRSTRLEN);
 			inet_ntop(AF_INET6, &sin6.sin6_addr,  addrbuf, sizeof(addrbuf));
@@ -1457,6 +1502,9 @@ PHP_FUNCTION(socket_recvfrom)
 			break;
 #endif
 		default:
+			if (recv_buf) {
+				zend_string_efree(recv_buf);
+			}
 			zend_argument_value_error(1, "must be one of AF_UNIX, AF_INET, or AF_INET6");
 			RETURN_THROWS();
 	}
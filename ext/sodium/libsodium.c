@@ -1865,6 +1865,190 @@ PHP_FUNCTION(sodium_crypto_aead_aes256gcm_decrypt)
 
 	RETURN_NEW_STR(msg);
 }
+
+PHP_FUNCTION(sodium_crypto_aead_aes256gcm_encrypt_batch)
+{
+	crypto_aead_aes256gcm_state state;
+	HashTable          *messages;
+	unsigned char       npub_cur[crypto_aead_aes256gcm_NPUBBYTES];
+	unsigned char      *ad;
+	unsigned char      *npub;
+	unsigned char      *secretkey;
+	size_t              ad_len;
+	size_t              npub_len;
+	size_t              secretkey_len;
+	zend_string        *arr_key;
+	zend_ulong          num_key;
+	zval               *msg_zv;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsss",
+									&messages,
+									&ad, &ad_len,
+									&npub, &npub_len,
+									&secretkey, &secretkey_len) == FAILURE) {
+		sodium_remove_param_values_from_backtrace(EG(exception));
+		RETURN_THROWS();
+	}
+	if (npub_len != crypto_aead_aes256gcm_NPUBBYTES) {
+		zend_argument_error(sodium_exception_ce, 3, "must be SODIUM_CRYPTO_AEAD_AES256GCM_NPUBBYTES bytes long");
+		RETURN_THROWS();
+	}
+	if (secretkey_len != crypto_aead_aes256gcm_KEYBYTES) {
+		zend_argument_error(sodium_exception_ce, 4, "must be SODIUM_CRYPTO_AEAD_AES256GCM_KEYBYTES bytes long");
+		RETURN_THROWS();
+	}
+	/* Expand the key once for the whole batch; every message gets its own
+	 * nonce by incrementing the caller-supplied one, as a single (key, nonce)
+	 * pair must never encrypt two messages. */
+	crypto_aead_aes256gcm_beforenm(&state, secretkey);
+	memcpy(npub_cur, npub, sizeof npub_cur);
+
+	array_init_size(return_value, zend_hash_num_elements(messages));
+	ZEND_HASH_FOREACH_KEY_VAL(messages, num_key, arr_key, msg_zv) {
+		zend_string        *ciphertext;
+		unsigned long long  ciphertext_real_len;
+		size_t              ciphertext_len;
+		size_t              msg_len;
+		zval                tmp;
+
+		ZVAL_DEREF(msg_zv);
+		if (Z_TYPE_P(msg_zv) != IS_STRING) {
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_argument_error(sodium_exception_ce, 1, "must only contain strings");
+			RETURN_THROWS();
+		}
+		msg_len = Z_STRLEN_P(msg_zv);
+		if (SIZE_MAX - msg_len <= crypto_aead_aes256gcm_ABYTES ||
+			(unsigned long long) msg_len > (16ULL * ((1ULL << 32) - 2ULL)) - crypto_aead_aes256gcm_ABYTES) {
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_throw_exception(sodium_exception_ce, "message too long for a single key", 0);
+			RETURN_THROWS();
+		}
+		ciphertext_len = msg_len + crypto_aead_aes256gcm_ABYTES;
+		ciphertext = zend_string_alloc(ciphertext_len, 0);
+		if (crypto_aead_aes256gcm_encrypt_afternm
+			((unsigned char *) ZSTR_VAL(ciphertext), &ciphertext_real_len,
+			 (unsigned char *) Z_STRVAL_P(msg_zv), (unsigned long long) msg_len,
+			 ad, (unsigned long long) ad_len, NULL, npub_cur,
+			 (const crypto_aead_aes256gcm_state *) &state) != 0 ||
+			ciphertext_real_len <= 0U || ciphertext_real_len >= SIZE_MAX ||
+			ciphertext_real_len > ciphertext_len) {
+			zend_string_efree(ciphertext);
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_throw_exception(sodium_exception_ce, "internal error", 0);
+			RETURN_THROWS();
+		}
+		PHP_SODIUM_ZSTR_TRUNCATE(ciphertext, (size_t) ciphertext_real_len);
+		ZSTR_VAL(ciphertext)[ciphertext_real_len] = 0;
+
+		ZVAL_NEW_STR(&tmp, ciphertext);
+		if (arr_key) {
+			zend_hash_update(Z_ARRVAL_P(return_value), arr_key, &tmp);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), num_key, &tmp);
+		}
+		sodium_increment(npub_cur, sizeof npub_cur);
+	} ZEND_HASH_FOREACH_END();
+	sodium_memzero(&state, sizeof state);
+}
+
+PHP_FUNCTION(sodium_crypto_aead_aes256gcm_decrypt_batch)
+{
+	crypto_aead_aes256gcm_state state;
+	HashTable          *ciphertexts;
+	unsigned char       npub_cur[crypto_aead_aes256gcm_NPUBBYTES];
+	unsigned char      *ad;
+	unsigned char      *npub;
+	unsigned char      *secretkey;
+	size_t              ad_len;
+	size_t              npub_len;
+	size_t              secretkey_len;
+	zend_string        *arr_key;
+	zend_ulong          num_key;
+	zval               *ciphertext_zv;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsss",
+									&ciphertexts,
+									&ad, &ad_len,
+									&npub, &npub_len,
+									&secretkey, &secretkey_len) == FAILURE) {
+		sodium_remove_param_values_from_backtrace(EG(exception));
+		RETURN_THROWS();
+	}
+	if (npub_len != crypto_aead_aes256gcm_NPUBBYTES) {
+		zend_argument_error(sodium_exception_ce, 3, "must be SODIUM_CRYPTO_AEAD_AES256GCM_NPUBBYTES bytes long");
+		RETURN_THROWS();
+	}
+	if (secretkey_len != crypto_aead_aes256gcm_KEYBYTES) {
+		zend_argument_error(sodium_exception_ce, 4, "must be SODIUM_CRYPTO_AEAD_AES256GCM_KEYBYTES bytes long");
+		RETURN_THROWS();
+	}
+	crypto_aead_aes256gcm_beforenm(&state, secretkey);
+	memcpy(npub_cur, npub, sizeof npub_cur);
+
+	array_init_size(return_value, zend_hash_num_elements(ciphertexts));
+	ZEND_HASH_FOREACH_KEY_VAL(ciphertexts, num_key, arr_key, ciphertext_zv) {
+		zend_string        *msg;
+		unsigned long long  msg_real_len;
+		size_t              ciphertext_len;
+		size_t              msg_len;
+		zval                tmp;
+
+		ZVAL_DEREF(ciphertext_zv);
+		if (Z_TYPE_P(ciphertext_zv) != IS_STRING) {
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_argument_error(sodium_exception_ce, 1, "must only contain strings");
+			RETURN_THROWS();
+		}
+		ciphertext_len = Z_STRLEN_P(ciphertext_zv);
+		if (ciphertext_len >= crypto_aead_aes256gcm_ABYTES &&
+			ciphertext_len - crypto_aead_aes256gcm_ABYTES > 16ULL * ((1ULL << 32) - 2ULL)) {
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_argument_error(sodium_exception_ce, 1, "contains an element that is too long");
+			RETURN_THROWS();
+		}
+		if (ciphertext_len < crypto_aead_aes256gcm_ABYTES) {
+			/* too short to carry a tag; report it like a failed decryption */
+			ZVAL_FALSE(&tmp);
+			goto store;
+		}
+		msg_len = ciphertext_len;
+		msg = zend_string_alloc(msg_len, 0);
+		if (crypto_aead_aes256gcm_decrypt_afternm
+			((unsigned char *) ZSTR_VAL(msg), &msg_real_len, NULL,
+			 (unsigned char *) Z_STRVAL_P(ciphertext_zv), (unsigned long long) ciphertext_len,
+			 ad, (unsigned long long) ad_len, npub_cur,
+			 (const crypto_aead_aes256gcm_state *) &state) != 0) {
+			zend_string_efree(msg);
+			ZVAL_FALSE(&tmp);
+			goto store;
+		}
+		if (msg_real_len >= SIZE_MAX || msg_real_len > msg_len) {
+			zend_string_efree(msg);
+			sodium_memzero(&state, sizeof state);
+			zval_ptr_dtor(return_value);
+			zend_throw_exception(sodium_exception_ce, "arithmetic overflow", 0);
+			RETURN_THROWS();
+		}
+		PHP_SODIUM_ZSTR_TRUNCATE(msg, (size_t) msg_real_len);
+		ZSTR_VAL(msg)[msg_real_len] = 0;
+		ZVAL_NEW_STR(&tmp, msg);
+
+store:
+		if (arr_key) {
+			zend_hash_update(Z_ARRVAL_P(return_value), arr_key, &tmp);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), num_key, &tmp);
+		}
+		sodium_increment(npub_cur, sizeof npub_cur);
+	} ZEND_HASH_FOREACH_END();
+	sodium_memzero(&state, sizeof state);
+}
 #endif
 
 #ifdef crypto_aead_aegis128l_KEYBYTES
@@ -550,6 +550,12 @@ function sodium_crypto_aead_aes256gcm_decrypt(string $ciphertext, string $additi
 
 function sodium_crypto_aead_aes256gcm_encrypt(#[\SensitiveParameter] string $message, string $additional_data, string $nonce, #[\SensitiveParameter] string $key): string {}
 
+/** @refcount 1 */
+function sodium_crypto_aead_aes256gcm_encrypt_batch(#[\SensitiveParameter] array $messages, string $additional_data, string $nonce, #[\SensitiveParameter] string $key): array {}
+
+/** @refcount 1 */
+function sodium_crypto_aead_aes256gcm_decrypt_batch(array $ciphertexts, string $additional_data, string $nonce, #[\SensitiveParameter] string $key): array {}
+
 function sodium_crypto_aead_aes256gcm_keygen(): string {}
 #endif
 
@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 89cbb449ee6146dc8d50ba4bb1e76f83444a2db2 */
+ * Stub hash: 4bd1eefe0a6b6fc8702529bfb140c4c50c135e1d */
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_sodium_crypto_aead_aes256gcm_is_available, 0, 0, _IS_BOOL, 0)
 ZEND_END_ARG_INFO()
@@ -22,6 +22,24 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_sodium_crypto_aead_aes256gcm_enc
 ZEND_END_ARG_INFO()
 #endif
 
+#if defined(HAVE_AESGCM)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_sodium_crypto_aead_aes256gcm_encrypt_batch, 0, 4, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, messages, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, additional_data, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, nonce, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+#endif
+
+#if defined(HAVE_AESGCM)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_sodium_crypto_aead_aes256gcm_decrypt_batch, 0, 4, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, ciphertexts, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, additional_data, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, nonce, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+#endif
+
 #if defined(HAVE_AESGCM)
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_sodium_crypto_aead_aes256gcm_keygen, 0, 0, IS_STRING, 0)
 ZEND_END_ARG_INFO()
@@ -559,6 +577,12 @@ ZEND_FUNCTION(sodium_crypto_aead_aes256gcm_decrypt);
 ZEND_FUNCTION(sodium_crypto_aead_aes256gcm_encrypt);
 #endif
 #if defined(HAVE_AESGCM)
+ZEND_FUNCTION(sodium_crypto_aead_aes256gcm_encrypt_batch);
+#endif
+#if defined(HAVE_AESGCM)
+ZEND_FUNCTION(sodium_crypto_aead_aes256gcm_decrypt_batch);
+#endif
+#if defined(HAVE_AESGCM)
 ZEND_FUNCTION(sodium_crypto_aead_aes256gcm_keygen);
 #endif
 #if defined(crypto_aead_aegis128l_KEYBYTES)
@@ -761,6 +785,12 @@ static const zend_function_entry ext_functions[] = {
 #if defined(HAVE_AESGCM)
 	ZEND_FE(sodium_crypto_aead_aes256gcm_encrypt, arginfo_sodium_crypto_aead_aes256gcm_encrypt)
 #endif
+#if defined(HAVE_AESGCM)
+	ZEND_FE(sodium_crypto_aead_aes256gcm_encrypt_batch, arginfo_sodium_crypto_aead_aes256gcm_encrypt_batch)
+#endif
+#if defined(HAVE_AESGCM)
+	ZEND_FE(sodium_crypto_aead_aes256gcm_decrypt_batch, arginfo_sodium_crypto_aead_aes256gcm_decrypt_batch)
+#endif
 #if defined(HAVE_AESGCM)
 	ZEND_FE(sodium_crypto_aead_aes256gcm_keygen, arginfo_sodium_crypto_aead_aes256gcm_keygen)
 #endif
@@ -0,0 +1,65 @@
+--TEST--
+Check for libsodium AES256-GCM batch AEAD
+--EXTENSIONS--
+sodium
+--SKIPIF--
+<?php
+if (!defined('SODIUM_CRYPTO_AEAD_AES256GCM_NPUBBYTES')) print "skip libsodium without AESGCM";
+if (!sodium_crypto_aead_aes256gcm_is_available()) print "skip AES256-GCM not available on this CPU";
+?>
+--FILE--
+<?php
+$messages = [];
+for ($i = 0; $i < 10; $i++) {
+    $messages[] = random_bytes(random_int(1, 1000));
+}
+$nonce = random_bytes(SODIUM_CRYPTO_AEAD_AES256GCM_NPUBBYTES);
+$key = sodium_crypto_aead_aes256gcm_keygen();
+$ad = random_bytes(random_int(1, 1000));
+
+$ciphertexts = sodium_crypto_aead_aes256gcm_encrypt_batch($messages, $ad, $nonce, $key);
+var_dump(count($ciphertexts));
+
+/* message $i is encrypted under the base nonce incremented $i times */
+$npub = $nonce;
+$ok = true;
+foreach ($ciphertexts as $i => $ciphertext) {
+    $expected = sodium_crypto_aead_aes256gcm_encrypt($messages[$i], $ad, $npub, $key);
+    $ok = $ok && hash_equals($expected, $ciphertext);
+    sodium_increment($npub);
+}
+var_dump($ok);
+
+$decrypted = sodium_crypto_aead_aes256gcm_decrypt_batch($ciphertexts, $ad, $nonce, $key);
+var_dump($decrypted === $messages);
+
+/* string keys are preserved */
+$keyed = sodium_crypto_aead_aes256gcm_encrypt_batch(['a' => 'one', 'b' => 'two'], '', $nonce, $key);
+var_dump(array_keys($keyed));
+
+/* a corrupted element decrypts to false without breaking the rest */
+$ciphertexts[3][0] = $ciphertexts[3][0] ^ "\xff";
+$decrypted = sodium_crypto_aead_aes256gcm_decrypt_batch($ciphertexts, $ad, $nonce, $key);
+var_dump($decrypted[3]);
+var_dump($decrypted[4] === $messages[4]);
+
+/* non-string elements are rejected */
+try {
+    sodium_crypto_aead_aes256gcm_encrypt_batch([42], $ad, $nonce, $key);
+} catch (SodiumException $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+int(10)
+bool(true)
+bool(true)
+array(2) {
+  [0]=>
+  string(1) "a"
+  [1]=>
+  string(1) "b"
+}
+bool(false)
+bool(true)
+sodium_crypto_aead_aes256gcm_encrypt_batch(): Argument #1 ($messages) must only contain strings
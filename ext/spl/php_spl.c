@@ -33,6 +33,7 @@
 #include "spl_observer.h"
 #include "spl_dllist.h"
 #include "spl_fixedarray.h"
+#include "spl_typedvector.h"
 #include "spl_heap.h"
 #include "zend_exceptions.h"
 #include "zend_interfaces.h"
@@ -569,6 +570,9 @@ PHP_FUNCTION(spl_autoload_register)
 		HT_MOVE_TAIL_TO_HEAD(spl_autoload_functions);
 	}
 
+	/* The new autoloader may succeed where previous ones failed. */
+	zend_reset_failed_autoload_cache();
+
 	RETURN_TRUE;
 } /* }}} */
 
@@ -729,6 +733,7 @@ PHP_MINIT_FUNCTION(spl)
 	PHP_MINIT(spl_dllist)(INIT_FUNC_ARGS_PASSTHRU);
 	PHP_MINIT(spl_heap)(INIT_FUNC_ARGS_PASSTHRU);
 	PHP_MINIT(spl_fixedarray)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(spl_typedvector)(INIT_FUNC_ARGS_PASSTHRU);
 	PHP_MINIT(spl_observer)(INIT_FUNC_ARGS_PASSTHRU);
 
 	return SUCCESS;
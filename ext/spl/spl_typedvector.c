@@ -0,0 +1,642 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | https://www.php.net/license/3_01.txt                                 |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "zend_exceptions.h"
+#include "zend_interfaces.h"
+#include "zend_operators.h"
+
+#include "php_spl.h"
+#include "spl_typedvector_arginfo.h"
+#include "spl_typedvector.h"
+#include "spl_exceptions.h"
+
+/* SplTypedVector is a preallocated, type-homogeneous vector.  Unlike
+ * SplFixedArray, which stores full 16-byte zvals, each element occupies a
+ * single 8-byte machine slot (zend_long, double or zend_string pointer), so a
+ * vector of n ints costs n * 8 bytes of contiguous memory and bulk operations
+ * walk a dense array of scalars instead of re-boxing zvals. */
+
+typedef enum {
+	SPL_TV_INT,
+	SPL_TV_FLOAT,
+	SPL_TV_STRING,
+} spl_typedvector_type;
+
+typedef struct _spl_typedvector_object {
+	spl_typedvector_type type;
+	zend_long            size;
+	union {
+		zend_long    *lvals;
+		double       *dvals;
+		zend_string **strs;
+		void         *raw;
+	} data;
+	zend_object          std;
+} spl_typedvector_object;
+
+static zend_object_handlers spl_handler_SplTypedVector;
+PHPAPI zend_class_entry *spl_ce_SplTypedVector;
+
+static inline spl_typedvector_object *spl_typedvector_from_obj(zend_object *obj)
+{
+	return (spl_typedvector_object*)((char*)(obj) - XtOffsetOf(spl_typedvector_object, std));
+}
+
+#define Z_SPLTYPEDVECTOR_P(zv)  spl_typedvector_from_obj(Z_OBJ_P((zv)))
+
+static const char *spl_typedvector_type_name(spl_typedvector_type type)
+{
+	switch (type) {
+		case SPL_TV_INT:
+			return "int";
+		case SPL_TV_FLOAT:
+			return "float";
+		case SPL_TV_STRING:
+			return "string";
+		EMPTY_SWITCH_DEFAULT_CASE();
+	}
+}
+
+static bool spl_typedvector_parse_type(const zend_string *name, spl_typedvector_type *type)
+{
+	if (zend_string_equals_literal(name, "int")) {
+		*type = SPL_TV_INT;
+	} else if (zend_string_equals_literal(name, "float")) {
+		*type = SPL_TV_FLOAT;
+	} else if (zend_string_equals_literal(name, "string")) {
+		*type = SPL_TV_STRING;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static void spl_typedvector_init_data(spl_typedvector_object *intern, zend_long size)
+{
+	if (size > 0) {
+		/* All element representations are 8 bytes; a zero-filled slot reads
+		 * back as 0, 0.0 or the empty string respectively. */
+		intern->data.raw = safe_emalloc(size, sizeof(zend_long), 0);
+		memset(intern->data.raw, 0, size * sizeof(zend_long));
+	} else {
+		intern->data.raw = NULL;
+	}
+	intern->size = size;
+}
+
+static zend_object *spl_typedvector_new(zend_class_entry *class_type)
+{
+	spl_typedvector_object *intern = zend_object_alloc(sizeof(spl_typedvector_object), class_type);
+
+	zend_object_std_init(&intern->std, class_type);
+	object_properties_init(&intern->std, class_type);
+
+	intern->type = SPL_TV_INT;
+	intern->size = 0;
+	intern->data.raw = NULL;
+
+	return &intern->std;
+}
+
+static void spl_typedvector_free_storage(zend_object *object)
+{
+	spl_typedvector_object *intern = spl_typedvector_from_obj(object);
+
+	if (intern->data.raw) {
+		if (intern->type == SPL_TV_STRING) {
+			for (zend_long i = 0; i < intern->size; i++) {
+				if (intern->data.strs[i]) {
+					zend_string_release(intern->data.strs[i]);
+				}
+			}
+		}
+		efree(intern->data.raw);
+	}
+
+	zend_object_std_dtor(&intern->std);
+}
+
+static zend_object *spl_typedvector_clone(zend_object *old_object)
+{
+	spl_typedvector_object *old = spl_typedvector_from_obj(old_object);
+	zend_object *new_object = spl_typedvector_new(old_object->ce);
+	spl_typedvector_object *new = spl_typedvector_from_obj(new_object);
+
+	new->type = old->type;
+	spl_typedvector_init_data(new, old->size);
+	if (old->size > 0) {
+		if (old->type == SPL_TV_STRING) {
+			for (zend_long i = 0; i < old->size; i++) {
+				new->data.strs[i] = old->data.strs[i] ? zend_string_copy(old->data.strs[i]) : NULL;
+			}
+		} else {
+			memcpy(new->data.raw, old->data.raw, old->size * sizeof(zend_long));
+		}
+	}
+
+	zend_objects_clone_members(new_object, old_object);
+
+	return new_object;
+}
+
+/* Stores a PHP value into slot index, enforcing the element type.  arg_num is
+ * the 1-based position of the value argument for error messages. */
+static zend_result spl_typedvector_store(spl_typedvector_object *intern, zend_long index, zval *value, uint32_t arg_num)
+{
+	switch (intern->type) {
+		case SPL_TV_INT:
+			if (Z_TYPE_P(value) != IS_LONG) {
+				zend_argument_type_error(arg_num, "must be of type int for an int vector, %s given", zend_zval_value_name(value));
+				return FAILURE;
+			}
+			intern->data.lvals[index] = Z_LVAL_P(value);
+			break;
+		case SPL_TV_FLOAT:
+			if (Z_TYPE_P(value) == IS_DOUBLE) {
+				intern->data.dvals[index] = Z_DVAL_P(value);
+			} else if (Z_TYPE_P(value) == IS_LONG) {
+				intern->data.dvals[index] = (double) Z_LVAL_P(value);
+			} else {
+				zend_argument_type_error(arg_num, "must be of type float for a float vector, %s given", zend_zval_value_name(value));
+				return FAILURE;
+			}
+			break;
+		case SPL_TV_STRING:
+			if (Z_TYPE_P(value) != IS_STRING) {
+				zend_argument_type_error(arg_num, "must be of type string for a string vector, %s given", zend_zval_value_name(value));
+				return FAILURE;
+			}
+			if (intern->data.strs[index]) {
+				zend_string_release(intern->data.strs[index]);
+			}
+			intern->data.strs[index] = zend_string_copy(Z_STR_P(value));
+			break;
+	}
+	return SUCCESS;
+}
+
+static void spl_typedvector_fetch(spl_typedvector_object *intern, zend_long index, zval *return_value)
+{
+	switch (intern->type) {
+		case SPL_TV_INT:
+			RETVAL_LONG(intern->data.lvals[index]);
+			break;
+		case SPL_TV_FLOAT:
+			RETVAL_DOUBLE(intern->data.dvals[index]);
+			break;
+		case SPL_TV_STRING:
+			if (intern->data.strs[index]) {
+				RETVAL_STR_COPY(intern->data.strs[index]);
+			} else {
+				RETVAL_EMPTY_STRING();
+			}
+			break;
+	}
+}
+
+PHP_METHOD(SplTypedVector, __construct)
+{
+	zend_string *type_name;
+	zend_long size = 0;
+	spl_typedvector_object *intern;
+	spl_typedvector_type type;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_STR(type_name)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(size)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (!spl_typedvector_parse_type(type_name, &type)) {
+		zend_argument_value_error(1, "must be one of \"int\", \"float\" or \"string\"");
+		RETURN_THROWS();
+	}
+	if (size < 0) {
+		zend_argument_value_error(2, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (intern->data.raw) {
+		/* __construct() called twice */
+		return;
+	}
+	intern->type = type;
+	spl_typedvector_init_data(intern, size);
+}
+
+PHP_METHOD(SplTypedVector, getType)
+{
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	RETURN_STRING(spl_typedvector_type_name(intern->type));
+}
+
+PHP_METHOD(SplTypedVector, count)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_SPLTYPEDVECTOR_P(ZEND_THIS)->size);
+}
+
+PHP_METHOD(SplTypedVector, getSize)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_SPLTYPEDVECTOR_P(ZEND_THIS)->size);
+}
+
+PHP_METHOD(SplTypedVector, setSize)
+{
+	zend_long size;
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_LONG(size)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (size < 0) {
+		zend_argument_value_error(1, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (size == intern->size) {
+		return;
+	}
+
+	if (intern->type == SPL_TV_STRING && size < intern->size) {
+		for (zend_long i = size; i < intern->size; i++) {
+			if (intern->data.strs[i]) {
+				zend_string_release(intern->data.strs[i]);
+			}
+		}
+	}
+
+	if (size == 0) {
+		if (intern->data.raw) {
+			efree(intern->data.raw);
+			intern->data.raw = NULL;
+		}
+	} else {
+		intern->data.raw = safe_erealloc(intern->data.raw, size, sizeof(zend_long), 0);
+		if (size > intern->size) {
+			memset((char*)intern->data.raw + intern->size * sizeof(zend_long), 0,
+					(size - intern->size) * sizeof(zend_long));
+		}
+	}
+	intern->size = size;
+}
+
+PHP_METHOD(SplTypedVector, get)
+{
+	zend_long index;
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_LONG(index)
+	ZEND_PARSE_PARAMETERS_END();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (index < 0 || index >= intern->size) {
+		zend_throw_exception(spl_ce_RuntimeException, "Index invalid or out of range", 0);
+		RETURN_THROWS();
+	}
+
+	spl_typedvector_fetch(intern, index, return_value);
+}
+
+PHP_METHOD(SplTypedVector, set)
+{
+	zend_long index;
+	zval *value;
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_START(2, 2)
+		Z_PARAM_LONG(index)
+		Z_PARAM_ZVAL(value)
+	ZEND_PARSE_PARAMETERS_END();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (index < 0 || index >= intern->size) {
+		zend_throw_exception(spl_ce_RuntimeException, "Index invalid or out of range", 0);
+		RETURN_THROWS();
+	}
+
+	ZVAL_DEREF(value);
+	if (spl_typedvector_store(intern, index, value, 2) == FAILURE) {
+		RETURN_THROWS();
+	}
+}
+
+PHP_METHOD(SplTypedVector, fill)
+{
+	zval *value;
+	zend_long offset = 0;
+	zend_long count = 0;
+	bool count_is_null = true;
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_START(1, 3)
+		Z_PARAM_ZVAL(value)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(offset)
+		Z_PARAM_LONG_OR_NULL(count, count_is_null)
+	ZEND_PARSE_PARAMETERS_END();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (offset < 0 || offset > intern->size) {
+		zend_argument_value_error(2, "must be between 0 and the size of the vector");
+		RETURN_THROWS();
+	}
+	if (count_is_null) {
+		count = intern->size - offset;
+	} else if (count < 0 || count > intern->size - offset) {
+		zend_argument_value_error(3, "must be between 0 and the number of elements after the offset");
+		RETURN_THROWS();
+	}
+	if (count == 0) {
+		return;
+	}
+
+	ZVAL_DEREF(value);
+	/* Validate (and convert) once through the normal store path, then
+	 * replicate the raw slot. */
+	if (spl_typedvector_store(intern, offset, value, 1) == FAILURE) {
+		RETURN_THROWS();
+	}
+	switch (intern->type) {
+		case SPL_TV_INT: {
+			zend_long lval = intern->data.lvals[offset];
+			for (zend_long i = offset + 1; i < offset + count; i++) {
+				intern->data.lvals[i] = lval;
+			}
+			break;
+		}
+		case SPL_TV_FLOAT: {
+			double dval = intern->data.dvals[offset];
+			for (zend_long i = offset + 1; i < offset + count; i++) {
+				intern->data.dvals[i] = dval;
+			}
+			break;
+		}
+		case SPL_TV_STRING: {
+			zend_string *str = intern->data.strs[offset];
+			for (zend_long i = offset + 1; i < offset + count; i++) {
+				if (intern->data.strs[i]) {
+					zend_string_release(intern->data.strs[i]);
+				}
+				intern->data.strs[i] = zend_string_copy(str);
+			}
+			break;
+		}
+	}
+}
+
+PHP_METHOD(SplTypedVector, sum)
+{
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	switch (intern->type) {
+		case SPL_TV_INT: {
+			zval op;
+			ZVAL_LONG(return_value, 0);
+			for (zend_long i = 0; i < intern->size; i++) {
+				ZVAL_LONG(&op, intern->data.lvals[i]);
+				fast_long_add_function(return_value, return_value, &op);
+			}
+			break;
+		}
+		case SPL_TV_FLOAT: {
+			double sum = 0.0;
+			for (zend_long i = 0; i < intern->size; i++) {
+				sum += intern->data.dvals[i];
+			}
+			RETURN_DOUBLE(sum);
+		}
+		case SPL_TV_STRING:
+			zend_throw_error(NULL, "Cannot sum a string vector");
+			RETURN_THROWS();
+	}
+}
+
+/* Treats an unwritten NULL slot as the empty string. */
+static int spl_typedvector_strcmp(zend_string *a, zend_string *b)
+{
+	return zend_binary_strcmp(
+			a ? ZSTR_VAL(a) : "", a ? ZSTR_LEN(a) : 0,
+			b ? ZSTR_VAL(b) : "", b ? ZSTR_LEN(b) : 0);
+}
+
+static void spl_typedvector_minmax(INTERNAL_FUNCTION_PARAMETERS, bool want_max)
+{
+	spl_typedvector_object *intern;
+	zend_long best = 0;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (intern->size == 0) {
+		zend_string *func_name = get_active_function_or_method_name();
+		zend_value_error("%s(): The vector must contain at least one element", ZSTR_VAL(func_name));
+		zend_string_release(func_name);
+		RETURN_THROWS();
+	}
+
+	switch (intern->type) {
+		case SPL_TV_INT:
+			for (zend_long i = 1; i < intern->size; i++) {
+				if (want_max ? intern->data.lvals[i] > intern->data.lvals[best]
+						: intern->data.lvals[i] < intern->data.lvals[best]) {
+					best = i;
+				}
+			}
+			break;
+		case SPL_TV_FLOAT:
+			for (zend_long i = 1; i < intern->size; i++) {
+				if (want_max ? intern->data.dvals[i] > intern->data.dvals[best]
+						: intern->data.dvals[i] < intern->data.dvals[best]) {
+					best = i;
+				}
+			}
+			break;
+		case SPL_TV_STRING:
+			for (zend_long i = 1; i < intern->size; i++) {
+				int cmp = spl_typedvector_strcmp(intern->data.strs[i], intern->data.strs[best]);
+				if (want_max ? cmp > 0 : cmp < 0) {
+					best = i;
+				}
+			}
+			break;
+	}
+
+	spl_typedvector_fetch(intern, best, return_value);
+}
+
+PHP_METHOD(SplTypedVector, min)
+{
+	spl_typedvector_minmax(INTERNAL_FUNCTION_PARAM_PASSTHRU, false);
+}
+
+PHP_METHOD(SplTypedVector, max)
+{
+	spl_typedvector_minmax(INTERNAL_FUNCTION_PARAM_PASSTHRU, true);
+}
+
+PHP_METHOD(SplTypedVector, slice)
+{
+	zend_long offset;
+	zend_long count = 0;
+	bool count_is_null = true;
+	spl_typedvector_object *intern, *result;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_LONG(offset)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG_OR_NULL(count, count_is_null)
+	ZEND_PARSE_PARAMETERS_END();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (offset < 0) {
+		offset += intern->size;
+		if (offset < 0) {
+			offset = 0;
+		}
+	} else if (offset > intern->size) {
+		offset = intern->size;
+	}
+	if (count_is_null || count > intern->size - offset) {
+		count = intern->size - offset;
+	} else if (count < 0) {
+		count = 0;
+	}
+
+	/* The class is final, so the result is always a plain SplTypedVector. */
+	object_init_ex(return_value, spl_ce_SplTypedVector);
+	result = Z_SPLTYPEDVECTOR_P(return_value);
+	result->type = intern->type;
+	spl_typedvector_init_data(result, count);
+	if (count > 0) {
+		if (intern->type == SPL_TV_STRING) {
+			for (zend_long i = 0; i < count; i++) {
+				zend_string *str = intern->data.strs[offset + i];
+				result->data.strs[i] = str ? zend_string_copy(str) : NULL;
+			}
+		} else {
+			memcpy(result->data.raw, (char*)intern->data.raw + offset * sizeof(zend_long),
+					count * sizeof(zend_long));
+		}
+	}
+}
+
+PHP_METHOD(SplTypedVector, toArray)
+{
+	spl_typedvector_object *intern;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	intern = Z_SPLTYPEDVECTOR_P(ZEND_THIS);
+	if (intern->size == 0) {
+		RETURN_EMPTY_ARRAY();
+	}
+
+	array_init_size(return_value, intern->size);
+	zend_hash_real_init_packed(Z_ARRVAL_P(return_value));
+	ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(return_value)) {
+		switch (intern->type) {
+			case SPL_TV_INT:
+				for (zend_long i = 0; i < intern->size; i++) {
+					ZEND_HASH_FILL_SET_LONG(intern->data.lvals[i]);
+					ZEND_HASH_FILL_NEXT();
+				}
+				break;
+			case SPL_TV_FLOAT:
+				for (zend_long i = 0; i < intern->size; i++) {
+					ZEND_HASH_FILL_SET_DOUBLE(intern->data.dvals[i]);
+					ZEND_HASH_FILL_NEXT();
+				}
+				break;
+			case SPL_TV_STRING:
+				for (zend_long i = 0; i < intern->size; i++) {
+					if (intern->data.strs[i]) {
+						ZEND_HASH_FILL_SET_STR_COPY(intern->data.strs[i]);
+					} else {
+						ZEND_HASH_FILL_SET_STR(ZSTR_EMPTY_ALLOC());
+					}
+					ZEND_HASH_FILL_NEXT();
+				}
+				break;
+		}
+	} ZEND_HASH_FILL_END();
+}
+
+PHP_METHOD(SplTypedVector, fromArray)
+{
+	zend_string *type_name;
+	HashTable *values;
+	spl_typedvector_object *result;
+	spl_typedvector_type type;
+	zval *entry;
+	zend_long i = 0;
+
+	ZEND_PARSE_PARAMETERS_START(2, 2)
+		Z_PARAM_STR(type_name)
+		Z_PARAM_ARRAY_HT(values)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (!spl_typedvector_parse_type(type_name, &type)) {
+		zend_argument_value_error(1, "must be one of \"int\", \"float\" or \"string\"");
+		RETURN_THROWS();
+	}
+
+	object_init_ex(return_value, spl_ce_SplTypedVector);
+	result = Z_SPLTYPEDVECTOR_P(return_value);
+	result->type = type;
+	spl_typedvector_init_data(result, zend_hash_num_elements(values));
+
+	ZEND_HASH_FOREACH_VAL(values, entry) {
+		ZVAL_DEREF(entry);
+		if (spl_typedvector_store(result, i, entry, 2) == FAILURE) {
+			zval_ptr_dtor(return_value);
+			RETURN_THROWS();
+		}
+		i++;
+	} ZEND_HASH_FOREACH_END();
+}
+
+PHP_MINIT_FUNCTION(spl_typedvector)
+{
+	spl_ce_SplTypedVector = register_class_SplTypedVector(zend_ce_countable);
+	spl_ce_SplTypedVector->create_object = spl_typedvector_new;
+	spl_ce_SplTypedVector->default_object_handlers = &spl_handler_SplTypedVector;
+
+	memcpy(&spl_handler_SplTypedVector, &std_object_handlers, sizeof(zend_object_handlers));
+
+	spl_handler_SplTypedVector.offset = XtOffsetOf(spl_typedvector_object, std);
+	spl_handler_SplTypedVector.clone_obj = spl_typedvector_clone;
+	spl_handler_SplTypedVector.free_obj = spl_typedvector_free_storage;
+
+	return SUCCESS;
+}
@@ -0,0 +1,22 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | https://www.php.net/license/3_01.txt                                 |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef SPL_TYPEDVECTOR_H
+#define SPL_TYPEDVECTOR_H
+
+extern PHPAPI zend_class_entry *spl_ce_SplTypedVector;
+
+PHP_MINIT_FUNCTION(spl_typedvector);
+
+#endif	/* SPL_TYPEDVECTOR_H */
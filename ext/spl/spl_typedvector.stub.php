@@ -0,0 +1,38 @@
+<?php
+
+/** @generate-class-entries */
+
+/**
+ * @strict-properties
+ * @not-serializable
+ */
+final class SplTypedVector implements Countable
+{
+    public function __construct(string $type, int $size = 0) {}
+
+    public function getType(): string {}
+
+    public function count(): int {}
+
+    public function getSize(): int {}
+
+    public function setSize(int $size): void {}
+
+    public function get(int $index): int|float|string {}
+
+    public function set(int $index, int|float|string $value): void {}
+
+    public function fill(int|float|string $value, int $offset = 0, ?int $count = null): void {}
+
+    public function sum(): int|float {}
+
+    public function min(): int|float|string {}
+
+    public function max(): int|float|string {}
+
+    public function slice(int $offset, ?int $count = null): SplTypedVector {}
+
+    public function toArray(): array {}
+
+    public static function fromArray(string $type, array $values): SplTypedVector {}
+}
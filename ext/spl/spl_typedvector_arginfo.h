@@ -0,0 +1,100 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: 815ea2b44b301eba35c1008b9a21fd1cbb129b60 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_SplTypedVector___construct, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, type, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, size, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_getType, 0, 0, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_count, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_SplTypedVector_getSize arginfo_class_SplTypedVector_count
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_setSize, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, size, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_SplTypedVector_get, 0, 1, MAY_BE_LONG|MAY_BE_DOUBLE|MAY_BE_STRING)
+	ZEND_ARG_TYPE_INFO(0, index, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_set, 0, 2, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, index, IS_LONG, 0)
+	ZEND_ARG_TYPE_MASK(0, value, MAY_BE_LONG|MAY_BE_DOUBLE|MAY_BE_STRING, NULL)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_fill, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_MASK(0, value, MAY_BE_LONG|MAY_BE_DOUBLE|MAY_BE_STRING, NULL)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, offset, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, count, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_SplTypedVector_sum, 0, 0, MAY_BE_LONG|MAY_BE_DOUBLE)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_SplTypedVector_min, 0, 0, MAY_BE_LONG|MAY_BE_DOUBLE|MAY_BE_STRING)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_SplTypedVector_max arginfo_class_SplTypedVector_min
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_SplTypedVector_slice, 0, 1, SplTypedVector, 0)
+	ZEND_ARG_TYPE_INFO(0, offset, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, count, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_SplTypedVector_toArray, 0, 0, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_SplTypedVector_fromArray, 0, 2, SplTypedVector, 0)
+	ZEND_ARG_TYPE_INFO(0, type, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, values, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_METHOD(SplTypedVector, __construct);
+ZEND_METHOD(SplTypedVector, getType);
+ZEND_METHOD(SplTypedVector, count);
+ZEND_METHOD(SplTypedVector, getSize);
+ZEND_METHOD(SplTypedVector, setSize);
+ZEND_METHOD(SplTypedVector, get);
+ZEND_METHOD(SplTypedVector, set);
+ZEND_METHOD(SplTypedVector, fill);
+ZEND_METHOD(SplTypedVector, sum);
+ZEND_METHOD(SplTypedVector, min);
+ZEND_METHOD(SplTypedVector, max);
+ZEND_METHOD(SplTypedVector, slice);
+ZEND_METHOD(SplTypedVector, toArray);
+ZEND_METHOD(SplTypedVector, fromArray);
+
+static const zend_function_entry class_SplTypedVector_methods[] = {
+	ZEND_ME(SplTypedVector, __construct, arginfo_class_SplTypedVector___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, getType, arginfo_class_SplTypedVector_getType, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, count, arginfo_class_SplTypedVector_count, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, getSize, arginfo_class_SplTypedVector_getSize, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, setSize, arginfo_class_SplTypedVector_setSize, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, get, arginfo_class_SplTypedVector_get, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, set, arginfo_class_SplTypedVector_set, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, fill, arginfo_class_SplTypedVector_fill, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, sum, arginfo_class_SplTypedVector_sum, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, min, arginfo_class_SplTypedVector_min, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, max, arginfo_class_SplTypedVector_max, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, slice, arginfo_class_SplTypedVector_slice, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, toArray, arginfo_class_SplTypedVector_toArray, ZEND_ACC_PUBLIC)
+	ZEND_ME(SplTypedVector, fromArray, arginfo_class_SplTypedVector_fromArray, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_SplTypedVector(zend_class_entry *class_entry_Countable)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "SplTypedVector", class_SplTypedVector_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES|ZEND_ACC_NOT_SERIALIZABLE;
+	zend_class_implements(class_entry, 1, class_entry_Countable);
+
+	return class_entry;
+}
@@ -0,0 +1,83 @@
+--TEST--
+SplTypedVector: basic operations on int, float and string vectors
+--FILE--
+<?php
+$v = new SplTypedVector("int", 4);
+var_dump($v->getType(), count($v), $v->get(0));
+$v->set(0, 7);
+$v->set(3, -2);
+var_dump($v->get(0), $v->get(3), $v->sum(), $v->min(), $v->max());
+var_dump($v->toArray());
+
+$v->setSize(6);
+var_dump(count($v), $v->get(5));
+$v->setSize(2);
+var_dump($v->toArray());
+
+$f = SplTypedVector::fromArray("float", [1.5, 2, 3.25]);
+var_dump($f->getType(), $f->sum(), $f->min(), $f->max());
+$f->fill(0.5, 1);
+var_dump($f->toArray());
+
+$s = SplTypedVector::fromArray("string", ["pear", "apple", "orange"]);
+var_dump($s->min(), $s->max());
+var_dump($s->slice(1)->toArray());
+var_dump($s->slice(-2, 1)->toArray());
+
+$c = clone $s;
+$c->set(0, "kiwi");
+var_dump($s->get(0), $c->get(0));
+?>
+--EXPECT--
+string(3) "int"
+int(4)
+int(0)
+int(7)
+int(-2)
+int(5)
+int(-2)
+int(7)
+array(4) {
+  [0]=>
+  int(7)
+  [1]=>
+  int(0)
+  [2]=>
+  int(0)
+  [3]=>
+  int(-2)
+}
+int(6)
+int(0)
+array(2) {
+  [0]=>
+  int(7)
+  [1]=>
+  int(0)
+}
+string(5) "float"
+float(6.75)
+float(1.5)
+float(3.25)
+array(3) {
+  [0]=>
+  float(1.5)
+  [1]=>
+  float(0.5)
+  [2]=>
+  float(0.5)
+}
+string(5) "apple"
+string(4) "pear"
+array(2) {
+  [0]=>
+  string(5) "apple"
+  [1]=>
+  string(6) "orange"
+}
+array(1) {
+  [0]=>
+  string(5) "apple"
+}
+string(4) "pear"
+string(4) "kiwi"
@@ -0,0 +1,66 @@
+--TEST--
+SplTypedVector: error conditions
+--FILE--
+<?php
+try {
+    new SplTypedVector("bool");
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    new SplTypedVector("int", -1);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+$v = new SplTypedVector("int", 2);
+try {
+    $v->get(2);
+} catch (RuntimeException $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    $v->set(-1, 1);
+} catch (RuntimeException $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    $v->set(0, "nope");
+} catch (TypeError $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    $v->setSize(-5);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+$s = new SplTypedVector("string", 1);
+try {
+    $s->sum();
+} catch (Error $e) {
+    echo $e->getMessage(), "\n";
+}
+
+$empty = new SplTypedVector("float");
+try {
+    $empty->min();
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    SplTypedVector::fromArray("int", [1, 2.5]);
+} catch (TypeError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+SplTypedVector::__construct(): Argument #1 ($type) must be one of "int", "float" or "string"
+SplTypedVector::__construct(): Argument #2 ($size) must be greater than or equal to 0
+Index invalid or out of range
+Index invalid or out of range
+SplTypedVector::set(): Argument #2 ($value) must be of type int for an int vector, string given
+SplTypedVector::setSize(): Argument #1 ($size) must be greater than or equal to 0
+Cannot sum a string vector
+SplTypedVector::min(): The vector must contain at least one element
+SplTypedVector::fromArray(): Argument #2 ($values) must be of type int for an int vector, float given
@@ -25,6 +25,11 @@ extern zend_module_entry sqlite3_module_entry;
 ZEND_BEGIN_MODULE_GLOBALS(sqlite3)
 	char *extension_dir;
 	int dbconfig_defensive;
+	zend_long mmap_size;
+	zend_long cache_size;
+	bool shared_cache;
+	zend_long wal_autocheckpoint;
+	zend_long stmt_cache_size;
 ZEND_END_MODULE_GLOBALS(sqlite3)
 
 #if defined(ZTS) && defined(COMPILE_DL_SQLITE3)
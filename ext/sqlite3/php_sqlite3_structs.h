@@ -71,6 +71,11 @@ typedef struct _php_sqlite3_db_object  {
 	bool exception;
 
 	zend_llist free_list;
+
+	/* Reusable prepared statements keyed by SQL text, in insertion order
+	 * (see sqlite3.stmt_cache_size). Entries are owned by the connection
+	 * and finalized before the database handle is closed. */
+	HashTable stmt_cache;
 	zend_object zo;
 } php_sqlite3_db_object;
 
@@ -63,6 +63,11 @@ PHP_INI_BEGIN()
 #if SQLITE_VERSION_NUMBER >= 3026000
 	STD_PHP_INI_BOOLEAN("sqlite3.defensive",  "1", PHP_INI_USER, OnUpdateBool, dbconfig_defensive, zend_sqlite3_globals, sqlite3_globals)
 #endif
+	STD_PHP_INI_ENTRY("sqlite3.mmap_size",  "-1", PHP_INI_SYSTEM, OnUpdateLong, mmap_size, zend_sqlite3_globals, sqlite3_globals)
+	STD_PHP_INI_ENTRY("sqlite3.cache_size",  "0", PHP_INI_SYSTEM, OnUpdateLong, cache_size, zend_sqlite3_globals, sqlite3_globals)
+	STD_PHP_INI_BOOLEAN("sqlite3.shared_cache",  "0", PHP_INI_SYSTEM, OnUpdateBool, shared_cache, zend_sqlite3_globals, sqlite3_globals)
+	STD_PHP_INI_ENTRY("sqlite3.wal_autocheckpoint",  "-1", PHP_INI_SYSTEM, OnUpdateLong, wal_autocheckpoint, zend_sqlite3_globals, sqlite3_globals)
+	STD_PHP_INI_ENTRY("sqlite3.stmt_cache_size",  "0", PHP_INI_SYSTEM, OnUpdateLong, stmt_cache_size, zend_sqlite3_globals, sqlite3_globals)
 PHP_INI_END()
 /* }}} */
 
@@ -99,6 +104,74 @@ static void php_sqlite3_error(php_sqlite3_db_object *db_obj, int errcode, const
 }
 /* }}} */
 
+/* {{{ php_sqlite3_stmt_cache_take
+	Look up a previously compiled statement for the given SQL and take it out
+	of the cache. Ownership moves to the caller, so a user-defined function
+	running inside sqlite3_step() that re-enters with the same SQL cannot
+	reset a statement that is still executing. */
+static sqlite3_stmt *php_sqlite3_stmt_cache_take(php_sqlite3_db_object *db_obj, zend_string *sql)
+{
+	sqlite3_stmt *stmt;
+
+	if (SQLITE3G(stmt_cache_size) <= 0) {
+		return NULL;
+	}
+
+	stmt = zend_hash_find_ptr(&db_obj->stmt_cache, sql);
+	if (stmt) {
+		/* the table has no destructor; the statement stays valid */
+		zend_hash_del(&db_obj->stmt_cache, sql);
+	}
+	return stmt;
+}
+/* }}} */
+
+/* {{{ php_sqlite3_stmt_cache_store
+	Keep a finished statement for the next query with the same SQL. The table
+	is insertion-ordered, so when it is full the oldest entry is evicted.
+	Statements from sqlite3_prepare_v2() re-compile themselves on schema
+	changes, so no explicit invalidation is needed. */
+static void php_sqlite3_stmt_cache_store(php_sqlite3_db_object *db_obj, zend_string *sql, sqlite3_stmt *stmt)
+{
+	if (SQLITE3G(stmt_cache_size) <= 0) {
+		sqlite3_finalize(stmt);
+		return;
+	}
+
+	sqlite3_reset(stmt);
+	if (zend_hash_add_ptr(&db_obj->stmt_cache, sql, stmt) == NULL) {
+		/* an identical statement was cached by a re-entrant call */
+		sqlite3_finalize(stmt);
+		return;
+	}
+
+	if (zend_hash_num_elements(&db_obj->stmt_cache) > (uint32_t)SQLITE3G(stmt_cache_size)) {
+		zend_string *key;
+		zend_ulong idx;
+		HashPosition pos;
+
+		zend_hash_internal_pointer_reset_ex(&db_obj->stmt_cache, &pos);
+		if (zend_hash_get_current_key_ex(&db_obj->stmt_cache, &key, &idx, &pos) == HASH_KEY_IS_STRING) {
+			sqlite3_finalize(zend_hash_get_current_data_ptr_ex(&db_obj->stmt_cache, &pos));
+			zend_hash_del(&db_obj->stmt_cache, key);
+		}
+	}
+}
+/* }}} */
+
+/* {{{ php_sqlite3_stmt_cache_flush
+	Finalize all cached statements; must happen before sqlite3_close(). */
+static void php_sqlite3_stmt_cache_flush(php_sqlite3_db_object *db_obj)
+{
+	sqlite3_stmt *stmt;
+
+	ZEND_HASH_MAP_FOREACH_PTR(&db_obj->stmt_cache, stmt) {
+		sqlite3_finalize(stmt);
+	} ZEND_HASH_FOREACH_END();
+	zend_hash_clean(&db_obj->stmt_cache);
+}
+/* }}} */
+
 /* {{{ Opens a SQLite 3 Database, if the build includes encryption then it will attempt to use the key. */
 PHP_METHOD(SQLite3, open)
 {
@@ -165,6 +238,24 @@ PHP_METHOD(SQLite3, open)
 	db_obj->initialised = 1;
 	db_obj->authorizer_fcc = empty_fcall_info_cache;
 
+	/* Apply connection tuning before the authorizer is installed, so the
+	 * pragmas are not subject to user authorizer callbacks */
+	if (SQLITE3G(mmap_size) >= 0) {
+		char buf[64];
+
+		snprintf(buf, sizeof(buf), "PRAGMA mmap_size=" ZEND_LONG_FMT, SQLITE3G(mmap_size));
+		sqlite3_exec(db_obj->db, buf, NULL, NULL, NULL);
+	}
+	if (SQLITE3G(cache_size) != 0) {
+		char buf[64];
+
+		snprintf(buf, sizeof(buf), "PRAGMA cache_size=" ZEND_LONG_FMT, SQLITE3G(cache_size));
+		sqlite3_exec(db_obj->db, buf, NULL, NULL, NULL);
+	}
+	if (SQLITE3G(wal_autocheckpoint) >= 0) {
+		sqlite3_wal_autocheckpoint(db_obj->db, (int)SQLITE3G(wal_autocheckpoint));
+	}
+
 	sqlite3_set_authorizer(db_obj->db, php_sqlite3_authorizer, db_obj);
 
 #if SQLITE_VERSION_NUMBER >= 3026000
@@ -193,6 +284,7 @@ PHP_METHOD(SQLite3, close)
 
 	if (db_obj->initialised) {
 		zend_llist_clean(&(db_obj->free_list));
+		php_sqlite3_stmt_cache_flush(db_obj);
 		if(db_obj->db) {
 			errcode = sqlite3_close(db_obj->db);
 			if (errcode != SQLITE_OK) {
@@ -698,10 +790,13 @@ PHP_METHOD(SQLite3, querySingle)
 		RETURN_FALSE;
 	}
 
-	return_code = sqlite3_prepare_v2(db_obj->db, ZSTR_VAL(sql), ZSTR_LEN(sql), &stmt, NULL);
-	if (return_code != SQLITE_OK) {
-		php_sqlite3_error(db_obj, return_code, "Unable to prepare statement: %s", sqlite3_errmsg(db_obj->db));
-		RETURN_FALSE;
+	stmt = php_sqlite3_stmt_cache_take(db_obj, sql);
+	if (!stmt) {
+		return_code = sqlite3_prepare_v2(db_obj->db, ZSTR_VAL(sql), ZSTR_LEN(sql), &stmt, NULL);
+		if (return_code != SQLITE_OK) {
+			php_sqlite3_error(db_obj, return_code, "Unable to prepare statement: %s", sqlite3_errmsg(db_obj->db));
+			RETURN_FALSE;
+		}
 	}
 
 	return_code = sqlite3_step(stmt);
@@ -737,7 +832,7 @@ PHP_METHOD(SQLite3, querySingle)
 		}
 		RETVAL_FALSE;
 	}
-	sqlite3_finalize(stmt);
+	php_sqlite3_stmt_cache_store(db_obj, sql, stmt);
 }
 /* }}} */
 
@@ -2224,6 +2319,9 @@ static void php_sqlite3_object_free_storage(zend_object *object) /* {{{ */
 		efree(collation);
 	}
 
+	php_sqlite3_stmt_cache_flush(intern);
+	zend_hash_destroy(&intern->stmt_cache);
+
 	if (intern->initialised && intern->db) {
 		sqlite3_close(intern->db);
 		intern->initialised = 0;
@@ -2334,6 +2432,7 @@ static zend_object *php_sqlite3_object_new(zend_class_entry *class_type) /* {{{
 
 	/* Need to keep track of things to free */
 	zend_llist_init(&(intern->free_list),  sizeof(php_sqlite3_free_list *), (llist_dtor_func_t)php_sqlite3_free_list_dtor, 0);
+	zend_hash_init(&intern->stmt_cache, 0, NULL, NULL, 0);
 
 	zend_object_std_init(&intern->zo, class_type);
 	object_properties_init(&intern->zo, class_type);
@@ -2431,6 +2530,13 @@ PHP_MINIT_FUNCTION(sqlite3)
 
 	REGISTER_INI_ENTRIES();
 
+#ifndef SQLITE_OMIT_SHARED_CACHE
+	/* Must be enabled before the first connection is opened */
+	if (SQLITE3G(shared_cache)) {
+		sqlite3_enable_shared_cache(1);
+	}
+#endif
+
 	register_sqlite3_symbols(module_number);
 
 	return SUCCESS;
@@ -0,0 +1,27 @@
+--TEST--
+SQLite3 sqlite3.cache_size ini setting is applied to new connections
+--EXTENSIONS--
+sqlite3
+--INI--
+sqlite3.cache_size=-4321
+--FILE--
+<?php
+
+require_once(__DIR__ . '/new_db.inc');
+
+var_dump($db->querySingle('PRAGMA cache_size'));
+
+/* each connection gets the pragma, not just the first one */
+$db2 = new SQLite3(':memory:');
+var_dump($db2->querySingle('PRAGMA cache_size'));
+
+var_dump($db->close());
+var_dump($db2->close());
+echo "Done\n";
+?>
+--EXPECT--
+int(-4321)
+int(-4321)
+bool(true)
+bool(true)
+Done
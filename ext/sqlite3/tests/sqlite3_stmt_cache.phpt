@@ -0,0 +1,74 @@
+--TEST--
+SQLite3 statement cache (sqlite3.stmt_cache_size)
+--EXTENSIONS--
+sqlite3
+--INI--
+sqlite3.stmt_cache_size=2
+--FILE--
+<?php
+
+require_once(__DIR__ . '/new_db.inc');
+
+echo "Creating Table\n";
+var_dump($db->exec('CREATE TABLE test (id INTEGER, val STRING)'));
+var_dump($db->exec("INSERT INTO test (id, val) VALUES (1, 'a')"));
+
+echo "Repeated querySingle sees fresh data\n";
+var_dump($db->querySingle("SELECT val FROM test WHERE id = 1"));
+var_dump($db->exec("UPDATE test SET val = 'b' WHERE id = 1"));
+/* served from the statement cache; must be reset and re-stepped */
+var_dump($db->querySingle("SELECT val FROM test WHERE id = 1"));
+
+echo "Rotating through more statements than the cache holds\n";
+for ($i = 0; $i < 3; $i++) {
+    var_dump($db->querySingle("SELECT id + $i FROM test"));
+}
+for ($i = 0; $i < 3; $i++) {
+    var_dump($db->querySingle("SELECT id + $i FROM test"));
+}
+
+echo "Re-entrant querySingle with identical SQL\n";
+$depth = 0;
+function reenter($x)
+{
+    global $db, $depth;
+    if ($depth < 1) {
+        $depth++;
+        $r = $db->querySingle("SELECT reenter(7)");
+        $depth--;
+        return $r + 1;
+    }
+    return $x;
+}
+var_dump($db->createFunction('reenter', 'reenter'));
+/* the inner call runs while the outer statement is still stepping */
+var_dump($db->querySingle("SELECT reenter(7)"));
+/* again, so the outer call starts from a cached statement */
+var_dump($db->querySingle("SELECT reenter(7)"));
+
+echo "Closing database\n";
+var_dump($db->close());
+echo "Done\n";
+?>
+--EXPECT--
+Creating Table
+bool(true)
+bool(true)
+Repeated querySingle sees fresh data
+string(1) "a"
+bool(true)
+string(1) "b"
+Rotating through more statements than the cache holds
+int(1)
+int(2)
+int(3)
+int(1)
+int(2)
+int(3)
+Re-entrant querySingle with identical SQL
+bool(true)
+int(8)
+int(8)
+Closing database
+bool(true)
+Done
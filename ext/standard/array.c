@@ -29,12 +29,19 @@
 #ifdef PHP_WIN32
 #include "win32/unistd.h"
 #endif
+#ifdef HAVE_FORK
+#include <unistd.h>
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#endif
 #include "zend_globals.h"
 #include "zend_interfaces.h"
 #include "php_array.h"
 #include "basic_functions.h"
 #include "php_string.h"
 #include "php_math.h"
+#include "php_var.h"
 #include "zend_smart_str.h"
 #include "zend_bitset.h"
 #include "zend_exceptions.h"
@@ -768,6 +775,84 @@ PHP_FUNCTION(arsort)
 }
 /* }}} */
 
+static void php_array_flat_zval_swap(void *p, void *q) /* {{{ */
+{
+	zval tmp;
+
+	ZVAL_COPY_VALUE(&tmp, (zval *) p);
+	ZVAL_COPY_VALUE((zval *) p, (zval *) q);
+	ZVAL_COPY_VALUE((zval *) q, &tmp);
+}
+/* }}} */
+
+static int php_array_flat_compare_long(const void *a, const void *b) /* {{{ */
+{
+	return ZEND_THREEWAY_COMPARE(Z_LVAL_P((const zval *) a), Z_LVAL_P((const zval *) b));
+}
+/* }}} */
+
+static int php_array_flat_compare_long_reverse(const void *a, const void *b) /* {{{ */
+{
+	return ZEND_THREEWAY_COMPARE(Z_LVAL_P((const zval *) b), Z_LVAL_P((const zval *) a));
+}
+/* }}} */
+
+static int php_array_flat_compare_double(const void *a, const void *b) /* {{{ */
+{
+	return ZEND_THREEWAY_COMPARE(Z_DVAL_P((const zval *) a), Z_DVAL_P((const zval *) b));
+}
+/* }}} */
+
+static int php_array_flat_compare_double_reverse(const void *a, const void *b) /* {{{ */
+{
+	return ZEND_THREEWAY_COMPARE(Z_DVAL_P((const zval *) b), Z_DVAL_P((const zval *) a));
+}
+/* }}} */
+
+/* {{{ php_array_sort_flat_scalars
+ * sort()/rsort() on a packed array holding only longs or only doubles does
+ * not need the bucket conversion done by zend_hash_sort(): the keys are
+ * renumbered anyway and equal scalars are interchangeable, so stability
+ * bookkeeping is irrelevant. One pre-scan detects the case, then the packed
+ * zval vector is sorted in place with a branch-free scalar comparator
+ * instead of the generic zval type dispatch per comparison. */
+static bool php_array_sort_flat_scalars(HashTable *ht, zend_long sort_type, bool reverse)
+{
+	compare_func_t cmp;
+	uint32_t i;
+	uint8_t type;
+
+	if (!HT_IS_PACKED(ht) || !HT_IS_WITHOUT_HOLES(ht) || ht->nNumOfElements == 0) {
+		return false;
+	}
+	if (sort_type != PHP_SORT_REGULAR && sort_type != PHP_SORT_NUMERIC) {
+		return false;
+	}
+
+	type = Z_TYPE(ht->arPacked[0]);
+	if (type != IS_LONG && type != IS_DOUBLE) {
+		return false;
+	}
+	for (i = 1; i < ht->nNumOfElements; i++) {
+		if (Z_TYPE(ht->arPacked[i]) != type) {
+			return false;
+		}
+	}
+
+	if (type == IS_LONG) {
+		cmp = reverse ? php_array_flat_compare_long_reverse : php_array_flat_compare_long;
+	} else {
+		cmp = reverse ? php_array_flat_compare_double_reverse : php_array_flat_compare_double;
+	}
+	zend_sort(ht->arPacked, ht->nNumOfElements, sizeof(zval), cmp, php_array_flat_zval_swap);
+
+	/* The keys of a packed array without holes are already 0..n-1. */
+	ht->nNextFreeElement = ht->nNumOfElements;
+	ht->nInternalPointer = 0;
+	return true;
+}
+/* }}} */
+
 /* {{{ Sort an array */
 PHP_FUNCTION(sort)
 {
@@ -781,6 +866,10 @@ PHP_FUNCTION(sort)
 		Z_PARAM_LONG(sort_type)
 	ZEND_PARSE_PARAMETERS_END();
 
+	if (php_array_sort_flat_scalars(Z_ARRVAL_P(array), sort_type, false)) {
+		RETURN_TRUE;
+	}
+
 	cmp = php_get_data_compare_func(sort_type, 0);
 
 	zend_hash_sort(Z_ARRVAL_P(array), cmp, 1);
@@ -802,6 +891,10 @@ PHP_FUNCTION(rsort)
 		Z_PARAM_LONG(sort_type)
 	ZEND_PARSE_PARAMETERS_END();
 
+	if (php_array_sort_flat_scalars(Z_ARRVAL_P(array), sort_type, true)) {
+		RETURN_TRUE;
+	}
+
 	cmp = php_get_data_compare_func(sort_type, 1);
 
 	zend_hash_sort(Z_ARRVAL_P(array), cmp, 1);
@@ -2695,13 +2788,13 @@ PHP_FUNCTION(extract)
 }
 /* }}} */
 
-static void php_compact_var(HashTable *eg_active_symbol_table, zval *return_value, zval *entry, uint32_t pos) /* {{{ */
+static void php_compact_var(zval *return_value, zval *entry, uint32_t pos) /* {{{ */
 {
 	zval *value_ptr, data;
 
 	ZVAL_DEREF(entry);
 	if (Z_TYPE_P(entry) == IS_STRING) {
-		if ((value_ptr = zend_hash_find_ind(eg_active_symbol_table, Z_STR_P(entry))) != NULL) {
+		if ((value_ptr = zend_get_local_var(Z_STR_P(entry))) != NULL) {
 			ZVAL_DEREF(value_ptr);
 			Z_TRY_ADDREF_P(value_ptr);
 			zend_hash_update(Z_ARRVAL_P(return_value), Z_STR_P(entry), value_ptr);
@@ -2723,7 +2816,7 @@ static void php_compact_var(HashTable *eg_active_symbol_table, zval *return_valu
 			Z_PROTECT_RECURSION_P(entry);
 		}
 		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(entry), value_ptr) {
-			php_compact_var(eg_active_symbol_table, return_value, value_ptr, pos);
+			php_compact_var(return_value, value_ptr, pos);
 		} ZEND_HASH_FOREACH_END();
 		if (Z_REFCOUNTED_P(entry)) {
 			Z_UNPROTECT_RECURSION_P(entry);
@@ -2740,7 +2833,6 @@ PHP_FUNCTION(compact)
 {
 	zval *args = NULL;	/* function arguments array */
 	uint32_t num_args, i;
-	zend_array *symbol_table;
 
 	ZEND_PARSE_PARAMETERS_START(1, -1)
 		Z_PARAM_VARIADIC('+', args, num_args)
@@ -2750,8 +2842,8 @@ PHP_FUNCTION(compact)
 		return;
 	}
 
-	symbol_table = zend_rebuild_symbol_table();
-	ZEND_ASSERT(symbol_table && "A symbol table should always be available here");
+	/* compact() only reads the requested names, so the caller's variables
+	 * are looked up one by one instead of materializing its symbol table. */
 
 	/* compact() is probably most used with a single array of var_names
 	   or multiple string names, rather than a combination of both.
@@ -2763,7 +2855,7 @@ PHP_FUNCTION(compact)
 	}
 
 	for (i = 0; i < num_args; i++) {
-		php_compact_var(symbol_table, return_value, &args[i], i + 1);
+		php_compact_var(return_value, &args[i], i + 1);
 	}
 }
 /* }}} */
@@ -4096,16 +4188,41 @@ PHPAPI int php_array_merge(HashTable *dest, HashTable *src) /* {{{ */
 
 	if (HT_IS_PACKED(dest) && HT_IS_PACKED(src)) {
 		zend_hash_extend(dest, zend_hash_num_elements(dest) + zend_hash_num_elements(src), 1);
-		ZEND_HASH_FILL_PACKED(dest) {
-			ZEND_HASH_PACKED_FOREACH_VAL(src, src_entry) {
-				if (UNEXPECTED(Z_ISREF_P(src_entry)) &&
-					UNEXPECTED(Z_REFCOUNT_P(src_entry) == 1)) {
-					src_entry = Z_REFVAL_P(src_entry);
-				}
-				Z_TRY_ADDREF_P(src_entry);
-				ZEND_HASH_FILL_ADD(src_entry);
-			} ZEND_HASH_FOREACH_END();
-		} ZEND_HASH_FILL_END();
+		if (HT_IS_WITHOUT_HOLES(src) && zend_hash_num_elements(src) > 0) {
+			/* Layout-aware append: copy the whole zval block at once, then
+			 * fix up refcounts; the element-wise fill below is only needed
+			 * when holes have to be skipped */
+			uint32_t n = src->nNumUsed;
+			zval *dst_slot;
+			uint32_t i;
+
+			zend_hash_extend(dest, dest->nNumUsed + n, 1);
+			dst_slot = dest->arPacked + dest->nNumUsed;
+			memcpy(dst_slot, src->arPacked, n * sizeof(zval));
+			for (i = 0; i < n; i++, dst_slot++) {
+				if (UNEXPECTED(Z_ISREF_P(dst_slot)) &&
+					UNEXPECTED(Z_REFCOUNT_P(dst_slot) == 1)) {
+					ZVAL_COPY(dst_slot, Z_REFVAL_P(dst_slot));
+				} else {
+					Z_TRY_ADDREF_P(dst_slot);
+				}
+			}
+			dest->nNumOfElements += n;
+			dest->nNumUsed += n;
+			dest->nNextFreeElement = dest->nNumUsed;
+			dest->nInternalPointer = 0;
+		} else {
+			ZEND_HASH_FILL_PACKED(dest) {
+				ZEND_HASH_PACKED_FOREACH_VAL(src, src_entry) {
+					if (UNEXPECTED(Z_ISREF_P(src_entry)) &&
+						UNEXPECTED(Z_REFCOUNT_P(src_entry) == 1)) {
+						src_entry = Z_REFVAL_P(src_entry);
+					}
+					Z_TRY_ADDREF_P(src_entry);
+					ZEND_HASH_FILL_ADD(src_entry);
+				} ZEND_HASH_FOREACH_END();
+			} ZEND_HASH_FILL_END();
+		}
 	} else {
 		ZEND_HASH_FOREACH_STR_KEY_VAL(src, string_key, src_entry) {
 			if (UNEXPECTED(Z_ISREF_P(src_entry) &&
@@ -4645,6 +4762,33 @@ PHP_FUNCTION(array_column)
 	void* cache_slot_column[3] = { NULL, NULL, NULL };
 	void* cache_slot_index[3] = { NULL, NULL, NULL };
 
+	/* With no column and no index key the result is the list of row values,
+	 * so a vector-like packed input can be shared instead of copied.
+	 * Inputs holding references are excluded because the generic loop
+	 * unwraps them. */
+	if (column_is_null && index_is_null
+	 && HT_IS_PACKED(input) && HT_IS_WITHOUT_HOLES(input)
+	 && input->nNextFreeElement == (zend_long)zend_hash_num_elements(input)) {
+		bool has_refs = false;
+
+		ZEND_HASH_PACKED_FOREACH_VAL(input, data) {
+			if (UNEXPECTED(Z_ISREF_P(data))) {
+				has_refs = true;
+				break;
+			}
+		} ZEND_HASH_FOREACH_END();
+
+		if (!has_refs) {
+			ZVAL_ARR(return_value, input);
+			if (!(GC_FLAGS(input) & IS_ARRAY_IMMUTABLE)) {
+				GC_ADDREF(input);
+			} else {
+				Z_TYPE_INFO_P(return_value) = IS_ARRAY;
+			}
+			return;
+		}
+	}
+
 	array_init_size(return_value, zend_hash_num_elements(input));
 	/* Index param is not passed */
 	if (index_is_null) {
@@ -4822,6 +4966,51 @@ PHP_FUNCTION(array_pad)
 }
 /* }}} */
 
+/* {{{ Preallocates storage for at least the given number of elements */
+PHP_FUNCTION(array_reserve)
+{
+	zval *array;
+	zend_long size;
+	bool packed = true;
+	HashTable *ht;
+
+	ZEND_PARSE_PARAMETERS_START(2, 3)
+		Z_PARAM_ARRAY_EX(array, 0, 1)
+		Z_PARAM_LONG(size)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_BOOL(packed)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (size < 0) {
+		zend_argument_value_error(2, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+	if (size > (zend_long)HT_MAX_SIZE) {
+		zend_argument_value_error(2, "is too large");
+		RETURN_THROWS();
+	}
+
+	ht = Z_ARRVAL_P(array);
+	if (size == 0
+	 || (!(HT_FLAGS(ht) & HASH_FLAG_UNINITIALIZED) && (uint32_t)size <= ht->nTableSize)) {
+		return;
+	}
+
+	if (HT_FLAGS(ht) & HASH_FLAG_UNINITIALIZED) {
+		zend_hash_extend(ht, (uint32_t)size, packed);
+	} else if (HT_IS_PACKED(ht)) {
+		if (!packed) {
+			zend_hash_packed_to_hash(ht);
+		}
+		zend_hash_extend(ht, (uint32_t)size, packed);
+	} else {
+		/* A hash cannot be turned back into a packed array;
+		 * the hint only sizes it. */
+		zend_hash_extend(ht, (uint32_t)size, false);
+	}
+}
+/* }}} */
+
 /* {{{ Return array with key <-> value flipped */
 PHP_FUNCTION(array_flip)
 {
@@ -5418,7 +5607,75 @@ PHP_FUNCTION(array_intersect_ukey)
 /* {{{ Returns the entries of arr1 that have values which are present in all the other arguments */
 PHP_FUNCTION(array_intersect)
 {
-	php_array_intersect(INTERNAL_FUNCTION_PARAM_PASSTHRU, INTERSECT_NORMAL, INTERSECT_COMP_DATA_INTERNAL, INTERSECT_COMP_KEY_INTERNAL);
+	zval *args;
+	uint32_t argc, i;
+	HashTable seen;
+	zval *value, *rounds;
+	zend_string *str, *tmp_str, *key;
+	zend_long idx;
+	zval one;
+
+	ZEND_PARSE_PARAMETERS_START(1, -1)
+		Z_PARAM_VARIADIC('+', args, argc)
+	ZEND_PARSE_PARAMETERS_END();
+
+	for (i = 0; i < argc; i++) {
+		if (Z_TYPE(args[i]) != IS_ARRAY) {
+			zend_argument_type_error(i + 1, "must be of type array, %s given", zend_zval_value_name(&args[i]));
+			RETURN_THROWS();
+		}
+	}
+
+	if (argc == 1) {
+		ZVAL_COPY(return_value, &args[0]);
+		return;
+	}
+
+	if (zend_hash_num_elements(Z_ARRVAL(args[0])) == 0) {
+		RETURN_EMPTY_ARRAY();
+	}
+
+	/* Hash join instead of the historic sort-merge: every value is keyed by
+	 * its string representation, which yields exactly the equality classes of
+	 * the default string comparison.  The table tracks how many of the other
+	 * arrays have produced each value so far, so every array is scanned once. */
+	zend_hash_init(&seen, zend_hash_num_elements(Z_ARRVAL(args[1])), NULL, NULL, 0);
+	ZVAL_LONG(&one, 1);
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(args[1]), value) {
+		str = zval_get_tmp_string(value, &tmp_str);
+		zend_hash_add(&seen, str, &one);
+		zend_tmp_string_release(tmp_str);
+	} ZEND_HASH_FOREACH_END();
+
+	for (i = 2; i < argc; i++) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(args[i]), value) {
+			str = zval_get_tmp_string(value, &tmp_str);
+			rounds = zend_hash_find(&seen, str);
+			/* bump at most once per array */
+			if (rounds && Z_LVAL_P(rounds) == (zend_long)i - 1) {
+				Z_LVAL_P(rounds) = i;
+			}
+			zend_tmp_string_release(tmp_str);
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	/* copy the elements of the first array that all the others produced */
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL(args[0])));
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(args[0]), idx, key, value) {
+		str = zval_get_tmp_string(value, &tmp_str);
+		rounds = zend_hash_find(&seen, str);
+		if (rounds && Z_LVAL_P(rounds) == (zend_long)argc - 1) {
+			if (key) {
+				value = zend_hash_add_new(Z_ARRVAL_P(return_value), key, value);
+			} else {
+				value = zend_hash_index_add_new(Z_ARRVAL_P(return_value), idx, value);
+			}
+			zval_add_ref(value);
+		}
+		zend_tmp_string_release(tmp_str);
+	} ZEND_HASH_FOREACH_END();
+
+	zend_hash_destroy(&seen);
 }
 /* }}} */
 
@@ -6364,6 +6621,77 @@ PHP_FUNCTION(array_rand)
 }
 /* }}} */
 
+/* Fast path of php_array_binop() for packed arrays holding only longs and
+ * doubles: elements are read straight from arPacked and accumulated in
+ * locals, skipping the per-element dispatch through add_function()/
+ * mul_function(). Returns false without touching return_value if an element
+ * of any other type is found; the caller then runs the generic loop instead. */
+static bool php_array_binop_packed(const HashTable *input, bool is_product, zend_long initial, zval *return_value)
+{
+	zval *zv = input->arPacked;
+	zval *end = zv + input->nNumUsed;
+	zval acc;
+	double dval;
+
+	ZVAL_LONG(&acc, initial);
+
+	/* Accumulate as long until the first double element or an overflow,
+	 * producing the same sequence of intermediate results as the generic
+	 * loop does. */
+	do {
+		if (EXPECTED(Z_TYPE_P(zv) == IS_LONG)) {
+			if (!is_product) {
+				fast_long_add_function(&acc, &acc, zv);
+				if (UNEXPECTED(Z_TYPE(acc) == IS_DOUBLE)) {
+					dval = Z_DVAL(acc);
+					zv++;
+					goto use_double;
+				}
+			} else {
+				zend_long lval;
+				zend_long overflow;
+
+				ZEND_SIGNED_MULTIPLY_LONG(Z_LVAL(acc), Z_LVAL_P(zv), lval, dval, overflow);
+				if (UNEXPECTED(overflow)) {
+					zv++;
+					goto use_double;
+				}
+				Z_LVAL(acc) = lval;
+			}
+		} else if (Z_TYPE_P(zv) == IS_DOUBLE) {
+			dval = (double) Z_LVAL(acc);
+			goto use_double;
+		} else if (UNEXPECTED(Z_TYPE_P(zv) != IS_UNDEF)) {
+			return false;
+		}
+	} while (++zv < end);
+
+	ZVAL_COPY_VALUE(return_value, &acc);
+	return true;
+
+use_double:
+	for (; zv < end; zv++) {
+		double val;
+
+		if (EXPECTED(Z_TYPE_P(zv) == IS_DOUBLE)) {
+			val = Z_DVAL_P(zv);
+		} else if (EXPECTED(Z_TYPE_P(zv) == IS_LONG)) {
+			val = (double) Z_LVAL_P(zv);
+		} else if (Z_TYPE_P(zv) == IS_UNDEF) {
+			continue;
+		} else {
+			return false;
+		}
+		if (is_product) {
+			dval *= val;
+		} else {
+			dval += val;
+		}
+	}
+	ZVAL_DOUBLE(return_value, dval);
+	return true;
+}
+
 /* Wrapper for array_sum and array_product */
 static void php_array_binop(INTERNAL_FUNCTION_PARAMETERS, const char *op_name, binary_op_type op, zend_long initial)
 {
@@ -6378,6 +6706,11 @@ static void php_array_binop(INTERNAL_FUNCTION_PARAMETERS, const char *op_name, b
 		RETURN_LONG(initial);
 	}
 
+	if (HT_IS_PACKED(input)
+	 && php_array_binop_packed(input, op == mul_function, initial, return_value)) {
+		return;
+	}
+
 	ZVAL_LONG(return_value, initial);
 	ZEND_HASH_FOREACH_VAL(input, entry) {
 		/* For objects we try to cast them to a numeric type */
@@ -6916,6 +7249,268 @@ PHP_FUNCTION(array_map)
 }
 /* }}} */
 
+/* Applies the callback to `count` elements of `input` starting at position
+ * `offset`, appending the results with their original keys to `dest`. */
+static zend_result php_array_map_slice(zend_fcall_info *fci, zend_fcall_info_cache *fci_cache,
+		HashTable *input, uint32_t offset, uint32_t count, HashTable *dest)
+{
+	uint32_t skipped = 0;
+	zend_ulong num_key;
+	zend_string *str_key;
+	zval *zv, arg, result;
+	int ret;
+
+	ZEND_HASH_FOREACH_KEY_VAL(input, num_key, str_key, zv) {
+		if (skipped < offset) {
+			skipped++;
+			continue;
+		}
+		if (!count) {
+			break;
+		}
+		count--;
+
+		fci->retval = &result;
+		fci->param_count = 1;
+		fci->params = &arg;
+
+		ZVAL_COPY(&arg, zv);
+		ret = zend_call_function(fci, fci_cache);
+		i_zval_ptr_dtor(&arg);
+		if (ret != SUCCESS || Z_TYPE(result) == IS_UNDEF) {
+			return FAILURE;
+		}
+		if (str_key) {
+			zend_hash_add_new(dest, str_key, &result);
+		} else {
+			zend_hash_index_add_new(dest, num_key, &result);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return SUCCESS;
+}
+
+#ifdef HAVE_FORK
+
+/* Forking below this many elements per worker costs more than it saves. */
+#define PHP_ARRAY_PARALLEL_MIN_CHUNK 1024
+
+static bool php_array_parallel_write(int fd, const char *p, size_t len)
+{
+	while (len) {
+		ssize_t n = write(fd, p, len);
+
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		p += n;
+		len -= n;
+	}
+	return true;
+}
+
+/* Worker side: map the chunk, stream the serialized result over the pipe and
+ * _exit() without running any of the parent's shutdown handlers. */
+ZEND_NORETURN static void php_array_parallel_worker(zend_fcall_info *fci, zend_fcall_info_cache *fci_cache,
+		HashTable *input, uint32_t offset, uint32_t count, int fd)
+{
+	HashTable chunk;
+	zend_result status = FAILURE;
+
+	/* A fatal error in the callback (memory limit, timeout) bails out to the
+	 * bailout context inherited from the parent, which would run the parent's
+	 * request shutdown — flushing the shared SAPI output and running userland
+	 * shutdown handlers a second time.  Catch it and die quietly instead. */
+	zend_try {
+		zend_hash_init(&chunk, count, NULL, ZVAL_PTR_DTOR, 0);
+		if (php_array_map_slice(fci, fci_cache, input, offset, count, &chunk) == SUCCESS) {
+			smart_str buf = {0};
+			php_serialize_data_t var_hash;
+			zval tmp;
+
+			ZVAL_ARR(&tmp, &chunk);
+			PHP_VAR_SERIALIZE_INIT(var_hash);
+			php_var_serialize(&buf, &tmp, &var_hash);
+			PHP_VAR_SERIALIZE_DESTROY(var_hash);
+			if (buf.s && !EG(exception)
+			 && php_array_parallel_write(fd, ZSTR_VAL(buf.s), ZSTR_LEN(buf.s))) {
+				status = SUCCESS;
+			}
+		}
+	} zend_catch {
+		_exit(1);
+	} zend_end_try();
+	_exit(status == SUCCESS ? 0 : 1);
+}
+
+/* Parent side: drain one worker's pipe, reap it and merge its chunk into
+ * return_value.  Returns FAILURE if the worker failed or sent garbage. */
+static zend_result php_array_parallel_collect(int fd, pid_t pid, HashTable *dest)
+{
+	smart_str buf = {0};
+	char block[8192];
+	ssize_t n;
+	int wstatus;
+	zend_result result = FAILURE;
+
+	while ((n = read(fd, block, sizeof(block))) != 0) {
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		smart_str_appendl(&buf, block, n);
+	}
+	close(fd);
+	while (waitpid(pid, &wstatus, 0) < 0 && errno == EINTR);
+
+	if (n == 0 && buf.s && WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0) {
+		const unsigned char *p = (const unsigned char*)ZSTR_VAL(buf.s);
+		const unsigned char *max = p + ZSTR_LEN(buf.s);
+		php_unserialize_data_t var_hash;
+		zval chunk;
+
+		ZVAL_UNDEF(&chunk);
+		PHP_VAR_UNSERIALIZE_INIT(var_hash);
+		if (php_var_unserialize(&chunk, &p, max, &var_hash) && Z_TYPE(chunk) == IS_ARRAY) {
+			zend_ulong num_key;
+			zend_string *str_key;
+			zval *zv;
+
+			ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(chunk), num_key, str_key, zv) {
+				Z_TRY_ADDREF_P(zv);
+				if (str_key) {
+					zend_hash_update(dest, str_key, zv);
+				} else {
+					zend_hash_index_update(dest, num_key, zv);
+				}
+			} ZEND_HASH_FOREACH_END();
+			result = SUCCESS;
+		}
+		zval_ptr_dtor(&chunk);
+		PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+	}
+	smart_str_free(&buf);
+
+	return result;
+}
+
+static bool php_array_map_parallel(zend_fcall_info *fci, zend_fcall_info_cache *fci_cache,
+		HashTable *input, zend_long workers, HashTable *dest)
+{
+	uint32_t n = zend_hash_num_elements(input);
+	uint32_t per = n / workers, extra = n % workers, offset = 0;
+	pid_t *pids = safe_emalloc(workers, sizeof(pid_t), 0);
+	int *fds = safe_emalloc(workers, sizeof(int), 0);
+	zend_long i, started = 0;
+	bool ok;
+
+	for (i = 0; i < workers; i++) {
+		uint32_t count = per + (i < (zend_long)extra ? 1 : 0);
+		int pipefd[2];
+		pid_t pid;
+
+		if (pipe(pipefd) != 0) {
+			break;
+		}
+		pid = fork();
+		if (pid < 0) {
+			close(pipefd[0]);
+			close(pipefd[1]);
+			break;
+		}
+		if (pid == 0) {
+			close(pipefd[0]);
+			php_array_parallel_worker(fci, fci_cache, input, offset, count, pipefd[1]);
+		}
+		close(pipefd[1]);
+		pids[started] = pid;
+		fds[started] = pipefd[0];
+		started++;
+		offset += count;
+	}
+
+	/* Collect in submission order so the merged result keeps the input
+	 * order.  Workers past a failure are still drained and reaped. */
+	ok = (started == workers);
+	for (i = 0; i < started; i++) {
+		if (php_array_parallel_collect(fds[i], pids[i], dest) == FAILURE) {
+			ok = false;
+		}
+	}
+
+	efree(pids);
+	efree(fds);
+	return ok;
+}
+#endif /* HAVE_FORK */
+
+/* {{{ Applies the callback to the elements of the given array, partitioning
+   the work across forked workers */
+PHP_FUNCTION(array_map_parallel)
+{
+	zend_fcall_info fci;
+	zend_fcall_info_cache fci_cache;
+	HashTable *input;
+	zend_long workers = 0;
+	uint32_t n;
+
+	ZEND_PARSE_PARAMETERS_START(2, 3)
+		Z_PARAM_FUNC(fci, fci_cache)
+		Z_PARAM_ARRAY_HT(input)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(workers)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (workers < 0) {
+		zend_argument_value_error(3, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+
+	n = zend_hash_num_elements(input);
+	array_init_size(return_value, n);
+	zend_hash_real_init(Z_ARRVAL_P(return_value), HT_IS_PACKED(input));
+	if (n == 0) {
+		return;
+	}
+
+#ifdef HAVE_FORK
+	if (workers == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+		long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+
+		workers = ncpu > 0 ? ncpu : 1;
+#else
+		workers = 1;
+#endif
+	}
+	if (workers > (zend_long)(n / PHP_ARRAY_PARALLEL_MIN_CHUNK)) {
+		workers = n / PHP_ARRAY_PARALLEL_MIN_CHUNK;
+	}
+	if (workers > 1) {
+		if (php_array_map_parallel(&fci, &fci_cache, input, workers, Z_ARRVAL_P(return_value))) {
+			return;
+		}
+		/* A worker failed (callback error, exception or fork failure).
+		 * Re-run serially so errors surface in this process; worker side
+		 * effects are confined to the forked children either way. */
+		zend_array_destroy(Z_ARRVAL_P(return_value));
+		array_init_size(return_value, n);
+		zend_hash_real_init(Z_ARRVAL_P(return_value), HT_IS_PACKED(input));
+	}
+#endif
+
+	if (php_array_map_slice(&fci, &fci_cache, input, 0, n, Z_ARRVAL_P(return_value)) == FAILURE) {
+		zend_array_destroy(Z_ARRVAL_P(return_value));
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
 /* {{{ Checks if the given key or index exists in the array */
 PHP_FUNCTION(array_key_exists)
 {
@@ -37,6 +37,7 @@
 #include "zend_ini.h"
 #include "zend_operators.h"
 #include "ext/standard/php_dns.h"
+#include "ext/standard/php_shmcache.h"
 #include "ext/standard/php_uuencode.h"
 #include "ext/standard/crc32_x86.h"
 
@@ -213,6 +214,7 @@ static void basic_globals_ctor(php_basic_globals *basic_globals_p) /* {{{ */
 	BG(umask) = -1;
 	BG(user_tick_functions) = NULL;
 	BG(user_filter_map) = NULL;
+	BG(env_snapshot) = NULL;
 	BG(serialize_lock) = 0;
 
 	memset(&BG(serialize), 0, sizeof(BG(serialize)));
@@ -226,6 +228,7 @@ static void basic_globals_ctor(php_basic_globals *basic_globals_p) /* {{{ */
 
 	zend_hash_init(&BG(url_adapt_session_hosts_ht), 0, NULL, NULL, 1);
 	zend_hash_init(&BG(url_adapt_output_hosts_ht), 0, NULL, NULL, 1);
+	zend_hash_init(&BG(stat_cache), 8, NULL, php_stat_cache_entry_dtor, 1);
 
 #if defined(_REENTRANT)
 	memset(&BG(mblen_state), 0, sizeof(BG(mblen_state)));
@@ -251,6 +254,7 @@ static void basic_globals_dtor(php_basic_globals *basic_globals_p) /* {{{ */
 
 	zend_hash_destroy(&basic_globals_p->url_adapt_session_hosts_ht);
 	zend_hash_destroy(&basic_globals_p->url_adapt_output_hosts_ht);
+	zend_hash_destroy(&basic_globals_p->stat_cache);
 }
 /* }}} */
 
@@ -311,6 +315,7 @@ PHP_MINIT_FUNCTION(basic) /* {{{ */
 	BASIC_MINIT_SUBMODULE(standard_filters)
 	BASIC_MINIT_SUBMODULE(user_filters)
 	BASIC_MINIT_SUBMODULE(password)
+	BASIC_MINIT_SUBMODULE(shmcache)
 
 #ifdef ZTS
 	BASIC_MINIT_SUBMODULE(localeconv)
@@ -386,6 +391,7 @@ PHP_MSHUTDOWN_FUNCTION(basic) /* {{{ */
 #endif
 	BASIC_MSHUTDOWN_SUBMODULE(crypt)
 	BASIC_MSHUTDOWN_SUBMODULE(password)
+	BASIC_MSHUTDOWN_SUBMODULE(shmcache)
 
 	return SUCCESS;
 }
@@ -413,6 +419,7 @@ PHP_RINIT_FUNCTION(basic) /* {{{ */
 	zend_hash_init(&BG(putenv_ht), 1, NULL, php_putenv_destructor, 0);
 #endif
 	BG(user_shutdown_function_names) = NULL;
+	BG(sprintf_compiled) = NULL;
 
 	PHP_RINIT(filestat)(INIT_FUNC_ARGS_PASSTHRU);
 	BASIC_RINIT_SUBMODULE(dir)
@@ -446,6 +453,12 @@ PHP_RSHUTDOWN_FUNCTION(basic) /* {{{ */
 	tsrm_env_unlock();
 #endif
 
+	if (BG(env_snapshot)) {
+		zend_hash_destroy(BG(env_snapshot));
+		FREE_HASHTABLE(BG(env_snapshot));
+		BG(env_snapshot) = NULL;
+	}
+
 	if (BG(umask) != -1) {
 		umask(BG(umask));
 	}
@@ -482,6 +495,12 @@ PHP_RSHUTDOWN_FUNCTION(basic) /* {{{ */
 		BG(user_tick_functions) = NULL;
 	}
 
+	if (BG(sprintf_compiled)) {
+		zend_hash_destroy(BG(sprintf_compiled));
+		efree(BG(sprintf_compiled));
+		BG(sprintf_compiled) = NULL;
+	}
+
 	BASIC_RSHUTDOWN_SUBMODULE(user_filters)
 	BASIC_RSHUTDOWN_SUBMODULE(browscap)
 
@@ -680,17 +699,33 @@ PHPAPI zend_string *php_getenv(const char *str, size_t str_len) {
 		}
 	}
 #else
-	tsrm_env_lock();
+	/* Take the environment lock once per request: snapshot environ into a
+	 * request-local HashTable on the first lookup and serve all further
+	 * lookups from it. putenv() drops the snapshot, so changes made through
+	 * PHP stay visible; changes made behind PHP's back by C code no longer
+	 * are until the next request. */
+	if (!BG(env_snapshot)) {
+		char **env;
+
+		ALLOC_HASHTABLE(BG(env_snapshot));
+		zend_hash_init(BG(env_snapshot), 64, NULL, ZVAL_PTR_DTOR, 0);
 
-	/* system method returns a const */
-	char *ptr = getenv(str);
-	zend_string *result = NULL;
-	if (ptr) {
-		result = zend_string_init(ptr, strlen(ptr), 0);
+		tsrm_env_lock();
+		for (env = environ; env != NULL && *env != NULL; env++) {
+			const char *eq = strchr(*env, '=');
+			zval val;
+
+			if (!eq || eq == *env) {
+				continue;
+			}
+			ZVAL_STRING(&val, eq + 1);
+			zend_hash_str_update(BG(env_snapshot), *env, eq - *env, &val);
+		}
+		tsrm_env_unlock();
 	}
 
-	tsrm_env_unlock();
-	return result;
+	zval *zv = zend_hash_str_find(BG(env_snapshot), str, str_len);
+	return zv ? zend_string_copy(Z_STR_P(zv)) : NULL;
 #endif
 }
 
@@ -823,6 +858,12 @@ PHP_FUNCTION(putenv)
 # endif
 #endif
 		zend_hash_add_mem(&BG(putenv_ht), pe.key, &pe, sizeof(putenv_entry));
+		/* The environment changed; rebuild the getenv() snapshot on next use. */
+		if (BG(env_snapshot)) {
+			zend_hash_destroy(BG(env_snapshot));
+			FREE_HASHTABLE(BG(env_snapshot));
+			BG(env_snapshot) = NULL;
+		}
 #ifdef HAVE_TZSET
 		if (zend_string_equals_literal_ci(pe.key, "TZ")) {
 			tzset();
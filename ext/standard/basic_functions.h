@@ -58,6 +58,7 @@ typedef int32_t php_int32;
 typedef struct _php_basic_globals {
 	HashTable *user_shutdown_function_names;
 	HashTable putenv_ht;
+	HashTable *env_snapshot; /* per-request environment snapshot served by php_getenv() */
 	zend_string *strtok_string;
 	zend_string *ctype_string; /* current LC_CTYPE locale (or NULL for 'C') */
 	bool locale_changed;   /* locale was changed and has to be restored */
@@ -82,6 +83,7 @@ typedef struct _php_basic_globals {
 	/* filestat.c && main/streams/streams.c */
 	zend_string *CurrentStatFile, *CurrentLStatFile;
 	php_stream_statbuf ssb, lssb;
+	HashTable stat_cache; /* per-request stat results behind the last-stat slots */
 
 	/* syslog.c */
 	char *syslog_device;
@@ -97,6 +99,9 @@ typedef struct _php_basic_globals {
 		unsigned level;
 	} unserialize;
 
+	/* formatted_print.c */
+	HashTable *sprintf_compiled; /* compiled programs of interned format strings */
+
 	/* url_scanner_ex.re */
 	url_adapt_state_ex_t url_adapt_session_ex;
 	HashTable url_adapt_session_hosts_ht;
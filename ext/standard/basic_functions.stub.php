@@ -1759,6 +1759,8 @@ function array_reverse(array $array, bool $preserve_keys = false): array {}
 
 function array_pad(array $array, int $length, mixed $value): array {}
 
+function array_reserve(array &$array, int $size, bool $packed = true): void {}
+
 /**
  * @return array<int|string, int|string>
  * @compile-time-eval
@@ -1907,6 +1909,8 @@ function array_all(array $array, callable $callback): bool {}
 
 function array_map(?callable $callback, array $array, array ...$arrays): array {}
 
+function array_map_parallel(callable $callback, array $array, int $workers = 0): array {}
+
 /**
  * @param string|int $key
  * @compile-time-eval
@@ -2203,7 +2207,7 @@ function ftok(string $filename, string $project_id): int {}
 
 /* hrtime.c */
 
-function hrtime(bool $as_number = false): array|int|float|false {}
+function hrtime(bool $as_number = false, bool $coarse = false): array|int|float|false {}
 
 /* md5.c */
 
@@ -2900,6 +2904,13 @@ function fputcsv($stream, array $fields, string $separator = ",", string $enclos
  */
 function fgetcsv($stream, ?int $length = null, string $separator = ",", string $enclosure = "\"", string $escape = "\\"): array|false {}
 
+/**
+ * @param resource $stream
+ * @return array<int, array<int, string|null>>|false
+ * @refcount 1
+ */
+function stream_get_csv($stream, int $max_rows = 0, ?int $length = null, string $separator = ",", string $enclosure = "\"", string $escape = "\\"): array|false {}
+
 /** @refcount 1 */
 function realpath(string $path): string|false {}
 
@@ -3511,6 +3522,8 @@ function stream_copy_to_stream($from, $to, ?int $length = null, int $offset = 0)
  */
 function stream_get_contents($stream, ?int $length = null, int $offset = -1): string|false {}
 
+function stream_get_contents_multi(array $streams): array {}
+
 /** @param resource $stream */
 function stream_supports_lock($stream): bool {}
 
@@ -3810,12 +3823,31 @@ function serialize(mixed $value): string {}
 
 function unserialize(string $data, array $options = []): mixed {}
 
+/** @refcount 1 */
+function serialize_binary(mixed $value): string {}
+
+function unserialize_binary(string $data, array $options = []): mixed {}
+
 function memory_get_usage(bool $real_usage = false): int {}
 
 function memory_get_peak_usage(bool $real_usage = false): int {}
 
 function memory_reset_peak_usage(): void {}
 
+/* shmcache.c */
+
+function shmcache_store(string $key, mixed $value, int $ttl = 0): bool {}
+
+/**
+ * @param bool $success
+ * @refcount 1
+ */
+function shmcache_fetch(string $key, &$success = null): mixed {}
+
+function shmcache_delete(string $key): bool {}
+
+function shmcache_clear(): bool {}
+
 /* versioning.c */
 
 /** @compile-time-eval */
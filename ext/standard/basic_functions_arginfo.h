@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 7d588414e84ed62088cd5b1c668b29c0e51d406f */
+ * Stub hash: 1c570cb3e4b6bb6fe10e33c14c67feba00528130 */
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_set_time_limit, 0, 1, _IS_BOOL, 0)
 	ZEND_ARG_TYPE_INFO(0, seconds, IS_LONG, 0)
@@ -258,6 +258,12 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_pad, 0, 3, IS_ARRAY, 0)
 	ZEND_ARG_TYPE_INFO(0, value, IS_MIXED, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_reserve, 0, 2, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(1, array, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, size, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, packed, _IS_BOOL, 0, "true")
+ZEND_END_ARG_INFO()
+
 #define arginfo_array_flip arginfo_array_values
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_change_key_case, 0, 1, IS_ARRAY, 0)
@@ -356,6 +362,12 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_map, 0, 2, IS_ARRAY, 0)
 	ZEND_ARG_VARIADIC_TYPE_INFO(0, arrays, IS_ARRAY, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_map_parallel, 0, 2, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, callback, IS_CALLABLE, 0)
+	ZEND_ARG_TYPE_INFO(0, array, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, workers, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_array_key_exists, 0, 2, _IS_BOOL, 0)
 	ZEND_ARG_INFO(0, key)
 	ZEND_ARG_TYPE_INFO(0, array, IS_ARRAY, 0)
@@ -688,6 +700,7 @@ ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_hrtime, 0, 0, MAY_BE_ARRAY|MAY_BE_LONG|MAY_BE_DOUBLE|MAY_BE_FALSE)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, as_number, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, coarse, _IS_BOOL, 0, "false")
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_md5, 0, 1, IS_STRING, 0)
@@ -1355,6 +1368,15 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_fgetcsv, 0, 1, MAY_BE_ARRAY|MAY_
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, escape, IS_STRING, 0, "\"\\\\\"")
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_stream_get_csv, 0, 1, MAY_BE_ARRAY|MAY_BE_FALSE)
+	ZEND_ARG_INFO(0, stream)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, max_rows, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, length, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, separator, IS_STRING, 0, "\",\"")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, enclosure, IS_STRING, 0, "\"\\\"\"")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, escape, IS_STRING, 0, "\"\\\\\"")
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_realpath, 0, 1, MAY_BE_STRING|MAY_BE_FALSE)
 	ZEND_ARG_TYPE_INFO(0, path, IS_STRING, 0)
 ZEND_END_ARG_INFO()
@@ -1969,6 +1991,10 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_stream_get_contents, 0, 1, MAY_B
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, offset, IS_LONG, 0, "-1")
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_stream_get_contents_multi, 0, 1, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, streams, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 #define arginfo_stream_supports_lock arginfo_rewind
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_stream_set_write_buffer, 0, 2, IS_LONG, 0)
@@ -2166,6 +2192,10 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_unserialize, 0, 1, IS_MIXED, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, options, IS_ARRAY, 0, "[]")
 ZEND_END_ARG_INFO()
 
+#define arginfo_serialize_binary arginfo_gettype
+
+#define arginfo_unserialize_binary arginfo_unserialize
+
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_memory_get_usage, 0, 0, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, real_usage, _IS_BOOL, 0, "false")
 ZEND_END_ARG_INFO()
@@ -2174,6 +2204,24 @@ ZEND_END_ARG_INFO()
 
 #define arginfo_memory_reset_peak_usage arginfo_flush
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_shmcache_store, 0, 2, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, value, IS_MIXED, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, ttl, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_shmcache_fetch, 0, 1, IS_MIXED, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_STRING, 0)
+	ZEND_ARG_INFO_WITH_DEFAULT_VALUE(1, success, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_shmcache_delete, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_shmcache_clear, 0, 0, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_version_compare, 0, 2, MAY_BE_LONG|MAY_BE_BOOL)
 	ZEND_ARG_TYPE_INFO(0, version1, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO(0, version2, IS_STRING, 0)
@@ -2394,6 +2442,7 @@ ZEND_FUNCTION(array_count_values);
 ZEND_FUNCTION(array_column);
 ZEND_FUNCTION(array_reverse);
 ZEND_FUNCTION(array_pad);
+ZEND_FUNCTION(array_reserve);
 ZEND_FUNCTION(array_flip);
 ZEND_FUNCTION(array_change_key_case);
 ZEND_FUNCTION(array_unique);
@@ -2424,6 +2473,7 @@ ZEND_FUNCTION(array_find_key);
 ZEND_FUNCTION(array_any);
 ZEND_FUNCTION(array_all);
 ZEND_FUNCTION(array_map);
+ZEND_FUNCTION(array_map_parallel);
 ZEND_FUNCTION(array_key_exists);
 ZEND_FUNCTION(array_chunk);
 ZEND_FUNCTION(array_combine);
@@ -2688,6 +2738,7 @@ ZEND_FUNCTION(unlink);
 ZEND_FUNCTION(file_put_contents);
 ZEND_FUNCTION(fputcsv);
 ZEND_FUNCTION(fgetcsv);
+ZEND_FUNCTION(stream_get_csv);
 ZEND_FUNCTION(realpath);
 #if defined(HAVE_FNMATCH)
 ZEND_FUNCTION(fnmatch);
@@ -2868,6 +2919,7 @@ ZEND_FUNCTION(stream_socket_pair);
 #endif
 ZEND_FUNCTION(stream_copy_to_stream);
 ZEND_FUNCTION(stream_get_contents);
+ZEND_FUNCTION(stream_get_contents_multi);
 ZEND_FUNCTION(stream_supports_lock);
 ZEND_FUNCTION(stream_set_write_buffer);
 ZEND_FUNCTION(stream_set_read_buffer);
@@ -2928,9 +2980,15 @@ ZEND_FUNCTION(var_export);
 ZEND_FUNCTION(debug_zval_dump);
 ZEND_FUNCTION(serialize);
 ZEND_FUNCTION(unserialize);
+ZEND_FUNCTION(serialize_binary);
+ZEND_FUNCTION(unserialize_binary);
 ZEND_FUNCTION(memory_get_usage);
 ZEND_FUNCTION(memory_get_peak_usage);
 ZEND_FUNCTION(memory_reset_peak_usage);
+ZEND_FUNCTION(shmcache_store);
+ZEND_FUNCTION(shmcache_fetch);
+ZEND_FUNCTION(shmcache_delete);
+ZEND_FUNCTION(shmcache_clear);
 ZEND_FUNCTION(version_compare);
 #if defined(PHP_WIN32)
 ZEND_FUNCTION(sapi_windows_cp_set);
@@ -3023,6 +3081,7 @@ static const zend_function_entry ext_functions[] = {
 	ZEND_RAW_FENTRY("array_column", zif_array_column, arginfo_array_column, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_RAW_FENTRY("array_reverse", zif_array_reverse, arginfo_array_reverse, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_FE(array_pad, arginfo_array_pad)
+	ZEND_FE(array_reserve, arginfo_array_reserve)
 	ZEND_RAW_FENTRY("array_flip", zif_array_flip, arginfo_array_flip, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_RAW_FENTRY("array_change_key_case", zif_array_change_key_case, arginfo_array_change_key_case, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_RAW_FENTRY("array_unique", zif_array_unique, arginfo_array_unique, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
@@ -3053,6 +3112,7 @@ static const zend_function_entry ext_functions[] = {
 	ZEND_FE(array_any, arginfo_array_any)
 	ZEND_FE(array_all, arginfo_array_all)
 	ZEND_FE(array_map, arginfo_array_map)
+	ZEND_FE(array_map_parallel, arginfo_array_map_parallel)
 	ZEND_RAW_FENTRY("array_key_exists", zif_array_key_exists, arginfo_array_key_exists, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_RAW_FENTRY("key_exists", zif_array_key_exists, arginfo_key_exists, 0, NULL, NULL)
 	ZEND_RAW_FENTRY("array_chunk", zif_array_chunk, arginfo_array_chunk, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
@@ -3330,6 +3390,7 @@ static const zend_function_entry ext_functions[] = {
 	ZEND_FE(file_put_contents, arginfo_file_put_contents)
 	ZEND_FE(fputcsv, arginfo_fputcsv)
 	ZEND_FE(fgetcsv, arginfo_fgetcsv)
+	ZEND_FE(stream_get_csv, arginfo_stream_get_csv)
 	ZEND_FE(realpath, arginfo_realpath)
 #if defined(HAVE_FNMATCH)
 	ZEND_FE(fnmatch, arginfo_fnmatch)
@@ -3512,6 +3573,7 @@ static const zend_function_entry ext_functions[] = {
 #endif
 	ZEND_FE(stream_copy_to_stream, arginfo_stream_copy_to_stream)
 	ZEND_FE(stream_get_contents, arginfo_stream_get_contents)
+	ZEND_FE(stream_get_contents_multi, arginfo_stream_get_contents_multi)
 	ZEND_FE(stream_supports_lock, arginfo_stream_supports_lock)
 	ZEND_FE(stream_set_write_buffer, arginfo_stream_set_write_buffer)
 	ZEND_RAW_FENTRY("set_file_buffer", zif_stream_set_write_buffer, arginfo_set_file_buffer, 0, NULL, NULL)
@@ -3582,9 +3644,15 @@ static const zend_function_entry ext_functions[] = {
 	ZEND_FE(debug_zval_dump, arginfo_debug_zval_dump)
 	ZEND_RAW_FENTRY("serialize", zif_serialize, arginfo_serialize, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 	ZEND_FE(unserialize, arginfo_unserialize)
+	ZEND_FE(serialize_binary, arginfo_serialize_binary)
+	ZEND_FE(unserialize_binary, arginfo_unserialize_binary)
 	ZEND_FE(memory_get_usage, arginfo_memory_get_usage)
 	ZEND_FE(memory_get_peak_usage, arginfo_memory_get_peak_usage)
 	ZEND_FE(memory_reset_peak_usage, arginfo_memory_reset_peak_usage)
+	ZEND_FE(shmcache_store, arginfo_shmcache_store)
+	ZEND_FE(shmcache_fetch, arginfo_shmcache_fetch)
+	ZEND_FE(shmcache_delete, arginfo_shmcache_delete)
+	ZEND_FE(shmcache_clear, arginfo_shmcache_clear)
 	ZEND_RAW_FENTRY("version_compare", zif_version_compare, arginfo_version_compare, ZEND_ACC_COMPILE_TIME_EVAL, NULL, NULL)
 #if defined(PHP_WIN32)
 	ZEND_FE(sapi_windows_cp_set, arginfo_sapi_windows_cp_set)
@@ -22,6 +22,7 @@
 #include "php_dir.h"
 #include "php_dir_int.h"
 #include "php_scandir.h"
+#include "php_filestat.h"
 #include "basic_functions.h"
 #include "dir_arginfo.h"
 
@@ -260,6 +261,7 @@ PHP_FUNCTION(chdir)
 		zend_string_release(BG(CurrentLStatFile));
 		BG(CurrentLStatFile) = NULL;
 	}
+	php_stat_cache_clean_relative();
 
 	RETURN_TRUE;
 }
@@ -85,6 +85,11 @@
 #include "scanf.h"
 #include "zend_API.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#include "Zend/zend_bitset.h"
+#endif
+
 #ifdef ZTS
 int file_globals_id;
 #else
@@ -155,6 +160,8 @@ PHP_INI_BEGIN()
 	STD_PHP_INI_ENTRY("user_agent", NULL, PHP_INI_ALL, OnUpdateString, user_agent, php_file_globals, file_globals)
 	STD_PHP_INI_ENTRY("from", NULL, PHP_INI_ALL, OnUpdateString, from_address, php_file_globals, file_globals)
 	STD_PHP_INI_ENTRY("default_socket_timeout", "60", PHP_INI_ALL, OnUpdateLong, default_socket_timeout, php_file_globals, file_globals)
+	STD_PHP_INI_ENTRY("dns_cache_ttl", "60", PHP_INI_ALL, OnUpdateLong, dns_cache_ttl, php_file_globals, file_globals)
+	STD_PHP_INI_ENTRY("temp_stream_max_memory", "2097152", PHP_INI_ALL, OnUpdateLong, temp_stream_max_memory, php_file_globals, file_globals)
 	STD_PHP_INI_BOOLEAN("auto_detect_line_endings", "0", PHP_INI_ALL, OnUpdateAutoDetectLineEndings, auto_detect_line_endings, php_file_globals, file_globals)
 PHP_INI_END()
 
@@ -1643,6 +1650,39 @@ PHPAPI PHP_FUNCTION(fread)
 }
 /* }}} */
 
+/* Locate the next enclosure or escape character, so that the enclosure
+ * parsing loop in php_fgetcsv() can skip over runs of ordinary characters
+ * in one go when the locale is single byte. */
+static const char *php_fgetcsv_find_special(const char *ptr, const char *end, char enclosure, int escape_char) /* {{{ */
+{
+	if (escape_char == PHP_CSV_NO_ESCAPE) {
+		const char *found = memchr(ptr, enclosure, end - ptr);
+		return found ? found : end;
+	}
+
+#ifdef __SSE2__
+	const __m128i enc16 = _mm_set1_epi8(enclosure);
+	const __m128i esc16 = _mm_set1_epi8((char) escape_char);
+
+	while (ptr + sizeof(__m128i) <= end) {
+		const __m128i block = _mm_loadu_si128((const __m128i *) ptr);
+		const int mask = _mm_movemask_epi8(
+			_mm_or_si128(_mm_cmpeq_epi8(block, enc16), _mm_cmpeq_epi8(block, esc16)));
+
+		if (mask) {
+			return ptr + zend_ulong_ntz(mask);
+		}
+		ptr += sizeof(__m128i);
+	}
+#endif
+
+	while (ptr < end && *ptr != enclosure && *ptr != (char) escape_char) {
+		ptr++;
+	}
+	return ptr;
+}
+/* }}} */
+
 static const char *php_fgetcsv_lookup_trailing_spaces(const char *ptr, size_t len) /* {{{ */
 {
 	int inc_len;
@@ -1774,19 +1814,42 @@ PHPAPI ssize_t php_fputcsv(php_stream *stream, zval *fields, char delimiter, cha
 		) {
 			char *ch = ZSTR_VAL(field_str);
 			char *end = ch + ZSTR_LEN(field_str);
-			int escaped = 0;
 
 			smart_str_appendc(&csvline, enclosure);
 			while (ch < end) {
+				/* bulk-copy the run up to the next character that needs
+				 * handling instead of appending byte by byte */
+				char *stop = memchr(ch, enclosure, end - ch);
+
+				if (escape_char != PHP_CSV_NO_ESCAPE) {
+					char *esc = memchr(ch, escape_char, stop ? (size_t)(stop - ch) : (size_t)(end - ch));
+
+					if (esc) {
+						stop = esc;
+					}
+				}
+				if (!stop) {
+					smart_str_appendl(&csvline, ch, end - ch);
+					break;
+				}
+				smart_str_appendl(&csvline, ch, stop - ch);
+				ch = stop;
 				if (escape_char != PHP_CSV_NO_ESCAPE && *ch == escape_char) {
-					escaped = 1;
-				} else if (!escaped && *ch == enclosure) {
-					smart_str_appendc(&csvline, enclosure);
+					/* a run of escape characters exempts exactly one
+					 * following character from enclosure doubling */
+					do {
+						smart_str_appendc(&csvline, *ch);
+						ch++;
+					} while (ch < end && *ch == escape_char);
+					if (ch < end) {
+						smart_str_appendc(&csvline, *ch);
+						ch++;
+					}
 				} else {
-					escaped = 0;
+					smart_str_appendc(&csvline, enclosure);
+					smart_str_appendc(&csvline, enclosure);
+					ch++;
 				}
-				smart_str_appendc(&csvline, *ch);
-				ch++;
 			}
 			smart_str_appendc(&csvline, enclosure);
 		} else {
@@ -1909,6 +1972,120 @@ PHP_FUNCTION(fgetcsv)
 }
 /* }}} */
 
+/* {{{ Get multiple lines from file pointer and parse them for CSV fields */
+PHP_FUNCTION(stream_get_csv)
+{
+	char delimiter = ',';
+	char enclosure = '"';
+	int escape = (unsigned char) '\\';
+
+	zend_long max_rows = 0;
+	zend_long len = 0;
+	php_stream *stream;
+
+	{
+		zval *fd;
+		bool len_is_null = 1;
+		char *delimiter_str = NULL;
+		size_t delimiter_str_len = 0;
+		char *enclosure_str = NULL;
+		size_t enclosure_str_len = 0;
+		char *escape_str = NULL;
+		size_t escape_str_len = 0;
+
+		ZEND_PARSE_PARAMETERS_START(1, 6)
+			Z_PARAM_RESOURCE(fd)
+			Z_PARAM_OPTIONAL
+			Z_PARAM_LONG(max_rows)
+			Z_PARAM_LONG_OR_NULL(len, len_is_null)
+			Z_PARAM_STRING(delimiter_str, delimiter_str_len)
+			Z_PARAM_STRING(enclosure_str, enclosure_str_len)
+			Z_PARAM_STRING(escape_str, escape_str_len)
+		ZEND_PARSE_PARAMETERS_END();
+
+		if (max_rows < 0) {
+			zend_argument_value_error(2, "must be greater than or equal to 0");
+			RETURN_THROWS();
+		}
+
+		if (delimiter_str != NULL) {
+			if (delimiter_str_len != 1) {
+				zend_argument_value_error(4, "must be a single character");
+				RETURN_THROWS();
+			}
+
+			delimiter = delimiter_str[0];
+		}
+
+		if (enclosure_str != NULL) {
+			if (enclosure_str_len != 1) {
+				zend_argument_value_error(5, "must be a single character");
+				RETURN_THROWS();
+			}
+
+			enclosure = enclosure_str[0];
+		}
+
+		if (escape_str != NULL) {
+			if (escape_str_len > 1) {
+				zend_argument_value_error(6, "must be empty or a single character");
+				RETURN_THROWS();
+			}
+
+			if (escape_str_len < 1) {
+				escape = PHP_CSV_NO_ESCAPE;
+			} else {
+				escape = (unsigned char) escape_str[0];
+			}
+		}
+
+		if (len_is_null || len == 0) {
+			len = -1;
+		} else if (len < 0) {
+			zend_argument_value_error(3, "must be a greater than or equal to 0");
+			RETURN_THROWS();
+		}
+
+		PHP_STREAM_FROM_ZVAL(stream, fd);
+	}
+
+	array_init(return_value);
+
+	zend_long rows = 0;
+	while (max_rows == 0 || rows < max_rows) {
+		char *buf;
+		size_t buf_len;
+
+		if (len < 0) {
+			if ((buf = php_stream_get_line(stream, NULL, 0, &buf_len)) == NULL) {
+				break;
+			}
+		} else {
+			buf = emalloc(len + 1);
+			if (php_stream_get_line(stream, buf, len + 1, &buf_len) == NULL) {
+				efree(buf);
+				break;
+			}
+		}
+
+		HashTable *values = php_fgetcsv(stream, delimiter, enclosure, escape, buf_len, buf);
+		if (values == NULL) {
+			values = php_bc_fgetcsv_empty_line();
+		}
+
+		zval row;
+		ZVAL_ARR(&row, values);
+		zend_hash_next_index_insert(Z_ARRVAL_P(return_value), &row);
+		rows++;
+	}
+
+	if (rows == 0) {
+		zval_ptr_dtor(return_value);
+		RETURN_FALSE;
+	}
+}
+/* }}} */
+
 PHPAPI HashTable *php_bc_fgetcsv_empty_line(void)
 {
 	HashTable *values = zend_new_array(1);
@@ -1930,6 +2107,11 @@ PHPAPI HashTable *php_fgetcsv(php_stream *stream, char delimiter, char enclosure
 	/* initialize internal state */
 	php_mb_reset();
 
+	/* In a single byte locale every character is exactly one byte long, so
+	 * the scan loops below may skip ahead to the next special character
+	 * instead of measuring every character with php_mblen(). */
+	const bool single_byte = (MB_CUR_MAX == 1);
+
 	/* Now into new section that parses buf for delimiter/enclosure fields */
 
 	/* Strip trailing space from buf, saving end of line in case required for enclosure field */
@@ -2078,6 +2260,9 @@ PHPAPI HashTable *php_fgetcsv(php_stream *stream, char delimiter, char enclosure
 									state = 2;
 								} else if (escape_char != PHP_CSV_NO_ESCAPE && *bptr == escape_char) {
 									state = 1;
+								} else if (single_byte) {
+									/* skip the whole run of ordinary characters */
+									bptr = (char *)php_fgetcsv_find_special(bptr + 1, limit, enclosure, escape_char) - 1;
 								}
 								bptr++;
 								break;
@@ -2122,6 +2307,17 @@ PHPAPI HashTable *php_fgetcsv(php_stream *stream, char delimiter, char enclosure
 						if (*bptr == delimiter) {
 							goto quit_loop_3;
 						}
+						if (single_byte) {
+							char *next = memchr(bptr, delimiter, limit - bptr);
+							if (next) {
+								bptr = next;
+								inc_len = 1;
+							} else {
+								bptr = limit;
+								inc_len = 0;
+							}
+							goto quit_loop_3;
+						}
 						break;
 					default:
 						break;
@@ -2152,6 +2348,17 @@ PHPAPI HashTable *php_fgetcsv(php_stream *stream, char delimiter, char enclosure
 						if (*bptr == delimiter) {
 							goto quit_loop_4;
 						}
+						if (single_byte) {
+							char *next = memchr(bptr, delimiter, limit - bptr);
+							if (next) {
+								bptr = next;
+								inc_len = 1;
+							} else {
+								bptr = limit;
+								inc_len = 0;
+							}
+							goto quit_loop_4;
+						}
 						break;
 					default:
 						break;
@@ -89,6 +89,8 @@ typedef struct {
 	size_t def_chunk_size;
 	bool auto_detect_line_endings;
 	zend_long default_socket_timeout;
+	zend_long dns_cache_ttl;
+	zend_long temp_stream_max_memory; /* php://temp spill-to-disk watermark */
 	char *user_agent; /* for the http wrapper */
 	char *from_address; /* for the ftp and http wrappers */
 	const char *user_stream_current_filename; /* for simple recursion protection */
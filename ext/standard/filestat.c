@@ -82,6 +82,41 @@
 #include "basic_functions.h"
 #include "php_filestat.h"
 
+/* Upper bound for the per-request stat cache; when reached, the whole table
+ * is dropped rather than tracking per-entry age. */
+#define PHP_STAT_CACHE_MAX_ENTRIES 64
+
+typedef struct _php_stat_cache_entry {
+	php_stream_statbuf ssb;
+	php_stream_statbuf lssb;
+	bool have_ssb;
+	bool have_lssb;
+} php_stat_cache_entry;
+
+PHPAPI void php_stat_cache_entry_dtor(zval *zv)
+{
+	pefree(Z_PTR_P(zv), 1);
+}
+
+PHPAPI void php_stat_cache_forget(const char *path, size_t path_len)
+{
+	zend_hash_str_del(&BG(stat_cache), path, path_len);
+}
+
+static int php_stat_cache_relative_filter(zval *zv, int num_args, va_list args, zend_hash_key *hash_key)
+{
+	if (hash_key->key && !IS_ABSOLUTE_PATH(ZSTR_VAL(hash_key->key), ZSTR_LEN(hash_key->key))) {
+		return ZEND_HASH_APPLY_REMOVE;
+	}
+	return ZEND_HASH_APPLY_KEEP;
+}
+
+/* Relative paths resolve differently after a chdir(), so drop them. */
+PHPAPI void php_stat_cache_clean_relative(void)
+{
+	zend_hash_apply_with_arguments(&BG(stat_cache), php_stat_cache_relative_filter, 0);
+}
+
 PHP_RINIT_FUNCTION(filestat) /* {{{ */
 {
 	BG(CurrentStatFile)=NULL;
@@ -100,6 +135,9 @@ PHP_RSHUTDOWN_FUNCTION(filestat) /* {{{ */
 		zend_string_release(BG(CurrentLStatFile));
 		BG(CurrentLStatFile) = NULL;
 	}
+	/* results must not leak into the next request; the (persistent) table
+	 * itself lives with the globals */
+	zend_hash_clean(&BG(stat_cache));
 	return SUCCESS;
 }
 /* }}} */
@@ -671,6 +709,12 @@ PHPAPI void php_clear_stat_cache(bool clear_realpath_cache, const char *filename
 		zend_string_release(BG(CurrentLStatFile));
 		BG(CurrentLStatFile) = NULL;
 	}
+	zend_hash_clean(&BG(stat_cache));
+	/* A change on disk can turn a previously failed autoload into a hit
+	 * (generated class files); give those names another chance.  This also
+	 * makes clearstatcache() the userland escape hatch for loaders whose
+	 * state changed without re-registering. */
+	zend_reset_failed_autoload_cache();
 	if (clear_realpath_cache) {
 		if (filename != NULL) {
 			realpath_cache_del(filename, filename_len);
@@ -784,6 +828,22 @@ PHPAPI void php_stat(zend_string *filename, int type, zval *return_value)
 			}
 		}
 
+		{
+			php_stat_cache_entry *entry = zend_hash_find_ptr(&BG(stat_cache), filename);
+
+			if (entry) {
+				if (flags & PHP_STREAM_URL_STAT_LINK) {
+					if (entry->have_lssb) {
+						stat_sb = &entry->lssb.sb;
+						break;
+					}
+				} else if (entry->have_ssb) {
+					stat_sb = &entry->ssb.sb;
+					break;
+				}
+			}
+		}
+
 		if (!wrapper) {
 			if (!ZSTR_LEN(filename) || CHECK_NULL_PATH(ZSTR_VAL(filename), ZSTR_LEN(filename))) {
 				if (ZSTR_LEN(filename) && !IS_EXISTS_CHECK(type)) {
@@ -824,6 +884,30 @@ PHPAPI void php_stat(zend_string *filename, int type, zval *return_value)
 			BG(CurrentStatFile) = zend_string_copy(filename);
 			memcpy(&BG(ssb), &ssb, sizeof(php_stream_statbuf));
 		}
+
+		{
+			php_stat_cache_entry *entry;
+
+			if (zend_hash_num_elements(&BG(stat_cache)) >= PHP_STAT_CACHE_MAX_ENTRIES) {
+				zend_hash_clean(&BG(stat_cache));
+			}
+			entry = zend_hash_find_ptr(&BG(stat_cache), filename);
+			if (!entry) {
+				entry = pecalloc(1, sizeof(php_stat_cache_entry), 1);
+				/* the table outlives the request, so it must not retain
+				 * request-allocated key strings */
+				zend_hash_str_add_new_ptr(&BG(stat_cache), ZSTR_VAL(filename), ZSTR_LEN(filename), entry);
+			}
+			if (flags & PHP_STREAM_URL_STAT_LINK) {
+				memcpy(&entry->lssb, &ssb, sizeof(php_stream_statbuf));
+				entry->have_lssb = true;
+			}
+			if (!(flags & PHP_STREAM_URL_STAT_LINK)
+			 || !S_ISLNK(ssb.sb.st_mode)) {
+				memcpy(&entry->ssb, &ssb, sizeof(php_stream_statbuf));
+				entry->have_ssb = true;
+			}
+		}
 	} while (0);
 
 	if (type >= FS_IS_W && type <= FS_IS_X) {
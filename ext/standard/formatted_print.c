@@ -17,6 +17,7 @@
 #include <math.h>				/* modf() */
 #include "php.h"
 #include "zend_execute.h"
+#include "basic_functions.h"
 
 #include <locale.h>
 #ifdef ZTS
@@ -418,297 +419,371 @@ int php_sprintf_get_argnum(char **format, size_t *format_len) {
  *  - -1: ValueError is thrown (for vsprintf where args originates from an array)
  *  - 0 or more: ArgumentCountError is thrown
  */
-static zend_string *
-php_formatted_print(char *format, size_t format_len, zval *args, int argc, int nb_additional_parameters)
+#define PHP_SPRINTF_ARG_NONE -3
+
+/* One conversion of a compiled format string: the literal run preceding it
+ * plus all parse results of the specifier itself.  Width and precision are
+ * either literal values or argument positions ('*'). */
+typedef struct _php_sprintf_spec {
+	const char *lit;    /* literal run emitted before the conversion */
+	size_t lit_len;
+	char type;          /* conversion character, 0 for a bare literal run */
+	char padding;
+	uint8_t alignment;
+	uint8_t adjusting;
+	uint8_t always_sign;
+	uint8_t expprec;
+	int argnum;         /* ARG_NUM_NEXT or explicit position */
+	int width;          /* used when width_argnum == PHP_SPRINTF_ARG_NONE */
+	int width_argnum;
+	int precision;      /* used when prec_argnum == PHP_SPRINTF_ARG_NONE */
+	int prec_argnum;
+} php_sprintf_spec;
+
+typedef struct _php_sprintf_program {
+	uint32_t num_specs;
+	php_sprintf_spec specs[1];
+} php_sprintf_program;
+
+/* Parse a format string into a program.  The literal runs point into the
+ * format string, so the program must not outlive it.  Returns NULL and
+ * throws when the format is malformed. */
+static php_sprintf_program *php_sprintf_compile(char *format, size_t format_len)
 {
-	size_t size = 240, outpos = 0;
-	int alignment, currarg, adjusting, argnum, width, precision;
-	char *temppos, padding;
-	zend_string *result;
-	int always_sign;
-	int max_missing_argnum = -1;
-
-	result = zend_string_alloc(size, 0);
-
-	currarg = 0;
-	argnum = 0;
+	uint32_t num_specs = 0, capacity = 8;
+	php_sprintf_spec *specs = safe_emalloc(capacity, sizeof(php_sprintf_spec), 0);
+	php_sprintf_program *prog;
 
 	while (format_len) {
-		int expprec;
-		zval *tmp;
+		php_sprintf_spec *spec;
+		char *temppos = memchr(format, '%', format_len);
+
+		if (num_specs == capacity) {
+			capacity *= 2;
+			specs = safe_erealloc(specs, capacity, sizeof(php_sprintf_spec), 0);
+		}
+		spec = &specs[num_specs++];
+		memset(spec, 0, sizeof(*spec));
 
-		temppos = memchr(format, '%', format_len);
 		if (!temppos) {
-			php_sprintf_appendchars(&result, &outpos, format, format_len);
+			spec->lit = format;
+			spec->lit_len = format_len;
 			break;
-		} else if (temppos != format) {
-			php_sprintf_appendchars(&result, &outpos, format, temppos - format);
-			format_len -= temppos - format;
-			format = temppos;
 		}
-		format++;			/* skip the '%' */
-		format_len--;
+		spec->lit = format;
+		spec->lit_len = temppos - format;
+		format_len -= (temppos - format) + 1;
+		format = temppos + 1;	/* skip the '%' */
 
 		if (*format == '%') {
-			php_sprintf_appendchar(&result, &outpos, '%');
+			/* "%%" prints a literal '%': extend the run to cover the
+			 * second '%' of the source instead */
+			spec->lit_len++;
 			format++;
 			format_len--;
+			continue;
+		}
+
+		spec->alignment = ALIGN_RIGHT;
+		spec->padding = ' ';
+		spec->width_argnum = PHP_SPRINTF_ARG_NONE;
+		spec->prec_argnum = PHP_SPRINTF_ARG_NONE;
+
+		if (isalpha((int)*format)) {
+			spec->argnum = ARG_NUM_NEXT;
 		} else {
-			/* starting a new format specifier, reset variables */
-			alignment = ALIGN_RIGHT;
-			adjusting = 0;
-			padding = ' ';
-			always_sign = 0;
-			expprec = 0;
-
-			PRINTF_DEBUG(("sprintf: first looking at '%c', inpos=%d\n",
-						  *format, format - Z_STRVAL_P(z_format)));
-			if (isalpha((int)*format)) {
-				width = precision = 0;
-				argnum = ARG_NUM_NEXT;
-			} else {
-				/* first look for argnum */
-				argnum = php_sprintf_get_argnum(&format, &format_len);
-				if (argnum == ARG_NUM_INVALID) {
-					goto fail;
-				}
+			/* first look for argnum */
+			spec->argnum = php_sprintf_get_argnum(&format, &format_len);
+			if (spec->argnum == ARG_NUM_INVALID) {
+				goto fail;
+			}
 
-				/* after argnum comes modifiers */
-				PRINTF_DEBUG(("sprintf: looking for modifiers\n"
-							  "sprintf: now looking at '%c', inpos=%d\n",
-							  *format, format - Z_STRVAL_P(z_format)));
-				for (;; format++, format_len--) {
-					if (*format == ' ' || *format == '0') {
-						padding = *format;
-					} else if (*format == '-') {
-						alignment = ALIGN_LEFT;
-						/* space padding, the default */
-					} else if (*format == '+') {
-						always_sign = 1;
-					} else if (*format == '\'') {
-						if (format_len > 1) {
-							format++;
-							format_len--;
-							padding = *format;
-						} else {
-							zend_value_error("Missing padding character");
-							goto fail;
-						}
+			/* after argnum comes modifiers */
+			for (;; format++, format_len--) {
+				if (*format == ' ' || *format == '0') {
+					spec->padding = *format;
+				} else if (*format == '-') {
+					spec->alignment = ALIGN_LEFT;
+					/* space padding, the default */
+				} else if (*format == '+') {
+					spec->always_sign = 1;
+				} else if (*format == '\'') {
+					if (format_len > 1) {
+						format++;
+						format_len--;
+						spec->padding = *format;
 					} else {
-						PRINTF_DEBUG(("sprintf: end of modifiers\n"));
-						break;
+						zend_value_error("Missing padding character");
+						goto fail;
 					}
+				} else {
+					break;
 				}
-				PRINTF_DEBUG(("sprintf: padding='%c'\n", padding));
-				PRINTF_DEBUG(("sprintf: alignment=%s\n",
-							  (alignment == ALIGN_LEFT) ? "left" : "right"));
+			}
+
+			/* after modifiers comes width */
+			if (*format == '*') {
+				format++;
+				format_len--;
 
+				spec->width_argnum = php_sprintf_get_argnum(&format, &format_len);
+				if (spec->width_argnum == ARG_NUM_INVALID) {
+					goto fail;
+				}
+				spec->adjusting |= ADJ_WIDTH;
+			} else if (isdigit((int)*format)) {
+				if ((spec->width = php_sprintf_getnumber(&format, &format_len)) < 0) {
+					zend_value_error("Width must be greater than zero and less than %d", INT_MAX);
+					goto fail;
+				}
+				spec->adjusting |= ADJ_WIDTH;
+			}
 
-				/* after modifiers comes width */
+			/* after width and argnum comes precision */
+			if (*format == '.') {
+				format++;
+				format_len--;
 				if (*format == '*') {
 					format++;
 					format_len--;
 
-					int width_argnum = php_sprintf_get_argnum(&format, &format_len);
-					if (width_argnum == ARG_NUM_INVALID) {
+					spec->prec_argnum = php_sprintf_get_argnum(&format, &format_len);
+					if (spec->prec_argnum == ARG_NUM_INVALID) {
 						goto fail;
 					}
-					if (width_argnum == ARG_NUM_NEXT) {
-						width_argnum = currarg++;
-					}
-					if (width_argnum >= argc) {
-						max_missing_argnum = MAX(max_missing_argnum, width_argnum);
-						continue;
-					}
-					tmp = &args[width_argnum];
-					ZVAL_DEREF(tmp);
-					if (Z_TYPE_P(tmp) != IS_LONG) {
-						zend_value_error("Width must be an integer");
-						goto fail;
-					}
-					if (Z_LVAL_P(tmp) < 0 || Z_LVAL_P(tmp) > INT_MAX) {
-						zend_value_error("Width must be greater than zero and less than %d", INT_MAX);
-						goto fail;
-					}
-					width = Z_LVAL_P(tmp);
-					adjusting |= ADJ_WIDTH;
+					spec->adjusting |= ADJ_PRECISION;
+					spec->expprec = 1;
 				} else if (isdigit((int)*format)) {
-					PRINTF_DEBUG(("sprintf: getting width\n"));
-					if ((width = php_sprintf_getnumber(&format, &format_len)) < 0) {
-						zend_value_error("Width must be greater than zero and less than %d", INT_MAX);
+					if ((spec->precision = php_sprintf_getnumber(&format, &format_len)) < 0) {
+						zend_value_error("Precision must be greater than zero and less than %d", INT_MAX);
 						goto fail;
 					}
-					adjusting |= ADJ_WIDTH;
-				} else {
-					width = 0;
-				}
-				PRINTF_DEBUG(("sprintf: width=%d\n", width));
-
-				/* after width and argnum comes precision */
-				if (*format == '.') {
-					format++;
-					format_len--;
-					PRINTF_DEBUG(("sprintf: getting precision\n"));
-					if (*format == '*') {
-						format++;
-						format_len--;
-
-						int prec_argnum = php_sprintf_get_argnum(&format, &format_len);
-						if (prec_argnum == ARG_NUM_INVALID) {
-							goto fail;
-						}
-						if (prec_argnum == ARG_NUM_NEXT) {
-							prec_argnum = currarg++;
-						}
-						if (prec_argnum >= argc) {
-							max_missing_argnum = MAX(max_missing_argnum, prec_argnum);
-							continue;
-						}
-						tmp = &args[prec_argnum];
-						ZVAL_DEREF(tmp);
-						if (Z_TYPE_P(tmp) != IS_LONG) {
-							zend_value_error("Precision must be an integer");
-							goto fail;
-						}
-						if (Z_LVAL_P(tmp) < -1 || Z_LVAL_P(tmp) > INT_MAX) {
-							zend_value_error("Precision must be between -1 and %d", INT_MAX);
-							goto fail;
-						}
-						precision = Z_LVAL_P(tmp);
-						adjusting |= ADJ_PRECISION;
-						expprec = 1;
-					} else if (isdigit((int)*format)) {
-						if ((precision = php_sprintf_getnumber(&format, &format_len)) < 0) {
-							zend_value_error("Precision must be greater than zero and less than %d", INT_MAX);
-							goto fail;
-						}
-						adjusting |= ADJ_PRECISION;
-						expprec = 1;
-					} else {
-						precision = 0;
-					}
-				} else {
-					precision = 0;
+					spec->adjusting |= ADJ_PRECISION;
+					spec->expprec = 1;
 				}
-				PRINTF_DEBUG(("sprintf: precision=%d\n", precision));
 			}
+		}
 
-			if (*format == 'l') {
-				format++;
-				format_len--;
-			}
-			PRINTF_DEBUG(("sprintf: format character='%c'\n", *format));
+		if (*format == 'l') {
+			format++;
+			format_len--;
+		}
 
-			if (argnum == ARG_NUM_NEXT) {
-				argnum = currarg++;
-			}
-			if (argnum >= argc) {
-				max_missing_argnum = MAX(max_missing_argnum, argnum);
-				continue;
-			}
+		/* now we expect to find a type specifier */
+		switch (*format) {
+			case 's':
+			case 'd':
+			case 'u':
+			case 'e':
+			case 'E':
+			case 'f':
+			case 'F':
+			case 'g':
+			case 'G':
+			case 'h':
+			case 'H':
+			case 'c':
+			case 'o':
+			case 'x':
+			case 'X':
+			case 'b':
+			case '%':
+				spec->type = *format;
+				break;
+
+			case '\0':
+				if (!format_len) {
+					zend_value_error("Missing format specifier at end of string");
+					goto fail;
+				}
+				ZEND_FALLTHROUGH;
 
-			if (expprec && precision == -1
-					&& *format != 'g' && *format != 'G' && *format != 'h' && *format != 'H') {
-				zend_value_error("Precision -1 is only supported for %%g, %%G, %%h and %%H");
+			default:
+				zend_value_error("Unknown format specifier \"%c\"", *format);
 				goto fail;
-			}
-
-			/* now we expect to find a type specifier */
-			tmp = &args[argnum];
-			switch (*format) {
-				case 's': {
-					zend_string *t;
-					zend_string *str = zval_get_tmp_string(tmp, &t);
-					php_sprintf_appendstring(&result, &outpos,
-											 ZSTR_VAL(str),
-											 width, precision, padding,
-											 alignment,
-											 ZSTR_LEN(str),
-											 /* neg */ false, expprec, 0);
-					zend_tmp_string_release(t);
-					break;
-				}
+		}
+		format++;
+		format_len--;
+	}
 
-				case 'd':
-					php_sprintf_appendint(&result, &outpos,
-										  zval_get_long(tmp),
-										  width, padding, alignment,
-										  always_sign);
-					break;
+	prog = emalloc(sizeof(php_sprintf_program)
+		+ (num_specs ? num_specs - 1 : 0) * sizeof(php_sprintf_spec));
+	prog->num_specs = num_specs;
+	memcpy(prog->specs, specs, num_specs * sizeof(php_sprintf_spec));
+	efree(specs);
+	return prog;
 
-				case 'u':
-					php_sprintf_appenduint(&result, &outpos,
-										  zval_get_long(tmp),
-										  width, padding, alignment);
-					break;
+fail:
+	efree(specs);
+	return NULL;
+}
 
-				case 'e':
-				case 'E':
-				case 'f':
-				case 'F':
-				case 'g':
-				case 'G':
-				case 'h':
-				case 'H':
-					php_sprintf_appenddouble(&result, &outpos,
-											 zval_get_double(tmp),
-											 width, padding, alignment,
-											 precision, adjusting,
-											 *format, always_sign
-											);
-					break;
+static zend_string *
+php_sprintf_execute(const php_sprintf_program *prog, zval *args, int argc, int nb_additional_parameters)
+{
+	size_t size = 240, outpos = 0;
+	zend_string *result = zend_string_alloc(size, 0);
+	const php_sprintf_spec *spec = prog->specs;
+	const php_sprintf_spec *spec_end = spec + prog->num_specs;
+	int currarg = 0;
+	int max_missing_argnum = -1;
 
-				case 'c':
-					php_sprintf_appendchar(&result, &outpos,
-										(char) zval_get_long(tmp));
-					break;
+	for (; spec != spec_end; spec++) {
+		zval *tmp;
+		int argnum, width, precision;
 
-				case 'o':
-					php_sprintf_append2n(&result, &outpos,
-										 zval_get_long(tmp),
-										 width, padding, alignment, 3,
-										 hexchars, expprec);
-					break;
+		if (spec->lit_len) {
+			php_sprintf_appendchars(&result, &outpos, (char *) spec->lit, spec->lit_len);
+		}
+		if (!spec->type) {
+			continue;
+		}
 
-				case 'x':
-					php_sprintf_append2n(&result, &outpos,
-										 zval_get_long(tmp),
-										 width, padding, alignment, 4,
-										 hexchars, expprec);
-					break;
+		width = spec->width;
+		if (spec->width_argnum != PHP_SPRINTF_ARG_NONE) {
+			int width_argnum = spec->width_argnum;
 
-				case 'X':
-					php_sprintf_append2n(&result, &outpos,
-										 zval_get_long(tmp),
-										 width, padding, alignment, 4,
-										 HEXCHARS, expprec);
-					break;
+			if (width_argnum == ARG_NUM_NEXT) {
+				width_argnum = currarg++;
+			}
+			if (width_argnum >= argc) {
+				max_missing_argnum = MAX(max_missing_argnum, width_argnum);
+				continue;
+			}
+			tmp = &args[width_argnum];
+			ZVAL_DEREF(tmp);
+			if (Z_TYPE_P(tmp) != IS_LONG) {
+				zend_value_error("Width must be an integer");
+				goto fail;
+			}
+			if (Z_LVAL_P(tmp) < 0 || Z_LVAL_P(tmp) > INT_MAX) {
+				zend_value_error("Width must be greater than zero and less than %d", INT_MAX);
+				goto fail;
+			}
+			width = Z_LVAL_P(tmp);
+		}
 
-				case 'b':
-					php_sprintf_append2n(&result, &outpos,
-										 zval_get_long(tmp),
-										 width, padding, alignment, 1,
-										 hexchars, expprec);
-					break;
+		precision = spec->precision;
+		if (spec->prec_argnum != PHP_SPRINTF_ARG_NONE) {
+			int prec_argnum = spec->prec_argnum;
 
-				case '%':
-					php_sprintf_appendchar(&result, &outpos, '%');
+			if (prec_argnum == ARG_NUM_NEXT) {
+				prec_argnum = currarg++;
+			}
+			if (prec_argnum >= argc) {
+				max_missing_argnum = MAX(max_missing_argnum, prec_argnum);
+				continue;
+			}
+			tmp = &args[prec_argnum];
+			ZVAL_DEREF(tmp);
+			if (Z_TYPE_P(tmp) != IS_LONG) {
+				zend_value_error("Precision must be an integer");
+				goto fail;
+			}
+			if (Z_LVAL_P(tmp) < -1 || Z_LVAL_P(tmp) > INT_MAX) {
+				zend_value_error("Precision must be between -1 and %d", INT_MAX);
+				goto fail;
+			}
+			precision = Z_LVAL_P(tmp);
+		}
 
-					break;
+		argnum = spec->argnum;
+		if (argnum == ARG_NUM_NEXT) {
+			argnum = currarg++;
+		}
+		if (argnum >= argc) {
+			max_missing_argnum = MAX(max_missing_argnum, argnum);
+			continue;
+		}
 
-				case '\0':
-					if (!format_len) {
-						zend_value_error("Missing format specifier at end of string");
-						goto fail;
-					}
-					ZEND_FALLTHROUGH;
+		if (spec->expprec && precision == -1
+				&& spec->type != 'g' && spec->type != 'G' && spec->type != 'h' && spec->type != 'H') {
+			zend_value_error("Precision -1 is only supported for %%g, %%G, %%h and %%H");
+			goto fail;
+		}
 
-				default:
-					zend_value_error("Unknown format specifier \"%c\"", *format);
-					goto fail;
+		tmp = &args[argnum];
+		switch (spec->type) {
+			case 's': {
+				zend_string *t;
+				zend_string *str = zval_get_tmp_string(tmp, &t);
+				php_sprintf_appendstring(&result, &outpos,
+										 ZSTR_VAL(str),
+										 width, precision, spec->padding,
+										 spec->alignment,
+										 ZSTR_LEN(str),
+										 /* neg */ false, spec->expprec, 0);
+				zend_tmp_string_release(t);
+				break;
 			}
-			format++;
-			format_len--;
+
+			case 'd':
+				php_sprintf_appendint(&result, &outpos,
+									  zval_get_long(tmp),
+									  width, spec->padding, spec->alignment,
+									  spec->always_sign);
+				break;
+
+			case 'u':
+				php_sprintf_appenduint(&result, &outpos,
+									  zval_get_long(tmp),
+									  width, spec->padding, spec->alignment);
+				break;
+
+			case 'e':
+			case 'E':
+			case 'f':
+			case 'F':
+			case 'g':
+			case 'G':
+			case 'h':
+			case 'H':
+				php_sprintf_appenddouble(&result, &outpos,
+										 zval_get_double(tmp),
+										 width, spec->padding, spec->alignment,
+										 precision, spec->adjusting,
+										 spec->type, spec->always_sign
+										);
+				break;
+
+			case 'c':
+				php_sprintf_appendchar(&result, &outpos,
+									(char) zval_get_long(tmp));
+				break;
+
+			case 'o':
+				php_sprintf_append2n(&result, &outpos,
+									 zval_get_long(tmp),
+									 width, spec->padding, spec->alignment, 3,
+									 hexchars, spec->expprec);
+				break;
+
+			case 'x':
+				php_sprintf_append2n(&result, &outpos,
+									 zval_get_long(tmp),
+									 width, spec->padding, spec->alignment, 4,
+									 hexchars, spec->expprec);
+				break;
+
+			case 'X':
+				php_sprintf_append2n(&result, &outpos,
+									 zval_get_long(tmp),
+									 width, spec->padding, spec->alignment, 4,
+									 HEXCHARS, spec->expprec);
+				break;
+
+			case 'b':
+				php_sprintf_append2n(&result, &outpos,
+									 zval_get_long(tmp),
+									 width, spec->padding, spec->alignment, 1,
+									 hexchars, spec->expprec);
+				break;
+
+			case '%':
+				php_sprintf_appendchar(&result, &outpos, '%');
+				break;
+
+			EMPTY_SWITCH_DEFAULT_CASE()
 		}
 	}
 
@@ -730,6 +805,51 @@ fail:
 	zend_string_efree(result);
 	return NULL;
 }
+
+#define PHP_SPRINTF_CACHE_MAX_ENTRIES 256
+
+static void php_sprintf_program_dtor(zval *zv)
+{
+	efree(Z_PTR_P(zv));
+}
+
+static zend_string *
+php_formatted_print(zend_string *format, zval *args, int argc, int nb_additional_parameters)
+{
+	php_sprintf_program *prog;
+	zend_string *result;
+
+	/* Nearly all call sites pass a literal format, which the compiler hands
+	 * us as an interned string.  Those are immutable and outlive the request,
+	 * so the compiled program can be cached under the string's address and
+	 * replayed without re-parsing the format on every call. */
+	if (ZSTR_IS_INTERNED(format)) {
+		if (!BG(sprintf_compiled)) {
+			BG(sprintf_compiled) = emalloc(sizeof(HashTable));
+			zend_hash_init(BG(sprintf_compiled), 8, NULL, php_sprintf_program_dtor, 0);
+		}
+		prog = zend_hash_index_find_ptr(BG(sprintf_compiled), (zend_ulong)(uintptr_t)format);
+		if (!prog) {
+			prog = php_sprintf_compile(ZSTR_VAL(format), ZSTR_LEN(format));
+			if (!prog) {
+				return NULL;
+			}
+			if (zend_hash_num_elements(BG(sprintf_compiled)) >= PHP_SPRINTF_CACHE_MAX_ENTRIES) {
+				zend_hash_clean(BG(sprintf_compiled));
+			}
+			zend_hash_index_add_new_ptr(BG(sprintf_compiled), (zend_ulong)(uintptr_t)format, prog);
+		}
+		return php_sprintf_execute(prog, args, argc, nb_additional_parameters);
+	}
+
+	prog = php_sprintf_compile(ZSTR_VAL(format), ZSTR_LEN(format));
+	if (!prog) {
+		return NULL;
+	}
+	result = php_sprintf_execute(prog, args, argc, nb_additional_parameters);
+	efree(prog);
+	return result;
+}
 /* }}} */
 
 /* php_formatted_print_get_array() {{{ */
@@ -755,17 +875,16 @@ static zval *php_formatted_print_get_array(zend_array *array, int *argc)
 PHP_FUNCTION(sprintf)
 {
 	zend_string *result;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *args;
 	int argc;
 
 	ZEND_PARSE_PARAMETERS_START(1, -1)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_VARIADIC('*', args, argc)
 	ZEND_PARSE_PARAMETERS_END();
 
-	result = php_formatted_print(format, format_len, args, argc, 1);
+	result = php_formatted_print(format, args, argc, 1);
 	if (result == NULL) {
 		RETURN_THROWS();
 	}
@@ -777,20 +896,19 @@ PHP_FUNCTION(sprintf)
 PHP_FUNCTION(vsprintf)
 {
 	zend_string *result;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *args;
 	zend_array *array;
 	int argc;
 
 	ZEND_PARSE_PARAMETERS_START(2, 2)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_ARRAY_HT(array)
 	ZEND_PARSE_PARAMETERS_END();
 
 	args = php_formatted_print_get_array(array, &argc);
 
-	result = php_formatted_print(format, format_len, args, argc, -1);
+	result = php_formatted_print(format, args, argc, -1);
 	efree(args);
 	if (result == NULL) {
 		RETURN_THROWS();
@@ -804,17 +922,16 @@ PHP_FUNCTION(printf)
 {
 	zend_string *result;
 	size_t rlen;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *args;
 	int argc;
 
 	ZEND_PARSE_PARAMETERS_START(1, -1)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_VARIADIC('*', args, argc)
 	ZEND_PARSE_PARAMETERS_END();
 
-	result = php_formatted_print(format, format_len, args, argc, 1);
+	result = php_formatted_print(format, args, argc, 1);
 	if (result == NULL) {
 		RETURN_THROWS();
 	}
@@ -829,20 +946,19 @@ PHP_FUNCTION(vprintf)
 {
 	zend_string *result;
 	size_t rlen;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *args;
 	zend_array *array;
 	int argc;
 
 	ZEND_PARSE_PARAMETERS_START(2, 2)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_ARRAY_HT(array)
 	ZEND_PARSE_PARAMETERS_END();
 
 	args = php_formatted_print_get_array(array, &argc);
 
-	result = php_formatted_print(format, format_len, args, argc, -1);
+	result = php_formatted_print(format, args, argc, -1);
 	efree(args);
 	if (result == NULL) {
 		RETURN_THROWS();
@@ -857,21 +973,20 @@ PHP_FUNCTION(vprintf)
 PHP_FUNCTION(fprintf)
 {
 	php_stream *stream;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *arg1, *args;
 	int argc;
 	zend_string *result;
 
 	ZEND_PARSE_PARAMETERS_START(2, -1)
 		Z_PARAM_RESOURCE(arg1)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_VARIADIC('*', args, argc)
 	ZEND_PARSE_PARAMETERS_END();
 
 	php_stream_from_zval(stream, arg1);
 
-	result = php_formatted_print(format, format_len, args, argc, 2);
+	result = php_formatted_print(format, args, argc, 2);
 	if (result == NULL) {
 		RETURN_THROWS();
 	}
@@ -887,8 +1002,7 @@ PHP_FUNCTION(fprintf)
 PHP_FUNCTION(vfprintf)
 {
 	php_stream *stream;
-	char *format;
-	size_t format_len;
+	zend_string *format;
 	zval *arg1, *args;
 	zend_array *array;
 	int argc;
@@ -896,7 +1010,7 @@ PHP_FUNCTION(vfprintf)
 
 	ZEND_PARSE_PARAMETERS_START(3, 3)
 		Z_PARAM_RESOURCE(arg1)
-		Z_PARAM_STRING(format, format_len)
+		Z_PARAM_STR(format)
 		Z_PARAM_ARRAY_HT(array)
 	ZEND_PARSE_PARAMETERS_END();
 
@@ -904,7 +1018,7 @@ PHP_FUNCTION(vfprintf)
 
 	args = php_formatted_print_get_array(array, &argc);
 
-	result = php_formatted_print(format, format_len, args, argc, -1);
+	result = php_formatted_print(format, args, argc, -1);
 	efree(args);
 	if (result == NULL) {
 		RETURN_THROWS();
@@ -43,18 +43,24 @@
 	from an arbitrary point in time. If an optional boolean argument is
 	passed, returns an integer on 64-bit platforms or float on 32-bit
 	containing the current high-resolution time in nanoseconds. The
-	delivered timestamp is monotonic and cannot be adjusted. */
+	delivered timestamp is monotonic and cannot be adjusted. With the second
+	argument set to true a cheaper, coarser clock is read where the platform
+	provides one. */
 PHP_FUNCTION(hrtime)
 {
 #if ZEND_HRTIME_AVAILABLE
 	bool get_as_num = 0;
-	zend_hrtime_t t = zend_hrtime();
+	bool coarse = 0;
+	zend_hrtime_t t;
 
-	ZEND_PARSE_PARAMETERS_START(0, 1)
+	ZEND_PARSE_PARAMETERS_START(0, 2)
 		Z_PARAM_OPTIONAL
 		Z_PARAM_BOOL(get_as_num)
+		Z_PARAM_BOOL(coarse)
 	ZEND_PARSE_PARAMETERS_END();
 
+	t = UNEXPECTED(coarse) ? zend_hrtime_coarse() : zend_hrtime();
+
 	if (UNEXPECTED(get_as_num)) {
 		PHP_RETURN_HRTIME(t);
 	} else {
@@ -47,6 +47,11 @@
 #include <zend_hash.h>
 #include "html_tables.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#include "Zend/zend_bitset.h"
+#endif
+
 /* Macro for disabling flag of translation of non-basic entities where this isn't supported.
  * Not appropriate for html_entity_decode/htmlspecialchars_decode */
 #define LIMIT_ALL(all, doctype, charset) do { \
@@ -1096,6 +1101,59 @@ static inline void find_entity_for_char_basic(
 /* }}} */
 
 /* {{{ php_escape_html_entities */
+/* {{{ html_ascii_run_length
+ * Length of the initial run of printable ASCII bytes that never need an
+ * entity in the basic (htmlspecialchars) mode: anything in [0x20, 0x7E]
+ * except '"', '&', '\'', '<' and '>'. Bytes in that range decode to
+ * themselves in every supported charset, never start or continue a
+ * multibyte sequence, and are passed through unchanged by the per-char
+ * loop, so the whole run can be copied at once. The range check also
+ * stops at control characters, which ENT_DISALLOWED may substitute. */
+static zend_always_inline size_t html_ascii_run_length(const unsigned char *s, size_t len)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	if (len >= 16) {
+		const __m128i quot = _mm_set1_epi8('"');
+		const __m128i amp  = _mm_set1_epi8('&');
+		const __m128i apos = _mm_set1_epi8('\'');
+		const __m128i lt   = _mm_set1_epi8('<');
+		const __m128i gt   = _mm_set1_epi8('>');
+		const __m128i below_printable = _mm_set1_epi8(0x20);
+		const __m128i del = _mm_set1_epi8(0x7F);
+
+		do {
+			__m128i in = _mm_loadu_si128((const __m128i *)(s + i));
+			/* bytes >= 0x80 are negative here, so the first compare also
+			 * stops the run at the start of any multibyte sequence */
+			__m128i stop = _mm_cmplt_epi8(in, below_printable);
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, del));
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, quot));
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, amp));
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, apos));
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, lt));
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(in, gt));
+
+			uint32_t res = _mm_movemask_epi8(stop);
+			if (res) {
+				return i + zend_ulong_ntz(res);
+			}
+			i += 16;
+		} while (len - i >= 16);
+	}
+#endif
+	for (; i < len; i++) {
+		unsigned char c = s[i];
+
+		if (c - 0x20 >= 0x5F || c == '"' || c == '&' || c == '\'' || c == '<' || c == '>') {
+			break;
+		}
+	}
+	return i;
+}
+/* }}} */
+
 PHPAPI zend_string *php_escape_html_entities_ex(const unsigned char *old, size_t oldlen, int all, int flags, const char *hint_charset, bool double_encode, bool quiet)
 {
 	size_t cursor, maxlen, len;
@@ -1149,6 +1207,24 @@ PHPAPI zend_string *php_escape_html_entities_ex(const unsigned char *old, size_t
 	len = 0;
 	cursor = 0;
 	while (cursor < oldlen) {
+		if (!all) {
+			/* common case: copy over runs of printable ASCII needing no
+			 * entity in one go instead of going through the character
+			 * decoder byte by byte */
+			size_t run = html_ascii_run_length(&old[cursor], oldlen - cursor);
+
+			if (run) {
+				if (UNEXPECTED(maxlen - len < run)) {
+					replaced = zend_string_safe_realloc(replaced, maxlen, 1, run + 128, 0);
+					maxlen += run + 128;
+				}
+				memcpy(&ZSTR_VAL(replaced)[len], &old[cursor], run);
+				len += run;
+				cursor += run;
+				continue;
+			}
+		}
+
 		const unsigned char *mbsequence = NULL;
 		size_t mbseqlen					= 0,
 		       cursor_before			= cursor;
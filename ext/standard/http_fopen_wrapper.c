@@ -81,6 +81,167 @@
 #define HTTP_WRAPPER_REDIRECTED     2
 #define HTTP_WRAPPER_KEEP_METHOD    4
 
+/* Cached keep-alive connections are dropped when they have been idle for
+ * longer than this many seconds (the "keep_alive_timeout" context option
+ * overrides it). */
+#define HTTP_KEEP_ALIVE_DEFAULT_TIMEOUT	60
+
+/* Response body framing used by the keep-alive body stream */
+#define HTTP_BODY_UNTIL_CLOSE	0
+#define HTTP_BODY_LENGTH		1
+
+typedef struct _php_http_keepalive_body {
+	php_stream *conn;	/* persistent transport stream */
+	int framing;
+	size_t remaining;	/* HTTP_BODY_LENGTH: body bytes not yet delivered */
+	bool reusable;		/* conn may go back into the cache on close */
+} php_http_keepalive_body;
+
+/* Return the transport to the keep-alive cache, or tear it down when the
+ * response was not cleanly delimited. The release time is recorded in the
+ * (otherwise unused) wrapperdata of the transport stream so the next request
+ * can apply the idle timeout; it must only ever hold a non-refcounted value
+ * because the stream outlives the request. */
+static void php_http_conn_release(php_stream *conn, bool reusable)
+{
+	if (reusable && conn->writepos == conn->readpos) {
+		ZVAL_LONG(&conn->wrapperdata, (zend_long) time(NULL));
+	} else {
+		php_stream_free(conn, PHP_STREAM_FREE_CLOSE_PERSISTENT | PHP_STREAM_FREE_IGNORE_ENCLOSING);
+	}
+}
+
+static ssize_t php_http_keepalive_body_read(php_stream *stream, char *buf, size_t count)
+{
+	php_http_keepalive_body *body = (php_http_keepalive_body*)stream->abstract;
+	ssize_t nr;
+
+	if (body->framing == HTTP_BODY_LENGTH) {
+		if (body->remaining == 0) {
+			stream->eof = 1;
+			return 0;
+		}
+		if (count > body->remaining) {
+			count = body->remaining;
+		}
+	}
+
+	nr = php_stream_read(body->conn, buf, count);
+	if (nr > 0) {
+		if (body->framing == HTTP_BODY_LENGTH) {
+			body->remaining -= nr;
+			if (body->remaining == 0) {
+				stream->eof = 1;
+			}
+		}
+	} else if (php_stream_eof(body->conn)) {
+		/* the server closed early; never recycle a half-delivered connection */
+		body->reusable = false;
+		stream->eof = 1;
+	}
+
+	return nr;
+}
+
+static ssize_t php_http_keepalive_body_write(php_stream *stream, const char *buf, size_t count)
+{
+	return -1;
+}
+
+static int php_http_keepalive_body_close(php_stream *stream, int close_handle)
+{
+	php_http_keepalive_body *body = (php_http_keepalive_body*)stream->abstract;
+
+	if (body->conn) {
+		php_http_conn_release(body->conn, body->reusable && body->remaining == 0);
+		body->conn = NULL;
+	}
+	efree(body);
+	stream->abstract = NULL;
+
+	return 0;
+}
+
+static int php_http_keepalive_body_flush(php_stream *stream)
+{
+	return 0;
+}
+
+static int php_http_keepalive_body_set_option(php_stream *stream, int option, int value, void *ptrparam)
+{
+	php_http_keepalive_body *body = (php_http_keepalive_body*)stream->abstract;
+
+	if (!body->conn) {
+		return PHP_STREAM_OPTION_RETURN_NOTIMPL;
+	}
+	return php_stream_set_option(body->conn, option, value, ptrparam);
+}
+
+static const php_stream_ops php_http_keepalive_body_ops = {
+	php_http_keepalive_body_write, php_http_keepalive_body_read,
+	php_http_keepalive_body_close, php_http_keepalive_body_flush,
+	"http/keep-alive",
+	NULL, /* seek */
+	NULL, /* cast */
+	NULL, /* stat */
+	php_http_keepalive_body_set_option
+};
+
+/* Cache key of a keep-alive connection. TLS transports are only
+ * interchangeable when every context option that affects certificate
+ * verification matches, since a connection verified under one policy must
+ * never serve a request that asked for a stricter one — the same rule
+ * php_openssl_build_session_key() applies to cached TLS sessions. */
+static zend_string *php_http_keepalive_persistent_id(php_stream_context *context, zend_string *transport_string, bool use_ssl)
+{
+	smart_str id = {0};
+	zval *tmpzval;
+
+	smart_str_appends(&id, "php_http_keepalive::");
+	smart_str_append(&id, transport_string);
+
+	if (use_ssl) {
+		static const char *str_opts[] = {"peer_name", "cafile", "capath"};
+		bool verify_peer = true;
+		bool verify_peer_name = true;
+		bool allow_self_signed = false;
+		zend_long verify_depth = -1;
+		size_t i;
+
+		if ((tmpzval = php_stream_context_get_option(context, "ssl", "verify_peer")) != NULL) {
+			verify_peer = zend_is_true(tmpzval);
+		}
+		if ((tmpzval = php_stream_context_get_option(context, "ssl", "verify_peer_name")) != NULL) {
+			verify_peer_name = zend_is_true(tmpzval);
+		}
+		if ((tmpzval = php_stream_context_get_option(context, "ssl", "allow_self_signed")) != NULL) {
+			allow_self_signed = zend_is_true(tmpzval);
+		}
+		if ((tmpzval = php_stream_context_get_option(context, "ssl", "verify_depth")) != NULL) {
+			verify_depth = zval_get_long(tmpzval);
+		}
+
+		smart_str_appendc(&id, '|');
+		smart_str_appendc(&id, verify_peer ? '1' : '0');
+		smart_str_appendc(&id, verify_peer_name ? '1' : '0');
+		smart_str_appendc(&id, allow_self_signed ? '1' : '0');
+		smart_str_appendc(&id, '|');
+		smart_str_append_long(&id, verify_depth);
+
+		for (i = 0; i < sizeof(str_opts) / sizeof(str_opts[0]); i++) {
+			smart_str_appendc(&id, '|');
+			if ((tmpzval = php_stream_context_get_option(context, "ssl", str_opts[i])) != NULL) {
+				zend_string *str = zval_get_string(tmpzval);
+
+				smart_str_append(&id, str);
+				zend_string_release(str);
+			}
+		}
+	}
+
+	return smart_str_extract(&id);
+}
+
 static inline void strip_header(char *header_bag, char *lc_header_bag,
 		const char *lc_header_name)
 {
@@ -147,6 +308,11 @@ static php_stream *php_stream_url_wrap_http_ex(php_stream_wrapper *wrapper,
 	int response_code;
 	smart_str req_buf = {0};
 	bool custom_request_method;
+	bool use_keep_alive = false;
+	bool request_is_head = false;
+	bool has_content_length = false;
+	bool response_chunked = false;
+	bool connection_reusable = false;
 
 	tmp_line[0] = '\0';
 
@@ -220,9 +386,60 @@ static php_stream *php_stream_url_wrap_http_ex(php_stream_wrapper *wrapper,
 		timeout.tv_usec = 0;
 	}
 
-	stream = php_stream_xport_create(ZSTR_VAL(transport_string), ZSTR_LEN(transport_string), options,
-			STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT,
-			NULL, &timeout, context, &errstr, NULL);
+	/* Keep-alive connection reuse is opt-in and layered on the persistent
+	 * transport cache, so the TCP (and TLS) handshake is skipped when the same
+	 * scheme/host/port is requested again. Reuse is only implemented for
+	 * HTTP/1.0 framing: a 1.0 response may not use chunked encoding, so the
+	 * end of the body is always known from Content-Length (or the server
+	 * closes the connection, in which case it is simply not recycled). */
+	if (context && !use_proxy && !(options & STREAM_WILL_CAST) &&
+		(tmpzval = php_stream_context_get_option(context, "http", "keep_alive")) != NULL &&
+		zend_is_true(tmpzval)) {
+		use_keep_alive = true;
+		if ((tmpzval = php_stream_context_get_option(context, "http", "protocol_version")) != NULL &&
+			zval_get_double(tmpzval) != 1.0) {
+			use_keep_alive = false;
+		}
+	}
+
+	if (use_keep_alive) {
+		zend_string *persistent_id = php_http_keepalive_persistent_id(context, transport_string, use_ssl);
+
+		stream = php_stream_xport_create(ZSTR_VAL(transport_string), ZSTR_LEN(transport_string), options,
+				STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT,
+				ZSTR_VAL(persistent_id), &timeout, context, &errstr, NULL);
+		if (stream && Z_TYPE(stream->wrapperdata) == IS_LONG) {
+			zend_long idle_limit = HTTP_KEEP_ALIVE_DEFAULT_TIMEOUT;
+
+			if ((tmpzval = php_stream_context_get_option(context, "http", "keep_alive_timeout")) != NULL) {
+				idle_limit = zval_get_long(tmpzval);
+			}
+			if ((zend_long) time(NULL) - Z_LVAL(stream->wrapperdata) > idle_limit) {
+				/* idled out; connect anew */
+				php_stream_pclose(stream);
+				stream = php_stream_xport_create(ZSTR_VAL(transport_string), ZSTR_LEN(transport_string), options,
+						STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT,
+						ZSTR_VAL(persistent_id), &timeout, context, &errstr, NULL);
+			}
+		}
+		if (stream && Z_TYPE(stream->wrapperdata) == IS_FALSE) {
+			/* the cached connection is still checked out by another open
+			 * stream of this request; fall back to a one-shot connection
+			 * without disturbing the cache entry */
+			use_keep_alive = false;
+			stream = php_stream_xport_create(ZSTR_VAL(transport_string), ZSTR_LEN(transport_string), options,
+					STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT,
+					NULL, &timeout, context, &errstr, NULL);
+		} else if (stream) {
+			/* mark the connection as checked out */
+			ZVAL_FALSE(&stream->wrapperdata);
+		}
+		zend_string_release(persistent_id);
+	} else {
+		stream = php_stream_xport_create(ZSTR_VAL(transport_string), ZSTR_LEN(transport_string), options,
+				STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT,
+				NULL, &timeout, context, &errstr, NULL);
+	}
 
 	if (stream) {
 		php_stream_set_option(stream, PHP_STREAM_OPTION_READ_TIMEOUT, 0, &timeout);
@@ -372,6 +589,7 @@ finish:
 				|| zend_string_equals_literal(Z_STR_P(tmpzval), "HEAD")
 			) {
 				custom_request_method = 1;
+				request_is_head = zend_string_equals_literal(Z_STR_P(tmpzval), "HEAD");
 				smart_str_append(&req_buf, Z_STR_P(tmpzval));
 				smart_str_appendc(&req_buf, ' ');
 			}
@@ -409,7 +627,10 @@ finish:
 	}
 
 	/* protocol version we are speaking */
-	if (context && (tmpzval = php_stream_context_get_option(context, "http", "protocol_version")) != NULL) {
+	if (use_keep_alive) {
+		/* see above: connection reuse requires HTTP/1.0 framing */
+		smart_str_appends(&req_buf, " HTTP/1.0\r\n");
+	} else if (context && (tmpzval = php_stream_context_get_option(context, "http", "protocol_version")) != NULL) {
 		char *protocol_version;
 		spprintf(&protocol_version, 0, "%.1F", zval_get_double(tmpzval));
 
@@ -573,7 +794,11 @@ finish:
 	 * HTTP/1.0 to avoid issues when the server respond with an HTTP/1.1
 	 * keep-alive response, which is the preferred response type. */
 	if ((have_header & HTTP_HEADER_CONNECTION) == 0) {
-		smart_str_appends(&req_buf, "Connection: close\r\n");
+		if (use_keep_alive) {
+			smart_str_appends(&req_buf, "Connection: keep-alive\r\n");
+		} else {
+			smart_str_appends(&req_buf, "Connection: close\r\n");
+		}
 	}
 
 	if (context &&
@@ -724,7 +949,11 @@ finish:
 			ZVAL_STRINGL(&http_response, tmp_line, tmp_line_len);
 			zend_hash_next_index_insert(Z_ARRVAL_P(response_header), &http_response);
 		} else {
-			php_stream_close(stream);
+			if (use_keep_alive) {
+				php_http_conn_release(stream, false);
+			} else {
+				php_stream_close(stream);
+			}
 			stream = NULL;
 			php_stream_wrapper_log_error(wrapper, options, "HTTP request failed!");
 			goto out;
@@ -792,12 +1021,20 @@ finish:
 			} else if (!strncasecmp(http_header_line, "Content-Type:", sizeof("Content-Type:")-1)) {
 				php_stream_notify_info(context, PHP_STREAM_NOTIFY_MIME_TYPE_IS, http_header_value, 0);
 			} else if (!strncasecmp(http_header_line, "Content-Length:", sizeof("Content-Length:")-1)) {
+				has_content_length = true;
 				file_size = atoi(http_header_value);
 				php_stream_notify_file_size(context, file_size, http_header_line, 0);
+			} else if (use_keep_alive
+				&& !strncasecmp(http_header_line, "Connection:", sizeof("Connection:")-1)
+				&& !strncasecmp(http_header_value, "keep-alive", sizeof("keep-alive")-1)
+			) {
+				/* the server agreed to keep the connection open */
+				connection_reusable = true;
 			} else if (
 				!strncasecmp(http_header_line, "Transfer-Encoding:", sizeof("Transfer-Encoding:")-1)
 				&& !strncasecmp(http_header_value, "Chunked", sizeof("Chunked")-1)
 			) {
+				response_chunked = true;
 
 				/* create filter to decode response body */
 				if (!(options & STREAM_ONLY_GET_HEADERS)) {
@@ -834,7 +1071,30 @@ finish:
 		if (location[0] != '\0')
 			php_stream_notify_info(context, PHP_STREAM_NOTIFY_REDIRECTED, location, 0);
 
-		php_stream_close(stream);
+		if (use_keep_alive) {
+			/* Redirect responses normally carry a small body; drain it so the
+			 * connection can be reused for the follow-up request. */
+			bool drained = false;
+
+			if (connection_reusable && has_content_length && !response_chunked
+					&& file_size <= 16 * 1024) {
+				char scratch[1024];
+				size_t togo = file_size;
+
+				drained = true;
+				while (togo > 0) {
+					ssize_t nr = php_stream_read(stream, scratch, MIN(togo, sizeof(scratch)));
+					if (nr <= 0) {
+						drained = false;
+						break;
+					}
+					togo -= nr;
+				}
+			}
+			php_http_conn_release(stream, drained);
+		} else {
+			php_stream_close(stream);
+		}
 		stream = NULL;
 
 		if (transfer_encoding) {
@@ -942,6 +1202,29 @@ out:
 		php_url_free(resource);
 	}
 
+	if (stream && use_keep_alive) {
+		/* Hand out a body stream that ends at the response boundary instead of
+		 * the raw transport, so the connection can go back into the cache once
+		 * the body has been consumed and the stream is closed. */
+		php_http_keepalive_body *body = emalloc(sizeof(*body));
+
+		if (request_is_head || response_code == 204 || response_code == 304) {
+			body->framing = HTTP_BODY_LENGTH;
+			body->remaining = 0;
+		} else if (has_content_length && !response_chunked) {
+			body->framing = HTTP_BODY_LENGTH;
+			body->remaining = file_size;
+		} else {
+			body->framing = HTTP_BODY_UNTIL_CLOSE;
+			body->remaining = 0;
+		}
+		body->reusable = connection_reusable && body->framing == HTTP_BODY_LENGTH;
+		body->conn = stream;
+
+		stream = php_stream_alloc(&php_http_keepalive_body_ops, body, NULL, mode);
+		php_stream_context_set(stream, context);
+	}
+
 	if (stream) {
 		if (header_init) {
 			ZVAL_COPY(&stream->wrapperdata, response_header);
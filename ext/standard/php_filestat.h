@@ -41,6 +41,9 @@ PHP_RSHUTDOWN_FUNCTION(filestat);
 typedef size_t php_stat_len;
 
 PHPAPI void php_clear_stat_cache(bool clear_realpath_cache, const char *filename, size_t filename_len);
+PHPAPI void php_stat_cache_forget(const char *path, size_t path_len);
+PHPAPI void php_stat_cache_clean_relative(void);
+PHPAPI void php_stat_cache_entry_dtor(zval *zv);
 PHPAPI void php_stat(zend_string *filename, int type, zval *return_value);
 
 /* Switches for various filestat functions: */
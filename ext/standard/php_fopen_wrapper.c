@@ -192,7 +192,7 @@ static php_stream * php_stream_url_wrap_php(php_stream_wrapper *wrapper, const c
 
 	if (!strncasecmp(path, "temp", 4)) {
 		path += 4;
-		max_memory = PHP_STREAM_MAX_MEM;
+		max_memory = FG(temp_stream_max_memory) >= 0 ? FG(temp_stream_max_memory) : PHP_STREAM_MAX_MEM;
 		if (!strncasecmp(path, "/maxmemory:", 11)) {
 			path += 11;
 			max_memory = ZEND_STRTOL(path, NULL, 10);
@@ -99,6 +99,7 @@ PHP_FUNCTION(sha1_file)
 
 
 static void SHA1Transform(uint32_t[5], const unsigned char[64]);
+static void SHA1TransformBlocks(uint32_t[5], const unsigned char *, size_t);
 static void SHA1Encode(unsigned char *, uint32_t *, unsigned int);
 static void SHA1Decode(uint32_t *, const unsigned char *, unsigned int);
 
@@ -194,8 +195,8 @@ PHPAPI void PHP_SHA1Update(PHP_SHA1_CTX * context, const unsigned char *input,
 			((unsigned char*) & context->buffer[index], (unsigned char*) input, partLen);
 		SHA1Transform(context->state, context->buffer);
 
-		for (i = partLen; i + 63 < inputLen; i += 64)
-			SHA1Transform(context->state, &input[i]);
+		SHA1TransformBlocks(context->state, &input[partLen], (inputLen - partLen) >> 6);
+		i = partLen + ((inputLen - partLen) & ~(size_t) 0x3F);
 
 		index = 0;
 	} else
@@ -354,6 +355,110 @@ static void SHA1Transform(uint32_t state[5], const unsigned char block[64])
 }
 /* }}} */
 
+#if defined(__x86_64__) && defined(HAVE_FUNC_ATTRIBUTE_TARGET) && defined(HAVE_IMMINTRIN_H)
+# define PHP_SHA1_NI 1
+# include <immintrin.h>
+# include "Zend/zend_cpuinfo.h"
+
+/* {{{ SHA1Transform_shani
+ * SHA1 transformation over whole blocks using the x86 SHA extensions.
+ * sha1rnds4 runs four rounds per instruction; the round constant selector
+ * must be an immediate, hence the macro-expanded group list below.
+ */
+
+/* W[g] = sha1msg2(sha1msg1(W[g-4], W[g-3]) ^ W[g-2], W[g-1]), four words at
+ * a time */
+#define SHA1_NI_MSG(g) \
+	(msgs[(g) & 3] = _mm_sha1msg2_epu32( \
+		_mm_xor_si128(_mm_sha1msg1_epu32(msgs[(g) & 3], msgs[((g) - 3) & 3]), msgs[((g) - 2) & 3]), \
+		msgs[((g) - 1) & 3]))
+
+#define SHA1_NI_ROUNDS4(g, imm, msg) do { \
+		e_cur = (g) == 0 ? _mm_add_epi32(e, (msg)) : _mm_sha1nexte_epu32(prev_abcd, (msg)); \
+		prev_abcd = abcd; \
+		abcd = _mm_sha1rnds4_epu32(abcd, e_cur, (imm)); \
+	} while (0)
+
+static void SHA1Transform_shani(uint32_t state[5], const unsigned char *input, size_t blocks)
+	__attribute__((target("sha,sse4.1")));
+
+static void SHA1Transform_shani(uint32_t state[5], const unsigned char *input, size_t blocks)
+{
+	const __m128i byteswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+	__m128i abcd, e, e_cur, prev_abcd, msgs[4];
+
+	abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0x1B);
+	e = _mm_set_epi32((int) state[4], 0, 0, 0);
+
+	while (blocks--) {
+		const __m128i abcd_save = abcd, e_save = e;
+		int i;
+
+		for (i = 0; i < 4; i++) {
+			msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (input + 16 * i)), byteswap);
+		}
+
+		SHA1_NI_ROUNDS4( 0, 0, msgs[0]);
+		SHA1_NI_ROUNDS4( 1, 0, msgs[1]);
+		SHA1_NI_ROUNDS4( 2, 0, msgs[2]);
+		SHA1_NI_ROUNDS4( 3, 0, msgs[3]);
+		SHA1_NI_ROUNDS4( 4, 0, SHA1_NI_MSG( 4));
+		SHA1_NI_ROUNDS4( 5, 1, SHA1_NI_MSG( 5));
+		SHA1_NI_ROUNDS4( 6, 1, SHA1_NI_MSG( 6));
+		SHA1_NI_ROUNDS4( 7, 1, SHA1_NI_MSG( 7));
+		SHA1_NI_ROUNDS4( 8, 1, SHA1_NI_MSG( 8));
+		SHA1_NI_ROUNDS4( 9, 1, SHA1_NI_MSG( 9));
+		SHA1_NI_ROUNDS4(10, 2, SHA1_NI_MSG(10));
+		SHA1_NI_ROUNDS4(11, 2, SHA1_NI_MSG(11));
+		SHA1_NI_ROUNDS4(12, 2, SHA1_NI_MSG(12));
+		SHA1_NI_ROUNDS4(13, 2, SHA1_NI_MSG(13));
+		SHA1_NI_ROUNDS4(14, 2, SHA1_NI_MSG(14));
+		SHA1_NI_ROUNDS4(15, 3, SHA1_NI_MSG(15));
+		SHA1_NI_ROUNDS4(16, 3, SHA1_NI_MSG(16));
+		SHA1_NI_ROUNDS4(17, 3, SHA1_NI_MSG(17));
+		SHA1_NI_ROUNDS4(18, 3, SHA1_NI_MSG(18));
+		SHA1_NI_ROUNDS4(19, 3, SHA1_NI_MSG(19));
+
+		e = _mm_sha1nexte_epu32(prev_abcd, e_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+		input += 64;
+	}
+
+	_mm_storeu_si128((__m128i *) &state[0], _mm_shuffle_epi32(abcd, 0x1B));
+	state[4] = (uint32_t) _mm_extract_epi32(e, 3);
+}
+/* }}} */
+
+static bool SHA1UseSHANI(void)
+{
+	static int enabled = -1;
+
+	if (UNEXPECTED(enabled < 0)) {
+		enabled = zend_cpu_supports(ZEND_CPU_FEATURE_SHA);
+	}
+	return enabled;
+}
+#endif /* PHP_SHA1_NI */
+
+/* {{{ SHA1TransformBlocks
+   Runs the transform over a run of whole 64-byte blocks, hardware
+   accelerated where the CPU allows it.
+ */
+static void SHA1TransformBlocks(uint32_t state[5], const unsigned char *input, size_t blocks)
+{
+#ifdef PHP_SHA1_NI
+	if (SHA1UseSHANI()) {
+		SHA1Transform_shani(state, input, blocks);
+		return;
+	}
+#endif
+	while (blocks--) {
+		SHA1Transform(state, input);
+		input += 64;
+	}
+}
+/* }}} */
+
 /* {{{ SHA1Encode
    Encodes input (uint32_t) into output (unsigned char). Assumes len is
    a multiple of 4.
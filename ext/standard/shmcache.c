@@ -0,0 +1,693 @@
+/*
+   +----------------------------------------------------------------------+
+   | Copyright (c) The PHP Group                                          |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | https://www.php.net/license/3_01.txt                                 |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_shmcache.h"
+
+#if defined(HAVE_MMAP) && !defined(PHP_WIN32)
+#define PHP_SHMCACHE 1
+#endif
+
+#ifdef PHP_SHMCACHE
+
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+
+#include "php_var.h"
+#include "zend_smart_str.h"
+
+#ifndef MAP_ANONYMOUS
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Cross-worker key/value cache over one anonymous shared mapping created
+ * in the parent process before workers fork.  Values are serialize()d
+ * blobs.  As in ext/session's shm handler, everything in the segment is
+ * addressed by byte offsets (offset 0 = segment header = NULL offset), so
+ * the mapping address does not matter.
+ *
+ * Writers take a per-bucket spinlock and bracket every chain mutation
+ * with two increments of the bucket sequence counter (odd while a change
+ * is in flight).  Readers never lock: they walk the chain, copy the value
+ * out, and re-check the sequence counter; if it moved, the copy may be
+ * torn and the walk is retried.  Offsets are bounds-checked during the
+ * walk so a torn chain cannot make a reader touch memory outside the
+ * segment, which keeps the retry loop safe without a read lock. */
+
+#define SHMCACHE_BUCKETS	256	/* power of two */
+#define SHMCACHE_MIN_SIZE	(64 * 1024)
+#define SHMCACHE_ALIGNMENT	8
+#define SHMCACHE_ALIGN(s)	(((s) + SHMCACHE_ALIGNMENT - 1) & ~(size_t)(SHMCACHE_ALIGNMENT - 1))
+#define SHMCACHE_EVICT_ATTEMPTS	8
+#define SHMCACHE_READ_RETRIES	64
+
+/* Heap block header; the payload follows it directly. */
+typedef struct {
+	uint32_t size;
+	uint32_t next;
+} shmcache_block;
+
+/* One cache record: key and serialized value are stored inline. */
+typedef struct {
+	uint32_t next;		/* offset of next record in the same bucket */
+	uint32_t hv;		/* hash value of key */
+	uint32_t keylen;
+	uint32_t datalen;
+	time_t expires;		/* absolute expiry time, 0 = does not expire */
+	time_t atime;		/* time of last read or write */
+} shmcache_entry;
+
+typedef struct {
+	uint32_t lock;
+	uint32_t seq;		/* seqlock; odd while the chain is being changed */
+	uint32_t head;		/* offset of first record */
+} shmcache_bucket;
+
+typedef struct {
+	uint32_t segsize;
+	uint32_t free_head;	/* offset of first free heap block */
+	uint32_t alloc_lock;
+	pid_t owner;
+	shmcache_bucket buckets[SHMCACHE_BUCKETS];
+} shmcache_seg;
+
+static shmcache_seg *shmcache = NULL;
+static size_t shmcache_size = 0;
+
+#define SHMCACHE_PTR(off) ((void *)((char *)shmcache + (off)))
+
+static zend_always_inline bool shmcache_trylock(volatile uint32_t *lock)
+{
+	return __atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static zend_always_inline void shmcache_lock(volatile uint32_t *lock)
+{
+	while (!shmcache_trylock(lock)) {
+		sched_yield();
+	}
+}
+
+static zend_always_inline void shmcache_unlock(volatile uint32_t *lock)
+{
+	__atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+/* Bracket a chain mutation; the caller holds the bucket lock. */
+static zend_always_inline void shmcache_seq_begin(shmcache_bucket *b)
+{
+	__atomic_store_n(&b->seq, b->seq + 1, __ATOMIC_RELEASE);
+}
+
+static zend_always_inline void shmcache_seq_end(shmcache_bucket *b)
+{
+	__atomic_store_n(&b->seq, b->seq + 1, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t shmcache_hash(const zend_string *key)
+{
+	uint32_t h;
+	const char *p = ZSTR_VAL(key);
+	const char *e = ZSTR_VAL(key) + ZSTR_LEN(key);
+
+	for (h = 2166136261U; p < e; ) {
+		h *= 16777619;
+		h ^= *p++;
+	}
+
+	return h;
+}
+
+/* Carve an allocated block for payload_size payload bytes out of the free
+ * list. Returns the payload offset, 0 when no block is large enough. */
+static uint32_t shmcache_heap_alloc(size_t payload_size)
+{
+	size_t need = sizeof(shmcache_block) + SHMCACHE_ALIGN(payload_size);
+	uint32_t *prev, off, ret = 0;
+
+	shmcache_lock(&shmcache->alloc_lock);
+
+	prev = &shmcache->free_head;
+	for (off = shmcache->free_head; off; ) {
+		shmcache_block *b = SHMCACHE_PTR(off);
+
+		if (b->size >= need) {
+			if (b->size - need >= sizeof(shmcache_block) + SHMCACHE_ALIGNMENT) {
+				shmcache_block *rest = SHMCACHE_PTR(off + need);
+
+				rest->size = b->size - (uint32_t)need;
+				rest->next = b->next;
+				b->size = (uint32_t)need;
+				*prev = off + (uint32_t)need;
+			} else {
+				*prev = b->next;
+			}
+			ret = off + sizeof(shmcache_block);
+			break;
+		}
+		prev = &b->next;
+		off = b->next;
+	}
+
+	shmcache_unlock(&shmcache->alloc_lock);
+
+	return ret;
+}
+
+static void shmcache_heap_free(uint32_t payload_off)
+{
+	uint32_t off = payload_off - sizeof(shmcache_block);
+	shmcache_block *b = SHMCACHE_PTR(off);
+	uint32_t *prev, prev_off = 0, cur;
+
+	shmcache_lock(&shmcache->alloc_lock);
+
+	/* Keep the free list sorted by address so neighbours can coalesce. */
+	prev = &shmcache->free_head;
+	for (cur = shmcache->free_head; cur && cur < off; ) {
+		shmcache_block *c = SHMCACHE_PTR(cur);
+		prev_off = cur;
+		prev = &c->next;
+		cur = c->next;
+	}
+
+	if (cur && off + b->size == cur) {
+		shmcache_block *n = SHMCACHE_PTR(cur);
+		b->size += n->size;
+		b->next = n->next;
+	} else {
+		b->next = cur;
+	}
+	*prev = off;
+
+	if (prev_off) {
+		shmcache_block *p = SHMCACHE_PTR(prev_off);
+		if (prev_off + p->size == off) {
+			p->size += b->size;
+			p->next = b->next;
+		}
+	}
+
+	shmcache_unlock(&shmcache->alloc_lock);
+}
+
+/* Chain search; the caller must hold the bucket lock. */
+static uint32_t shmcache_lookup(uint32_t slot, uint32_t hv, const zend_string *key)
+{
+	uint32_t off;
+
+	for (off = shmcache->buckets[slot].head; off; ) {
+		shmcache_entry *e = SHMCACHE_PTR(off);
+
+		if (e->hv == hv && e->keylen == ZSTR_LEN(key)
+				&& !memcmp((char *)(e + 1), ZSTR_VAL(key), e->keylen)) {
+			return off;
+		}
+		off = e->next;
+	}
+
+	return 0;
+}
+
+/* Remove a record from its chain; the caller must hold the bucket lock.
+ * Returns false when the record is no longer on the chain. */
+static bool shmcache_unlink(uint32_t slot, uint32_t entry_off)
+{
+	shmcache_bucket *b = &shmcache->buckets[slot];
+	uint32_t *prev = &b->head;
+	uint32_t off;
+
+	for (off = *prev; off; ) {
+		shmcache_entry *e = SHMCACHE_PTR(off);
+
+		if (off == entry_off) {
+			shmcache_seq_begin(b);
+			*prev = e->next;
+			shmcache_seq_end(b);
+			return true;
+		}
+		prev = &e->next;
+		off = e->next;
+	}
+
+	return false;
+}
+
+/* Drop expired records from one bucket; the caller must hold its lock. */
+static void shmcache_expire_bucket(uint32_t slot, time_t now)
+{
+	uint32_t off, next;
+
+	for (off = shmcache->buckets[slot].head; off; off = next) {
+		shmcache_entry *e = SHMCACHE_PTR(off);
+
+		next = e->next;
+		if (e->expires && e->expires <= now) {
+			shmcache_unlink(slot, off);
+			shmcache_heap_free(off);
+		}
+	}
+}
+
+/* Free the least recently used record, approximating LRU across all
+ * buckets. locked_slot is the bucket the caller already holds; other
+ * buckets are only trylocked so two writers evicting at the same time
+ * cannot deadlock on each other's bucket. */
+static bool shmcache_evict(uint32_t locked_slot)
+{
+	int attempts = SHMCACHE_EVICT_ATTEMPTS;
+
+	while (attempts-- > 0) {
+		uint32_t best_slot = 0, best_off = 0, slot, off;
+		time_t best_atime = 0;
+		bool found = false;
+
+		for (slot = 0; slot < SHMCACHE_BUCKETS; slot++) {
+			if (slot != locked_slot && !shmcache_trylock(&shmcache->buckets[slot].lock)) {
+				continue;
+			}
+			for (off = shmcache->buckets[slot].head; off; ) {
+				shmcache_entry *e = SHMCACHE_PTR(off);
+
+				if (!found || e->atime < best_atime) {
+					found = true;
+					best_slot = slot;
+					best_off = off;
+					best_atime = e->atime;
+				}
+				off = e->next;
+			}
+			if (slot != locked_slot) {
+				shmcache_unlock(&shmcache->buckets[slot].lock);
+			}
+		}
+
+		if (!found) {
+			return false;
+		}
+
+		if (best_slot == locked_slot) {
+			if (shmcache_unlink(best_slot, best_off)) {
+				shmcache_heap_free(best_off);
+				return true;
+			}
+			continue;
+		}
+
+		if (!shmcache_trylock(&shmcache->buckets[best_slot].lock)) {
+			continue;
+		}
+		/* The candidate may have been removed while the bucket was
+		 * unlocked; unlink confirms it is still there. */
+		if (shmcache_unlink(best_slot, best_off)) {
+			shmcache_heap_free(best_off);
+			shmcache_unlock(&shmcache->buckets[best_slot].lock);
+			return true;
+		}
+		shmcache_unlock(&shmcache->buckets[best_slot].lock);
+	}
+
+	return false;
+}
+
+/* Lock-free fetch: walk the chain under the bucket seqlock and copy the
+ * value out; a sequence change means the copy may be torn and the walk is
+ * retried. Returns a new string with the serialized value, NULL on miss. */
+static zend_string *shmcache_read(uint32_t slot, uint32_t hv, const zend_string *key, time_t now)
+{
+	shmcache_bucket *b = &shmcache->buckets[slot];
+	int retries = SHMCACHE_READ_RETRIES;
+	zend_string *val = NULL;
+	bool locked = false;
+
+	while (1) {
+		uint32_t seq, off, steps;
+
+		if (retries-- <= 0) {
+			/* Pathological write load; fall back to the lock. */
+			shmcache_lock(&b->lock);
+			locked = true;
+		}
+
+		seq = __atomic_load_n(&b->seq, __ATOMIC_ACQUIRE);
+		if (!locked && (seq & 1)) {
+			sched_yield();
+			continue;
+		}
+
+		if (val) {
+			zend_string_efree(val);
+			val = NULL;
+		}
+
+		/* Bounds-check every offset: under a torn walk the chain may
+		 * dangle, and the reader must stay inside the segment. */
+		off = b->head;
+		steps = 0;
+		while (off) {
+			shmcache_entry *e;
+
+			if (off < sizeof(shmcache_seg)
+					|| off + sizeof(shmcache_entry) > shmcache_size
+					|| ++steps > SHMCACHE_BUCKETS * 1024) {
+				off = UINT32_MAX;	/* inconsistent; force a retry */
+				break;
+			}
+			e = SHMCACHE_PTR(off);
+			if (e->hv == hv && e->keylen == ZSTR_LEN(key)
+					&& (size_t)off + sizeof(shmcache_entry) + e->keylen + e->datalen <= shmcache_size
+					&& !memcmp((char *)(e + 1), ZSTR_VAL(key), e->keylen)) {
+				if (e->expires && e->expires <= now) {
+					off = 0;	/* expired counts as a miss */
+					break;
+				}
+				val = zend_string_init((char *)(e + 1) + e->keylen, e->datalen, 0);
+				break;
+			}
+			off = e->next;
+		}
+
+		if (locked) {
+			shmcache_unlock(&b->lock);
+			return val;
+		}
+
+		/* The fence orders the data loads above before the seq re-read; an
+		 * acquire load alone would not keep them from drifting past it on
+		 * weakly-ordered CPUs, letting a torn copy pass validation. */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (off != UINT32_MAX && __atomic_load_n(&b->seq, __ATOMIC_RELAXED) == seq) {
+			/* Best effort LRU: touch atime only when the bucket is
+			 * uncontended, and only after re-confirming the record is
+			 * still live so the store cannot hit recycled memory. */
+			if (val && shmcache_trylock(&b->lock)) {
+				uint32_t live = shmcache_lookup(slot, hv, key);
+				if (live) {
+					shmcache_entry *e = SHMCACHE_PTR(live);
+					e->atime = now;
+				}
+				shmcache_unlock(&b->lock);
+			}
+			return val;
+		}
+	}
+}
+
+static bool shmcache_write(uint32_t slot, uint32_t hv, const zend_string *key, const smart_str *data, time_t expires, time_t now)
+{
+	shmcache_bucket *b = &shmcache->buckets[slot];
+	size_t datalen = ZSTR_LEN(data->s);
+	uint32_t off;
+	shmcache_entry *e;
+
+	shmcache_lock(&b->lock);
+	shmcache_expire_bucket(slot, now);
+
+	off = shmcache_lookup(slot, hv, key);
+	if (off) {
+		shmcache_entry *old = SHMCACHE_PTR(off);
+		shmcache_block *blk = SHMCACHE_PTR(off - sizeof(shmcache_block));
+
+		if (blk->size - sizeof(shmcache_block) - sizeof(shmcache_entry) - ZSTR_LEN(key) >= datalen) {
+			/* Overwrite in place; readers are fended off by the seqlock. */
+			shmcache_seq_begin(b);
+			memcpy((char *)(old + 1) + old->keylen, ZSTR_VAL(data->s), datalen);
+			old->datalen = (uint32_t)datalen;
+			old->expires = expires;
+			old->atime = now;
+			shmcache_seq_end(b);
+			shmcache_unlock(&b->lock);
+			return true;
+		}
+		shmcache_unlink(slot, off);
+		shmcache_heap_free(off);
+	}
+
+	while (!(off = shmcache_heap_alloc(sizeof(shmcache_entry) + ZSTR_LEN(key) + datalen))) {
+		if (!shmcache_evict(slot)) {
+			shmcache_unlock(&b->lock);
+			return false;
+		}
+	}
+
+	e = SHMCACHE_PTR(off);
+	e->hv = hv;
+	e->keylen = (uint32_t)ZSTR_LEN(key);
+	e->datalen = (uint32_t)datalen;
+	e->expires = expires;
+	e->atime = now;
+	memcpy((char *)(e + 1), ZSTR_VAL(key), ZSTR_LEN(key));
+	memcpy((char *)(e + 1) + ZSTR_LEN(key), ZSTR_VAL(data->s), datalen);
+
+	shmcache_seq_begin(b);
+	e->next = b->head;
+	b->head = off;
+	shmcache_seq_end(b);
+
+	shmcache_unlock(&b->lock);
+	return true;
+}
+
+#endif /* PHP_SHMCACHE */
+
+PHP_INI_BEGIN()
+	PHP_INI_ENTRY("shmcache.size", "0", PHP_INI_SYSTEM, NULL)
+PHP_INI_END()
+
+PHP_MINIT_FUNCTION(shmcache)
+{
+	REGISTER_INI_ENTRIES();
+
+#ifdef PHP_SHMCACHE
+	zend_long requested = INI_INT("shmcache.size");
+	size_t segsize;
+	shmcache_seg *seg;
+	shmcache_block *first;
+
+	if (requested <= 0) {
+		return SUCCESS;
+	}
+	if (requested < SHMCACHE_MIN_SIZE) {
+		segsize = SHMCACHE_MIN_SIZE;
+	} else if ((zend_ulong)requested > UINT32_MAX - SHMCACHE_ALIGNMENT) {
+		segsize = UINT32_MAX - SHMCACHE_ALIGNMENT + 1;
+	} else {
+		segsize = SHMCACHE_ALIGN((size_t)requested);
+	}
+
+	seg = mmap(NULL, segsize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (seg == MAP_FAILED) {
+		zend_error(E_WARNING, "shmcache: unable to map %zu shared bytes", segsize);
+		return SUCCESS;
+	}
+
+	memset(seg, 0, sizeof(shmcache_seg));
+	seg->segsize = (uint32_t)segsize;
+	seg->owner = getpid();
+
+	first = (shmcache_block *)((char *)seg + SHMCACHE_ALIGN(sizeof(shmcache_seg)));
+	first->size = (uint32_t)(segsize - SHMCACHE_ALIGN(sizeof(shmcache_seg)));
+	first->next = 0;
+	seg->free_head = (uint32_t)SHMCACHE_ALIGN(sizeof(shmcache_seg));
+
+	shmcache = seg;
+	shmcache_size = segsize;
+#endif
+
+	return SUCCESS;
+}
+
+PHP_MSHUTDOWN_FUNCTION(shmcache)
+{
+	UNREGISTER_INI_ENTRIES();
+
+#ifdef PHP_SHMCACHE
+	if (shmcache) {
+		/* Only the process that created the mapping unmaps it. */
+		if (shmcache->owner == getpid()) {
+			munmap(shmcache, shmcache_size);
+		}
+		shmcache = NULL;
+		shmcache_size = 0;
+	}
+#endif
+
+	return SUCCESS;
+}
+
+/* {{{ Store a value in the shared memory cache */
+PHP_FUNCTION(shmcache_store)
+{
+	zend_string *key;
+	zval *value;
+	zend_long ttl = 0;
+
+	ZEND_PARSE_PARAMETERS_START(2, 3)
+		Z_PARAM_STR(key)
+		Z_PARAM_ZVAL(value)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(ttl)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (ttl < 0) {
+		zend_argument_value_error(3, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+
+#ifdef PHP_SHMCACHE
+	if (!shmcache || ZSTR_LEN(key) > UINT32_MAX) {
+		RETURN_FALSE;
+	}
+
+	smart_str buf = {0};
+	php_serialize_data_t var_hash;
+
+	PHP_VAR_SERIALIZE_INIT(var_hash);
+	php_var_serialize(&buf, value, &var_hash);
+	PHP_VAR_SERIALIZE_DESTROY(var_hash);
+
+	if (EG(exception) || !buf.s) {
+		smart_str_free(&buf);
+		RETURN_FALSE;
+	}
+
+	time_t now = time(NULL);
+	uint32_t hv = shmcache_hash(key);
+	bool ok = shmcache_write(hv & (SHMCACHE_BUCKETS - 1), hv, key, &buf,
+			ttl ? now + (time_t)ttl : 0, now);
+
+	smart_str_free(&buf);
+	RETURN_BOOL(ok);
+#else
+	RETURN_FALSE;
+#endif
+}
+/* }}} */
+
+/* {{{ Fetch a value from the shared memory cache */
+PHP_FUNCTION(shmcache_fetch)
+{
+	zend_string *key;
+	zval *success = NULL;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_STR(key)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(success)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (success) {
+		ZEND_TRY_ASSIGN_REF_FALSE(success);
+	}
+
+#ifdef PHP_SHMCACHE
+	if (!shmcache || ZSTR_LEN(key) > UINT32_MAX) {
+		RETURN_NULL();
+	}
+
+	uint32_t hv = shmcache_hash(key);
+	zend_string *data = shmcache_read(hv & (SHMCACHE_BUCKETS - 1), hv, key, time(NULL));
+
+	if (!data) {
+		RETURN_NULL();
+	}
+
+	php_unserialize_data_t var_hash;
+	const unsigned char *p = (const unsigned char *)ZSTR_VAL(data);
+	const unsigned char *end = p + ZSTR_LEN(data);
+
+	PHP_VAR_UNSERIALIZE_INIT(var_hash);
+	if (!php_var_unserialize(return_value, &p, end, &var_hash)) {
+		PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+		zend_string_efree(data);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+	PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+	zend_string_efree(data);
+
+	if (success) {
+		ZEND_TRY_ASSIGN_REF_TRUE(success);
+	}
+#else
+	RETURN_NULL();
+#endif
+}
+/* }}} */
+
+/* {{{ Remove a value from the shared memory cache */
+PHP_FUNCTION(shmcache_delete)
+{
+	zend_string *key;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_STR(key)
+	ZEND_PARSE_PARAMETERS_END();
+
+#ifdef PHP_SHMCACHE
+	if (!shmcache) {
+		RETURN_FALSE;
+	}
+
+	uint32_t hv = shmcache_hash(key);
+	uint32_t slot = hv & (SHMCACHE_BUCKETS - 1);
+	bool found = false;
+
+	shmcache_lock(&shmcache->buckets[slot].lock);
+	uint32_t off = shmcache_lookup(slot, hv, key);
+	if (off) {
+		shmcache_unlink(slot, off);
+		shmcache_heap_free(off);
+		found = true;
+	}
+	shmcache_unlock(&shmcache->buckets[slot].lock);
+
+	RETURN_BOOL(found);
+#else
+	RETURN_FALSE;
+#endif
+}
+/* }}} */
+
+/* {{{ Remove all values from the shared memory cache */
+PHP_FUNCTION(shmcache_clear)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+#ifdef PHP_SHMCACHE
+	if (!shmcache) {
+		RETURN_FALSE;
+	}
+
+	for (uint32_t slot = 0; slot < SHMCACHE_BUCKETS; slot++) {
+		shmcache_lock(&shmcache->buckets[slot].lock);
+		while (shmcache->buckets[slot].head) {
+			uint32_t off = shmcache->buckets[slot].head;
+			shmcache_unlink(slot, off);
+			shmcache_heap_free(off);
+		}
+		shmcache_unlock(&shmcache->buckets[slot].lock);
+	}
+
+	RETURN_TRUE;
+#else
+	RETURN_FALSE;
+#endif
+}
+/* }}} */
@@ -23,6 +23,7 @@
 #include "streamsfuncs.h"
 #include "php_network.h"
 #include "php_string.h"
+#include "zend_smart_str.h"
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -486,6 +487,153 @@ PHP_FUNCTION(stream_get_contents)
 }
 /* }}} */
 
+typedef struct {
+	php_stream *stream;
+	smart_str buf;
+	php_socket_t fd;
+	bool done;
+} php_stream_multi_entry;
+
+/* {{{ Reads all remaining bytes from an array of streams, draining them
+	concurrently, and returns the contents keyed like the input array */
+PHP_FUNCTION(stream_get_contents_multi)
+{
+	HashTable *streams;
+	zval *elem;
+	php_stream_multi_entry *entries, *e;
+	php_pollfd *ufds;
+	uint32_t count, pending = 0, i = 0, n;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_ARRAY_HT(streams)
+	ZEND_PARSE_PARAMETERS_END();
+
+	count = zend_hash_num_elements(streams);
+	if (!count) {
+		RETURN_EMPTY_ARRAY();
+	}
+
+	ZEND_HASH_FOREACH_VAL(streams, elem) {
+		php_stream *stream;
+
+		ZVAL_DEREF(elem);
+		if (Z_TYPE_P(elem) != IS_RESOURCE) {
+			zend_argument_type_error(1, "must only contain stream resources");
+			RETURN_THROWS();
+		}
+		php_stream_from_zval_no_verify(stream, elem);
+		if (stream == NULL) {
+			zend_argument_type_error(1, "must only contain stream resources");
+			RETURN_THROWS();
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	entries = safe_emalloc(count, sizeof(php_stream_multi_entry), 0);
+	ufds = safe_emalloc(count, sizeof(php_pollfd), 0);
+
+	ZEND_HASH_FOREACH_VAL(streams, elem) {
+		/* Temporary int fd for the STREAM data type on windows, see stream_array_to_fd_set() */
+		php_socket_t this_fd;
+
+		ZVAL_DEREF(elem);
+		e = &entries[i++];
+		php_stream_from_zval_no_verify(e->stream, elem);
+		memset(&e->buf, 0, sizeof(e->buf));
+		if (SUCCESS == php_stream_cast(e->stream, PHP_STREAM_AS_FD_FOR_SELECT | PHP_STREAM_CAST_INTERNAL, (void*)&this_fd, 1) && this_fd != -1) {
+			e->fd = this_fd;
+			e->done = false;
+			pending++;
+		} else {
+			/* not descriptor backed (memory streams etc.); drain right away */
+			zend_string *contents = php_stream_copy_to_mem(e->stream, PHP_STREAM_COPY_ALL, 0);
+			if (contents) {
+				smart_str_append(&e->buf, contents);
+				zend_string_release_ex(contents, 0);
+			}
+			e->done = true;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	while (pending > 0) {
+		uint32_t progressed = 0;
+
+		/* serve buffered stream data first, the descriptor won't signal it */
+		for (i = 0; i < count; i++) {
+			e = &entries[i];
+			if (!e->done && (e->stream->writepos - e->stream->readpos) > 0) {
+				char chunk[8192];
+				ssize_t ret = php_stream_read(e->stream, chunk, sizeof(chunk));
+
+				if (ret > 0) {
+					smart_str_appendl(&e->buf, chunk, ret);
+					progressed++;
+				} else {
+					e->done = true;
+					pending--;
+				}
+			}
+		}
+		if (progressed || !pending) {
+			continue;
+		}
+
+		n = 0;
+		for (i = 0; i < count; i++) {
+			if (!entries[i].done) {
+				ufds[n].fd = entries[i].fd;
+				ufds[n].events = PHP_POLLREADABLE;
+				ufds[n].revents = 0;
+				n++;
+			}
+		}
+		if (php_poll2(ufds, n, -1) < 0) {
+			php_error_docref(NULL, E_WARNING, "Unable to poll streams: %d", php_socket_errno());
+			break;
+		}
+
+		n = 0;
+		for (i = 0; i < count; i++) {
+			e = &entries[i];
+			if (e->done) {
+				continue;
+			}
+			if (ufds[n++].revents & (PHP_POLLREADABLE | POLLNVAL)) {
+				char chunk[8192];
+				ssize_t ret = php_stream_read(e->stream, chunk, sizeof(chunk));
+
+				if (ret > 0) {
+					smart_str_appendl(&e->buf, chunk, ret);
+				} else if (ret < 0 || php_stream_eof(e->stream)) {
+					e->done = true;
+					pending--;
+				}
+			}
+		}
+	}
+
+	array_init_size(return_value, count);
+	i = 0;
+	{
+		zend_ulong num_key;
+		zend_string *str_key;
+
+		ZEND_HASH_FOREACH_KEY(streams, num_key, str_key) {
+			zval zcontents;
+
+			ZVAL_STR(&zcontents, smart_str_extract(&entries[i++].buf));
+			if (str_key) {
+				zend_hash_update(Z_ARRVAL_P(return_value), str_key, &zcontents);
+			} else {
+				zend_hash_index_update(Z_ARRVAL_P(return_value), num_key, &zcontents);
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	efree(ufds);
+	efree(entries);
+}
+/* }}} */
+
 /* {{{ Reads up to maxlen bytes from source stream and writes them to dest stream. */
 PHP_FUNCTION(stream_copy_to_stream)
 {
@@ -617,7 +765,7 @@ PHP_FUNCTION(stream_get_wrappers)
 /* }}} */
 
 /* {{{ stream_select related functions */
-static int stream_array_to_fd_set(zval *stream_array, fd_set *fds, php_socket_t *max_fd)
+static int stream_array_to_pollfds(zval *stream_array, php_pollfd *pfds, uint32_t *nfds, short events)
 {
 	zval *elem;
 	php_stream *stream;
@@ -645,18 +793,17 @@ static int stream_array_to_fd_set(zval *stream_array, fd_set *fds, php_socket_t
 		 * */
 		if (SUCCESS == php_stream_cast(stream, PHP_STREAM_AS_FD_FOR_SELECT | PHP_STREAM_CAST_INTERNAL, (void*)&this_fd, 1) && this_fd != -1) {
 
-			PHP_SAFE_FD_SET(this_fd, fds);
-
-			if (this_fd > *max_fd) {
-				*max_fd = this_fd;
-			}
+			pfds[*nfds].fd = this_fd;
+			pfds[*nfds].events = events;
+			pfds[*nfds].revents = 0;
+			(*nfds)++;
 			cnt++;
 		}
 	} ZEND_HASH_FOREACH_END();
 	return cnt ? 1 : 0;
 }
 
-static int stream_array_from_fd_set(zval *stream_array, fd_set *fds)
+static int stream_array_from_pollfds(zval *stream_array, const php_pollfd *pfds, uint32_t *pos, short revents_mask)
 {
 	zval *elem, *dest_elem;
 	HashTable *ht;
@@ -684,7 +831,9 @@ static int stream_array_from_fd_set(zval *stream_array, fd_set *fds)
 		 * is not displayed.
 		 */
 		if (SUCCESS == php_stream_cast(stream, PHP_STREAM_AS_FD_FOR_SELECT | PHP_STREAM_CAST_INTERNAL, (void*)&this_fd, 1) && this_fd != SOCK_ERR) {
-			if (PHP_SAFE_FD_ISSET(this_fd, fds)) {
+			/* entries were appended by stream_array_to_pollfds() in this
+			 * same iteration order */
+			if (pfds[(*pos)++].revents & revents_mask) {
 				if (!key) {
 					dest_elem = zend_hash_index_update(ht, num_ind, elem);
 				} else {
@@ -755,18 +904,17 @@ static int stream_array_emulate_read_fd_set(zval *stream_array)
 }
 /* }}} */
 
-/* {{{ Runs the select() system call on the sets of streams with a timeout specified by tv_sec and tv_usec */
+/* {{{ Waits on the sets of streams with a timeout specified by tv_sec and tv_usec */
 PHP_FUNCTION(stream_select)
 {
 	zval *r_array, *w_array, *e_array;
-	struct timeval tv, *tv_p = NULL;
-	fd_set rfds, wfds, efds;
-	php_socket_t max_fd = 0;
+	php_pollfd *pfds;
+	uint32_t nfds = 0, pos = 0, max_streams = 0;
+	int timeout = -1;
 	int retval, sets = 0;
 	zend_long sec, usec = 0;
 	bool secnull;
 	bool usecnull = 1;
-	int set_count, max_set_count = 0;
 
 	ZEND_PARSE_PARAMETERS_START(4, 5)
 		Z_PARAM_ARRAY_EX2(r_array, 1, 1, 0)
@@ -777,61 +925,70 @@ PHP_FUNCTION(stream_select)
 		Z_PARAM_LONG_OR_NULL(usec, usecnull)
 	ZEND_PARSE_PARAMETERS_END();
 
-	FD_ZERO(&rfds);
-	FD_ZERO(&wfds);
-	FD_ZERO(&efds);
+	/* poll(2) takes a flat descriptor array instead of fd_set bitmaps, so
+	 * descriptor numbers beyond FD_SETSIZE need no special treatment */
+	if (r_array != NULL) {
+		max_streams += zend_hash_num_elements(Z_ARRVAL_P(r_array));
+	}
+	if (w_array != NULL) {
+		max_streams += zend_hash_num_elements(Z_ARRVAL_P(w_array));
+	}
+	if (e_array != NULL) {
+		max_streams += zend_hash_num_elements(Z_ARRVAL_P(e_array));
+	}
+	pfds = max_streams ? safe_emalloc(max_streams, sizeof(php_pollfd), 0) : NULL;
 
 	if (r_array != NULL) {
-		set_count = stream_array_to_fd_set(r_array, &rfds, &max_fd);
-		if (set_count > max_set_count)
-			max_set_count = set_count;
-		sets += set_count;
+		sets += stream_array_to_pollfds(r_array, pfds, &nfds, POLLIN);
 	}
 
 	if (w_array != NULL) {
-		set_count = stream_array_to_fd_set(w_array, &wfds, &max_fd);
-		if (set_count > max_set_count)
-			max_set_count = set_count;
-		sets += set_count;
+		sets += stream_array_to_pollfds(w_array, pfds, &nfds, POLLOUT);
 	}
 
 	if (e_array != NULL) {
-		set_count = stream_array_to_fd_set(e_array, &efds, &max_fd);
-		if (set_count > max_set_count)
-			max_set_count = set_count;
-		sets += set_count;
+		sets += stream_array_to_pollfds(e_array, pfds, &nfds, POLLPRI);
 	}
 
 	if (!sets) {
+		if (pfds) {
+			efree(pfds);
+		}
 		zend_value_error("No stream arrays were passed");
 		RETURN_THROWS();
 	}
 
-	if (!PHP_SAFE_MAX_FD(max_fd, max_set_count)) {
-		RETURN_FALSE;
-	}
-
 	if (secnull && !usecnull) {
 		if (usec != 0) {
+			efree(pfds);
 			zend_argument_value_error(5, "must be null when argument #4 ($seconds) is null");
 			RETURN_THROWS();
 		}
 	}
 
-	/* If seconds is not set to null, build the timeval, else we wait indefinitely */
+	/* If seconds is not set to null, compute the millisecond timeout, else we
+	 * wait indefinitely */
 	if (!secnull) {
 		if (sec < 0) {
+			efree(pfds);
 			zend_argument_value_error(4, "must be greater than or equal to 0");
 			RETURN_THROWS();
 		} else if (usec < 0) {
+			efree(pfds);
 			zend_argument_value_error(5, "must be greater than or equal to 0");
 			RETURN_THROWS();
 		}
 
-		/* Windows, Solaris and BSD do not like microsecond values which are >= 1 sec */
-		tv.tv_sec = (long)(sec + (usec / 1000000));
-		tv.tv_usec = (long)(usec % 1000000);
-		tv_p = &tv;
+		if (sec > (zend_long)(INT_MAX / 1000) - 1) {
+			/* ~24.8 days; effectively indefinite */
+			timeout = INT_MAX;
+		} else {
+			zend_long ms = sec * 1000;
+			/* round a sub-millisecond remainder up so e.g. tv_usec=500 still
+			 * waits instead of degrading into a busy loop */
+			zend_long us = usec / 1000 + (usec % 1000 != 0);
+			timeout = (us > INT_MAX - ms) ? INT_MAX : (int)(ms + us);
+		}
 	}
 
 	/* slight hack to support buffered data; if there is data sitting in the
@@ -848,21 +1005,30 @@ PHP_FUNCTION(stream_select)
 				zval_ptr_dtor(e_array);
 				ZVAL_EMPTY_ARRAY(e_array);
 			}
+			efree(pfds);
 			RETURN_LONG(retval);
 		}
 	}
 
-	retval = php_select(max_fd+1, &rfds, &wfds, &efds, tv_p);
+	retval = php_poll2(pfds, nfds, timeout);
 
 	if (retval == -1) {
-		php_error_docref(NULL, E_WARNING, "Unable to select [%d]: %s (max_fd=%d)",
-				errno, strerror(errno), max_fd);
+		php_error_docref(NULL, E_WARNING, "Unable to poll [%d]: %s",
+				errno, strerror(errno));
+		efree(pfds);
 		RETURN_FALSE;
 	}
 
-	if (r_array != NULL) stream_array_from_fd_set(r_array, &rfds);
-	if (w_array != NULL) stream_array_from_fd_set(w_array, &wfds);
-	if (e_array != NULL) stream_array_from_fd_set(e_array, &efds);
+	/* Count the streams that are kept rather than trusting poll()'s return
+	 * value: error conditions make a descriptor ready in more than one set,
+	 * exactly as select() reports them.  POLLNVAL is folded into readable and
+	 * writable so a stale descriptor surfaces as an I/O error instead of
+	 * blocking here forever. */
+	retval = 0;
+	if (r_array != NULL) retval += stream_array_from_pollfds(r_array, pfds, &pos, PHP_POLLREADABLE|POLLNVAL);
+	if (w_array != NULL) retval += stream_array_from_pollfds(w_array, pfds, &pos, POLLOUT|POLLERR|POLLHUP|POLLNVAL);
+	if (e_array != NULL) retval += stream_array_from_pollfds(e_array, pfds, &pos, POLLPRI|POLLNVAL);
+	efree(pfds);
 
 	RETURN_LONG(retval);
 }
@@ -66,7 +66,34 @@ static zend_string *php_bin2hex(const unsigned char *old, const size_t oldlen)
 
 	result = zend_string_safe_alloc(oldlen, 2 * sizeof(char), 0, 0);
 
-	for (i = j = 0; i < oldlen; i++) {
+	i = j = 0;
+#ifdef __SSE2__
+	if (oldlen >= 16) {
+		/* Split each byte into its nibbles, convert both registers to ASCII
+		 * ('a' - '0' - 10 is added on top of '0' for nibbles above 9) and
+		 * interleave them back into the output. */
+		const __m128i mask_0f = _mm_set1_epi8(0x0f);
+		const __m128i nine = _mm_set1_epi8(9);
+		const __m128i ascii_0 = _mm_set1_epi8('0');
+		const __m128i alpha_corr = _mm_set1_epi8('a' - '0' - 10);
+
+		do {
+			__m128i block = _mm_loadu_si128((const __m128i *) (old + i));
+			__m128i hi = _mm_and_si128(_mm_srli_epi16(block, 4), mask_0f);
+			__m128i lo = _mm_and_si128(block, mask_0f);
+
+			hi = _mm_add_epi8(_mm_add_epi8(hi, ascii_0), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), alpha_corr));
+			lo = _mm_add_epi8(_mm_add_epi8(lo, ascii_0), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), alpha_corr));
+
+			_mm_storeu_si128((__m128i *) (ZSTR_VAL(result) + j), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128((__m128i *) (ZSTR_VAL(result) + j + 16), _mm_unpackhi_epi8(hi, lo));
+			i += 16;
+			j += 32;
+		} while (i + 16 <= oldlen);
+	}
+#endif
+
+	for (; i < oldlen; i++) {
 		ZSTR_VAL(result)[j++] = hexconvtab[old[i] >> 4];
 		ZSTR_VAL(result)[j++] = hexconvtab[old[i] & 15];
 	}
@@ -84,7 +111,45 @@ static zend_string *php_hex2bin(const unsigned char *old, const size_t oldlen)
 	unsigned char *ret = (unsigned char *)ZSTR_VAL(str);
 	size_t i, j;
 
-	for (i = j = 0; i < target_length; i++) {
+	i = j = 0;
+#ifdef __SSE2__
+	if (target_length >= 8) {
+		/* Decode 16 hex digits into 8 bytes at a time. A block with any
+		 * non-hex digit is left to the scalar loop below, which duplicates
+		 * the error handling. */
+		const __m128i mask_upper = _mm_set1_epi8((char) ~0x20);
+		const __m128i digit_lo = _mm_set1_epi8('0' - 1);
+		const __m128i digit_hi = _mm_set1_epi8('9' + 1);
+		const __m128i alpha_lo = _mm_set1_epi8('A' - 1);
+		const __m128i alpha_hi = _mm_set1_epi8('F' + 1);
+
+		do {
+			__m128i block = _mm_loadu_si128((const __m128i *) (old + j));
+			__m128i upper = _mm_and_si128(block, mask_upper);
+			__m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(block, digit_lo), _mm_cmpgt_epi8(digit_hi, block));
+			__m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(upper, alpha_lo), _mm_cmpgt_epi8(alpha_hi, upper));
+
+			if (UNEXPECTED(_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff)) {
+				break;
+			}
+
+			__m128i nibbles = _mm_or_si128(
+				_mm_and_si128(is_digit, _mm_sub_epi8(block, _mm_set1_epi8('0'))),
+				_mm_and_si128(is_alpha, _mm_sub_epi8(upper, _mm_set1_epi8('A' - 10))));
+			/* Each 16-bit lane holds the high nibble in its low byte and the
+			 * low nibble in its high byte; fold the lanes into bytes. */
+			__m128i bytes = _mm_or_si128(
+				_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x000f)), 4),
+				_mm_srli_epi16(nibbles, 8));
+
+			_mm_storel_epi64((__m128i *) (ret + i), _mm_packus_epi16(bytes, bytes));
+			i += 8;
+			j += 16;
+		} while (i + 8 <= target_length);
+	}
+#endif
+
+	for (; i < target_length; i++) {
 		unsigned char c = old[j++];
 		unsigned char l = c & ~0x20;
 		int is_letter = ((unsigned int) ((l - 'A') ^ (l - 'F' - 1))) >> (8 * sizeof(unsigned int) - 1);
@@ -584,6 +649,47 @@ static zend_always_inline zend_string *php_trim_int(zend_string *str, const char
 			}
 		}
 	} else {
+#ifdef __SSE2__
+		/* Skip whole 16-byte blocks of default whitespace.  A byte is in the
+		 * set (' ', '\t', '\n', '\v', '\r', '\0') if it equals one of the
+		 * single values or falls into the '\t'..'\v' range. */
+		if (end - start >= 16) {
+			const __m128i space = _mm_set1_epi8(' ');
+			const __m128i nul = _mm_setzero_si128();
+			const __m128i cr = _mm_set1_epi8('\r');
+
+			if (mode & 1) {
+				while (end - start >= 16) {
+					__m128i block = _mm_loadu_si128((const __m128i *) start);
+					__m128i range = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+					__m128i ws = _mm_or_si128(
+						_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, nul)),
+						_mm_or_si128(_mm_cmpeq_epi8(block, cr),
+							_mm_and_si128(_mm_cmpgt_epi8(range, _mm_set1_epi8(-1)), _mm_cmplt_epi8(range, _mm_set1_epi8(3)))));
+
+					if (_mm_movemask_epi8(ws) != 0xFFFF) {
+						break;
+					}
+					start += 16;
+				}
+			}
+			if (mode & 2) {
+				while (end - start >= 16) {
+					__m128i block = _mm_loadu_si128((const __m128i *) (end - 16));
+					__m128i range = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+					__m128i ws = _mm_or_si128(
+						_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, nul)),
+						_mm_or_si128(_mm_cmpeq_epi8(block, cr),
+							_mm_and_si128(_mm_cmpgt_epi8(range, _mm_set1_epi8(-1)), _mm_cmplt_epi8(range, _mm_set1_epi8(3)))));
+
+					if (_mm_movemask_epi8(ws) != 0xFFFF) {
+						break;
+					}
+					end -= 16;
+				}
+			}
+		}
+#endif
 		if (mode & 1) {
 			while (start != end) {
 				unsigned char c = (unsigned char)*start;
@@ -855,6 +961,21 @@ PHPAPI void php_explode(const zend_string *delim, zend_string *str, zval *return
 		zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &tmp);
 	} else {
 		zend_hash_real_init_packed(Z_ARRVAL_P(return_value));
+		if (ZSTR_LEN(delim) == 1) {
+			/* Counting the pieces is a cheap memchr() scan for single-byte
+			 * delimiters and allows sizing the array up front, instead of
+			 * repeatedly doubling (and copying) it while filling */
+			size_t count = 2; /* the first piece and the tail */
+			const char *p = p2;
+
+			while ((p = memchr(p + 1, ZSTR_VAL(delim)[0], endp - p - 1)) != NULL) {
+				count++;
+			}
+			if ((size_t)limit < count) {
+				count = (size_t)limit;
+			}
+			zend_hash_extend(Z_ARRVAL_P(return_value), count, 1);
+		}
 		ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(return_value)) {
 			do {
 				ZEND_HASH_FILL_GROW();
@@ -3137,8 +3258,31 @@ static zend_string* php_char_to_str_ex(zend_string *str, char from, char *to, si
 	} else {
 		char_count = 0;
 		lc_from = zend_tolower_ascii(from);
+		source = ZSTR_VAL(str);
 		source_end = ZSTR_VAL(str) + ZSTR_LEN(str);
-		for (source = ZSTR_VAL(str); source < source_end; source++) {
+
+#ifdef __SSE2__
+		/* Case-insensitively matching a single ASCII char means matching
+		 * either of its two case variants. */
+		if (ZSTR_LEN(str) >= sizeof(__m128i)) {
+			__m128i search_lc = _mm_set1_epi8(lc_from);
+			__m128i search_uc = _mm_set1_epi8(zend_toupper_ascii(from));
+
+			do {
+				__m128i src = _mm_loadu_si128((const __m128i*)source);
+				uint32_t mask = _mm_movemask_epi8(_mm_or_si128(
+						_mm_cmpeq_epi8(src, search_lc),
+						_mm_cmpeq_epi8(src, search_uc)));
+
+				while (mask != 0) {
+					char_count++;
+					mask = mask & (mask - 1);
+				}
+				source += sizeof(__m128i);
+			} while (source + sizeof(__m128i) <= source_end);
+		}
+#endif
+		for (; source < source_end; source++) {
 			if (zend_tolower_ascii(*source) == lc_from) {
 				char_count++;
 			}
@@ -3174,8 +3318,45 @@ static zend_string* php_char_to_str_ex(zend_string *str, char from, char *to, si
 			target = zend_mempcpy(target, s, e - s);
 		}
 	} else {
+		source = ZSTR_VAL(str);
 		source_end = ZSTR_VAL(str) + ZSTR_LEN(str);
-		for (source = ZSTR_VAL(str); source < source_end; source++) {
+
+#ifdef __SSE2__
+		/* Copy blocks without an occurrence wholesale; only blocks that
+		 * contain a match go through the byte loop. The raw 16 byte store
+		 * never overruns the result: a block without matches contributes as
+		 * many output bytes as input bytes. */
+		if (source + sizeof(__m128i) <= source_end) {
+			__m128i search_lc = _mm_set1_epi8(lc_from);
+			__m128i search_uc = _mm_set1_epi8(zend_toupper_ascii(from));
+
+			do {
+				__m128i src = _mm_loadu_si128((const __m128i*)source);
+				uint32_t mask = _mm_movemask_epi8(_mm_or_si128(
+						_mm_cmpeq_epi8(src, search_lc),
+						_mm_cmpeq_epi8(src, search_uc)));
+
+				if (mask == 0) {
+					_mm_storeu_si128((__m128i*)target, src);
+					source += sizeof(__m128i);
+					target += sizeof(__m128i);
+				} else {
+					const char *block_end = source + sizeof(__m128i);
+
+					do {
+						if (zend_tolower_ascii(*source) == lc_from) {
+							target = zend_mempcpy(target, to, to_len);
+						} else {
+							*target = *source;
+							target++;
+						}
+						source++;
+					} while (source < block_end);
+				}
+			} while (source + sizeof(__m128i) <= source_end);
+		}
+#endif
+		for (; source < source_end; source++) {
 			if (zend_tolower_ascii(*source) == lc_from) {
 				target = zend_mempcpy(target, to, to_len);
 			} else {
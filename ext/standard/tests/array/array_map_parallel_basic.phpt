@@ -0,0 +1,56 @@
+--TEST--
+array_map_parallel() matches array_map() semantics
+--FILE--
+<?php
+// small arrays run serially; the result must match array_map() either way
+$input = range(1, 20);
+var_dump(array_map_parallel(fn($x) => $x * 2, $input) === array_map(fn($x) => $x * 2, $input));
+
+// string keys are preserved
+$assoc = ["a" => 1, "b" => 2, "c" => 3];
+var_dump(array_map_parallel(fn($x) => $x + 10, $assoc, 2));
+
+// empty input
+var_dump(array_map_parallel(fn($x) => $x, []));
+
+// a chunk large enough to actually fork
+$big = range(0, 4999);
+$out = array_map_parallel(fn($x) => $x * $x, $big, 4);
+var_dump(count($out), $out[0], $out[4999]);
+
+// exceptions surface in the calling process
+try {
+    array_map_parallel(function ($x) {
+        if ($x === 3) {
+            throw new Exception("boom");
+        }
+        return $x;
+    }, range(1, 5000), 2);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+
+// invalid worker count
+try {
+    array_map_parallel(fn($x) => $x, [1], -1);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+bool(true)
+array(3) {
+  ["a"]=>
+  int(11)
+  ["b"]=>
+  int(12)
+  ["c"]=>
+  int(13)
+}
+array(0) {
+}
+int(5000)
+int(0)
+int(24990001)
+boom
+array_map_parallel(): Argument #3 ($workers) must be greater than or equal to 0
@@ -0,0 +1,70 @@
+--TEST--
+array_reserve() preallocates without changing array contents
+--FILE--
+<?php
+// reserving must not change content, keys or iteration order
+$a = [];
+array_reserve($a, 1000);
+var_dump($a);
+for ($i = 0; $i < 5; $i++) {
+    $a[] = $i * 10;
+}
+var_dump($a);
+
+// existing elements survive a reserve
+$b = [1, 2, 3];
+array_reserve($b, 100);
+var_dump($b);
+
+// hash arrays can be reserved too
+$c = ["x" => 1, "y" => 2];
+array_reserve($c, 100, false);
+$c["z"] = 3;
+var_dump($c);
+
+// shrinking or zero size is a no-op
+$d = range(1, 8);
+array_reserve($d, 2);
+array_reserve($d, 0);
+var_dump(count($d));
+
+// invalid sizes
+try {
+    array_reserve($d, -1);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+array(0) {
+}
+array(5) {
+  [0]=>
+  int(0)
+  [1]=>
+  int(10)
+  [2]=>
+  int(20)
+  [3]=>
+  int(30)
+  [4]=>
+  int(40)
+}
+array(3) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+}
+array(3) {
+  ["x"]=>
+  int(1)
+  ["y"]=>
+  int(2)
+  ["z"]=>
+  int(3)
+}
+int(8)
+array_reserve(): Argument #2 ($size) must be greater than or equal to 0
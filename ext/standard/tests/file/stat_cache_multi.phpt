@@ -0,0 +1,54 @@
+--TEST--
+Per-request stat cache keeps multiple files and is invalidated by writes
+--FILE--
+<?php
+
+$dir = __DIR__ . '/stat_cache_multi';
+mkdir($dir);
+$a = $dir . '/a.txt';
+$b = $dir . '/b.txt';
+file_put_contents($a, 'aaaa');
+file_put_contents($b, 'bb');
+
+/* interleaved stats of several files stay correct */
+var_dump(filesize($a), filesize($b), filesize($a), filesize($b));
+
+/* writing through a stream refreshes what stat reports */
+file_put_contents($a, 'aaaaaaaa');
+var_dump(filesize($a));
+
+$fp = fopen($b, 'a');
+fwrite($fp, 'bbbb');
+fclose($fp);
+clearstatcache();
+var_dump(filesize($b));
+
+/* relative paths survive a chdir() */
+$cwd = getcwd();
+chdir($dir);
+var_dump(filesize('a.txt'));
+chdir($cwd);
+var_dump(filesize($dir . '/a.txt'));
+
+/* unlink drops cached data */
+unlink($b);
+var_dump(file_exists($b));
+
+?>
+--CLEAN--
+<?php
+$dir = __DIR__ . '/stat_cache_multi';
+@unlink($dir . '/a.txt');
+@unlink($dir . '/b.txt');
+@rmdir($dir);
+?>
+--EXPECT--
+int(4)
+int(2)
+int(4)
+int(2)
+int(8)
+int(6)
+int(8)
+int(8)
+bool(false)
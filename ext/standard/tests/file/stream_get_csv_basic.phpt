@@ -0,0 +1,110 @@
+--TEST--
+stream_get_csv(): basic functionality
+--FILE--
+<?php
+$file = __DIR__ . '/stream_get_csv_basic.csv';
+file_put_contents($file, "id,name,note\n" .
+	"1,water,\"still, sparkling\"\n" .
+	"2,bread,\"multi\nline\"\n" .
+	"3,salt,plain\n");
+
+$fp = fopen($file, 'r');
+
+echo "-- all rows --\n";
+var_dump(stream_get_csv($fp));
+
+echo "-- at EOF --\n";
+var_dump(stream_get_csv($fp));
+
+rewind($fp);
+echo "-- two rows at a time --\n";
+while (($rows = stream_get_csv($fp, 2)) !== false) {
+    var_dump(count($rows));
+}
+
+rewind($fp);
+echo "-- custom separator --\n";
+var_dump(stream_get_csv($fp, 1, null, ','));
+
+echo "-- invalid max_rows --\n";
+try {
+    stream_get_csv($fp, -1);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+echo "-- invalid separator --\n";
+try {
+    stream_get_csv($fp, 0, null, 'ab');
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+fclose($fp);
+?>
+--CLEAN--
+<?php
+@unlink(__DIR__ . '/stream_get_csv_basic.csv');
+?>
+--EXPECT--
+-- all rows --
+array(4) {
+  [0]=>
+  array(3) {
+    [0]=>
+    string(2) "id"
+    [1]=>
+    string(4) "name"
+    [2]=>
+    string(4) "note"
+  }
+  [1]=>
+  array(3) {
+    [0]=>
+    string(1) "1"
+    [1]=>
+    string(5) "water"
+    [2]=>
+    string(16) "still, sparkling"
+  }
+  [2]=>
+  array(3) {
+    [0]=>
+    string(1) "2"
+    [1]=>
+    string(5) "bread"
+    [2]=>
+    string(10) "multi
+line"
+  }
+  [3]=>
+  array(3) {
+    [0]=>
+    string(1) "3"
+    [1]=>
+    string(4) "salt"
+    [2]=>
+    string(5) "plain"
+  }
+}
+-- at EOF --
+bool(false)
+-- two rows at a time --
+int(2)
+int(2)
+-- custom separator --
+array(1) {
+  [0]=>
+  array(3) {
+    [0]=>
+    string(2) "id"
+    [1]=>
+    string(4) "name"
+    [2]=>
+    string(4) "note"
+  }
+}
+-- invalid max_rows --
+stream_get_csv(): Argument #2 ($max_rows) must be greater than or equal to 0
+-- invalid separator --
+stream_get_csv(): Argument #4 ($separator) must be a single character
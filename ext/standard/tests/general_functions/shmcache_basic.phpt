@@ -0,0 +1,86 @@
+--TEST--
+shmcache_store()/shmcache_fetch()/shmcache_delete()/shmcache_clear() basic behaviour
+--INI--
+shmcache.size=262144
+--SKIPIF--
+<?php
+if (!shmcache_store("skipif", 1)) die("skip shared memory cache not available");
+?>
+--FILE--
+<?php
+var_dump(shmcache_store("answer", 42));
+var_dump(shmcache_fetch("answer", $ok));
+var_dump($ok);
+
+var_dump(shmcache_store("flags", ["a" => true, "b" => [1, 2.5, null]]));
+var_dump(shmcache_fetch("flags"));
+
+echo "-- overwrite --\n";
+var_dump(shmcache_store("answer", "forty-two"));
+var_dump(shmcache_fetch("answer"));
+
+echo "-- miss --\n";
+var_dump(shmcache_fetch("nothing", $ok));
+var_dump($ok);
+
+echo "-- ttl --\n";
+var_dump(shmcache_store("gone", "soon", 1));
+var_dump(shmcache_fetch("gone"));
+sleep(2);
+var_dump(shmcache_fetch("gone", $ok));
+var_dump($ok);
+
+echo "-- delete --\n";
+var_dump(shmcache_delete("answer"));
+var_dump(shmcache_delete("answer"));
+var_dump(shmcache_fetch("answer"));
+
+echo "-- clear --\n";
+var_dump(shmcache_clear());
+var_dump(shmcache_fetch("flags"));
+
+echo "-- invalid ttl --\n";
+try {
+    shmcache_store("k", 1, -1);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+bool(true)
+int(42)
+bool(true)
+bool(true)
+array(2) {
+  ["a"]=>
+  bool(true)
+  ["b"]=>
+  array(3) {
+    [0]=>
+    int(1)
+    [1]=>
+    float(2.5)
+    [2]=>
+    NULL
+  }
+}
+-- overwrite --
+bool(true)
+string(9) "forty-two"
+-- miss --
+NULL
+bool(false)
+-- ttl --
+bool(true)
+string(4) "soon"
+NULL
+bool(false)
+-- delete --
+bool(true)
+bool(false)
+NULL
+-- clear --
+bool(true)
+NULL
+-- invalid ttl --
+shmcache_store(): Argument #3 ($ttl) must be greater than or equal to 0
@@ -0,0 +1,28 @@
+--TEST--
+Test hrtime() coarse clock
+--FILE--
+<?php
+
+var_dump(hrtime(coarse: true));
+
+$c0 = hrtime(true, true);
+$f = hrtime(true);
+$c1 = hrtime(true, true);
+
+/* Coarse readings never go backwards. */
+var_dump($c1 >= $c0);
+
+/* The coarse clock lags the precise one by at most its tick; a full
+   second of slack keeps this robust on any platform. */
+var_dump(abs($f - $c1) < 1000000000);
+
+?>
+--EXPECTF--
+array(2) {
+  [0]=>
+  int(%d)
+  [1]=>
+  int(%d)
+}
+bool(true)
+bool(true)
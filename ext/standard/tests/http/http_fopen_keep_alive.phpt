@@ -0,0 +1,44 @@
+--TEST--
+HTTP wrapper: keep-alive connection reuse through the keep_alive context option
+--SKIPIF--
+<?php require 'server.inc'; http_server_skipif(); ?>
+--FILE--
+<?php
+require 'server.inc';
+
+$server = stream_socket_server('tcp://localhost:0', $errno, $errstr);
+$uri = 'http://' . stream_socket_get_name($server, false) . '/';
+
+$pid = pcntl_fork();
+if ($pid == 0) {
+    pcntl_alarm(60);
+
+    /* Serve two responses on a single accepted connection: the second request
+     * can only succeed when the wrapper reused the first connection. */
+    $sock = stream_socket_accept($server);
+    for ($i = 1; $i <= 2; $i++) {
+        while (($line = stream_get_line($sock, 8192, "\r\n")) !== '') {
+            if ($line === false) {
+                exit(1);
+            }
+        }
+        $body = "response $i";
+        fwrite($sock, "HTTP/1.0 200 OK\r\n"
+            . "Connection: keep-alive\r\n"
+            . "Content-Length: " . strlen($body) . "\r\n\r\n"
+            . $body);
+    }
+    fclose($sock);
+    exit(0);
+}
+
+$ctx = stream_context_create(['http' => ['keep_alive' => true, 'timeout' => 10]]);
+
+var_dump(file_get_contents($uri, false, $ctx));
+var_dump(file_get_contents($uri, false, $ctx));
+
+pcntl_waitpid($pid, $status);
+?>
+--EXPECT--
+string(10) "response 1"
+string(10) "response 2"
@@ -0,0 +1,74 @@
+--TEST--
+unserialize_binary(): the allowed_classes and max_depth options
+--FILE--
+<?php
+class Allowed {
+    public int $n = 7;
+}
+class Forbidden {
+    public string $s = "secret";
+}
+
+$allowed = serialize_binary(new Allowed());
+$forbidden = serialize_binary(new Forbidden());
+
+// default: every class may be instantiated
+var_dump(unserialize_binary($forbidden) instanceof Forbidden);
+
+// explicit true behaves the same
+var_dump(unserialize_binary($forbidden, ["allowed_classes" => true]) instanceof Forbidden);
+
+// a list is matched case-insensitively and rejects everything else
+var_dump(unserialize_binary($allowed, ["allowed_classes" => ["ALLOWED"]])->n);
+var_dump(unserialize_binary($forbidden, ["allowed_classes" => ["Allowed"]]));
+
+// false rejects all objects
+var_dump(unserialize_binary($allowed, ["allowed_classes" => false]));
+
+// scalars pass whatever the filter says
+var_dump(unserialize_binary(serialize_binary([1, 2]), ["allowed_classes" => false]));
+
+try {
+    unserialize_binary($allowed, ["allowed_classes" => "Allowed"]);
+} catch (TypeError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+// max_depth overrides the ini setting for this call only
+$nested = serialize_binary([[[1]]]);
+var_dump(unserialize_binary($nested, ["max_depth" => 3])[0][0][0]);
+var_dump(unserialize_binary($nested, ["max_depth" => 2]));
+try {
+    unserialize_binary($nested, ["max_depth" => -1]);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECTF--
+bool(true)
+bool(true)
+int(7)
+
+Warning: unserialize_binary(): Class Forbidden is not allowed to be unserialized in %s on line %d
+
+Warning: unserialize_binary(): Error at offset %d of %d bytes in %s on line %d
+bool(false)
+
+Warning: unserialize_binary(): Class Allowed is not allowed to be unserialized in %s on line %d
+
+Warning: unserialize_binary(): Error at offset %d of %d bytes in %s on line %d
+bool(false)
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+}
+unserialize_binary(): Option "allowed_classes" must be of type array|bool, string given
+int(1)
+
+Warning: unserialize_binary(): Maximum depth of 2 exceeded in %s on line %d
+
+Warning: unserialize_binary(): Error at offset %d of %d bytes in %s on line %d
+bool(false)
+unserialize_binary(): Option "max_depth" must be greater than or equal to 0
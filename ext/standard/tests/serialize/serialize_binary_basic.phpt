@@ -0,0 +1,69 @@
+--TEST--
+serialize_binary()/unserialize_binary(): scalars, strings and arrays round-trip
+--FILE--
+<?php
+$values = [
+    null,
+    true,
+    false,
+    0,
+    -1,
+    42,
+    -129,
+    32768,
+    2147483648,
+    PHP_INT_MAX,
+    PHP_INT_MIN,
+    1.5,
+    -0.0,
+    NAN,
+    "",
+    "a",
+    "hello world",
+    str_repeat("x", 70000),
+    [],
+    [1, 2, 3],
+    ["a" => 1, "b" => [2, 3], 10 => "c"],
+    [0 => "zero", 2 => "two"],
+];
+foreach ($values as $value) {
+    $copy = unserialize_binary(serialize_binary($value));
+    if (is_float($value) && is_nan($value)) {
+        var_dump(is_nan($copy));
+    } else {
+        var_dump($copy === $value);
+    }
+}
+
+// repeated strings are stored once and back-referenced
+$key = str_repeat("some-long-key-", 10);
+$a = array_fill_keys([$key . "1", $key . "2", $key . "3"], $key);
+$binary = serialize_binary($a);
+var_dump(strlen($binary) < 3 * strlen($key));
+var_dump(unserialize_binary($binary) === $a);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
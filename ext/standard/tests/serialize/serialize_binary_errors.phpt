@@ -0,0 +1,51 @@
+--TEST--
+serialize_binary()/unserialize_binary(): error handling
+--FILE--
+<?php
+// not a binary payload
+var_dump(unserialize_binary("i:42;"));
+
+// truncated payload
+$binary = serialize_binary(str_repeat("x", 100));
+var_dump(unserialize_binary(substr($binary, 0, 10)));
+
+// trailing garbage
+var_dump(unserialize_binary(serialize_binary(1) . "junk"));
+
+// unknown class
+$binary = serialize_binary(new stdClass());
+var_dump(unserialize_binary(str_replace("stdClass", "ctdClass", $binary)));
+
+// array recursion is rejected
+$a = [];
+$a[] = &$a;
+try {
+    serialize_binary($a);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+
+// enums are not supported by format version 1
+enum Suit { case Hearts; }
+try {
+    serialize_binary(Suit::Hearts);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECTF--
+Warning: unserialize_binary(): Data is not a binary serialization payload in %s on line %d
+bool(false)
+
+Warning: unserialize_binary(): Error at offset %d of 10 bytes in %s on line %d
+bool(false)
+
+Warning: unserialize_binary(): Extra data starting at offset %d of %d bytes in %s on line %d
+int(1)
+
+Warning: unserialize_binary(): Class ctdClass does not exist in %s on line %d
+
+Warning: unserialize_binary(): Error at offset %d of %d bytes in %s on line %d
+bool(false)
+Recursion detected in serialize_binary()
+Serialization of enum 'Suit' is not supported by serialize_binary()
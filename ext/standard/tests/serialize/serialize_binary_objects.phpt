@@ -0,0 +1,56 @@
+--TEST--
+serialize_binary()/unserialize_binary(): objects, __serialize() and shared identity
+--FILE--
+<?php
+class Point {
+    public function __construct(
+        public int $x = 0,
+        public int $y = 0,
+        private string $label = "origin",
+    ) {}
+    public function label(): string { return $this->label; }
+}
+
+class Magic {
+    public array $data = [];
+    public function __serialize(): array {
+        return ["packed" => implode(",", $this->data)];
+    }
+    public function __unserialize(array $data): void {
+        $this->data = explode(",", $data["packed"]);
+    }
+}
+
+$p = new Point(3, 4, "corner");
+$q = unserialize_binary(serialize_binary($p));
+var_dump($q->x, $q->y, $q->label());
+
+$m = new Magic();
+$m->data = ["a", "b", "c"];
+var_dump(unserialize_binary(serialize_binary($m))->data);
+
+// the same instance stays the same instance
+$shared = new Point(1, 1);
+$arr = unserialize_binary(serialize_binary([$shared, $shared]));
+var_dump($arr[0] === $arr[1]);
+
+// object cycles survive via back-references
+$cycle = new stdClass();
+$cycle->self = $cycle;
+$copy = unserialize_binary(serialize_binary($cycle));
+var_dump($copy->self === $copy);
+?>
+--EXPECT--
+int(3)
+int(4)
+string(6) "corner"
+array(3) {
+  [0]=>
+  string(1) "a"
+  [1]=>
+  string(1) "b"
+  [2]=>
+  string(1) "c"
+}
+bool(true)
+bool(true)
@@ -1,5 +1,5 @@
 --TEST--
-Bug GH-9590 002 (stream_select does not abort upon exception or empty valid fd set)
+Bug GH-9590 002 (stream_select times out with descriptors beyond FD_SETSIZE)
 --EXTENSIONS--
 posix
 --SKIPIF--
@@ -20,20 +20,16 @@ for ($i = 0; $i < 1023; $i++) {
 
 list($a, $b) = stream_socket_pair(STREAM_PF_UNIX, STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
 
-set_error_handler(function($errno, $errstr) { throw new \Exception($errstr); });
-
 $r = [$a];
 $w = $e = [];
-var_dump(stream_select($r, $w, $e, PHP_INT_MAX));
+var_dump(stream_select($r, $w, $e, 0, 1000));
+var_dump($r);
 
 ?>
---EXPECTF--
-Fatal error: Uncaught Exception: stream_select(): You MUST recompile PHP with a larger value of FD_SETSIZE.
-It is set to 1024, but you have descriptors numbered at least as high as %d.
- --enable-fd-setsize=%d is recommended, but you may want to set it
-to equal the maximum number of open files supported by your system,
-in order to avoid seeing this error again at a later date. in %s:%d
-Stack trace:%a
+--EXPECT--
+int(0)
+array(0) {
+}
 --CLEAN--
 <?php
 for ($i = 0; $i < 1023; $i++) {
@@ -0,0 +1,61 @@
+--TEST--
+stream_get_contents_multi() drains several streams and keeps the input keys
+--FILE--
+<?php
+
+$tmp = fopen('php://temp', 'w+');
+fwrite($tmp, 'memory stream contents');
+rewind($tmp);
+
+$file = __DIR__ . '/stream_get_contents_multi.tmp';
+file_put_contents($file, str_repeat('x', 10000));
+$fp = fopen($file, 'r');
+
+list($a, $b) = stream_socket_pair(
+    stristr(PHP_OS, 'WIN') ? STREAM_PF_INET : STREAM_PF_UNIX,
+    STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
+fwrite($b, 'over the wire');
+fclose($b);
+
+$result = stream_get_contents_multi([
+    'mem' => $tmp,
+    'file' => $fp,
+    7 => $a,
+]);
+
+var_dump(array_keys($result));
+var_dump($result['mem']);
+var_dump(strlen($result['file']));
+var_dump($result[7]);
+
+var_dump(stream_get_contents_multi([]));
+
+try {
+    stream_get_contents_multi(['not a stream']);
+} catch (TypeError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+fclose($tmp);
+fclose($fp);
+fclose($a);
+?>
+--CLEAN--
+<?php
+unlink(__DIR__ . '/stream_get_contents_multi.tmp');
+?>
+--EXPECT--
+array(3) {
+  [0]=>
+  string(3) "mem"
+  [1]=>
+  string(4) "file"
+  [2]=>
+  int(7)
+}
+string(22) "memory stream contents"
+int(10000)
+string(13) "over the wire"
+array(0) {
+}
+stream_get_contents_multi(): Argument #1 ($streams) must only contain stream resources
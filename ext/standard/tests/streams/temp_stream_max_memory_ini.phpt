@@ -0,0 +1,26 @@
+--TEST--
+temp_stream_max_memory ini controls the php://temp spill threshold
+--INI--
+temp_stream_max_memory=32
+--FILE--
+<?php
+$data = str_repeat("0123456789", 10); /* 100 bytes, past the 32 byte limit */
+
+$fp = fopen('php://temp', 'w+');
+var_dump(fwrite($fp, $data));
+rewind($fp);
+var_dump(stream_get_contents($fp) === $data);
+fclose($fp);
+
+/* an explicit maxmemory in the path still overrides the ini */
+$fp = fopen('php://temp/maxmemory:1024', 'w+');
+var_dump(fwrite($fp, $data));
+rewind($fp);
+var_dump(stream_get_contents($fp) === $data);
+fclose($fp);
+?>
+--EXPECT--
+int(100)
+bool(true)
+int(100)
+bool(true)
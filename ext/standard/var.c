@@ -1441,6 +1441,916 @@ PHP_FUNCTION(unserialize)
 }
 /* }}} */
 
+/* {{{ binary serialization
+ *
+ * Compact length-prefixed binary format for cache/session payloads where the
+ * textual serialize() representation is too verbose. Layout: a two byte
+ * header (magic, version), then one tagged value. Integers are stored in the
+ * smallest of 1/2/4/8 little-endian bytes, strings are length-prefixed and
+ * every string longer than one byte is remembered so later occurrences are
+ * written as a table back-reference, packed arrays store their values without
+ * keys, and objects are serialized through __serialize()/__unserialize() or
+ * their property table like serialize() does. Repeated objects are written as
+ * back-references, which also makes object cycles safe. PHP references are
+ * flattened to their values, enums and the legacy Serializable interface are
+ * not supported by version 1 of the format, and resources serialize as null.
+ */
+
+#define PHP_BSER_MAGIC           0xBF
+#define PHP_BSER_VERSION         0x01
+
+#define PHP_BSER_NULL            0x00
+#define PHP_BSER_FALSE           0x01
+#define PHP_BSER_TRUE            0x02
+#define PHP_BSER_INT8            0x03
+#define PHP_BSER_INT16           0x04
+#define PHP_BSER_INT32           0x05
+#define PHP_BSER_INT64           0x06
+#define PHP_BSER_DOUBLE          0x07
+#define PHP_BSER_STR8            0x08
+#define PHP_BSER_STR16           0x09
+#define PHP_BSER_STR32           0x0A
+#define PHP_BSER_STRREF16        0x0B
+#define PHP_BSER_STRREF32        0x0C
+#define PHP_BSER_PACKED8         0x0D
+#define PHP_BSER_PACKED32        0x0E
+#define PHP_BSER_HASH8           0x0F
+#define PHP_BSER_HASH32          0x10
+#define PHP_BSER_OBJECT          0x11
+#define PHP_BSER_OBJREF32        0x12
+
+typedef struct {
+	smart_str *buf;
+	HashTable strings;          /* string content -> back-reference index */
+	HashTable objects;          /* object handle -> back-reference id */
+	uint32_t next_string;
+	uint32_t next_object;
+} php_bser_ctx;
+
+typedef struct {
+	const unsigned char *p;
+	const unsigned char *end;
+	zend_string **strings;      /* decoded strings, in order of first use */
+	uint32_t n_strings;
+	uint32_t cap_strings;
+	zend_object **objects;      /* decoded objects, in order of creation */
+	uint32_t n_objects;
+	uint32_t cap_objects;
+	zend_long depth;
+	zend_long max_depth;
+	HashTable *allowed_classes; /* lowercased names; NULL allows everything */
+} php_bunser_ctx;
+
+static zend_always_inline void php_bser_put8(smart_str *buf, uint8_t v)
+{
+	smart_str_appendc(buf, (char)v);
+}
+
+static zend_always_inline void php_bser_put16(smart_str *buf, uint16_t v)
+{
+	char *dst = smart_str_extend(buf, 2);
+	dst[0] = (char)(v & 0xff);
+	dst[1] = (char)(v >> 8);
+}
+
+static zend_always_inline void php_bser_put32(smart_str *buf, uint32_t v)
+{
+	char *dst = smart_str_extend(buf, 4);
+	dst[0] = (char)(v & 0xff);
+	dst[1] = (char)((v >> 8) & 0xff);
+	dst[2] = (char)((v >> 16) & 0xff);
+	dst[3] = (char)((v >> 24) & 0xff);
+}
+
+static zend_always_inline void php_bser_put64(smart_str *buf, uint64_t v)
+{
+	php_bser_put32(buf, (uint32_t)(v & 0xffffffff));
+	php_bser_put32(buf, (uint32_t)(v >> 32));
+}
+
+static void php_bser_write_long(php_bser_ctx *ctx, zend_long v)
+{
+	if (v >= INT8_MIN && v <= INT8_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_INT8);
+		php_bser_put8(ctx->buf, (uint8_t)(int8_t)v);
+	} else if (v >= INT16_MIN && v <= INT16_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_INT16);
+		php_bser_put16(ctx->buf, (uint16_t)(int16_t)v);
+	} else if (v >= INT32_MIN && v <= INT32_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_INT32);
+		php_bser_put32(ctx->buf, (uint32_t)(int32_t)v);
+	} else {
+		php_bser_put8(ctx->buf, PHP_BSER_INT64);
+		php_bser_put64(ctx->buf, (uint64_t)(int64_t)v);
+	}
+}
+
+static void php_bser_write_string(php_bser_ctx *ctx, zend_string *str)
+{
+	size_t len = ZSTR_LEN(str);
+	zval *idx_zv, idx;
+
+	if (len > 1 && (idx_zv = zend_hash_find(&ctx->strings, str))) {
+		uint32_t ref = (uint32_t)Z_LVAL_P(idx_zv);
+
+		if (ref <= UINT16_MAX) {
+			php_bser_put8(ctx->buf, PHP_BSER_STRREF16);
+			php_bser_put16(ctx->buf, (uint16_t)ref);
+		} else {
+			php_bser_put8(ctx->buf, PHP_BSER_STRREF32);
+			php_bser_put32(ctx->buf, ref);
+		}
+		return;
+	}
+
+	if (len <= UINT8_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_STR8);
+		php_bser_put8(ctx->buf, (uint8_t)len);
+	} else if (len <= UINT16_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_STR16);
+		php_bser_put16(ctx->buf, (uint16_t)len);
+	} else {
+		php_bser_put8(ctx->buf, PHP_BSER_STR32);
+		php_bser_put32(ctx->buf, (uint32_t)len);
+	}
+	smart_str_appendl(ctx->buf, ZSTR_VAL(str), len);
+
+	if (len > 1) {
+		ZVAL_LONG(&idx, ctx->next_string);
+		zend_hash_add(&ctx->strings, str, &idx);
+		ctx->next_string++;
+	}
+}
+
+static void php_var_serialize_binary_zval(php_bser_ctx *ctx, zval *zv);
+
+static void php_bser_write_hash_contents(php_bser_ctx *ctx, HashTable *ht, uint32_t count)
+{
+	zend_string *key;
+	zend_ulong index;
+	zval *val;
+
+	if (count <= UINT8_MAX) {
+		php_bser_put8(ctx->buf, PHP_BSER_HASH8);
+		php_bser_put8(ctx->buf, (uint8_t)count);
+	} else {
+		php_bser_put8(ctx->buf, PHP_BSER_HASH32);
+		php_bser_put32(ctx->buf, count);
+	}
+
+	ZEND_HASH_FOREACH_KEY_VAL(ht, index, key, val) {
+		if (Z_TYPE_P(val) == IS_INDIRECT) {
+			val = Z_INDIRECT_P(val);
+			if (Z_TYPE_P(val) == IS_UNDEF) {
+				continue;
+			}
+		}
+		if (key) {
+			php_bser_write_string(ctx, key);
+		} else {
+			php_bser_write_long(ctx, (zend_long)index);
+		}
+		php_var_serialize_binary_zval(ctx, val);
+		if (UNEXPECTED(EG(exception))) {
+			return;
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+
+static uint32_t php_bser_hash_count(HashTable *ht)
+{
+	uint32_t count = zend_hash_num_elements(ht);
+	zval *val;
+
+	ZEND_HASH_FOREACH_VAL(ht, val) {
+		if (Z_TYPE_P(val) == IS_INDIRECT && Z_TYPE_P(Z_INDIRECT_P(val)) == IS_UNDEF) {
+			count--;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return count;
+}
+
+static void php_var_serialize_binary_zval(php_bser_ctx *ctx, zval *zv)
+{
+	ZVAL_DEREF(zv);
+
+	switch (Z_TYPE_P(zv)) {
+		case IS_UNDEF:
+		case IS_NULL:
+			php_bser_put8(ctx->buf, PHP_BSER_NULL);
+			break;
+		case IS_FALSE:
+			php_bser_put8(ctx->buf, PHP_BSER_FALSE);
+			break;
+		case IS_TRUE:
+			php_bser_put8(ctx->buf, PHP_BSER_TRUE);
+			break;
+		case IS_LONG:
+			php_bser_write_long(ctx, Z_LVAL_P(zv));
+			break;
+		case IS_DOUBLE: {
+			uint64_t bits;
+
+			ZEND_ASSERT(sizeof(bits) == sizeof(double));
+			memcpy(&bits, &Z_DVAL_P(zv), sizeof(bits));
+#ifdef WORDS_BIGENDIAN
+			bits = ZEND_BYTES_SWAP64(bits);
+#endif
+			php_bser_put8(ctx->buf, PHP_BSER_DOUBLE);
+			php_bser_put64(ctx->buf, bits);
+			break;
+		}
+		case IS_STRING:
+			php_bser_write_string(ctx, Z_STR_P(zv));
+			break;
+		case IS_ARRAY: {
+			HashTable *ht = Z_ARRVAL_P(zv);
+			uint32_t count = zend_hash_num_elements(ht);
+
+			if (UNEXPECTED(Z_IS_RECURSIVE_P(zv))) {
+				zend_throw_exception_ex(NULL, 0, "Recursion detected in serialize_binary()");
+				return;
+			}
+			Z_PROTECT_RECURSION_P(zv);
+
+			if (HT_IS_PACKED(ht) && HT_IS_WITHOUT_HOLES(ht)) {
+				zval *val;
+
+				if (count <= UINT8_MAX) {
+					php_bser_put8(ctx->buf, PHP_BSER_PACKED8);
+					php_bser_put8(ctx->buf, (uint8_t)count);
+				} else {
+					php_bser_put8(ctx->buf, PHP_BSER_PACKED32);
+					php_bser_put32(ctx->buf, count);
+				}
+				/* packed arrays without holes are a plain zval vector */
+				ZEND_HASH_PACKED_FOREACH_VAL(ht, val) {
+					php_var_serialize_binary_zval(ctx, val);
+					if (UNEXPECTED(EG(exception))) {
+						break;
+					}
+				} ZEND_HASH_FOREACH_END();
+			} else {
+				php_bser_write_hash_contents(ctx, ht, count);
+			}
+
+			Z_UNPROTECT_RECURSION_P(zv);
+			break;
+		}
+		case IS_OBJECT: {
+			zend_object *obj = Z_OBJ_P(zv);
+			zend_class_entry *ce = obj->ce;
+			zval *id_zv, id;
+
+			id_zv = zend_hash_index_find(&ctx->objects, obj->handle);
+			if (id_zv) {
+				php_bser_put8(ctx->buf, PHP_BSER_OBJREF32);
+				php_bser_put32(ctx->buf, (uint32_t)Z_LVAL_P(id_zv));
+				break;
+			}
+
+			if (ce->ce_flags & ZEND_ACC_NOT_SERIALIZABLE) {
+				zend_throw_exception_ex(NULL, 0, "Serialization of '%s' is not allowed",
+					ZSTR_VAL(ce->name));
+				return;
+			}
+			if (ce->ce_flags & ZEND_ACC_ENUM) {
+				zend_throw_exception_ex(NULL, 0,
+					"Serialization of enum '%s' is not supported by serialize_binary()",
+					ZSTR_VAL(ce->name));
+				return;
+			}
+			if (!ce->__serialize && ce->serialize) {
+				zend_throw_exception_ex(NULL, 0,
+					"Serialization of '%s' is not supported by serialize_binary(), implement __serialize()",
+					ZSTR_VAL(ce->name));
+				return;
+			}
+
+			ZVAL_LONG(&id, ctx->next_object);
+			zend_hash_index_add(&ctx->objects, obj->handle, &id);
+			ctx->next_object++;
+
+			php_bser_put8(ctx->buf, PHP_BSER_OBJECT);
+			php_bser_write_string(ctx, ce->name);
+
+			if (ce->__serialize) {
+				zval retval, obj_zv;
+
+				ZVAL_OBJ_COPY(&obj_zv, obj);
+				if (php_var_serialize_call_magic_serialize(&retval, &obj_zv) == FAILURE) {
+					zval_ptr_dtor(&obj_zv);
+					return;
+				}
+				php_bser_write_hash_contents(ctx, Z_ARRVAL(retval),
+					zend_hash_num_elements(Z_ARRVAL(retval)));
+				zval_ptr_dtor(&retval);
+				zval_ptr_dtor(&obj_zv);
+			} else {
+				HashTable *props = zend_get_properties_for(zv, ZEND_PROP_PURPOSE_SERIALIZE);
+
+				php_bser_write_hash_contents(ctx, props, php_bser_hash_count(props));
+				zend_release_properties(props);
+			}
+			break;
+		}
+		case IS_RESOURCE:
+		default:
+			/* like json_encode(), resources degrade to null */
+			php_bser_put8(ctx->buf, PHP_BSER_NULL);
+			break;
+	}
+}
+
+static zend_always_inline bool php_bunser_read(php_bunser_ctx *ctx, void *dst, size_t n)
+{
+	if (UNEXPECTED((size_t)(ctx->end - ctx->p) < n)) {
+		return false;
+	}
+	memcpy(dst, ctx->p, n);
+	ctx->p += n;
+	return true;
+}
+
+static zend_always_inline bool php_bunser_read8(php_bunser_ctx *ctx, uint8_t *v)
+{
+	return php_bunser_read(ctx, v, 1);
+}
+
+static bool php_bunser_read16(php_bunser_ctx *ctx, uint16_t *v)
+{
+	unsigned char b[2];
+
+	if (!php_bunser_read(ctx, b, 2)) {
+		return false;
+	}
+	*v = (uint16_t)(b[0] | (b[1] << 8));
+	return true;
+}
+
+static bool php_bunser_read32(php_bunser_ctx *ctx, uint32_t *v)
+{
+	unsigned char b[4];
+
+	if (!php_bunser_read(ctx, b, 4)) {
+		return false;
+	}
+	*v = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+	return true;
+}
+
+static bool php_bunser_read64(php_bunser_ctx *ctx, uint64_t *v)
+{
+	uint32_t lo, hi;
+
+	if (!php_bunser_read32(ctx, &lo) || !php_bunser_read32(ctx, &hi)) {
+		return false;
+	}
+	*v = (uint64_t)lo | ((uint64_t)hi << 32);
+	return true;
+}
+
+static zend_string *php_bunser_read_string(php_bunser_ctx *ctx, uint8_t tag)
+{
+	zend_string *str;
+	uint32_t len;
+
+	switch (tag) {
+		case PHP_BSER_STR8: {
+			uint8_t l;
+			if (!php_bunser_read8(ctx, &l)) {
+				return NULL;
+			}
+			len = l;
+			break;
+		}
+		case PHP_BSER_STR16: {
+			uint16_t l;
+			if (!php_bunser_read16(ctx, &l)) {
+				return NULL;
+			}
+			len = l;
+			break;
+		}
+		case PHP_BSER_STR32:
+			if (!php_bunser_read32(ctx, &len)) {
+				return NULL;
+			}
+			break;
+		case PHP_BSER_STRREF16: {
+			uint16_t ref;
+			if (!php_bunser_read16(ctx, &ref) || ref >= ctx->n_strings) {
+				return NULL;
+			}
+			return zend_string_copy(ctx->strings[ref]);
+		}
+		case PHP_BSER_STRREF32: {
+			uint32_t ref;
+			if (!php_bunser_read32(ctx, &ref) || ref >= ctx->n_strings) {
+				return NULL;
+			}
+			return zend_string_copy(ctx->strings[ref]);
+		}
+		default:
+			return NULL;
+	}
+
+	if ((size_t)(ctx->end - ctx->p) < len) {
+		return NULL;
+	}
+	str = zend_string_init((const char*)ctx->p, len, 0);
+	ctx->p += len;
+
+	if (len > 1) {
+		if (ctx->n_strings >= ctx->cap_strings) {
+			ctx->cap_strings = ctx->cap_strings ? ctx->cap_strings * 2 : 16;
+			ctx->strings = safe_erealloc(ctx->strings, ctx->cap_strings, sizeof(zend_string*), 0);
+		}
+		/* the table keeps its own reference until the context is freed */
+		ctx->strings[ctx->n_strings++] = zend_string_copy(str);
+	}
+
+	return str;
+}
+
+static zend_result php_var_unserialize_binary_zval(php_bunser_ctx *ctx, zval *rv);
+static zend_result php_var_unserialize_binary_tagged(php_bunser_ctx *ctx, zval *rv, uint8_t tag);
+
+static zend_result php_bunser_read_hash_contents(php_bunser_ctx *ctx, zval *rv, uint32_t count)
+{
+	uint32_t i;
+
+	/* every entry needs at least two bytes, so an oversized count is corrupt */
+	if ((size_t)(ctx->end - ctx->p) < (size_t)count * 2) {
+		return FAILURE;
+	}
+	array_init_size(rv, count);
+
+	for (i = 0; i < count; i++) {
+		uint8_t tag;
+		zval val;
+
+		if (!php_bunser_read8(ctx, &tag)) {
+			goto fail;
+		}
+		if (tag >= PHP_BSER_INT8 && tag <= PHP_BSER_INT64) {
+			zval key;
+
+			ZVAL_UNDEF(&key);
+			if (php_var_unserialize_binary_tagged(ctx, &key, tag) == FAILURE) {
+				goto fail;
+			}
+			if (php_var_unserialize_binary_zval(ctx, &val) == FAILURE) {
+				goto fail;
+			}
+			zend_hash_index_update(Z_ARRVAL_P(rv), (zend_ulong)Z_LVAL(key), &val);
+		} else {
+			zend_string *key = php_bunser_read_string(ctx, tag);
+
+			if (!key) {
+				goto fail;
+			}
+			if (php_var_unserialize_binary_zval(ctx, &val) == FAILURE) {
+				zend_string_release_ex(key, 0);
+				goto fail;
+			}
+			zend_symtable_update(Z_ARRVAL_P(rv), key, &val);
+			zend_string_release_ex(key, 0);
+		}
+	}
+	return SUCCESS;
+
+fail:
+	zval_ptr_dtor(rv);
+	ZVAL_UNDEF(rv);
+	return FAILURE;
+}
+
+static zend_result php_var_unserialize_binary_tagged(php_bunser_ctx *ctx, zval *rv, uint8_t tag)
+{
+	switch (tag) {
+		case PHP_BSER_NULL:
+			ZVAL_NULL(rv);
+			return SUCCESS;
+		case PHP_BSER_FALSE:
+			ZVAL_FALSE(rv);
+			return SUCCESS;
+		case PHP_BSER_TRUE:
+			ZVAL_TRUE(rv);
+			return SUCCESS;
+		case PHP_BSER_INT8: {
+			uint8_t v;
+			if (!php_bunser_read8(ctx, &v)) {
+				return FAILURE;
+			}
+			ZVAL_LONG(rv, (int8_t)v);
+			return SUCCESS;
+		}
+		case PHP_BSER_INT16: {
+			uint16_t v;
+			if (!php_bunser_read16(ctx, &v)) {
+				return FAILURE;
+			}
+			ZVAL_LONG(rv, (int16_t)v);
+			return SUCCESS;
+		}
+		case PHP_BSER_INT32: {
+			uint32_t v;
+			if (!php_bunser_read32(ctx, &v)) {
+				return FAILURE;
+			}
+			ZVAL_LONG(rv, (int32_t)v);
+			return SUCCESS;
+		}
+		case PHP_BSER_INT64: {
+			uint64_t v;
+			if (!php_bunser_read64(ctx, &v)) {
+				return FAILURE;
+			}
+#if SIZEOF_ZEND_LONG == 4
+			if ((int64_t)v < ZEND_LONG_MIN || (int64_t)v > ZEND_LONG_MAX) {
+				ZVAL_DOUBLE(rv, (double)(int64_t)v);
+				return SUCCESS;
+			}
+#endif
+			ZVAL_LONG(rv, (zend_long)(int64_t)v);
+			return SUCCESS;
+		}
+		case PHP_BSER_DOUBLE: {
+			uint64_t bits;
+			double d;
+
+			if (!php_bunser_read64(ctx, &bits)) {
+				return FAILURE;
+			}
+#ifdef WORDS_BIGENDIAN
+			bits = ZEND_BYTES_SWAP64(bits);
+#endif
+			memcpy(&d, &bits, sizeof(d));
+			ZVAL_DOUBLE(rv, d);
+			return SUCCESS;
+		}
+		case PHP_BSER_STR8:
+		case PHP_BSER_STR16:
+		case PHP_BSER_STR32:
+		case PHP_BSER_STRREF16:
+		case PHP_BSER_STRREF32: {
+			zend_string *str = php_bunser_read_string(ctx, tag);
+
+			if (!str) {
+				return FAILURE;
+			}
+			ZVAL_STR(rv, str);
+			return SUCCESS;
+		}
+		case PHP_BSER_PACKED8:
+		case PHP_BSER_PACKED32: {
+			uint32_t count;
+			uint32_t i;
+			zend_result result = SUCCESS;
+
+			if (tag == PHP_BSER_PACKED8) {
+				uint8_t c;
+				if (!php_bunser_read8(ctx, &c)) {
+					return FAILURE;
+				}
+				count = c;
+			} else if (!php_bunser_read32(ctx, &count)) {
+				return FAILURE;
+			}
+			if ((size_t)(ctx->end - ctx->p) < count) {
+				return FAILURE;
+			}
+			if (UNEXPECTED(++ctx->depth > ctx->max_depth)) {
+				php_error_docref(NULL, E_WARNING,
+					"Maximum depth of " ZEND_LONG_FMT " exceeded", ctx->max_depth);
+				return FAILURE;
+			}
+
+			array_init_size(rv, count);
+			zend_hash_real_init_packed(Z_ARRVAL_P(rv));
+			ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(rv)) {
+				for (i = 0; i < count; i++) {
+					zval val;
+
+					if (php_var_unserialize_binary_zval(ctx, &val) == FAILURE) {
+						result = FAILURE;
+						break;
+					}
+					ZEND_HASH_FILL_ADD(&val);
+				}
+			} ZEND_HASH_FILL_END();
+
+			ctx->depth--;
+			if (result == FAILURE) {
+				zval_ptr_dtor(rv);
+				ZVAL_UNDEF(rv);
+			}
+			return result;
+		}
+		case PHP_BSER_HASH8:
+		case PHP_BSER_HASH32: {
+			uint32_t count;
+			zend_result result;
+
+			if (tag == PHP_BSER_HASH8) {
+				uint8_t c;
+				if (!php_bunser_read8(ctx, &c)) {
+					return FAILURE;
+				}
+				count = c;
+			} else if (!php_bunser_read32(ctx, &count)) {
+				return FAILURE;
+			}
+			if (UNEXPECTED(++ctx->depth > ctx->max_depth)) {
+				php_error_docref(NULL, E_WARNING,
+					"Maximum depth of " ZEND_LONG_FMT " exceeded", ctx->max_depth);
+				return FAILURE;
+			}
+			result = php_bunser_read_hash_contents(ctx, rv, count);
+			ctx->depth--;
+			return result;
+		}
+		case PHP_BSER_OBJECT: {
+			uint8_t name_tag;
+			zend_string *class_name;
+			zend_class_entry *ce;
+			zval data;
+
+			if (!php_bunser_read8(ctx, &name_tag)) {
+				return FAILURE;
+			}
+			class_name = php_bunser_read_string(ctx, name_tag);
+			if (!class_name) {
+				return FAILURE;
+			}
+
+			/* checked before the lookup so disallowed classes are not even
+			 * autoloaded */
+			if (ctx->allowed_classes) {
+				zend_string *lcname = zend_string_tolower(class_name);
+				bool allowed = zend_hash_exists(ctx->allowed_classes, lcname);
+
+				zend_string_release_ex(lcname, 0);
+				if (!allowed) {
+					php_error_docref(NULL, E_WARNING,
+						"Class %s is not allowed to be unserialized", ZSTR_VAL(class_name));
+					zend_string_release_ex(class_name, 0);
+					return FAILURE;
+				}
+			}
+
+			ce = zend_lookup_class(class_name);
+			if (!ce) {
+				php_error_docref(NULL, E_WARNING, "Class %s does not exist", ZSTR_VAL(class_name));
+				zend_string_release_ex(class_name, 0);
+				return FAILURE;
+			}
+			zend_string_release_ex(class_name, 0);
+
+			if ((ce->ce_flags & (ZEND_ACC_NOT_SERIALIZABLE|ZEND_ACC_ENUM|ZEND_ACC_INTERFACE|ZEND_ACC_TRAIT|ZEND_ACC_IMPLICIT_ABSTRACT_CLASS|ZEND_ACC_EXPLICIT_ABSTRACT_CLASS))
+			 || (!ce->__unserialize && ce->unserialize)) {
+				php_error_docref(NULL, E_WARNING,
+					"Class %s cannot be unserialized by unserialize_binary()", ZSTR_VAL(ce->name));
+				return FAILURE;
+			}
+
+			if (UNEXPECTED(++ctx->depth > ctx->max_depth)) {
+				php_error_docref(NULL, E_WARNING,
+					"Maximum depth of " ZEND_LONG_FMT " exceeded", ctx->max_depth);
+				return FAILURE;
+			}
+
+			if (object_init_ex(rv, ce) == FAILURE) {
+				ctx->depth--;
+				return FAILURE;
+			}
+
+			/* register before reading the data so cycles resolve */
+			if (ctx->n_objects >= ctx->cap_objects) {
+				ctx->cap_objects = ctx->cap_objects ? ctx->cap_objects * 2 : 8;
+				ctx->objects = safe_erealloc(ctx->objects, ctx->cap_objects, sizeof(zend_object*), 0);
+			}
+			ctx->objects[ctx->n_objects++] = Z_OBJ_P(rv);
+
+			if (php_var_unserialize_binary_zval(ctx, &data) == FAILURE) {
+				ctx->depth--;
+				goto obj_fail;
+			}
+			if (Z_TYPE(data) != IS_ARRAY) {
+				zval_ptr_dtor(&data);
+				ctx->depth--;
+				goto obj_fail;
+			}
+			ctx->depth--;
+
+			if (ce->__unserialize) {
+				BG(serialize_lock)++;
+				zend_call_known_instance_method_with_1_params(
+					ce->__unserialize, Z_OBJ_P(rv), NULL, &data);
+				BG(serialize_lock)--;
+				zval_ptr_dtor(&data);
+				if (EG(exception)) {
+					goto obj_fail;
+				}
+			} else {
+				object_properties_load(Z_OBJ_P(rv), Z_ARRVAL(data));
+				zval_ptr_dtor(&data);
+				if (EG(exception)) {
+					goto obj_fail;
+				}
+			}
+			return SUCCESS;
+
+obj_fail:
+			/* keep the table entry: the object stays alive through it until
+			 * the context is freed, and ids of later entries must not shift */
+			zval_ptr_dtor(rv);
+			ZVAL_UNDEF(rv);
+			return FAILURE;
+		}
+		case PHP_BSER_OBJREF32: {
+			uint32_t id;
+
+			if (!php_bunser_read32(ctx, &id) || id >= ctx->n_objects) {
+				return FAILURE;
+			}
+			ZVAL_OBJ_COPY(rv, ctx->objects[id]);
+			return SUCCESS;
+		}
+		default:
+			return FAILURE;
+	}
+}
+
+static zend_result php_var_unserialize_binary_zval(php_bunser_ctx *ctx, zval *rv)
+{
+	uint8_t tag;
+
+	if (!php_bunser_read8(ctx, &tag)) {
+		return FAILURE;
+	}
+	return php_var_unserialize_binary_tagged(ctx, rv, tag);
+}
+/* }}} */
+
+/* {{{ Generates a compact binary representation of a value */
+PHP_FUNCTION(serialize_binary)
+{
+	zval *struc;
+	php_bser_ctx ctx;
+	smart_str buf = {0};
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_ZVAL(struc)
+	ZEND_PARSE_PARAMETERS_END();
+
+	ctx.buf = &buf;
+	zend_hash_init(&ctx.strings, 16, NULL, NULL, 0);
+	zend_hash_init(&ctx.objects, 8, NULL, NULL, 0);
+	ctx.next_string = 0;
+	ctx.next_object = 0;
+
+	php_bser_put8(&buf, PHP_BSER_MAGIC);
+	php_bser_put8(&buf, PHP_BSER_VERSION);
+	php_var_serialize_binary_zval(&ctx, struc);
+
+	zend_hash_destroy(&ctx.strings);
+	zend_hash_destroy(&ctx.objects);
+
+	if (EG(exception)) {
+		smart_str_free(&buf);
+		RETURN_THROWS();
+	}
+
+	RETURN_STR(smart_str_extract(&buf));
+}
+/* }}} */
+
+/* {{{ Recreates a value from its binary representation */
+PHP_FUNCTION(unserialize_binary)
+{
+	char *buf;
+	size_t buf_len;
+	HashTable *options = NULL;
+	HashTable *class_hash = NULL;
+	php_bunser_ctx ctx;
+	uint32_t i;
+	zend_result result;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_STRING(buf, buf_len)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ARRAY_HT(options)
+	ZEND_PARSE_PARAMETERS_END();
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.max_depth = BG(unserialize_max_depth);
+
+	if (options != NULL) {
+		zval *classes, *max_depth;
+
+		classes = zend_hash_str_find_deref(options, "allowed_classes", sizeof("allowed_classes")-1);
+		if (classes && Z_TYPE_P(classes) != IS_ARRAY && Z_TYPE_P(classes) != IS_TRUE && Z_TYPE_P(classes) != IS_FALSE) {
+			zend_type_error("unserialize_binary(): Option \"allowed_classes\" must be of type array|bool, %s given", zend_zval_value_name(classes));
+			RETURN_THROWS();
+		}
+
+		if (classes && (Z_TYPE_P(classes) == IS_ARRAY || !zend_is_true(classes))) {
+			ALLOC_HASHTABLE(class_hash);
+			zend_hash_init(class_hash, (Z_TYPE_P(classes) == IS_ARRAY)?zend_hash_num_elements(Z_ARRVAL_P(classes)):0, NULL, NULL, 0);
+		}
+		if (class_hash && Z_TYPE_P(classes) == IS_ARRAY) {
+			zval *entry;
+			zend_string *lcname;
+
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(classes), entry) {
+				convert_to_string(entry);
+				lcname = zend_string_tolower(Z_STR_P(entry));
+				zend_hash_add_empty_element(class_hash, lcname);
+				zend_string_release_ex(lcname, 0);
+			} ZEND_HASH_FOREACH_END();
+
+			/* Exception during string conversion. */
+			if (EG(exception)) {
+				goto options_fail;
+			}
+		}
+		ctx.allowed_classes = class_hash;
+
+		max_depth = zend_hash_str_find_deref(options, "max_depth", sizeof("max_depth") - 1);
+		if (max_depth) {
+			if (Z_TYPE_P(max_depth) != IS_LONG) {
+				zend_type_error("unserialize_binary(): Option \"max_depth\" must be of type int, %s given", zend_zval_value_name(max_depth));
+				goto options_fail;
+			}
+			if (Z_LVAL_P(max_depth) < 0) {
+				zend_value_error("unserialize_binary(): Option \"max_depth\" must be greater than or equal to 0");
+				goto options_fail;
+			}
+			ctx.max_depth = Z_LVAL_P(max_depth);
+		}
+	}
+
+	if (buf_len < 3
+	 || (unsigned char)buf[0] != PHP_BSER_MAGIC
+	 || (unsigned char)buf[1] != PHP_BSER_VERSION) {
+		php_error_docref(NULL, E_WARNING, "Data is not a binary serialization payload");
+		if (class_hash) {
+			zend_hash_destroy(class_hash);
+			FREE_HASHTABLE(class_hash);
+		}
+		RETURN_FALSE;
+	}
+
+	ctx.p = (const unsigned char*)buf + 2;
+	ctx.end = (const unsigned char*)buf + buf_len;
+
+	result = php_var_unserialize_binary_zval(&ctx, return_value);
+
+	if (result == SUCCESS && ctx.p < ctx.end && !EG(exception)) {
+		php_error_docref(NULL, E_WARNING, "Extra data starting at offset " ZEND_LONG_FMT " of %zd bytes",
+			(zend_long)((const char*)ctx.p - buf), buf_len);
+	}
+
+	for (i = 0; i < ctx.n_strings; i++) {
+		zend_string_release_ex(ctx.strings[i], 0);
+	}
+	if (ctx.strings) {
+		efree(ctx.strings);
+	}
+	if (ctx.objects) {
+		efree(ctx.objects);
+	}
+	if (class_hash) {
+		zend_hash_destroy(class_hash);
+		FREE_HASHTABLE(class_hash);
+	}
+
+	if (result == FAILURE) {
+		if (EG(exception)) {
+			RETURN_THROWS();
+		}
+		php_error_docref(NULL, E_WARNING, "Error at offset " ZEND_LONG_FMT " of %zd bytes",
+			(zend_long)((const char*)ctx.p - buf), buf_len);
+		RETURN_FALSE;
+	}
+
+	if (Z_REFCOUNTED_P(return_value)) {
+		gc_check_possible_root(Z_COUNTED_P(return_value));
+	}
+	return;
+
+options_fail:
+	if (class_hash) {
+		zend_hash_destroy(class_hash);
+		FREE_HASHTABLE(class_hash);
+	}
+	RETURN_THROWS();
+}
+/* }}} */
+
 /* {{{ Returns the allocated by PHP memory */
 PHP_FUNCTION(memory_get_usage) {
 	bool real_usage = 0;
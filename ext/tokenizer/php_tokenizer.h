@@ -24,6 +24,7 @@ extern zend_module_entry tokenizer_module_entry;
 #define PHP_TOKENIZER_VERSION PHP_VERSION
 
 #define TOKEN_PARSE (1 << 0)
+#define TOKEN_PACKED (1 << 1)
 
 #ifdef ZTS
 #include "TSRM.h"
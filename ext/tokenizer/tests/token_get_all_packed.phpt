@@ -0,0 +1,48 @@
+--TEST--
+token_get_all() with TOKEN_PACKED returns parallel integer arrays
+--EXTENSIONS--
+tokenizer
+--FILE--
+<?php
+$source = '<?php echo "Hello"; ?>';
+$packed = token_get_all($source, TOKEN_PACKED);
+var_dump(array_keys($packed));
+
+$tokens = token_get_all($source);
+var_dump(count($packed['ids']) === count($tokens));
+
+// Packed arrays describe the same token stream as the default mode.
+foreach ($tokens as $i => $token) {
+    if (is_array($token)) {
+        [$id, $text, $line] = $token;
+    } else {
+        [$id, $text, $line] = [ord($token), $token, $packed['lines'][$i]];
+    }
+    if ($packed['ids'][$i] !== $id
+        || $packed['lines'][$i] !== $line
+        || substr($source, $packed['positions'][$i], $packed['lengths'][$i]) !== $text) {
+        var_dump($i, $token, $packed['ids'][$i], $packed['positions'][$i], $packed['lengths'][$i]);
+    }
+}
+echo "match\n";
+
+try {
+    token_get_all($source, TOKEN_PACKED | TOKEN_PARSE);
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+array(4) {
+  [0]=>
+  string(3) "ids"
+  [1]=>
+  string(9) "positions"
+  [2]=>
+  string(7) "lengths"
+  [3]=>
+  string(5) "lines"
+}
+bool(true)
+match
+token_get_all(): Argument #2 ($flags) must not combine TOKEN_PACKED with TOKEN_PARSE
@@ -383,6 +383,89 @@ static bool tokenize(zval *return_value, zend_string *source, zend_class_entry *
 	return 1;
 }
 
+static void packed_add(zval *arr, zend_long num) {
+	zval tmp;
+	ZVAL_LONG(&tmp, num);
+	zend_hash_next_index_insert_new(Z_ARRVAL_P(arr), &tmp);
+}
+
+/* Batch mode for analysis tools: instead of one array/object with copied
+ * text per token, return four parallel packed arrays of integers. Token
+ * text is addressed as substr($code, $positions[$i], $lengths[$i]), so no
+ * per-token string is ever allocated. */
+static bool tokenize_packed(zval *return_value, zend_string *source)
+{
+	zval source_zval;
+	zend_lex_state original_lex_state;
+	zval token;
+	int token_type;
+	int token_line = 1;
+	int need_tokens = -1; /* for __halt_compiler lexing. -1 = disabled */
+	zval ids, positions, lengths, lines;
+
+	ZVAL_STR_COPY(&source_zval, source);
+	zend_save_lexical_state(&original_lex_state);
+
+	zend_prepare_string_for_scanning(&source_zval, ZSTR_EMPTY_ALLOC());
+
+	LANG_SCNG(yy_state) = yycINITIAL;
+	array_init(&ids);
+	array_init(&positions);
+	array_init(&lengths);
+	array_init(&lines);
+
+	while ((token_type = lex_scan(&token, NULL))) {
+		ZEND_ASSERT(token_type != T_ERROR);
+
+		packed_add(&ids, token_type);
+		packed_add(&positions, zendtext - LANG_SCNG(yy_start));
+		packed_add(&lengths, zendleng);
+		packed_add(&lines, token_line);
+
+		if (Z_TYPE(token) != IS_UNDEF) {
+			zval_ptr_dtor_nogc(&token);
+			ZVAL_UNDEF(&token);
+		}
+
+		/* after T_HALT_COMPILER collect the next three non-dropped tokens */
+		if (need_tokens != -1) {
+			if (token_type != T_WHITESPACE && token_type != T_OPEN_TAG
+				&& token_type != T_COMMENT && token_type != T_DOC_COMMENT
+				&& --need_tokens == 0
+			) {
+				/* report the rest as a T_INLINE_HTML */
+				if (zendcursor < zendlimit) {
+					packed_add(&ids, T_INLINE_HTML);
+					packed_add(&positions, zendcursor - LANG_SCNG(yy_start));
+					packed_add(&lengths, zendlimit - zendcursor);
+					packed_add(&lines, token_line);
+				}
+				break;
+			}
+		} else if (token_type == T_HALT_COMPILER) {
+			need_tokens = 3;
+		}
+
+		if (CG(increment_lineno)) {
+			CG(zend_lineno)++;
+			CG(increment_lineno) = 0;
+		}
+
+		token_line = CG(zend_lineno);
+	}
+
+	zval_ptr_dtor_str(&source_zval);
+	zend_restore_lexical_state(&original_lex_state);
+
+	array_init_size(return_value, 4);
+	add_assoc_zval(return_value, "ids", &ids);
+	add_assoc_zval(return_value, "positions", &positions);
+	add_assoc_zval(return_value, "lengths", &lengths);
+	add_assoc_zval(return_value, "lines", &lines);
+
+	return 1;
+}
+
 struct event_context {
 	zval *tokens;
 	zend_class_entry *token_class;
@@ -524,6 +607,17 @@ PHP_FUNCTION(token_get_all)
 		Z_PARAM_LONG(flags)
 	ZEND_PARSE_PARAMETERS_END();
 
+	if (flags & TOKEN_PACKED) {
+		if (flags & TOKEN_PARSE) {
+			zend_argument_value_error(2, "must not combine TOKEN_PACKED with TOKEN_PARSE");
+			RETURN_THROWS();
+		}
+		tokenize_packed(return_value, source);
+		/* Normal token_get_all() should not throw. */
+		zend_clear_exception();
+		return;
+	}
+
 	if (!tokenize_common(return_value, source, flags, /* token_class */ NULL)) {
 		RETURN_THROWS();
 	}
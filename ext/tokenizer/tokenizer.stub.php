@@ -7,6 +7,11 @@
  * @cvalue TOKEN_PARSE
  */
 const TOKEN_PARSE = UNKNOWN;
+/**
+ * @var int
+ * @cvalue TOKEN_PACKED
+ */
+const TOKEN_PACKED = UNKNOWN;
 
 function token_get_all(string $code, int $flags = 0): array {}
 
@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: a89f03303f8a7d254509ae2bc46a36bb79a3c900 */
+ * Stub hash: 85de57ec78fe120e176b4eaf8f1da8807fefdd69 */
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_token_get_all, 0, 1, IS_ARRAY, 0)
 	ZEND_ARG_TYPE_INFO(0, code, IS_STRING, 0)
@@ -60,6 +60,7 @@ static const zend_function_entry class_PhpToken_methods[] = {
 static void register_tokenizer_symbols(int module_number)
 {
 	REGISTER_LONG_CONSTANT("TOKEN_PARSE", TOKEN_PARSE, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("TOKEN_PACKED", TOKEN_PACKED, CONST_PERSISTENT);
 }
 
 static zend_class_entry *register_class_PhpToken(zend_class_entry *class_entry_Stringable)
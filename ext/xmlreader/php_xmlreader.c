@@ -51,8 +51,26 @@ typedef struct _xmlreader_prop_handler {
 	xmlreader_read_int_t read_int_func;
 	xmlreader_read_const_char_t read_char_func;
 	int type;
+	int cache_slot;
 } xmlreader_prop_handler;
 
+/* Element names, prefixes and namespace URIs repeat constantly while
+ * streaming over a large document, so each of these properties memoizes
+ * its last returned string per object instead of allocating a fresh copy
+ * on every access. The node text ("value") is excluded: it rarely repeats
+ * and comparing it would touch the whole text. */
+enum {
+	XMLREADER_CACHE_BASE_URI = 0,
+	XMLREADER_CACHE_LOCAL_NAME,
+	XMLREADER_CACHE_NAME,
+	XMLREADER_CACHE_NAMESPACE_URI,
+	XMLREADER_CACHE_PREFIX,
+	XMLREADER_CACHE_XML_LANG,
+};
+#define XMLREADER_CACHE_NONE (-1)
+ZEND_STATIC_ASSERT(XMLREADER_CACHE_XML_LANG < XMLREADER_PROP_CACHE_SLOTS,
+	"xmlreader prop cache slot out of range");
+
 #define XMLREADER_LOAD_STRING 0
 #define XMLREADER_LOAD_FILE 1
 
@@ -63,8 +81,8 @@ static void xmlreader_register_prop_handler(HashTable *prop_handler, const char
 	zend_string_release_ex(str, true);
 }
 
-#define XMLREADER_REGISTER_PROP_HANDLER(prop_handler, name, prop_read_int_func, prop_read_char_func, prop_type) do { \
-		static const xmlreader_prop_handler hnd = {.read_int_func = prop_read_int_func, .read_char_func = prop_read_char_func, .type = prop_type}; \
+#define XMLREADER_REGISTER_PROP_HANDLER(prop_handler, name, prop_read_int_func, prop_read_char_func, prop_type, prop_cache_slot) do { \
+		static const xmlreader_prop_handler hnd = {.read_int_func = prop_read_int_func, .read_char_func = prop_read_char_func, .type = prop_type, .cache_slot = prop_cache_slot}; \
 		xmlreader_register_prop_handler(prop_handler, "" name, sizeof("" name) - 1, &hnd); \
 	} while (0)
 
@@ -91,7 +109,20 @@ static int xmlreader_property_reader(xmlreader_object *obj, xmlreader_prop_handl
 	switch (hnd->type) {
 		case IS_STRING:
 			if (retchar) {
-				ZVAL_STRING(rv, (char *) retchar);
+				if (hnd->cache_slot != XMLREADER_CACHE_NONE) {
+					zend_string **cache = &obj->prop_cache[hnd->cache_slot];
+					size_t len = strlen((const char *) retchar);
+
+					if (*cache == NULL || !zend_string_equals_cstr(*cache, (const char *) retchar, len)) {
+						if (*cache) {
+							zend_string_release_ex(*cache, false);
+						}
+						*cache = zend_string_init((const char *) retchar, len, false);
+					}
+					ZVAL_STR_COPY(rv, *cache);
+				} else {
+					ZVAL_STRING(rv, (char *) retchar);
+				}
 			} else {
 				ZVAL_EMPTY_STRING(rv);
 			}
@@ -328,6 +359,12 @@ void xmlreader_objects_free_storage(zend_object *object)
 
 	zend_object_std_dtor(&intern->std);
 
+	for (size_t i = 0; i < XMLREADER_PROP_CACHE_SLOTS; i++) {
+		if (intern->prop_cache[i]) {
+			zend_string_release_ex(intern->prop_cache[i], false);
+		}
+	}
+
 	xmlreader_free_resources(intern);
 }
 /* }}} */
@@ -1160,20 +1197,20 @@ PHP_MINIT_FUNCTION(xmlreader)
 
 	/* Note: update the size upon adding properties. */
 	zend_hash_init(&xmlreader_prop_handlers, 14, NULL, NULL, true);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "attributeCount", xmlTextReaderAttributeCount, NULL, IS_LONG);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "baseURI", NULL, xmlTextReaderConstBaseUri, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "depth", xmlTextReaderDepth, NULL, IS_LONG);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "hasAttributes", xmlTextReaderHasAttributes, NULL, _IS_BOOL);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "hasValue", xmlTextReaderHasValue, NULL, _IS_BOOL);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "isDefault", xmlTextReaderIsDefault, NULL, _IS_BOOL);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "isEmptyElement", xmlTextReaderIsEmptyElement, NULL, _IS_BOOL);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "localName", NULL, xmlTextReaderConstLocalName, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "name", NULL, xmlTextReaderConstName, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "namespaceURI", NULL, xmlTextReaderConstNamespaceUri, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "nodeType", xmlTextReaderNodeType, NULL, IS_LONG);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "prefix", NULL, xmlTextReaderConstPrefix, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "value", NULL, xmlTextReaderConstValue, IS_STRING);
-	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "xmlLang", NULL, xmlTextReaderConstXmlLang, IS_STRING);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "attributeCount", xmlTextReaderAttributeCount, NULL, IS_LONG, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "baseURI", NULL, xmlTextReaderConstBaseUri, IS_STRING, XMLREADER_CACHE_BASE_URI);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "depth", xmlTextReaderDepth, NULL, IS_LONG, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "hasAttributes", xmlTextReaderHasAttributes, NULL, _IS_BOOL, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "hasValue", xmlTextReaderHasValue, NULL, _IS_BOOL, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "isDefault", xmlTextReaderIsDefault, NULL, _IS_BOOL, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "isEmptyElement", xmlTextReaderIsEmptyElement, NULL, _IS_BOOL, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "localName", NULL, xmlTextReaderConstLocalName, IS_STRING, XMLREADER_CACHE_LOCAL_NAME);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "name", NULL, xmlTextReaderConstName, IS_STRING, XMLREADER_CACHE_NAME);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "namespaceURI", NULL, xmlTextReaderConstNamespaceUri, IS_STRING, XMLREADER_CACHE_NAMESPACE_URI);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "nodeType", xmlTextReaderNodeType, NULL, IS_LONG, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "prefix", NULL, xmlTextReaderConstPrefix, IS_STRING, XMLREADER_CACHE_PREFIX);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "value", NULL, xmlTextReaderConstValue, IS_STRING, XMLREADER_CACHE_NONE);
+	XMLREADER_REGISTER_PROP_HANDLER(&xmlreader_prop_handlers, "xmlLang", NULL, xmlTextReaderConstXmlLang, IS_STRING, XMLREADER_CACHE_XML_LANG);
 
 	return SUCCESS;
 }
@@ -38,11 +38,16 @@ extern zend_module_entry xmlreader_module_entry;
 # endif
 #endif
 
+/* One memo slot per repetitive string property (name, localName, ...);
+ * see xmlreader_property_reader() in php_xmlreader.c. */
+#define XMLREADER_PROP_CACHE_SLOTS 6
+
 typedef struct _xmlreader_object {
 	xmlTextReaderPtr ptr;
 	/* strings must be set in input buffer as copy is required */
 	xmlParserInputBufferPtr input;
 	void *schema;
+	zend_string *prop_cache[XMLREADER_PROP_CACHE_SLOTS];
 	zend_object  std;
 } xmlreader_object;
 
@@ -31,6 +31,8 @@
 #include "php_zip.h"
 #include "php_zip_arginfo.h"
 
+#include <errno.h>
+
 #ifdef HAVE_GLOB
 #ifndef PHP_WIN32
 #include <glob.h>
@@ -339,6 +341,65 @@ static int php_zip_add_file(ze_zip_object *obj, const char *filename, size_t fil
 }
 /* }}} */
 
+/* userdata for zip sources backed by a PHP stream, see php_zip_stream_source_cb() */
+typedef struct _php_zip_stream_source {
+	zval stream_zv; /* keeps the stream resource alive until the source is freed */
+	int  err_zip;
+	int  err_sys;
+} php_zip_stream_source;
+
+static zip_int64_t php_zip_stream_source_cb(void *userdata, void *data, zip_uint64_t len, enum zip_source_cmd cmd) /* {{{ */
+{
+	php_zip_stream_source *src = userdata;
+
+	switch (cmd) {
+		case ZIP_SOURCE_OPEN:
+		case ZIP_SOURCE_CLOSE:
+			return 0;
+		case ZIP_SOURCE_READ: {
+			/* re-fetch on every read: the user may have fclose()d the
+			 * stream behind our back, leaving only a dead resource */
+			zend_resource *res = Z_RES(src->stream_zv);
+			ssize_t n;
+
+			if (res->ptr == NULL
+			 || (res->type != php_file_le_stream() && res->type != php_file_le_pstream())) {
+				src->err_zip = ZIP_ER_READ;
+				src->err_sys = EBADF;
+				return -1;
+			}
+			n = php_stream_read((php_stream*)res->ptr, data, (size_t)len);
+			if (n < 0) {
+				src->err_zip = ZIP_ER_READ;
+				src->err_sys = errno;
+				return -1;
+			}
+			return n;
+		}
+		case ZIP_SOURCE_STAT: {
+			struct zip_stat *st = data;
+			/* the size is unknown up front; libzip reads until EOF */
+			zip_stat_init(st);
+			return sizeof(*st);
+		}
+		case ZIP_SOURCE_ERROR: {
+			int *errs = data;
+			errs[0] = src->err_zip;
+			errs[1] = src->err_sys;
+			return 2 * sizeof(int);
+		}
+		case ZIP_SOURCE_FREE:
+			zval_ptr_dtor(&src->stream_zv);
+			efree(src);
+			return 0;
+		default:
+			src->err_zip = ZIP_ER_OPNOTSUPP;
+			src->err_sys = 0;
+			return -1;
+	}
+}
+/* }}} */
+
 typedef struct {
 	zend_long    remove_all_path;
 	char        *remove_path;
@@ -1972,6 +2033,57 @@ PHP_METHOD(ZipArchive, addFromString)
 }
 /* }}} */
 
+/* {{{ Add an entry piped from an open stream, without staging its content in memory */
+PHP_METHOD(ZipArchive, addFromStream)
+{
+	struct zip *intern;
+	zval *self = ZEND_THIS;
+	zval *zstream;
+	php_stream *stream;
+	char *name;
+	size_t name_len;
+	ze_zip_object *ze_obj;
+	struct zip_source *zs;
+	php_zip_stream_source *src;
+	zend_long flags = ZIP_FL_OVERWRITE;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "rs|l",
+			&zstream, &name, &name_len, &flags) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	ZIP_FROM_OBJECT(intern, self);
+
+	php_stream_from_zval(stream, zstream);
+
+	ze_obj = Z_ZIP_P(self);
+
+	src = emalloc(sizeof(*src));
+	ZVAL_COPY(&src->stream_zv, zstream);
+	src->err_zip = 0;
+	src->err_sys = 0;
+
+	/* The stream is consumed when the archive is written out on close();
+	 * it must stay readable until then (the retained reference is released
+	 * together with the source). */
+	zs = zip_source_function(intern, php_zip_stream_source_cb, src);
+	if (zs == NULL) {
+		zval_ptr_dtor(&src->stream_zv);
+		efree(src);
+		RETURN_FALSE;
+	}
+
+	ze_obj->last_id = zip_file_add(intern, name, zs, flags);
+	if (ze_obj->last_id == -1) {
+		zip_source_free(zs);
+		RETURN_FALSE;
+	} else {
+		zip_error_clear(intern);
+		RETURN_TRUE;
+	}
+}
+/* }}} */
+
 /* {{{ Returns the information about a the zip entry filename */
 PHP_METHOD(ZipArchive, statName)
 {
@@ -663,6 +663,9 @@ class ZipArchive implements Countable
     /** @tentative-return-type */
     public function addFromString(string $name, string $content, int $flags = ZipArchive::FL_OVERWRITE): bool {}
 
+    /** @param resource $stream */
+    public function addFromStream($stream, string $name, int $flags = ZipArchive::FL_OVERWRITE): bool {}
+
     /** @tentative-return-type */
     public function addFile(string $filepath, string $entryname = "", int $start = 0, int $length = ZipArchive::LENGTH_TO_END, int $flags = ZipArchive::FL_OVERWRITE): bool {}
 
@@ -0,0 +1,52 @@
+--TEST--
+ziparchive::addFromStream() function
+--EXTENSIONS--
+zip
+--FILE--
+<?php
+
+$dirname = __DIR__ . '/';
+$file = $dirname . '__tmp_oo_addfromstream.zip';
+
+@unlink($file);
+
+$zip = new ZipArchive;
+if (!$zip->open($file, ZIPARCHIVE::CREATE)) {
+    exit('failed');
+}
+
+$stream = fopen('php://temp', 'w+');
+fwrite($stream, str_repeat('entry content ', 64));
+rewind($stream);
+
+var_dump($zip->addFromStream($stream, 'piped.txt'));
+var_dump($zip->lastId);
+
+// the archive keeps its own reference until close()
+unset($stream);
+
+$data = fopen('data://text/plain,second entry', 'r');
+var_dump($zip->addFromStream($data, 'second.txt'));
+unset($data);
+
+var_dump($zip->close());
+
+$zip = new ZipArchive;
+if (!$zip->open($file)) {
+    exit('failed');
+}
+var_dump($zip->getFromName('piped.txt') === str_repeat('entry content ', 64));
+var_dump($zip->getFromName('second.txt'));
+$zip->close();
+?>
+--CLEAN--
+<?php
+unlink(__DIR__ . '/__tmp_oo_addfromstream.zip');
+?>
+--EXPECT--
+bool(true)
+int(0)
+bool(true)
+bool(true)
+bool(true)
+string(12) "second entry"
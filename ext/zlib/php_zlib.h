@@ -63,6 +63,13 @@ ZEND_END_MODULE_GLOBALS(zlib);
 
 #define ZLIBG(v) ZEND_MODULE_GLOBALS_ACCESSOR(zlib, v)
 
+/* Transparent output compression runs deflate() through this hook, so other
+   extensions can substitute a zlib-compatible implementation (hardware
+   offload, ISA-L). A replacement must consume next_in/avail_in, fill
+   next_out/avail_out and honour the flush mode like deflate() does; the
+   stream is still set up and torn down with deflateInit2()/deflateEnd(). */
+PHPAPI extern int (*php_zlib_output_compressor)(z_streamp strm, int flush);
+
 php_stream *php_stream_gzopen(php_stream_wrapper *wrapper, const char *path, const char *mode, int options, zend_string **opened_path, php_stream_context *context STREAMS_DC);
 extern const php_stream_ops php_stream_gzio_ops;
 extern const php_stream_wrapper php_stream_gzip_wrapper;
@@ -0,0 +1,47 @@
+--TEST--
+zlib.deflate/zlib.inflate filters with preset dictionary
+--EXTENSIONS--
+zlib
+--FILE--
+<?php
+$dict = str_repeat("the quick brown fox jumps over the lazy dog ", 4);
+$text = "the quick brown fox jumps over the lazy dog again and again";
+$params = ['window' => 15, 'dictionary' => $dict];
+
+$fp = fopen('php://memory', 'w+');
+$filter = stream_filter_append($fp, 'zlib.deflate', STREAM_FILTER_WRITE, $params);
+fwrite($fp, $text);
+stream_filter_remove($filter);
+rewind($fp);
+$compressed = stream_get_contents($fp);
+fclose($fp);
+
+/* the stream really requires the dictionary */
+$ctx = inflate_init(ZLIB_ENCODING_DEFLATE, ['dictionary' => $dict]);
+var_dump(inflate_add($ctx, $compressed) === $text);
+
+/* and the inflate filter can supply it */
+$fp = fopen('php://memory', 'w+');
+fwrite($fp, $compressed);
+rewind($fp);
+stream_filter_append($fp, 'zlib.inflate', STREAM_FILTER_READ, $params);
+var_dump(stream_get_contents($fp) === $text);
+fclose($fp);
+
+/* raw deflate has to be primed up front */
+$params = ['window' => -15, 'dictionary' => $dict];
+$fp = fopen('php://memory', 'w+');
+$filter = stream_filter_append($fp, 'zlib.deflate', STREAM_FILTER_WRITE, $params);
+fwrite($fp, $text);
+stream_filter_remove($filter);
+rewind($fp);
+$compressed = stream_get_contents($fp);
+stream_filter_append($fp, 'zlib.inflate', STREAM_FILTER_READ, $params);
+rewind($fp);
+var_dump(stream_get_contents($fp) === $text);
+fclose($fp);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
@@ -43,6 +43,9 @@
 
 ZEND_DECLARE_MODULE_GLOBALS(zlib)
 
+/* Offload hook for transparent output compression, see php_zlib.h */
+PHPAPI int (*php_zlib_output_compressor)(z_streamp strm, int flush) = deflate;
+
 /* InflateContext class */
 
 zend_class_entry *inflate_context_ce;
@@ -221,7 +224,7 @@ static zend_result php_zlib_output_handler_ex(php_zlib_context *ctx, php_output_
 			flags = Z_FULL_FLUSH;
 		}
 
-		switch (deflate(&ctx->Z, flags)) {
+		switch (php_zlib_output_compressor(&ctx->Z, flags)) {
 			case Z_OK:
 				if (flags == Z_FINISH) {
 					deflateEnd(&ctx->Z);
@@ -391,7 +394,10 @@ static zend_string *php_zlib_encode(const char *in_buf, size_t in_len, int encod
 	Z.zfree = php_zlib_free;
 
 	if (Z_OK == (status = deflateInit2(&Z, level, Z_DEFLATED, encoding, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY))) {
-		out = zend_string_alloc(PHP_ZLIB_BUFFER_SIZE_GUESS(in_len), 0);
+		/* deflateBound() knows the configured wrapper, so one Z_FINISH pass
+		 * is guaranteed to fit; the heuristic guess over-allocates by ~1.5%,
+		 * which is real memory on multi-hundred-megabyte payloads. */
+		out = zend_string_alloc(deflateBound(&Z, in_len), 0);
 
 		Z.next_in = (Bytef *) in_buf;
 		Z.next_out = (Bytef *) ZSTR_VAL(out);
@@ -26,6 +26,8 @@ typedef struct _php_zlib_filter_data {
 	size_t inbuf_len;
 	unsigned char *outbuf;
 	size_t outbuf_len;
+	unsigned char *dict; /* preset dictionary, kept until inflate() asks for it via Z_NEED_DICT */
+	size_t dict_len;
 	int persistent;
 	bool finished; /* for zlib.deflate: signals that no flush is pending */
 } php_zlib_filter_data;
@@ -84,6 +86,10 @@ static php_stream_filter_status_t php_zlib_inflate_filter(
 			data->strm.avail_in = desired;
 
 			status = inflate(&(data->strm), flags & PSFS_FLAG_FLUSH_CLOSE ? Z_FINISH : Z_SYNC_FLUSH);
+			if (UNEXPECTED(status == Z_NEED_DICT) && data->dict) {
+				status = inflateSetDictionary(&(data->strm), data->dict, data->dict_len);
+				/* on success the not yet consumed input is re-fed on the next pass */
+			}
 			if (status == Z_STREAM_END) {
 				inflateEnd(&(data->strm));
 				data->finished = '\1';
@@ -150,6 +156,9 @@ static void php_zlib_inflate_dtor(php_stream_filter *thisfilter)
 		if (!data->finished) {
 			inflateEnd(&(data->strm));
 		}
+		if (data->dict) {
+			pefree(data->dict, data->persistent);
+		}
 		pefree(data->inbuf, data->persistent);
 		pefree(data->outbuf, data->persistent);
 		pefree(data, data->persistent);
@@ -319,11 +328,10 @@ static php_stream_filter *php_zlib_filter_create(const char *filtername, zval *f
 	if (strcasecmp(filtername, "zlib.inflate") == 0) {
 		int windowBits = -MAX_WBITS;
 
-		if (filterparams) {
+		if (filterparams && (Z_TYPE_P(filterparams) == IS_ARRAY || Z_TYPE_P(filterparams) == IS_OBJECT)) {
 			zval *tmpzval;
 
-			if ((Z_TYPE_P(filterparams) == IS_ARRAY || Z_TYPE_P(filterparams) == IS_OBJECT) &&
-				(tmpzval = zend_hash_str_find(HASH_OF(filterparams), "window", sizeof("window") - 1))) {
+			if ((tmpzval = zend_hash_str_find(HASH_OF(filterparams), "window", sizeof("window") - 1))) {
 				/* log-2 base of history window (9 - 15) */
 				zend_long tmp = zval_get_long(tmpzval);
 				if (tmp < -MAX_WBITS || tmp > MAX_WBITS + 32) {
@@ -332,11 +340,30 @@ static php_stream_filter *php_zlib_filter_create(const char *filtername, zval *f
 					windowBits = tmp;
 				}
 			}
+
+			if ((tmpzval = zend_hash_str_find(HASH_OF(filterparams), "dictionary", sizeof("dictionary") - 1))) {
+				ZVAL_DEREF(tmpzval);
+				if (Z_TYPE_P(tmpzval) == IS_STRING) {
+					data->dict = (unsigned char *) pemalloc(Z_STRLEN_P(tmpzval), persistent);
+					memcpy(data->dict, Z_STRVAL_P(tmpzval), Z_STRLEN_P(tmpzval));
+					data->dict_len = Z_STRLEN_P(tmpzval);
+				} else {
+					php_error_docref(NULL, E_WARNING, "Invalid parameter given for preset dictionary, ignored");
+				}
+			}
 		}
 
 		/* RFC 1951 Inflate */
 		data->finished = '\0';
 		status = inflateInit2(&(data->strm), windowBits);
+		if (status == Z_OK && data->dict && windowBits < 0) {
+			/* Raw deflate has no Z_NEED_DICT handshake, so the dictionary has
+			 * to be primed before the first inflate() call. zlib copies it;
+			 * ours is only kept around for the zlib-header case. */
+			status = inflateSetDictionary(&(data->strm), data->dict, data->dict_len);
+			pefree(data->dict, persistent);
+			data->dict = NULL;
+		}
 		fops = &php_zlib_inflate_ops;
 	} else if (strcasecmp(filtername, "zlib.deflate") == 0) {
 		/* RFC 1951 Deflate */
@@ -375,6 +402,17 @@ static php_stream_filter *php_zlib_filter_create(const char *filtername, zval *f
 						}
 					}
 
+					if ((tmpzval = zend_hash_str_find(HASH_OF(filterparams), "dictionary", sizeof("dictionary") - 1))) {
+						ZVAL_DEREF(tmpzval);
+						if (Z_TYPE_P(tmpzval) == IS_STRING) {
+							data->dict = (unsigned char *) pemalloc(Z_STRLEN_P(tmpzval), persistent);
+							memcpy(data->dict, Z_STRVAL_P(tmpzval), Z_STRLEN_P(tmpzval));
+							data->dict_len = Z_STRLEN_P(tmpzval);
+						} else {
+							php_error_docref(NULL, E_WARNING, "Invalid parameter given for preset dictionary, ignored");
+						}
+					}
+
 					if ((tmpzval = zend_hash_str_find(HASH_OF(filterparams), "level", sizeof("level") - 1))) {
 						tmp = zval_get_long(tmpzval);
 
@@ -399,6 +437,12 @@ factory_setlevel:
 			}
 		}
 		status = deflateInit2(&(data->strm), level, Z_DEFLATED, windowBits, memLevel, 0);
+		if (status == Z_OK && data->dict) {
+			/* zlib copies the dictionary into its window right away */
+			status = deflateSetDictionary(&(data->strm), data->dict, data->dict_len);
+			pefree(data->dict, persistent);
+			data->dict = NULL;
+		}
 		data->finished = 1;
 		fops = &php_zlib_deflate_ops;
 	} else {
@@ -407,6 +451,9 @@ factory_setlevel:
 
 	if (status != Z_OK) {
 		/* Unspecified (probably strm) error, let stream-filter error do its own whining */
+		if (data->dict) {
+			pefree(data->dict, persistent);
+		}
 		pefree(data->strm.next_in, persistent);
 		pefree(data->strm.next_out, persistent);
 		pefree(data, persistent);
@@ -24,6 +24,7 @@
 #include "SAPI.h"
 #include "php_variables.h"
 #include "php_ini.h"
+#include "php_network.h"
 #ifdef ZTS
 #include "TSRM.h"
 #endif
@@ -84,6 +85,7 @@ SAPI_API void sapi_startup(sapi_module_struct *sf)
 #endif
 
 	reentrancy_startup();
+	php_network_startup();
 }
 
 SAPI_API void sapi_shutdown(void)
@@ -94,6 +96,7 @@ SAPI_API void sapi_shutdown(void)
 	sapi_globals_dtor(&sapi_globals);
 #endif
 
+	php_network_shutdown();
 	reentrancy_shutdown();
 
 #ifdef PHP_WIN32
@@ -447,6 +450,7 @@ SAPI_API void sapi_activate(void)
 	SG(request_info).post_entry = NULL;
 	SG(request_info).proto_num = 1000; /* Default to HTTP 1.0 */
 	SG(global_request_time) = 0;
+	SG(request_start_hrtime) = zend_hrtime();
 	SG(post_read) = 0;
 	/* It's possible to override this general case in the activate() callback, if necessary. */
 	if (SG(request_info).request_method && !strcmp(SG(request_info).request_method, "HEAD")) {
@@ -1098,6 +1102,14 @@ SAPI_API double sapi_get_request_time(void)
 	return SG(global_request_time);
 }
 
+/* Monotonic timestamp taken at request activation, so per-request durations
+ * can be computed without an additional clock read at the start of the
+ * measured interval. */
+SAPI_API zend_hrtime_t sapi_get_request_start_hrtime(void)
+{
+	return SG(request_start_hrtime);
+}
+
 SAPI_API void sapi_terminate_process(void) {
 	if (sapi_module.terminate_process) {
 		sapi_module.terminate_process();
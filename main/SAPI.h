@@ -22,6 +22,7 @@
 #include "zend_API.h"
 #include "zend_llist.h"
 #include "zend_operators.h"
+#include "zend_hrtime.h"
 #include <sys/stat.h>
 
 #define SAPI_OPTION_NO_CHDIR 1
@@ -144,6 +145,7 @@ typedef struct _sapi_globals_struct {
 	int options;
 	bool sapi_started;
 	double global_request_time;
+	zend_hrtime_t request_start_hrtime;
 	HashTable known_post_content_types;
 	zval callback_func;
 	zend_fcall_info_cache fci_cache;
@@ -231,6 +233,7 @@ SAPI_API int sapi_force_http_10(void);
 SAPI_API int sapi_get_target_uid(uid_t *);
 SAPI_API int sapi_get_target_gid(gid_t *);
 SAPI_API double sapi_get_request_time(void);
+SAPI_API zend_hrtime_t sapi_get_request_start_hrtime(void);
 SAPI_API void sapi_terminate_process(void);
 END_EXTERN_C()
 
@@ -75,6 +75,10 @@ static int is_impersonate = 0;
 # elif defined(HAVE_SYS_POLL_H) && defined(HAVE_POLL)
 #  include <sys/poll.h>
 # endif
+# ifdef HAVE_SYS_UIO_H
+#  include <sys/uio.h>
+#  define FCGI_HAVE_WRITEV 1
+# endif
 # if defined(HAVE_SYS_SELECT_H)
 #  include <sys/select.h>
 # endif
@@ -216,6 +220,11 @@ struct _fcgi_request {
 	int            in_len;
 	int            in_pad;
 
+	/* readahead over the connection; see buffered_read() */
+	int            in_buf_pos;
+	int            in_buf_len;
+	unsigned char  in_buf[1024*8];
+
 	fcgi_header   *out_hdr;
 
 	unsigned char *out_pos;
@@ -248,6 +257,15 @@ static int in_shutdown = 0;
 static sa_t *allowed_clients = NULL;
 static sa_t client_sa;
 
+#if !defined(_WIN32) && defined(HAVE_POLL)
+/* Idle keep-alive connections parked between requests while the worker
+ * multiplexes over them and the listen socket. See fcgi_accept_request(). */
+static int *parked_conns = NULL;
+static struct pollfd *parked_pollfds = NULL;
+static unsigned int parked_count = 0;
+static unsigned int parked_limit = 0;
+#endif
+
 /* hash table */
 static void fcgi_hash_init(fcgi_hash *h)
 {
@@ -463,6 +481,25 @@ void fcgi_request_set_keep(fcgi_request *req, int new_value)
 	req->keep = new_value;
 }
 
+void fcgi_set_max_idle_connections(unsigned int max)
+{
+#if !defined(_WIN32) && defined(HAVE_POLL)
+	if (max > 0 && !parked_conns) {
+		parked_conns = (int*)malloc(max * sizeof(int));
+		/* one extra slot for the listen socket */
+		parked_pollfds = (struct pollfd*)malloc((max + 1) * sizeof(struct pollfd));
+		if (!parked_conns || !parked_pollfds) {
+			free(parked_conns);
+			free(parked_pollfds);
+			parked_conns = NULL;
+			parked_pollfds = NULL;
+			return;
+		}
+	}
+	parked_limit = max;
+#endif
+}
+
 #ifndef HAVE_ATTRIBUTE_WEAK
 void fcgi_set_logger(fcgi_logger lg) {
 	fcgi_log = lg;
@@ -556,6 +593,16 @@ void fcgi_shutdown(void)
 	if (allowed_clients) {
 		free(allowed_clients);
 	}
+#if !defined(_WIN32) && defined(HAVE_POLL)
+	while (parked_count > 0) {
+		closesocket(parked_conns[--parked_count]);
+	}
+	free(parked_conns);
+	free(parked_pollfds);
+	parked_conns = NULL;
+	parked_pollfds = NULL;
+	parked_limit = 0;
+#endif
 }
 
 #ifdef _WIN32
@@ -944,34 +991,68 @@ static inline ssize_t safe_write(fcgi_request *req, const void *buf, size_t coun
 	return n;
 }
 
-static inline ssize_t safe_read(fcgi_request *req, const void *buf, size_t count)
+#ifdef FCGI_HAVE_WRITEV
+static ssize_t safe_writev(fcgi_request *req, struct iovec *iov, int iovcnt, size_t count)
 {
-	int    ret;
-	size_t n = 0;
+	ssize_t ret;
+	size_t  n = 0;
 
-	do {
-#ifdef _WIN32
-		size_t tmp;
-#endif
+	while (iovcnt > 0) {
 		errno = 0;
-#ifdef _WIN32
-		tmp = count - n;
+		ret = writev(req->fd, iov, iovcnt);
+		if (ret > 0) {
+			n += ret;
+			if (n == count) {
+				return n;
+			}
+			/* advance the chain past the segments a short write completed */
+			while ((size_t)ret >= iov->iov_len) {
+				ret -= iov->iov_len;
+				iov++;
+				iovcnt--;
+			}
+			iov->iov_base = (char*)iov->iov_base + ret;
+			iov->iov_len -= ret;
+		} else if (ret <= 0 && errno != 0 && errno != EINTR) {
+			return ret;
+		}
+	}
+	return n;
+}
+#endif
 
-		if (!req->tcp) {
-			unsigned int in_len = tmp > INT_MAX ? INT_MAX : (unsigned int)tmp;
+/* One raw read from the connection; error handling is left to the caller */
+static inline int raw_read(fcgi_request *req, void *buf, size_t count)
+{
+	int ret;
 
-			ret = _read(req->fd, ((char*)buf)+n, in_len);
-		} else {
-			int in_len = tmp > INT_MAX ? INT_MAX : (int)tmp;
+#ifdef _WIN32
+	if (!req->tcp) {
+		unsigned int in_len = count > INT_MAX ? INT_MAX : (unsigned int)count;
 
-			ret = recv(req->fd, ((char*)buf)+n, in_len, 0);
-			if (ret <= 0) {
-				errno = WSAGetLastError();
-			}
+		ret = _read(req->fd, buf, in_len);
+	} else {
+		int in_len = count > INT_MAX ? INT_MAX : (int)count;
+
+		ret = recv(req->fd, buf, in_len, 0);
+		if (ret <= 0) {
+			errno = WSAGetLastError();
 		}
+	}
 #else
-		ret = read(req->fd, ((char*)buf)+n, count-n);
+	ret = read(req->fd, buf, count);
 #endif
+	return ret;
+}
+
+static inline ssize_t safe_read(fcgi_request *req, const void *buf, size_t count)
+{
+	int    ret;
+	size_t n = 0;
+
+	do {
+		errno = 0;
+		ret = raw_read(req, ((char*)buf)+n, count-n);
 		if (ret > 0) {
 			n += ret;
 		} else if (ret == 0 && errno == 0) {
@@ -983,6 +1064,54 @@ static inline ssize_t safe_read(fcgi_request *req, const void *buf, size_t count
 	return n;
 }
 
+/* Buffered counterpart of safe_read(): reads ahead into req->in_buf, so a
+ * request whose records arrive back to back is parsed with a single read
+ * syscall instead of one per record header and payload. Readahead may also
+ * pick up records of a pipelined next request on a keep-alive connection;
+ * they stay buffered and fcgi_accept_request() parses them right away
+ * instead of going back to poll(). */
+static ssize_t buffered_read(fcgi_request *req, void *buf, size_t count)
+{
+	size_t n = 0;
+
+	while (n < count) {
+		int ret;
+
+		if (req->in_buf_pos < req->in_buf_len) {
+			size_t chunk = req->in_buf_len - req->in_buf_pos;
+
+			if (chunk > count - n) {
+				chunk = count - n;
+			}
+			memcpy((char*)buf + n, req->in_buf + req->in_buf_pos, chunk);
+			req->in_buf_pos += (int)chunk;
+			n += chunk;
+			continue;
+		}
+		req->in_buf_pos = req->in_buf_len = 0;
+		if (count - n >= sizeof(req->in_buf)) {
+			/* the tail is larger than the readahead buffer, read it
+			 * straight into the caller's buffer */
+			ssize_t r = safe_read(req, (char*)buf + n, count - n);
+
+			return r < 0 ? r : (ssize_t)n + r;
+		}
+		do {
+			errno = 0;
+			ret = raw_read(req, req->in_buf, sizeof(req->in_buf));
+		} while (ret < 0 && errno == EINTR);
+		if (ret < 0) {
+			return ret;
+		}
+		if (ret == 0) {
+			/* EOF: short read, as with safe_read() */
+			return n;
+		}
+		req->in_buf_len = ret;
+	}
+	return n;
+}
+
 static inline int fcgi_make_header(fcgi_header *hdr, fcgi_request_type type, int req_id, int len)
 {
 	int pad = ((len + 7) & ~7) - len;
@@ -1051,7 +1180,7 @@ static int fcgi_read_request(fcgi_request *req)
 		req->has_env = 1;
 	}
 
-	if (safe_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
+	if (buffered_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
 	    hdr.version < FCGI_VERSION_1) {
 		return 0;
 	}
@@ -1060,7 +1189,7 @@ static int fcgi_read_request(fcgi_request *req)
 	padding = hdr.paddingLength;
 
 	while (hdr.type == FCGI_STDIN && len == 0) {
-		if (safe_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
+		if (buffered_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
 		    hdr.version < FCGI_VERSION_1) {
 			return 0;
 		}
@@ -1078,7 +1207,7 @@ static int fcgi_read_request(fcgi_request *req)
 	if (hdr.type == FCGI_BEGIN_REQUEST && len == sizeof(fcgi_begin_request)) {
 		fcgi_begin_request *b;
 
-		if (safe_read(req, buf, len+padding) != len+padding) {
+		if (buffered_read(req, buf, len+padding) != len+padding) {
 			return 0;
 		}
 
@@ -1110,7 +1239,7 @@ static int fcgi_read_request(fcgi_request *req)
 				return 0;
 		}
 
-		if (safe_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
+		if (buffered_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
 		    hdr.version < FCGI_VERSION_1) {
 			return 0;
 		}
@@ -1123,7 +1252,7 @@ static int fcgi_read_request(fcgi_request *req)
 				return 0;
 			}
 
-			if (safe_read(req, buf, len+padding) != len+padding) {
+			if (buffered_read(req, buf, len+padding) != len+padding) {
 				req->keep = 0;
 				return 0;
 			}
@@ -1133,7 +1262,7 @@ static int fcgi_read_request(fcgi_request *req)
 				return 0;
 			}
 
-			if (safe_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
+			if (buffered_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
 			    hdr.version < FCGI_VERSION_1) {
 				req->keep = 0;
 				return 0;
@@ -1147,7 +1276,7 @@ static int fcgi_read_request(fcgi_request *req)
 		unsigned int zlen;
 		fcgi_hash_bucket *q;
 
-		if (safe_read(req, buf, len+padding) != len+padding) {
+		if (buffered_read(req, buf, len+padding) != len+padding) {
 			req->keep = 0;
 			return 0;
 		}
@@ -1211,7 +1340,7 @@ int fcgi_read(fcgi_request *req, char *str, int len)
 	rest = len;
 	while (rest > 0) {
 		if (req->in_len == 0) {
-			if (safe_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
+			if (buffered_read(req, &hdr, sizeof(fcgi_header)) != sizeof(fcgi_header) ||
 			    hdr.version < FCGI_VERSION_1 ||
 			    hdr.type != FCGI_STDIN) {
 				req->keep = 0;
@@ -1225,9 +1354,9 @@ int fcgi_read(fcgi_request *req, char *str, int len)
 		}
 
 		if (req->in_len >= rest) {
-			ret = (int)safe_read(req, str, rest);
+			ret = (int)buffered_read(req, str, rest);
 		} else {
-			ret = (int)safe_read(req, str, req->in_len);
+			ret = (int)buffered_read(req, str, req->in_len);
 		}
 		if (ret < 0) {
 			req->keep = 0;
@@ -1239,7 +1368,7 @@ int fcgi_read(fcgi_request *req, char *str, int len)
 			str += ret;
 			if (req->in_len == 0) {
 				if (req->in_pad) {
-					if (safe_read(req, buf, req->in_pad) != req->in_pad) {
+					if (buffered_read(req, buf, req->in_pad) != req->in_pad) {
 						req->keep = 0;
 						return ret;
 					}
@@ -1300,6 +1429,7 @@ void fcgi_close(fcgi_request *req, int force, int destroy)
 		req->nodelay = 0;
 #endif
 		req->fd = -1;
+		req->in_buf_pos = req->in_buf_len = 0;
 
 		req->hook.on_close();
 	}
@@ -1356,6 +1486,85 @@ int fcgi_accept_request(fcgi_request *req)
 #endif
 
 	while (1) {
+#if !defined(_WIN32) && defined(HAVE_POLL)
+		/* Multiplexing mode: an idle keep-alive connection does not pin the
+		 * worker. Park it and wait for the first of the parked connections
+		 * or, while below the limit, the listen socket to become readable.
+		 * New connections are parked as well, so only a connection that has
+		 * data pending is ever handed to the (blocking) request reader. */
+		if (parked_limit && !in_shutdown
+		 /* records of a pipelined next request are already buffered: the
+		  * connection would not poll readable, parse them right away */
+		 && req->in_buf_pos >= req->in_buf_len) {
+			if (req->fd >= 0 && parked_count < parked_limit) {
+				parked_conns[parked_count++] = req->fd;
+				req->fd = -1;
+			}
+			while (req->fd < 0 && parked_count > 0 && !in_shutdown) {
+				unsigned int i, listen_idx = parked_count;
+				int with_listen = parked_count < parked_limit;
+				nfds_t nfds = parked_count + (with_listen ? 1 : 0);
+				int ret;
+
+				for (i = 0; i < parked_count; i++) {
+					parked_pollfds[i].fd = parked_conns[i];
+					parked_pollfds[i].events = POLLIN;
+					parked_pollfds[i].revents = 0;
+				}
+				if (with_listen) {
+					parked_pollfds[listen_idx].fd = req->listen_socket;
+					parked_pollfds[listen_idx].events = POLLIN;
+					parked_pollfds[listen_idx].revents = 0;
+				}
+
+				req->hook.on_accept();
+				errno = 0;
+				ret = poll(parked_pollfds, nfds, -1);
+				if (ret <= 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					break;
+				}
+				for (i = 0; i < parked_count; i++) {
+					if (parked_pollfds[i].revents & (POLLIN|POLLERR|POLLHUP)) {
+						req->fd = parked_conns[i];
+						parked_conns[i] = parked_conns[--parked_count];
+						break;
+					}
+				}
+				if (req->fd < 0 && with_listen
+				 && (parked_pollfds[listen_idx].revents & POLLIN)) {
+					sa_t sa;
+					socklen_t len = sizeof(sa);
+					int fd;
+
+					FCGI_LOCK(req->listen_socket);
+#ifdef HAVE_ACCEPT4
+					fd = accept4(req->listen_socket, (struct sockaddr *)&sa, &len, SOCK_CLOEXEC);
+#else
+					fd = accept(req->listen_socket, (struct sockaddr *)&sa, &len);
+#endif
+					FCGI_UNLOCK(req->listen_socket);
+					if (fd >= 0) {
+						client_sa = sa;
+						if (!fcgi_is_allowed()) {
+							fcgi_log(FCGI_ERROR, "Connection disallowed: IP address '%s' has been dropped.", fcgi_get_last_client_ip());
+							closesocket(fd);
+						} else {
+#if !defined(HAVE_ACCEPT4) && defined(F_SETFD) && defined(FD_CLOEXEC)
+							int fd_attrs = fcntl(fd, F_GETFD);
+							if (0 > fd_attrs || 0 > fcntl(fd, F_SETFD, fd_attrs | FD_CLOEXEC)) {
+								fcgi_log(FCGI_WARNING, "failed to change attribute of the connection socket");
+							}
+#endif
+							parked_conns[parked_count++] = fd;
+						}
+					}
+				}
+			}
+		}
+#endif
 		if (req->fd < 0) {
 			while (1) {
 				if (in_shutdown) {
@@ -1394,7 +1603,11 @@ int fcgi_accept_request(fcgi_request *req)
 					socklen_t len = sizeof(sa);
 
 					FCGI_LOCK(req->listen_socket);
+#ifdef HAVE_ACCEPT4
+					req->fd = accept4(listen_socket, (struct sockaddr *)&sa, &len, SOCK_CLOEXEC);
+#else
 					req->fd = accept(listen_socket, (struct sockaddr *)&sa, &len);
+#endif
 					FCGI_UNLOCK(req->listen_socket);
 
 					client_sa = sa;
@@ -1414,7 +1627,7 @@ int fcgi_accept_request(fcgi_request *req)
 					return -1;
 				}
 
-#if defined(F_SETFD) && defined(FD_CLOEXEC)
+#if !defined(HAVE_ACCEPT4) && defined(F_SETFD) && defined(FD_CLOEXEC)
 				int fd_attrs = fcntl(req->fd, F_GETFD);
 				if (0 > fd_attrs) {
 					fcgi_log(FCGI_WARNING, "failed to get attributes of the connection socket");
@@ -1537,6 +1750,38 @@ int fcgi_flush(fcgi_request *req, int end)
 	return 1;
 }
 
+/* Flush the buffered records followed by an out-of-buffer record body.
+ * With writev() both go out in a single gather-write, so large bodies are
+ * never copied into out_buf and cost one syscall instead of two. */
+static int fcgi_flush_with_body(fcgi_request *req, const char *body, int body_len)
+{
+#ifdef FCGI_HAVE_WRITEV
+	struct iovec iov[2];
+	int len = (int)(req->out_pos - req->out_buf);
+
+	iov[0].iov_base = req->out_buf;
+	iov[0].iov_len = len;
+	iov[1].iov_base = (char*)body;
+	iov[1].iov_len = body_len;
+
+	req->out_pos = req->out_buf;
+	if (safe_writev(req, iov, 2, len + body_len) != len + body_len) {
+		req->keep = 0;
+		return 0;
+	}
+	return 1;
+#else
+	if (!fcgi_flush(req, 0)) {
+		return 0;
+	}
+	if (safe_write(req, body, body_len) != (ssize_t)body_len) {
+		req->keep = 0;
+		return 0;
+	}
+	return 1;
+#endif
+}
+
 int fcgi_write(fcgi_request *req, fcgi_request_type type, const char *str, int len)
 {
 	int limit, rest;
@@ -1613,11 +1858,7 @@ int fcgi_write(fcgi_request *req, fcgi_request_type type, const char *str, int l
 			open_packet(req, type);
 			fcgi_make_header(req->out_hdr, type, req->id, 0xfff8);
 			req->out_hdr = NULL;
-			if (!fcgi_flush(req, 0)) {
-				return -1;
-			}
-			if (safe_write(req, str + pos, 0xfff8) != 0xfff8) {
-				req->keep = 0;
+			if (!fcgi_flush_with_body(req, str + pos, 0xfff8)) {
 				return -1;
 			}
 			pos += 0xfff8;
@@ -1629,11 +1870,7 @@ int fcgi_write(fcgi_request *req, fcgi_request_type type, const char *str, int l
 		open_packet(req, type);
 		fcgi_make_header(req->out_hdr, type, req->id, (len - pos) - rest);
 		req->out_hdr = NULL;
-		if (!fcgi_flush(req, 0)) {
-			return -1;
-		}
-		if (safe_write(req, str + pos, (len - pos) - rest) != (len - pos) - rest) {
-			req->keep = 0;
+		if (!fcgi_flush_with_body(req, str + pos, (len - pos) - rest)) {
 			return -1;
 		}
 		if (pad) {
@@ -130,6 +130,80 @@ static const char *php_gai_strerror(int code)
 #endif
 #endif
 
+/* Installed by event-loop providers to suspend the running fiber instead of
+ * blocking in poll(2); see php_fiber_fd_wait() in php_network.h. */
+PHPAPI php_fd_wait_func_t php_fiber_fd_wait_hook = NULL;
+
+#ifdef HAVE_GETADDRINFO
+/* {{{ Per-process DNS cache
+ *
+ * getaddrinfo() is called synchronously for every outgoing connection, so a
+ * slow or flaky resolver stalls the worker for up to several seconds each
+ * time. Successful lookups are therefore cached for dns_cache_ttl seconds
+ * (0 disables the cache) and resolution failures for a few seconds, so
+ * repeated connects to the same hosts do not touch the resolver at all.
+ * The cache is process-wide and survives requests; everything it holds is
+ * allocated persistently. */
+
+#define PHP_DNS_CACHE_MAX_ENTRIES	256
+#define PHP_DNS_NEG_CACHE_TTL		5
+
+typedef struct {
+	struct sockaddr **addrs;	/* NULL-terminated; count entries */
+	socklen_t *lens;
+	int count;					/* 0 for a cached failure */
+	int gai_errno;				/* getaddrinfo() result for cached failures */
+	time_t expires;
+} php_dns_cache_entry;
+
+static HashTable dns_cache;
+#ifdef ZTS
+static MUTEX_T dns_cache_mutex;
+# define DNS_CACHE_LOCK()	tsrm_mutex_lock(dns_cache_mutex)
+# define DNS_CACHE_UNLOCK()	tsrm_mutex_unlock(dns_cache_mutex)
+#else
+# define DNS_CACHE_LOCK()
+# define DNS_CACHE_UNLOCK()
+#endif
+
+static void php_dns_cache_entry_free(zval *zv)
+{
+	php_dns_cache_entry *entry = (php_dns_cache_entry *) Z_PTR_P(zv);
+
+	if (entry->addrs) {
+		struct sockaddr **sap;
+
+		for (sap = entry->addrs; *sap != NULL; sap++) {
+			pefree(*sap, 1);
+		}
+		pefree(entry->addrs, 1);
+		pefree(entry->lens, 1);
+	}
+	pefree(entry, 1);
+}
+/* }}} */
+#endif
+
+PHPAPI void php_network_startup(void)
+{
+#ifdef HAVE_GETADDRINFO
+	zend_hash_init(&dns_cache, 16, NULL, php_dns_cache_entry_free, 1);
+# ifdef ZTS
+	dns_cache_mutex = tsrm_mutex_alloc();
+# endif
+#endif
+}
+
+PHPAPI void php_network_shutdown(void)
+{
+#ifdef HAVE_GETADDRINFO
+	zend_hash_destroy(&dns_cache);
+# ifdef ZTS
+	tsrm_mutex_free(dns_cache_mutex);
+# endif
+#endif
+}
+
 /* {{{ php_network_freeaddresses */
 PHPAPI void php_network_freeaddresses(struct sockaddr **sal)
 {
@@ -155,6 +229,10 @@ PHPAPI int php_network_getaddresses(const char *host, int socktype, struct socka
 	static int ipv6_borked = -1; /* the way this is used *is* thread safe */
 # endif
 	struct addrinfo hints, *res, *sai;
+	zend_long dns_ttl = FG(dns_cache_ttl);
+	char dns_key[320];
+	size_t dns_key_len = 0;
+	bool dns_negative_hit = false;
 #else
 	struct hostent *host_info;
 	struct in_addr in;
@@ -190,7 +268,42 @@ PHPAPI int php_network_getaddresses(const char *host, int socktype, struct socka
 	hints.ai_family = ipv6_borked ? AF_INET : AF_UNSPEC;
 # endif
 
-	if ((n = getaddrinfo(host, NULL, &hints, &res))) {
+	/* the probed address family is fixed for the process lifetime, so the
+	 * cache key only needs the socket type and the host */
+	if (dns_ttl > 0 && strlen(host) < sizeof(dns_key) - 16) {
+		php_dns_cache_entry *entry;
+
+		dns_key_len = (size_t) snprintf(dns_key, sizeof(dns_key), "%d:%s", socktype, host);
+
+		DNS_CACHE_LOCK();
+		entry = zend_hash_str_find_ptr(&dns_cache, dns_key, dns_key_len);
+		if (entry) {
+			if (entry->expires >= time(NULL)) {
+				if (entry->count > 0) {
+					int i;
+
+					/* copy out while holding the lock; the entry may be
+					 * evicted by another thread afterwards */
+					n = entry->count;
+					*sal = safe_emalloc(n + 1, sizeof(*sal), 0);
+					for (i = 0; i < n; i++) {
+						(*sal)[i] = emalloc(entry->lens[i]);
+						memcpy((*sal)[i], entry->addrs[i], entry->lens[i]);
+					}
+					(*sal)[n] = NULL;
+					DNS_CACHE_UNLOCK();
+					return n;
+				}
+				n = entry->gai_errno;
+				dns_negative_hit = true;
+			} else {
+				zend_hash_str_del(&dns_cache, dns_key, dns_key_len);
+			}
+		}
+		DNS_CACHE_UNLOCK();
+	}
+
+	if (dns_negative_hit || (n = getaddrinfo(host, NULL, &hints, &res))) {
 		if (error_string) {
 			/* free error string received during previous iteration (if any) */
 			if (*error_string) {
@@ -201,6 +314,27 @@ PHPAPI int php_network_getaddresses(const char *host, int socktype, struct socka
 		} else {
 			php_error_docref(NULL, E_WARNING, "php_network_getaddresses: getaddrinfo for %s failed: %s", host, PHP_GAI_STRERROR(n));
 		}
+		/* remember the failure briefly, except for local resource problems */
+		if (dns_key_len && !dns_negative_hit && n != EAI_MEMORY
+#ifdef EAI_SYSTEM
+			&& n != EAI_SYSTEM
+#endif
+		) {
+			php_dns_cache_entry *entry = pemalloc(sizeof(*entry), 1);
+
+			entry->addrs = NULL;
+			entry->lens = NULL;
+			entry->count = 0;
+			entry->gai_errno = n;
+			entry->expires = time(NULL) + MIN(dns_ttl, PHP_DNS_NEG_CACHE_TTL);
+
+			DNS_CACHE_LOCK();
+			if (zend_hash_num_elements(&dns_cache) >= PHP_DNS_CACHE_MAX_ENTRIES) {
+				zend_hash_clean(&dns_cache);
+			}
+			zend_hash_str_update_ptr(&dns_cache, dns_key, dns_key_len, entry);
+			DNS_CACHE_UNLOCK();
+		}
 		return 0;
 	} else if (res == NULL) {
 		if (error_string) {
@@ -230,6 +364,30 @@ PHPAPI int php_network_getaddresses(const char *host, int socktype, struct socka
 		sap++;
 	} while ((sai = sai->ai_next) != NULL);
 
+	if (dns_key_len) {
+		php_dns_cache_entry *entry = pemalloc(sizeof(*entry), 1);
+		int i;
+
+		entry->count = n;
+		entry->gai_errno = 0;
+		entry->expires = time(NULL) + dns_ttl;
+		entry->addrs = pemalloc((n + 1) * sizeof(*entry->addrs), 1);
+		entry->lens = pemalloc(n * sizeof(*entry->lens), 1);
+		for (sai = res, i = 0; sai != NULL; sai = sai->ai_next, i++) {
+			entry->addrs[i] = pemalloc(sai->ai_addrlen, 1);
+			memcpy(entry->addrs[i], sai->ai_addr, sai->ai_addrlen);
+			entry->lens[i] = sai->ai_addrlen;
+		}
+		entry->addrs[n] = NULL;
+
+		DNS_CACHE_LOCK();
+		if (zend_hash_num_elements(&dns_cache) >= PHP_DNS_CACHE_MAX_ENTRIES) {
+			zend_hash_clean(&dns_cache);
+		}
+		zend_hash_str_update_ptr(&dns_cache, dns_key, dns_key_len, entry);
+		DNS_CACHE_UNLOCK();
+	}
+
 	freeaddrinfo(res);
 #else
 	if (!inet_pton(AF_INET, host, &in)) {
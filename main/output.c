@@ -52,8 +52,9 @@ static inline bool php_output_lock_error(int op);
 static inline void php_output_op(int op, const char *str, size_t len);
 
 static inline php_output_handler *php_output_handler_init(zend_string *name, size_t chunk_size, int flags);
+static void php_output_buffer_release(php_output_buffer *buffer);
 static inline php_output_handler_status_t php_output_handler_op(php_output_handler *handler, php_output_context *context);
-static inline bool php_output_handler_append(php_output_handler *handler, const php_output_buffer *buf);
+static inline bool php_output_handler_append(php_output_handler *handler, php_output_buffer *buf);
 static inline zval *php_output_handler_status(php_output_handler *handler, zval *entry);
 
 static inline void php_output_context_init(php_output_context *context, int op);
@@ -80,6 +81,18 @@ static inline void php_output_init_globals(zend_output_globals *G)
 }
 /* }}} */
 
+/* {{{ static void php_output_free_globals(zend_output_globals *G)
+ * Free the spare handler buffer kept across requests */
+static void php_output_free_globals(zend_output_globals *G)
+{
+	if (G->spare_data) {
+		pefree(G->spare_data, 1);
+		G->spare_data = NULL;
+		G->spare_size = 0;
+	}
+}
+/* }}} */
+
 /* {{{ stderr/stdout writer if not PHP_OUTPUT_ACTIVATED */
 static size_t php_output_stdout(const char *str, size_t str_len)
 {
@@ -135,7 +148,7 @@ static void reverse_conflict_dtor(zval *zv)
  * Set up module globals and initialize the conflict and reverse conflict hash tables */
 PHPAPI void php_output_startup(void)
 {
-	ZEND_INIT_MODULE_GLOBALS(output, php_output_init_globals, NULL);
+	ZEND_INIT_MODULE_GLOBALS(output, php_output_init_globals, php_output_free_globals);
 	zend_hash_init(&php_output_handler_aliases, 8, NULL, NULL, 1);
 	zend_hash_init(&php_output_handler_conflicts, 8, NULL, NULL, 1);
 	zend_hash_init(&php_output_handler_reverse_conflicts, 8, NULL, reverse_conflict_dtor, 1);
@@ -148,6 +161,9 @@ PHPAPI void php_output_startup(void)
 PHPAPI void php_output_shutdown(void)
 {
 	php_output_direct = php_output_stderr;
+#ifndef ZTS
+	php_output_free_globals(&output_globals);
+#endif
 	zend_hash_destroy(&php_output_handler_aliases);
 	zend_hash_destroy(&php_output_handler_conflicts);
 	zend_hash_destroy(&php_output_handler_reverse_conflicts);
@@ -159,10 +175,19 @@ PHPAPI void php_output_shutdown(void)
 PHPAPI int php_output_activate(void)
 {
 #ifdef ZTS
-	memset(TSRMG_BULK_STATIC(output_globals_id, zend_output_globals*), 0, sizeof(zend_output_globals));
+	zend_output_globals *G = TSRMG_BULK_STATIC(output_globals_id, zend_output_globals*);
 #else
-	memset(&output_globals, 0, sizeof(zend_output_globals));
+	zend_output_globals *G = &output_globals;
 #endif
+	/* the recycled buffer and its high-water mark survive the request cycle */
+	char *spare_data = G->spare_data;
+	size_t spare_size = G->spare_size;
+	size_t high_water = G->high_water;
+
+	memset(G, 0, sizeof(zend_output_globals));
+	G->spare_data = spare_data;
+	G->spare_size = spare_size;
+	G->high_water = high_water;
 
 	zend_stack_init(&OG(handlers), sizeof(php_output_handler *));
 	OG(flags) |= PHP_OUTPUT_ACTIVATED;
@@ -247,6 +272,60 @@ PHPAPI size_t php_output_write(const char *str, size_t len)
 }
 /* }}} */
 
+/* {{{ char *php_output_reserve(size_t len)
+ * Reserve len bytes at the end of the active handler's buffer for direct
+ * writing, so producers of large output can skip the intermediate copy that
+ * php_output_write() implies.  Returns NULL when no buffer can be reserved;
+ * the caller must then fall back to php_output_write().  Every successful
+ * reservation must be completed with php_output_commit() before any other
+ * output operation is performed. */
+PHPAPI char *php_output_reserve(size_t len)
+{
+	php_output_handler *handler = OG(active);
+
+	if (!(OG(flags) & PHP_OUTPUT_ACTIVATED)
+	 || (OG(flags) & (PHP_OUTPUT_DISABLED|PHP_OUTPUT_IMPLICITFLUSH))
+	 || OG(running)
+	 || !handler
+	 || (handler->flags & PHP_OUTPUT_HANDLER_DISABLED)
+	 /* stay below the chunk size so no flush is due after the commit */
+	 || (handler->size && handler->buffer.used + len >= handler->size)) {
+		return NULL;
+	}
+	if ((handler->buffer.size - handler->buffer.used) <= len) {
+		size_t grow_int = PHP_OUTPUT_HANDLER_INITBUF_SIZE(handler->size);
+		size_t grow_buf = PHP_OUTPUT_HANDLER_INITBUF_SIZE(len - (handler->buffer.size - handler->buffer.used));
+		size_t grow_max = MAX(grow_int, grow_buf);
+
+		if (handler->buffer.persistent) {
+			handler->buffer.data = safe_perealloc(handler->buffer.data, 1, handler->buffer.size, grow_max, 1);
+		} else {
+			handler->buffer.data = safe_erealloc(handler->buffer.data, 1, handler->buffer.size, grow_max);
+		}
+		handler->buffer.size += grow_max;
+	}
+	return handler->buffer.data + handler->buffer.used;
+}
+/* }}} */
+
+/* {{{ void php_output_commit(size_t len)
+ * Publish len bytes written into the space returned by php_output_reserve() */
+PHPAPI void php_output_commit(size_t len)
+{
+	php_output_handler *handler = OG(active);
+
+	ZEND_ASSERT(handler && handler->buffer.size - handler->buffer.used > len);
+
+	handler->buffer.used += len;
+	if (handler->buffer.used > OG(high_water)) {
+		OG(high_water) = handler->buffer.used;
+	}
+	if (len) {
+		OG(flags) |= PHP_OUTPUT_WRITTEN;
+	}
+}
+/* }}} */
+
 /* {{{ SUCCESS|FAILURE php_output_flush(void)
  * Flush the most recent output handlers buffer */
 PHPAPI zend_result php_output_flush(void)
@@ -697,7 +776,7 @@ PHPAPI void php_output_handler_dtor(php_output_handler *handler)
 		zend_string_release_ex(handler->name, 0);
 	}
 	if (handler->buffer.data) {
-		efree(handler->buffer.data);
+		php_output_buffer_release(&handler->buffer);
 	}
 	if (handler->flags & PHP_OUTPUT_HANDLER_USER) {
 		zval_ptr_dtor(&handler->func.user->zoh);
@@ -847,6 +926,38 @@ static inline void php_output_context_dtor(php_output_context *context)
 }
 /* }}} */
 
+/* A spare buffer larger than this is not worth keeping across requests */
+#define PHP_OUTPUT_SPARE_MAX_SIZE 0x100000
+
+/* {{{ static void php_output_buffer_release(php_output_buffer *buffer)
+ * Free a handler buffer, keeping one spare buffer per worker sized from the
+ * high-water mark of past requests so the next request starts out with
+ * storage that does not need to grow */
+static void php_output_buffer_release(php_output_buffer *buffer)
+{
+	if (buffer->persistent) {
+		if (!OG(spare_data) && buffer->size <= PHP_OUTPUT_SPARE_MAX_SIZE) {
+			OG(spare_data) = buffer->data;
+			OG(spare_size) = buffer->size;
+		} else {
+			pefree(buffer->data, 1);
+		}
+	} else {
+		efree(buffer->data);
+		if (!OG(spare_data) && OG(high_water) > PHP_OUTPUT_HANDLER_DEFAULT_SIZE) {
+			size_t spare_size = MIN(PHP_OUTPUT_HANDLER_INITBUF_SIZE(OG(high_water)), PHP_OUTPUT_SPARE_MAX_SIZE);
+
+			OG(spare_data) = pemalloc(spare_size, 1);
+			OG(spare_size) = spare_size;
+		}
+	}
+	buffer->data = NULL;
+	buffer->size = 0;
+	buffer->used = 0;
+	buffer->persistent = 0;
+}
+/* }}} */
+
 /* {{{ static php_output_handler *php_output_handler_init(zval *name, size_t chunk_size, int flags)
  * Allocates and initializes a php_output_handler structure */
 static inline php_output_handler *php_output_handler_init(zend_string *name, size_t chunk_size, int flags)
@@ -858,29 +969,63 @@ static inline php_output_handler *php_output_handler_init(zend_string *name, siz
 	handler->size = chunk_size;
 	handler->flags = flags;
 	handler->buffer.size = PHP_OUTPUT_HANDLER_INITBUF_SIZE(chunk_size);
-	handler->buffer.data = emalloc(handler->buffer.size);
+	if (OG(spare_data) && OG(spare_size) >= handler->buffer.size) {
+		handler->buffer.data = OG(spare_data);
+		handler->buffer.size = OG(spare_size);
+		handler->buffer.persistent = 1;
+		OG(spare_data) = NULL;
+		OG(spare_size) = 0;
+	} else {
+		handler->buffer.data = emalloc(handler->buffer.size);
+	}
 
 	return handler;
 }
 /* }}} */
 
-/* {{{ static bool php_output_handler_append(php_output_handler *handler, const php_output_buffer *buf)
+/* {{{ static bool php_output_handler_append(php_output_handler *handler, php_output_buffer *buf)
  * Appends input to the output handlers buffer and indicates whether the buffer does not have to be processed by the output handler */
-static inline bool php_output_handler_append(php_output_handler *handler, const php_output_buffer *buf)
+static inline bool php_output_handler_append(php_output_handler *handler, php_output_buffer *buf)
 {
 	if (buf->used) {
 		OG(flags) |= PHP_OUTPUT_WRITTEN;
-		/* store it away */
-		if ((handler->buffer.size - handler->buffer.used) <= buf->used) {
-			size_t grow_int = PHP_OUTPUT_HANDLER_INITBUF_SIZE(handler->size);
-			size_t grow_buf = PHP_OUTPUT_HANDLER_INITBUF_SIZE(buf->used - (handler->buffer.size - handler->buffer.used));
-			size_t grow_max = MAX(grow_int, grow_buf);
-
-			handler->buffer.data = safe_erealloc(handler->buffer.data, 1, handler->buffer.size, grow_max);
-			handler->buffer.size += grow_max;
+		if (!handler->buffer.used && buf->free && buf->used >= handler->buffer.size) {
+			/* Between chained handlers the producing handler's output is heap
+			 * data owned by the context; adopt it as this handler's storage
+			 * instead of copying it over */
+			if (handler->buffer.persistent) {
+				php_output_buffer_release(&handler->buffer);
+			} else {
+				efree(handler->buffer.data);
+			}
+			handler->buffer.data = buf->data;
+			handler->buffer.used = buf->used;
+			handler->buffer.size = MAX(buf->size, buf->used);
+			handler->buffer.persistent = 0;
+			buf->data = NULL;
+			buf->used = 0;
+			buf->size = 0;
+			buf->free = 0;
+		} else {
+			/* store it away */
+			if ((handler->buffer.size - handler->buffer.used) <= buf->used) {
+				size_t grow_int = PHP_OUTPUT_HANDLER_INITBUF_SIZE(handler->size);
+				size_t grow_buf = PHP_OUTPUT_HANDLER_INITBUF_SIZE(buf->used - (handler->buffer.size - handler->buffer.used));
+				size_t grow_max = MAX(grow_int, grow_buf);
+
+				if (handler->buffer.persistent) {
+					handler->buffer.data = safe_perealloc(handler->buffer.data, 1, handler->buffer.size, grow_max, 1);
+				} else {
+					handler->buffer.data = safe_erealloc(handler->buffer.data, 1, handler->buffer.size, grow_max);
+				}
+				handler->buffer.size += grow_max;
+			}
+			memcpy(handler->buffer.data + handler->buffer.used, buf->data, buf->used);
+			handler->buffer.used += buf->used;
+		}
+		if (handler->buffer.used > OG(high_water)) {
+			OG(high_water) = handler->buffer.used;
 		}
-		memcpy(handler->buffer.data + handler->buffer.used, buf->data, buf->used);
-		handler->buffer.used += buf->used;
 
 		/* chunked buffering */
 		if (handler->size && (handler->buffer.used >= handler->size)) {
@@ -1001,12 +1146,21 @@ static inline php_output_handler_status_t php_output_handler_op(php_output_handl
 				efree(context->out.data);
 			}
 			/* returns handlers buffer */
-			context->out.data = handler->buffer.data;
-			context->out.used = handler->buffer.used;
-			context->out.free = 1;
-			handler->buffer.data = NULL;
-			handler->buffer.used = 0;
-			handler->buffer.size = 0;
+			if (handler->buffer.persistent) {
+				/* the recycled buffer must not travel through the context,
+				 * which frees its data with efree() */
+				context->out.data = estrndup(handler->buffer.data, handler->buffer.used);
+				context->out.used = handler->buffer.used;
+				context->out.free = 1;
+				php_output_buffer_release(&handler->buffer);
+			} else {
+				context->out.data = handler->buffer.data;
+				context->out.used = handler->buffer.used;
+				context->out.free = 1;
+				handler->buffer.data = NULL;
+				handler->buffer.used = 0;
+				handler->buffer.size = 0;
+			}
 			break;
 		case PHP_OUTPUT_HANDLER_NO_DATA:
 			/* handler ate all */
@@ -33,6 +33,12 @@ SAPI_API SAPI_POST_READER_FUNC(php_default_post_reader)
 {
 	if (!strcmp(SG(request_info).request_method, "POST")) {
 		if (NULL == SG(request_info).post_entry) {
+			if (PG(post_data_deferred_reading)) {
+				/* Leave the body on the SAPI; php://input pulls it block by
+				 * block on demand, teeing only what was actually read into
+				 * the request_body temp stream for later re-reads. */
+				return;
+			}
 			/* no post handler registered, so we just swallow the data */
 			sapi_read_standard_form_data();
 		}
@@ -133,6 +133,7 @@ struct _php_core_globals {
 	bool during_request_startup;
 	bool allow_url_fopen;
 	bool enable_post_data_reading;
+	bool post_data_deferred_reading;
 	bool report_zend_debug;
 
 	int last_error_type;
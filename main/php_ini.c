@@ -25,6 +25,7 @@
 #include "SAPI.h"
 #include "php_main.h"
 #include "php_scandir.h"
+#include "zend_smart_str.h"
 #ifdef PHP_WIN32
 #include "win32/php_registry.h"
 #include "win32/winutil.h"
@@ -310,6 +311,503 @@ static void php_ini_parser_cb(zval *arg1, zval *arg2, zval *arg3, int callback_t
 }
 /* }}} */
 
+/* {{{ Binary configuration cache
+
+   When the PHP_INI_CACHE environment variable names a file, the fully parsed
+   configuration (configuration_hash, the deferred extension load lists and
+   the scanned-file bookkeeping) is stored there as a compact binary blob and
+   restored on subsequent starts, skipping the ini parser entirely. This is
+   aimed at short-lived CLI jobs, where re-parsing php.ini plus a populated
+   scan directory on every start is pure overhead.
+
+   The cache is validated before use: it records the PHP version, SAPI name,
+   resolved php.ini path, scan path, and the mtime/size of every parsed file
+   as well as the mtime of every scanned directory (so adding or removing an
+   .ini file invalidates it). Any mismatch or structural damage falls back
+   silently to the normal parse, which then rewrites the cache. SAPI-provided
+   ini entries (e.g. command line -d) are applied after restore, exactly as
+   they are applied after parsing. */
+
+typedef struct _php_ini_cache_file {
+	uint8_t  is_dir;
+	uint64_t mtime;
+	uint64_t size;
+	char     path[MAXPATHLEN];
+} php_ini_cache_file;
+
+typedef struct _php_ini_cache_reader {
+	const unsigned char *p;
+	const unsigned char *end;
+	bool ok;
+} php_ini_cache_reader;
+
+#define PHP_INI_CACHE_MAGIC   "PHPINICH"
+#define PHP_INI_CACHE_VERSION 1
+
+/* marker for an absent (NULL) string */
+#define PHP_INI_CACHE_NO_STR  UINT32_MAX
+
+static void ini_cache_put_u8(smart_str *buf, uint8_t v)
+{
+	smart_str_appendl(buf, (const char *) &v, sizeof(v));
+}
+
+static void ini_cache_put_u32(smart_str *buf, uint32_t v)
+{
+	smart_str_appendl(buf, (const char *) &v, sizeof(v));
+}
+
+static void ini_cache_put_u64(smart_str *buf, uint64_t v)
+{
+	smart_str_appendl(buf, (const char *) &v, sizeof(v));
+}
+
+static void ini_cache_put_str(smart_str *buf, const char *s, size_t len)
+{
+	if (!s) {
+		ini_cache_put_u32(buf, PHP_INI_CACHE_NO_STR);
+	} else {
+		ini_cache_put_u32(buf, (uint32_t) len);
+		smart_str_appendl(buf, s, len);
+	}
+}
+
+static uint8_t ini_cache_get_u8(php_ini_cache_reader *r)
+{
+	uint8_t v;
+
+	if ((size_t) (r->end - r->p) < sizeof(v)) {
+		r->ok = false;
+		return 0;
+	}
+	memcpy(&v, r->p, sizeof(v));
+	r->p += sizeof(v);
+	return v;
+}
+
+static uint32_t ini_cache_get_u32(php_ini_cache_reader *r)
+{
+	uint32_t v;
+
+	if ((size_t) (r->end - r->p) < sizeof(v)) {
+		r->ok = false;
+		return 0;
+	}
+	memcpy(&v, r->p, sizeof(v));
+	r->p += sizeof(v);
+	return v;
+}
+
+static uint64_t ini_cache_get_u64(php_ini_cache_reader *r)
+{
+	uint64_t v;
+
+	if ((size_t) (r->end - r->p) < sizeof(v)) {
+		r->ok = false;
+		return 0;
+	}
+	memcpy(&v, r->p, sizeof(v));
+	r->p += sizeof(v);
+	return v;
+}
+
+/* Returns a pointer into the blob (not NUL terminated), NULL for an absent
+ * string. Absence and truncation are told apart through r->ok. */
+static const char *ini_cache_get_str(php_ini_cache_reader *r, uint32_t *len)
+{
+	const char *s;
+
+	*len = ini_cache_get_u32(r);
+	if (!r->ok || *len == PHP_INI_CACHE_NO_STR) {
+		*len = 0;
+		return NULL;
+	}
+	if ((size_t) (r->end - r->p) < *len) {
+		r->ok = false;
+		*len = 0;
+		return NULL;
+	}
+	s = (const char *) r->p;
+	r->p += *len;
+	return s;
+}
+
+static void ini_cache_put_zval(smart_str *buf, zval *zv);
+
+static void ini_cache_put_ht(smart_str *buf, HashTable *ht)
+{
+	zend_string *key;
+	zend_ulong idx;
+	zval *val;
+
+	ini_cache_put_u32(buf, zend_hash_num_elements(ht));
+	ZEND_HASH_FOREACH_KEY_VAL(ht, idx, key, val) {
+		if (key) {
+			ini_cache_put_u8(buf, 'k');
+			ini_cache_put_str(buf, ZSTR_VAL(key), ZSTR_LEN(key));
+		} else {
+			ini_cache_put_u8(buf, 'i');
+			ini_cache_put_u64(buf, idx);
+		}
+		ini_cache_put_zval(buf, val);
+	} ZEND_HASH_FOREACH_END();
+}
+
+static void ini_cache_put_zval(smart_str *buf, zval *zv)
+{
+	if (Z_TYPE_P(zv) == IS_ARRAY) {
+		ini_cache_put_u8(buf, 'A');
+		ini_cache_put_ht(buf, Z_ARRVAL_P(zv));
+	} else {
+		ZEND_ASSERT(Z_TYPE_P(zv) == IS_STRING);
+		ini_cache_put_u8(buf, 'S');
+		ini_cache_put_str(buf, Z_STRVAL_P(zv), Z_STRLEN_P(zv));
+	}
+}
+
+static bool ini_cache_read_zval(php_ini_cache_reader *r, zval *out);
+
+/* Reads entries into target; a NULL target validates the structure without
+ * applying it (used for a dry run before touching configuration_hash). */
+static bool ini_cache_read_ht(php_ini_cache_reader *r, HashTable *target)
+{
+	uint32_t count = ini_cache_get_u32(r);
+
+	while (r->ok && count--) {
+		uint8_t kind = ini_cache_get_u8(r);
+		const char *key = NULL;
+		uint32_t key_len = 0;
+		uint64_t idx = 0;
+		zval val;
+
+		if (kind == 'k') {
+			key = ini_cache_get_str(r, &key_len);
+			if (!key) {
+				r->ok = false;
+			}
+		} else if (kind == 'i') {
+			idx = ini_cache_get_u64(r);
+		} else {
+			r->ok = false;
+		}
+		if (!r->ok || !ini_cache_read_zval(r, target ? &val : NULL)) {
+			break;
+		}
+		if (target) {
+			if (key) {
+				zend_hash_str_update(target, key, key_len, &val);
+			} else {
+				zend_hash_index_update(target, (zend_ulong) idx, &val);
+			}
+		}
+	}
+	return r->ok;
+}
+
+static bool ini_cache_read_zval(php_ini_cache_reader *r, zval *out)
+{
+	uint8_t type = ini_cache_get_u8(r);
+
+	if (type == 'S') {
+		uint32_t len;
+		const char *s = ini_cache_get_str(r, &len);
+
+		if (!s) {
+			r->ok = false;
+			return false;
+		}
+		if (out) {
+			ZVAL_STR(out, zend_string_init(s, len, 1));
+		}
+	} else if (type == 'A') {
+		if (out) {
+			ZVAL_NEW_PERSISTENT_ARR(out);
+			zend_hash_init(Z_ARRVAL_P(out), 8, NULL, config_zval_dtor, 1);
+			if (!ini_cache_read_ht(r, Z_ARRVAL_P(out))) {
+				config_zval_dtor(out);
+				return false;
+			}
+		} else {
+			return ini_cache_read_ht(r, NULL);
+		}
+	} else {
+		r->ok = false;
+	}
+	return r->ok;
+}
+
+/* The scan path the current start would use; recomputed on both the store
+ * and the load side so that a changed PHP_INI_SCAN_DIR invalidates. */
+static const char *php_ini_cache_scan_path(void)
+{
+	const char *path;
+
+	if (sapi_module.php_ini_ignore) {
+		return "";
+	}
+	path = getenv("PHP_INI_SCAN_DIR");
+	if (!path) {
+		path = PHP_CONFIG_FILE_SCAN_DIR;
+	}
+	return path;
+}
+
+static void php_ini_cache_record_file(zend_llist *files, const char *path, uint8_t is_dir)
+{
+	php_ini_cache_file rec;
+	zend_stat_t sb = {0};
+	size_t len = strlen(path);
+
+	if (len >= sizeof(rec.path)) {
+		return;
+	}
+	memset(&rec, 0, sizeof(rec));
+	rec.is_dir = is_dir;
+	if (VCWD_STAT(path, &sb) == 0) {
+		rec.mtime = (uint64_t) sb.st_mtime;
+		rec.size = is_dir ? 0 : (uint64_t) sb.st_size;
+	}
+	memcpy(rec.path, path, len + 1);
+	zend_llist_add_element(files, &rec);
+}
+
+static bool ini_cache_str_matches(const char *s, uint32_t len, const char *expected)
+{
+	if (!s) {
+		return expected == NULL;
+	}
+	return expected && strlen(expected) == len && memcmp(s, expected, len) == 0;
+}
+
+static void ini_cache_read_payload(php_ini_cache_reader *r, bool apply)
+{
+	uint32_t count, len;
+	const char *s;
+	uint8_t per_dir, per_host;
+
+	if (!ini_cache_read_ht(r, apply ? &configuration_hash : NULL)) {
+		return;
+	}
+
+	count = ini_cache_get_u32(r);
+	while (r->ok && count--) {
+		s = ini_cache_get_str(r, &len);
+		if (!s) {
+			r->ok = false;
+			break;
+		}
+		if (apply) {
+			char *name = estrndup(s, len);
+			zend_llist_add_element(&extension_lists.engine, &name);
+		}
+	}
+	count = ini_cache_get_u32(r);
+	while (r->ok && count--) {
+		s = ini_cache_get_str(r, &len);
+		if (!s) {
+			r->ok = false;
+			break;
+		}
+		if (apply) {
+			char *name = estrndup(s, len);
+			zend_llist_add_element(&extension_lists.functions, &name);
+		}
+	}
+
+	per_dir = ini_cache_get_u8(r);
+	per_host = ini_cache_get_u8(r);
+	if (r->ok && apply) {
+		has_per_dir_config = per_dir;
+		has_per_host_config = per_host;
+	}
+
+	s = ini_cache_get_str(r, &len);
+	if (r->ok && s && apply) {
+		php_ini_opened_path = zend_strndup(s, len);
+	}
+	s = ini_cache_get_str(r, &len);
+	if (r->ok && s && apply) {
+		php_ini_scanned_files = (char *) malloc(len + 1);
+		memcpy(php_ini_scanned_files, s, len);
+		php_ini_scanned_files[len] = '\0';
+	}
+}
+
+static bool php_ini_cache_load(const char *cache_path, const char *main_ini_path)
+{
+	php_ini_cache_reader r;
+	unsigned char *blob;
+	size_t blob_len;
+	uint32_t count, len;
+	const char *s;
+	zend_stat_t sb = {0};
+	FILE *fp;
+
+	fp = VCWD_FOPEN(cache_path, "rb");
+	if (!fp) {
+		return false;
+	}
+	if (zend_fstat(fileno(fp), &sb) != 0 || !S_ISREG(sb.st_mode) ||
+			sb.st_size <= 0 || sb.st_size > 64 * 1024 * 1024) {
+		fclose(fp);
+		return false;
+	}
+	blob_len = (size_t) sb.st_size;
+	blob = emalloc(blob_len);
+	if (fread(blob, 1, blob_len, fp) != blob_len) {
+		fclose(fp);
+		efree(blob);
+		return false;
+	}
+	fclose(fp);
+
+	r.p = blob;
+	r.end = blob + blob_len;
+	r.ok = true;
+
+	/* header */
+	if (blob_len < sizeof(PHP_INI_CACHE_MAGIC) - 1 ||
+			memcmp(blob, PHP_INI_CACHE_MAGIC, sizeof(PHP_INI_CACHE_MAGIC) - 1) != 0) {
+		efree(blob);
+		return false;
+	}
+	r.p += sizeof(PHP_INI_CACHE_MAGIC) - 1;
+	if (ini_cache_get_u32(&r) != PHP_INI_CACHE_VERSION ||
+			ini_cache_get_u32(&r) != PHP_VERSION_ID) {
+		efree(blob);
+		return false;
+	}
+	s = ini_cache_get_str(&r, &len);
+	if (!r.ok || !ini_cache_str_matches(s, len, sapi_module.name)) {
+		efree(blob);
+		return false;
+	}
+	s = ini_cache_get_str(&r, &len);
+	if (!r.ok || !ini_cache_str_matches(s, len, php_ini_cache_scan_path())) {
+		efree(blob);
+		return false;
+	}
+	s = ini_cache_get_str(&r, &len);
+	if (!r.ok || !ini_cache_str_matches(s, len, main_ini_path)) {
+		efree(blob);
+		return false;
+	}
+
+	/* recorded files and scan directories */
+	count = ini_cache_get_u32(&r);
+	while (r.ok && count--) {
+		uint8_t is_dir = ini_cache_get_u8(&r);
+		uint64_t mtime, size, cur_mtime = 0, cur_size = 0;
+		char pathbuf[MAXPATHLEN];
+
+		s = ini_cache_get_str(&r, &len);
+		mtime = ini_cache_get_u64(&r);
+		size = ini_cache_get_u64(&r);
+		if (!r.ok || !s || len >= sizeof(pathbuf)) {
+			efree(blob);
+			return false;
+		}
+		memcpy(pathbuf, s, len);
+		pathbuf[len] = '\0';
+		if (VCWD_STAT(pathbuf, &sb) == 0) {
+			cur_mtime = (uint64_t) sb.st_mtime;
+			cur_size = is_dir ? 0 : (uint64_t) sb.st_size;
+		}
+		if (cur_mtime != mtime || cur_size != size) {
+			efree(blob);
+			return false;
+		}
+	}
+
+	/* dry run first so a damaged payload cannot leave a half-restored
+	 * configuration_hash behind */
+	{
+		php_ini_cache_reader probe = r;
+
+		ini_cache_read_payload(&probe, false);
+		if (!probe.ok || probe.p != probe.end) {
+			efree(blob);
+			return false;
+		}
+	}
+	ini_cache_read_payload(&r, true);
+
+	efree(blob);
+	return true;
+}
+
+static void php_ini_cache_store(const char *cache_path, zend_llist *files)
+{
+	smart_str buf = {0};
+	zend_llist_element *element;
+	char tmp_path[MAXPATHLEN];
+	FILE *fp;
+	bool ok;
+
+	smart_str_appendl(&buf, PHP_INI_CACHE_MAGIC, sizeof(PHP_INI_CACHE_MAGIC) - 1);
+	ini_cache_put_u32(&buf, PHP_INI_CACHE_VERSION);
+	ini_cache_put_u32(&buf, PHP_VERSION_ID);
+	ini_cache_put_str(&buf, sapi_module.name, strlen(sapi_module.name));
+	{
+		const char *scan_path = php_ini_cache_scan_path();
+		ini_cache_put_str(&buf, scan_path, strlen(scan_path));
+	}
+	ini_cache_put_str(&buf, php_ini_opened_path,
+			php_ini_opened_path ? strlen(php_ini_opened_path) : 0);
+
+	ini_cache_put_u32(&buf, zend_llist_count(files));
+	for (element = files->head; element; element = element->next) {
+		php_ini_cache_file *rec = (php_ini_cache_file *) element->data;
+
+		ini_cache_put_u8(&buf, rec->is_dir);
+		ini_cache_put_str(&buf, rec->path, strlen(rec->path));
+		ini_cache_put_u64(&buf, rec->mtime);
+		ini_cache_put_u64(&buf, rec->size);
+	}
+
+	ini_cache_put_ht(&buf, &configuration_hash);
+	ini_cache_put_u32(&buf, zend_llist_count(&extension_lists.engine));
+	for (element = extension_lists.engine.head; element; element = element->next) {
+		char *name = *(char **) element->data;
+		ini_cache_put_str(&buf, name, strlen(name));
+	}
+	ini_cache_put_u32(&buf, zend_llist_count(&extension_lists.functions));
+	for (element = extension_lists.functions.head; element; element = element->next) {
+		char *name = *(char **) element->data;
+		ini_cache_put_str(&buf, name, strlen(name));
+	}
+	ini_cache_put_u8(&buf, has_per_dir_config);
+	ini_cache_put_u8(&buf, has_per_host_config);
+	ini_cache_put_str(&buf, php_ini_opened_path,
+			php_ini_opened_path ? strlen(php_ini_opened_path) : 0);
+	ini_cache_put_str(&buf, php_ini_scanned_files,
+			php_ini_scanned_files ? strlen(php_ini_scanned_files) : 0);
+
+	/* write to a private temp file, publish with an atomic rename */
+	if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.%lu", cache_path,
+#ifdef PHP_WIN32
+			(unsigned long) GetCurrentProcessId()
+#else
+			(unsigned long) getpid()
+#endif
+			) >= (int) sizeof(tmp_path)) {
+		smart_str_free(&buf);
+		return;
+	}
+	fp = VCWD_FOPEN(tmp_path, "wb");
+	if (!fp) {
+		smart_str_free(&buf);
+		return;
+	}
+	ok = fwrite(ZSTR_VAL(buf.s), 1, ZSTR_LEN(buf.s), fp) == ZSTR_LEN(buf.s);
+	ok = !fclose(fp) && ok;
+	if (!ok || VCWD_RENAME(tmp_path, cache_path) != 0) {
+		VCWD_UNLINK(tmp_path);
+	}
+	smart_str_free(&buf);
+}
+/* }}} */
+
 /* {{{ php_load_php_extension_cb */
 static void php_load_php_extension_cb(void *arg)
 {
@@ -415,6 +913,11 @@ int php_init_config(void)
 	char *open_basedir;
 	int free_ini_search_path = 0;
 	zend_string *opened_path = NULL;
+	const char *ini_cache_path = getenv("PHP_INI_CACHE");
+	bool ini_cache_hit = false;
+	zend_llist ini_cache_files;
+
+	zend_llist_init(&ini_cache_files, sizeof(php_ini_cache_file), NULL, 1);
 
 	zend_hash_init(&configuration_hash, 8, NULL, config_zval_dtor, 1);
 
@@ -596,6 +1099,22 @@ int php_init_config(void)
 
 	PG(open_basedir) = open_basedir;
 
+	/* Try the binary configuration cache before running the parser. On a hit
+	 * everything below up to the SAPI-provided entries is restored from it. */
+	if (ini_cache_path) {
+		ini_cache_hit = php_ini_cache_load(ini_cache_path, filename);
+		if (ini_cache_hit && fp) {
+			fclose(fp);
+			if (opened_path) {
+				zend_string_release_ex(opened_path, 0);
+			}
+			if (free_filename) {
+				efree(filename);
+			}
+			fp = NULL;
+		}
+	}
+
 	if (fp) {
 		zend_file_handle fh;
 		zend_stream_init_fp(&fh, fp, filename);
@@ -603,6 +1122,10 @@ int php_init_config(void)
 
 		zend_parse_ini_file(&fh, 1, ZEND_INI_SCANNER_NORMAL, (zend_ini_parser_cb_t) php_ini_parser_cb, &configuration_hash);
 
+		if (ini_cache_path) {
+			php_ini_cache_record_file(&ini_cache_files, filename, 0);
+		}
+
 		{
 			zval tmp;
 
@@ -629,7 +1152,7 @@ int php_init_config(void)
 	php_ini_scanned_path_len = (int)strlen(php_ini_scanned_path);
 
 	/* Scan and parse any .ini files found in scan path if path not empty. */
-	if (!sapi_module.php_ini_ignore && php_ini_scanned_path_len) {
+	if (!ini_cache_hit && !sapi_module.php_ini_ignore && php_ini_scanned_path_len) {
 		struct dirent **namelist;
 		int ndir, i;
 		zend_stat_t sb = {0};
@@ -656,6 +1179,10 @@ int php_init_config(void)
 			}
 			lenpath = (int)strlen(debpath);
 
+			if (ini_cache_path && lenpath > 0) {
+				php_ini_cache_record_file(&ini_cache_files, debpath, 1);
+			}
+
 			if (lenpath > 0 && (ndir = php_scandir(debpath, &namelist, 0, php_alphasort)) > 0) {
 
 				for (i = 0; i < ndir; i++) {
@@ -685,6 +1212,9 @@ int php_init_config(void)
 									total_l += l + 2;
 									p = estrndup(ini_file, l);
 									zend_llist_add_element(&scanned_ini_list, &p);
+									if (ini_cache_path) {
+										php_ini_cache_record_file(&ini_cache_files, ini_file, 0);
+									}
 								}
 								zend_destroy_file_handle(&fh);
 							}
@@ -713,11 +1243,18 @@ int php_init_config(void)
 			}
 		}
 		zend_llist_destroy(&scanned_ini_list);
-	} else {
+	} else if (sapi_module.php_ini_ignore || !php_ini_scanned_path_len) {
 		/* Make sure an empty php_ini_scanned_path ends up as NULL */
 		php_ini_scanned_path = NULL;
 	}
 
+	/* Snapshot the file-derived configuration before SAPI-provided entries
+	 * (which may change from run to run) are merged on top. */
+	if (ini_cache_path && !ini_cache_hit) {
+		php_ini_cache_store(ini_cache_path, &ini_cache_files);
+	}
+	zend_llist_destroy(&ini_cache_files);
+
 	if (sapi_module.ini_entries) {
 		/* Reset active ini section */
 		RESET_ACTIVE_INI_HASH();
@@ -804,7 +1341,19 @@ PHPAPI void php_ini_activate_config(HashTable *source_hash, int modify_type, int
 
 	/* Walk through config hash and alter matching ini entries using the values found in the hash */
 	ZEND_HASH_MAP_FOREACH_STR_KEY_VAL(source_hash, str, data) {
-		zend_string *data_str = zend_string_dup(Z_STR_P(data), 0);
+		zend_ini_entry *ini_entry;
+		zend_string *data_str;
+
+		/* Per-dir and user configs are re-applied on every request; skip the
+		 * dup + modify + restore cycle for entries that already have the
+		 * target value (an unchanged entry needs no restore either) */
+		ini_entry = zend_hash_find_ptr(EG(ini_directives), str);
+		if (ini_entry && ini_entry->value
+		 && zend_string_equals(ini_entry->value, Z_STR_P(data))) {
+			continue;
+		}
+
+		data_str = zend_string_dup(Z_STR_P(data), 0);
 		zend_alter_ini_entry_ex(str, data_str, modify_type, stage, 0);
 		zend_string_release(data_str);
 	} ZEND_HASH_FOREACH_END();
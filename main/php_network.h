@@ -166,6 +166,27 @@ static inline int php_tvtoto(struct timeval *timeouttv)
 	return -1;
 }
 
+/* Fiber-aware wait hook for single-descriptor stream waits.
+ *
+ * When set (typically by an event-loop extension), every blocking
+ * single-descriptor wait issued through php_pollfd_for()/php_pollfd_for_ms()
+ * while a fiber is running is first offered to the hook, so the provider can
+ * suspend the current fiber and resume it once the descriptor is ready
+ * instead of blocking the whole thread.  The hook must return a poll(2)-style
+ * event mask (> 0), 0 on timeout, -1 on error, or
+ * PHP_FD_WAIT_NOT_HANDLED to fall through to the regular poll. */
+#define PHP_FD_WAIT_NOT_HANDLED (-2)
+typedef int (*php_fd_wait_func_t)(php_socket_t fd, int events, int timeout_ms);
+extern PHPAPI php_fd_wait_func_t php_fiber_fd_wait_hook;
+
+static inline int php_fiber_fd_wait(php_socket_t fd, int events, int timeout_ms)
+{
+	if (UNEXPECTED(php_fiber_fd_wait_hook != NULL) && EG(active_fiber)) {
+		return php_fiber_fd_wait_hook(fd, events, timeout_ms);
+	}
+	return PHP_FD_WAIT_NOT_HANDLED;
+}
+
 /* hybrid select(2)/poll(2) for a single descriptor.
  * timeouttv follows same rules as select(2), but is reduced to millisecond accuracy.
  * Returns 0 on timeout, -1 on error, or the event mask (ala poll(2)).
@@ -175,6 +196,11 @@ static inline int php_pollfd_for(php_socket_t fd, int events, struct timeval *ti
 	php_pollfd p;
 	int n;
 
+	n = php_fiber_fd_wait(fd, events, php_tvtoto(timeouttv));
+	if (n != PHP_FD_WAIT_NOT_HANDLED) {
+		return n;
+	}
+
 	p.fd = fd;
 	p.events = events;
 	p.revents = 0;
@@ -193,6 +219,11 @@ static inline int php_pollfd_for_ms(php_socket_t fd, int events, int timeout)
 	php_pollfd p;
 	int n;
 
+	n = php_fiber_fd_wait(fd, events, timeout);
+	if (n != PHP_FD_WAIT_NOT_HANDLED) {
+		return n;
+	}
+
 	p.fd = fd;
 	p.events = events;
 	p.revents = 0;
@@ -260,6 +291,9 @@ typedef struct {
 #endif
 
 BEGIN_EXTERN_C()
+PHPAPI void php_network_startup(void);
+PHPAPI void php_network_shutdown(void);
+
 PHPAPI int php_network_getaddresses(const char *host, int socktype, struct sockaddr ***sal, zend_string **error_string);
 PHPAPI void php_network_freeaddresses(struct sockaddr **sal);
 
@@ -84,7 +84,7 @@
  * SUCH DAMAGE.
  */
 
-static int php_do_open_temporary_file(const char *path, const char *pfx, zend_string **opened_path_p)
+static int php_do_open_temporary_file(const char *path, const char *pfx, zend_string **opened_path_p, uint32_t flags)
 {
 #ifdef PHP_WIN32
 	char *opened_path = NULL;
@@ -128,6 +128,19 @@ static int php_do_open_temporary_file(const char *path, const char *pfx, zend_st
 		return -1;
 	}
 
+#if defined(O_TMPFILE) && !defined(PHP_WIN32)
+	if (flags & PHP_TMP_FILE_ANONYMOUS) {
+		/* An unnamed file needs no name generation and no unlink later on.
+		 * Not every filesystem supports it, so fall through to a regular
+		 * named file when the open fails. */
+		fd = open(new_state.cwd, O_TMPFILE | O_RDWR, 0600);
+		if (fd != -1) {
+			efree(new_state.cwd);
+			return fd;
+		}
+	}
+#endif
+
 #ifndef PHP_WIN32
 	if (IS_SLASH(new_state.cwd[new_state.cwd_length - 1])) {
 		trailing_slash = "";
@@ -302,7 +315,7 @@ def_tmp:
 		if (temp_dir &&
 		    *temp_dir != '\0' &&
 		    (!(flags & PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_FALLBACK) || !php_check_open_basedir(temp_dir))) {
-			return php_do_open_temporary_file(temp_dir, pfx, opened_path_p);
+			return php_do_open_temporary_file(temp_dir, pfx, opened_path_p, flags);
 		} else {
 			return -1;
 		}
@@ -313,7 +326,7 @@ def_tmp:
 	}
 
 	/* Try the directory given as parameter. */
-	fd = php_do_open_temporary_file(dir, pfx, opened_path_p);
+	fd = php_do_open_temporary_file(dir, pfx, opened_path_p, flags);
 	if (fd == -1) {
 		/* Use default temporary directory. */
 		if (!(flags & PHP_TMP_FILE_SILENT)) {
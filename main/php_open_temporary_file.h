@@ -21,6 +21,10 @@
 #define PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_FALLBACK (1<<0)
 #define PHP_TMP_FILE_SILENT (1<<1)
 #define PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_EXPLICIT_DIR (1<<2)
+/* Prefer an unnamed file (O_TMPFILE); when the kernel or filesystem cannot
+ * provide one, a regular named temporary file is created instead and its
+ * path is reported through opened_path_p as usual. */
+#define PHP_TMP_FILE_ANONYMOUS (1<<3)
 #define PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ALWAYS \
     (PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_FALLBACK | PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_EXPLICIT_DIR)
 
@@ -93,7 +93,8 @@ typedef struct _php_output_buffer {
 	size_t size;
 	size_t used;
 	uint32_t free:1;
-	uint32_t _reserved:31;
+	uint32_t persistent:1; /* recycled across requests, not on the Zend heap */
+	uint32_t _reserved:30;
 } php_output_buffer;
 
 typedef struct _php_output_context {
@@ -142,6 +143,10 @@ ZEND_BEGIN_MODULE_GLOBALS(output)
 	zend_string *output_start_filename;
 	int output_start_lineno;
 	int flags;
+	/* recycled handler buffer; survives php_output_activate()/deactivate() */
+	char *spare_data;
+	size_t spare_size;
+	size_t high_water;
 ZEND_END_MODULE_GLOBALS(output)
 
 PHPAPI ZEND_EXTERN_MODULE_GLOBALS(output)
@@ -202,6 +207,9 @@ PHPAPI int php_output_get_start_lineno(void);
 PHPAPI size_t php_output_write_unbuffered(const char *str, size_t len);
 PHPAPI size_t php_output_write(const char *str, size_t len);
 
+PHPAPI char *php_output_reserve(size_t len);
+PHPAPI void php_output_commit(size_t len);
+
 PHPAPI zend_result php_output_flush(void);
 PHPAPI void php_output_flush_all(void);
 PHPAPI zend_result php_output_clean(void);
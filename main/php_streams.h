@@ -243,6 +243,10 @@ struct _php_stream  {
 	/* how much data to read when filling buffer */
 	size_t chunk_size;
 
+	/* adaptive read-ahead: effective fill size for buffered reads, grown
+	 * while the buffer keeps being drained sequentially, reset on seeks */
+	size_t readahead_size;
+
 #if ZEND_DEBUG
 	const char *open_filename;
 	uint32_t open_lineno;
@@ -587,6 +591,7 @@ END_EXTERN_C()
 int php_init_stream_wrappers(int module_number);
 void php_shutdown_stream_wrappers(int module_number);
 void php_shutdown_stream_hashes(void);
+PHPAPI void php_stream_plain_dirfd_cache_clear(void);
 PHP_RSHUTDOWN_FUNCTION(streams);
 
 BEGIN_EXTERN_C()
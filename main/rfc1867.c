@@ -51,6 +51,7 @@ static php_rfc1867_getword_conf_t php_rfc1867_getword_conf = php_ap_getword_conf
 static php_rfc1867_basename_t php_rfc1867_basename = NULL;
 
 PHPAPI zend_result (*php_rfc1867_callback)(unsigned int event, void *event_data, void **extra) = NULL;
+PHPAPI int (*php_rfc1867_open_destination)(const char *param, const char *filename, zend_string **dest_path) = NULL;
 
 static void safe_php_register_variable(char *var, char *strval, size_t val_len, zval *track_vars_array, bool override_protection);
 
@@ -181,6 +182,9 @@ PHPAPI void destroy_uploaded_files_hash(void) /* {{{ */
 /* {{{ Following code is based on apache_multipart_buffer.c from libapreq-0.33 package. */
 
 #define FILLUNIT (1024 * 5)
+/* Size of the multipart read buffer. File parts are written out straight
+ * from this buffer, so it also bounds the write() granularity. */
+#define MULTIPART_BUFSIZE (1024 * 64)
 
 typedef struct {
 
@@ -256,7 +260,7 @@ static multipart_buffer *multipart_buffer_new(char *boundary, int boundary_len)
 	multipart_buffer *self = (multipart_buffer *) ecalloc(1, sizeof(multipart_buffer));
 
 	int minsize = boundary_len + 6;
-	if (minsize < FILLUNIT) minsize = FILLUNIT;
+	if (minsize < MULTIPART_BUFSIZE) minsize = MULTIPART_BUFSIZE;
 
 	self->buffer = (char *) ecalloc(1, minsize + 1);
 	self->bufsize = minsize;
@@ -578,7 +582,7 @@ static void *php_ap_memstr(char *haystack, int haystacklen, char *needle, int ne
 /* read until a boundary condition */
 static size_t multipart_buffer_read(multipart_buffer *self, char *buf, size_t bytes, int *end)
 {
-	size_t len, max;
+	size_t len, max, scan;
 	char *bound;
 
 	/* fill buffer if needed */
@@ -586,14 +590,22 @@ static size_t multipart_buffer_read(multipart_buffer *self, char *buf, size_t by
 		fill_buffer(self);
 	}
 
+	/* only scan as far as this call can consume, plus enough slack to see a
+	 * boundary straddling the end of the copied range; anything beyond that
+	 * is re-scanned by the next call anyway */
+	scan = self->bytes_in_buffer;
+	if (scan > bytes + (size_t)self->boundary_next_len) {
+		scan = bytes + (size_t)self->boundary_next_len;
+	}
+
 	/* look for a potential boundary match, only read data up to that point */
-	if ((bound = php_ap_memstr(self->buf_begin, self->bytes_in_buffer, self->boundary_next, self->boundary_next_len, 1))) {
+	if ((bound = php_ap_memstr(self->buf_begin, scan, self->boundary_next, self->boundary_next_len, 1))) {
 		max = bound - self->buf_begin;
-		if (end && php_ap_memstr(self->buf_begin, self->bytes_in_buffer, self->boundary_next, self->boundary_next_len, 0)) {
+		if (end && php_ap_memstr(self->buf_begin, scan, self->boundary_next, self->boundary_next_len, 0)) {
 			*end = 1;
 		}
 	} else {
-		max = self->bytes_in_buffer;
+		max = scan;
 	}
 
 	/* maximum number of bytes we are reading */
@@ -618,6 +630,53 @@ static size_t multipart_buffer_read(multipart_buffer *self, char *buf, size_t by
 	return len;
 }
 
+/* Read until a boundary condition, without copying: hands out a pointer into
+ * the multipart buffer and consumes the data it points at. The pointer stays
+ * valid until the next call refills the buffer, so the chunk must be written
+ * out before reading on. */
+static size_t multipart_buffer_read_ptr(multipart_buffer *self, char **ptr, int *end)
+{
+	size_t len;
+	char *bound;
+
+	if (self->bytes_in_buffer < self->bufsize) {
+		fill_buffer(self);
+	}
+
+	if ((bound = php_ap_memstr(self->buf_begin, self->bytes_in_buffer, self->boundary_next, self->boundary_next_len, 1))) {
+		len = bound - self->buf_begin;
+		if (end && php_ap_memstr(self->buf_begin, self->bytes_in_buffer, self->boundary_next, self->boundary_next_len, 0)) {
+			*end = 1;
+		}
+	} else {
+		len = self->bytes_in_buffer;
+	}
+
+	*ptr = self->buf_begin;
+
+	/* drop a CR belonging to the boundary, like multipart_buffer_read() */
+	if (bound && len > 0 && self->buf_begin[len - 1] == '\r') {
+		len--;
+	}
+
+	self->bytes_in_buffer -= (int)len;
+	self->buf_begin += len;
+
+	return len;
+}
+
+/* Read the next chunk of a file part. Part-data observers may rewrite the
+ * chunk in place, so give them a private copy; without an observer the data
+ * is written straight from the multipart buffer. */
+static size_t multipart_buffer_read_part(multipart_buffer *self, char *buf, size_t bytes, char **ptr, int *end)
+{
+	if (php_rfc1867_callback == NULL) {
+		return multipart_buffer_read_ptr(self, ptr, end);
+	}
+	*ptr = buf;
+	return multipart_buffer_read(self, buf, bytes, end);
+}
+
 /*
   XXX: this is horrible memory-usage-wise, but we only expect
   to do this on small pieces of form data.
@@ -770,7 +829,7 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler)
 	while (!multipart_buffer_eof(mbuff))
 	{
 		char buff[FILLUNIT];
-		char *cd = NULL, *param = NULL, *filename = NULL, *tmp = NULL;
+		char *cd = NULL, *param = NULL, *filename = NULL, *tmp = NULL, *dbuf = NULL;
 		size_t blen = 0, wlen = 0;
 		zend_off_t offset;
 
@@ -988,14 +1047,19 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler)
 
 			if (!cancel_upload) {
 				/* only bother to open temp file if we have data */
-				blen = multipart_buffer_read(mbuff, buff, sizeof(buff), &end);
+				blen = multipart_buffer_read_part(mbuff, buff, sizeof(buff), &dbuf, &end);
 #if DEBUG_FILE_UPLOAD
 				if (blen > 0) {
 #else
 				/* in non-debug mode we have no problem with 0-length files */
 				{
 #endif
-					fd = php_open_temporary_fd_ex(PG(upload_tmp_dir), "php", &temp_filename, PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_FALLBACK);
+					if (php_rfc1867_open_destination != NULL) {
+						fd = php_rfc1867_open_destination(param, filename, &temp_filename);
+					}
+					if (fd == -1) {
+						fd = php_open_temporary_fd_ex(PG(upload_tmp_dir), "php", &temp_filename, PHP_TMP_FILE_OPEN_BASEDIR_CHECK_ON_FALLBACK);
+					}
 					upload_cnt--;
 					if (fd == -1) {
 						EMIT_WARNING_OR_ERROR("File upload error - unable to create a temporary file");
@@ -1011,7 +1075,7 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler)
 
 					event_file_data.post_bytes_processed = SG(read_post_bytes);
 					event_file_data.offset = offset;
-					event_file_data.data = buff;
+					event_file_data.data = dbuf;
 					event_file_data.length = blen;
 					event_file_data.newlength = &blen;
 					if (php_rfc1867_callback(MULTIPART_EVENT_FILE_DATA, &event_file_data, &event_extra_data) == FAILURE) {
@@ -1032,9 +1096,9 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler)
 					cancel_upload = PHP_UPLOAD_ERROR_B;
 				} else if (blen > 0) {
 #ifdef PHP_WIN32
-					wlen = write(fd, buff, (unsigned int)blen);
+					wlen = write(fd, dbuf, (unsigned int)blen);
 #else
-					wlen = write(fd, buff, blen);
+					wlen = write(fd, dbuf, blen);
 #endif
 
 					if (wlen == (size_t)-1) {
@@ -1055,7 +1119,7 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler)
 				}
 
 				/* read data for next iteration */
-				blen = multipart_buffer_read(mbuff, buff, sizeof(buff), &end);
+				blen = multipart_buffer_read_part(mbuff, buff, sizeof(buff), &dbuf, &end);
 			}
 
 			if (fd != -1) { /* may not be initialized if file could not be created */
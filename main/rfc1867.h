@@ -85,6 +85,12 @@ SAPI_API SAPI_POST_HANDLER_FUNC(rfc1867_post_handler);
 PHPAPI void destroy_uploaded_files_hash(void);
 extern PHPAPI zend_result (*php_rfc1867_callback)(unsigned int event, void *event_data, void **extra);
 
+/* Optional hook deciding where a file part is written. Returns an open fd and
+ * sets *dest_path to the path the part is stored under (reported as tmp_name
+ * and unlinked on upload failure), or -1 to fall back to the regular
+ * upload_tmp_dir temporary file. */
+extern PHPAPI int (*php_rfc1867_open_destination)(const char *param, const char *filename, zend_string **dest_path);
+
 SAPI_API void php_rfc1867_set_multibyte_callbacks(
 					php_rfc1867_encoding_translation_t encoding_translation,
 					php_rfc1867_get_detect_order_t get_detect_order,
@@ -53,6 +53,110 @@ extern int php_get_uid_by_name(const char *name, uid_t *uid);
 extern int php_get_gid_by_name(const char *name, gid_t *gid);
 #endif
 
+#if !defined(PHP_WIN32) && defined(O_DIRECTORY) && defined(AT_FDCWD)
+# define PHP_STREAM_DIRFD_CACHE 1
+#endif
+
+#ifdef PHP_STREAM_DIRFD_CACHE
+
+/* Small per-request cache of open directory descriptors.  Repeated opens
+ * under the same directory (an autoloader walking vendor/, templates under
+ * one root) then only resolve the final path component in the kernel through
+ * openat() instead of walking the whole prefix again.  The descriptors are
+ * closed at request shutdown via php_shutdown_stream_hashes(), so a replaced
+ * directory tree is picked up by the next request at the latest; within a
+ * request a cached descriptor pins the directory it was opened in, and any
+ * openat() failure falls back to a full-path open(). */
+#define PHP_STREAM_DIRFD_CACHE_SIZE 8
+
+typedef struct {
+	char     dir[MAXPATHLEN];
+	size_t   dir_len;           /* 0 for unused slots */
+	int      fd;
+	uint64_t stamp;             /* age mark for LRU eviction */
+} php_stream_dirfd_entry;
+
+ZEND_TLS php_stream_dirfd_entry php_stream_dirfd_cache[PHP_STREAM_DIRFD_CACHE_SIZE];
+ZEND_TLS uint64_t php_stream_dirfd_stamp = 0;
+
+static int php_stream_dirfd_open(const char *realpath, int open_flags, mode_t mode)
+{
+	const char *base = strrchr(realpath, '/');
+	php_stream_dirfd_entry *entry, *found = NULL, *victim;
+	size_t dir_len;
+	int i, fd;
+
+	if (!base || base == realpath || base[1] == '\0') {
+		/* file in the root directory, or no prefix worth caching */
+		return open(realpath, open_flags, mode);
+	}
+	dir_len = base - realpath;
+	base++;
+	if (dir_len >= MAXPATHLEN) {
+		return open(realpath, open_flags, mode);
+	}
+
+	victim = php_stream_dirfd_cache;
+	for (i = 0, entry = php_stream_dirfd_cache; i < PHP_STREAM_DIRFD_CACHE_SIZE; i++, entry++) {
+		if (entry->dir_len == dir_len && memcmp(entry->dir, realpath, dir_len) == 0) {
+			found = entry;
+			break;
+		}
+		if (entry->dir_len == 0) {
+			victim = entry;
+		} else if (victim->dir_len != 0 && entry->stamp < victim->stamp) {
+			victim = entry;
+		}
+	}
+
+	if (!found) {
+		if (victim->dir_len) {
+			close(victim->fd);
+			victim->dir_len = 0;
+		}
+		memcpy(victim->dir, realpath, dir_len);
+		victim->dir[dir_len] = '\0';
+#ifdef O_CLOEXEC
+		fd = open(victim->dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#else
+		fd = open(victim->dir, O_RDONLY | O_DIRECTORY);
+#endif
+		if (fd < 0) {
+			return open(realpath, open_flags, mode);
+		}
+		victim->fd = fd;
+		victim->dir_len = dir_len;
+		found = victim;
+	}
+	found->stamp = ++php_stream_dirfd_stamp;
+
+	fd = openat(found->fd, base, open_flags, mode);
+	if (fd < 0) {
+		/* the cached descriptor may refer to a directory that has been
+		 * replaced since it was opened; retry with the full path so the
+		 * result (and errno) match a plain open() */
+		return open(realpath, open_flags, mode);
+	}
+	return fd;
+}
+
+#endif /* PHP_STREAM_DIRFD_CACHE */
+
+PHPAPI void php_stream_plain_dirfd_cache_clear(void)
+{
+#ifdef PHP_STREAM_DIRFD_CACHE
+	php_stream_dirfd_entry *entry = php_stream_dirfd_cache;
+	int i;
+
+	for (i = 0; i < PHP_STREAM_DIRFD_CACHE_SIZE; i++, entry++) {
+		if (entry->dir_len) {
+			close(entry->fd);
+			entry->dir_len = 0;
+		}
+	}
+#endif
+}
+
 #if defined(PHP_WIN32)
 # define PLAIN_WRAP_BUF_SIZE(st) ((unsigned int)(st > INT_MAX ? INT_MAX : st))
 #define fsync _commit
@@ -137,7 +241,13 @@ typedef struct {
 	unsigned is_pipe_blocking:1; /* allow blocking read() on pipes, currently Windows only */
 	unsigned no_forced_fstat:1;  /* Use fstat cache even if forced */
 	unsigned is_seekable:1;		/* don't try and seek, if not set */
+#ifdef HAVE_POSIX_FADVISE
+	unsigned advised_sequential:1;	/* POSIX_FADV_SEQUENTIAL was issued */
+	unsigned sequential_reads:3;	/* uninterrupted reads seen so far */
+	unsigned _reserved:22;
+#else
 	unsigned _reserved:26;
+#endif
 
 	int lock_flag;			/* stores the lock state */
 	zend_string *temp_name;	/* if non-null, this is the path to a temporary file that
@@ -217,9 +327,17 @@ static php_stream *_php_stream_fopen_from_file_int(FILE *file, const char *mode
 PHPAPI php_stream *_php_stream_fopen_temporary_file(const char *dir, const char *pfx, zend_string **opened_path_ptr STREAMS_DC)
 {
 	zend_string *opened_path = NULL;
+	uint32_t flags = PHP_TMP_FILE_DEFAULT;
 	int fd;
 
-	fd = php_open_temporary_fd(dir, pfx, &opened_path);
+	/* A caller that does not ask for the path never refers to the file by
+	 * name, so the file may be unnamed (O_TMPFILE) where supported; when
+	 * that is unavailable opened_path reports the named fallback. */
+	if (!opened_path_ptr) {
+		flags |= PHP_TMP_FILE_ANONYMOUS;
+	}
+
+	fd = php_open_temporary_fd_ex(dir, pfx, &opened_path, flags);
 	if (fd != -1)	{
 		php_stream *stream;
 
@@ -231,14 +349,20 @@ PHPAPI php_stream *_php_stream_fopen_temporary_file(const char *dir, const char
 		if (stream) {
 			php_stdio_stream_data *self = (php_stdio_stream_data*)stream->abstract;
 			stream->wrapper = (php_stream_wrapper*)&php_plain_files_wrapper;
-			stream->orig_path = estrndup(ZSTR_VAL(opened_path), ZSTR_LEN(opened_path));
-
-			self->temp_name = opened_path;
 			self->lock_flag = LOCK_UN;
 
+			if (opened_path) {
+				/* Named file: remember the path so it is deleted on close. */
+				stream->orig_path = estrndup(ZSTR_VAL(opened_path), ZSTR_LEN(opened_path));
+				self->temp_name = opened_path;
+			}
+
 			return stream;
 		}
 		close(fd);
+		if (!opened_path_ptr && opened_path) {
+			zend_string_release_ex(opened_path, 0);
+		}
 
 		php_error_docref(NULL, E_WARNING, "Unable to allocate stream");
 
@@ -449,6 +573,19 @@ static ssize_t php_stdiop_read(php_stream *stream, char *buf, size_t count)
 			stream->eof = 1;
 		}
 
+#ifdef HAVE_POSIX_FADVISE
+		if (ret > 0 && !data->advised_sequential
+				&& !data->is_pipe && !data->is_process_pipe) {
+			/* a handful of uninterrupted reads is a good indication of a
+			 * sequential scan; let the kernel widen its read-ahead window */
+			if (data->sequential_reads < 4) {
+				data->sequential_reads++;
+			} else if (do_fstat(data, 0) == 0 && S_ISREG(data->sb.st_mode)) {
+				posix_fadvise(data->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+				data->advised_sequential = 1;
+			}
+		}
+#endif
 	} else {
 #ifdef HAVE_FLUSHIO
 		if (data->is_seekable && data->last_op == 'w')
@@ -586,6 +723,10 @@ static int php_stdiop_seek(php_stream *stream, zend_off_t offset, int whence, ze
 		if (result == (zend_off_t)-1)
 			return -1;
 
+#ifdef HAVE_POSIX_FADVISE
+		/* a seek interrupts the pattern used to detect sequential scans */
+		data->sequential_reads = 0;
+#endif
 		*newoffset = result;
 		return 0;
 
@@ -1138,6 +1279,8 @@ PHPAPI php_stream *_php_stream_fopen(const char *filename, const char *mode, zen
 	}
 #ifdef PHP_WIN32
 	fd = php_win32_ioutil_open(realpath, open_flags, 0666);
+#elif defined(PHP_STREAM_DIRFD_CACHE)
+	fd = php_stream_dirfd_open(realpath, open_flags, 0666);
 #else
 	fd = open(realpath, open_flags, 0666);
 #endif
@@ -1211,6 +1354,11 @@ static php_stream *php_plain_files_stream_opener(php_stream_wrapper *wrapper, co
 		return NULL;
 	}
 
+	/* opening for writing is about to change what stat would report */
+	if (strpbrk(mode, "waxc+")) {
+		php_stat_cache_forget(path, strlen(path));
+	}
+
 	return php_stream_fopen_rel(path, mode, opened_path, options);
 }
 
@@ -22,6 +22,7 @@
 #endif
 #include "php.h"
 #include "php_globals.h"
+#include "zend_dtrace.h"
 #include "php_memory_streams.h"
 #include "php_network.h"
 #include "php_open_temporary_file.h"
@@ -30,8 +31,14 @@
 #include "ext/standard/php_string.h" /* for php_memnstr, used by php_stream_get_record() */
 #include <stddef.h>
 #include <fcntl.h>
+#if defined(__linux__) && defined(HAVE_SENDFILE)
+# include <sys/sendfile.h>
+#endif
 #include "php_streams_int.h"
 
+/* cap for the adaptive read-ahead window used when filling the read buffer */
+#define PHP_STREAM_MAX_READAHEAD (1024 * 1024)
+
 /* {{{ resource and registration code */
 /* Global wrapper hash, copied to FG(stream_wrappers) on registration of volatile wrapper */
 static HashTable url_stream_wrappers_hash;
@@ -294,6 +301,7 @@ fprintf(stderr, "stream_alloc: %s:%p persistent=%s\n", ops->label, ret, persiste
 	ret->abstract = abstract;
 	ret->is_persistent = persistent_id ? 1 : 0;
 	ret->chunk_size = FG(def_chunk_size);
+	ret->readahead_size = 0;
 
 #if ZEND_DEBUG
 	ret->open_filename = __zend_orig_filename ? __zend_orig_filename : __zend_filename;
@@ -663,9 +671,23 @@ PHPAPI zend_result _php_stream_fill_read_buffer(php_stream *stream, size_t size)
 		/* is there enough data in the buffer ? */
 		if (stream->writepos - stream->readpos < (zend_off_t)size) {
 			ssize_t justread = 0;
+			size_t fill_size;
+
+			/* Every refill means the previous window was drained without an
+			 * intervening seek, so widen the read-ahead window to issue
+			 * larger reads against the underlying stream. Seeks and
+			 * stream_set_chunk_size() reset the window to chunk_size. */
+			if (stream->readahead_size < stream->chunk_size) {
+				fill_size = stream->chunk_size;
+			} else if (stream->readahead_size < PHP_STREAM_MAX_READAHEAD) {
+				fill_size = MIN(stream->readahead_size * 2, PHP_STREAM_MAX_READAHEAD);
+			} else {
+				fill_size = stream->readahead_size;
+			}
+			stream->readahead_size = fill_size;
 
 			/* reduce buffer memory consumption if possible, to avoid a realloc */
-			if (stream->readbuf && stream->readbuflen - stream->writepos < stream->chunk_size) {
+			if (stream->readbuf && stream->readbuflen - stream->writepos < fill_size) {
 				if (stream->writepos > stream->readpos) {
 					memmove(stream->readbuf, stream->readbuf + stream->readpos, stream->writepos - stream->readpos);
 				}
@@ -675,8 +697,8 @@ PHPAPI zend_result _php_stream_fill_read_buffer(php_stream *stream, size_t size)
 
 			/* grow the buffer if required
 			 * TODO: this can fail for persistent streams */
-			if (stream->readbuflen - stream->writepos < stream->chunk_size) {
-				stream->readbuflen += stream->chunk_size;
+			if (stream->readbuflen - stream->writepos < fill_size) {
+				stream->readbuflen += fill_size;
 				stream->readbuf = perealloc(stream->readbuf, stream->readbuflen,
 						stream->is_persistent);
 			}
@@ -707,6 +729,12 @@ PHPAPI ssize_t _php_stream_read(php_stream *stream, char *buf, size_t size)
 {
 	ssize_t toread = 0, didread = 0;
 
+#ifdef HAVE_DTRACE
+	if (DTRACE_STREAM_READ_ENTRY_ENABLED()) {
+		DTRACE_STREAM_READ_ENTRY((char *) stream->ops->label, stream->orig_path, size);
+	}
+#endif
+
 	while (size > 0) {
 
 		/* take from the read buffer first.
@@ -739,6 +767,11 @@ PHPAPI ssize_t _php_stream_read(php_stream *stream, char *buf, size_t size)
 				/* Report an error if the read failed and we did not read any data
 				 * before that. Otherwise return the data we did read. */
 				if (didread == 0) {
+#ifdef HAVE_DTRACE
+					if (DTRACE_STREAM_READ_RETURN_ENABLED()) {
+						DTRACE_STREAM_READ_RETURN((char *) stream->ops->label, stream->orig_path, toread);
+					}
+#endif
 					return toread;
 				}
 				break;
@@ -746,6 +779,11 @@ PHPAPI ssize_t _php_stream_read(php_stream *stream, char *buf, size_t size)
 		} else {
 			if (php_stream_fill_read_buffer(stream, size) != SUCCESS) {
 				if (didread == 0) {
+#ifdef HAVE_DTRACE
+					if (DTRACE_STREAM_READ_RETURN_ENABLED()) {
+						DTRACE_STREAM_READ_RETURN((char *) stream->ops->label, stream->orig_path, -1);
+					}
+#endif
 					return -1;
 				}
 				break;
@@ -784,6 +822,12 @@ PHPAPI ssize_t _php_stream_read(php_stream *stream, char *buf, size_t size)
 		stream->has_buffered_data = 0;
 	}
 
+#ifdef HAVE_DTRACE
+	if (DTRACE_STREAM_READ_RETURN_ENABLED()) {
+		DTRACE_STREAM_READ_RETURN((char *) stream->ops->label, stream->orig_path, didread);
+	}
+#endif
+
 	return didread;
 }
 
@@ -1299,6 +1343,12 @@ PHPAPI ssize_t _php_stream_write(php_stream *stream, const char *buf, size_t cou
 		return (ssize_t) -1;
 	}
 
+#ifdef HAVE_DTRACE
+	if (DTRACE_STREAM_WRITE_ENTRY_ENABLED()) {
+		DTRACE_STREAM_WRITE_ENTRY((char *) stream->ops->label, stream->orig_path, count);
+	}
+#endif
+
 	if (stream->writefilters.head) {
 		bytes = _php_stream_write_filtered(stream, buf, count, PSFS_FLAG_NORMAL);
 	} else {
@@ -1309,6 +1359,12 @@ PHPAPI ssize_t _php_stream_write(php_stream *stream, const char *buf, size_t cou
 		stream->flags |= PHP_STREAM_FLAG_WAS_WRITTEN;
 	}
 
+#ifdef HAVE_DTRACE
+	if (DTRACE_STREAM_WRITE_RETURN_ENABLED()) {
+		DTRACE_STREAM_WRITE_RETURN((char *) stream->ops->label, stream->orig_path, bytes);
+	}
+#endif
+
 	return bytes;
 }
 
@@ -1395,6 +1451,7 @@ PHPAPI int _php_stream_seek(php_stream *stream, zend_off_t offset, int whence)
 
 			/* invalidate the buffer contents */
 			stream->readpos = stream->writepos = 0;
+			stream->readahead_size = 0;
 
 			return ret;
 		}
@@ -1435,6 +1492,7 @@ PHPAPI int _php_stream_set_option(php_stream *stream, int option, int value, voi
 				/* XXX chunk size itself is of size_t, that might be ok or not for a particular case*/
 				ret = stream->chunk_size > INT_MAX ? INT_MAX : (int)stream->chunk_size;
 				stream->chunk_size = value;
+				stream->readahead_size = 0;
 				return ret;
 
 			case PHP_STREAM_OPTION_READ_BUFFER:
@@ -1692,6 +1750,60 @@ PHPAPI zend_result _php_stream_copy_to_stream_ex(php_stream *src, php_stream *de
 	}
 #endif // HAVE_COPY_FILE_RANGE
 
+#if defined(__linux__) && defined(HAVE_SENDFILE)
+	if (php_stream_is(src, PHP_STREAM_IS_STDIO) &&
+			php_stream_is(dest, PHP_STREAM_IS_SOCKET) &&
+			src->writepos == src->readpos) {
+		/* the source is a plain unfiltered file with an empty read buffer and
+		 * the destination is a socket: sendfile(2) moves the data from the
+		 * page cache into the socket without copying it through userspace */
+		int src_fd, dest_fd;
+
+		if (php_stream_cast(src, PHP_STREAM_AS_FD, (void*)&src_fd, 0) == SUCCESS &&
+				php_stream_cast(dest, PHP_STREAM_AS_FD, (void*)&dest_fd, 0) == SUCCESS) {
+			while (1) {
+				/* clamp to SSIZE_MAX; the kernel may send less per call */
+				const size_t chunk = MIN(maxlen - haveread, (size_t)SSIZE_MAX);
+				ssize_t result = sendfile(dest_fd, src_fd, NULL, chunk);
+
+				if (result > 0) {
+					size_t nbytes = (size_t)result;
+					haveread += nbytes;
+
+					src->position += nbytes;
+					dest->position += nbytes;
+
+					if (maxlen != PHP_STREAM_COPY_ALL && haveread == maxlen) {
+						*len = haveread;
+						return SUCCESS;
+					}
+				} else if (result == 0) {
+					/* end of file */
+					*len = haveread;
+					return SUCCESS;
+				} else {
+					if (errno == EINTR) {
+						continue;
+					}
+					if (errno != EINVAL && errno != ENOSYS && errno != ENOTSOCK &&
+							errno != EOVERFLOW && errno != EAGAIN
+#ifdef EWOULDBLOCK
+							&& errno != EWOULDBLOCK
+#endif
+							) {
+						/* unexpected I/O error - give up, no fallback */
+						*len = haveread;
+						return FAILURE;
+					}
+					/* fall back to classic copying, e.g. for non-blocking
+					 * sockets or descriptors sendfile cannot handle */
+					break;
+				}
+			}
+		}
+	}
+#endif // __linux__ && HAVE_SENDFILE
+
 	if (maxlen == PHP_STREAM_COPY_ALL) {
 		maxlen = 0;
 	}
@@ -1828,6 +1940,8 @@ static void stream_resource_persistent_dtor(zend_resource *rsrc)
 
 void php_shutdown_stream_hashes(void)
 {
+	php_stream_plain_dirfd_cache_clear();
+
 	FG(user_stream_current_filename) = NULL;
 	if (FG(stream_wrappers)) {
 		zend_hash_destroy(FG(stream_wrappers));
@@ -18,6 +18,7 @@
 #include "ext/standard/file.h"
 #include "streams/php_streams_int.h"
 #include "php_network.h"
+#include "zend_hrtime.h"
 
 #if defined(PHP_WIN32) || defined(__riscos__)
 # undef AF_UNIX
@@ -123,7 +124,8 @@ retry:
 static void php_sock_stream_wait_for_data(php_stream *stream, php_netstream_data_t *sock, bool has_buffered_data)
 {
 	int retval;
-	struct timeval *ptimeout, zero_timeout;
+	struct timeval *ptimeout, work_timeout;
+	zend_hrtime_t deadline = 0;
 
 	if (!sock || sock->socket == -1) {
 		return;
@@ -133,13 +135,20 @@ static void php_sock_stream_wait_for_data(php_stream *stream, php_netstream_data
 
 	if (has_buffered_data) {
 		/* If there is already buffered data, use no timeout. */
-		zero_timeout.tv_sec = 0;
-		zero_timeout.tv_usec = 0;
-		ptimeout = &zero_timeout;
+		work_timeout.tv_sec = 0;
+		work_timeout.tv_usec = 0;
+		ptimeout = &work_timeout;
 	} else if (sock->timeout.tv_sec == -1) {
 		ptimeout = NULL;
 	} else {
-		ptimeout = &sock->timeout;
+		/* Fix the deadline once, so EINTR wakeups (profiling or timer
+		 * signals in particular) continue with the remaining time instead
+		 * of restarting the full timeout on every iteration */
+		deadline = zend_hrtime()
+			+ (zend_hrtime_t)sock->timeout.tv_sec * ZEND_NANO_IN_SEC
+			+ (zend_hrtime_t)sock->timeout.tv_usec * 1000;
+		work_timeout = sock->timeout;
+		ptimeout = &work_timeout;
 	}
 
 	while(1) {
@@ -153,6 +162,17 @@ static void php_sock_stream_wait_for_data(php_stream *stream, php_netstream_data
 
 		if (php_socket_errno() != EINTR)
 			break;
+
+		if (deadline) {
+			zend_hrtime_t now = zend_hrtime();
+
+			if (now >= deadline) {
+				sock->timeout_event = 1;
+				break;
+			}
+			work_timeout.tv_sec = (deadline - now) / ZEND_NANO_IN_SEC;
+			work_timeout.tv_usec = ((deadline - now) % ZEND_NANO_IN_SEC) / 1000;
+		}
 	}
 }
 
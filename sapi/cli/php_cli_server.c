@@ -58,6 +58,16 @@
 # include <sys/procctl.h>
 #endif
 
+#ifdef __linux__
+# include <sys/sendfile.h>
+# define PHP_CLI_SERVER_USE_SENDFILE 1
+#endif
+
+#if !defined(PHP_WIN32) && defined(HAVE_SYS_UIO_H)
+# include <sys/uio.h>
+# define PHP_CLI_SERVER_HAVE_WRITEV 1
+#endif
+
 #include "SAPI.h"
 #include "php.h"
 #include "php_ini.h"
@@ -184,6 +194,9 @@ typedef struct php_cli_server_client {
 	php_cli_server_request request;
 	bool content_sender_initialized;
 	php_cli_server_content_sender content_sender;
+	/* header block corked until the first body write, see
+	 * sapi_cli_server_send_headers()/sapi_cli_server_ub_write() */
+	smart_str pending_headers;
 	int file_fd;
 } php_cli_server_client;
 
@@ -229,6 +242,7 @@ static int php_cli_output_is_tty = OUTPUT_NOT_CHECKED;
 static const char php_cli_server_request_error_unexpected_eof[] = "Unexpected EOF";
 
 static size_t php_cli_server_client_send_through(php_cli_server_client *client, const char *str, size_t str_len);
+static void php_cli_server_client_drain_headers(php_cli_server_client *client, bool send);
 static php_cli_server_chunk *php_cli_server_chunk_heap_new_self_contained(size_t len);
 static void php_cli_server_buffer_append(php_cli_server_buffer *buffer, php_cli_server_chunk *chunk);
 static void php_cli_server_logf(int type, const char *format, ...);
@@ -521,6 +535,37 @@ static size_t sapi_cli_server_ub_write(const char *str, size_t str_length) /* {{
 	if (!client) {
 		return 0;
 	}
+	if (client->pending_headers.s) {
+#ifdef PHP_CLI_SERVER_HAVE_WRITEV
+		/* First body chunk after the headers: push both out with a single
+		 * gather-write so small responses fit into one TCP segment. */
+		struct iovec iov[2];
+		ssize_t nbytes_sent;
+		size_t header_len = ZSTR_LEN(client->pending_headers.s);
+
+		iov[0].iov_base = ZSTR_VAL(client->pending_headers.s);
+		iov[0].iov_len = header_len;
+		iov[1].iov_base = (void *) str;
+		iov[1].iov_len = str_length;
+		nbytes_sent = writev(client->sock, iov, 2);
+		if (nbytes_sent >= 0) {
+			if ((size_t)nbytes_sent < header_len) {
+				php_cli_server_client_send_through(client,
+						ZSTR_VAL(client->pending_headers.s) + nbytes_sent, header_len - nbytes_sent);
+				smart_str_free(&client->pending_headers);
+				return php_cli_server_client_send_through(client, str, str_length);
+			}
+			smart_str_free(&client->pending_headers);
+			if ((size_t)nbytes_sent - header_len < str_length) {
+				size_t body_written = (size_t)nbytes_sent - header_len;
+				php_cli_server_client_send_through(client, str + body_written, str_length - body_written);
+			}
+			return str_length;
+		}
+		/* fall back to the blocking path on EAGAIN or error */
+#endif
+		php_cli_server_client_drain_headers(client, /* send */ true);
+	}
 	return php_cli_server_client_send_through(client, str, str_length);
 } /* }}} */
 
@@ -533,6 +578,7 @@ static void sapi_cli_server_flush(void *server_context) /* {{{ */
 	}
 
 	if (!ZEND_VALID_SOCKET(client->sock)) {
+		php_cli_server_client_drain_headers(client, /* send */ false);
 		php_handle_aborted_connection();
 		return;
 	}
@@ -541,6 +587,9 @@ static void sapi_cli_server_flush(void *server_context) /* {{{ */
 		sapi_send_headers();
 		SG(headers_sent) = 1;
 	}
+
+	/* body-less response: the headers were never flushed by a body write */
+	php_cli_server_client_drain_headers(client, /* send */ true);
 } /* }}} */
 
 static int sapi_cli_server_discard_headers(sapi_headers_struct *sapi_headers) /* {{{ */{
@@ -578,9 +627,11 @@ static int sapi_cli_server_send_headers(sapi_headers_struct *sapi_headers) /* {{
 	}
 	smart_str_appendl(&buffer, "\r\n", 2);
 
-	php_cli_server_client_send_through(client, ZSTR_VAL(buffer.s), ZSTR_LEN(buffer.s));
-
-	smart_str_free(&buffer);
+	/* Cork the header block until the first body write; see
+	 * sapi_cli_server_ub_write(). sapi_cli_server_flush() picks it up for
+	 * responses without a body. */
+	php_cli_server_client_drain_headers(client, /* send */ true);
+	client->pending_headers = buffer;
 	return SAPI_HEADER_SENT_SUCCESSFULLY;
 }
 /* }}} */
@@ -1280,7 +1331,7 @@ static void php_cli_server_logf(int type, const char *format, ...) /* {{{ */
 	efree(buf);
 } /* }}} */
 
-static php_socket_t php_network_listen_socket(const char *host, int *port, int socktype, int *af, socklen_t *socklen, zend_string **errstr) /* {{{ */
+static php_socket_t php_network_listen_socket(const char *host, int *port, int socktype, int *af, socklen_t *socklen, bool reuseport, zend_string **errstr) /* {{{ */
 {
 	php_socket_t retval = SOCK_ERR;
 	int err = 0;
@@ -1329,6 +1380,12 @@ static php_socket_t php_network_listen_socket(const char *host, int *port, int s
 			setsockopt(retval, SOL_SOCKET, SO_REUSEADDR, (char*)&val, sizeof(val));
 		}
 #endif
+#ifdef SO_REUSEPORT
+		if (reuseport) {
+			int val = 1;
+			setsockopt(retval, SOL_SOCKET, SO_REUSEPORT, (char*)&val, sizeof(val));
+		}
+#endif
 
 		if (bind(retval, sa, *socklen) == SOCK_CONN_ERR) {
 			err = php_socket_errno();
@@ -1914,6 +1971,18 @@ static size_t php_cli_server_client_send_through(php_cli_server_client *client,
 	return str_len;
 } /* }}} */
 
+static void php_cli_server_client_drain_headers(php_cli_server_client *client, bool send) /* {{{ */
+{
+	if (!client->pending_headers.s) {
+		return;
+	}
+	if (send) {
+		php_cli_server_client_send_through(client,
+				ZSTR_VAL(client->pending_headers.s), ZSTR_LEN(client->pending_headers.s));
+	}
+	smart_str_free(&client->pending_headers);
+} /* }}} */
+
 static void php_cli_server_client_populate_request_info(const php_cli_server_client *client, sapi_request_info *request_info) /* {{{ */
 {
 	zval *val;
@@ -1962,12 +2031,14 @@ static void php_cli_server_client_ctor(php_cli_server_client *client, php_cli_se
 	php_cli_server_request_ctor(&client->request);
 
 	client->content_sender_initialized = false;
+	memset(&client->pending_headers, 0, sizeof(client->pending_headers));
 	client->file_fd = -1;
 } /* }}} */
 
 static void php_cli_server_client_dtor(php_cli_server_client *client) /* {{{ */
 {
 	php_cli_server_request_dtor(&client->request);
+	smart_str_free(&client->pending_headers);
 	if (client->file_fd >= 0) {
 		close(client->file_fd);
 		client->file_fd = -1;
@@ -2478,7 +2549,7 @@ static void php_cli_server_worker_install_pdeathsig(void)
 }
 #endif
 
-static void php_cli_server_startup_workers(void) {
+static void php_cli_server_startup_workers(php_cli_server *server, const char *host, int port, bool reuseport) {
 	char *workers = getenv("PHP_CLI_SERVER_WORKERS");
 	if (!workers) {
 		return;
@@ -2507,6 +2578,29 @@ static void php_cli_server_startup_workers(void) {
 			} else if (pid == 0) {
 #if defined(HAVE_PRCTL) || defined(HAVE_PROCCTL)
 				php_cli_server_worker_install_pdeathsig();
+#endif
+#ifdef SO_REUSEPORT
+				if (reuseport) {
+					/* Replace the inherited listen socket with a private
+					 * SO_REUSEPORT one, so the kernel load-balances incoming
+					 * connections across the workers instead of waking every
+					 * worker for each connection on the shared accept queue.
+					 * The shared socket is kept if binding fails. */
+					zend_string *errstr = NULL;
+					int worker_port = port;
+					php_socket_t sock = php_network_listen_socket(host, &worker_port, SOCK_STREAM,
+							&server->address_family, &server->socklen, true, &errstr);
+
+					if (sock != SOCK_ERR && SUCCESS == php_set_sock_blocking(sock, 0)) {
+						closesocket(server->server_sock);
+						server->server_sock = sock;
+					} else if (sock != SOCK_ERR) {
+						closesocket(sock);
+					}
+					if (errstr) {
+						zend_string_release_ex(errstr, 0);
+					}
+				}
 #endif
 				return;
 			} else {
@@ -2530,6 +2624,7 @@ static zend_result php_cli_server_ctor(php_cli_server *server, const char *addr,
 	char *_router = NULL;
 	int port = 3000;
 	php_socket_t server_sock = SOCK_ERR;
+	bool reuseport = false;
 
 	host = php_cli_server_parse_addr(addr, &port);
 	if (!host) {
@@ -2538,7 +2633,16 @@ static zend_result php_cli_server_ctor(php_cli_server *server, const char *addr,
 		goto out;
 	}
 
-	server_sock = php_network_listen_socket(host, &port, SOCK_STREAM, &server->address_family, &server->socklen, &errstr);
+#if defined(SO_REUSEPORT) && HAVE_FORK
+	{
+		/* With an ephemeral port every worker would bind a different one, so
+		 * per-worker sockets are only used for an explicitly chosen port. */
+		char *workers_env = getenv("PHP_CLI_SERVER_WORKERS");
+		reuseport = workers_env && ZEND_ATOL(workers_env) > 1 && port != 0;
+	}
+#endif
+
+	server_sock = php_network_listen_socket(host, &port, SOCK_STREAM, &server->address_family, &server->socklen, reuseport, &errstr);
 	if (server_sock == SOCK_ERR) {
 		php_cli_server_logf(PHP_CLI_SERVER_LOG_ERROR, "Failed to listen on %s:%d (reason: %s)", host, port, errstr ? ZSTR_VAL(errstr) : "?");
 		if (errstr) {
@@ -2557,11 +2661,12 @@ static zend_result php_cli_server_ctor(php_cli_server *server, const char *addr,
 	}
 	server->server_sock = server_sock;
 
-	php_cli_server_startup_workers();
+	php_cli_server_startup_workers(server, host, port, reuseport);
 
 	php_cli_server_poller_ctor(&server->poller);
 
-	php_cli_server_poller_add(&server->poller, POLLIN, server_sock);
+	/* workers may have swapped in their own SO_REUSEPORT socket */
+	php_cli_server_poller_add(&server->poller, POLLIN, server->server_sock);
 
 	server->host = host;
 	server->port = port;
@@ -2641,6 +2746,33 @@ static zend_result php_cli_server_recv_event_read_request(php_cli_server *server
 static zend_result php_cli_server_send_event(php_cli_server *server, php_cli_server_client *client) /* {{{ */
 {
 	if (client->content_sender_initialized) {
+#ifdef PHP_CLI_SERVER_USE_SENDFILE
+		if (client->file_fd >= 0 && !client->content_sender.buffer.first) {
+			/* The headers are flushed; stream the file body straight from the
+			 * page cache instead of copying it through userspace buffers. */
+			ssize_t nbytes_sent;
+
+			do {
+				nbytes_sent = sendfile(client->sock, client->file_fd, NULL, 65536);
+			} while (nbytes_sent > 0);
+			if (nbytes_sent == 0) {
+				/* end of file */
+				close(client->file_fd);
+				client->file_fd = -1;
+				php_cli_server_close_connection(server, client);
+				return SUCCESS;
+			}
+			if (errno == SOCK_EAGAIN) {
+				return SUCCESS;
+			}
+			if (errno != EINVAL && errno != ENOSYS) {
+				php_cli_server_close_connection(server, client);
+				return FAILURE;
+			}
+			/* the file or socket does not support sendfile();
+			 * fall back to read() + send() below */
+		}
+#endif
 		if (client->file_fd >= 0 && !client->content_sender.buffer.first) {
 			size_t nbytes_read;
 			if (!php_cli_server_content_sender_pull(&client->content_sender, client->file_fd, &nbytes_read)) {
@@ -0,0 +1,67 @@
+--TEST--
+PHP_INI_CACHE round-trip, invalidation and corrupt cache rejection
+--SKIPIF--
+<?php
+include "skipif.inc";
+?>
+--FILE--
+<?php
+
+$php = getenv('TEST_PHP_EXECUTABLE_ESCAPED');
+
+$dir = __DIR__ . '/ini_cache_test';
+@mkdir($dir);
+$ini = $dir . '/custom.ini';
+$cache = $dir . '/ini.cache';
+
+file_put_contents($ini, "memory_limit=129M\nuser_agent=ini-cache-one\n");
+putenv("PHP_INI_CACHE=$cache");
+putenv("PHP_INI_SCAN_DIR=");
+
+$base = "$php -c " . escapeshellarg($ini);
+$code = escapeshellarg('echo ini_get("memory_limit"), "|", ini_get("user_agent"), "\n";');
+$cmd = "$base -r $code";
+
+// cold start parses the ini file and writes the cache
+echo `$cmd`;
+var_dump(is_file($cache) && filesize($cache) > 0);
+
+// warm start restores the identical configuration from the cache
+echo `$cmd`;
+
+// -d entries still win over cached values
+echo `$base -d user_agent=from-command-line -r $code`;
+
+// editing the ini file invalidates the cache and the new values are seen
+file_put_contents($ini, "memory_limit=130M\nuser_agent=ini-cache-two\n");
+echo `$cmd`;
+
+// a garbage cache file is rejected silently and rewritten
+file_put_contents($cache, 'not an ini cache');
+echo `$cmd`;
+var_dump(filesize($cache) > strlen('not an ini cache'));
+
+// so is a truncated one
+$blob = file_get_contents($cache);
+file_put_contents($cache, substr($blob, 0, (int) (strlen($blob) / 2)));
+echo `$cmd`;
+
+putenv("PHP_INI_CACHE");
+putenv("PHP_INI_SCAN_DIR");
+?>
+--CLEAN--
+<?php
+$dir = __DIR__ . '/ini_cache_test';
+@unlink($dir . '/custom.ini');
+@unlink($dir . '/ini.cache');
+@rmdir($dir);
+?>
+--EXPECT--
+129M|ini-cache-one
+bool(true)
+129M|ini-cache-one
+129M|from-command-line
+130M|ini-cache-two
+130M|ini-cache-two
+bool(true)
+130M|ini-cache-two
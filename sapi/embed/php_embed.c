@@ -160,7 +160,14 @@ static const zend_function_entry additional_functions[] = {
 	ZEND_FE_END
 };
 
-EMBED_SAPI_API int php_embed_init(int argc, char **argv)
+/* Process initialization: everything up to and including module startup
+ * (MINIT), but no request context. Embedders that serve many isolated
+ * execution contexts from one process call this once, then cycle
+ * php_embed_request_startup()/php_embed_request_shutdown() per context.
+ * Immutable state created at module startup — interned strings, internal
+ * class metadata and opcache's shared code — is paid for once and reused
+ * by every context, while each context gets its own request heap. */
+EMBED_SAPI_API int php_embed_init_process(int argc, char **argv)
 {
 #if defined(SIGPIPE) && defined(SIG_IGN)
 	signal(SIGPIPE, SIG_IGN); /* ignore SIGPIPE in standalone mode so
@@ -236,9 +243,16 @@ EMBED_SAPI_API int php_embed_init(int argc, char **argv)
 	SG(request_info).argc=argc;
 	SG(request_info).argv=argv;
 
-	/* Request initialization (RINIT) */
+	return SUCCESS;
+}
+
+/* Start a fresh execution context (RINIT). Userland state from previous
+ * contexts — classes, functions, globals, the request heap — is gone;
+ * code compiled into opcache's shared memory is not and does not have to
+ * be recompiled or duplicated per context. */
+EMBED_SAPI_API int php_embed_request_startup(void)
+{
 	if (php_request_startup() == FAILURE) {
-		php_module_shutdown();
 		return FAILURE;
 	}
 
@@ -249,11 +263,16 @@ EMBED_SAPI_API int php_embed_init(int argc, char **argv)
 	return SUCCESS;
 }
 
-EMBED_SAPI_API void php_embed_shutdown(void)
+/* Tear down the current execution context (RSHUTDOWN), releasing its
+ * request heap. The module stays up for the next context. */
+EMBED_SAPI_API void php_embed_request_shutdown(void)
 {
-	/* Request shutdown (RSHUTDOWN) */
 	php_request_shutdown((void *) 0);
+}
 
+/* Process shutdown, after the last context has been torn down. */
+EMBED_SAPI_API void php_embed_shutdown_process(void)
+{
 	/* Module shutdown (MSHUTDOWN) */
 	php_module_shutdown();
 
@@ -264,3 +283,26 @@ EMBED_SAPI_API void php_embed_shutdown(void)
 	tsrm_shutdown();
 #endif
 }
+
+EMBED_SAPI_API int php_embed_init(int argc, char **argv)
+{
+	if (php_embed_init_process(argc, argv) == FAILURE) {
+		return FAILURE;
+	}
+
+	/* Request initialization (RINIT) */
+	if (php_embed_request_startup() == FAILURE) {
+		php_module_shutdown();
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+EMBED_SAPI_API void php_embed_shutdown(void)
+{
+	/* Request shutdown (RSHUTDOWN) */
+	php_embed_request_shutdown();
+
+	php_embed_shutdown_process();
+}
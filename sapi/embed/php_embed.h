@@ -48,6 +48,10 @@ ZEND_TSRMLS_CACHE_EXTERN()
 BEGIN_EXTERN_C()
 EMBED_SAPI_API int php_embed_init(int argc, char **argv);
 EMBED_SAPI_API void php_embed_shutdown(void);
+EMBED_SAPI_API int php_embed_init_process(int argc, char **argv);
+EMBED_SAPI_API int php_embed_request_startup(void);
+EMBED_SAPI_API void php_embed_request_shutdown(void);
+EMBED_SAPI_API void php_embed_shutdown_process(void);
 extern EMBED_SAPI_API sapi_module_struct php_embed_module;
 END_EXTERN_C()
 
@@ -434,7 +434,7 @@ if test "$PHP_FPM" != "no"; then
   AC_FPM_EPOLL
   AC_FPM_SELECT
 
-  AC_CHECK_FUNCS([clearenv setproctitle setproctitle_fast])
+  AC_CHECK_FUNCS([clearenv setproctitle setproctitle_fast sched_setaffinity])
 
   AC_CHECK_HEADER([priv.h], [AC_CHECK_FUNCS([setpflags])])
   AC_CHECK_HEADER([sys/times.h], [AC_CHECK_FUNCS([times])])
@@ -599,6 +599,7 @@ if test "$PHP_FPM" != "no"; then
   PHP_FPM_CFLAGS="-I$abs_srcdir/sapi/fpm -DZEND_ENABLE_STATIC_TSRMLS_CACHE=1"
 
   PHP_FPM_FILES="fpm/fpm.c \
+    fpm/fpm_channel.c \
     fpm/fpm_children.c \
     fpm/fpm_cleanup.c \
     fpm/fpm_clock.c \
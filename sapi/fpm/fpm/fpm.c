@@ -17,6 +17,7 @@
 #include "fpm_conf.h"
 #include "fpm_worker_pool.h"
 #include "fpm_scoreboard.h"
+#include "fpm_channel.h"
 #include "fpm_stdio.h"
 #include "fpm_log.h"
 #include "zlog.h"
@@ -58,6 +59,7 @@ enum fpm_init_return_status fpm_init(int argc, char **argv, char *config, char *
 	    0 > fpm_conf_init_main(test_conf, force_daemon) ||
 	    0 > fpm_unix_init_main()          ||
 	    0 > fpm_scoreboard_init_main()    ||
+	    0 > fpm_channel_init_main()       ||
 	    0 > fpm_pctl_init_main()          ||
 	    0 > fpm_env_init_main()           ||
 	    0 > fpm_signals_init_main()       ||
@@ -15,7 +15,8 @@
  * and only use volatile atomic_uint_t as atomic_t
  */
 
-typedef volatile unsigned long atomic_t;
+typedef unsigned long               atomic_uint_t;
+typedef volatile atomic_uint_t      atomic_t;
 #define atomic_cmp_set(a,b,c) __sync_bool_compare_and_swap(a,b,c)
 
 #elif ( __i386__ || __i386 )
@@ -158,4 +159,78 @@ static inline int fpm_spinlock(atomic_t *lock, int try_once) /* {{{ */
 
 #define fpm_unlock(lock) lock = 0
 
+/* Portable atomic add built on atomic_cmp_set, for targets whose branch
+ * above does not provide atomic_fetch_add */
+static inline void fpm_atomic_add(atomic_t *value, unsigned long add) /* {{{ */
+{
+	atomic_t old = *value;
+
+	while (!atomic_cmp_set(value, old, old + add)) {
+		old = *value;
+	}
+}
+/* }}} */
+
+#ifdef __ATOMIC_SEQ_CST
+
+/* Sequence counter of a seqlock. Writers are already serialized by the
+ * corresponding spinlock; the full barrier is what matters here, so that the
+ * data writes cannot escape the odd/even bump pair around them and readers
+ * polling the counter never observe a torn snapshot. */
+static inline void fpm_seqlock_bump(atomic_t *seq) /* {{{ */
+{
+	__atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+}
+/* }}} */
+
+static inline atomic_uint_t fpm_seqlock_read_begin(const atomic_t *seq) /* {{{ */
+{
+	return __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+}
+/* }}} */
+
+/* The acquire fence keeps the preceding data reads from being reordered past
+ * the re-read; a bare acquire load on the re-read would not. */
+static inline int fpm_seqlock_read_verify(const atomic_t *seq, atomic_uint_t start) /* {{{ */
+{
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return __atomic_load_n(seq, __ATOMIC_RELAXED) == start;
+}
+/* }}} */
+
+#else /* no __atomic builtins (GCC < 4.7); every branch above still provides
+       * atomic_cmp_set(), which is a full barrier */
+
+#if defined(HAVE_BUILTIN_ATOMIC) || ( __arm__ || __arm )
+#define fpm_seqlock_rmb() __sync_synchronize()
+#else
+/* x86 and SPARC keep loads ordered with other loads; only the compiler
+ * needs restraining */
+#define fpm_seqlock_rmb() __asm__ __volatile__("" ::: "memory")
+#endif
+
+static inline void fpm_seqlock_bump(atomic_t *seq) /* {{{ */
+{
+	fpm_atomic_add(seq, 1);
+}
+/* }}} */
+
+static inline atomic_uint_t fpm_seqlock_read_begin(const atomic_t *seq) /* {{{ */
+{
+	atomic_uint_t start = *seq;
+
+	fpm_seqlock_rmb();
+	return start;
+}
+/* }}} */
+
+static inline int fpm_seqlock_read_verify(const atomic_t *seq, atomic_uint_t start) /* {{{ */
+{
+	fpm_seqlock_rmb();
+	return *seq == start;
+}
+/* }}} */
+
+#endif /* __ATOMIC_SEQ_CST */
+
 #endif
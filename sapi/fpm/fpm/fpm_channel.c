@@ -0,0 +1,152 @@
+#include "fpm_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "fpm_atomic.h"
+#include "fpm_channel.h"
+#include "fpm_shm.h"
+#include "zlog.h"
+
+#define FPM_CHANNEL_MAX 8
+
+/* A channel is a byte ring carrying length-prefixed messages. head and tail
+ * only ever grow; the ring offset is pos % FPM_CHANNEL_SIZE. Senders and
+ * receivers from any worker serialize on the per-channel spinlock, which is
+ * only held for the duration of one memcpy pair. */
+struct fpm_channel_s {
+	atomic_t lock;
+	unsigned int used;
+	char name[FPM_CHANNEL_NAME_MAX];
+	size_t head; /* bytes consumed */
+	size_t tail; /* bytes produced */
+	char data[FPM_CHANNEL_SIZE];
+};
+
+struct fpm_channel_dir_s {
+	atomic_t lock;
+	struct fpm_channel_s channels[FPM_CHANNEL_MAX];
+};
+
+static struct fpm_channel_dir_s *fpm_channel_dir = NULL;
+
+int fpm_channel_init_main(void)
+{
+	fpm_channel_dir = fpm_shm_alloc(sizeof(struct fpm_channel_dir_s));
+	if (!fpm_channel_dir) {
+		zlog(ZLOG_ERROR, "unable to allocate shared memory for channels");
+		return -1;
+	}
+	memset((void *) fpm_channel_dir, 0, sizeof(struct fpm_channel_dir_s));
+	return 0;
+}
+
+struct fpm_channel_s *fpm_channel_open(const char *name, size_t name_len) /* {{{ */
+{
+	struct fpm_channel_s *channel = NULL;
+	unsigned int i;
+
+	if (!fpm_channel_dir || name_len == 0 || name_len >= FPM_CHANNEL_NAME_MAX) {
+		return NULL;
+	}
+
+	fpm_spinlock(&fpm_channel_dir->lock, 0);
+	for (i = 0; i < FPM_CHANNEL_MAX; i++) {
+		struct fpm_channel_s *slot = &fpm_channel_dir->channels[i];
+		if (slot->used) {
+			if (strlen(slot->name) == name_len && !memcmp(slot->name, name, name_len)) {
+				channel = slot;
+				break;
+			}
+		} else if (!channel) {
+			channel = slot;
+		}
+	}
+	if (channel && !channel->used) {
+		memcpy(channel->name, name, name_len);
+		channel->name[name_len] = '\0';
+		channel->used = 1;
+	}
+	fpm_unlock(fpm_channel_dir->lock);
+
+	return channel;
+}
+/* }}} */
+
+static void fpm_channel_copy_in(struct fpm_channel_s *channel, size_t pos, const char *data, size_t len) /* {{{ */
+{
+	size_t offset = pos % FPM_CHANNEL_SIZE;
+	size_t chunk = FPM_CHANNEL_SIZE - offset;
+
+	if (chunk > len) {
+		chunk = len;
+	}
+	memcpy(channel->data + offset, data, chunk);
+	memcpy(channel->data, data + chunk, len - chunk);
+}
+/* }}} */
+
+static void fpm_channel_copy_out(struct fpm_channel_s *channel, size_t pos, char *data, size_t len) /* {{{ */
+{
+	size_t offset = pos % FPM_CHANNEL_SIZE;
+	size_t chunk = FPM_CHANNEL_SIZE - offset;
+
+	if (chunk > len) {
+		chunk = len;
+	}
+	memcpy(data, channel->data + offset, chunk);
+	memcpy(data + chunk, channel->data, len - chunk);
+}
+/* }}} */
+
+int fpm_channel_try_send(struct fpm_channel_s *channel, const char *data, size_t len) /* {{{ */
+{
+	uint32_t frame_len = (uint32_t) len;
+
+	if (len > FPM_CHANNEL_MSG_MAX) {
+		return -1;
+	}
+
+	fpm_spinlock(&channel->lock, 0);
+	if (FPM_CHANNEL_SIZE - (channel->tail - channel->head) < sizeof(frame_len) + len) {
+		fpm_unlock(channel->lock);
+		return -1;
+	}
+	fpm_channel_copy_in(channel, channel->tail, (const char *) &frame_len, sizeof(frame_len));
+	fpm_channel_copy_in(channel, channel->tail + sizeof(frame_len), data, len);
+	channel->tail += sizeof(frame_len) + len;
+	fpm_unlock(channel->lock);
+
+	return 0;
+}
+/* }}} */
+
+int fpm_channel_try_recv(struct fpm_channel_s *channel, char **data, size_t *len) /* {{{ */
+{
+	uint32_t frame_len;
+	char *buf = NULL;
+
+	fpm_spinlock(&channel->lock, 0);
+	if (channel->tail == channel->head) {
+		fpm_unlock(channel->lock);
+		return -1;
+	}
+	fpm_channel_copy_out(channel, channel->head, (char *) &frame_len, sizeof(frame_len));
+	if (frame_len > 0) {
+		buf = malloc(frame_len);
+		if (!buf) {
+			fpm_unlock(channel->lock);
+			zlog(ZLOG_ERROR, "unable to allocate %u bytes for a channel message", frame_len);
+			return -1;
+		}
+		fpm_channel_copy_out(channel, channel->head + sizeof(frame_len), buf, frame_len);
+	}
+	channel->head += sizeof(frame_len) + frame_len;
+	fpm_unlock(channel->lock);
+
+	*data = buf;
+	*len = frame_len;
+
+	return 0;
+}
+/* }}} */
@@ -0,0 +1,18 @@
+#ifndef FPM_CHANNEL_H
+#define FPM_CHANNEL_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FPM_CHANNEL_NAME_MAX 32
+#define FPM_CHANNEL_SIZE 65536
+#define FPM_CHANNEL_MSG_MAX (FPM_CHANNEL_SIZE - sizeof(uint32_t))
+
+struct fpm_channel_s;
+
+int fpm_channel_init_main(void);
+struct fpm_channel_s *fpm_channel_open(const char *name, size_t name_len);
+int fpm_channel_try_send(struct fpm_channel_s *channel, const char *data, size_t len);
+int fpm_channel_try_recv(struct fpm_channel_s *channel, char **data, size_t *len);
+
+#endif
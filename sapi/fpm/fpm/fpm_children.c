@@ -8,6 +8,9 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+# include <sched.h>
+#endif
 
 #include "fpm.h"
 #include "fpm_children.h"
@@ -185,10 +188,33 @@ static int fpm_child_cloexec(void)
 	return 0;
 }
 
-static void fpm_child_init(struct fpm_worker_pool_s *wp) /* {{{ */
+static void fpm_child_init(struct fpm_worker_pool_s *wp, int child_slot) /* {{{ */
 {
+	int listening_socket = wp->listening_socket;
+
+	/* with listen.shards each child accepts on the listener assigned to its
+	 * scoreboard slot, so the kernel spreads connections between children */
+	if (wp->shard_count > 1 && child_slot >= 0) {
+		listening_socket = wp->shard_sockets[(unsigned)child_slot % wp->shard_count];
+	}
+
+#ifdef HAVE_SCHED_SETAFFINITY
+	/* round-robin by scoreboard slot, so a respawned child replaces its
+	 * predecessor on the same CPU */
+	if (wp->affinity_ncpus > 0 && child_slot >= 0) {
+		int cpu = wp->affinity_cpus[(unsigned)child_slot % wp->affinity_ncpus];
+		cpu_set_t set;
+
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		if (0 > sched_setaffinity(0, sizeof(set), &set)) {
+			zlog(ZLOG_SYSERROR, "[pool %s] failed to pin child to CPU %d", wp->config->name, cpu);
+		}
+	}
+#endif
+
 	fpm_globals.max_requests = wp->config->pm_max_requests;
-	fpm_globals.listening_socket = dup(wp->listening_socket);
+	fpm_globals.listening_socket = dup(listening_socket);
 
 	if (0 > fpm_stdio_init_child(wp)  ||
 	    0 > fpm_log_init_child(wp)    ||
@@ -412,6 +438,7 @@ int fpm_children_make(struct fpm_worker_pool_s *wp, int in_event_loop, int nb_to
 	pid_t pid;
 	struct fpm_child_s *child;
 	int max;
+	int child_slot;
 	static int warned = 0;
 
 	if (wp->config->pm == PM_STYLE_DYNAMIC) {
@@ -446,6 +473,10 @@ int fpm_children_make(struct fpm_worker_pool_s *wp, int in_event_loop, int nb_to
 			return 2;
 		}
 
+		/* fpm_child_resources_use() frees the child struct, so remember the
+		 * slot the forked process will need to pick its listener shard */
+		child_slot = child->scoreboard_i;
+
 		zlog(ZLOG_DEBUG, "blocking signals before child birth");
 		if (0 > fpm_signals_child_block()) {
 			zlog(ZLOG_WARNING, "child may miss signals");
@@ -458,7 +489,7 @@ int fpm_children_make(struct fpm_worker_pool_s *wp, int in_event_loop, int nb_to
 			case 0 :
 				fpm_child_resources_use(child);
 				fpm_globals.is_child = 1;
-				fpm_child_init(wp);
+				fpm_child_init(wp, child_slot);
 				return 0;
 
 			case -1 :
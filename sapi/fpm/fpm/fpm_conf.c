@@ -16,6 +16,9 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+# include <sched.h>
+#endif
 
 #include "php.h"
 #include "zend_ini_scanner.h"
@@ -126,11 +129,18 @@ static const struct ini_value_parser_s ini_fpm_pool_options[] = {
 	{ "listen.group",              &fpm_conf_set_string,      WPO(listen_group) },
 	{ "listen.mode",               &fpm_conf_set_string,      WPO(listen_mode) },
 	{ "listen.allowed_clients",    &fpm_conf_set_string,      WPO(listen_allowed_clients) },
+	{ "listen.max_idle_connections", &fpm_conf_set_integer,   WPO(listen_max_idle_connections) },
 #ifdef SO_SETFIB
 	{ "listen.setfib",             &fpm_conf_set_integer,     WPO(listen_setfib) },
+#endif
+#ifdef SO_REUSEPORT
+	{ "listen.shards",             &fpm_conf_set_integer,     WPO(listen_shards) },
 #endif
 	{ "process.priority",          &fpm_conf_set_integer,     WPO(process_priority) },
 	{ "process.dumpable",          &fpm_conf_set_boolean,     WPO(process_dumpable) },
+#ifdef HAVE_SCHED_SETAFFINITY
+	{ "process.cpu_affinity",      &fpm_conf_set_string,      WPO(process_cpu_affinity) },
+#endif
 	{ "pm",                        &fpm_conf_set_pm,          WPO(pm) },
 	{ "pm.max_children",           &fpm_conf_set_integer,     WPO(pm_max_children) },
 	{ "pm.start_servers",          &fpm_conf_set_integer,     WPO(pm_start_servers) },
@@ -139,6 +149,7 @@ static const struct ini_value_parser_s ini_fpm_pool_options[] = {
 	{ "pm.max_spawn_rate",         &fpm_conf_set_integer,     WPO(pm_max_spawn_rate) },
 	{ "pm.process_idle_timeout",   &fpm_conf_set_time,        WPO(pm_process_idle_timeout) },
 	{ "pm.max_requests",           &fpm_conf_set_integer,     WPO(pm_max_requests) },
+	{ "pm.warmup_script",          &fpm_conf_set_string,      WPO(pm_warmup_script) },
 	{ "pm.status_path",            &fpm_conf_set_string,      WPO(pm_status_path) },
 	{ "pm.status_listen",          &fpm_conf_set_string,      WPO(pm_status_listen) },
 	{ "ping.path",                 &fpm_conf_set_string,      WPO(ping_path) },
@@ -150,6 +161,8 @@ static const struct ini_value_parser_s ini_fpm_pool_options[] = {
 	{ "request_slowlog_trace_depth", &fpm_conf_set_integer,     WPO(request_slowlog_trace_depth) },
 	{ "request_terminate_timeout", &fpm_conf_set_time,        WPO(request_terminate_timeout) },
 	{ "request_terminate_timeout_track_finished", &fpm_conf_set_boolean, WPO(request_terminate_timeout_track_finished) },
+	{ "request_admission_rate",    &fpm_conf_set_integer,     WPO(request_admission_rate) },
+	{ "request_admission_burst",   &fpm_conf_set_integer,     WPO(request_admission_burst) },
 	{ "rlimit_files",              &fpm_conf_set_integer,     WPO(rlimit_files) },
 	{ "rlimit_core",               &fpm_conf_set_rlimit_core, WPO(rlimit_core) },
 	{ "chroot",                    &fpm_conf_set_string,      WPO(chroot) },
@@ -672,6 +685,7 @@ int fpm_worker_pool_config_free(struct fpm_worker_pool_config_s *wpc) /* {{{ */
 	free(wpc->listen_group);
 	free(wpc->listen_mode);
 	free(wpc->listen_allowed_clients);
+	free(wpc->pm_warmup_script);
 	free(wpc->pm_status_path);
 	free(wpc->ping_path);
 	free(wpc->ping_response);
@@ -681,6 +695,9 @@ int fpm_worker_pool_config_free(struct fpm_worker_pool_config_s *wpc) /* {{{ */
 	free(wpc->chroot);
 	free(wpc->chdir);
 	free(wpc->security_limit_extensions);
+#ifdef HAVE_SCHED_SETAFFINITY
+	free(wpc->process_cpu_affinity);
+#endif
 #ifdef HAVE_APPARMOR
 	free(wpc->apparmor_hat);
 #endif
@@ -836,6 +853,90 @@ static int fpm_evaluate_full_path(char **path, struct fpm_worker_pool_s *wp, cha
 }
 /* }}} */
 
+#ifdef HAVE_SCHED_SETAFFINITY
+/* Expand process.cpu_affinity ("auto" or a list such as "0-3,8-11") into the
+ * CPU array fpm_child_init() round-robins the children over. */
+static int fpm_conf_expand_cpu_affinity(struct fpm_worker_pool_s *wp) /* {{{ */
+{
+	char *spec = wp->config->process_cpu_affinity;
+	int *cpus = NULL;
+	unsigned ncpus = 0;
+
+	if (!spec || !*spec) {
+		return 0;
+	}
+
+	if (!strcasecmp(spec, "auto")) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		long i;
+
+		if (online <= 0) {
+			zlog(ZLOG_ERROR, "[pool %s] process.cpu_affinity = auto: unable to determine the number of online CPUs", wp->config->name);
+			return -1;
+		}
+		cpus = malloc(sizeof(int) * online);
+		if (!cpus) {
+			zlog(ZLOG_SYSERROR, "[pool %s] unable to allocate the CPU affinity set", wp->config->name);
+			return -1;
+		}
+		for (i = 0; i < online; i++) {
+			cpus[i] = (int)i;
+		}
+		ncpus = (unsigned)online;
+	} else {
+		char *p = spec;
+
+		while (*p) {
+			char *end;
+			long lo, hi;
+			int *tmp;
+
+			lo = strtol(p, &end, 10);
+			if (end == p || lo < 0 || lo >= CPU_SETSIZE) {
+				goto invalid;
+			}
+			hi = lo;
+			if (*end == '-') {
+				p = end + 1;
+				hi = strtol(p, &end, 10);
+				if (end == p || hi < lo || hi >= CPU_SETSIZE) {
+					goto invalid;
+				}
+			}
+			tmp = realloc(cpus, sizeof(int) * (ncpus + (unsigned)(hi - lo + 1)));
+			if (!tmp) {
+				zlog(ZLOG_SYSERROR, "[pool %s] unable to allocate the CPU affinity set", wp->config->name);
+				free(cpus);
+				return -1;
+			}
+			cpus = tmp;
+			for (; lo <= hi; lo++) {
+				cpus[ncpus++] = (int)lo;
+			}
+			p = end;
+			if (*p == ',') {
+				p++;
+			} else if (*p) {
+				goto invalid;
+			}
+		}
+		if (!ncpus) {
+			goto invalid;
+		}
+	}
+
+	wp->affinity_cpus = cpus;
+	wp->affinity_ncpus = ncpus;
+	return 0;
+
+invalid:
+	free(cpus);
+	zlog(ZLOG_ERROR, "[pool %s] invalid process.cpu_affinity value '%s': expected \"auto\" or a CPU list such as \"0-3,8-11\"", wp->config->name, spec);
+	return -1;
+}
+/* }}} */
+#endif
+
 static int fpm_conf_process_all_pools(void)
 {
 	struct fpm_worker_pool_s *wp, *wp2;
@@ -880,6 +981,13 @@ static int fpm_conf_process_all_pools(void)
 			return -1;
 		}
 
+#ifdef HAVE_SCHED_SETAFFINITY
+		/* process.cpu_affinity */
+		if (0 > fpm_conf_expand_cpu_affinity(wp)) {
+			return -1;
+		}
+#endif
+
 		/* pm */
 		if (wp->config->pm != PM_STYLE_STATIC && wp->config->pm != PM_STYLE_DYNAMIC && wp->config->pm != PM_STYLE_ONDEMAND) {
 			zlog(ZLOG_ALERT, "[pool %s] the process manager is missing (static, dynamic or ondemand)", wp->config->name);
@@ -892,6 +1000,34 @@ static int fpm_conf_process_all_pools(void)
 			return -1;
 		}
 
+		/* listen.max_idle_connections */
+		if (wp->config->listen_max_idle_connections < 0) {
+			zlog(ZLOG_ALERT, "[pool %s] listen.max_idle_connections(%d) must not be negative", wp->config->name, wp->config->listen_max_idle_connections);
+			return -1;
+		}
+
+#ifdef SO_REUSEPORT
+		/* listen.shards */
+		if (wp->config->listen_shards < 0) {
+			zlog(ZLOG_ALERT, "[pool %s] listen.shards(%d) must not be negative", wp->config->name, wp->config->listen_shards);
+			return -1;
+		}
+		if (wp->config->listen_shards > 1) {
+			if (wp->listen_address_domain != FPM_AF_INET) {
+				zlog(ZLOG_ALERT, "[pool %s] listen.shards is only supported for TCP sockets", wp->config->name);
+				return -1;
+			}
+			if (wp->config->pm == PM_STYLE_ONDEMAND) {
+				zlog(ZLOG_ALERT, "[pool %s] listen.shards cannot be used with the ondemand process manager", wp->config->name);
+				return -1;
+			}
+			if (wp->config->listen_shards > wp->config->pm_max_children) {
+				zlog(ZLOG_WARNING, "[pool %s] listen.shards(%d) is greater than pm.max_children(%d), lowering it", wp->config->name, wp->config->listen_shards, wp->config->pm_max_children);
+				wp->config->listen_shards = wp->config->pm_max_children;
+			}
+		}
+#endif
+
 		/* pm.start_servers, pm.min_spare_servers, pm.max_spare_servers, pm.max_spawn_rate */
 		if (wp->config->pm == PM_STYLE_DYNAMIC) {
 			struct fpm_worker_pool_config_s *config = wp->config;
@@ -1097,6 +1233,20 @@ static int fpm_conf_process_all_pools(void)
 			wp->config->request_slowlog_trace_depth = 20;
 		}
 
+		/* request_admission_rate */
+		if (wp->config->request_admission_rate < 0) {
+			zlog(ZLOG_ERROR, "[pool %s] 'request_admission_rate' (%d) must not be negative", wp->config->name, wp->config->request_admission_rate);
+			return -1;
+		}
+		if (wp->config->request_admission_burst < 0) {
+			zlog(ZLOG_ERROR, "[pool %s] 'request_admission_burst' (%d) must not be negative", wp->config->name, wp->config->request_admission_burst);
+			return -1;
+		}
+		if (wp->config->request_admission_burst && !wp->config->request_admission_rate) {
+			zlog(ZLOG_ERROR, "[pool %s] 'request_admission_rate' must be specified for use with 'request_admission_burst'", wp->config->name);
+			return -1;
+		}
+
 		/* chroot */
 		if (wp->config->chroot && *wp->config->chroot) {
 
@@ -1143,6 +1293,17 @@ static int fpm_conf_process_all_pools(void)
 			}
 		}
 
+		/* pm.warmup_script */
+		if (wp->config->pm_warmup_script && *wp->config->pm_warmup_script) {
+
+			fpm_evaluate_full_path(&wp->config->pm_warmup_script, wp, NULL, 0);
+
+			if (*wp->config->pm_warmup_script != '/') {
+				zlog(ZLOG_ERROR, "[pool %s] the warmup script path '%s' must start with a '/'", wp->config->name, wp->config->pm_warmup_script);
+				return -1;
+			}
+		}
+
 		/* security.limit_extensions */
 		if (!wp->config->security_limit_extensions) {
 			wp->config->security_limit_extensions = strdup(".php .phar");
@@ -1776,8 +1937,12 @@ static void fpm_conf_dump(void)
 		zlog(ZLOG_NOTICE, "\tlisten.group = %s",               STR2STR(wp->config->listen_group));
 		zlog(ZLOG_NOTICE, "\tlisten.mode = %s",                STR2STR(wp->config->listen_mode));
 		zlog(ZLOG_NOTICE, "\tlisten.allowed_clients = %s",     STR2STR(wp->config->listen_allowed_clients));
+		zlog(ZLOG_NOTICE, "\tlisten.max_idle_connections = %d", wp->config->listen_max_idle_connections);
 #ifdef SO_SETFIB
 		zlog(ZLOG_NOTICE, "\tlisten.setfib = %d",              wp->config->listen_setfib);
+#endif
+#ifdef SO_REUSEPORT
+		zlog(ZLOG_NOTICE, "\tlisten.shards = %d",              wp->config->listen_shards);
 #endif
 		if (wp->config->process_priority == 64) {
 			zlog(ZLOG_NOTICE, "\tprocess.priority = undefined");
@@ -1785,6 +1950,9 @@ static void fpm_conf_dump(void)
 			zlog(ZLOG_NOTICE, "\tprocess.priority = %d", wp->config->process_priority);
 		}
 		zlog(ZLOG_NOTICE, "\tprocess.dumpable = %s",           BOOL2STR(wp->config->process_dumpable));
+#ifdef HAVE_SCHED_SETAFFINITY
+		zlog(ZLOG_NOTICE, "\tprocess.cpu_affinity = %s",       STR2STR(wp->config->process_cpu_affinity));
+#endif
 		zlog(ZLOG_NOTICE, "\tpm = %s",                         PM2STR(wp->config->pm));
 		zlog(ZLOG_NOTICE, "\tpm.max_children = %d",            wp->config->pm_max_children);
 		zlog(ZLOG_NOTICE, "\tpm.start_servers = %d",           wp->config->pm_start_servers);
@@ -1793,6 +1961,7 @@ static void fpm_conf_dump(void)
 		zlog(ZLOG_NOTICE, "\tpm.max_spawn_rate = %d",          wp->config->pm_max_spawn_rate);
 		zlog(ZLOG_NOTICE, "\tpm.process_idle_timeout = %d",    wp->config->pm_process_idle_timeout);
 		zlog(ZLOG_NOTICE, "\tpm.max_requests = %d",            wp->config->pm_max_requests);
+		zlog(ZLOG_NOTICE, "\tpm.warmup_script = %s",           STR2STR(wp->config->pm_warmup_script));
 		zlog(ZLOG_NOTICE, "\tpm.status_path = %s",             STR2STR(wp->config->pm_status_path));
 		zlog(ZLOG_NOTICE, "\tpm.status_listen = %s",           STR2STR(wp->config->pm_status_listen));
 		zlog(ZLOG_NOTICE, "\tping.path = %s",                  STR2STR(wp->config->ping_path));
@@ -1807,6 +1976,8 @@ static void fpm_conf_dump(void)
 		zlog(ZLOG_NOTICE, "\trequest_slowlog_trace_depth = %d", wp->config->request_slowlog_trace_depth);
 		zlog(ZLOG_NOTICE, "\trequest_terminate_timeout = %ds", wp->config->request_terminate_timeout);
 		zlog(ZLOG_NOTICE, "\trequest_terminate_timeout_track_finished = %s", BOOL2STR(wp->config->request_terminate_timeout_track_finished));
+		zlog(ZLOG_NOTICE, "\trequest_admission_rate = %d",     wp->config->request_admission_rate);
+		zlog(ZLOG_NOTICE, "\trequest_admission_burst = %d",    wp->config->request_admission_burst);
 		zlog(ZLOG_NOTICE, "\trlimit_files = %d",               wp->config->rlimit_files);
 		zlog(ZLOG_NOTICE, "\trlimit_core = %d",                wp->config->rlimit_core);
 		zlog(ZLOG_NOTICE, "\tchroot = %s",                     STR2STR(wp->config->chroot));
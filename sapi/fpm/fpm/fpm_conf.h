@@ -63,8 +63,12 @@ struct fpm_worker_pool_config_s {
 	char *listen_group;
 	char *listen_mode;
 	char *listen_allowed_clients;
+	int listen_max_idle_connections;
 	int process_priority;
 	int process_dumpable;
+#ifdef HAVE_SCHED_SETAFFINITY
+	char *process_cpu_affinity;
+#endif
 	int pm;
 	int pm_max_children;
 	int pm_start_servers;
@@ -73,6 +77,7 @@ struct fpm_worker_pool_config_s {
 	int pm_max_spawn_rate;
 	int pm_process_idle_timeout;
 	int pm_max_requests;
+	char *pm_warmup_script;
 	char *pm_status_path;
 	char *pm_status_listen;
 	char *ping_path;
@@ -85,6 +90,8 @@ struct fpm_worker_pool_config_s {
 	int request_slowlog_trace_depth;
 	int request_terminate_timeout;
 	int request_terminate_timeout_track_finished;
+	int request_admission_rate;
+	int request_admission_burst;
 	int rlimit_files;
 	int rlimit_core;
 	char *chroot;
@@ -107,6 +114,9 @@ struct fpm_worker_pool_config_s {
 #ifdef SO_SETFIB
 	int listen_setfib;
 #endif
+#ifdef SO_REUSEPORT
+	int listen_shards;
+#endif
 };
 
 struct ini_value_parser_s {
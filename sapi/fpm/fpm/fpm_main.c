@@ -86,11 +86,13 @@ int __riscosify_control = __RISCOSIFY_STRICT_UNIX_SPECS;
 #include "fpm_main_arginfo.h"
 #include "fpm_request.h"
 #include "fpm_status.h"
+#include "fpm_scoreboard.h"
 #include "fpm_signals.h"
 #include "fpm_stdio.h"
 #include "fpm_conf.h"
 #include "fpm_php.h"
 #include "fpm_log.h"
+#include "fpm_channel.h"
 #include "zlog.h"
 
 static void (*php_php_import_environment_variables)(zval *array_ptr);
@@ -1449,6 +1451,41 @@ static void php_cgi_globals_ctor(php_cgi_globals_struct *php_cgi_globals)
 }
 /* }}} */
 
+/* {{{ Fpm\Channel object */
+typedef struct _fpm_channel_object {
+	struct fpm_channel_s *channel;
+	zend_object std;
+} fpm_channel_object;
+
+static zend_class_entry *fpm_channel_ce;
+static zend_object_handlers fpm_channel_object_handlers;
+
+/* Polling interval while blocking on a full/empty channel */
+#define FPM_CHANNEL_WAIT_US 100
+
+static zend_always_inline fpm_channel_object *fpm_channel_object_from_obj(zend_object *obj)
+{
+	return (fpm_channel_object *)((char *)(obj) - XtOffsetOf(fpm_channel_object, std));
+}
+
+static zend_object *fpm_channel_object_create(zend_class_entry *ce)
+{
+	fpm_channel_object *intern = zend_object_alloc(sizeof(fpm_channel_object), ce);
+
+	intern->channel = NULL;
+	zend_object_std_init(&intern->std, ce);
+	object_properties_init(&intern->std, ce);
+
+	return &intern->std;
+}
+
+static zend_function *fpm_channel_get_constructor(zend_object *object)
+{
+	zend_throw_error(NULL, "Cannot directly construct Fpm\\Channel, use Fpm\\Channel::open() instead");
+	return NULL;
+}
+/* }}} */
+
 /* {{{ PHP_MINIT_FUNCTION */
 static PHP_MINIT_FUNCTION(cgi)
 {
@@ -1458,6 +1495,16 @@ static PHP_MINIT_FUNCTION(cgi)
 	php_cgi_globals_ctor(&php_cgi_globals);
 #endif
 	REGISTER_INI_ENTRIES();
+
+	memcpy(&fpm_channel_object_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	fpm_channel_object_handlers.offset = XtOffsetOf(fpm_channel_object, std);
+	fpm_channel_object_handlers.get_constructor = fpm_channel_get_constructor;
+	fpm_channel_object_handlers.clone_obj = NULL;
+
+	fpm_channel_ce = register_class_Fpm_Channel();
+	fpm_channel_ce->create_object = fpm_channel_object_create;
+	fpm_channel_ce->default_object_handlers = &fpm_channel_object_handlers;
+
 	return SUCCESS;
 }
 /* }}} */
@@ -1532,6 +1579,100 @@ PHP_FUNCTION(fpm_get_status) /* {{{ */
 }
 /* }}} */
 
+/* {{{ Fpm\Channel */
+ZEND_METHOD(Fpm_Channel, open) /* {{{ */
+{
+	zend_string *name;
+	struct fpm_channel_s *channel;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_STR(name)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (ZSTR_LEN(name) != strlen(ZSTR_VAL(name))) {
+		zend_argument_value_error(1, "must not contain any null bytes");
+		RETURN_THROWS();
+	}
+	if (ZSTR_LEN(name) == 0 || ZSTR_LEN(name) >= FPM_CHANNEL_NAME_MAX) {
+		zend_argument_value_error(1, "must be between 1 and %d bytes long", FPM_CHANNEL_NAME_MAX - 1);
+		RETURN_THROWS();
+	}
+
+	channel = fpm_channel_open(ZSTR_VAL(name), ZSTR_LEN(name));
+	if (!channel) {
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, fpm_channel_ce);
+	fpm_channel_object_from_obj(Z_OBJ_P(return_value))->channel = channel;
+}
+/* }}} */
+
+ZEND_METHOD(Fpm_Channel, send) /* {{{ */
+{
+	zend_string *message;
+	bool blocking = true;
+	struct fpm_channel_s *channel = fpm_channel_object_from_obj(Z_OBJ_P(ZEND_THIS))->channel;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_STR(message)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_BOOL(blocking)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(!channel)) {
+		zend_throw_error(NULL, "Fpm\\Channel object is not initialized");
+		RETURN_THROWS();
+	}
+	if (ZSTR_LEN(message) > FPM_CHANNEL_MSG_MAX) {
+		zend_argument_value_error(1, "must be at most %zu bytes long", (size_t) FPM_CHANNEL_MSG_MAX);
+		RETURN_THROWS();
+	}
+
+	while (fpm_channel_try_send(channel, ZSTR_VAL(message), ZSTR_LEN(message)) != 0) {
+		if (!blocking || zend_atomic_bool_load_ex(&EG(vm_interrupt))) {
+			RETURN_FALSE;
+		}
+		usleep(FPM_CHANNEL_WAIT_US);
+	}
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+ZEND_METHOD(Fpm_Channel, recv) /* {{{ */
+{
+	bool blocking = true;
+	char *data;
+	size_t len;
+	struct fpm_channel_s *channel = fpm_channel_object_from_obj(Z_OBJ_P(ZEND_THIS))->channel;
+
+	ZEND_PARSE_PARAMETERS_START(0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_BOOL(blocking)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(!channel)) {
+		zend_throw_error(NULL, "Fpm\\Channel object is not initialized");
+		RETURN_THROWS();
+	}
+
+	while (fpm_channel_try_recv(channel, &data, &len) != 0) {
+		if (!blocking || zend_atomic_bool_load_ex(&EG(vm_interrupt))) {
+			RETURN_FALSE;
+		}
+		usleep(FPM_CHANNEL_WAIT_US);
+	}
+
+	if (!data) {
+		RETURN_EMPTY_STRING();
+	}
+	RETVAL_STRINGL(data, len);
+	free(data);
+}
+/* }}} */
+/* }}} */
+
 static zend_module_entry cgi_module_entry = {
 	STANDARD_MODULE_HEADER,
 	"cgi-fcgi",
@@ -1844,6 +1985,10 @@ consult the installation file that came with this distribution, or visit \n\
 	}
 	fpm_is_running = 1;
 
+	/* share resolved paths across the pool's workers; mapped before the
+	 * fork in fpm_run() so all children see one cache */
+	realpath_cache_share(4096);
+
 	fcgi_fd = fpm_run(&max_requests);
 	parent = 0;
 
@@ -1858,6 +2003,9 @@ consult the installation file that came with this distribution, or visit \n\
 	/* library is already initialized, now init our request */
 	request = fpm_init_request(fcgi_fd);
 
+	/* warm the heap, realpath cache and opcode caches before serving traffic */
+	fpm_php_execute_warmup_script();
+
 	zend_first_try {
 		while (EXPECTED(fcgi_accept_request(request) >= 0)) {
 			char *primary_script = NULL;
@@ -1887,6 +2035,17 @@ consult the installation file that came with this distribution, or visit \n\
 				goto fastcgi_request_done;
 			}
 
+			/* admission control: one shared token bucket operation; anything
+			 * past the configured rate is answered before any script work */
+			if (UNEXPECTED(!fpm_scoreboard_admission_acquire())) {
+				zend_try {
+					SG(sapi_headers).http_response_code = 503;
+					PUTS("Service unavailable.\n");
+				} zend_catch {
+				} zend_end_try();
+				goto fastcgi_request_done;
+			}
+
 			/* If path_translated is NULL, terminate here with a 404 */
 			if (UNEXPECTED(!SG(request_info).path_translated)) {
 				zend_try {
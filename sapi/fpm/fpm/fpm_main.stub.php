@@ -2,11 +2,28 @@
 
 /** @generate-class-entries */
 
-function fastcgi_finish_request(): bool {}
+namespace {
+	function fastcgi_finish_request(): bool {}
 
-function apache_request_headers(): array {}
+	function apache_request_headers(): array {}
 
-/** @alias apache_request_headers */
-function getallheaders(): array {}
+	/** @alias apache_request_headers */
+	function getallheaders(): array {}
 
-function fpm_get_status(): array|false {}
+	function fpm_get_status(): array|false {}
+}
+
+namespace Fpm {
+	/**
+	 * @strict-properties
+	 * @not-serializable
+	 */
+	final class Channel
+	{
+		public static function open(string $name): ?Channel {}
+
+		public function send(string $message, bool $blocking = true): bool {}
+
+		public function recv(bool $blocking = true): string|false {}
+	}
+}
@@ -20,6 +20,7 @@
 #include "zlog.h"
 
 static char **limit_extensions = NULL;
+static char *warmup_script = NULL;
 
 static int fpm_php_zend_ini_alter_master(char *name, int name_length, char *new_value, int new_value_length, int mode, int stage) /* {{{ */
 {
@@ -239,10 +240,45 @@ int fpm_php_init_child(struct fpm_worker_pool_s *wp) /* {{{ */
 		limit_extensions = wp->limit_extensions;
 		wp->limit_extensions = NULL;
 	}
+
+	if (wp->config->pm_warmup_script && *wp->config->pm_warmup_script) {
+		warmup_script = strdup(wp->config->pm_warmup_script);
+	}
+
+	if (wp->config->listen_max_idle_connections > 0) {
+		fcgi_set_max_idle_connections((unsigned int)wp->config->listen_max_idle_connections);
+	}
 	return 0;
 }
 /* }}} */
 
+void fpm_php_execute_warmup_script(void) /* {{{ */
+{
+	zend_file_handle file_handle;
+
+	if (!warmup_script) {
+		return;
+	}
+
+	if (php_request_startup() == FAILURE) {
+		zlog(ZLOG_WARNING, "failed to run the warmup script '%s': request startup failed", warmup_script);
+		return;
+	}
+
+	/* There is no FastCGI request yet, so anything the script prints has
+	 * nowhere to go; swallow it. */
+	php_output_start_devnull();
+
+	zend_stream_init_filename(&file_handle, warmup_script);
+	if (php_execute_simple_script(&file_handle, NULL) != 0) {
+		zlog(ZLOG_WARNING, "the warmup script '%s' exited with a non-zero status", warmup_script);
+	}
+	zend_destroy_file_handle(&file_handle);
+
+	php_request_shutdown((void *) 0);
+}
+/* }}} */
+
 int fpm_php_limit_extensions(char *path) /* {{{ */
 {
 	char **p;
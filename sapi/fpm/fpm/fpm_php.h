@@ -31,6 +31,7 @@
 struct fpm_worker_pool_s;
 
 int fpm_php_init_child(struct fpm_worker_pool_s *wp);
+void fpm_php_execute_warmup_script(void);
 char *fpm_php_script_filename(void);
 char *fpm_php_request_uri(void);
 char *fpm_php_request_method(void);
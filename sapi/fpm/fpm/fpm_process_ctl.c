@@ -6,6 +6,9 @@
 #include <signal.h>
 #include <unistd.h>
 #include <stdlib.h>
+#ifdef HAVE_DTRACE
+# include <sys/sdt.h>
+#endif
 
 #include "fpm.h"
 #include "fpm_clock.h"
@@ -335,6 +338,7 @@ static void fpm_pctl_perform_idle_server_maintenance(struct timeval *now) /* {{{
 		int active = 0;
 		int children_to_fork;
 		unsigned cur_lq = 0;
+		unsigned i;
 
 		if (wp->config == NULL) continue;
 
@@ -354,6 +358,15 @@ static void fpm_pctl_perform_idle_server_maintenance(struct timeval *now) /* {{{
 				}
 #endif
 			}
+
+			/* with listen.shards every listener has its own accept queue */
+			for (i = 1; i < wp->shard_count; i++) {
+				unsigned shard_lq = 0;
+
+				if (0 <= fpm_socket_get_listening_queue(wp->shard_sockets[i], &shard_lq, NULL)) {
+					cur_lq += shard_lq;
+				}
+			}
 		}
 
 		fpm_scoreboard_update_begin(wp->scoreboard);
@@ -373,6 +386,10 @@ static void fpm_pctl_perform_idle_server_maintenance(struct timeval *now) /* {{{
 			}
 		}
 
+#ifdef HAVE_DTRACE
+		DTRACE_PROBE4(php, fpm__queue__depth, wp->config->name, cur_lq, idle, active);
+#endif
+
 		fpm_scoreboard_update_commit(idle, active, cur_lq, -1, -1, -1, 0, FPM_SCOREBOARD_ACTION_SET, wp->scoreboard);
 
 		/* this is specific to PM_STYLE_ONDEMAND */
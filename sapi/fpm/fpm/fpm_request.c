@@ -1,6 +1,9 @@
 	/* (c) 2007,2008 Andrei Nigmatulin */
 #ifdef HAVE_TIMES
 #include <sys/times.h>
+#ifdef HAVE_DTRACE
+# include <sys/sdt.h>
+#endif
 #endif
 
 #include "fpm_config.h"
@@ -99,6 +102,10 @@ void fpm_request_reading_headers(void)
 
 	/* idle--, active++, request++ */
 	fpm_scoreboard_update_commit(-1, 1, 0, 0, 1, 0, 0, FPM_SCOREBOARD_ACTION_INC, NULL);
+
+#ifdef HAVE_DTRACE
+	DTRACE_PROBE(php, fpm__request__accepted);
+#endif
 }
 
 void fpm_request_info(void)
@@ -153,7 +160,8 @@ void fpm_request_info(void)
 void fpm_request_executing(void)
 {
 	struct fpm_scoreboard_proc_s *proc;
-	struct timeval now;
+	struct fpm_scoreboard_s *scoreboard;
+	struct timeval now, queue_wait;
 
 	fpm_clock_get(&now);
 
@@ -165,12 +173,21 @@ void fpm_request_executing(void)
 
 	proc->request_stage = FPM_REQUEST_EXECUTING;
 	proc->tv = now;
+	timersub(&now, &proc->accepted, &queue_wait);
 	fpm_scoreboard_proc_release(proc);
+
+	scoreboard = fpm_scoreboard_get();
+	if (scoreboard) {
+		fpm_scoreboard_histogram_record(&scoreboard->hist_queue_wait,
+			(unsigned long) queue_wait.tv_sec * 1000000 + queue_wait.tv_usec);
+	}
 }
 
 void fpm_request_end(void)
 {
 	struct fpm_scoreboard_proc_s *proc;
+	struct fpm_scoreboard_s *scoreboard;
+	struct timeval duration;
 	struct timeval now;
 #ifdef HAVE_TIMES
 	struct tms cpu;
@@ -198,7 +215,21 @@ void fpm_request_end(void)
 	proc->last_request_cpu.tms_cstime = cpu.tms_cstime - proc->cpu_accepted.tms_cstime;
 #endif
 	proc->memory = memory;
+#ifdef HAVE_DTRACE
+	DTRACE_PROBE3(php, fpm__request__finished,
+		proc->request_uri,
+		(unsigned long) proc->duration.tv_sec * 1000000 + proc->duration.tv_usec,
+		memory);
+#endif
+	duration = proc->duration;
 	fpm_scoreboard_proc_release(proc);
+
+	scoreboard = fpm_scoreboard_get();
+	if (scoreboard) {
+		fpm_scoreboard_histogram_record(&scoreboard->hist_duration,
+			(unsigned long) duration.tv_sec * 1000000 + duration.tv_usec);
+		fpm_scoreboard_histogram_record(&scoreboard->hist_memory, memory);
+	}
 }
 
 void fpm_request_finished(void)
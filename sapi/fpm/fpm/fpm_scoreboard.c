@@ -86,6 +86,24 @@ static struct fpm_scoreboard_s *fpm_scoreboard_get_for_update(struct fpm_scorebo
 }
 /* }}} */
 
+void fpm_scoreboard_histogram_record(struct fpm_scoreboard_histogram_s *hist, unsigned long value) /* {{{ */
+{
+	unsigned int bucket = 0;
+	unsigned long v = value;
+
+	while (v >>= 1) {
+		bucket++;
+	}
+	if (bucket >= FPM_SCOREBOARD_HISTOGRAM_BUCKETS) {
+		bucket = FPM_SCOREBOARD_HISTOGRAM_BUCKETS - 1;
+	}
+
+	fpm_atomic_add(&hist->buckets[bucket], 1);
+	fpm_atomic_add(&hist->count, 1);
+	fpm_atomic_add(&hist->sum, value);
+}
+/* }}} */
+
 void fpm_scoreboard_update_begin(struct fpm_scoreboard_s *scoreboard) /* {{{ */
 {
 	scoreboard = fpm_scoreboard_get_for_update(scoreboard);
@@ -94,6 +112,7 @@ void fpm_scoreboard_update_begin(struct fpm_scoreboard_s *scoreboard) /* {{{ */
 	}
 
 	fpm_spinlock(&scoreboard->lock, 0);
+	fpm_seqlock_bump(&scoreboard->seq);
 }
 /* }}} */
 
@@ -170,6 +189,7 @@ void fpm_scoreboard_update_commit(
 		scoreboard->active_max = scoreboard->active;
 	}
 
+	fpm_seqlock_bump(&scoreboard->seq);
 	fpm_unlock(scoreboard->lock);
 }
 /* }}} */
@@ -256,6 +276,65 @@ void fpm_scoreboard_release(struct fpm_scoreboard_s *scoreboard) {
 	scoreboard->lock = 0;
 }
 
+/* give up on a snapshot after that many torn reads in a row */
+#define FPM_SCOREBOARD_SNAPSHOT_RETRIES 64
+
+/* Copy the pool counters without taking the lock: readers poll the sequence
+ * counter around the copy and retry while a writer is in progress, so status
+ * requests never stall request accounting in the workers. */
+int fpm_scoreboard_snapshot(struct fpm_scoreboard_s *scoreboard, struct fpm_scoreboard_s *copy) /* {{{ */
+{
+	unsigned int tries = 0;
+
+	if (!scoreboard) {
+		scoreboard = fpm_scoreboard;
+	}
+	if (!scoreboard) {
+		return -1;
+	}
+
+	do {
+		atomic_uint_t seq = fpm_seqlock_read_begin(&scoreboard->seq);
+
+		if (!(seq & 1)) {
+			memcpy(copy, scoreboard, sizeof(struct fpm_scoreboard_s));
+			if (fpm_seqlock_read_verify(&scoreboard->seq, seq)) {
+				return 0;
+			}
+		}
+		sched_yield();
+	} while (++tries < FPM_SCOREBOARD_SNAPSHOT_RETRIES);
+
+	return -1;
+}
+/* }}} */
+
+int fpm_scoreboard_proc_snapshot(struct fpm_scoreboard_s *scoreboard, int child_index, struct fpm_scoreboard_proc_s *copy) /* {{{ */
+{
+	struct fpm_scoreboard_proc_s *proc;
+	unsigned int tries = 0;
+
+	proc = fpm_scoreboard_proc_get(scoreboard, child_index);
+	if (!proc) {
+		return -1;
+	}
+
+	do {
+		atomic_uint_t seq = fpm_seqlock_read_begin(&proc->seq);
+
+		if (!(seq & 1)) {
+			memcpy(copy, proc, sizeof(struct fpm_scoreboard_proc_s));
+			if (fpm_seqlock_read_verify(&proc->seq, seq)) {
+				return 0;
+			}
+		}
+		sched_yield();
+	} while (++tries < FPM_SCOREBOARD_SNAPSHOT_RETRIES);
+
+	return -1;
+}
+/* }}} */
+
 struct fpm_scoreboard_s *fpm_scoreboard_copy(struct fpm_scoreboard_s *scoreboard, int copy_procs)
 {
 	struct fpm_scoreboard_s *scoreboard_copy;
@@ -284,27 +363,23 @@ struct fpm_scoreboard_s *fpm_scoreboard_copy(struct fpm_scoreboard_s *scoreboard
 
 	scoreboard_copy = mem;
 
-	scoreboard = fpm_scoreboard_acquire(scoreboard, FPM_SCOREBOARD_LOCK_NOHANG);
-	if (!scoreboard) {
+	if (fpm_scoreboard_snapshot(scoreboard, scoreboard_copy) < 0) {
 		free(mem);
-		zlog(ZLOG_ERROR, "scoreboard: failed to lock (already locked)");
+		zlog(ZLOG_ERROR, "scoreboard: failed to take a consistent snapshot");
 		return NULL;
 	}
 
-	*scoreboard_copy = *scoreboard;
-
 	if (copy_procs) {
-		mem += scoreboard_size;
-
-		for (i = 0; i < scoreboard->nprocs; i++, mem += sizeof(struct fpm_scoreboard_proc_s)) {
-			scoreboard_proc_p = fpm_scoreboard_proc_acquire(scoreboard, i, FPM_SCOREBOARD_LOCK_HANG);
-			scoreboard_copy->procs[i] = *scoreboard_proc_p;
-			fpm_scoreboard_proc_release(scoreboard_proc_p);
+		for (i = 0; i < scoreboard->nprocs; i++) {
+			scoreboard_proc_p = &scoreboard_copy->procs[i];
+			if (fpm_scoreboard_proc_snapshot(scoreboard, i, scoreboard_proc_p) < 0) {
+				free(mem);
+				zlog(ZLOG_ERROR, "scoreboard: failed to take a consistent snapshot of proc %d", i);
+				return NULL;
+			}
 		}
 	}
 
-	fpm_scoreboard_release(scoreboard);
-
 	return scoreboard_copy;
 }
 
@@ -326,6 +401,7 @@ struct fpm_scoreboard_proc_s *fpm_scoreboard_proc_acquire(struct fpm_scoreboard_
 		return NULL;
 	}
 
+	fpm_seqlock_bump(&proc->seq);
 	return proc;
 }
 /* }}} */
@@ -336,6 +412,7 @@ void fpm_scoreboard_proc_release(struct fpm_scoreboard_proc_s *proc) /* {{{ */
 		return;
 	}
 
+	fpm_seqlock_bump(&proc->seq);
 	proc->lock = 0;
 }
 
@@ -360,6 +437,7 @@ void fpm_scoreboard_child_use(struct fpm_child_s *child, pid_t pid) /* {{{ */
 	struct fpm_scoreboard_proc_s *proc;
 	fpm_scoreboard = child->wp->scoreboard;
 	fpm_scoreboard_i = child->scoreboard_i;
+	fpm_scoreboard_admission_init(child->wp);
 	proc = fpm_scoreboard_proc_get_from_child(child);
 	if (!proc) {
 		return;
@@ -369,6 +447,60 @@ void fpm_scoreboard_child_use(struct fpm_child_s *child, pid_t pid) /* {{{ */
 }
 /* }}} */
 
+/* Admission rate limiter: a token bucket per pool, kept in the scoreboard as
+ * a single GCRA "theoretical arrival time" and updated with one
+ * compare-and-swap per decision.  Virtual time runs in microseconds where
+ * atomics are 64 bit and in milliseconds on 32-bit platforms (where the
+ * ~49-day wrap can at worst let one extra burst through). */
+static atomic_uint_t admission_tick = 0;  /* virtual time cost of one request */
+static atomic_uint_t admission_tau = 0;   /* burst allowance */
+static atomic_uint_t admission_scale = 0; /* virtual time ticks per second */
+
+void fpm_scoreboard_admission_init(struct fpm_worker_pool_s *wp) /* {{{ */
+{
+	int rate = wp->config->request_admission_rate;
+	int burst = wp->config->request_admission_burst;
+
+	if (rate <= 0) {
+		admission_tick = 0;
+		return;
+	}
+	admission_scale = sizeof(atomic_uint_t) >= 8 ? 1000000 : 1000;
+	admission_tick = admission_scale / (atomic_uint_t) rate;
+	if (!admission_tick) {
+		admission_tick = 1;
+	}
+	admission_tau = (atomic_uint_t) (burst > 0 ? burst : rate) * admission_tick;
+}
+/* }}} */
+
+int fpm_scoreboard_admission_acquire(void) /* {{{ */
+{
+	struct timeval tv;
+	atomic_uint_t now, tat, new_tat;
+
+	if (!admission_tick || !fpm_scoreboard) {
+		return 1;
+	}
+
+	fpm_clock_get(&tv);
+	now = (atomic_uint_t) tv.tv_sec * admission_scale
+		+ (atomic_uint_t) tv.tv_usec / (1000000 / admission_scale);
+
+	for (;;) {
+		tat = fpm_scoreboard->admission_tat;
+		if (tat > now && tat - now > admission_tau) {
+			/* over budget; the deny path doesn't touch shared state */
+			return 0;
+		}
+		new_tat = (tat > now ? tat : now) + admission_tick;
+		if (atomic_cmp_set(&fpm_scoreboard->admission_tat, tat, new_tat)) {
+			return 1;
+		}
+	}
+}
+/* }}} */
+
 void fpm_scoreboard_proc_free(struct fpm_child_s *child) /* {{{ */
 {
 	struct fpm_worker_pool_s *wp = child->wp;
@@ -18,11 +18,24 @@
 #define FPM_SCOREBOARD_LOCK_HANG 0
 #define FPM_SCOREBOARD_LOCK_NOHANG 1
 
+#define FPM_SCOREBOARD_HISTOGRAM_BUCKETS 28
+
+/* Fixed log2 bucket histogram updated lock-free by the children: bucket i
+ * counts values in [2^i, 2^(i+1)) (microseconds or bytes), the last bucket
+ * absorbs everything larger. */
+struct fpm_scoreboard_histogram_s {
+	atomic_t buckets[FPM_SCOREBOARD_HISTOGRAM_BUCKETS];
+	atomic_t count;
+	atomic_t sum;
+};
+
 struct fpm_scoreboard_proc_s {
 	union {
 		atomic_t lock;
 		char dummy[16];
 	};
+	/* odd while a writer holds the lock; readers snapshot without locking */
+	atomic_t seq;
 	int used;
 	time_t start_epoch;
 	pid_t pid;
@@ -52,6 +65,8 @@ struct fpm_scoreboard_s {
 		atomic_t lock;
 		char dummy[16];
 	};
+	/* odd while a writer holds the lock; readers snapshot without locking */
+	atomic_t seq;
 	char pool[32];
 	int pm;
 	time_t start_epoch;
@@ -66,6 +81,12 @@ struct fpm_scoreboard_s {
 	unsigned int nprocs;
 	int free_proc;
 	unsigned long int slow_rq;
+	/* theoretical arrival time of the admission rate limiter (GCRA), in
+	 * ticks; see fpm_scoreboard_admission_acquire() */
+	atomic_t admission_tat;
+	struct fpm_scoreboard_histogram_s hist_duration;   /* request duration, microseconds */
+	struct fpm_scoreboard_histogram_s hist_queue_wait; /* accept to execution start, microseconds */
+	struct fpm_scoreboard_histogram_s hist_memory;     /* per-request peak memory, bytes */
 	struct fpm_scoreboard_s *shared;
 	struct fpm_scoreboard_proc_s procs[] ZEND_ELEMENT_COUNT(nprocs);
 };
@@ -73,6 +94,8 @@ struct fpm_scoreboard_s {
 int fpm_scoreboard_init_main(void);
 int fpm_scoreboard_init_child(struct fpm_worker_pool_s *wp);
 
+void fpm_scoreboard_histogram_record(struct fpm_scoreboard_histogram_s *hist, unsigned long value);
+
 void fpm_scoreboard_update_begin(struct fpm_scoreboard_s *scoreboard);
 void fpm_scoreboard_update_commit(int idle, int active, int lq, int lq_len, int requests, int max_children_reached, int slow_rq, int action, struct fpm_scoreboard_s *scoreboard);
 void fpm_scoreboard_update(int idle, int active, int lq, int lq_len, int requests, int max_children_reached, int slow_rq, int action, struct fpm_scoreboard_s *scoreboard);
@@ -90,9 +113,15 @@ void fpm_scoreboard_free(struct fpm_worker_pool_s *wp);
 
 void fpm_scoreboard_child_use(struct fpm_child_s *child, pid_t pid);
 
+void fpm_scoreboard_admission_init(struct fpm_worker_pool_s *wp);
+int fpm_scoreboard_admission_acquire(void);
+
 void fpm_scoreboard_proc_free(struct fpm_child_s *child);
 int fpm_scoreboard_proc_alloc(struct fpm_child_s *child);
 
+int fpm_scoreboard_snapshot(struct fpm_scoreboard_s *scoreboard, struct fpm_scoreboard_s *copy);
+int fpm_scoreboard_proc_snapshot(struct fpm_scoreboard_s *scoreboard, int child_index, struct fpm_scoreboard_proc_s *copy);
+
 struct fpm_scoreboard_s *fpm_scoreboard_copy(struct fpm_scoreboard_s *scoreboard, int copy_procs);
 void fpm_scoreboard_free_copy(struct fpm_scoreboard_s *scoreboard);
 
@@ -43,6 +43,12 @@ enum { FPM_GET_USE_SOCKET = 1, FPM_STORE_SOCKET = 2, FPM_STORE_USE_SOCKET = 3 };
 static int routemax = -1;
 #endif
 
+#ifdef SO_REUSEPORT
+/* Shard currently being created; suffixes the socket hash key so each
+ * SO_REUSEPORT listener of a pool keeps its own slot across reloads. */
+static unsigned shard_no = 0;
+#endif
+
 static inline void fpm_sockets_get_env_name(char *envname, unsigned idx) /* {{{ */
 {
 	if (!idx) {
@@ -141,9 +147,14 @@ static int fpm_sockets_hash_op(int sock, struct sockaddr *sa, char *key, int typ
 	if (key == NULL) {
 		switch (type) {
 			case FPM_AF_INET : {
-				key = alloca(INET6_ADDRSTRLEN+10);
+				key = alloca(INET6_ADDRSTRLEN+22);
 				inet_ntop(sa->sa_family, fpm_get_in_addr(sa), key, INET6_ADDRSTRLEN);
 				sprintf(key+strlen(key), ":%d", fpm_get_in_port(sa));
+#ifdef SO_REUSEPORT
+				if (shard_no) {
+					sprintf(key+strlen(key), "#%u", shard_no);
+				}
+#endif
 				break;
 			}
 
@@ -218,6 +229,14 @@ static int fpm_sockets_new_listening_socket(struct fpm_worker_pool_s *wp, struct
 		zlog(ZLOG_WARNING, "failed to change socket attribute");
 	}
 
+#ifdef SO_REUSEPORT
+	if (wp->config->listen_shards > 1) {
+		if (0 > setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &flags, sizeof(flags))) {
+			zlog(ZLOG_WARNING, "failed to change socket SO_REUSEPORT attribute");
+		}
+	}
+#endif
+
 	if (wp->listen_address_domain == FPM_AF_UNIX) {
 		if (fpm_socket_unix_test_connect((struct sockaddr_un *)sa, socklen) == 0) {
 			zlog(ZLOG_ERROR, "Another FPM instance seems to already listen on %s", ((struct sockaddr_un *) sa)->sun_path);
@@ -420,6 +439,37 @@ static int fpm_socket_af_unix_listening_socket(struct fpm_worker_pool_s *wp) /*
 }
 /* }}} */
 
+#ifdef SO_REUSEPORT
+static int fpm_sockets_shards_init(struct fpm_worker_pool_s *wp) /* {{{ */
+{
+	unsigned i, count = (unsigned)wp->config->listen_shards;
+
+	wp->shard_sockets = malloc(sizeof(int) * count);
+	if (!wp->shard_sockets) {
+		zlog(ZLOG_ERROR, "[pool %s] unable to malloc shard socket list", wp->config->name);
+		return -1;
+	}
+
+	/* the pool socket doubles as shard 0; the kernel balances incoming
+	 * connections across all listeners bound to the same address */
+	wp->shard_sockets[0] = wp->listening_socket;
+	for (i = 1; i < count; i++) {
+		shard_no = i;
+		wp->shard_sockets[i] = fpm_socket_af_inet_listening_socket(wp);
+		shard_no = 0;
+
+		if (wp->shard_sockets[i] == -1) {
+			zlog(ZLOG_ERROR, "[pool %s] unable to create listener for shard %u", wp->config->name, i);
+			return -1;
+		}
+	}
+	wp->shard_count = count;
+
+	return 0;
+}
+/* }}} */
+#endif
+
 #ifdef SO_SETFIB
 static zend_result fpm_socket_setfib_init(void)
 {
@@ -498,6 +548,12 @@ int fpm_sockets_init_main(void)
 		switch (wp->listen_address_domain) {
 			case FPM_AF_INET :
 				wp->listening_socket = fpm_socket_af_inet_listening_socket(wp);
+#ifdef SO_REUSEPORT
+				if (wp->listening_socket != -1 && wp->config->listen_shards > 1
+						&& 0 > fpm_sockets_shards_init(wp)) {
+					return -1;
+				}
+#endif
 				break;
 
 			case FPM_AF_UNIX :
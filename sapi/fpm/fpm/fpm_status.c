@@ -45,6 +45,25 @@ int fpm_status_init_child(struct fpm_worker_pool_s *wp) /* {{{ */
 }
 /* }}} */
 
+static void fpm_status_export_histogram_to_zval(zval *status, const char *key, struct fpm_scoreboard_histogram_s *hist) /* {{{ */
+{
+	zval histogram, buckets;
+	unsigned int i;
+
+	array_init(&histogram);
+	add_assoc_long(&histogram, "count", hist->count);
+	add_assoc_long(&histogram, "sum", hist->sum);
+
+	array_init(&buckets);
+	for (i = 0; i < FPM_SCOREBOARD_HISTOGRAM_BUCKETS; i++) {
+		add_next_index_long(&buckets, hist->buckets[i]);
+	}
+	add_assoc_zval(&histogram, "buckets", &buckets);
+
+	add_assoc_zval(status, key, &histogram);
+}
+/* }}} */
+
 int fpm_status_export_to_zval(zval *status)
 {
 	struct fpm_scoreboard_s scoreboard, *scoreboard_p;
@@ -54,27 +73,26 @@ int fpm_status_export_to_zval(zval *status)
 	double cpu;
 	int i;
 
-	scoreboard_p = fpm_scoreboard_acquire(NULL, 1);
+	scoreboard_p = fpm_scoreboard_get();
 	if (!scoreboard_p) {
-		zlog(ZLOG_NOTICE, "[pool (unknown)] status: scoreboard already in use.");
+		zlog(ZLOG_NOTICE, "[pool (unknown)] status: scoreboard not found.");
 		return -1;
 	}
 
-	/* copy the scoreboard not to bother other processes */
-	scoreboard = *scoreboard_p;
+	/* snapshot the scoreboard not to bother other processes */
+	if (fpm_scoreboard_snapshot(scoreboard_p, &scoreboard) < 0) {
+		zlog(ZLOG_NOTICE, "[pool (unknown)] status: unable to take a consistent scoreboard snapshot.");
+		return -1;
+	}
 	struct fpm_scoreboard_proc_s procs[scoreboard.nprocs];
 
 	struct fpm_scoreboard_proc_s *proc_p;
 	for(i=0; i<scoreboard.nprocs; i++) {
-		proc_p = fpm_scoreboard_proc_acquire(scoreboard_p, i, 1);
-		if (!proc_p){
+		if (fpm_scoreboard_proc_snapshot(scoreboard_p, i, &procs[i]) < 0) {
 			procs[i].used=-1;
 			continue;
 		}
-		procs[i] = *proc_p;
-		fpm_scoreboard_proc_release(proc_p);
 	}
-	fpm_scoreboard_release(scoreboard_p);
 
 	now_epoch = time(NULL);
 	fpm_clock_get(&now);
@@ -94,6 +112,9 @@ int fpm_status_export_to_zval(zval *status)
 	add_assoc_long(status, "max-active-processes", scoreboard.active_max);
 	add_assoc_long(status, "max-children-reached", scoreboard.max_children_reached);
 	add_assoc_long(status, "slow-requests", scoreboard.slow_rq);
+	fpm_status_export_histogram_to_zval(status, "request-duration-histogram", &scoreboard.hist_duration);
+	fpm_status_export_histogram_to_zval(status, "queue-wait-histogram", &scoreboard.hist_queue_wait);
+	fpm_status_export_histogram_to_zval(status, "request-memory-histogram", &scoreboard.hist_memory);
 
 	array_init(&fpm_proc_stats);
 	for(i=0; i<scoreboard.nprocs; i++) {
@@ -135,6 +156,26 @@ int fpm_status_export_to_zval(zval *status)
 }
 /* }}} */
 
+static void fpm_status_json_print_histogram(const char *name, struct fpm_scoreboard_histogram_s *hist, int first) /* {{{ */
+{
+	char *buffer;
+	unsigned int i;
+
+	spprintf(&buffer, 0, "%s\"%s\":{\"count\":%lu,\"sum\":%lu,\"buckets\":[",
+		first ? "" : ",", name, (unsigned long) hist->count, (unsigned long) hist->sum);
+	PUTS(buffer);
+	efree(buffer);
+
+	for (i = 0; i < FPM_SCOREBOARD_HISTOGRAM_BUCKETS; i++) {
+		spprintf(&buffer, 0, "%s%lu", i ? "," : "", (unsigned long) hist->buckets[i]);
+		PUTS(buffer);
+		efree(buffer);
+	}
+
+	PUTS("]}");
+}
+/* }}} */
+
 int fpm_status_handle_request(void) /* {{{ */
 {
 	struct fpm_scoreboard_s *scoreboard_p;
@@ -518,6 +559,16 @@ int fpm_status_handle_request(void) /* {{{ */
 		efree(buffer);
 		zend_string_release_ex(_GET_str, 0);
 
+		if (encode_json) {
+			/* log2 bucket histograms accumulated since the pool started;
+			 * durations in microseconds, memory in bytes */
+			PUTS(",\"histograms\":{");
+			fpm_status_json_print_histogram("request duration", &scoreboard_p->hist_duration, 1);
+			fpm_status_json_print_histogram("queue wait", &scoreboard_p->hist_queue_wait, 0);
+			fpm_status_json_print_histogram("request memory", &scoreboard_p->hist_memory, 0);
+			PUTS("}");
+		}
+
 		if (short_post) {
 			PUTS(short_post);
 		}
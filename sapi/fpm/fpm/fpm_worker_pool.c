@@ -43,6 +43,14 @@ void fpm_worker_pool_free(struct fpm_worker_pool_s *wp) /* {{{ */
 	if (wp->limit_extensions) {
 		fpm_worker_pool_free_limit_extensions(wp->limit_extensions);
 	}
+	if (wp->shard_sockets) {
+		free(wp->shard_sockets);
+	}
+#ifdef HAVE_SCHED_SETAFFINITY
+	if (wp->affinity_cpus) {
+		free(wp->affinity_cpus);
+	}
+#endif
 	fpm_unix_free_socket_permissions(wp);
 	free(wp);
 }
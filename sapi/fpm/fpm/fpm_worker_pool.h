@@ -23,6 +23,12 @@ struct fpm_worker_pool_s {
 	char *user, *home;									/* for setting env USER and HOME */
 	enum fpm_address_domain listen_address_domain;
 	int listening_socket;
+	int *shard_sockets;									/* SO_REUSEPORT listeners; [0] aliases listening_socket */
+	unsigned shard_count;								/* 0 unless listen.shards > 1 */
+#ifdef HAVE_SCHED_SETAFFINITY
+	int *affinity_cpus;									/* expanded process.cpu_affinity set */
+	unsigned affinity_ncpus;							/* 0 unless process.cpu_affinity is set */
+#endif
 	int set_uid, set_gid;								/* config uid and gid */
 	char *set_user;										/* config user name */
 	int socket_uid, socket_gid, socket_mode;
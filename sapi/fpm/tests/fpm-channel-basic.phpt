@@ -0,0 +1,109 @@
+--TEST--
+FPM: Fpm\Channel send/recv round-trip, oversized messages and ring capacity
+--SKIPIF--
+<?php include "skipif.inc"; ?>
+--FILE--
+<?php
+
+require_once "tester.inc";
+
+$cfg = <<<EOT
+[global]
+error_log = {{FILE:LOG}}
+[unconfined]
+listen = {{ADDR}}
+pm = dynamic
+pm.max_children = 5
+pm.start_servers = 1
+pm.min_spare_servers = 1
+pm.max_spare_servers = 3
+EOT;
+
+$code = <<<'EOT'
+<?php
+echo "Test Start\n";
+
+try {
+    Fpm\Channel::open(str_repeat('x', 32));
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+try {
+    Fpm\Channel::open("a\0b");
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+$channel = Fpm\Channel::open('test');
+var_dump($channel instanceof Fpm\Channel);
+
+/* the directory has 8 slots; opening an existing name does not take one */
+for ($i = 1; $i < 8; $i++) {
+    Fpm\Channel::open("test$i");
+}
+var_dump(Fpm\Channel::open('test') instanceof Fpm\Channel);
+var_dump(Fpm\Channel::open('overflow'));
+
+/* round-trip */
+var_dump($channel->send('hello'));
+var_dump($channel->recv());
+
+/* the ring is now empty again */
+var_dump($channel->recv(false));
+
+/* messages larger than the ring minus its length prefix are rejected */
+try {
+    $channel->send(str_repeat('a', 65533));
+} catch (ValueError $e) {
+    echo $e->getMessage(), "\n";
+}
+
+/* each message occupies its length plus a 4 byte prefix, so 4092 byte
+ * payloads fill the 64KiB ring after exactly 16 non-blocking sends */
+$msg = str_repeat('b', 4092);
+$sent = 0;
+while ($channel->send($msg, false)) {
+    $sent++;
+}
+var_dump($sent);
+
+/* draining one message frees exactly enough room for another */
+var_dump(strlen($channel->recv()));
+var_dump($channel->send($msg, false));
+var_dump($channel->send($msg, false));
+
+echo "Test End\n";
+EOT;
+
+$tester = new FPM\Tester($cfg, $code);
+$tester->start();
+$tester->expectLogStartNotices();
+$tester->request()->printBody();
+$tester->terminate();
+$tester->expectLogTerminatingNotices();
+$tester->close();
+
+?>
+Done
+--EXPECT--
+Test Start
+Fpm\Channel::open(): Argument #1 ($name) must be between 1 and 31 bytes long
+Fpm\Channel::open(): Argument #1 ($name) must not contain any null bytes
+bool(true)
+bool(true)
+NULL
+bool(true)
+string(5) "hello"
+bool(false)
+Fpm\Channel::send(): Argument #1 ($message) must be at most 65532 bytes long
+int(16)
+int(4092)
+bool(true)
+bool(false)
+Test End
+Done
+--CLEAN--
+<?php
+require_once "tester.inc";
+FPM\Tester::clean();
+?>